@@ -0,0 +1,73 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+
+namespace megamol::core::utility {
+
+/**
+ * Writes a file through a temporary file next to it, which replaces the file only once it has been written
+ * completely. If writing fails or is abandoned, e.g. by an exception, the file keeps its previous state instead of
+ * being left partially written.
+ */
+class AtomicFileWriter {
+public:
+    /**
+     * Creates the temporary file, IsOpen() tells whether this succeeded.
+     *
+     * @param filename The file to be written.
+     */
+    explicit AtomicFileWriter(std::filesystem::path filename);
+
+    /**
+     * Removes the temporary file unless it has been committed.
+     */
+    ~AtomicFileWriter();
+
+    AtomicFileWriter(const AtomicFileWriter&) = delete;
+    AtomicFileWriter& operator=(const AtomicFileWriter&) = delete;
+
+    /**
+     * Answer whether the temporary file is open for writing.
+     *
+     * @return true until the file has been committed or discarded.
+     */
+    bool IsOpen() const {
+        return this->stream.is_open();
+    }
+
+    /**
+     * Answer the stream writing the temporary file.
+     *
+     * @return The stream.
+     */
+    std::ofstream& Stream() {
+        return this->stream;
+    }
+
+    /**
+     * Closes the temporary file and moves it to the name of the file.
+     *
+     * @return true on success. If the stream has failed before or the file cannot be replaced, the temporary file is
+     *         removed and false is returned.
+     */
+    bool Commit();
+
+    /**
+     * Closes and removes the temporary file, the file is left untouched.
+     */
+    void Discard();
+
+private:
+    std::filesystem::path filename;
+    std::filesystem::path temporary;
+    std::ofstream stream;
+};
+
+} // namespace megamol::core::utility
@@ -0,0 +1,81 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+ * Helpers for binary cache files, which keep data parsed from a source file next to it and are written through
+ * AtomicFileWriter. Values are stored in the layout of the machine, cache files are not meant to be portable.
+ */
+namespace megamol::core::utility {
+
+/**
+ * Builds the key identifying the state of a source file, which changes whenever the file is modified.
+ *
+ * @param magic  Identifies the layout of the cache file.
+ * @param source The file the cache is made from.
+ *
+ * @return The key, or an empty string if the size or the modification time of the file cannot be determined.
+ */
+std::string CacheFileKey(const std::string& magic, const std::filesystem::path& source);
+
+template<typename T>
+void WriteCacheValue(std::ostream& stream, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+T ReadCacheValue(std::istream& stream) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+    T value{};
+    stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+    return value;
+}
+
+/**
+ * Writes the size of the vector followed by its elements.
+ */
+template<typename T>
+void WriteCacheVector(std::ostream& stream, const std::vector<T>& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written");
+    WriteCacheValue(stream, static_cast<std::uint64_t>(value.size()));
+    stream.write(reinterpret_cast<const char*>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(T)));
+}
+
+/**
+ * Reads a vector written by WriteCacheVector().
+ *
+ * @throws std::bad_alloc or std::length_error if the stored size is corrupt.
+ */
+template<typename T>
+void ReadCacheVector(std::istream& stream, std::vector<T>& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read");
+    value.resize(ReadCacheValue<std::uint64_t>(stream));
+    stream.read(reinterpret_cast<char*>(value.data()), static_cast<std::streamsize>(value.size() * sizeof(T)));
+}
+
+/**
+ * Writes the length of the string followed by its characters.
+ */
+void WriteCacheString(std::ostream& stream, const std::string& value);
+
+/**
+ * Reads a string written by WriteCacheString().
+ *
+ * @throws std::bad_alloc or std::length_error if the stored length is corrupt.
+ */
+std::string ReadCacheString(std::istream& stream);
+
+} // namespace megamol::core::utility
@@ -0,0 +1,55 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "mmcore/utility/AtomicFileWriter.h"
+
+#include <system_error>
+#include <utility>
+
+megamol::core::utility::AtomicFileWriter::AtomicFileWriter(std::filesystem::path filename)
+        : filename(std::move(filename)) {
+    this->temporary = std::filesystem::path(this->filename).concat(".tmp");
+    this->stream.open(this->temporary, std::ios::binary | std::ios::trunc);
+}
+
+megamol::core::utility::AtomicFileWriter::~AtomicFileWriter() {
+    this->Discard();
+}
+
+bool megamol::core::utility::AtomicFileWriter::Commit() {
+    if (!this->stream.is_open()) {
+        return false;
+    }
+
+    // Failures are reported by the result, even if the user enabled exceptions
+    this->stream.exceptions(std::ios::goodbit);
+    this->stream.close();
+    if (this->stream.fail()) {
+        this->Discard();
+        return false;
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(this->temporary, this->filename, ec);
+    if (ec) {
+        this->Discard();
+        return false;
+    }
+    this->temporary.clear();
+    return true;
+}
+
+void megamol::core::utility::AtomicFileWriter::Discard() {
+    if (this->temporary.empty()) {
+        return;
+    }
+    this->stream.exceptions(std::ios::goodbit);
+    this->stream.close();
+
+    std::error_code ec;
+    std::filesystem::remove(this->temporary, ec);
+    this->temporary.clear();
+}
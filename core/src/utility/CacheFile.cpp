@@ -0,0 +1,33 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "mmcore/utility/CacheFile.h"
+
+#include <system_error>
+
+std::string megamol::core::utility::CacheFileKey(const std::string& magic, const std::filesystem::path& source) {
+    std::error_code ec;
+    const auto size = std::filesystem::file_size(source, ec);
+    if (ec) {
+        return {};
+    }
+    const auto time = std::filesystem::last_write_time(source, ec);
+    if (ec) {
+        return {};
+    }
+    return magic + "|" + std::to_string(size) + "|" + std::to_string(time.time_since_epoch().count());
+}
+
+void megamol::core::utility::WriteCacheString(std::ostream& stream, const std::string& value) {
+    WriteCacheValue(stream, static_cast<std::uint64_t>(value.size()));
+    stream.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+std::string megamol::core::utility::ReadCacheString(std::istream& stream) {
+    std::string value(ReadCacheValue<std::uint64_t>(stream), '\0');
+    stream.read(value.data(), static_cast<std::streamsize>(value.size()));
+    return value;
+}
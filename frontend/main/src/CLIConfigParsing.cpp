@@ -118,6 +118,8 @@ static std::string guishow_option = "guishow";
 static std::string nogui_option = "nogui";
 static std::string guiscale_option = "guiscale";
 static std::string privacynote_option = "privacynote";
+static std::string screenshot_threads_option = "screenshot-threads";
+static std::string screenshot_queue_option = "screenshot-queue";
 static std::string versionnote_option = "versionnote";
 static std::string profile_log_option = "profiling-log";
 static std::string flush_frequency_option = "flush-frequency";
@@ -133,6 +135,10 @@ static std::string remote_rendernode_zmq_source_option = "rendernode-zmq-source"
 static std::string remote_headnode_broadcast_quit_option = "headnode-broadcast-quit";
 static std::string remote_headnode_broadcast_project_option = "headnode-broadcast-project";
 static std::string remote_headnode_connect_at_start_option = "headnode-connect-at-start";
+static std::string remote_headnode_zmq_request_option = "headnode-zmq-request-source";
+static std::string remote_rendernode_zmq_request_option = "rendernode-zmq-request-target";
+static std::string remote_headnode_flush_interval_option = "headnode-flush-interval";
+static std::string remote_headnode_compress_option = "headnode-compress";
 static std::string framebuffer_option = "framebuffer";
 static std::string viewport_tile_option = "tile";
 static std::string vr_service_option = "vr";
@@ -173,6 +179,20 @@ static void privacynote_handler(
     config.screenshot_show_privacy_note = parsed_options[option_name].as<bool>();
 };
 
+static void screenshot_threads_handler(
+    std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
+    config.screenshot_writer_threads = parsed_options[option_name].as<unsigned int>();
+};
+
+static void screenshot_queue_handler(
+    std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
+    const auto length = parsed_options[option_name].as<unsigned int>();
+    if (length == 0) {
+        exit("screenshot queue length must be at least 1");
+    }
+    config.screenshot_queue_length = length;
+};
+
 static void versionnote_handler(
     std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
     config.show_version_note = parsed_options[option_name].as<bool>();
@@ -243,6 +263,26 @@ static void remote_head_connect_at_start_handler(
     config.remote_headnode_connect_on_start = parsed_options[option_name].as<bool>();
 };
 
+static void remote_head_zmqrequest_handler(
+    std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
+    config.remote_headnode_zmq_request_address = parsed_options[option_name].as<std::string>();
+};
+
+static void remote_render_zmqrequest_handler(
+    std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
+    config.remote_rendernode_zmq_request_address = parsed_options[option_name].as<std::string>();
+};
+
+static void remote_head_flush_interval_handler(
+    std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
+    config.remote_headnode_flush_interval_ms = parsed_options[option_name].as<unsigned int>();
+};
+
+static void remote_head_compress_handler(
+    std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config) {
+    config.remote_headnode_compress_messages = parsed_options[option_name].as<bool>();
+};
+
 static void config_handler(
     std::string const& option_name, cxxopts::ParseResult const& parsed_options, RuntimeConfig& config){
     // is already done by first CLI pass which checks config files before running them through Lua
@@ -566,6 +606,11 @@ std::vector<OptionsListEntry> cli_options_list =
             cxxopts::value<float>(), guiscale_handler},
         {privacynote_option, "Show privacy note when taking screenshot, use '=false' to disable",
             cxxopts::value<bool>(), privacynote_handler},
+        {screenshot_threads_option,
+            "Number of threads encoding screenshots in the background, 0 writes them synchronously (default)",
+            cxxopts::value<unsigned int>(), screenshot_threads_handler},
+        {screenshot_queue_option, "Number of screenshots waiting for background encoding before rendering blocks",
+            cxxopts::value<unsigned int>(), screenshot_queue_handler},
         {versionnote_option, "Show version warning when loading a project, use '=false' to disable",
             cxxopts::value<bool>(), versionnote_handler},
         {flush_frequency_option, "Flush logs (performance, power, ...) every that many frames",
@@ -602,6 +647,14 @@ std::vector<OptionsListEntry> cli_options_list =
             remote_head_broadcast_project_handler},
         {remote_headnode_connect_at_start_option, "Headnode starts sender thread at startup", cxxopts::value<bool>(),
             remote_head_connect_at_start_handler},
+        {remote_headnode_zmq_request_option, "Address and port where the headnode receives snapshot requests via ZMQ",
+            cxxopts::value<std::string>(), remote_head_zmqrequest_handler},
+        {remote_rendernode_zmq_request_option, "Address and port where the rendernode offers snapshot requests via ZMQ",
+            cxxopts::value<std::string>(), remote_render_zmqrequest_handler},
+        {remote_headnode_flush_interval_option, "Headnode batches messages for that many milliseconds, default: 0",
+            cxxopts::value<unsigned int>(), remote_head_flush_interval_handler},
+        {remote_headnode_compress_option, "Headnode compresses large messages", cxxopts::value<bool>(),
+            remote_head_compress_handler},
         {framebuffer_option, "Size of framebuffer, syntax: --framebuffer WIDTHxHEIGHT", cxxopts::value<std::string>(),
             framebuffer_handler},
         {viewport_tile_option,
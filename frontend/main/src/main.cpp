@@ -113,6 +113,8 @@ int main(const int argc, const char** argv) {
     megamol::frontend::Screenshot_Service screenshot_service;
     megamol::frontend::Screenshot_Service::Config screenshotConfig;
     screenshotConfig.show_privacy_note = config.screenshot_show_privacy_note;
+    screenshotConfig.writer_threads = config.screenshot_writer_threads;
+    screenshotConfig.queue_length = config.screenshot_queue_length;
     screenshot_service.setPriority(30);
 
     megamol::frontend::FrameStatistics_Service framestatistics_service;
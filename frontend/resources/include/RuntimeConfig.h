@@ -77,6 +77,8 @@ struct RuntimeConfig {
     bool gui_show = true;
     float gui_scale = 1.0f;
     bool screenshot_show_privacy_note = true;
+    unsigned int screenshot_writer_threads = 0; // 0 => write screenshots on the render thread
+    unsigned int screenshot_queue_length = 4;
     bool show_version_note = true;
     std::string profiling_output_file;
     uint32_t flush_frequency = 1000;
@@ -102,6 +104,10 @@ struct RuntimeConfig {
     unsigned int remote_mpi_broadcast_rank = 0;
     std::string remote_headnode_zmq_target_address = "tcp://127.0.0.1:62562";
     std::string remote_rendernode_zmq_source_address = "tcp://*:62562";
+    std::string remote_headnode_zmq_request_address = "tcp://127.0.0.1:62563";
+    std::string remote_rendernode_zmq_request_address = "tcp://*:62563";
+    unsigned int remote_headnode_flush_interval_ms = 0;
+    bool remote_headnode_compress_messages = false;
 
     enum class VRMode {
         Off,
@@ -8,35 +8,69 @@
 
 #include "HeadNode.hpp"
 
-//#include <chrono>
+#include <thread>
 
 #include "mmcore/utility/log/Log.h"
 
 using namespace megamol::remote;
 
-bool megamol::frontend::Remote_Service::HeadNode::send(megamol::remote::Message_t const& data) {
+bool megamol::frontend::Remote_Service::HeadNode::send(MessageType type, Message_t const& data) {
     if (!comm_thread_.signal.is_running() || data.empty())
         return false;
 
     // the Remote_Service fills the message data according to the used convention
-    // we are only responsible to send the data here
+    // we are only responsible to frame and send the data here
 
-    std::lock_guard<std::mutex> guard(send_buffer_guard_);
-    send_buffer_.clear();
-    send_buffer_.reserve(data.size());
-    send_buffer_.insert(send_buffer_.end(), data.begin(), data.end());
-    send_buffer_has_changed_.store(true);
+    {
+        std::lock_guard<std::mutex> guard(send_buffer_guard_);
+        append_message(send_buffer_, type, ++msg_id_, data.data(), data.size(), compress_);
+        send_buffer_has_changed_.store(true);
+    }
+    send_buffer_cond_.notify_one();
 
     return true;
 }
 
-bool megamol::frontend::Remote_Service::HeadNode::start_server(std::string const& send_to_address) {
+bool megamol::frontend::Remote_Service::HeadNode::send_snapshot(Message_t const& data) {
+    if (!comm_thread_.signal.is_running())
+        return false;
+
+    {
+        // queued messages stay in front of the snapshot, render nodes in sync still need e.g. mmQuit()
+        std::lock_guard<std::mutex> guard(send_buffer_guard_);
+        append_message(send_buffer_, MessageType::PRJ_FILE_MSG, ++msg_id_, data.data(), data.size(), compress_,
+            MSG_FLAG_SNAPSHOT);
+        send_buffer_has_changed_.store(true);
+    }
+    send_buffer_cond_.notify_one();
+
+    return true;
+}
+
+bool megamol::frontend::Remote_Service::HeadNode::snapshot_requested() {
+    return snapshot_requested_.exchange(false);
+}
+
+bool megamol::frontend::Remote_Service::HeadNode::start_server(std::string const& send_to_address,
+    std::string const& request_from_address, unsigned int flush_interval_ms, bool compress) {
     try {
         close_server();
         megamol::core::utility::log::Log::DefaultLog.WriteInfo(
             "Remote_Service::HeadNode: attempt ZMQCommFabric Connect on %s", send_to_address.c_str());
         this->comm_fabric_ = FBOCommFabric(std::make_unique<ZMQCommFabric>(zmq::socket_type::push));
         this->comm_fabric_.Connect(send_to_address);
+        this->request_comm_ = FBOCommFabric(std::make_unique<ZMQCommFabric>(zmq::socket_type::pull));
+        this->request_comm_.Connect(request_from_address);
+
+        // a fresh session starts a new sequence, render nodes resync via snapshot
+        this->msg_id_ = 0;
+        this->send_buffer_.clear();
+        this->send_buffer_has_changed_.store(false);
+        this->snapshot_requested_.store(false);
+        this->compress_ = compress;
+        this->flush_interval_ = std::chrono::milliseconds{flush_interval_ms};
+
+        this->comm_thread_.signal.start();
         this->comm_thread_.thread = std::thread{[&]() { this->comm_thread_loop(); }};
         megamol::core::utility::log::Log::DefaultLog.WriteInfo(
             "Remote_Service::HeadNode: Communication thread started.");
@@ -55,8 +89,10 @@ bool megamol::frontend::Remote_Service::HeadNode::close_server() {
         try {
             megamol::core::utility::log::Log::DefaultLog.WriteInfo("Remote_Service::HeadNode: Joining sender thread.");
             comm_thread_.signal.stop();
+            send_buffer_cond_.notify_one();
             comm_thread_.join();
             comm_fabric_.Disconnect();
+            request_comm_.Disconnect();
         } catch (std::exception& ex) {
             megamol::core::utility::log::Log::DefaultLog.WriteError(
                 "Remote_Service::HeadNode: error joining thread or disconnecting ZMQCommFabric: %s", ex.what());
@@ -66,24 +102,62 @@ bool megamol::frontend::Remote_Service::HeadNode::close_server() {
     return true;
 }
 
+void megamol::frontend::Remote_Service::HeadNode::poll_requests() {
+    Message_t buf;
+    std::vector<Message> requests;
+
+    while (request_comm_.Recv(buf, recv_type::IRECV)) {
+        requests.clear();
+        decode_messages(buf, requests);
+        for (auto const& req : requests) {
+            if (req.type == MessageType::SNAPSHOT_REQ_MSG) {
+                megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+                    "Remote_Service::HeadNode: Render node requested snapshot (last seen message: %llu).",
+                    static_cast<unsigned long long>(req.id));
+                snapshot_requested_.store(true);
+            }
+        }
+    }
+}
+
+void megamol::frontend::Remote_Service::HeadNode::flush() {
+    std::lock_guard<std::mutex> lock(send_buffer_guard_);
+    if (send_buffer_has_changed_.load()) {
+        comm_fabric_.Send(send_buffer_, send_type::SEND);
+        send_buffer_.clear();
+        send_buffer_has_changed_.store(false);
+    }
+}
+
 void megamol::frontend::Remote_Service::HeadNode::comm_thread_loop() {
-    comm_thread_.signal.start();
+    using namespace std::chrono_literals;
+
+    // upper bound for how long we wait for new messages before looking for snapshot requests again
+    constexpr auto poll_interval = 10ms;
+
+    auto last_flush = std::chrono::steady_clock::now();
 
     try {
         while (comm_thread_.signal.is_running()) {
-            // TODO: promise, future? events queue?
+            poll_requests();
+
+            {
+                std::unique_lock<std::mutex> lock(send_buffer_guard_);
+                send_buffer_cond_.wait_for(lock, poll_interval, [&]() {
+                    return send_buffer_has_changed_.load() || !comm_thread_.signal.is_running();
+                });
+            }
+
             if (send_buffer_has_changed_.load()) {
-                std::lock_guard<std::mutex> lock(send_buffer_guard_);
-                comm_fabric_.Send(send_buffer_, send_type::SEND);
-                send_buffer_.clear();
-                send_buffer_has_changed_.store(false);
-            } /*else {
-                comm_fabric_.Send(null_buf, send_type::SEND);
-            }*/
-
-            // using namespace std::chrono_literals;
-            // std::this_thread::sleep_for(1000ms / 120);
+                // batch everything arriving within the flush interval into one transport message
+                std::this_thread::sleep_until(last_flush + flush_interval_);
+                flush();
+                last_flush = std::chrono::steady_clock::now();
+            }
         }
+
+        // do not lose messages sent right before shutdown, e.g. mmQuit()
+        flush();
     } catch (std::exception& ex) {
         megamol::core::utility::log::Log::DefaultLog.WriteError(
             "Remote_Service::HeadNode: Error during communication: %s", ex.what());
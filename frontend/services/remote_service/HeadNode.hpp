@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <chrono>
+#include <condition_variable>
 #include <mutex>
 
 #include "Remote_Service.hpp"
@@ -18,11 +20,21 @@ struct megamol::frontend::Remote_Service::HeadNode {
     ~HeadNode();
 
     // "Sends custom lua command to the RendernodeView"
-    bool send(megamol::remote::Message_t const& data);
+    // messages get a sequence number and are batched until the next flush of the sender thread
+    bool send(megamol::remote::MessageType type, megamol::remote::Message_t const& data);
+
+    // sends the full state after all pending messages
+    bool send_snapshot(megamol::remote::Message_t const& data);
+
+    // true if some render node asked for a full state snapshot since the last call
+    bool snapshot_requested();
 
     // "Start listening to port."
     // "Address of headnode in ZMQ syntax (e.g. \"tcp://127.0.0.1:33333\")"
-    bool start_server(std::string const& send_to_address);
+    // request_from_address: where render nodes send their snapshot requests
+    // flush_interval_ms: collect messages for at least that long before sending them as one batch
+    bool start_server(std::string const& send_to_address, std::string const& request_from_address,
+        unsigned int flush_interval_ms = 0, bool compress = false);
     bool close_server();
 
 private:
@@ -30,13 +42,26 @@ private:
     // at some point comm_fabric_ sends the contents of this buffer
     megamol::remote::Message_t send_buffer_;
     mutable std::mutex send_buffer_guard_;
+    std::condition_variable send_buffer_cond_;
     std::atomic<bool> send_buffer_has_changed_ = false;
 
+    // sequence number of the last message put into the send buffer
+    uint64_t msg_id_ = 0;
+    bool compress_ = false;
+    std::chrono::milliseconds flush_interval_{0};
+    std::atomic<bool> snapshot_requested_ = false;
+
     // FBOCommFabric encapsulates either MPI or ZMQ communication
     // though called 'FBO' there is not much 'FBO' in the comm
     megamol::remote::FBOCommFabric comm_fabric_{
         std::make_unique<megamol::remote::ZMQCommFabric>(zmq::socket_type::push)};
 
+    // back channel, render nodes ask for snapshots on join or when they detect a sequence gap
+    megamol::remote::FBOCommFabric request_comm_{
+        std::make_unique<megamol::remote::ZMQCommFabric>(zmq::socket_type::pull)};
+
     megamol::frontend_resources::ThreadWorker comm_thread_;
     void comm_thread_loop();
+    void poll_requests();
+    void flush();
 };
@@ -8,6 +8,7 @@
 
 #include <imgui.h>
 #include <imgui_stdlib.h>
+#include <map>
 
 #include "GUIRegisterWindow.h" // register UI window for remote control
 #include "HeadNode.hpp"
@@ -15,6 +16,7 @@
 #include "MpiNode.hpp"
 #include "RenderNode.hpp"
 #include "mmcore/MegaMolGraph.h"
+#include "mmcore/param/ButtonParam.h"
 #include "mmcore/utility/log/Log.h"
 
 static const std::string service_name = "Remote_Service: ";
@@ -63,6 +65,10 @@ std::string handle_remote_session_config(
     remote_config.mpi_broadcast_rank = config.remote_mpi_broadcast_rank;
     remote_config.headnode_zmq_target_address = config.remote_headnode_zmq_target_address;
     remote_config.rendernode_zmq_source_address = config.remote_rendernode_zmq_source_address;
+    remote_config.headnode_zmq_request_address = config.remote_headnode_zmq_request_address;
+    remote_config.rendernode_zmq_request_address = config.remote_rendernode_zmq_request_address;
+    remote_config.headnode_flush_interval_ms = config.remote_headnode_flush_interval_ms;
+    remote_config.headnode_compress_messages = config.remote_headnode_compress_messages;
     remote_config.headnode_broadcast_quit = config.remote_headnode_broadcast_quit;
     remote_config.headnode_broadcast_initial_project = config.remote_headnode_broadcast_initial_project;
     remote_config.headnode_connect_on_start = config.remote_headnode_connect_on_start;
@@ -81,6 +87,10 @@ struct Remote_Service::PimplData {
     MpiNode mpi;
     MPI_Context mpi_context;
     megamol::remote::Message_t message;
+
+    // state the render nodes should have, used to answer snapshot requests and compute parameter deltas
+    std::string graph_snapshot;
+    std::map<std::string, std::string> sent_params;
 };
 #define m_head (m_pimpl->head)
 #define m_is_headnode_running (m_pimpl->is_headnode_running)
@@ -88,6 +98,57 @@ struct Remote_Service::PimplData {
 #define m_mpi (m_pimpl->mpi)
 #define m_mpi_context (m_pimpl->mpi_context)
 #define m_message (m_pimpl->message)
+#define m_graph_snapshot (m_pimpl->graph_snapshot)
+#define m_sent_params (m_pimpl->sent_params)
+
+static void split_module_names(std::string const& modules_list_string, std::vector<std::string>& module_list) {
+    if (modules_list_string.empty())
+        return;
+
+    const auto delimiters = ", ";
+    size_t begin = modules_list_string.find_first_not_of(delimiters);
+    auto end = modules_list_string.find_first_of(delimiters, begin);
+
+    while (begin != std::string::npos) {
+        module_list.push_back(modules_list_string.substr(begin, end - begin));
+        begin = modules_list_string.find_first_not_of(delimiters, end);
+        end = modules_list_string.find_first_of(delimiters, begin);
+    }
+}
+
+// current values of all parameters of the given modules ("all" for every module), keyed by full parameter name
+static void collect_parameters(megamol::core::MegaMolGraph const& graph, std::string const& modules_list_string,
+    std::map<std::string, std::string>& params) {
+    std::vector<std::string> module_list;
+    if (modules_list_string == "all") {
+        for (auto& module : graph.ListModules())
+            module_list.push_back(module.request.id);
+    } else {
+        split_module_names(modules_list_string, module_list);
+    }
+
+    for (auto const& module : module_list) {
+        for (auto& paramSlot : graph.EnumerateModuleParameterSlots(module)) {
+            // same convention as MegaMolGraph_Convenience::SerializeModuleParameters
+            if (paramSlot->Param<megamol::core::param::ButtonParam>()) {
+                continue;
+            }
+            auto name = std::string{paramSlot->FullName()};
+            name = "::" + name.substr(name.find_first_not_of(':'));
+            params[name] = paramSlot->Parameter()->ValueString();
+        }
+    }
+}
+
+static void append_param_command(std::string& commands, std::string const& name, std::string const& value) {
+    // the value goes into a Lua long bracket string whose level does not occur as closing bracket in the value
+    std::string level;
+    while (value.find("]" + level + "]") != std::string::npos) {
+        level += '=';
+    }
+    // Lua drops a newline directly after the opening bracket, the one inserted here keeps leading newlines of values
+    commands.append("mmSetParamValue(\"" + name + "\",[" + level + "[\n" + value + "]" + level + "])\n");
+}
 
 Remote_Service::Remote_Service() {
     // init members to default states
@@ -135,7 +196,7 @@ bool Remote_Service::init(const Config& config) {
     if (config.role == Role::RenderNode) {
         m_do_remote_things = std::function{[&]() { do_rendernode_things(); }};
 
-        if (!m_render.start_receiver(config.rendernode_zmq_source_address)) {
+        if (!m_render.start_receiver(config.rendernode_zmq_source_address, config.rendernode_zmq_request_address)) {
             log_error("could not start RenderNode receiver");
             return false;
         }
@@ -150,7 +211,7 @@ bool Remote_Service::init(const Config& config) {
         }
 
         if (m_mpi.mpi_comm.do_i_broadcast()) {
-            if (!m_render.start_receiver(config.rendernode_zmq_source_address)) {
+            if (!m_render.start_receiver(config.rendernode_zmq_source_address, config.rendernode_zmq_request_address)) {
                 log_error("could not start RenderNode receiver");
                 return false;
             }
@@ -220,13 +281,20 @@ void Remote_Service::postGraphRender() {}
 void Remote_Service::do_headnode_things() {
     auto& graph = m_requestedResourceReferences[0].getResource<megamol::core::MegaMolGraph>();
 
+    // render nodes that joined late or lost messages get the full state before any new delta
+    if (m_head.snapshot_requested()) {
+        head_send_snapshot();
+    }
+
     for (auto command : m_headnode_remote_control.commands_queue)
         switch (command) {
         case HeadNodeRemoteControl::Command::ClearGraph:
             head_send_message("mmClearGraph()");
+            m_graph_snapshot = "mmClearGraph()\n";
+            m_sent_params.clear();
             break;
         case HeadNodeRemoteControl::Command::SendGraph:
-            head_send_message(const_cast<megamol::core::MegaMolGraph&>(graph).Convenience().SerializeGraph());
+            head_send_graph(const_cast<megamol::core::MegaMolGraph&>(graph).Convenience().SerializeGraph());
             break;
         case HeadNodeRemoteControl::Command::SendLuaCommand:
             head_send_message(m_headnode_remote_control.lua_command);
@@ -236,39 +304,8 @@ void Remote_Service::do_headnode_things() {
         }
     m_headnode_remote_control.commands_queue.clear();
 
-    auto split_module_names = [&](std::string const& modules_list_string, auto& module_list) {
-        if (modules_list_string.empty())
-            return;
-
-        const auto delimiters = ", ";
-        size_t begin = modules_list_string.find_first_not_of(delimiters);
-        auto end = modules_list_string.find_first_of(delimiters, begin);
-
-        while (begin != std::string::npos) {
-            module_list.push_back(modules_list_string.substr(begin, end - begin));
-            begin = modules_list_string.find_first_not_of(delimiters, end);
-            end = modules_list_string.find_first_of(delimiters, begin);
-        }
-    };
-
     if (m_headnode_remote_control.keep_sending_params) {
-        static std::string send_params;
-        send_params.clear();
-
-        if (m_headnode_remote_control.modules_to_send_params_of == "all") {
-            send_params = const_cast<megamol::core::MegaMolGraph&>(graph).Convenience().SerializeAllParameters();
-        } else {
-            static std::vector<std::string> module_list;
-            module_list.clear();
-
-            split_module_names(m_headnode_remote_control.modules_to_send_params_of, module_list);
-
-            for (auto& module : module_list)
-                send_params +=
-                    const_cast<megamol::core::MegaMolGraph&>(graph).Convenience().SerializeModuleParameters(module);
-        }
-
-        head_send_message(send_params);
+        head_send_param_updates();
     }
 }
 
@@ -374,7 +411,8 @@ bool Remote_Service::start_headnode(bool start_or_shutdown) {
     case true:
         m_do_remote_things = std::function{[&]() { do_headnode_things(); }};
 
-        if (!m_head.start_server(m_config.headnode_zmq_target_address)) {
+        if (!m_head.start_server(m_config.headnode_zmq_target_address, m_config.headnode_zmq_request_address,
+                m_config.headnode_flush_interval_ms, m_config.headnode_compress_messages)) {
             log_error("could not start HeadNode server");
             return false;
         }
@@ -415,7 +453,59 @@ void Remote_Service::do_mpi_things() {
 void Remote_Service::head_send_message(std::string const& string) {
     m_message.resize(string.size());
     std::memcpy(m_message.data(), string.data(), string.size());
-    m_head.send(m_message);
+    m_head.send(megamol::remote::MessageType::LUA_CMD_MSG, m_message);
+}
+
+void Remote_Service::head_send_graph(std::string const& graph_serialization) {
+    auto& graph = m_requestedResourceReferences[0].getResource<megamol::core::MegaMolGraph>();
+
+    // the serialized graph carries all parameter values, deltas continue from there
+    m_graph_snapshot = "mmClearGraph()\n" + graph_serialization;
+    m_sent_params.clear();
+    collect_parameters(graph, "all", m_sent_params);
+
+    m_message.assign(graph_serialization.begin(), graph_serialization.end());
+    m_head.send(megamol::remote::MessageType::PRJ_FILE_MSG, m_message);
+}
+
+void Remote_Service::head_send_param_updates() {
+    auto& graph = m_requestedResourceReferences[0].getResource<megamol::core::MegaMolGraph>();
+
+    static std::map<std::string, std::string> current_params;
+    current_params.clear();
+    collect_parameters(graph, m_headnode_remote_control.modules_to_send_params_of, current_params);
+
+    static std::string changed_params;
+    changed_params.clear();
+    for (auto& [name, value] : current_params) {
+        auto sent = m_sent_params.find(name);
+        if (sent == m_sent_params.end() || sent->second != value) {
+            append_param_command(changed_params, name, value);
+            m_sent_params[name] = value;
+        }
+    }
+
+    if (!changed_params.empty()) {
+        m_message.assign(changed_params.begin(), changed_params.end());
+        m_head.send(megamol::remote::MessageType::PARAM_UPD_MSG, m_message);
+    }
+}
+
+void Remote_Service::head_send_snapshot() {
+    if (m_headnode_remote_control.keep_sending_params) {
+        auto& graph = m_requestedResourceReferences[0].getResource<megamol::core::MegaMolGraph>();
+        collect_parameters(graph, m_headnode_remote_control.modules_to_send_params_of, m_sent_params);
+    }
+
+    // last broadcast graph (if any) followed by every parameter value the render nodes have been sent so far
+    std::string snapshot = m_graph_snapshot;
+    for (auto& [name, value] : m_sent_params) {
+        append_param_command(snapshot, name, value);
+    }
+
+    log("sending state snapshot (" + std::to_string(snapshot.size()) + " bytes)");
+    m_message.assign(snapshot.begin(), snapshot.end());
+    m_head.send_snapshot(m_message);
 }
 
 void Remote_Service::execute_message(std::vector<char> const& message) {
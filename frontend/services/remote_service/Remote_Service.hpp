@@ -32,6 +32,13 @@ public:
             "tcp://127.0.0.1:62562"; // "Address of headnode in ZMQ syntax (e.g. \"tcp://127.0.0.1:33333\")"
         std::string rendernode_zmq_source_address =
             "tcp://*:62562"; // "Address of headnode in ZMQ syntax (e.g. \"tcp://127.0.0.1:33333\")"
+        std::string headnode_zmq_request_address =
+            "tcp://127.0.0.1:62563"; // where the headnode picks up snapshot requests of the rendernode
+        std::string rendernode_zmq_request_address =
+            "tcp://*:62563"; // where the rendernode offers snapshot requests to the headnode
+
+        unsigned int headnode_flush_interval_ms = 0; // headnode batches messages for that long before sending
+        bool headnode_compress_messages = false;     // zlib compress large messages (graphs, many params)
         //bool        head_distribute_local_project_at_startup = true;                    // "Sends project file on connect"
 
         int mpi_broadcast_rank = 0; // "Set which MPI rank is the broadcast master"
@@ -87,6 +94,9 @@ private:
     void do_mpi_things();
 
     void head_send_message(std::string const& string);
+    void head_send_graph(std::string const& graph_serialization);
+    void head_send_param_updates();
+    void head_send_snapshot();
     void execute_message(std::vector<char> const& message);
 
     struct PimplData;
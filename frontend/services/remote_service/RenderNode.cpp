@@ -18,7 +18,8 @@ megamol::frontend::Remote_Service::RenderNode::~RenderNode() {
     close_receiver();
 }
 
-bool megamol::frontend::Remote_Service::RenderNode::start_receiver(std::string const& receive_from_address) {
+bool megamol::frontend::Remote_Service::RenderNode::start_receiver(
+    std::string const& receive_from_address, std::string const& request_address) {
     close_receiver();
 
     megamol::core::utility::log::Log::DefaultLog.WriteInfo(
@@ -27,6 +28,14 @@ bool megamol::frontend::Remote_Service::RenderNode::start_receiver(std::string c
     try {
         this->receiver_comm_ = FBOCommFabric(std::make_unique<ZMQCommFabric>(zmq::socket_type::pull));
         this->receiver_comm_.Bind(receive_from_address);
+        this->request_comm_ = FBOCommFabric(std::make_unique<ZMQCommFabric>(zmq::socket_type::push));
+        this->request_comm_.Bind(request_address);
+
+        // joining a session: ask for the full state first
+        this->last_msg_id_.store(0);
+        this->awaiting_snapshot_ = true;
+        this->snapshot_request_pending_.store(true);
+
         receiver_thread_.thread = std::thread{[&]() { receiver_thread_loop(); }};
         megamol::core::utility::log::Log::DefaultLog.WriteInfo("Remote_Service::RenderNode: Receiver thread started.");
     } catch (std::exception& ex) {
@@ -45,6 +54,7 @@ bool megamol::frontend::Remote_Service::RenderNode::close_receiver() {
             receiver_thread_.signal.stop();
             receiver_thread_.join();
             receiver_comm_.Disconnect();
+            request_comm_.Disconnect();
         } catch (std::exception& ex) {
             megamol::core::utility::log::Log::DefaultLog.WriteError(
                 "Remote_Service::RenderNode: error joining thread or unbinding ZMQCommFabric: %s", ex.what());
@@ -57,18 +67,28 @@ bool megamol::frontend::Remote_Service::RenderNode::close_receiver() {
 void megamol::frontend::Remote_Service::RenderNode::receiver_thread_loop() {
     megamol::core::utility::log::Log::DefaultLog.WriteInfo("Remote_Service::RenderNode: Starting receiver loop.");
 
+    using namespace std::chrono_literals;
+
+    // a head node that is not up yet does not take requests, do not retry on every poll
+    constexpr auto request_retry_interval = 100ms;
+    auto next_request = std::chrono::steady_clock::now();
+
     try {
         receiver_thread_.signal.start();
         while (receiver_thread_.signal.is_running()) {
+            if (snapshot_request_pending_.load() && std::chrono::steady_clock::now() >= next_request) {
+                send_snapshot_request();
+                next_request = std::chrono::steady_clock::now() + request_retry_interval;
+            }
+
             Message_t buf = {'r', 'e', 'q'};
 
-            while (!receiver_comm_.Recv(buf, recv_type::RECV) && receiver_thread_.signal.is_running()) {
+            // waits at most ZMQCommFabric::RecvTimeoutMs, so that pending snapshot requests and stop() are handled
+            if (!receiver_comm_.Recv(buf, recv_type::RECV)) {
                 //megamol::core::utility::log::Log::DefaultLog.WriteWarn("RendernodeView: Failed to recv message.");
+                continue;
             }
 
-            if (!receiver_thread_.signal.is_running())
-                break;
-
             {
                 std::unique_lock<std::mutex> lock(recv_msgs_mtx_);
                 recv_msgs_.insert(recv_msgs_.end(), buf.begin(), buf.end());
@@ -95,12 +115,76 @@ bool megamol::frontend::Remote_Service::RenderNode::await_message(
         if (!data_has_changed_.load())
             return false;
 
-        result.resize(recv_msgs_.size());
-        std::copy(recv_msgs_.begin(), recv_msgs_.end(), result.begin());
+        unpack_messages(recv_msgs_, result);
         data_has_changed_.store(false);
         recv_msgs_.clear();
-        return true;
+        return !result.empty();
     } else {
         return false;
     }
 }
+
+void megamol::frontend::Remote_Service::RenderNode::send_snapshot_request() {
+    if (!snapshot_request_pending_.load())
+        return;
+
+    Message_t request;
+    append_message(request, MessageType::SNAPSHOT_REQ_MSG, last_msg_id_.load(), nullptr, 0, false);
+
+    // non-blocking: while no head node is connected the request stays pending
+    if (request_comm_.Send(request, send_type::ISEND)) {
+        snapshot_request_pending_.store(false);
+    }
+}
+
+void megamol::frontend::Remote_Service::RenderNode::unpack_messages(Message_t const& raw, Message_t& result) {
+    decoded_msgs_.clear();
+    auto const intact = decode_messages(raw, decoded_msgs_);
+    if (!intact) {
+        megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+            "Remote_Service::RenderNode: Received corrupt or incompatible message frame.");
+    }
+
+    auto const request_snapshot = [&]() {
+        if (!awaiting_snapshot_) {
+            awaiting_snapshot_ = true;
+            snapshot_request_pending_.store(true);
+        }
+    };
+
+    result.clear();
+    for (auto& msg : decoded_msgs_) {
+        if (msg.flags & MSG_FLAG_SNAPSHOT) {
+            // snapshots from an old session may still be in flight, anything newer than what we know is fine
+            if (!awaiting_snapshot_ && msg.id <= last_msg_id_.load())
+                continue;
+            // commands queued before the snapshot have already been applied by the head node, keep them
+            awaiting_snapshot_ = false;
+        } else if (awaiting_snapshot_) {
+            continue;
+        } else if (msg.id != last_msg_id_.load() + 1) {
+            megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+                "Remote_Service::RenderNode: Message gap (expected %llu, got %llu). Requesting snapshot.",
+                static_cast<unsigned long long>(last_msg_id_.load() + 1), static_cast<unsigned long long>(msg.id));
+            request_snapshot();
+            continue;
+        }
+        last_msg_id_.store(msg.id);
+
+        switch (msg.type) {
+        case MessageType::PRJ_FILE_MSG:
+        case MessageType::PARAM_UPD_MSG:
+        case MessageType::LUA_CMD_MSG:
+            result.insert(result.end(), msg.msg_body.begin(), msg.msg_body.end());
+            result.push_back('\n');
+            break;
+        default:
+            break;
+        }
+    }
+
+    // lost frames leave us in an unknown state
+    if (!intact) {
+        request_snapshot();
+    }
+}
@@ -20,8 +20,12 @@ struct megamol::frontend::Remote_Service::RenderNode {
     //, bool use_mpi, bool sync_data_sources_mpi, int broadcast_rank_mpi);
     ~RenderNode();
 
-    bool start_receiver(std::string const& receive_from_address);
+    // request_address: where the head node picks up our snapshot requests
+    bool start_receiver(std::string const& receive_from_address, std::string const& request_address);
     bool close_receiver();
+
+    // result holds the Lua commands of all messages received in order since the last call
+    // messages after a sequence gap are dropped until the requested snapshot arrives
     bool await_message(megamol::remote::Message_t& result, unsigned int timeout_ms = 1000);
 
 private:
@@ -31,6 +35,18 @@ private:
 
     void receiver_thread_loop();
 
+    // back channel to the head node for snapshot requests on join or sequence gaps
+    megamol::remote::FBOCommFabric request_comm_{
+        std::make_unique<megamol::remote::ZMQCommFabric>(zmq::socket_type::push)};
+    std::atomic<bool> snapshot_request_pending_ = false;
+    void send_snapshot_request();
+
+    // sequence tracking of received messages, only touched by await_message()
+    std::atomic<uint64_t> last_msg_id_ = 0;
+    bool awaiting_snapshot_ = true;
+    std::vector<megamol::remote::Message> decoded_msgs_;
+    void unpack_messages(megamol::remote::Message_t const& raw, megamol::remote::Message_t& result);
+
     megamol::remote::Message_t recv_msgs_;
     mutable std::mutex recv_msgs_mtx_;
     std::condition_variable data_received_cond_;
@@ -0,0 +1,96 @@
+/**
+ * MegaMol
+ * Copyright (c) 2021, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "DistributedProto.h"
+
+#include <cstring>
+
+#include <zlib.h>
+
+namespace {
+
+template<typename T>
+void write_value(megamol::remote::Message_t& buffer, size_t& offset, T const& value) {
+    std::memcpy(buffer.data() + offset, &value, sizeof(T));
+    offset += sizeof(T);
+}
+
+template<typename T>
+T read_value(megamol::remote::Message_t const& buffer, size_t& offset) {
+    T value;
+    std::memcpy(&value, buffer.data() + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+void megamol::remote::append_message(Message_t& buffer, MessageType type, uint64_t id, char const* body, size_t size,
+    bool compress, unsigned char flags) {
+    auto const header_offset = buffer.size();
+
+    uint64_t body_size = size;
+    if (compress && size >= MessageCompressionThreshold) {
+        auto bound = compressBound(static_cast<uLong>(size));
+        buffer.resize(header_offset + MessageHeaderSize + bound);
+        auto const res = compress2(reinterpret_cast<Bytef*>(buffer.data() + header_offset + MessageHeaderSize), &bound,
+            reinterpret_cast<Bytef const*>(body), static_cast<uLong>(size), Z_BEST_SPEED);
+        if (res == Z_OK && bound < size) {
+            body_size = bound;
+            flags |= MSG_FLAG_COMPRESSED;
+        }
+    }
+
+    buffer.resize(header_offset + MessageHeaderSize + body_size);
+    if ((flags & MSG_FLAG_COMPRESSED) == 0 && size > 0) {
+        std::memcpy(buffer.data() + header_offset + MessageHeaderSize, body, size);
+    }
+
+    auto offset = header_offset;
+    write_value(buffer, offset, ProtocolVersion);
+    write_value(buffer, offset, type);
+    write_value(buffer, offset, flags);
+    write_value(buffer, offset, id);
+    write_value(buffer, offset, static_cast<uint64_t>(size));
+    write_value(buffer, offset, body_size);
+}
+
+bool megamol::remote::decode_messages(Message_t const& buffer, std::vector<Message>& messages) {
+    size_t offset = 0;
+
+    while (offset < buffer.size()) {
+        if (buffer.size() - offset < MessageHeaderSize)
+            return false;
+
+        auto const version = read_value<unsigned char>(buffer, offset);
+        Message msg;
+        msg.type = read_value<MessageType>(buffer, offset);
+        msg.flags = read_value<unsigned char>(buffer, offset);
+        msg.id = read_value<uint64_t>(buffer, offset);
+        msg.size = read_value<uint64_t>(buffer, offset);
+        auto const body_size = read_value<uint64_t>(buffer, offset);
+
+        if (version != ProtocolVersion || buffer.size() - offset < body_size)
+            return false;
+
+        if (msg.flags & MSG_FLAG_COMPRESSED) {
+            msg.msg_body.resize(msg.size);
+            auto dest_size = static_cast<uLongf>(msg.size);
+            auto const res = uncompress(reinterpret_cast<Bytef*>(msg.msg_body.data()), &dest_size,
+                reinterpret_cast<Bytef const*>(buffer.data() + offset), static_cast<uLong>(body_size));
+            if (res != Z_OK || dest_size != msg.size)
+                return false;
+            msg.flags &= ~MSG_FLAG_COMPRESSED;
+        } else {
+            msg.msg_body.assign(buffer.begin() + offset, buffer.begin() + offset + body_size);
+        }
+        offset += body_size;
+
+        messages.push_back(std::move(msg));
+    }
+
+    return true;
+}
@@ -6,71 +6,80 @@
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 namespace megamol::remote {
-enum class MessageType : unsigned char { NULL_MSG = 0u, PRJ_FILE_MSG, CAM_UPD_MSG, PARAM_UPD_MSG, HEAD_DISC_MSG };
+
+/**
+ * Revision of the head node -> render node wire protocol.
+ * Render nodes drop frames of unknown revisions.
+ */
+constexpr unsigned char ProtocolVersion = 2u;
+
+enum class MessageType : unsigned char {
+    NULL_MSG = 0u,
+    PRJ_FILE_MSG,    // graph serialization
+    CAM_UPD_MSG,     // camera state (unused)
+    PARAM_UPD_MSG,   // changed parameters since the previous PARAM_UPD_MSG
+    HEAD_DISC_MSG,   // head node disconnects
+    LUA_CMD_MSG,     // arbitrary Lua command
+    SNAPSHOT_REQ_MSG // render node -> head node: please send full state
+};
+
+enum MessageFlags : unsigned char {
+    MSG_FLAG_NONE = 0u,
+    MSG_FLAG_COMPRESSED = 1u << 0, // body is zlib compressed
+    MSG_FLAG_SNAPSHOT = 1u << 1,   // body carries the full state, resets sequence tracking on the receiver
+};
 
 using Message_t = std::vector<char>;
 
 struct Message {
-    MessageType type;
-    uint64_t size;
-    uint64_t id;
+    MessageType type = MessageType::NULL_MSG;
+    uint64_t size = 0; // size of the uncompressed body
+    uint64_t id = 0;   // sequence number, counts up for each message of a head node
+    unsigned char flags = MSG_FLAG_NONE;
     Message_t msg_body;
 };
 
+// wire layout of one message frame:
+// | version | type | flags | id | uncompressed body size | body size | body ... |
+// several frames may be batched into one transport message
+constexpr size_t MessageVersionSize = sizeof(unsigned char);
 constexpr size_t MessageTypeSize = sizeof(MessageType);
-constexpr size_t MessageSizeSize = sizeof(uint64_t);
+constexpr size_t MessageFlagsSize = sizeof(unsigned char);
 constexpr size_t MessageIDSize = sizeof(uint64_t);
-constexpr size_t MessageHeaderSize = MessageIDSize + MessageTypeSize + MessageSizeSize;
+constexpr size_t MessageSizeSize = sizeof(uint64_t);
+constexpr size_t MessageHeaderSize =
+    MessageVersionSize + MessageTypeSize + MessageFlagsSize + MessageIDSize + 2 * MessageSizeSize;
 
-//Message_t prepare_null_msg() {
-//    Message_t msg(MessageHeaderSize);
-//    auto const type = MessageType::NULL_MSG;
-//    uint64_t const size = 0;
-//    auto const size_ptr = reinterpret_cast<char const*>(&size);
-//    msg[0] = static_cast<unsigned char>(type);
-//    std::copy(size_ptr, size_ptr + sizeof(uint64_t), msg.begin() + 1);
-//    return msg;
-//}
-//
-//MessageType get_msg_type(Message_t const& msg) {
-//    return static_cast<MessageType>(*msg.begin());
-//}
-//
-//MessageType get_msg_type(Message_t::const_iterator const& begin, Message_t::const_iterator const& end) {
-//    return static_cast<MessageType>(*begin);
-//}
-//
-//uint64_t get_msg_size(Message_t::const_iterator const& begin, Message_t::const_iterator const& end) {
-//    uint64_t ret = 0;
-//    if (std::distance(begin, end) > MessageHeaderSize) {
-//        std::copy(begin + MessageTypeSize, begin + MessageHeaderSize, &ret);
-//    }
-//    return ret;
-//}
-//
-//Message_t get_msg(uint64_t size, Message_t::const_iterator const& begin, Message_t::const_iterator const& end) {
-//    Message_t msg;
-//    if (std::distance(begin, end) < MessageHeaderSize + size) {
-//        return msg;
-//    }
-//
-//    msg.resize(size);
-//    std::copy(begin + MessageHeaderSize, begin + MessageHeaderSize + size, msg.begin());
-//
-//    return msg;
-//}
-//
-//Message_t::const_iterator progress_msg(
-//    uint64_t size, Message_t::const_iterator const& begin, Message_t::const_iterator const& end) {
-//    if (std::distance(begin, end) > MessageHeaderSize + size) {
-//        return begin + MessageHeaderSize + size;
-//    }
-//
-//    return end;
-//}
+// bodies smaller than this are never compressed, zlib overhead would eat the gain
+constexpr size_t MessageCompressionThreshold = 1024;
 
+/**
+ * Appends one message frame to the given buffer.
+ *
+ * @param buffer Transport buffer receiving the frame.
+ * @param type Type of the message.
+ * @param id Sequence number of the message.
+ * @param body Pointer to the message body.
+ * @param size Size of the message body in bytes.
+ * @param compress Try to compress the body. Compression is skipped if it does not pay off.
+ * @param flags Additional message flags.
+ */
+void append_message(Message_t& buffer, MessageType type, uint64_t id, char const* body, size_t size, bool compress,
+    unsigned char flags = MSG_FLAG_NONE);
+
+/**
+ * Splits a transport buffer into message frames and decompresses their bodies.
+ *
+ * @param buffer Transport buffer, possibly containing several batched frames.
+ * @param messages Decoded messages are appended here.
+ *
+ * @return False if the buffer contained a truncated or corrupt frame. Frames before the corrupt one are still returned.
+ */
+bool decode_messages(Message_t const& buffer, std::vector<Message>& messages);
 
 } // namespace megamol::remote
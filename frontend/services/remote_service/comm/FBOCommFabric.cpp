@@ -66,7 +66,9 @@ bool megamol::remote::MPICommFabric::Disconnect() {
 megamol::remote::MPICommFabric::~MPICommFabric() {}
 
 
-megamol::remote::ZMQCommFabric::ZMQCommFabric(zmq::socket_type const& type) : ctx_{1}, socket_{ctx_, type} {}
+megamol::remote::ZMQCommFabric::ZMQCommFabric(zmq::socket_type const& type) : ctx_{1}, socket_{ctx_, type} {
+    this->socket_.setsockopt(ZMQ_RCVTIMEO, RecvTimeoutMs);
+}
 
 
 megamol::remote::ZMQCommFabric::ZMQCommFabric(ZMQCommFabric&& rhs) noexcept
@@ -111,13 +113,17 @@ bool megamol::remote::ZMQCommFabric::Bind(std::string const& address) {
 
 
 bool megamol::remote::ZMQCommFabric::Send(std::vector<char> const& buf, send_type const type) {
+    if (type == ISEND) {
+        // non-blocking, fails if the message can not be queued right now (e.g. no peer connected)
+        return this->socket_.send(buf.data(), buf.size(), ZMQ_DONTWAIT) == buf.size();
+    }
     return this->socket_.send(buf.begin(), buf.end());
 }
 
 
 bool megamol::remote::ZMQCommFabric::Recv(std::vector<char>& buf, recv_type const type) {
     zmq::message_t msg;
-    auto const ret = this->socket_.recv(&msg, ZMQ_DONTWAIT);
+    auto const ret = this->socket_.recv(&msg, type == IRECV ? ZMQ_DONTWAIT : 0);
     if (!ret)
         return false;
     buf.resize(msg.size());
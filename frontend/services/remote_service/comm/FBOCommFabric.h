@@ -19,6 +19,7 @@ namespace megamol::remote {
 
 enum send_type : unsigned int { ST_UNDEF = 0, BCAST, SCATTER, SEND, ISEND };
 
+// RECV waits for a message, ZMQ gives up after ZMQCommFabric::RecvTimeoutMs; IRECV only takes what has arrived
 enum recv_type : unsigned int { RT_UNDEF = 0, RECV, IRECV };
 
 
@@ -61,6 +62,9 @@ private:
  */
 class ZMQCommFabric : public AbstractCommFabric {
 public:
+    /** upper bound of a blocking receive, so that receiver threads notice when they are stopped */
+    static constexpr int RecvTimeoutMs = 100;
+
     ZMQCommFabric(zmq::socket_type const& type);
     ZMQCommFabric(ZMQCommFabric const& rhs) = delete;
     ZMQCommFabric& operator=(ZMQCommFabric const& rhs) = delete;
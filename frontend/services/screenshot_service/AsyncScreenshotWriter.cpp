@@ -0,0 +1,125 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "AsyncScreenshotWriter.hpp"
+
+#include <algorithm>
+
+#include "ScreenshotEncoders.hpp"
+#include "mmcore/utility/log/Log.h"
+
+using megamol::frontend::screenshot::AsyncScreenshotWriter;
+
+AsyncScreenshotWriter::~AsyncScreenshotWriter() {
+    stop();
+}
+
+void AsyncScreenshotWriter::start(unsigned int threads, unsigned int queue_length) {
+    stop();
+
+    threads = std::max(1u, threads);
+    m_queue_length = std::max(1u, queue_length);
+    // the remaining cores deflate stripes of the PNG a worker is encoding
+    m_encoder_threads = std::max(1u, std::thread::hardware_concurrency() / threads);
+    m_written = 0;
+    m_failed = 0;
+    m_stop = false;
+    m_reported_full = false;
+
+    m_workers.reserve(threads);
+    for (unsigned int i = 0; i < threads; ++i) {
+        m_workers.emplace_back(&AsyncScreenshotWriter::work, this);
+    }
+}
+
+void AsyncScreenshotWriter::stop() {
+    if (m_workers.empty()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_job_available.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+    m_workers.clear();
+}
+
+std::future<bool> AsyncScreenshotWriter::push(frontend_resources::ScreenshotImageData const& image,
+    std::filesystem::path const& filename, std::optional<std::string> project) {
+    // copy outside of the lock, sources hand out images they overwrite with the next screenshot
+    Job job{image, filename, std::move(project)};
+    auto result = job.result.get_future();
+    // the row pointers of the copy still point into the source
+    job.image.resize(job.image.width, job.image.height);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_queue.size() >= m_queue_length) {
+        if (!m_reported_full) {
+            megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+                "Screenshot_Service: %zu screenshots pending, rendering waits for the encoder", m_queue.size());
+            m_reported_full = true;
+        }
+        m_slot_available.wait(lock, [this] { return m_queue.size() < m_queue_length; });
+    }
+    m_queue.push_back(std::move(job));
+    lock.unlock();
+
+    m_job_available.notify_one();
+    return result;
+}
+
+void AsyncScreenshotWriter::flush() {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_idle.wait(lock, [this] { return m_queue.empty() && m_in_progress == 0; });
+}
+
+size_t AsyncScreenshotWriter::written() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_written;
+}
+
+size_t AsyncScreenshotWriter::failed() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_failed;
+}
+
+void AsyncScreenshotWriter::work() {
+    while (true) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        // pending images are still written when stopping
+        m_job_available.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+        if (m_queue.empty()) {
+            return;
+        }
+        Job job = std::move(m_queue.front());
+        m_queue.pop_front();
+        ++m_in_progress;
+        lock.unlock();
+        m_slot_available.notify_one();
+
+        const bool ok = write_image(job.image, job.filename, job.project, m_encoder_threads);
+
+        lock.lock();
+        --m_in_progress;
+        ++(ok ? m_written : m_failed);
+        const bool idle = m_queue.empty() && m_in_progress == 0;
+        lock.unlock();
+
+        if (!ok) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "Screenshot_Service: failed to write screenshot %s", job.filename.generic_string().c_str());
+        }
+        job.result.set_value(ok);
+        if (idle) {
+            m_idle.notify_all();
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Screenshots.h"
+
+namespace megamol::frontend::screenshot {
+
+// Encodes and writes screenshots on worker threads, so taking a screenshot only costs copying the image.
+// The queue of pending images is bounded: when it is full, push() blocks until a worker took an image,
+// which keeps batch frame dumps from piling up unbounded amounts of memory.
+class AsyncScreenshotWriter {
+public:
+    AsyncScreenshotWriter() = default;
+    ~AsyncScreenshotWriter();
+
+    AsyncScreenshotWriter(AsyncScreenshotWriter const&) = delete;
+    AsyncScreenshotWriter& operator=(AsyncScreenshotWriter const&) = delete;
+
+    // starts 'threads' workers accepting up to 'queue_length' pending images
+    void start(unsigned int threads, unsigned int queue_length);
+
+    // writes all pending images and joins the workers
+    void stop();
+
+    bool running() const {
+        return !m_workers.empty();
+    }
+
+    // queues a copy of the image, blocks while the queue is full.
+    // the future yields whether the image has been encoded and written, failures are logged either way.
+    std::future<bool> push(frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename,
+        std::optional<std::string> project);
+
+    // blocks until all queued images are written
+    void flush();
+
+    // number of images written or failed since start()
+    size_t written() const;
+    size_t failed() const;
+
+private:
+    struct Job {
+        frontend_resources::ScreenshotImageData image;
+        std::filesystem::path filename;
+        std::optional<std::string> project;
+        std::promise<bool> result;
+    };
+
+    void work();
+
+    std::vector<std::thread> m_workers;
+    std::deque<Job> m_queue;
+    size_t m_queue_length = 1;
+    size_t m_in_progress = 0;
+    size_t m_written = 0;
+    size_t m_failed = 0;
+    unsigned int m_encoder_threads = 1;
+    bool m_stop = false;
+    bool m_reported_full = false;
+
+    mutable std::mutex m_mutex;
+    std::condition_variable m_job_available;
+    std::condition_variable m_slot_available;
+    std::condition_variable m_idle;
+};
+
+} // namespace megamol::frontend::screenshot
@@ -0,0 +1,373 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "ScreenshotEncoders.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <zlib.h>
+
+#include "mmcore/utility/graphics/ScreenShotComments.h"
+#include "mmcore/utility/log/Log.h"
+
+using megamol::frontend_resources::ScreenshotImageData;
+
+namespace {
+
+void log_error(std::string const& text) {
+    megamol::core::utility::log::Log::DefaultLog.WriteError(("Screenshot_Service: " + text).c_str());
+}
+
+// ScreenshotImageData starts at the bottom-left pixel, all formats written here start at the top-left
+ScreenshotImageData::Pixel const* top_down_row(ScreenshotImageData const& image, size_t y) {
+    return image.image.data() + (image.height - 1 - y) * image.width;
+}
+
+bool write_file(std::filesystem::path const& filename, std::vector<std::uint8_t> const& bytes) {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        log_error("Cannot open output file " + filename.generic_string());
+        return false;
+    }
+    file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    if (!file) {
+        log_error("Cannot write output file " + filename.generic_string());
+        return false;
+    }
+    return true;
+}
+
+void put_u16_le(std::vector<std::uint8_t>& out, std::uint16_t v) {
+    out.push_back(v & 0xFF);
+    out.push_back(v >> 8);
+}
+
+void put_u32_le(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 0; i < 4; ++i) {
+        out.push_back((v >> (8 * i)) & 0xFF);
+    }
+}
+
+void put_u32_be(std::vector<std::uint8_t>& out, std::uint32_t v) {
+    for (int i = 3; i >= 0; --i) {
+        out.push_back((v >> (8 * i)) & 0xFF);
+    }
+}
+
+void put_png_chunk(std::vector<std::uint8_t>& out, char const* type, std::uint8_t const* data, size_t size) {
+    put_u32_be(out, static_cast<std::uint32_t>(size));
+    auto const type_begin = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    auto const crc = crc32(0, out.data() + type_begin, static_cast<uInt>(4 + size));
+    put_u32_be(out, static_cast<std::uint32_t>(crc));
+}
+
+// deflates [data, data+size) as raw deflate stream, byte-aligned at the end so that streams can be concatenated
+bool deflate_stripe(std::uint8_t const* data, size_t size, bool last, std::vector<std::uint8_t>& out) {
+    z_stream stream{};
+    if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    out.resize(deflateBound(&stream, static_cast<uLong>(size)) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(size);
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    auto const result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+    bool const ok = last ? (result == Z_STREAM_END) : (result == Z_OK);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+    return ok;
+}
+
+} // namespace
+
+
+megamol::frontend::screenshot::Format megamol::frontend::screenshot::format_for(std::filesystem::path const& filename) {
+    auto extension = filename.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return std::tolower(c); });
+
+    if (extension == ".qoi") {
+        return Format::QOI;
+    }
+    if (extension == ".tif" || extension == ".tiff") {
+        return Format::TIFF;
+    }
+    if (extension == ".raw") {
+        return Format::RAW;
+    }
+    return Format::PNG;
+}
+
+bool megamol::frontend::screenshot::write_image(ScreenshotImageData const& image, std::filesystem::path const& filename,
+    std::optional<std::string> const& project, unsigned int threads) {
+    switch (format_for(filename)) {
+    case Format::QOI:
+        return write_qoi(image, filename);
+    case Format::TIFF:
+        return write_tiff(image, filename);
+    case Format::RAW:
+        return write_raw(image, filename);
+    case Format::PNG:
+    default:
+        return write_png(image, filename, project, threads);
+    }
+}
+
+bool megamol::frontend::screenshot::write_png(ScreenshotImageData const& image, std::filesystem::path const& filename,
+    std::optional<std::string> const& project, unsigned int threads) {
+    constexpr size_t bytes_per_pixel = 4;
+    constexpr size_t min_stripe_bytes = 256 * 1024;
+    constexpr size_t max_idat_size = 1024 * 1024;
+
+    // filtered scanlines: filter byte 'Sub' followed by the differences to the left neighbors
+    size_t const row_bytes = 1 + image.width * bytes_per_pixel;
+    std::vector<std::uint8_t> scanlines(row_bytes * image.height);
+
+    size_t const rows_per_stripe = std::max<size_t>(1, min_stripe_bytes / row_bytes);
+    auto const stripe_count = static_cast<int64_t>((image.height + rows_per_stripe - 1) / rows_per_stripe);
+    std::vector<std::vector<std::uint8_t>> stripes(stripe_count);
+    std::vector<uLong> checksums(stripe_count);
+    std::atomic<bool> ok = true;
+
+#pragma omp parallel for schedule(dynamic) num_threads(std::max(1u, threads)) if (threads > 1 && stripe_count > 1)
+    for (int64_t s = 0; s < stripe_count; ++s) {
+        size_t const row_begin = s * rows_per_stripe;
+        size_t const row_end = std::min(row_begin + rows_per_stripe, image.height);
+
+        for (size_t y = row_begin; y < row_end; ++y) {
+            auto const* src = reinterpret_cast<std::uint8_t const*>(top_down_row(image, y));
+            auto* dst = scanlines.data() + y * row_bytes;
+            dst[0] = 1;
+            std::memcpy(dst + 1, src, bytes_per_pixel);
+            for (size_t i = bytes_per_pixel; i < image.width * bytes_per_pixel; ++i) {
+                dst[1 + i] = static_cast<std::uint8_t>(src[i] - src[i - bytes_per_pixel]);
+            }
+        }
+
+        auto const* begin = scanlines.data() + row_begin * row_bytes;
+        size_t const size = (row_end - row_begin) * row_bytes;
+        checksums[s] = adler32(adler32(0, nullptr, 0), begin, static_cast<uInt>(size));
+        if (!deflate_stripe(begin, size, s + 1 == stripe_count, stripes[s])) {
+            ok = false;
+        }
+    }
+
+    if (!ok) {
+        log_error("Cannot compress image data for " + filename.generic_string());
+        return false;
+    }
+
+    // zlib stream: header for fastest compression, concatenated stripes, combined checksum
+    std::vector<std::uint8_t> zlib_stream = {0x78, 0x01};
+    uLong checksum = adler32(0, nullptr, 0);
+    for (int64_t s = 0; s < stripe_count; ++s) {
+        zlib_stream.insert(zlib_stream.end(), stripes[s].begin(), stripes[s].end());
+        size_t const rows = std::min(rows_per_stripe, image.height - s * rows_per_stripe);
+        checksum = adler32_combine(checksum, checksums[s], static_cast<z_off_t>(rows * row_bytes));
+        std::vector<std::uint8_t>().swap(stripes[s]);
+    }
+    if (stripe_count == 0) {
+        // empty image, emit an empty final block
+        zlib_stream.insert(zlib_stream.end(), {0x03, 0x00});
+    }
+    put_u32_be(zlib_stream, static_cast<std::uint32_t>(checksum));
+
+    std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    png.reserve(zlib_stream.size() + 64 * 1024);
+
+    std::vector<std::uint8_t> header;
+    put_u32_be(header, static_cast<std::uint32_t>(image.width));
+    put_u32_be(header, static_cast<std::uint32_t>(image.height));
+    // bit depth, RGBA, deflate, adaptive filters, no interlace
+    header.insert(header.end(), {8, 6, 0, 0, 0});
+    put_png_chunk(png, "IHDR", header.data(), header.size());
+
+    // todo: camera settings are not stored without magic knowledge about the view
+    if (project.has_value()) {
+        megamol::core::utility::graphics::ScreenShotComments ssc(project.value());
+        for (auto const& comment : ssc.GetComments()) {
+            std::vector<std::uint8_t> text(comment.key, comment.key + std::strlen(comment.key));
+            text.push_back(0);
+            if (comment.compression == PNG_TEXT_COMPRESSION_zTXt) {
+                text.push_back(0); // deflate
+                uLongf size = compressBound(static_cast<uLong>(comment.text_length));
+                auto const offset = text.size();
+                text.resize(offset + size);
+                if (compress2(text.data() + offset, &size, reinterpret_cast<Bytef const*>(comment.text),
+                        static_cast<uLong>(comment.text_length), Z_BEST_SPEED) != Z_OK) {
+                    log_error("Cannot compress project for " + filename.generic_string());
+                    return false;
+                }
+                text.resize(offset + size);
+                put_png_chunk(png, "zTXt", text.data(), text.size());
+            } else {
+                text.insert(text.end(), comment.text, comment.text + comment.text_length);
+                put_png_chunk(png, "tEXt", text.data(), text.size());
+            }
+        }
+    }
+
+    for (size_t offset = 0; offset < zlib_stream.size(); offset += max_idat_size) {
+        put_png_chunk(
+            png, "IDAT", zlib_stream.data() + offset, std::min(max_idat_size, zlib_stream.size() - offset));
+    }
+    put_png_chunk(png, "IEND", nullptr, 0);
+
+    return write_file(filename, png);
+}
+
+bool megamol::frontend::screenshot::write_qoi(ScreenshotImageData const& image, std::filesystem::path const& filename) {
+    // see https://qoiformat.org/qoi-specification.pdf
+    constexpr std::uint8_t QOI_OP_INDEX = 0x00;
+    constexpr std::uint8_t QOI_OP_DIFF = 0x40;
+    constexpr std::uint8_t QOI_OP_LUMA = 0x80;
+    constexpr std::uint8_t QOI_OP_RUN = 0xc0;
+    constexpr std::uint8_t QOI_OP_RGB = 0xfe;
+    constexpr std::uint8_t QOI_OP_RGBA = 0xff;
+
+    std::vector<std::uint8_t> out = {'q', 'o', 'i', 'f'};
+    out.reserve(14 + image.width * image.height * 2 + 8);
+    put_u32_be(out, static_cast<std::uint32_t>(image.width));
+    put_u32_be(out, static_cast<std::uint32_t>(image.height));
+    out.push_back(4); // RGBA
+    out.push_back(0); // sRGB with linear alpha
+
+    using Pixel = ScreenshotImageData::Pixel;
+    std::array<Pixel, 64> index{};
+    for (auto& p : index) {
+        p = Pixel{0, 0, 0, 0};
+    }
+    auto hash = [](Pixel const& p) { return (p.r * 3 + p.g * 5 + p.b * 7 + p.a * 11) % 64; };
+    auto equal = [](Pixel const& a, Pixel const& b) { return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a; };
+
+    Pixel previous{0, 0, 0, 255};
+    int run = 0;
+    size_t const pixel_count = image.width * image.height;
+
+    for (size_t i = 0; i < pixel_count; ++i) {
+        Pixel const& pixel = top_down_row(image, i / image.width)[i % image.width];
+
+        if (equal(pixel, previous)) {
+            ++run;
+            if (run == 62 || i + 1 == pixel_count) {
+                out.push_back(QOI_OP_RUN | (run - 1));
+                run = 0;
+            }
+            continue;
+        }
+
+        if (run > 0) {
+            out.push_back(QOI_OP_RUN | (run - 1));
+            run = 0;
+        }
+
+        auto const position = hash(pixel);
+        if (equal(index[position], pixel)) {
+            out.push_back(QOI_OP_INDEX | position);
+        } else {
+            index[position] = pixel;
+
+            if (pixel.a == previous.a) {
+                auto const vr = static_cast<std::int8_t>(pixel.r - previous.r);
+                auto const vg = static_cast<std::int8_t>(pixel.g - previous.g);
+                auto const vb = static_cast<std::int8_t>(pixel.b - previous.b);
+                auto const vg_r = static_cast<std::int8_t>(vr - vg);
+                auto const vg_b = static_cast<std::int8_t>(vb - vg);
+
+                if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2) {
+                    out.push_back(QOI_OP_DIFF | (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2));
+                } else if (vg_r > -9 && vg_r < 8 && vg > -33 && vg < 32 && vg_b > -9 && vg_b < 8) {
+                    out.push_back(QOI_OP_LUMA | (vg + 32));
+                    out.push_back((vg_r + 8) << 4 | (vg_b + 8));
+                } else {
+                    out.insert(out.end(), {QOI_OP_RGB, pixel.r, pixel.g, pixel.b});
+                }
+            } else {
+                out.insert(out.end(), {QOI_OP_RGBA, pixel.r, pixel.g, pixel.b, pixel.a});
+            }
+        }
+        previous = pixel;
+    }
+
+    out.insert(out.end(), {0, 0, 0, 0, 0, 0, 0, 1});
+
+    return write_file(filename, out);
+}
+
+bool megamol::frontend::screenshot::write_tiff(
+    ScreenshotImageData const& image, std::filesystem::path const& filename) {
+    size_t const data_size = image.width * image.height * 4;
+    if (data_size > 0xFFFFFFFFull - 4096) {
+        log_error("Image too large for TIFF: " + filename.generic_string());
+        return false;
+    }
+
+    constexpr std::uint16_t entry_count = 11;
+    constexpr std::uint32_t ifd_offset = 8;
+    constexpr std::uint32_t bits_offset = ifd_offset + 2 + entry_count * 12 + 4;
+    constexpr std::uint32_t data_offset = bits_offset + 4 * 2;
+
+    enum Type : std::uint16_t { SHORT = 3, LONG = 4 };
+
+    std::vector<std::uint8_t> out = {'I', 'I', 42, 0};
+    out.reserve(data_offset + data_size);
+    put_u32_le(out, ifd_offset);
+
+    // baseline RGBA, one uncompressed strip, entries sorted by tag
+    put_u16_le(out, entry_count);
+    auto entry = [&out](std::uint16_t tag, Type type, std::uint32_t count, std::uint32_t value) {
+        put_u16_le(out, tag);
+        put_u16_le(out, type);
+        put_u32_le(out, count);
+        if (type == SHORT && count == 1) {
+            put_u16_le(out, static_cast<std::uint16_t>(value));
+            put_u16_le(out, 0);
+        } else {
+            put_u32_le(out, value);
+        }
+    };
+    entry(256, LONG, 1, static_cast<std::uint32_t>(image.width));  // ImageWidth
+    entry(257, LONG, 1, static_cast<std::uint32_t>(image.height)); // ImageLength
+    entry(258, SHORT, 4, bits_offset);                             // BitsPerSample
+    entry(259, SHORT, 1, 1);                                       // Compression: none
+    entry(262, SHORT, 1, 2);                                       // PhotometricInterpretation: RGB
+    entry(273, LONG, 1, data_offset);                              // StripOffsets
+    entry(277, SHORT, 1, 4);                                       // SamplesPerPixel
+    entry(278, LONG, 1, static_cast<std::uint32_t>(image.height)); // RowsPerStrip
+    entry(279, LONG, 1, static_cast<std::uint32_t>(data_size));    // StripByteCounts
+    entry(284, SHORT, 1, 1);                                       // PlanarConfiguration: chunky
+    entry(338, SHORT, 1, 2);                                       // ExtraSamples: unassociated alpha
+    put_u32_le(out, 0);                                            // no further IFD
+
+    for (int i = 0; i < 4; ++i) {
+        put_u16_le(out, 8);
+    }
+
+    for (size_t y = 0; y < image.height; ++y) {
+        auto const* row = reinterpret_cast<std::uint8_t const*>(top_down_row(image, y));
+        out.insert(out.end(), row, row + image.width * 4);
+    }
+
+    return write_file(filename, out);
+}
+
+bool megamol::frontend::screenshot::write_raw(ScreenshotImageData const& image, std::filesystem::path const& filename) {
+    std::vector<std::uint8_t> out;
+    out.reserve(image.width * image.height * 4);
+    for (size_t y = 0; y < image.height; ++y) {
+        auto const* row = reinterpret_cast<std::uint8_t const*>(top_down_row(image, y));
+        out.insert(out.end(), row, row + image.width * 4);
+    }
+    return write_file(filename, out);
+}
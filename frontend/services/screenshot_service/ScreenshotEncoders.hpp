@@ -0,0 +1,39 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+
+#include "Screenshots.h"
+
+namespace megamol::frontend::screenshot {
+
+enum class Format {
+    PNG,  // deflate-compressed, carries the project as metadata
+    QOI,  // "Quite OK Image" format, fast lossless compression
+    TIFF, // uncompressed baseline TIFF
+    RAW,  // RGBA8 pixels from the top-left, no header
+};
+
+// picks the format by file extension (.qoi, .tif/.tiff, .raw), defaults to PNG
+Format format_for(std::filesystem::path const& filename);
+
+// writes the image in the format matching the file name.
+// 'project' is stored in the metadata of PNG files, other formats drop it.
+// PNG compression is split into row stripes which are deflated by up to 'threads' threads.
+bool write_image(frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename,
+    std::optional<std::string> const& project, unsigned int threads = 1);
+
+bool write_png(frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename,
+    std::optional<std::string> const& project, unsigned int threads = 1);
+bool write_qoi(frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename);
+bool write_tiff(frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename);
+bool write_raw(frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename);
+
+} // namespace megamol::frontend::screenshot
@@ -6,18 +6,18 @@
 
 #include "Screenshot_Service.hpp"
 
-#include <png.h>
-#include <zlib.h>
+#include <algorithm>
+#include <thread>
 
+#include "AsyncScreenshotWriter.hpp"
 #include "GUIRegisterWindow.h"
 #include "GUIState.h"
 #include "ImageWrapper.h"
 #include "ImageWrapper_to_ByteArray.hpp"
 #include "OpenGL_Context.h"
+#include "ScreenshotEncoders.hpp"
 #include "mmcore/MegaMolGraph.h"
-#include "mmcore/utility/graphics/ScreenShotComments.h"
 #include "mmcore/utility/log/Log.h"
-#include "vislib/sys/FastFile.h"
 
 static std::shared_ptr<bool> service_open_popup = std::make_shared<bool>(false);
 static const std::string service_name = "Screenshot_Service: ";
@@ -51,81 +51,37 @@ static bool screenshot_show_privacy_note = true;
 
 unsigned char megamol::frontend::Screenshot_Service::default_alpha_value = 255;
 
-static void PNGAPI pngErrorFunc(png_structp pngPtr, png_const_charp msg) {
-    log("PNG Error: " + std::string(msg));
-}
-
-static void PNGAPI pngWarnFunc(png_structp pngPtr, png_const_charp msg) {
-    log("PNG Warning: " + std::string(msg));
-}
-
-static void PNGAPI pngWriteFileFunc(png_structp pngPtr, png_bytep buf, png_size_t size) {
-    vislib::sys::File* f = static_cast<vislib::sys::File*>(png_get_io_ptr(pngPtr));
-    f->Write(buf, size);
-}
-
-static void PNGAPI pngFlushFileFunc(png_structp pngPtr) {
-    vislib::sys::File* f = static_cast<vislib::sys::File*>(png_get_io_ptr(pngPtr));
-    f->Flush();
-}
+// encodes screenshots on worker threads once started, otherwise they are written on the render thread
+static megamol::frontend::screenshot::AsyncScreenshotWriter screenshot_writer;
 
-static bool write_png_to_file(
+static bool write_screenshot_to_file(
     megamol::frontend_resources::ScreenshotImageData const& image, std::filesystem::path const& filename) {
-    vislib::sys::FastFile file;
-    try {
-        // open final image file
-        if (!file.Open(filename.native().c_str(), vislib::sys::File::WRITE_ONLY, vislib::sys::File::SHARE_EXCLUSIVE,
-                vislib::sys::File::CREATE_OVERWRITE)) {
-            log("Cannot open output file" + filename.generic_string());
-            return false;
+    namespace screenshot = megamol::frontend::screenshot;
+
+    // only PNG files store the project. it has to be serialized here, the graph is not safe to access from workers.
+    std::optional<std::string> project;
+    if (screenshot::format_for(filename) == screenshot::Format::PNG) {
+        // todo: camera settings are not stored without magic knowledge about the view
+        project = megamolgraph_ptr->Convenience().SerializeGraph();
+        if (guistate_resources_ptr) {
+            project->append(guistate_resources_ptr->request_gui_state(true));
         }
-    } catch (...) {
-        log("Error/Exception opening output file" + filename.generic_string());
-        return false;
-    }
-
-    png_structp pngPtr = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, &pngErrorFunc, &pngWarnFunc);
-    if (!pngPtr) {
-        log("Cannot create png structure");
-        return false;
     }
 
-    png_infop pngInfoPtr = png_create_info_struct(pngPtr);
-    if (!pngInfoPtr) {
-        log("Cannot create png info");
-        return false;
+    bool result = true;
+    if (screenshot_writer.running()) {
+        // the render thread does not wait for the encoder, the workers log images they fail to write
+        screenshot_writer.push(image, filename, project);
+    } else {
+        result = screenshot::write_image(image, filename, project, std::max(1u, std::thread::hardware_concurrency()));
     }
 
-    png_set_write_fn(pngPtr, static_cast<void*>(&file), &pngWriteFileFunc, &pngFlushFileFunc);
-
-    png_set_compression_level(pngPtr, Z_BEST_SPEED);
-
-    // todo: camera settings are not stored without magic knowledge about the view
-    std::string project = megamolgraph_ptr->Convenience().SerializeGraph();
-    if (guistate_resources_ptr) {
-        project.append(guistate_resources_ptr->request_gui_state(true));
-    }
-    megamol::core::utility::graphics::ScreenShotComments ssc(project);
-    png_set_text(pngPtr, pngInfoPtr, ssc.GetComments().data(), ssc.GetComments().size());
-
-    png_set_IHDR(pngPtr, pngInfoPtr, image.width, image.height, 8, PNG_COLOR_TYPE_RGB_ALPHA /* PNG_COLOR_TYPE_RGB */,
-        PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
-
-    png_set_rows(
-        pngPtr, pngInfoPtr, const_cast<png_byte**>(reinterpret_cast<png_byte* const*>(image.flipped_rows.data())));
-
-    png_write_png(pngPtr, pngInfoPtr, PNG_TRANSFORM_IDENTITY, NULL);
-
-    png_destroy_write_struct(&pngPtr, &pngInfoPtr);
-
-    file.Close();
-
-    if (screenshot_show_privacy_note) {
+    if (result && project.has_value() && screenshot_show_privacy_note) {
         megamol::core::utility::log::Log::DefaultLog.WriteWarn("Screenshot: %s", privacy_note.c_str());
         if (service_open_popup != nullptr)
             *service_open_popup = true;
     }
-    return true;
+    return result;
 }
 
 megamol::frontend_resources::ImageWrapperScreenshotSource::ImageWrapperScreenshotSource(ImageWrapper const& image)
@@ -173,7 +129,7 @@ megamol::frontend_resources::ImageWrapperScreenshotSource::take_screenshot() con
 
 bool megamol::frontend_resources::ScreenshotImageDataToPNGWriter::write_image(
     ScreenshotImageData const& image, std::filesystem::path const& filename) const {
-    return write_png_to_file(image, filename);
+    return write_screenshot_to_file(image, filename);
 }
 
 namespace megamol::frontend {
@@ -204,6 +160,11 @@ bool Screenshot_Service::init(const Config& config) {
 
     screenshot_show_privacy_note = config.show_privacy_note;
 
+    if (config.writer_threads > 0) {
+        screenshot_writer.start(config.writer_threads, config.queue_length);
+        log("encoding screenshots on " + std::to_string(config.writer_threads) + " worker thread(s)");
+    }
+
     this->m_imagewrapperToPNG_trigger = [&](megamol::frontend_resources::ImageWrapper const& image,
                                             std::filesystem::path const& filename) -> bool {
         log("write screenshot to " + filename.generic_string());
@@ -215,7 +176,10 @@ bool Screenshot_Service::init(const Config& config) {
     return true;
 }
 
-void Screenshot_Service::close() {}
+void Screenshot_Service::close() {
+    // pending screenshots are still written
+    screenshot_writer.stop();
+}
 
 std::vector<FrontendResource>& Screenshot_Service::getProvidedResources() {
     this->m_providedResourceReferences = {{"GLScreenshotSource", m_frontbufferSource_resource},
@@ -17,6 +17,10 @@ class Screenshot_Service final : public AbstractFrontendService {
 public:
     struct Config {
         bool show_privacy_note;
+        // number of threads encoding screenshots in the background, 0 writes them on the render thread
+        unsigned int writer_threads = 0;
+        // number of screenshots waiting for encoding before taking another one blocks
+        unsigned int queue_length = 4;
     };
 
     std::string serviceName() const override {
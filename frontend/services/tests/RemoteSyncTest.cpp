@@ -0,0 +1,203 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <future>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <zmq.hpp>
+
+#include "HeadNode.hpp"
+#include "RenderNode.hpp"
+#include "comm/DistributedProto.h"
+
+#include "mmtest/Check.h"
+
+using megamol::frontend::Remote_Service;
+using namespace megamol::remote;
+using namespace std::chrono_literals;
+
+// The head node runs in this process, the render node in a second instance of this program started with
+// "render <data address> <request address>". Messages are "name=value" lines instead of Lua commands, a snapshot
+// starts with "clear".
+
+namespace {
+
+using State = std::map<std::string, std::string>;
+
+// enough parameters for the snapshot to be compressed
+constexpr int ParamCount = 200;
+constexpr int StepsBeforeGap = 50;
+constexpr int StepsAfterGap = 50;
+
+State initialState() {
+    State state;
+    for (int i = 0; i < ParamCount; ++i) {
+        state["param" + std::to_string(i)] = "0";
+    }
+    return state;
+}
+
+/** The delta of one step, as "name=value" */
+std::string changeOf(int step) {
+    return "param" + std::to_string((step * 7) % ParamCount) + "=" + std::to_string(step + 1);
+}
+
+void applyLine(State& state, std::string const& line) {
+    auto const pos = line.find('=');
+    if (pos != std::string::npos) {
+        state[line.substr(0, pos)] = line.substr(pos + 1);
+    }
+}
+
+State expectedState() {
+    auto state = initialState();
+    for (int step = 0; step < StepsBeforeGap + StepsAfterGap; ++step) {
+        applyLine(state, changeOf(step));
+    }
+    return state;
+}
+
+Message_t toMessage(std::string const& str) {
+    return Message_t(str.begin(), str.end());
+}
+
+Message_t snapshotOf(State const& state) {
+    std::string body = "clear\n";
+    for (auto const& [name, value] : state) {
+        body += name + "=" + value + "\n";
+    }
+    return toMessage(body);
+}
+
+/** An address on the loopback interface with a port that is free right now */
+std::string freeAddress() {
+    zmq::context_t context{1};
+    zmq::socket_t socket{context, zmq::socket_type::pull};
+    socket.bind("tcp://127.0.0.1:*");
+    char endpoint[1024];
+    size_t size = sizeof(endpoint);
+    socket.getsockopt(ZMQ_LAST_ENDPOINT, &endpoint, &size);
+    return std::string{endpoint};
+}
+
+int runRenderNode(std::string const& data_address, std::string const& request_address) {
+    Remote_Service::RenderNode node;
+    CHECK(node.start_receiver(data_address, request_address));
+
+    State state;
+    int snapshots = 0;
+    bool quit = false;
+    auto const deadline = std::chrono::steady_clock::now() + 30s;
+    while (!quit && std::chrono::steady_clock::now() < deadline) {
+        Message_t msgs;
+        if (!node.await_message(msgs, 100)) {
+            continue;
+        }
+        std::istringstream lines{std::string{msgs.begin(), msgs.end()}};
+        std::string line;
+        while (std::getline(lines, line)) {
+            if (line == "clear") {
+                state.clear();
+                ++snapshots;
+            } else if (line == "quit") {
+                quit = true;
+            } else {
+                applyLine(state, line);
+            }
+        }
+    }
+    node.close_receiver();
+
+    // one snapshot on join, one after the gap
+    CHECK(quit);
+    CHECK(snapshots >= 2);
+    CHECK(state.count("poison") == 0);
+    CHECK(state == expectedState());
+    return megamol::test::Result();
+}
+
+int runHeadNode(std::string const& program) {
+    auto const data_address = freeAddress();
+    auto const request_address = freeAddress();
+    auto render_node = std::async(std::launch::async, [&]() {
+        auto const command = "\"" + program + "\" render " + data_address + " " + request_address;
+        return std::system(command.c_str());
+    });
+
+    Remote_Service::HeadNode head;
+    CHECK(head.start_server(data_address, request_address, 5, true));
+
+    auto state = initialState();
+    auto const serve = [&]() {
+        if (head.snapshot_requested()) {
+            head.send_snapshot(snapshotOf(state));
+            return true;
+        }
+        return false;
+    };
+    auto const await_request = [&]() {
+        auto const deadline = std::chrono::steady_clock::now() + 10s;
+        while (!serve()) {
+            if (std::chrono::steady_clock::now() > deadline) {
+                return false;
+            }
+            std::this_thread::sleep_for(5ms);
+        }
+        return true;
+    };
+    auto const send_steps = [&](int begin, int end) {
+        for (int step = begin; step < end; ++step) {
+            applyLine(state, changeOf(step));
+            head.send(MessageType::PARAM_UPD_MSG, toMessage(changeOf(step)));
+            serve();
+            std::this_thread::sleep_for(2ms);
+        }
+    };
+
+    // the render node asks for the full state when it joins
+    CHECK(await_request());
+    send_steps(0, StepsBeforeGap);
+    std::this_thread::sleep_for(300ms);
+    serve();
+
+    // a message from the future makes the render node drop everything until the next snapshot
+    {
+        zmq::context_t context{1};
+        zmq::socket_t socket{context, zmq::socket_type::push};
+        socket.setsockopt(ZMQ_LINGER, 1000);
+        socket.connect(data_address);
+        Message_t gap;
+        auto const poison = toMessage("poison=1");
+        append_message(gap, MessageType::PARAM_UPD_MSG, 1000000, poison.data(), poison.size(), false);
+        socket.send(gap.begin(), gap.end());
+    }
+    CHECK(await_request());
+    send_steps(StepsBeforeGap, StepsBeforeGap + StepsAfterGap);
+
+    head.send(MessageType::LUA_CMD_MSG, toMessage("quit"));
+    while (render_node.wait_for(10ms) != std::future_status::ready) {
+        serve();
+    }
+    head.close_server();
+
+    CHECK(render_node.get() == 0);
+    return megamol::test::Result();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc == 4 && std::string{argv[1]} == "render") {
+        return runRenderNode(argv[2], argv[3]);
+    }
+    return runHeadNode(argv[0]);
+}
@@ -0,0 +1,258 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <png.h>
+
+#include "AsyncScreenshotWriter.hpp"
+#include "ScreenshotEncoders.hpp"
+#include "mmcore/utility/graphics/ScreenShotComments.h"
+
+#include "mmtest/Check.h"
+
+using megamol::frontend_resources::ScreenshotImageData;
+namespace screenshot = megamol::frontend::screenshot;
+
+namespace {
+
+/** Gradients with noise and flat areas, so that every QOI operation and several PNG stripes are used */
+ScreenshotImageData syntheticImage(size_t width, size_t height, std::uint32_t seed) {
+    ScreenshotImageData image;
+    image.resize(width, height);
+    for (size_t y = 0; y < height; ++y) {
+        for (size_t x = 0; x < width; ++x) {
+            seed = seed * 1664525u + 1013904223u;
+            auto& p = image.image[y * width + x];
+            if ((x / 64 + y / 64) % 3 == 0) {
+                p = {40, 80, 120, 255};
+            } else {
+                p.r = static_cast<std::uint8_t>(x + (seed >> 30));
+                p.g = static_cast<std::uint8_t>(y * 3);
+                p.b = static_cast<std::uint8_t>(seed >> 24);
+                p.a = static_cast<std::uint8_t>((x / 32) % 2 == 0 ? 255 : x + y);
+            }
+        }
+    }
+    return image;
+}
+
+/** RGBA bytes starting at the top-left pixel, as all formats store them */
+std::vector<std::uint8_t> topDown(ScreenshotImageData const& image) {
+    std::vector<std::uint8_t> bytes;
+    for (size_t y = image.height; y-- > 0;) {
+        auto const* row = reinterpret_cast<std::uint8_t const*>(image.image.data() + y * image.width);
+        bytes.insert(bytes.end(), row, row + image.width * 4);
+    }
+    return bytes;
+}
+
+std::vector<std::uint8_t> readFile(std::filesystem::path const& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+std::uint32_t getU32(std::vector<std::uint8_t> const& bytes, size_t offset, bool big_endian) {
+    std::uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        v |= static_cast<std::uint32_t>(bytes[offset + i]) << (8 * (big_endian ? 3 - i : i));
+    }
+    return v;
+}
+
+/** Decodes through libpng, which also verifies the chunk CRCs and the zlib checksum */
+std::vector<std::uint8_t> decodePNG(std::filesystem::path const& filename, size_t& width, size_t& height) {
+    png_image image{};
+    image.version = PNG_IMAGE_VERSION;
+    if (!png_image_begin_read_from_file(&image, filename.string().c_str())) {
+        return {};
+    }
+    image.format = PNG_FORMAT_RGBA;
+    std::vector<std::uint8_t> bytes(PNG_IMAGE_SIZE(image));
+    if (!png_image_finish_read(&image, nullptr, bytes.data(), 0, nullptr)) {
+        png_image_free(&image);
+        return {};
+    }
+    width = image.width;
+    height = image.height;
+    return bytes;
+}
+
+/** Reference decoder following https://qoiformat.org/qoi-specification.pdf */
+std::vector<std::uint8_t> decodeQOI(std::vector<std::uint8_t> const& in, size_t& width, size_t& height) {
+    if (in.size() < 22 || in[0] != 'q' || in[1] != 'o' || in[2] != 'i' || in[3] != 'f') {
+        return {};
+    }
+    width = getU32(in, 4, true);
+    height = getU32(in, 8, true);
+
+    std::uint8_t index[64][4] = {};
+    std::uint8_t px[4] = {0, 0, 0, 255};
+    std::vector<std::uint8_t> out;
+    size_t pos = 14;
+    int run = 0;
+    for (size_t i = 0; i < width * height; ++i) {
+        if (run > 0) {
+            --run;
+        } else if (pos < in.size() - 8) {
+            std::uint8_t const b = in[pos++];
+            if (b == 0xfe) {
+                px[0] = in[pos++];
+                px[1] = in[pos++];
+                px[2] = in[pos++];
+            } else if (b == 0xff) {
+                for (auto& c : px) {
+                    c = in[pos++];
+                }
+            } else if ((b & 0xc0) == 0x00) {
+                std::copy(index[b], index[b] + 4, px);
+            } else if ((b & 0xc0) == 0x40) {
+                px[0] += ((b >> 4) & 3) - 2;
+                px[1] += ((b >> 2) & 3) - 2;
+                px[2] += (b & 3) - 2;
+            } else if ((b & 0xc0) == 0x80) {
+                int const vg = (b & 0x3f) - 32;
+                std::uint8_t const b2 = in[pos++];
+                px[0] += vg - 8 + ((b2 >> 4) & 0x0f);
+                px[1] += vg;
+                px[2] += vg - 8 + (b2 & 0x0f);
+            } else {
+                run = b & 0x3f;
+            }
+            std::copy(px, px + 4, index[(px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) % 64]);
+        }
+        out.insert(out.end(), px, px + 4);
+    }
+    return out;
+}
+
+void checkPNG(std::filesystem::path const& dir, ScreenshotImageData const& image, unsigned int threads) {
+    auto const filename = dir / ("image_" + std::to_string(threads) + ".png");
+    std::string const project = "mmCreateView(\"test\", \"View3DGL\", \"::view\") -- " + std::to_string(threads);
+    CHECK(screenshot::write_image(image, filename, project, threads));
+
+    size_t width = 0, height = 0;
+    auto const pixels = decodePNG(filename, width, height);
+    CHECK(width == image.width && height == image.height);
+    CHECK(pixels == topDown(image));
+    CHECK(megamol::core::utility::graphics::ScreenShotComments::GetProjectFromPNG(filename) == project);
+}
+
+void checkQOI(std::filesystem::path const& dir, ScreenshotImageData const& image) {
+    auto const filename = dir / "image.qoi";
+    CHECK(screenshot::format_for(filename) == screenshot::Format::QOI);
+    CHECK(screenshot::write_image(image, filename, std::nullopt));
+
+    size_t width = 0, height = 0;
+    auto const pixels = decodeQOI(readFile(filename), width, height);
+    CHECK(width == image.width && height == image.height);
+    CHECK(pixels == topDown(image));
+}
+
+void checkTIFF(std::filesystem::path const& dir, ScreenshotImageData const& image) {
+    auto const filename = dir / "image.tiff";
+    CHECK(screenshot::format_for(filename) == screenshot::Format::TIFF);
+    CHECK(screenshot::write_image(image, filename, std::nullopt));
+
+    auto const bytes = readFile(filename);
+    CHECK(bytes.size() > 8 && bytes[0] == 'I' && bytes[1] == 'I' && bytes[2] == 42);
+    if (bytes.size() <= 8) {
+        return;
+    }
+
+    // find the single strip through the first IFD
+    size_t const ifd = getU32(bytes, 4, false);
+    size_t const entries = bytes[ifd] | bytes[ifd + 1] << 8;
+    size_t width = 0, height = 0, offset = 0, count = 0;
+    for (size_t e = 0; e < entries; ++e) {
+        size_t const entry = ifd + 2 + e * 12;
+        auto const tag = bytes[entry] | bytes[entry + 1] << 8;
+        auto const value = getU32(bytes, entry + 8, false);
+        width = tag == 256 ? value : width;
+        height = tag == 257 ? value : height;
+        offset = tag == 273 ? value : offset;
+        count = tag == 279 ? value : count;
+    }
+    CHECK(width == image.width && height == image.height);
+    CHECK(offset + count == bytes.size());
+    CHECK(count == image.width * image.height * 4);
+    if (offset + count == bytes.size()) {
+        CHECK(std::vector<std::uint8_t>(bytes.begin() + offset, bytes.end()) == topDown(image));
+    }
+}
+
+void checkRaw(std::filesystem::path const& dir, ScreenshotImageData const& image) {
+    auto const filename = dir / "image.raw";
+    CHECK(screenshot::format_for(filename) == screenshot::Format::RAW);
+    CHECK(screenshot::write_image(image, filename, std::nullopt));
+    CHECK(readFile(filename) == topDown(image));
+}
+
+/** More images than queue slots and workers, so that push() has to wait, and one image that cannot be written */
+void checkAsyncWriter(std::filesystem::path const& dir) {
+    screenshot::AsyncScreenshotWriter writer;
+    writer.start(2, 1);
+    CHECK(writer.running());
+
+    std::vector<ScreenshotImageData> images;
+    std::vector<std::future<bool>> results;
+    for (std::uint32_t i = 0; i < 8; ++i) {
+        images.push_back(syntheticImage(300 + 10 * i, 200, i));
+        auto const name = "async_" + std::to_string(i) + (i % 2 == 0 ? ".png" : ".qoi");
+        results.push_back(writer.push(images.back(), dir / name, std::string("project")));
+    }
+    auto failed = writer.push(images.front(), dir / "missing" / "directory" / "async.png", std::nullopt);
+
+    for (auto& result : results) {
+        CHECK(result.get());
+    }
+    CHECK(!failed.get());
+    writer.flush();
+    CHECK(writer.written() == 8);
+    CHECK(writer.failed() == 1);
+    writer.stop();
+    CHECK(!writer.running());
+
+    for (std::uint32_t i = 0; i < 8; i += 2) {
+        size_t width = 0, height = 0;
+        CHECK(decodePNG(dir / ("async_" + std::to_string(i) + ".png"), width, height) == topDown(images[i]));
+    }
+}
+
+} // namespace
+
+int main() {
+    auto const dir = std::filesystem::temp_directory_path() / "megamol_ScreenshotEncodersTest";
+    std::filesystem::remove_all(dir);
+    std::filesystem::create_directories(dir);
+
+    // spans several PNG stripes and IDAT chunks
+    auto const large = syntheticImage(1000, 700, 42);
+    for (unsigned int threads : {1u, 4u}) {
+        checkPNG(dir, large, threads);
+    }
+    checkQOI(dir, large);
+    checkTIFF(dir, large);
+    checkRaw(dir, large);
+
+    auto const tiny = syntheticImage(3, 1, 7);
+    checkPNG(dir, tiny, 4);
+    checkQOI(dir, tiny);
+
+    checkAsyncWriter(dir);
+
+    std::filesystem::remove_all(dir);
+
+    return megamol::test::Result();
+}
@@ -62,6 +62,16 @@ protected:
      */
     virtual bool manipulateExtent(C& outData, C& inData);
 
+    /**
+     * Prepares the request for the original data, called right before the data is requested
+     *
+     * @remarks the default implementation does nothing
+     *
+     * @param outData The call requesting the manipulated data
+     * @param inData The call about to request the original data
+     */
+    virtual void prepareDataRequest(C& outData, C& inData);
+
 private:
     /**
      * Called when the data is requested by this module
@@ -136,6 +146,10 @@ bool AbstractManipulator<C>::manipulateExtent(C& outData, C& inData) {
 }
 
 
+template<class C>
+void AbstractManipulator<C>::prepareDataRequest(C& outData, C& inData) {}
+
+
 template<class C>
 bool AbstractManipulator<C>::getDataCallback(megamol::core::Call& c) {
     auto outMpdc = dynamic_cast<C*>(&c);
@@ -147,6 +161,7 @@ bool AbstractManipulator<C>::getDataCallback(megamol::core::Call& c) {
         return false;
 
     *inMpdc = *outMpdc; // to get the correct request time
+    this->prepareDataRequest(*outMpdc, *inMpdc);
     if (!(*inMpdc)(0))
         return false;
 
@@ -0,0 +1,113 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "datatools/AbstractParticleManipulator.h"
+#include "geometry_calls/ParticleOperatorChain.h"
+#include "mmcore/param/ParamSlot.h"
+
+namespace megamol::datatools {
+
+/**
+ * Abstract class of point-wise particle manipulators that can be fused into one pass over the data.
+ *
+ * The manipulation is expressed as a geocalls::ParticleOperator. If the caller accepts deferred operators, the
+ * operator is appended to the chain of the input and passed on without touching the data. Otherwise a pending chain
+ * is materialized in one pass. Without any pending chain the module runs its own implementation.
+ */
+class AbstractParticleOperatorManipulator : public AbstractParticleManipulator {
+public:
+    /**
+     * Ctor
+     *
+     * @param outSlotName The name for the slot providing the manipulated data
+     * @param inSlotName The name for the slot accessing the original data
+     */
+    AbstractParticleOperatorManipulator(const char* outSlotName, const char* inSlotName);
+
+    /** Dtor */
+    ~AbstractParticleOperatorManipulator() override;
+
+protected:
+    /**
+     * Registers a parameter the operator depends on. A change of the parameter rebuilds the operator.
+     *
+     * @param slot The parameter slot
+     */
+    void addOperatorParam(core::param::ParamSlot& slot);
+
+    /**
+     * Answer the bounding box of the data the module answered with last, if it has been computed through the fused
+     * path
+     *
+     * @param box Receives the box of the materialized data, or an empty box if the operator has been deferred
+     *
+     * @return False if the last answer came from manipulateDataDirect
+     */
+    bool getFusedBBox(vislib::math::Cuboid<float>& box) const;
+
+    /**
+     * Creates the operator for the current parameter values. Must not change the state of the module, the operator
+     * may get discarded.
+     *
+     * @param inData The call holding the original data, including the operators still deferred on it
+     *
+     * @return The operator
+     */
+    virtual std::shared_ptr<geocalls::ParticleOperator const> createOperator(
+        geocalls::MultiParticleDataCall& inData) = 0;
+
+    /**
+     * Manipulates the particle data without any deferred operators involved
+     *
+     * @param outData The call receiving the manipulated data
+     * @param inData The call holding the original data
+     *
+     * @return True on success
+     */
+    virtual bool manipulateDataDirect(
+        geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) = 0;
+
+    void prepareDataRequest(
+        geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+
+    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+
+private:
+    /** The parameters the operator depends on */
+    std::vector<core::param::ParamSlot*> operatorParams;
+
+    /** The operator of this module for the current parameters and input */
+    std::shared_ptr<geocalls::ParticleOperator const> op;
+
+    /** The pending chain of the input the current chain was built on */
+    std::shared_ptr<geocalls::ParticleOperatorChain const> inChain;
+
+    /** The pending chain of the input with the operator of this module appended */
+    std::shared_ptr<geocalls::ParticleOperatorChain const> chain;
+
+    /** The materialized particle lists and their data */
+    std::vector<geocalls::SimpleSphericalParticles> lists;
+    std::vector<std::vector<float>> buffers;
+    vislib::math::Cuboid<float> bbox;
+    vislib::math::Cuboid<float> clipBox;
+    bool materialized;
+
+    /** True if the last request deferred the operator */
+    bool deferred;
+
+    /** True if the last request went through manipulateDataDirect */
+    bool direct;
+
+    size_t inDataHash;
+    size_t outDataHash;
+    unsigned int frameID;
+};
+
+} // namespace megamol::datatools
@@ -34,6 +34,17 @@ public:
     MultiParticleDataAdaptor(geocalls::MultiParticleDataCall& data);
     ~MultiParticleDataAdaptor();
 
+    /**
+     * Answer whether lists of the given data types are accessible through the adaptor. All other lists are skipped.
+     *
+     * @param vertexType The vertex data type of the list
+     * @param colourType The colour data type of the list
+     *
+     * @return True if the particles of the list are part of the adaptor
+     */
+    static bool IsSupported(geocalls::SimpleSphericalParticles::VertexDataType vertexType,
+        geocalls::SimpleSphericalParticles::ColourDataType colourType);
+
     inline size_t get_count() const {
         return count;
     }
@@ -0,0 +1,86 @@
+/*
+ * ParticleLODOrder.h
+ *
+ * Copyright (C) 2023 by MegaMol team
+ * Alle Rechte vorbehalten.
+ */
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry_calls/MultiParticleDataCall.h"
+
+namespace megamol::datatools {
+
+/**
+ * Progressive level-of-detail ordering of particle lists
+ *
+ * The particles of each list are copied once per frame into an interleaved buffer in an order in which every prefix
+ * is a spatially stratified subset of the whole list: the particles are sorted along a Morton curve and this sorted
+ * sequence is then traversed in bit-reversed rank order. Any thinning ratio is then served as a zero-copy prefix of
+ * the reordered buffer.
+ *
+ * @remarks: Positions, colours, directions and ids are carried over, the global attributes stay in the call.
+ */
+class ParticleLODOrder {
+public:
+    /**
+     * Reorders all lists of the call unless the buffers already hold the given frame and data hash.
+     *
+     * @param data The call holding the original data
+     *
+     * @return True if the ordering has been recomputed
+     */
+    bool Update(geocalls::MultiParticleDataCall& data);
+
+    /**
+     * Points a particle list to the first count particles of the reordered list idx.
+     *
+     * @param p The particle list receiving the data, global attributes are left untouched
+     * @param idx The index of the list in the call given to Update
+     * @param count The number of particles to provide, clamped to the list size
+     */
+    void Apply(geocalls::SimpleSphericalParticles& p, unsigned int idx, uint64_t count) const;
+
+    /** Answer the number of particles in the reordered list idx */
+    uint64_t GetCount(unsigned int idx) const {
+        return idx < lists.size() ? lists[idx].count : 0;
+    }
+
+    /** Frees the buffers */
+    void Clear();
+
+    /**
+     * Computes the progressive ordering of a particle list.
+     *
+     * @param p The particle list
+     *
+     * @return The permutation, element i holds the index of the particle to be placed at position i
+     */
+    static std::vector<uint64_t> ComputeOrder(geocalls::SimpleSphericalParticles const& p);
+
+private:
+    struct list_data {
+        std::vector<char> data;
+        uint64_t count = 0;
+        unsigned int stride = 0;
+        unsigned int colOffset = 0;
+        unsigned int dirOffset = 0;
+        unsigned int idOffset = 0;
+        geocalls::SimpleSphericalParticles::VertexDataType vertType = geocalls::SimpleSphericalParticles::VERTDATA_NONE;
+        geocalls::SimpleSphericalParticles::ColourDataType colType = geocalls::SimpleSphericalParticles::COLDATA_NONE;
+        geocalls::SimpleSphericalParticles::DirDataType dirType = geocalls::SimpleSphericalParticles::DIRDATA_NONE;
+        geocalls::SimpleSphericalParticles::IDDataType idType = geocalls::SimpleSphericalParticles::IDDATA_NONE;
+    };
+
+    std::vector<list_data> lists;
+
+    size_t dataHash = 0;
+
+    unsigned int frameID = 0;
+
+    bool valid = false;
+};
+
+} // namespace megamol::datatools
@@ -0,0 +1,51 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "geometry_calls/SimpleSphericalParticles.h"
+
+namespace megamol::datatools::misc {
+
+enum class CurveType : int { Morton = 0, Hilbert = 1 };
+
+/** Number of bits per axis of the 64 bit curve keys */
+constexpr unsigned int curve_bits_per_axis = 21;
+
+/**
+ * Interleaves the lower 21 bits of the three coordinates into a 63 bit Morton code, x being the least significant.
+ */
+uint64_t morton_code(uint32_t x, uint32_t y, uint32_t z);
+
+/**
+ * Computes the 63 bit index along a three-dimensional Hilbert curve of the lower 21 bits of the coordinates.
+ */
+uint64_t hilbert_code(uint32_t x, uint32_t y, uint32_t z);
+
+/**
+ * Computes the curve keys of all particles of a list. Positions are quantized into the bounding box of the list.
+ * Lists without positions yield their list order.
+ *
+ * @param p The particle list
+ * @param type The space-filling curve to use
+ *
+ * @return One key per particle
+ */
+std::vector<uint64_t> curve_keys(geocalls::SimpleSphericalParticles const& p, CurveType type);
+
+/**
+ * Stable parallel LSD radix sort of the indices of keys.
+ *
+ * @param keys The keys to sort by
+ *
+ * @return The permutation, element i holds the index of the key with rank i
+ */
+std::vector<uint64_t> sort_permutation(std::vector<uint64_t> const& keys);
+
+} // namespace megamol::datatools::misc
@@ -11,6 +11,7 @@
 #include "mmstd/data/AbstractGetDataCall.h"
 #include "vislib/String.h"
 #include "vislib/macro_utils.h"
+#include <optional>
 #include <string>
 #include <type_traits>
 
@@ -92,6 +93,20 @@ public:
         float maxVal;
     };
 
+    /**
+     * Hint of the caller that it only needs the rows whose value in a column lies within [minimum, maximum]. Sources
+     * may use it to skip blocks of rows outside of the range, but they are not required to filter the rows.
+     */
+    struct RowRangeHint {
+        std::string column;
+        float minimum;
+        float maximum;
+
+        inline bool operator==(const RowRangeHint& rhs) const {
+            return (column == rhs.column) && (minimum == rhs.minimum) && (maximum == rhs.maximum);
+        }
+    };
+
     TableDataCall();
     ~TableDataCall() override;
 
@@ -158,6 +173,14 @@ public:
         return this->frameID;
     }
 
+    inline void SetRowRangeHint(std::optional<RowRangeHint> hint) {
+        this->rowRangeHint = std::move(hint);
+    }
+
+    inline const std::optional<RowRangeHint>& GetRowRangeHint() const {
+        return this->rowRangeHint;
+    }
+
     inline void AssertColumnInfos() {
         for (int c = 0; c < columns_count; ++c) {
             const auto& column = columns[c];
@@ -176,6 +199,8 @@ private:
     const float* data; // data is stored row major order, aka array of structs
     unsigned int frameCount;
     unsigned int frameID;
+    VISLIB_MSVC_SUPPRESS_WARNING(4251)
+    std::optional<RowRangeHint> rowRangeHint;
 };
 
 typedef core::factories::CallAutoDescription<TableDataCall> TableDataCallDescription;
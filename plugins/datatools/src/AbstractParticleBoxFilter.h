@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include "datatools/AbstractManipulator.h"
+#include "geometry_calls/ParticleBulkAccess.h"
 #include "mmcore/param/ParamSlot.h"
 #include "mmcore/param/StringParam.h"
 #include "vislib/StringTokeniser.h"
@@ -176,17 +177,19 @@ bool AbstractParticleBoxFilter<T>::manipulateData(T& outData, T& inData) {
         auto& cur_numPts = numPts_[plidx];
         auto& cur_stride = stride_[plidx];
 
-        auto const& store = part.GetParticleStore();
-        auto const& xacc = store.GetXAcc();
-        auto const& yacc = store.GetYAcc();
-        auto const& zacc = store.GetZAcc();
-
-        for (size_t pidx = 0; pidx < pcount; ++pidx) {
-            // check for each particle whether it is contained within the box
-            vislib::math::Point<float, 3> pt(xacc->Get_f(pidx), yacc->Get_f(pidx), zacc->Get_f(pidx));
-            if (box.Contains(pt, true)) {
-                std::copy(base_ptr + pidx * stride, base_ptr + (pidx + 1) * stride, cur_data_ptr + cur_numPts * stride);
-                ++cur_numPts;
+        std::array<std::array<float, geocalls::ParticleBatchSize>, 3> pos;
+        for (size_t first = 0; first < pcount; first += geocalls::ParticleBatchSize) {
+            size_t const num = std::min<size_t>(geocalls::ParticleBatchSize, pcount - first);
+            geocalls::UnpackPositions(part, first, num, pos[0].data(), pos[1].data(), pos[2].data());
+            for (size_t i = 0; i < num; ++i) {
+                // check for each particle whether it is contained within the box
+                vislib::math::Point<float, 3> pt(pos[0][i], pos[1][i], pos[2][i]);
+                if (box.Contains(pt, true)) {
+                    auto const pidx = first + i;
+                    std::copy(
+                        base_ptr + pidx * stride, base_ptr + (pidx + 1) * stride, cur_data_ptr + cur_numPts * stride);
+                    ++cur_numPts;
+                }
             }
         }
 
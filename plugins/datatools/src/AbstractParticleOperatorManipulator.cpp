@@ -0,0 +1,174 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+#include "datatools/AbstractParticleOperatorManipulator.h"
+
+using namespace megamol;
+
+
+/*
+ * datatools::AbstractParticleOperatorManipulator::AbstractParticleOperatorManipulator
+ */
+datatools::AbstractParticleOperatorManipulator::AbstractParticleOperatorManipulator(
+    const char* outSlotName, const char* inSlotName)
+        : AbstractParticleManipulator(outSlotName, inSlotName)
+        , operatorParams()
+        , op()
+        , inChain()
+        , chain()
+        , lists()
+        , buffers()
+        , bbox()
+        , clipBox()
+        , materialized(false)
+        , deferred(false)
+        , direct(true)
+        , inDataHash(0)
+        , outDataHash(0)
+        , frameID(0) {
+    // intentionally empty
+}
+
+
+/*
+ * datatools::AbstractParticleOperatorManipulator::~AbstractParticleOperatorManipulator
+ */
+datatools::AbstractParticleOperatorManipulator::~AbstractParticleOperatorManipulator() {
+    this->Release();
+}
+
+
+/*
+ * datatools::AbstractParticleOperatorManipulator::addOperatorParam
+ */
+void datatools::AbstractParticleOperatorManipulator::addOperatorParam(core::param::ParamSlot& slot) {
+    this->operatorParams.push_back(&slot);
+}
+
+
+/*
+ * datatools::AbstractParticleOperatorManipulator::getFusedBBox
+ */
+bool datatools::AbstractParticleOperatorManipulator::getFusedBBox(vislib::math::Cuboid<float>& box) const {
+    if (this->direct) {
+        return false;
+    }
+    if (this->deferred || !this->materialized) {
+        box.SetNull();
+    } else {
+        box = this->bbox;
+    }
+    return true;
+}
+
+
+/*
+ * datatools::AbstractParticleOperatorManipulator::prepareDataRequest
+ */
+void datatools::AbstractParticleOperatorManipulator::prepareDataRequest(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+    inData.SetAcceptDeferredOperators(true);
+    inData.SetDeferredOperators(nullptr);
+}
+
+
+/*
+ * datatools::AbstractParticleOperatorManipulator::manipulateData
+ */
+bool datatools::AbstractParticleOperatorManipulator::manipulateData(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+    auto const upstream = inData.GetDeferredOperators();
+    bool const defer = outData.AcceptsDeferredOperators();
+
+    if (!upstream && !defer) {
+        if (!this->direct) {
+            // parameter changes have been consumed by the fused path
+            for (auto* slot : this->operatorParams) {
+                slot->ForceSetDirty();
+            }
+            this->direct = true;
+        }
+        outData.SetDeferredOperators(nullptr);
+        this->deferred = false;
+        return this->manipulateDataDirect(outData, inData);
+    }
+
+    bool paramsDirty = false;
+    for (auto* slot : this->operatorParams) {
+        paramsDirty = paramsDirty || slot->IsDirty();
+    }
+    if (this->direct || !this->chain || paramsDirty || (inData.DataHash() != this->inDataHash) ||
+        (inData.DataHash() == 0) || (inData.FrameID() != this->frameID) || (upstream != this->inChain)) {
+        for (auto* slot : this->operatorParams) {
+            slot->ResetDirty();
+        }
+        this->direct = false;
+        this->inDataHash = inData.DataHash();
+        this->frameID = inData.FrameID();
+        this->inChain = upstream;
+
+        this->op = this->createOperator(inData);
+        auto const base = upstream ? upstream
+                                   : std::make_shared<geocalls::ParticleOperatorChain const>(
+                                         inData.GetBoundingBoxes().ObjectSpaceBBox());
+        this->chain = base->Append(this->op);
+        this->materialized = false;
+        ++this->outDataHash;
+    }
+
+    outData = inData;                   // also transfers the unlocker to 'outData'
+    inData.SetUnlocker(nullptr, false); // keep original data locked
+                                        // original data will be unlocked through outData
+    outData.SetFrameID(this->frameID);
+    outData.SetDataHash(this->outDataHash);
+    this->deferred = defer;
+
+    if (defer) {
+        // the input boxes already account for the operators deferred upstream
+        auto& boxes = outData.AccessBoundingBoxes();
+        auto box = boxes.ObjectSpaceBBox();
+        this->op->TransformBBox(box);
+        boxes.SetObjectSpaceBBox(box);
+        box = boxes.ObjectSpaceClipBox();
+        this->op->TransformBBox(box);
+        boxes.SetObjectSpaceClipBox(box);
+        for (unsigned int i = 0; i < outData.GetParticleListCount(); ++i) {
+            auto& p = outData.AccessParticles(i);
+            box = p.GetBBox();
+            this->op->TransformBBox(box);
+            p.SetBBox(box);
+        }
+        outData.SetDeferredOperators(this->chain);
+        return true;
+    }
+
+    unsigned int const plc = outData.GetParticleListCount();
+    if (!this->materialized) {
+        this->chain->Materialize(outData, this->buffers);
+        this->lists.resize(plc);
+        for (unsigned int i = 0; i < plc; ++i) {
+            this->lists[i] = outData.AccessParticles(i);
+        }
+        this->bbox = outData.AccessBoundingBoxes().ObjectSpaceBBox();
+        this->clipBox = outData.AccessBoundingBoxes().ObjectSpaceClipBox();
+        this->materialized = true;
+    } else {
+        // point the fresh copies of the input lists to the materialized data again
+        for (unsigned int i = 0; i < plc && i < this->lists.size(); ++i) {
+            auto& p = outData.AccessParticles(i);
+            auto const& l = this->lists[i];
+            p.SetVertexData(l.GetVertexDataType(), l.GetVertexData(), l.GetVertexDataStride());
+            p.SetColourData(l.GetColourDataType(), l.GetColourData(), l.GetColourDataStride());
+            p.SetGlobalRadius(l.GetGlobalRadius());
+            p.SetColourMapIndexValues(l.GetMinColourIndexValue(), l.GetMaxColourIndexValue());
+            p.SetBBox(l.GetBBox());
+        }
+        outData.AccessBoundingBoxes().SetObjectSpaceBBox(this->bbox);
+        outData.AccessBoundingBoxes().SetObjectSpaceClipBox(this->clipBox);
+    }
+    outData.SetDeferredOperators(nullptr);
+
+    return true;
+}
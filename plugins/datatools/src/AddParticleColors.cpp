@@ -1,5 +1,6 @@
 #include "AddParticleColors.h"
 
+#include "geometry_calls/ParticleBulkAccess.h"
 #include "mmstd/renderer/CallGetTransferFunction.h"
 
 
@@ -84,14 +85,16 @@ bool megamol::datatools::AddParticleColors::manipulateData(
             col_vec.resize(p_count);
 
 
-            auto const iAcc = parts.GetParticleStore().GetCRAcc();
-
-            for (std::size_t pidx = 0; pidx < p_count; ++pidx) {
-                auto const col = iAcc->Get_f(pidx);
-                auto const val = (col - min_i) * fac_i * static_cast<float>(tf_size);
-                std::remove_const_t<decltype(val)> main = 0;
-                auto rest = std::modf(val, &main);
-                col_vec[pidx].rgba = sample_tf(tf, tf_size, static_cast<int>(main), rest);
+            std::array<float, geocalls::ParticleBatchSize> icol;
+            for (std::size_t first = 0; first < p_count; first += geocalls::ParticleBatchSize) {
+                std::size_t const num = std::min<std::size_t>(geocalls::ParticleBatchSize, p_count - first);
+                geocalls::UnpackColours(parts, first, num, icol.data());
+                for (std::size_t i = 0; i < num; ++i) {
+                    auto const val = (icol[i] - min_i) * fac_i * static_cast<float>(tf_size);
+                    std::remove_const_t<decltype(val)> main = 0;
+                    auto rest = std::modf(val, &main);
+                    col_vec[first + i].rgba = sample_tf(tf, tf_size, static_cast<int>(main), rest);
+                }
             }
         }
 
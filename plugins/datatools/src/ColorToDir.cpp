@@ -1,5 +1,7 @@
 #include "ColorToDir.h"
 
+#include "geometry_calls/ParticleBulkAccess.h"
+
 
 megamol::datatools::ColorToDir::ColorToDir() : AbstractParticleManipulator("outData", "inData") {}
 
@@ -31,16 +33,17 @@ bool megamol::datatools::ColorToDir::manipulateData(
                 auto& data = data_[pl_idx];
                 auto const p_count = parts.GetCount();
 
-                auto const dx_acc = parts.GetParticleStore().GetCRAcc();
-                auto const dy_acc = parts.GetParticleStore().GetCGAcc();
-                auto const dz_acc = parts.GetParticleStore().GetCBAcc();
-
                 data.resize(3 * p_count);
 
-                for (std::remove_cv_t<decltype(p_count)> p_idx = 0; p_idx < p_count; ++p_idx) {
-                    data[p_idx * 3 + 0] = dx_acc->Get_f(p_idx);
-                    data[p_idx * 3 + 1] = dy_acc->Get_f(p_idx);
-                    data[p_idx * 3 + 2] = dz_acc->Get_f(p_idx);
+                std::array<std::array<float, geocalls::ParticleBatchSize>, 3> dir;
+                for (size_t first = 0; first < p_count; first += geocalls::ParticleBatchSize) {
+                    size_t const num = std::min<size_t>(geocalls::ParticleBatchSize, p_count - first);
+                    geocalls::UnpackColours(parts, first, num, dir[0].data(), dir[1].data(), dir[2].data());
+                    for (size_t i = 0; i < num; ++i) {
+                        data[(first + i) * 3 + 0] = dir[0][i];
+                        data[(first + i) * 3 + 1] = dir[1][i];
+                        data[(first + i) * 3 + 2] = dir[2][i];
+                    }
                 }
 
                 parts.SetDirData(geocalls::SimpleSphericalParticles::DIRDATA_FLOAT_XYZ, data.data());
@@ -12,9 +12,55 @@
 using namespace megamol;
 using namespace megamol::datatools;
 
+namespace {
+
+/** Inverts the intensities within the colour range over all lists, all lists get intensities like in the module */
+class IColInverseOperator : public geocalls::ParticleOperator {
+public:
+    unsigned int Writes() const override {
+        return ATTR_COLOUR;
+    }
+
+    bool UsesColourRange() const override {
+        return true;
+    }
+
+    void Configure(std::vector<geocalls::ParticleListState>& states) const override {
+        float minCol = 0.0f, maxCol = 1.0f;
+        for (size_t list = 0; list < states.size(); ++list) {
+            float cMin = states[list].minColI;
+            float cMax = states[list].maxColI;
+            if (cMin > cMax)
+                std::swap(cMin, cMax);
+            if (list == 0) {
+                minCol = cMin;
+                maxCol = cMax;
+            } else {
+                minCol = std::min(minCol, cMin);
+                maxCol = std::max(maxCol, cMax);
+            }
+        }
+        for (auto& s : states) {
+            s.colourType = geocalls::SimpleSphericalParticles::COLDATA_FLOAT_I;
+            s.minColI = minCol;
+            s.maxColI = maxCol;
+        }
+    }
+
+    void Apply(geocalls::ParticleBatch& batch, geocalls::ParticleListState const& in,
+        geocalls::ParticleListState const& out) const override {
+        float const sum = out.minColI + out.maxColI;
+        for (size_t i = 0; i < batch.count; ++i) {
+            batch.cr[i] = sum - batch.cr[i];
+        }
+    }
+};
+
+} // namespace
+
 
 IColInverse::IColInverse()
-        : datatools::AbstractParticleManipulator("outData", "inData")
+        : datatools::AbstractParticleOperatorManipulator("outData", "inData")
         , dataHash(0)
         , frameID(0)
         , colors()
@@ -27,7 +73,12 @@ IColInverse::~IColInverse() {
     Release();
 }
 
-bool IColInverse::manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+std::shared_ptr<geocalls::ParticleOperator const> IColInverse::createOperator(geocalls::MultiParticleDataCall& inData) {
+    return std::make_shared<IColInverseOperator>();
+}
+
+bool IColInverse::manipulateDataDirect(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
 
     outData = inData;
     inData.SetUnlocker(nullptr, false);
@@ -6,12 +6,12 @@
  */
 #pragma once
 
-#include "datatools/AbstractParticleManipulator.h"
+#include "datatools/AbstractParticleOperatorManipulator.h"
 #include <vector>
 
 namespace megamol::datatools {
 
-class IColInverse : public datatools::AbstractParticleManipulator {
+class IColInverse : public datatools::AbstractParticleOperatorManipulator {
 public:
     static const char* ClassName() {
         return "IColInverse";
@@ -27,7 +27,9 @@ public:
     ~IColInverse() override;
 
 protected:
-    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+    std::shared_ptr<geocalls::ParticleOperator const> createOperator(geocalls::MultiParticleDataCall& inData) override;
+    bool manipulateDataDirect(
+        geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
 
 private:
     size_t dataHash;
@@ -9,13 +9,56 @@
 #include "mmcore/param/FloatParam.h"
 #include "vislib/math/ShallowVector.h"
 #include <algorithm>
+#include <limits>
 
 using namespace megamol;
 using namespace megamol::datatools;
 
+namespace {
+
+/**
+ * Leaves the data untouched and sets the colour range of all lists to the range of the colour values of the lists the
+ * module sees through the MultiParticleDataAdaptor
+ */
+class IColRangeFixOperator : public geocalls::ParticleOperator {
+public:
+    unsigned int Writes() const override {
+        return ATTR_NONE;
+    }
+
+    bool ReducesColourRange() const override {
+        return true;
+    }
+
+    void Apply(geocalls::ParticleBatch& batch, geocalls::ParticleListState const& in,
+        geocalls::ParticleListState const& out) const override {}
+
+    void SetReducedRange(std::vector<geocalls::ParticleListState> const& in,
+        std::vector<geocalls::ParticleListState>& out, std::vector<std::array<float, 2>> const& ranges) const override {
+        float minCol = std::numeric_limits<float>::max();
+        float maxCol = std::numeric_limits<float>::lowest();
+        for (size_t i = 0; i < ranges.size(); ++i) {
+            if (!datatools::MultiParticleDataAdaptor::IsSupported(in[i].vertexType, in[i].colourType))
+                continue;
+            minCol = std::min(minCol, ranges[i][0]);
+            maxCol = std::max(maxCol, ranges[i][1]);
+        }
+        if (minCol > maxCol) {
+            minCol = 0.0f;
+            maxCol = 1.0f;
+        }
+        for (auto& s : out) {
+            s.minColI = minCol;
+            s.maxColI = maxCol;
+        }
+    }
+};
+
+} // namespace
+
 
 IColRangeFix::IColRangeFix()
-        : datatools::AbstractParticleManipulator("outData", "inDataA")
+        : datatools::AbstractParticleOperatorManipulator("outData", "inDataA")
         , hash(0)
         , frameID(0)
         , minCol(0.0f)
@@ -27,7 +70,13 @@ IColRangeFix::~IColRangeFix() {
     Release();
 }
 
-bool IColRangeFix::manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+std::shared_ptr<geocalls::ParticleOperator const> IColRangeFix::createOperator(
+    geocalls::MultiParticleDataCall& inData) {
+    return std::make_shared<IColRangeFixOperator>();
+}
+
+bool IColRangeFix::manipulateDataDirect(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
 
     if ((hash != inData.DataHash()) || (inData.DataHash() == 0) || (frameID != inData.FrameID())) {
         // Update data
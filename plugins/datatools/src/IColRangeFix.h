@@ -6,11 +6,11 @@
  */
 #pragma once
 
-#include "datatools/AbstractParticleManipulator.h"
+#include "datatools/AbstractParticleOperatorManipulator.h"
 
 namespace megamol::datatools {
 
-class IColRangeFix : public datatools::AbstractParticleManipulator {
+class IColRangeFix : public datatools::AbstractParticleOperatorManipulator {
 public:
     static const char* ClassName() {
         return "IColRangeFix";
@@ -26,7 +26,9 @@ public:
     ~IColRangeFix() override;
 
 protected:
-    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+    std::shared_ptr<geocalls::ParticleOperator const> createOperator(geocalls::MultiParticleDataCall& inData) override;
+    bool manipulateDataDirect(
+        geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
 
 private:
     size_t hash;
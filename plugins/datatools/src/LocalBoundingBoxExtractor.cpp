@@ -1,4 +1,9 @@
 #include "LocalBoundingBoxExtractor.h"
+
+#include <algorithm>
+#include <array>
+
+#include "geometry_calls/ParticleBulkAccess.h"
 #include "mmcore/param/ColorParam.h"
 #include "mmcore/utility/ColourParser.h"
 #include "vislib/math/Cuboid.h"
@@ -256,13 +261,19 @@ void LocalBoundingBoxExtractor::calcLocalBox(
     if (!(parts.GetCount() > 0))
         return;
 
-    for (int i = 0; i < parts.GetCount(); i++) {
-        box.SetLeft(std::min(box.GetLeft(), parts.GetParticleStore().GetXAcc()->Get_f(i)));
-        box.SetRight(std::max(box.GetRight(), parts.GetParticleStore().GetXAcc()->Get_f(i)));
-        box.SetBottom(std::min(box.GetBottom(), parts.GetParticleStore().GetYAcc()->Get_f(i)));
-        box.SetTop(std::max(box.GetTop(), parts.GetParticleStore().GetYAcc()->Get_f(i)));
-        box.SetFront(std::min(box.GetFront(), parts.GetParticleStore().GetZAcc()->Get_f(i)));
-        box.SetBack(std::max(box.GetBack(), parts.GetParticleStore().GetZAcc()->Get_f(i)));
+    std::array<std::array<float, geocalls::ParticleBatchSize>, 3> pos;
+    auto const cnt = static_cast<size_t>(parts.GetCount());
+    for (size_t first = 0; first < cnt; first += geocalls::ParticleBatchSize) {
+        size_t const num = std::min(geocalls::ParticleBatchSize, cnt - first);
+        geocalls::UnpackPositions(parts, first, num, pos[0].data(), pos[1].data(), pos[2].data());
+        for (size_t i = 0; i < num; ++i) {
+            box.SetLeft(std::min(box.GetLeft(), pos[0][i]));
+            box.SetRight(std::max(box.GetRight(), pos[0][i]));
+            box.SetBottom(std::min(box.GetBottom(), pos[1][i]));
+            box.SetTop(std::max(box.GetTop(), pos[1][i]));
+            box.SetFront(std::min(box.GetFront(), pos[2][i]));
+            box.SetBack(std::max(box.GetBack(), pos[2][i]));
+        }
     }
 }
 
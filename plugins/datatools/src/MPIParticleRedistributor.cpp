@@ -0,0 +1,475 @@
+/*
+ * MPIParticleRedistributor.cpp
+ *
+ * Copyright (C) 2023 by MegaMol Team
+ * Alle Rechte vorbehalten.
+ */
+#include "MPIParticleRedistributor.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstring>
+#include <limits>
+
+#include "cluster/mpi/MpiCall.h"
+#include "geometry_calls/ParticleBulkAccess.h"
+#include "mmcore/param/EnumParam.h"
+#include "mmcore/param/FloatParam.h"
+#include "mmcore/utility/log/Log.h"
+#include "vislib/sys/SystemInformation.h"
+
+#include "ParticleDecomposition.h"
+
+using namespace megamol;
+using namespace megamol::datatools::redistribution;
+
+#ifdef MEGAMOL_USE_MPI
+namespace {
+
+/**
+ * Sorts the indices of records by destination rank.
+ *
+ * @param dest The destination of every record
+ * @param order Receives the record indices grouped by destination
+ * @param counts Receives the number of records per destination
+ */
+void group_by_rank(
+    std::vector<int> const& dest, int size, std::vector<uint64_t>& order, std::vector<uint64_t>& counts) {
+    counts.assign(size, 0);
+    for (auto const r : dest) {
+        ++counts[r];
+    }
+    std::vector<uint64_t> offsets(size, 0);
+    for (int r = 1; r < size; ++r) {
+        offsets[r] = offsets[r - 1] + counts[r - 1];
+    }
+    order.resize(dest.size());
+    for (size_t i = 0; i < dest.size(); ++i) {
+        order[offsets[dest[i]]++] = i;
+    }
+}
+
+/**
+ * Sends records to the other ranks with MPI_Alltoallv, all ranks have to use the same stride.
+ *
+ * @param records The records to send from
+ * @param order The records to send, grouped by destination
+ * @param counts The number of records per destination
+ * @param out Receives the records from all ranks in rank order
+ *
+ * @return false on all ranks if the counts of any rank exceed the range of MPI
+ */
+bool exchange_records(MPI_Comm comm, int size, char const* records, unsigned int stride,
+    std::vector<uint64_t> const& order, std::vector<uint64_t> const& counts, std::vector<char>& out) {
+    std::vector<uint64_t> recv_counts(size);
+    MPI_Alltoall(counts.data(), 1, MPI_UINT64_T, recv_counts.data(), 1, MPI_UINT64_T, comm);
+
+    // displacements are counted in records of type int
+    uint64_t send_total = 0, recv_total = 0;
+    std::vector<int> scounts(size), sdispls(size), rcounts(size), rdispls(size);
+    for (int r = 0; r < size; ++r) {
+        sdispls[r] = static_cast<int>(send_total);
+        rdispls[r] = static_cast<int>(recv_total);
+        scounts[r] = static_cast<int>(counts[r]);
+        rcounts[r] = static_cast<int>(recv_counts[r]);
+        send_total += counts[r];
+        recv_total += recv_counts[r];
+    }
+    int too_large = std::max(send_total, recv_total) > static_cast<uint64_t>(std::numeric_limits<int>::max());
+    MPI_Allreduce(MPI_IN_PLACE, &too_large, 1, MPI_INT, MPI_LOR, comm);
+    if (too_large) {
+        return false;
+    }
+
+    std::vector<char> send(send_total * stride);
+#pragma omp parallel for
+    for (int64_t i = 0; i < static_cast<int64_t>(order.size()); ++i) {
+        std::memcpy(send.data() + i * stride, records + order[i] * stride, stride);
+    }
+    out.resize(recv_total * stride);
+
+    MPI_Datatype record;
+    MPI_Type_contiguous(static_cast<int>(stride), MPI_BYTE, &record);
+    MPI_Type_commit(&record);
+    MPI_Alltoallv(send.data(), scounts.data(), sdispls.data(), record, out.data(), rcounts.data(), rdispls.data(),
+        record, comm);
+    MPI_Type_free(&record);
+
+    return true;
+}
+
+/** Unpacks the interleaved positions of a particle list */
+std::vector<float> unpack_positions(geocalls::SimpleSphericalParticles const& p) {
+    auto const cnt = p.GetCount();
+    std::vector<float> pos(3 * cnt);
+    auto const num_batches =
+        static_cast<int64_t>((cnt + geocalls::ParticleBatchSize - 1) / geocalls::ParticleBatchSize);
+#pragma omp parallel
+    {
+        std::array<std::array<float, geocalls::ParticleBatchSize>, 3> batch;
+#pragma omp for
+        for (int64_t b = 0; b < num_batches; ++b) {
+            size_t const first = b * geocalls::ParticleBatchSize;
+            size_t const num = std::min(geocalls::ParticleBatchSize, cnt - first);
+            geocalls::UnpackPositions(p, first, num, batch[0].data(), batch[1].data(), batch[2].data());
+            for (size_t i = 0; i < num; ++i) {
+                for (int d = 0; d < 3; ++d) {
+                    pos[3 * (first + i) + d] = batch[d][i];
+                }
+            }
+        }
+    }
+    return pos;
+}
+
+} // namespace
+#endif /* MEGAMOL_USE_MPI */
+
+
+/*
+ * datatools::MPIParticleRedistributor::MPIParticleRedistributor
+ */
+datatools::MPIParticleRedistributor::MPIParticleRedistributor()
+        : AbstractParticleManipulator("outData", "indata")
+        , callRequestMpi("requestMpi", "Requests initialisation of MPI and the communicator for the view.")
+        , decompositionSlot("decomposition", "The spatial decomposition assigning a region to every rank")
+        , ghostWidthSlot("ghostWidth", "Particles within this distance of another rank are copied there as ghosts") {
+
+    this->callRequestMpi.SetCompatibleCall<core::cluster::mpi::MpiCallDescription>();
+    this->MakeSlotAvailable(&this->callRequestMpi);
+
+    auto* ep = new core::param::EnumParam(static_cast<int>(DecompositionType::Morton));
+    ep->SetTypePair(static_cast<int>(DecompositionType::Morton), "Morton ranges");
+    ep->SetTypePair(static_cast<int>(DecompositionType::KD), "k-d split");
+    this->decompositionSlot << ep;
+    this->MakeSlotAvailable(&this->decompositionSlot);
+
+    this->ghostWidthSlot << new core::param::FloatParam(0.0f, 0.0f);
+    this->MakeSlotAvailable(&this->ghostWidthSlot);
+}
+
+
+/*
+ * datatools::MPIParticleRedistributor::~MPIParticleRedistributor
+ */
+datatools::MPIParticleRedistributor::~MPIParticleRedistributor() {
+    this->Release();
+}
+
+
+/*
+ * datatools::MPIParticleRedistributor::manipulateData
+ */
+bool datatools::MPIParticleRedistributor::manipulateData(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+    using geocalls::SimpleSphericalParticles;
+
+    outData = inData; // also transfers the unlocker to 'outData'
+
+    inData.SetUnlocker(nullptr, false); // keep original data locked
+                                        // original data will be unlocked through outData
+#ifdef MEGAMOL_USE_MPI
+    if (!initMPI()) {
+        return true;
+    }
+
+    // all ranks have to take part in the redistribution, so they have to agree on whether it is due
+    int dirty = (inData.FrameID() != this->frameID_) || (inData.DataHash() != this->inDataHash_) ||
+                (inData.DataHash() == 0) || this->decompositionSlot.IsDirty() || this->ghostWidthSlot.IsDirty();
+    MPI_Allreduce(MPI_IN_PLACE, &dirty, 1, MPI_INT, MPI_LOR, this->comm);
+    if (dirty) {
+        this->frameID_ = inData.FrameID();
+        this->inDataHash_ = inData.DataHash();
+        this->decompositionSlot.ResetDirty();
+        this->ghostWidthSlot.ResetDirty();
+        this->valid_ = this->redistribute(inData);
+        ++this->outDataHash_;
+    }
+
+    outData.SetDataHash(this->outDataHash_);
+    if (!this->valid_) {
+        return true;
+    }
+
+    auto const plc = inData.GetParticleListCount();
+    bool const hasGhosts = !this->ghosts_.empty();
+    outData.SetParticleListCount(hasGhosts ? 2 * plc : plc);
+    for (unsigned int i = 0; i < (hasGhosts ? 2 * plc : plc); ++i) {
+        auto const li = i % plc;
+        auto& p = outData.AccessParticles(i);
+        if (i >= plc) {
+            p = outData.AccessParticles(li);
+        }
+        auto const& l = this->layout_[li];
+        if (l.stride == 0) {
+            // lists without positions are not redistributed and have no ghosts
+            if (i >= plc) {
+                p.SetCount(0);
+            }
+            continue;
+        }
+        char const* base = i < plc ? this->data_[li].data() : this->ghosts_[li].data();
+        auto const cnt = (i < plc ? this->data_[li].size() : this->ghosts_[li].size()) / l.stride;
+
+        auto const vt = p.GetVertexDataType();
+        auto const ct = p.GetColourDataType();
+        auto const dt = p.GetDirDataType();
+        auto const it = p.GetIDDataType();
+
+        p.SetCount(cnt);
+        p.SetVertexData(vt, base, l.stride);
+        p.SetColourData(ct, ct != SimpleSphericalParticles::COLDATA_NONE ? base + l.colOffset : nullptr, l.stride);
+        p.SetDirData(dt, dt != SimpleSphericalParticles::DIRDATA_NONE ? base + l.dirOffset : nullptr, l.stride);
+        p.SetIDData(it, it != SimpleSphericalParticles::IDDATA_NONE ? base + l.idOffset : nullptr, l.stride);
+    }
+
+    auto const& ob = this->objectBBox_;
+    auto const& cb = this->clipBBox_;
+    outData.AccessBoundingBoxes().SetObjectSpaceBBox(ob[0], ob[1], ob[2], ob[3], ob[4], ob[5]);
+    outData.AccessBoundingBoxes().SetObjectSpaceClipBox(cb[0], cb[1], cb[2], cb[3], cb[4], cb[5]);
+#endif /* MEGAMOL_USE_MPI */
+
+    return true;
+}
+
+
+/*
+ * datatools::MPIParticleRedistributor::redistribute
+ */
+bool datatools::MPIParticleRedistributor::redistribute(geocalls::MultiParticleDataCall& inData) {
+#ifdef MEGAMOL_USE_MPI
+    using geocalls::SimpleSphericalParticles;
+    using megamol::core::utility::log::Log;
+
+    auto const plc = inData.GetParticleListCount();
+    auto const type = static_cast<DecompositionType>(this->decompositionSlot.Param<core::param::EnumParam>()->Value());
+    auto const ghostWidth = this->ghostWidthSlot.Param<core::param::FloatParam>()->Value();
+
+    this->data_.clear();
+    this->ghosts_.clear();
+    this->layout_.assign(plc, list_layout());
+
+    // the lists have to match on all ranks
+    std::vector<int> lists(1 + 4 * plc);
+    lists[0] = static_cast<int>(plc);
+    for (unsigned int i = 0; i < plc; ++i) {
+        auto const& p = inData.AccessParticles(i);
+        lists[1 + 4 * i] = p.GetVertexDataType();
+        lists[2 + 4 * i] = p.GetColourDataType();
+        lists[3 + 4 * i] = p.GetDirDataType();
+        lists[4 + 4 * i] = p.GetIDDataType();
+    }
+    int minCount = lists[0], maxCount = lists[0];
+    MPI_Allreduce(MPI_IN_PLACE, &minCount, 1, MPI_INT, MPI_MIN, this->comm);
+    MPI_Allreduce(MPI_IN_PLACE, &maxCount, 1, MPI_INT, MPI_MAX, this->comm);
+    if (minCount != maxCount) {
+        Log::DefaultLog.WriteError("MPIParticleRedistributor: the ranks hold different numbers of particle lists");
+        return false;
+    }
+    auto minLists = lists, maxLists = lists;
+    MPI_Allreduce(MPI_IN_PLACE, minLists.data(), static_cast<int>(lists.size()), MPI_INT, MPI_MIN, this->comm);
+    MPI_Allreduce(MPI_IN_PLACE, maxLists.data(), static_cast<int>(lists.size()), MPI_INT, MPI_MAX, this->comm);
+    if (minLists != maxLists) {
+        Log::DefaultLog.WriteError("MPIParticleRedistributor: the data types of the particle lists differ between "
+                                   "the ranks");
+        return false;
+    }
+
+    // global bounds of the positions and of the boxes, maxima are reduced as negated minima
+    std::vector<std::vector<float>> positions(plc);
+    bounds_t bounds = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX};
+    for (unsigned int i = 0; i < plc; ++i) {
+        auto const& p = inData.AccessParticles(i);
+        if (p.GetVertexDataType() == SimpleSphericalParticles::VERTDATA_NONE) {
+            continue;
+        }
+        positions[i] = unpack_positions(p);
+        for (size_t j = 0; j < positions[i].size(); j += 3) {
+            for (int d = 0; d < 3; ++d) {
+                bounds[d] = std::min(bounds[d], positions[i][j + d]);
+                bounds[3 + d] = std::min(bounds[3 + d], -positions[i][j + d]);
+            }
+        }
+    }
+    auto const& ib = inData.AccessBoundingBoxes().ObjectSpaceBBox();
+    auto const& ic = inData.AccessBoundingBoxes().ObjectSpaceClipBox();
+    std::array<float, 18> boxes = {bounds[0], bounds[1], bounds[2], bounds[3], bounds[4], bounds[5], ib.Left(),
+        ib.Bottom(), ib.Back(), -ib.Right(), -ib.Top(), -ib.Front(), ic.Left(), ic.Bottom(), ic.Back(), -ic.Right(),
+        -ic.Top(), -ic.Front()};
+    MPI_Allreduce(MPI_IN_PLACE, boxes.data(), static_cast<int>(boxes.size()), MPI_FLOAT, MPI_MIN, this->comm);
+    for (int d = 0; d < 3; ++d) {
+        bounds[d] = boxes[d];
+        bounds[3 + d] = -boxes[3 + d];
+        this->objectBBox_[d] = boxes[6 + d];
+        this->objectBBox_[3 + d] = -boxes[9 + d];
+        this->clipBBox_[d] = boxes[12 + d];
+        this->clipBBox_[3 + d] = -boxes[15 + d];
+    }
+
+    auto dec = make_decomposition(this->comm, this->mpiSize, type, positions, bounds);
+
+    // send every particle to the rank owning its position
+    this->data_.resize(plc);
+    uint64_t sentAway = 0;
+    std::vector<uint64_t> order, counts;
+    for (unsigned int i = 0; i < plc; ++i) {
+        auto& p = inData.AccessParticles(i);
+        auto& l = this->layout_[i];
+        if (p.GetVertexDataType() == SimpleSphericalParticles::VERTDATA_NONE) {
+            continue;
+        }
+
+        unsigned int const vs = SimpleSphericalParticles::VertexDataSize[p.GetVertexDataType()];
+        unsigned int const cs = SimpleSphericalParticles::ColorDataSize[p.GetColourDataType()];
+        unsigned int const ds = SimpleSphericalParticles::DirDataSize[p.GetDirDataType()];
+        unsigned int const is = SimpleSphericalParticles::IDDataSize[p.GetIDDataType()];
+        l.colOffset = vs;
+        l.dirOffset = vs + cs;
+        l.idOffset = vs + cs + ds;
+        l.stride = vs + cs + ds + is;
+
+        auto const vp = reinterpret_cast<char const*>(p.GetVertexData());
+        auto const cp = reinterpret_cast<char const*>(p.GetColourData());
+        auto const dp = reinterpret_cast<char const*>(p.GetDirData());
+        auto const ip = reinterpret_cast<char const*>(p.GetIDData());
+        size_t const avs = p.GetVertexDataStride() == 0 ? vs : p.GetVertexDataStride();
+        size_t const acs = p.GetColourDataStride() == 0 ? cs : p.GetColourDataStride();
+        size_t const ads = p.GetDirDataStride() == 0 ? ds : p.GetDirDataStride();
+        size_t const ais = p.GetIDDataStride() == 0 ? is : p.GetIDDataStride();
+
+        auto const cnt = static_cast<int64_t>(p.GetCount());
+        std::vector<char> records(cnt * l.stride);
+        std::vector<int> dest(cnt);
+        size_t const ts = l.stride;
+#pragma omp parallel for
+        for (int64_t pidx = 0; pidx < cnt; ++pidx) {
+            auto const dst = records.data() + pidx * ts;
+            std::memcpy(dst, vp + pidx * avs, vs);
+            if (cs > 0 && cp != nullptr)
+                std::memcpy(dst + vs, cp + pidx * acs, cs);
+            if (ds > 0 && dp != nullptr)
+                std::memcpy(dst + vs + cs, dp + pidx * ads, ds);
+            if (is > 0 && ip != nullptr)
+                std::memcpy(dst + vs + cs + ds, ip + pidx * ais, is);
+            dest[pidx] = dec.rank_of(positions[i].data() + 3 * pidx);
+        }
+
+        group_by_rank(dest, this->mpiSize, order, counts);
+        sentAway += cnt - counts[this->mpiRank];
+        if (!exchange_records(this->comm, this->mpiSize, records.data(), l.stride, order, counts, this->data_[i])) {
+            Log::DefaultLog.WriteError("MPIParticleRedistributor: list %u exceeds the range of MPI counts", i);
+            return false;
+        }
+    }
+
+    // copy the particles close to the regions of other ranks there
+    uint64_t numGhosts = 0;
+    if (ghostWidth > 0.0f) {
+        dec.set_ghost_width(ghostWidth);
+
+        this->ghosts_.resize(plc);
+        std::vector<std::vector<uint64_t>> perRank(this->mpiSize);
+        std::vector<int> near;
+        for (unsigned int i = 0; i < plc; ++i) {
+            auto const& l = this->layout_[i];
+            if (l.stride == 0) {
+                continue;
+            }
+            SimpleSphericalParticles p = inData.AccessParticles(i);
+            auto const vt = p.GetVertexDataType();
+            p.SetCount(this->data_[i].size() / l.stride);
+            p.SetVertexData(vt, this->data_[i].data(), l.stride);
+            auto const owned = unpack_positions(p);
+
+            for (auto& r : perRank) {
+                r.clear();
+            }
+            for (size_t j = 0; j < owned.size(); j += 3) {
+                dec.ranks_near(owned.data() + j, near);
+                for (auto const r : near) {
+                    if (r != this->mpiRank) {
+                        perRank[r].push_back(j / 3);
+                    }
+                }
+            }
+            order.clear();
+            counts.assign(this->mpiSize, 0);
+            for (int r = 0; r < this->mpiSize; ++r) {
+                order.insert(order.end(), perRank[r].begin(), perRank[r].end());
+                counts[r] = perRank[r].size();
+            }
+            if (!exchange_records(
+                    this->comm, this->mpiSize, this->data_[i].data(), l.stride, order, counts, this->ghosts_[i])) {
+                Log::DefaultLog.WriteError("MPIParticleRedistributor: the ghosts of list %u exceed the range of MPI "
+                                           "counts", i);
+                return false;
+            }
+            numGhosts += this->ghosts_[i].size() / l.stride;
+        }
+    }
+
+    // report the load of all ranks
+    uint64_t numOwned = 0;
+    for (unsigned int i = 0; i < plc; ++i) {
+        numOwned += this->layout_[i].stride > 0 ? this->data_[i].size() / this->layout_[i].stride : 0;
+    }
+    std::array<uint64_t, 3> load = {numOwned, numGhosts, sentAway};
+    std::vector<uint64_t> loads(this->mpiRank == 0 ? 3 * this->mpiSize : 0);
+    MPI_Gather(load.data(), 3, MPI_UINT64_T, loads.data(), 3, MPI_UINT64_T, 0, this->comm);
+    if (this->mpiRank == 0) {
+        uint64_t minLoad = std::numeric_limits<uint64_t>::max(), maxLoad = 0, total = 0;
+        for (int r = 0; r < this->mpiSize; ++r) {
+            minLoad = std::min(minLoad, loads[3 * r]);
+            maxLoad = std::max(maxLoad, loads[3 * r]);
+            total += loads[3 * r];
+            Log::DefaultLog.WriteInfo("MPIParticleRedistributor: rank %d owns %llu particles and %llu ghosts, sent "
+                                      "%llu particles away",
+                r, static_cast<unsigned long long>(loads[3 * r]), static_cast<unsigned long long>(loads[3 * r + 1]),
+                static_cast<unsigned long long>(loads[3 * r + 2]));
+        }
+        double const mean = static_cast<double>(total) / this->mpiSize;
+        Log::DefaultLog.WriteInfo("MPIParticleRedistributor: %llu particles on %d ranks, min %llu, max %llu, "
+                                  "imbalance (max / mean) %.3f",
+            static_cast<unsigned long long>(total), this->mpiSize, static_cast<unsigned long long>(minLoad),
+            static_cast<unsigned long long>(maxLoad), mean > 0.0 ? maxLoad / mean : 1.0);
+    }
+
+    return true;
+#else
+    return false;
+#endif /* MEGAMOL_USE_MPI */
+}
+
+
+/*
+ * datatools::MPIParticleRedistributor::initMPI
+ */
+bool datatools::MPIParticleRedistributor::initMPI() {
+    bool retval = false;
+#ifdef MEGAMOL_USE_MPI
+    if (this->comm == MPI_COMM_NULL) {
+        auto c = this->callRequestMpi.CallAs<core::cluster::mpi::MpiCall>();
+        if (c != nullptr) {
+            /* New method: let MpiProvider do all the stuff. */
+            if ((*c)(core::cluster::mpi::MpiCall::IDX_PROVIDE_MPI)) {
+                megamol::core::utility::log::Log::DefaultLog.WriteInfo("Got MPI communicator.");
+                this->comm = c->GetComm();
+            } else {
+                megamol::core::utility::log::Log::DefaultLog.WriteError(
+                    "Could not retrieve MPI communicator for the MPI-based view from the registered provider module.");
+            }
+        }
+
+        if (this->comm != MPI_COMM_NULL) {
+            ::MPI_Comm_rank(this->comm, &this->mpiRank);
+            ::MPI_Comm_size(this->comm, &this->mpiSize);
+            megamol::core::utility::log::Log::DefaultLog.WriteInfo("This MPIParticleRedistributor on %hs is %d of %d.",
+                vislib::sys::SystemInformation::ComputerNameA().PeekBuffer(), this->mpiRank, this->mpiSize);
+        }
+    }
+
+    /* Determine success of the whole operation. */
+    retval = (this->comm != MPI_COMM_NULL);
+#endif /* MEGAMOL_USE_MPI */
+    return retval;
+}
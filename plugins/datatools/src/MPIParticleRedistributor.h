@@ -0,0 +1,117 @@
+/*
+ * MPIParticleRedistributor.h
+ *
+ * Copyright (C) 2023 by MegaMol Team
+ * Alle Rechte vorbehalten.
+ */
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "datatools/AbstractParticleManipulator.h"
+#include "mmcore/CallerSlot.h"
+#include "mmcore/param/ParamSlot.h"
+
+#ifdef MEGAMOL_USE_MPI
+#include "mpi.h"
+#endif /* MEGAMOL_USE_MPI */
+
+namespace megamol::datatools {
+
+/**
+ * Module rebalancing object-space distributed MultiParticleDataCalls over MPI. Unlike MPIParticleCollector, no rank
+ * has to hold the whole data set: the domain is decomposed into one region per rank, either as ranges along a Morton
+ * curve or by recursive k-d bisection, and every rank receives the particles of its region through MPI_Alltoallv.
+ *
+ * If a ghost width is set, the particles within that distance of the region of another rank are copied to that rank
+ * as ghosts, so that neighbourhood filters see complete neighbourhoods. Ghosts of list i are output as list n + i, n
+ * being the number of input lists.
+ */
+class MPIParticleRedistributor : public AbstractParticleManipulator {
+public:
+    /** Return module class name */
+    static const char* ClassName() {
+        return "MPIParticleRedistributor";
+    }
+
+    /** Return module class description */
+    static const char* Description() {
+        return "rebalances object-space distributed MultiParticleDataCalls over MPI by a spatial decomposition";
+    }
+
+    /** Module is always available */
+    static bool IsAvailable() {
+#ifdef MEGAMOL_USE_MPI
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /** Ctor */
+    MPIParticleRedistributor();
+
+    /** Dtor */
+    ~MPIParticleRedistributor() override;
+
+protected:
+    /**
+     * Manipulates the particle data
+     *
+     * @param outData The call receiving the manipulated data
+     * @param inData The call holding the original data
+     *
+     * @return True on success
+     */
+    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+    bool initMPI();
+
+private:
+    struct list_layout {
+        unsigned int stride = 0;
+        unsigned int colOffset = 0;
+        unsigned int dirOffset = 0;
+        unsigned int idOffset = 0;
+    };
+
+    /**
+     * Redistributes the particles of 'inData', which has to be called on all ranks.
+     *
+     * @return false if the lists differ between the ranks
+     */
+    bool redistribute(geocalls::MultiParticleDataCall& inData);
+
+#ifdef MEGAMOL_USE_MPI
+    /** The communicator that the view uses. */
+    MPI_Comm comm = MPI_COMM_NULL;
+#endif /* MEGAMOL_USE_MPI */
+
+    /** slot for MPIprovider */
+    core::CallerSlot callRequestMpi;
+
+    core::param::ParamSlot decompositionSlot;
+    core::param::ParamSlot ghostWidthSlot;
+
+    int mpiRank = 0;
+    int mpiSize = 0;
+
+    /** Interleaved data of the particles owned by this rank and of the ghosts, per list */
+    std::vector<std::vector<char>> data_;
+    std::vector<std::vector<char>> ghosts_;
+    std::vector<list_layout> layout_;
+
+    /** The bounding boxes of all ranks' data */
+    std::array<float, 6> objectBBox_;
+    std::array<float, 6> clipBBox_;
+
+    bool valid_ = false;
+
+    size_t inDataHash_ = 0;
+
+    size_t outDataHash_ = 0;
+
+    unsigned int frameID_ = 0;
+};
+
+} // namespace megamol::datatools
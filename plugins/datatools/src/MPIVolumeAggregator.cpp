@@ -7,12 +7,108 @@
 #include "MPIVolumeAggregator.h"
 #include "cluster/mpi/MpiCall.h"
 #include "geometry_calls/MultiParticleDataCall.h"
+#include "mmcore/param/BoolParam.h"
 #include "mmcore/param/EnumParam.h"
+#include "mmcore/param/IntParam.h"
 #include "vislib/sys/SystemInformation.h"
+#include <algorithm>
+#include <array>
 #include <chrono>
+#include <cstring>
+#include <limits>
 
 using namespace megamol;
 
+#ifdef MEGAMOL_USE_MPI
+namespace {
+
+/** A grid split into cubic bricks, the last bricks along each axis may be smaller */
+struct brick_grid {
+    std::array<size_t, 3> res;
+    std::array<size_t, 3> num;
+    size_t edge;
+    size_t comp;
+
+    brick_grid(const size_t* resolution, size_t edge, size_t comp) : edge(edge), comp(comp) {
+        for (int d = 0; d < 3; ++d) {
+            res[d] = resolution[d];
+            num[d] = (res[d] + edge - 1) / edge;
+        }
+    }
+
+    size_t count() const {
+        return num[0] * num[1] * num[2];
+    }
+
+    /** Calls f(offset, length) for every row of voxels of brick b, both in floats */
+    template<class F>
+    void for_each_row(size_t b, F f) const {
+        const size_t bx = b % num[0], by = (b / num[0]) % num[1], bz = b / (num[0] * num[1]);
+        const size_t x0 = bx * edge, y0 = by * edge, z0 = bz * edge;
+        const size_t row = (std::min(x0 + edge, res[0]) - x0) * comp;
+        for (size_t z = z0; z < std::min(z0 + edge, res[2]); ++z) {
+            for (size_t y = y0; y < std::min(y0 + edge, res[1]); ++y) {
+                f(((z * res[1] + y) * res[0] + x0) * comp, row);
+            }
+        }
+    }
+
+    size_t floats(size_t b) const {
+        size_t n = 0;
+        for_each_row(b, [&n](size_t, size_t len) { n += len; });
+        return n;
+    }
+};
+
+float combine(int opVal, float a, float b) {
+    switch (opVal) {
+    case 0:
+        return std::max(a, b);
+    case 1:
+        return std::min(a, b);
+    case 3:
+        return a * b;
+    default:
+        return a + b;
+    }
+}
+
+/**
+ * Exchanges variable numbers of elements between all ranks with MPI_Alltoallv.
+ *
+ * @return false on all ranks if the counts of any rank exceed the range of MPI
+ */
+template<class T>
+bool exchange(MPI_Comm comm, int size, MPI_Datatype type, const std::vector<T>& send,
+    const std::vector<uint64_t>& sendCounts, std::vector<T>& recv, std::vector<uint64_t>& recvCounts) {
+    recvCounts.resize(size);
+    MPI_Alltoall(sendCounts.data(), 1, MPI_UINT64_T, recvCounts.data(), 1, MPI_UINT64_T, comm);
+
+    uint64_t sendTotal = 0, recvTotal = 0;
+    std::vector<int> scounts(size), sdispls(size), rcounts(size), rdispls(size);
+    for (int r = 0; r < size; ++r) {
+        sdispls[r] = static_cast<int>(sendTotal);
+        rdispls[r] = static_cast<int>(recvTotal);
+        scounts[r] = static_cast<int>(sendCounts[r]);
+        rcounts[r] = static_cast<int>(recvCounts[r]);
+        sendTotal += sendCounts[r];
+        recvTotal += recvCounts[r];
+    }
+    int tooLarge = std::max(sendTotal, recvTotal) > static_cast<uint64_t>(std::numeric_limits<int>::max());
+    MPI_Allreduce(MPI_IN_PLACE, &tooLarge, 1, MPI_INT, MPI_LOR, comm);
+    if (tooLarge) {
+        return false;
+    }
+
+    recv.resize(recvTotal);
+    MPI_Alltoallv(send.data(), scounts.data(), sdispls.data(), type, recv.data(), rcounts.data(), rdispls.data(), type,
+        comm);
+    return true;
+}
+
+} // namespace
+#endif /* MEGAMOL_USE_MPI */
+
 
 /*
  * datatools::MPIVolumeAggregator::MPIVolumeAggregator
@@ -20,7 +116,11 @@ using namespace megamol;
 datatools::MPIVolumeAggregator::MPIVolumeAggregator()
         : AbstractVolumeManipulator("outData", "indata")
         , callRequestMpi("requestMpi", "Requests initialisation of MPI and the communicator for the view.")
-        , operatorSlot("operator", "the operator to apply to the volume when aggregating") {
+        , operatorSlot("operator", "the operator to apply to the volume when aggregating")
+        , modeSlot("mode", "Allreduce the whole volume or reduce only the occupied bricks on their owners")
+        , brickSizeSlot("brickSize", "edge length of the bricks in voxels")
+        , gatherSlot("gatherResult", "gather the reduced bricks on all ranks, otherwise every rank only holds the "
+                                     "bricks it owns") {
 
     this->callRequestMpi.SetCompatibleCall<core::cluster::mpi::MpiCallDescription>();
     this->MakeSlotAvailable(&this->callRequestMpi);
@@ -32,6 +132,18 @@ datatools::MPIVolumeAggregator::MPIVolumeAggregator()
     ep->SetTypePair(3, "Product");
     this->operatorSlot << ep;
     this->MakeSlotAvailable(&this->operatorSlot);
+
+    ep = new core::param::EnumParam(0);
+    ep->SetTypePair(0, "Allreduce");
+    ep->SetTypePair(1, "Bricked");
+    this->modeSlot << ep;
+    this->MakeSlotAvailable(&this->modeSlot);
+
+    this->brickSizeSlot << new core::param::IntParam(32, 1);
+    this->MakeSlotAvailable(&this->brickSizeSlot);
+
+    this->gatherSlot << new core::param::BoolParam(true);
+    this->MakeSlotAvailable(&this->gatherSlot);
 }
 
 
@@ -89,12 +201,6 @@ bool datatools::MPIVolumeAggregator::manipulateData(
     }
 
     const size_t numFloats = comp * metadata.Resolution[0] * metadata.Resolution[1] * metadata.Resolution[2];
-    // we need a copy of the data since we must not alter it.
-    std::vector<float> tmpVolume;
-    tmpVolume.resize(numFloats);
-    memcpy(tmpVolume.data(), inData.GetData(), numFloats * sizeof(float));
-    // and a copy to receive the result
-    this->theVolume.resize(numFloats);
 
     MPI_Op op = MPI_SUM;
     const auto opVal = this->operatorSlot.Param<core::param::EnumParam>()->Value();
@@ -123,6 +229,32 @@ bool datatools::MPIVolumeAggregator::manipulateData(
         return false;
     }
 
+    if (this->modeSlot.Param<core::param::EnumParam>()->Value() == 1) {
+        float globalmin, globalmax;
+        if (!this->reduceBricked(static_cast<const float*>(inData.GetData()), opVal, globalmin, globalmax)) {
+            return false;
+        }
+
+        const auto endAllTime = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<float, std::milli> diffAllMillis = endAllTime - startAllTime;
+        megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+            "MPIVolumeAggregator: bricked aggregation of %u x %u x %u volume took %f ms.", metadata.Resolution[0],
+            metadata.Resolution[1], metadata.Resolution[2], diffAllMillis.count());
+
+        outData.SetData(this->theVolume.data());
+        metadata.MinValues[0] = globalmin;
+        metadata.MaxValues[0] = globalmax;
+        outData.SetMetadata(&metadata);
+        return true;
+    }
+
+    // we need a copy of the data since we must not alter it.
+    std::vector<float> tmpVolume;
+    tmpVolume.resize(numFloats);
+    memcpy(tmpVolume.data(), inData.GetData(), numFloats * sizeof(float));
+    // and a copy to receive the result
+    this->theVolume.resize(numFloats);
+
     megamol::core::utility::log::Log::DefaultLog.WriteInfo("MPIVolumeAggregator: starting Allreduce");
     const auto startTime = std::chrono::high_resolution_clock::now();
 
@@ -169,6 +301,166 @@ bool datatools::MPIVolumeAggregator::manipulateData(
     return true;
 }
 
+#ifdef MEGAMOL_USE_MPI
+/*
+ * datatools::MPIVolumeAggregator::reduceBricked
+ */
+bool datatools::MPIVolumeAggregator::reduceBricked(const float* data, int opVal, float& minVal, float& maxVal) {
+    using megamol::core::utility::log::Log;
+
+    const brick_grid grid(this->metadata.Resolution, this->brickSizeSlot.Param<core::param::IntParam>()->Value(),
+        this->metadata.Components);
+    const auto numBricks = grid.count();
+    const auto size = this->mpiSize;
+    const auto comp = grid.comp;
+
+    // bricks are dealt round robin, so that the occupied bricks of a region spread over all ranks
+    std::vector<char> occupied(numBricks);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < static_cast<int64_t>(numBricks); ++b) {
+        bool empty = true;
+        grid.for_each_row(b, [&](size_t offset, size_t len) {
+            empty = empty && std::all_of(data + offset, data + offset + len, [](float v) { return v == 0.0f; });
+        });
+        occupied[b] = !empty;
+    }
+
+    std::vector<uint64_t> sendCounts(size, 0), sendFloats(size, 0);
+    for (size_t b = 0; b < numBricks; ++b) {
+        if (occupied[b]) {
+            ++sendCounts[b % size];
+            sendFloats[b % size] += grid.floats(b);
+        }
+    }
+    std::vector<uint64_t> offsets(size, 0), floatOffsets(size, 0);
+    for (int r = 1; r < size; ++r) {
+        offsets[r] = offsets[r - 1] + sendCounts[r - 1];
+        floatOffsets[r] = floatOffsets[r - 1] + sendFloats[r - 1];
+    }
+    std::vector<uint64_t> sendBricks(offsets[size - 1] + sendCounts[size - 1]);
+    std::vector<float> sendData(floatOffsets[size - 1] + sendFloats[size - 1]);
+    for (size_t b = 0; b < numBricks; ++b) {
+        if (occupied[b]) {
+            const int r = static_cast<int>(b % size);
+            sendBricks[offsets[r]++] = b;
+            grid.for_each_row(b, [&](size_t offset, size_t len) {
+                std::memcpy(sendData.data() + floatOffsets[r], data + offset, len * sizeof(float));
+                floatOffsets[r] += len;
+            });
+        }
+    }
+
+    std::vector<uint64_t> recvBricks, recvCounts, recvFloats;
+    std::vector<float> recvData;
+    if (!exchange(this->comm, size, MPI_UINT64_T, sendBricks, sendCounts, recvBricks, recvCounts) ||
+        !exchange(this->comm, size, MPI_FLOAT, sendData, sendFloats, recvData, recvFloats)) {
+        Log::DefaultLog.WriteError("MPIVolumeAggregator: the bricks exceed the range of MPI counts");
+        return false;
+    }
+
+    // reduce the contributions in rank order, so the result does not depend on timing
+    const size_t numOwned = numBricks / size + 1;
+    std::vector<int64_t> slots(numOwned, -1);
+    std::vector<int> contributors;
+    std::vector<uint64_t> ownedBricks, ownedOffsets;
+    std::vector<float> owned;
+    size_t pos = 0;
+    for (const auto b : recvBricks) {
+        const auto len = grid.floats(b);
+        auto& slot = slots[b / size];
+        if (slot < 0) {
+            slot = static_cast<int64_t>(ownedBricks.size());
+            ownedBricks.push_back(b);
+            ownedOffsets.push_back(owned.size());
+            contributors.push_back(1);
+            owned.insert(owned.end(), recvData.begin() + pos, recvData.begin() + pos + len);
+        } else {
+            auto* dst = owned.data() + ownedOffsets[slot];
+            for (size_t i = 0; i < len; ++i) {
+                dst[i] = combine(opVal, dst[i], recvData[pos + i]);
+            }
+            ++contributors[slot];
+        }
+        pos += len;
+    }
+
+    // ranks that did not send a brick contributed zeros
+    float localMin = std::numeric_limits<float>::max();
+    float localMax = std::numeric_limits<float>::lowest();
+    for (size_t s = 0; s < ownedBricks.size(); ++s) {
+        const auto begin = ownedOffsets[s];
+        const auto end = s + 1 < ownedBricks.size() ? ownedOffsets[s + 1] : owned.size();
+        for (auto i = begin; i < end; ++i) {
+            if (contributors[s] < size) {
+                owned[i] = combine(opVal, owned[i], 0.0f);
+            }
+            if ((i - begin) % comp == 0) {
+                localMin = std::min(localMin, owned[i]);
+                localMax = std::max(localMax, owned[i]);
+            }
+        }
+    }
+    uint64_t numReduced = ownedBricks.size();
+    MPI_Allreduce(MPI_IN_PLACE, &numReduced, 1, MPI_UINT64_T, MPI_SUM, this->comm);
+    if (numReduced < numBricks) {
+        localMin = std::min(localMin, 0.0f);
+        localMax = std::max(localMax, 0.0f);
+    }
+    MPI_Allreduce(&localMin, &minVal, 1, MPI_FLOAT, MPI_MIN, this->comm);
+    MPI_Allreduce(&localMax, &maxVal, 1, MPI_FLOAT, MPI_MAX, this->comm);
+
+    Log::DefaultLog.WriteInfo("MPIVolumeAggregator: sent %llu of %llu bricks (%llu bytes), owning %llu of %llu "
+                              "occupied bricks",
+        static_cast<unsigned long long>(sendBricks.size()), static_cast<unsigned long long>(numBricks),
+        static_cast<unsigned long long>(sendData.size() * sizeof(float)),
+        static_cast<unsigned long long>(ownedBricks.size()), static_cast<unsigned long long>(numReduced));
+
+    // only the reduced bricks are gathered, the rest of the volume is zero
+    std::vector<uint64_t> resultBricks;
+    std::vector<float> resultData;
+    if (this->gatherSlot.Param<core::param::BoolParam>()->Value()) {
+        std::array<uint64_t, 2> local = {ownedBricks.size(), owned.size()};
+        std::vector<uint64_t> counts(2 * size);
+        MPI_Allgather(local.data(), 2, MPI_UINT64_T, counts.data(), 2, MPI_UINT64_T, this->comm);
+        std::vector<int> brickCounts(size), brickDispls(size), floatCounts(size), floatDispls(size);
+        uint64_t totalBricks = 0, totalFloats = 0;
+        for (int r = 0; r < size; ++r) {
+            brickDispls[r] = static_cast<int>(totalBricks);
+            floatDispls[r] = static_cast<int>(totalFloats);
+            brickCounts[r] = static_cast<int>(counts[2 * r]);
+            floatCounts[r] = static_cast<int>(counts[2 * r + 1]);
+            totalBricks += counts[2 * r];
+            totalFloats += counts[2 * r + 1];
+        }
+        if (totalFloats > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+            Log::DefaultLog.WriteError("MPIVolumeAggregator: the reduced bricks exceed the range of MPI counts");
+            return false;
+        }
+        resultBricks.resize(totalBricks);
+        resultData.resize(totalFloats);
+        MPI_Allgatherv(ownedBricks.data(), brickCounts[this->mpiRank], MPI_UINT64_T, resultBricks.data(),
+            brickCounts.data(), brickDispls.data(), MPI_UINT64_T, this->comm);
+        MPI_Allgatherv(owned.data(), floatCounts[this->mpiRank], MPI_FLOAT, resultData.data(), floatCounts.data(),
+            floatDispls.data(), MPI_FLOAT, this->comm);
+    } else {
+        resultBricks = std::move(ownedBricks);
+        resultData = std::move(owned);
+    }
+
+    this->theVolume.assign(grid.res[0] * grid.res[1] * grid.res[2] * comp, 0.0f);
+    pos = 0;
+    for (const auto b : resultBricks) {
+        grid.for_each_row(b, [&](size_t offset, size_t len) {
+            std::memcpy(this->theVolume.data() + offset, resultData.data() + pos, len * sizeof(float));
+            pos += len;
+        });
+    }
+
+    return true;
+}
+#endif /* MEGAMOL_USE_MPI */
+
+
 bool datatools::MPIVolumeAggregator::initMPI() {
     bool retval = false;
 #ifdef MEGAMOL_USE_MPI
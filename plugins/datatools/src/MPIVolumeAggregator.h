@@ -21,6 +21,10 @@ namespace megamol::datatools {
  * This should be used for gathering large in situ SUBSAMPLED (ParticleThinner) data sets:
  * Everything is collected at once and MPI cannot push that much data
  * at once.
+ *
+ * In bricked mode, the volume is split into bricks and only bricks holding non-zero values are sent to the rank
+ * owning them, where they are reduced. The reduced bricks are then either gathered on all ranks or kept on their
+ * owners, with all other voxels being zero. The traffic thus scales with the occupied bricks, not with the grid size.
  */
 class MPIVolumeAggregator : public AbstractVolumeManipulator {
 public:
@@ -67,6 +71,18 @@ protected:
 
 private:
 #ifdef MEGAMOL_USE_MPI
+    /**
+     * Reduces the occupied bricks of 'data' on their owners and writes the result to 'theVolume'.
+     *
+     * @param data The local volume as described by 'metadata'
+     * @param opVal The value of the operator parameter
+     * @param minVal Receives the global minimum of the first component
+     * @param maxVal Receives the global maximum of the first component
+     *
+     * @return false if the bricks exceed the range of MPI counts
+     */
+    bool reduceBricked(const float* data, int opVal, float& minVal, float& maxVal);
+
     /** The communicator that the view uses. */
     MPI_Comm comm = MPI_COMM_NULL;
 #endif /* MEGAMOL_USE_MPI */
@@ -75,6 +91,9 @@ private:
     core::CallerSlot callRequestMpi;
 
     core::param::ParamSlot operatorSlot;
+    core::param::ParamSlot modeSlot;
+    core::param::ParamSlot brickSizeSlot;
+    core::param::ParamSlot gatherSlot;
 
     geocalls::VolumetricDataCall::Metadata metadata;
 
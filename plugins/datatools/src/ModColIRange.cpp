@@ -11,9 +11,51 @@
 using namespace megamol;
 using namespace megamol::datatools;
 
+namespace {
+
+/** Maps intensities periodically into [0, range[, all lists get intensities like in the module */
+class ModColIRangeOperator : public geocalls::ParticleOperator {
+public:
+    explicit ModColIRangeOperator(float range) : range(range) {}
+
+    unsigned int Writes() const override {
+        return ATTR_COLOUR;
+    }
+
+    void Configure(std::vector<geocalls::ParticleListState>& states) const override {
+        uint64_t count = 0;
+        for (auto const& s : states) {
+            if (datatools::MultiParticleDataAdaptor::IsSupported(s.vertexType, s.colourType)) {
+                count += s.count;
+            }
+        }
+        for (auto& s : states) {
+            s.colourType = geocalls::SimpleSphericalParticles::COLDATA_FLOAT_I;
+            s.minColI = 0.0f;
+            s.maxColI = count > 0 ? range : 1.0f;
+        }
+    }
+
+    void Apply(geocalls::ParticleBatch& batch, geocalls::ParticleListState const& in,
+        geocalls::ParticleListState const& out) const override {
+        for (size_t i = 0; i < batch.count; ++i) {
+            // same arithmetic as the module
+            float c = batch.cr[i];
+            unsigned long f = static_cast<unsigned long>(c / range);
+            c -= static_cast<float>(f) * range;
+            batch.cr[i] = c;
+        }
+    }
+
+private:
+    float range;
+};
+
+} // namespace
+
 
 ModColIRange::ModColIRange()
-        : datatools::AbstractParticleManipulator("outData", "inData")
+        : datatools::AbstractParticleOperatorManipulator("outData", "inData")
         , rangeSlot("maxVal", "Specifies the color range from [0..r[")
         , inDataHash(0)
         , outDataHash(0)
@@ -24,13 +66,20 @@ ModColIRange::ModColIRange()
 
     rangeSlot.SetParameter(new core::param::FloatParam(1.0f, 1.0f));
     MakeSlotAvailable(&rangeSlot);
+    addOperatorParam(rangeSlot);
 }
 
 ModColIRange::~ModColIRange() {
     Release();
 }
 
-bool ModColIRange::manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+std::shared_ptr<geocalls::ParticleOperator const> ModColIRange::createOperator(
+    geocalls::MultiParticleDataCall& inData) {
+    return std::make_shared<ModColIRangeOperator>(rangeSlot.Param<core::param::FloatParam>()->Value());
+}
+
+bool ModColIRange::manipulateDataDirect(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
 
     if ((inData.DataHash() != inDataHash) || (inData.FrameID() != frameID) || (inData.DataHash() == 0) ||
         rangeSlot.IsDirty()) {
@@ -6,7 +6,7 @@
  */
 #pragma once
 
-#include "datatools/AbstractParticleManipulator.h"
+#include "datatools/AbstractParticleOperatorManipulator.h"
 #include "datatools/GraphDataCall.h"
 #include "mmcore/param/ParamSlot.h"
 #include "vislib/math/Vector.h"
@@ -14,7 +14,7 @@
 
 namespace megamol::datatools {
 
-class ModColIRange : public datatools::AbstractParticleManipulator {
+class ModColIRange : public datatools::AbstractParticleOperatorManipulator {
 public:
     static const char* ClassName() {
         return "ModIColRange";
@@ -30,7 +30,9 @@ public:
     ~ModColIRange() override;
 
 protected:
-    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+    std::shared_ptr<geocalls::ParticleOperator const> createOperator(geocalls::MultiParticleDataCall& inData) override;
+    bool manipulateDataDirect(
+        geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
 
 private:
     core::param::ParamSlot rangeSlot;
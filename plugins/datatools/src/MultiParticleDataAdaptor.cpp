@@ -16,13 +16,7 @@ MultiParticleDataAdaptor::MultiParticleDataAdaptor(geocalls::MultiParticleDataCa
         list[pli].next = list + (pli + 1);
 
         auto& pl = data.AccessParticles(pli);
-        if (!((((pl.GetVertexDataType() == MultiParticleDataCall::Particles::VERTDATA_NONE) ||
-                  (pl.GetVertexDataType() == MultiParticleDataCall::Particles::VERTDATA_FLOAT_XYZ) ||
-                  (pl.GetVertexDataType() == MultiParticleDataCall::Particles::VERTDATA_FLOAT_XYZR))) &&
-                ((pl.GetColourDataType() == MultiParticleDataCall::Particles::COLDATA_NONE) ||
-                    (pl.GetColourDataType() == MultiParticleDataCall::Particles::COLDATA_FLOAT_RGB) ||
-                    (pl.GetColourDataType() == MultiParticleDataCall::Particles::COLDATA_FLOAT_RGBA) ||
-                    (pl.GetColourDataType() == MultiParticleDataCall::Particles::COLDATA_FLOAT_I)))) {
+        if (!IsSupported(pl.GetVertexDataType(), pl.GetColourDataType())) {
             // data type we want to skip
             list[pli].count = 0;
             continue;
@@ -65,6 +59,18 @@ MultiParticleDataAdaptor::MultiParticleDataAdaptor(geocalls::MultiParticleDataCa
         list[plc - 1].next = nullptr;
 }
 
+bool MultiParticleDataAdaptor::IsSupported(geocalls::SimpleSphericalParticles::VertexDataType vertexType,
+    geocalls::SimpleSphericalParticles::ColourDataType colourType) {
+    using geocalls::MultiParticleDataCall;
+    return ((vertexType == MultiParticleDataCall::Particles::VERTDATA_NONE) ||
+               (vertexType == MultiParticleDataCall::Particles::VERTDATA_FLOAT_XYZ) ||
+               (vertexType == MultiParticleDataCall::Particles::VERTDATA_FLOAT_XYZR)) &&
+           ((colourType == MultiParticleDataCall::Particles::COLDATA_NONE) ||
+               (colourType == MultiParticleDataCall::Particles::COLDATA_FLOAT_RGB) ||
+               (colourType == MultiParticleDataCall::Particles::COLDATA_FLOAT_RGBA) ||
+               (colourType == MultiParticleDataCall::Particles::COLDATA_FLOAT_I));
+}
+
 MultiParticleDataAdaptor::~MultiParticleDataAdaptor() {
     if (list != nullptr) {
         delete[] list;
@@ -12,12 +12,74 @@
 
 using namespace megamol;
 
+namespace {
+
+/** Turns float RGB and RGBA colours into intensities taken from one channel, ranged per list */
+class ChannelSelectOperator : public geocalls::ParticleOperator {
+public:
+    explicit ChannelSelectOperator(int chan) : chan(chan) {}
+
+    unsigned int Writes() const override {
+        return ATTR_COLOUR;
+    }
+
+    bool ReducesColourRange() const override {
+        return true;
+    }
+
+    void Configure(std::vector<geocalls::ParticleListState>& states) const override {
+        for (auto& s : states) {
+            if (selects(s)) {
+                s.colourType = geocalls::SimpleSphericalParticles::COLDATA_FLOAT_I;
+            }
+        }
+    }
+
+    void Apply(geocalls::ParticleBatch& batch, geocalls::ParticleListState const& in,
+        geocalls::ParticleListState const& out) const override {
+        if (!selects(in))
+            return;
+        float const* src = chan == 0 ? batch.cr : (chan == 1 ? batch.cg : (chan == 2 ? batch.cb : batch.ca));
+        if (src != batch.cr) {
+            for (size_t i = 0; i < batch.count; ++i) {
+                batch.cr[i] = src[i];
+            }
+        }
+    }
+
+    void SetReducedRange(std::vector<geocalls::ParticleListState> const& in,
+        std::vector<geocalls::ParticleListState>& out, std::vector<std::array<float, 2>> const& ranges) const override {
+        for (size_t i = 0; i < out.size(); ++i) {
+            if (!selects(in[i]) || ranges[i][0] > ranges[i][1])
+                continue;
+            float minV = ranges[i][0];
+            float maxV = ranges[i][1];
+            if (minV > maxV - 0.0001f) {
+                maxV = minV + 0.5f;
+                minV -= 0.5f;
+            }
+            out[i].minColI = minV;
+            out[i].maxColI = maxV;
+        }
+    }
+
+private:
+    bool selects(geocalls::ParticleListState const& s) const {
+        return (s.colourType == geocalls::SimpleSphericalParticles::COLDATA_FLOAT_RGB && chan != 3) ||
+               s.colourType == geocalls::SimpleSphericalParticles::COLDATA_FLOAT_RGBA;
+    }
+
+    int chan;
+};
+
+} // namespace
+
 
 /*
  * datatools::ParticleColorChannelSelect::ParticleColorChannelSelect
  */
 datatools::ParticleColorChannelSelect::ParticleColorChannelSelect()
-        : AbstractParticleManipulator("outData", "indata")
+        : AbstractParticleOperatorManipulator("outData", "indata")
         , channelSlot("channel", "The color channel to be selected as new I color channel")
         , dataHash(-1)
         , colRange() {
@@ -29,6 +91,7 @@ datatools::ParticleColorChannelSelect::ParticleColorChannelSelect()
     chan->SetTypePair(3, "A");
     channelSlot.SetParameter(chan);
     MakeSlotAvailable(&channelSlot);
+    addOperatorParam(channelSlot);
 }
 
 
@@ -41,9 +104,19 @@ datatools::ParticleColorChannelSelect::~ParticleColorChannelSelect() {
 
 
 /*
- * datatools::ParticleColorChannelSelect::manipulateData
+ * datatools::ParticleColorChannelSelect::createOperator
+ */
+std::shared_ptr<geocalls::ParticleOperator const> datatools::ParticleColorChannelSelect::createOperator(
+    geocalls::MultiParticleDataCall& inData) {
+    int chan = channelSlot.Param<core::param::EnumParam>()->Value();
+    return std::make_shared<ChannelSelectOperator>(std::clamp(chan, 0, 3));
+}
+
+
+/*
+ * datatools::ParticleColorChannelSelect::manipulateDataDirect
  */
-bool datatools::ParticleColorChannelSelect::manipulateData(
+bool datatools::ParticleColorChannelSelect::manipulateDataDirect(
     geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
     outData = inData;                   // also transfers the unlocker to 'outData'
     inData.SetUnlocker(nullptr, false); // keep original data locked
@@ -86,7 +159,8 @@ bool datatools::ParticleColorChannelSelect::manipulateData(
                 const uint8_t* colPtr = static_cast<const uint8_t*>(p.GetColourData());
                 float minV, maxV;
                 minV = maxV = *reinterpret_cast<const float*>(colPtr);
-                for (uint64_t i = 1; i < p.GetCount(); ++i, colPtr += stride) {
+                for (uint64_t i = 1; i < p.GetCount(); ++i) {
+                    colPtr += stride;
                     const float& f = *reinterpret_cast<const float*>(colPtr);
                     if (minV > f)
                         minV = f;
@@ -0,0 +1,243 @@
+/*
+ * ParticleDecomposition.cpp
+ *
+ * Copyright (C) 2023 by MegaMol Team
+ * Alle Rechte vorbehalten.
+ */
+#include "ParticleDecomposition.h"
+
+#ifdef MEGAMOL_USE_MPI
+
+#include <algorithm>
+#include <limits>
+
+using namespace megamol::datatools;
+using namespace megamol::datatools::redistribution;
+
+namespace {
+
+/** Recursively bisects the samples in [b, e) along the longest axis into regions of equal weight */
+int build_kd(std::vector<sample>& s, size_t b, size_t e, int r0, int r1, bounds_t const& box,
+    std::vector<kd_node>& nodes) {
+    int const idx = static_cast<int>(nodes.size());
+    nodes.emplace_back();
+    if (r1 - r0 == 1) {
+        nodes[idx].rank = r0;
+        return idx;
+    }
+
+    int axis = 0;
+    for (int d = 1; d < 3; ++d) {
+        if (box[3 + d] - box[d] > box[3 + axis] - box[axis]) {
+            axis = d;
+        }
+    }
+
+    // ranks are split as evenly as possible, the weight in proportion
+    int const nl = (r1 - r0) / 2;
+    double total = 0.0;
+    for (size_t i = b; i < e; ++i) {
+        total += s[i].weight;
+    }
+    double const target = total * nl / (r1 - r0);
+    std::sort(s.begin() + b, s.begin() + e,
+        [axis](sample const& l, sample const& r) { return l.pos[axis] < r.pos[axis]; });
+    size_t k = b;
+    for (double acc = 0.0; k < e && acc + s[k].weight <= target; ++k) {
+        acc += s[k].weight;
+    }
+
+    float split;
+    if (b == e) {
+        split = 0.5f * (box[axis] + box[3 + axis]);
+    } else if (k == e) {
+        split = box[3 + axis];
+    } else if (k == b) {
+        split = s[b].pos[axis];
+    } else {
+        split = 0.5f * (s[k - 1].pos[axis] + s[k].pos[axis]);
+    }
+
+    bounds_t lbox = box;
+    bounds_t rbox = box;
+    lbox[3 + axis] = split;
+    rbox[axis] = split;
+    int const left = build_kd(s, b, k, r0, r0 + nl, lbox, nodes);
+    int const right = build_kd(s, k, e, r0 + nl, r1, rbox, nodes);
+    nodes[idx].axis = axis;
+    nodes[idx].split = split;
+    nodes[idx].left = left;
+    nodes[idx].right = right;
+    return idx;
+}
+
+} // namespace
+
+
+void redistribution::decomposition::quantize(float const* pos, uint32_t* q) const {
+    for (int d = 0; d < 3; ++d) {
+        float const extent = bounds[3 + d] - bounds[d];
+        float const f = extent > 0.0f ? (pos[d] - bounds[d]) / extent * static_cast<float>(0x1fffff) : 0.0f;
+        q[d] = f >= static_cast<float>(0x1fffff) ? 0x1fffff : (f > 0.0f ? static_cast<uint32_t>(f) : 0);
+    }
+}
+
+
+uint64_t redistribution::decomposition::key(float const* pos) const {
+    uint32_t q[3];
+    quantize(pos, q);
+    return misc::morton_code(q[0], q[1], q[2]);
+}
+
+
+int redistribution::decomposition::rank_of(float const* pos) const {
+    if (type == DecompositionType::Morton) {
+        return static_cast<int>(std::lower_bound(splitters.begin(), splitters.end(), key(pos)) - splitters.begin());
+    }
+    int n = 0;
+    while (nodes[n].axis >= 0) {
+        n = pos[nodes[n].axis] < nodes[n].split ? nodes[n].left : nodes[n].right;
+    }
+    return nodes[n].rank;
+}
+
+
+void redistribution::decomposition::set_ghost_width(float width) {
+    ghost_width = width;
+    ghost_level = static_cast<int>(misc::curve_bits_per_axis);
+    for (int d = 0; d < 3; ++d) {
+        float const extent = bounds[3 + d] - bounds[d];
+        while (extent > 0.0f && ghost_level > 0 && extent / static_cast<float>(1u << ghost_level) < 2.0f * width) {
+            --ghost_level;
+        }
+    }
+}
+
+
+void redistribution::decomposition::ranks_near(float const* pos, std::vector<int>& ranks) const {
+    ranks.clear();
+    float lo[3], hi[3];
+    for (int d = 0; d < 3; ++d) {
+        lo[d] = pos[d] - ghost_width;
+        hi[d] = pos[d] + ghost_width;
+    }
+
+    if (type == DecompositionType::Morton) {
+        // the cells overlapping the box around the position, at most two per axis, each covering a range of keys
+        uint32_t qlo[3], qhi[3];
+        quantize(lo, qlo);
+        quantize(hi, qhi);
+        int const shift = static_cast<int>(misc::curve_bits_per_axis) - ghost_level;
+        uint64_t const cell_keys = (uint64_t(1) << (3 * shift)) - 1;
+        for (uint32_t x = qlo[0] >> shift; x <= qhi[0] >> shift; ++x) {
+            for (uint32_t y = qlo[1] >> shift; y <= qhi[1] >> shift; ++y) {
+                for (uint32_t z = qlo[2] >> shift; z <= qhi[2] >> shift; ++z) {
+                    uint64_t const first = misc::morton_code(x << shift, y << shift, z << shift);
+                    auto const r0 = std::lower_bound(splitters.begin(), splitters.end(), first) - splitters.begin();
+                    auto const r1 =
+                        std::lower_bound(splitters.begin(), splitters.end(), first | cell_keys) - splitters.begin();
+                    for (auto r = r0; r <= r1; ++r) {
+                        ranks.push_back(static_cast<int>(r));
+                    }
+                }
+            }
+        }
+    } else {
+        // the leaves whose boxes overlap the box around the position
+        std::array<int, 64> stack;
+        int top = 0;
+        stack[top++] = 0;
+        while (top > 0) {
+            auto const& n = nodes[stack[--top]];
+            if (n.axis < 0) {
+                ranks.push_back(n.rank);
+                continue;
+            }
+            if (lo[n.axis] < n.split) {
+                stack[top++] = n.left;
+            }
+            if (hi[n.axis] >= n.split) {
+                stack[top++] = n.right;
+            }
+        }
+    }
+
+    std::sort(ranks.begin(), ranks.end());
+    ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+}
+
+
+decomposition megamol::datatools::redistribution::make_decomposition(MPI_Comm comm, int size, DecompositionType type,
+    std::vector<std::vector<float>> const& positions, bounds_t const& bounds) {
+    decomposition d;
+    d.type = type;
+    d.bounds = bounds;
+
+    uint64_t n = 0;
+    for (auto const& p : positions) {
+        n += p.size() / 3;
+    }
+    auto const pos = [&positions](uint64_t i) {
+        for (auto const& p : positions) {
+            if (i < p.size() / 3) {
+                return p.data() + 3 * i;
+            }
+            i -= p.size() / 3;
+        }
+        return static_cast<float const*>(nullptr);
+    };
+
+    // regular samples of the local particles, sorted along the curve for Morton ranges
+    std::vector<uint64_t> keys;
+    if (type == DecompositionType::Morton) {
+        keys.reserve(n);
+        for (auto const& p : positions) {
+            for (size_t i = 0; i < p.size(); i += 3) {
+                keys.push_back(d.key(p.data() + i));
+            }
+        }
+        std::sort(keys.begin(), keys.end());
+    }
+    auto const num_samples = static_cast<size_t>(std::min<uint64_t>(n, samples_per_rank));
+    std::vector<sample> local(num_samples);
+    for (size_t i = 0; i < num_samples; ++i) {
+        auto const idx = (2 * i + 1) * n / (2 * num_samples);
+        auto const p = pos(idx);
+        std::copy(p, p + 3, local[i].pos);
+        local[i].key = type == DecompositionType::Morton ? keys[idx] : 0;
+        local[i].weight = static_cast<double>(n) / static_cast<double>(num_samples);
+    }
+
+    std::vector<int> counts(size), displs(size, 0);
+    int const local_bytes = static_cast<int>(local.size() * sizeof(sample));
+    MPI_Allgather(&local_bytes, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+    for (int r = 1; r < size; ++r) {
+        displs[r] = displs[r - 1] + counts[r - 1];
+    }
+    std::vector<sample> all((displs[size - 1] + counts[size - 1]) / sizeof(sample));
+    MPI_Allgatherv(
+        local.data(), local_bytes, MPI_BYTE, all.data(), counts.data(), displs.data(), MPI_BYTE, comm);
+
+    if (type == DecompositionType::Morton) {
+        std::sort(all.begin(), all.end(), [](sample const& l, sample const& r) { return l.key < r.key; });
+        double total = 0.0;
+        for (auto const& s : all) {
+            total += s.weight;
+        }
+        double acc = 0.0;
+        for (auto const& s : all) {
+            acc += s.weight;
+            while (static_cast<int>(d.splitters.size()) < size - 1 &&
+                   acc >= total * static_cast<double>(d.splitters.size() + 1) / size) {
+                d.splitters.push_back(s.key);
+            }
+        }
+        d.splitters.resize(size - 1, std::numeric_limits<uint64_t>::max());
+    } else {
+        build_kd(all, 0, all.size(), 0, size, bounds, d.nodes);
+    }
+
+    return d;
+}
+
+#endif /* MEGAMOL_USE_MPI */
@@ -0,0 +1,91 @@
+/*
+ * ParticleDecomposition.h
+ *
+ * Copyright (C) 2023 by MegaMol Team
+ * Alle Rechte vorbehalten.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "datatools/misc/SpaceFillingCurve.h"
+
+#ifdef MEGAMOL_USE_MPI
+#include "mpi.h"
+#endif /* MEGAMOL_USE_MPI */
+
+namespace megamol::datatools::redistribution {
+
+enum class DecompositionType : int { Morton = 0, KD = 1 };
+
+#ifdef MEGAMOL_USE_MPI
+
+/** Number of samples each rank contributes for finding regions of equal load */
+constexpr size_t samples_per_rank = 256;
+
+/** Lower x, y, z and upper x, y, z */
+using bounds_t = std::array<float, 6>;
+
+struct sample {
+    float pos[3];
+    uint64_t key;
+    double weight;
+};
+
+struct kd_node {
+    int axis = -1; //< -1 for leaves
+    float split = 0.0f;
+    int left = -1;
+    int right = -1;
+    int rank = 0;
+};
+
+/** Assigns positions to ranks, identical on all ranks */
+struct decomposition {
+    DecompositionType type = DecompositionType::Morton;
+    bounds_t bounds;
+
+    /** Upper Morton keys of the ranges of all but the last rank */
+    std::vector<uint64_t> splitters;
+
+    std::vector<kd_node> nodes;
+
+    /** The distance within which ranks_near() finds other regions */
+    float ghost_width = 0.0f;
+
+    /** The level of the Morton cells approximating the ranges in ranks_near(), cells are at least twice the width */
+    int ghost_level = static_cast<int>(misc::curve_bits_per_axis);
+
+    /** Quantizes a position into the bits per axis of the curve */
+    void quantize(float const* pos, uint32_t* q) const;
+
+    uint64_t key(float const* pos) const;
+
+    int rank_of(float const* pos) const;
+
+    void set_ghost_width(float width);
+
+    /**
+     * Finds the ranks whose regions are within the ghost width of a position, including the owner of the position.
+     * k-d regions are exact, Morton ranges are rounded up to whole cells of the ghost level, so that every rank is
+     * found, but some ranks may be found only because of the rounding.
+     *
+     * @param ranks Receives the sorted ranks
+     */
+    void ranks_near(float const* pos, std::vector<int>& ranks) const;
+};
+
+/**
+ * Finds regions of equal load from weighted samples of all ranks' particles, which has to be called on all ranks.
+ *
+ * @param positions The interleaved positions of the particles of every list of this rank
+ * @param bounds The bounds of the positions of all ranks
+ */
+decomposition make_decomposition(MPI_Comm comm, int size, DecompositionType type,
+    std::vector<std::vector<float>> const& positions, bounds_t const& bounds);
+
+#endif /* MEGAMOL_USE_MPI */
+
+} // namespace megamol::datatools::redistribution
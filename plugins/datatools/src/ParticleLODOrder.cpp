@@ -0,0 +1,164 @@
+/*
+ * ParticleLODOrder.cpp
+ *
+ * Copyright (C) 2023 by MegaMol team
+ * Alle Rechte vorbehalten.
+ */
+#include "datatools/ParticleLODOrder.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "datatools/misc/SpaceFillingCurve.h"
+
+using namespace megamol;
+using namespace megamol::datatools;
+
+namespace {
+
+/** Reverses the lower bits bits of v */
+uint64_t reverse_bits(uint64_t v, unsigned int bits) {
+    if (bits == 0)
+        return 0;
+    v = ((v >> 1) & 0x5555555555555555ull) | ((v & 0x5555555555555555ull) << 1);
+    v = ((v >> 2) & 0x3333333333333333ull) | ((v & 0x3333333333333333ull) << 2);
+    v = ((v >> 4) & 0x0f0f0f0f0f0f0f0full) | ((v & 0x0f0f0f0f0f0f0f0full) << 4);
+    v = ((v >> 8) & 0x00ff00ff00ff00ffull) | ((v & 0x00ff00ff00ff00ffull) << 8);
+    v = ((v >> 16) & 0x0000ffff0000ffffull) | ((v & 0x0000ffff0000ffffull) << 16);
+    v = (v >> 32) | (v << 32);
+    return v >> (64 - bits);
+}
+
+} // namespace
+
+
+/*
+ * ParticleLODOrder::ComputeOrder
+ */
+std::vector<uint64_t> ParticleLODOrder::ComputeOrder(geocalls::SimpleSphericalParticles const& p) {
+    auto const cnt = p.GetCount();
+
+    // ranks along the Morton curve, list order if there are no positions
+    auto const sorted = misc::sort_permutation(misc::curve_keys(p, misc::CurveType::Morton));
+
+    // bit-reversed traversal of the curve: each prefix of length 2^k picks every 2^(bits-k)-th particle along it
+    unsigned int bits = 0;
+    while ((uint64_t(1) << bits) < cnt) {
+        ++bits;
+    }
+    std::vector<uint64_t> order(cnt);
+    uint64_t out = 0;
+    for (uint64_t r = 0; out < cnt; ++r) {
+        auto const rank = reverse_bits(r, bits);
+        if (rank < cnt) {
+            order[out++] = sorted[rank];
+        }
+    }
+
+    return order;
+}
+
+
+/*
+ * ParticleLODOrder::Update
+ */
+bool ParticleLODOrder::Update(geocalls::MultiParticleDataCall& data) {
+    using geocalls::SimpleSphericalParticles;
+
+    if (this->valid && data.DataHash() != 0 && data.DataHash() == this->dataHash &&
+        data.FrameID() == this->frameID) {
+        return false;
+    }
+
+    unsigned int const plc = data.GetParticleListCount();
+    this->lists.resize(plc);
+    for (unsigned int li = 0; li < plc; ++li) {
+        auto const& p = data.AccessParticles(li);
+        auto& l = this->lists[li];
+
+        l.vertType = p.GetVertexDataType();
+        l.colType = p.GetColourDataType();
+        l.dirType = p.GetDirDataType();
+        l.idType = p.GetIDDataType();
+
+        unsigned int const vs = SimpleSphericalParticles::VertexDataSize[l.vertType];
+        unsigned int const cs = SimpleSphericalParticles::ColorDataSize[l.colType];
+        unsigned int const ds = SimpleSphericalParticles::DirDataSize[l.dirType];
+        unsigned int const is = SimpleSphericalParticles::IDDataSize[l.idType];
+
+        l.colOffset = vs;
+        l.dirOffset = vs + cs;
+        l.idOffset = vs + cs + ds;
+        l.stride = vs + cs + ds + is;
+        l.count = p.GetCount();
+
+        auto const vp = reinterpret_cast<char const*>(p.GetVertexData());
+        auto const cp = reinterpret_cast<char const*>(p.GetColourData());
+        auto const dp = reinterpret_cast<char const*>(p.GetDirData());
+        auto const ip = reinterpret_cast<char const*>(p.GetIDData());
+        size_t const avs = p.GetVertexDataStride() == 0 ? vs : p.GetVertexDataStride();
+        size_t const acs = p.GetColourDataStride() == 0 ? cs : p.GetColourDataStride();
+        size_t const ads = p.GetDirDataStride() == 0 ? ds : p.GetDirDataStride();
+        size_t const ais = p.GetIDDataStride() == 0 ? is : p.GetIDDataStride();
+
+        auto const order = ComputeOrder(p);
+
+        l.data.clear();
+        l.data.shrink_to_fit();
+        l.data.resize(l.count * l.stride);
+        auto const base = l.data.data();
+        size_t const ts = l.stride;
+
+#pragma omp parallel for
+        for (int64_t i = 0; i < static_cast<int64_t>(l.count); ++i) {
+            auto const s = order[i];
+            auto const dst = base + i * ts;
+            if (vs > 0 && vp != nullptr)
+                std::memcpy(dst, vp + s * avs, vs);
+            if (cs > 0 && cp != nullptr)
+                std::memcpy(dst + vs, cp + s * acs, cs);
+            if (ds > 0 && dp != nullptr)
+                std::memcpy(dst + vs + cs, dp + s * ads, ds);
+            if (is > 0 && ip != nullptr)
+                std::memcpy(dst + vs + cs + ds, ip + s * ais, is);
+        }
+    }
+
+    this->dataHash = data.DataHash();
+    this->frameID = data.FrameID();
+    this->valid = true;
+
+    return true;
+}
+
+
+/*
+ * ParticleLODOrder::Apply
+ */
+void ParticleLODOrder::Apply(geocalls::SimpleSphericalParticles& p, unsigned int idx, uint64_t count) const {
+    using geocalls::SimpleSphericalParticles;
+
+    if (idx >= this->lists.size()) {
+        p.SetCount(0);
+        return;
+    }
+    auto const& l = this->lists[idx];
+    char const* base = l.data.data();
+
+    p.SetCount(std::min(count, l.count));
+    p.SetVertexData(l.vertType, l.vertType != SimpleSphericalParticles::VERTDATA_NONE ? base : nullptr, l.stride);
+    p.SetColourData(
+        l.colType, l.colType != SimpleSphericalParticles::COLDATA_NONE ? base + l.colOffset : nullptr, l.stride);
+    p.SetDirData(
+        l.dirType, l.dirType != SimpleSphericalParticles::DIRDATA_NONE ? base + l.dirOffset : nullptr, l.stride);
+    p.SetIDData(l.idType, l.idType != SimpleSphericalParticles::IDDATA_NONE ? base + l.idOffset : nullptr, l.stride);
+}
+
+
+/*
+ * ParticleLODOrder::Clear
+ */
+void ParticleLODOrder::Clear() {
+    this->lists.clear();
+    this->valid = false;
+}
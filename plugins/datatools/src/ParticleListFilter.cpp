@@ -9,6 +9,7 @@
 #include "geometry_calls/MultiParticleDataCall.h"
 #include "mmcore/param/BoolParam.h"
 #include "mmcore/param/ButtonParam.h"
+#include "mmcore/param/FloatParam.h"
 #include "mmcore/param/StringParam.h"
 #include "vislib/StringTokeniser.h"
 #include <cfloat>
@@ -28,6 +29,8 @@ ParticleListFilter::ParticleListFilter()
         , globalColorMapComputationSlot(
               "globalMap", "Compute color map min/max from all particle lists (false: compute them per list)")
         , includeHiddenInColorMapSlot("includeHidden", "Include hidden particle lists in color map min/max computation")
+        , lodFractionSlot("lodFraction", "Fraction of the particles of each list to keep, as a spatially stratified "
+                                         "subset. Changing it does not copy data.")
         , datahashParticlesIn(0)
         , datahashParticlesOut(0)
         , frameID(0) {
@@ -51,6 +54,8 @@ ParticleListFilter::ParticleListFilter()
     this->MakeSlotAvailable(&this->globalColorMapComputationSlot);
     this->includeHiddenInColorMapSlot << new core::param::BoolParam(true);
     this->MakeSlotAvailable(&this->includeHiddenInColorMapSlot);
+    this->lodFractionSlot << new core::param::FloatParam(1.0f, 0.0f, 1.0f);
+    this->MakeSlotAvailable(&this->lodFractionSlot);
 }
 
 
@@ -110,6 +115,10 @@ bool ParticleListFilter::getDataCallback(core::Call& call) {
         this->includeHiddenInColorMapSlot.ResetDirty();
         doStuff = true;
     }
+    if (this->lodFractionSlot.IsDirty()) {
+        this->lodFractionSlot.ResetDirty();
+        doStuff = true;
+    }
 
     if (outMpdc != NULL) {
         geocalls::MultiParticleDataCall* inMpdc = this->inParticlesDataSlot.CallAs<geocalls::MultiParticleDataCall>();
@@ -148,12 +157,22 @@ bool ParticleListFilter::getDataCallback(core::Call& call) {
         // not sure
         if (outMpdc->FrameID() != this->frameID) {
             doStuff = true;
+            this->frameID = outMpdc->FrameID();
         }
 
         if (!doStuff) {
             return true;
         }
 
+        float const lodFraction = this->lodFractionSlot.Param<core::param::FloatParam>()->Value();
+        bool const useLOD = lodFraction < 1.0f;
+        if (useLOD) {
+            // reorders only on new data, changing the fraction just moves the prefix end
+            this->lodOrder.Update(*inMpdc);
+        } else {
+            this->lodOrder.Clear();
+        }
+
         unsigned int cnt = inMpdc->GetParticleListCount();
         unsigned int outCnt = 0;
         if (included.Count() == 0) {
@@ -181,13 +200,18 @@ bool ParticleListFilter::getDataCallback(core::Call& call) {
             if (included.Count() > 0 && !included.Contains(inMpdc->AccessParticles(i).GetGlobalType())) {
                 continue;
             }
-            outMpdc->AccessParticles(outCnt).SetCount(inMpdc->AccessParticles(i).GetCount());
-            outMpdc->AccessParticles(outCnt).SetColourData(inMpdc->AccessParticles(i).GetColourDataType(),
-                inMpdc->AccessParticles(i).GetColourData(), inMpdc->AccessParticles(i).GetColourDataStride());
-            outMpdc->AccessParticles(outCnt).SetVertexData(inMpdc->AccessParticles(i).GetVertexDataType(),
-                inMpdc->AccessParticles(i).GetVertexData(), inMpdc->AccessParticles(i).GetVertexDataStride());
-            outMpdc->AccessParticles(outCnt).SetDirData(inMpdc->AccessParticles(i).GetDirDataType(),
-                inMpdc->AccessParticles(i).GetDirData(), inMpdc->AccessParticles(i).GetDirDataStride());
+            if (useLOD) {
+                this->lodOrder.Apply(outMpdc->AccessParticles(outCnt), i,
+                    static_cast<UINT64>(static_cast<double>(this->lodOrder.GetCount(i)) * lodFraction));
+            } else {
+                outMpdc->AccessParticles(outCnt).SetCount(inMpdc->AccessParticles(i).GetCount());
+                outMpdc->AccessParticles(outCnt).SetColourData(inMpdc->AccessParticles(i).GetColourDataType(),
+                    inMpdc->AccessParticles(i).GetColourData(), inMpdc->AccessParticles(i).GetColourDataStride());
+                outMpdc->AccessParticles(outCnt).SetVertexData(inMpdc->AccessParticles(i).GetVertexDataType(),
+                    inMpdc->AccessParticles(i).GetVertexData(), inMpdc->AccessParticles(i).GetVertexDataStride());
+                outMpdc->AccessParticles(outCnt).SetDirData(inMpdc->AccessParticles(i).GetDirDataType(),
+                    inMpdc->AccessParticles(i).GetDirData(), inMpdc->AccessParticles(i).GetDirDataStride());
+            }
             // TODO BUG HAZARD this is most probably wrong, as different list subsets have a different dynamic range :(
             // probably still loop over all...
             //outMpdc->AccessParticles(outCnt).SetColourMapIndexValues(inMpdc->AccessParticles(i).GetMinColourIndexValue(),
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "datatools/ParticleLODOrder.h"
 #include "mmcore/CalleeSlot.h"
 #include "mmcore/CallerSlot.h"
 #include "mmcore/Module.h"
@@ -107,6 +108,11 @@ private:
 
     core::param::ParamSlot includeHiddenInColorMapSlot;
 
+    core::param::ParamSlot lodFractionSlot;
+
+    /** Progressive ordering of the input lists, only used if lodFractionSlot is below one */
+    ParticleLODOrder lodOrder;
+
     SIZE_T datahashParticlesOut;
 
     SIZE_T datahashParticlesIn;
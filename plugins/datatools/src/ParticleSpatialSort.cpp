@@ -0,0 +1,199 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "ParticleSpatialSort.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+
+#include "datatools/misc/SpaceFillingCurve.h"
+#include "mmcore/param/EnumParam.h"
+#include "mmcore/utility/log/Log.h"
+
+using namespace megamol;
+
+
+datatools::ParticleSpatialSort::ParticleSpatialSort()
+        : AbstractParticleManipulator("outData", "indata")
+        , particleMapSlot("outParticleMap", "Publishes the index of the input particle for each output particle")
+        , curveSlot("curve", "The space-filling curve to sort along") {
+    auto* ep = new core::param::EnumParam(static_cast<int>(misc::CurveType::Morton));
+    ep->SetTypePair(static_cast<int>(misc::CurveType::Morton), "Morton");
+    ep->SetTypePair(static_cast<int>(misc::CurveType::Hilbert), "Hilbert");
+    this->curveSlot << ep;
+    this->MakeSlotAvailable(&this->curveSlot);
+
+    this->particleMapSlot.SetCallback(ParticleFilterMapDataCall::ClassName(),
+        ParticleFilterMapDataCall::FunctionName(ParticleFilterMapDataCall::GET_DATA),
+        &ParticleSpatialSort::getParticleMapData);
+    this->particleMapSlot.SetCallback(ParticleFilterMapDataCall::ClassName(),
+        ParticleFilterMapDataCall::FunctionName(ParticleFilterMapDataCall::GET_EXTENT),
+        &ParticleSpatialSort::getParticleMapExtent);
+    this->particleMapSlot.SetCallback(ParticleFilterMapDataCall::ClassName(),
+        ParticleFilterMapDataCall::FunctionName(ParticleFilterMapDataCall::GET_HASH),
+        &ParticleSpatialSort::getParticleMapHash);
+    this->MakeSlotAvailable(&this->particleMapSlot);
+}
+
+
+datatools::ParticleSpatialSort::~ParticleSpatialSort() {
+    this->Release();
+}
+
+
+bool datatools::ParticleSpatialSort::manipulateData(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+    using geocalls::SimpleSphericalParticles;
+
+    if ((inData.FrameID() != this->frameID_) || (inData.DataHash() != this->inDataHash_) ||
+        (inData.DataHash() == 0) || this->curveSlot.IsDirty() || this->data_.size() != inData.GetParticleListCount()) {
+        this->frameID_ = inData.FrameID();
+        this->inDataHash_ = inData.DataHash();
+        this->curveSlot.ResetDirty();
+        this->sortData(inData);
+        ++this->outDataHash_;
+    }
+
+    outData = inData; // also transfers the unlocker to 'outData'
+
+    inData.SetUnlocker(nullptr, false); // keep original data locked
+                                        // original data will be unlocked through outData
+
+    outData.SetDataHash(this->outDataHash_);
+
+    auto const plc = outData.GetParticleListCount();
+    for (unsigned int i = 0; i < plc; ++i) {
+        auto& p = outData.AccessParticles(i);
+        auto const& l = this->layout_[i];
+        char const* base = this->data_[i].data();
+
+        auto const vt = p.GetVertexDataType();
+        auto const ct = p.GetColourDataType();
+        auto const dt = p.GetDirDataType();
+        auto const it = p.GetIDDataType();
+
+        p.SetVertexData(vt, vt != SimpleSphericalParticles::VERTDATA_NONE ? base : nullptr, l.stride);
+        p.SetColourData(ct, ct != SimpleSphericalParticles::COLDATA_NONE ? base + l.colOffset : nullptr, l.stride);
+        p.SetDirData(dt, dt != SimpleSphericalParticles::DIRDATA_NONE ? base + l.dirOffset : nullptr, l.stride);
+        p.SetIDData(it, it != SimpleSphericalParticles::IDDATA_NONE ? base + l.idOffset : nullptr, l.stride);
+    }
+
+    return true;
+}
+
+
+void datatools::ParticleSpatialSort::sortData(geocalls::MultiParticleDataCall& inData) {
+    using geocalls::SimpleSphericalParticles;
+
+    auto const curve = static_cast<misc::CurveType>(this->curveSlot.Param<core::param::EnumParam>()->Value());
+
+    auto const plc = inData.GetParticleListCount();
+    this->data_.resize(plc);
+    this->layout_.resize(plc);
+
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < plc; ++i) {
+        total += inData.AccessParticles(i).GetCount();
+    }
+    if (total > std::numeric_limits<ParticleFilterMapDataCall::index_t>::max()) {
+        core::utility::log::Log::DefaultLog.WriteWarn(
+            "ParticleSpatialSort: %llu particles exceed the range of the particle map, the map will be incomplete",
+            static_cast<unsigned long long>(total));
+    }
+    this->mapIndex_.resize(std::min<uint64_t>(total, std::numeric_limits<ParticleFilterMapDataCall::index_t>::max()));
+
+    uint64_t mapOffset = 0;
+    for (unsigned int i = 0; i < plc; ++i) {
+        auto const& p = inData.AccessParticles(i);
+        auto& l = this->layout_[i];
+        auto& d = this->data_[i];
+
+        unsigned int const vs = SimpleSphericalParticles::VertexDataSize[p.GetVertexDataType()];
+        unsigned int const cs = SimpleSphericalParticles::ColorDataSize[p.GetColourDataType()];
+        unsigned int const ds = SimpleSphericalParticles::DirDataSize[p.GetDirDataType()];
+        unsigned int const is = SimpleSphericalParticles::IDDataSize[p.GetIDDataType()];
+        l.colOffset = vs;
+        l.dirOffset = vs + cs;
+        l.idOffset = vs + cs + ds;
+        l.stride = vs + cs + ds + is;
+
+        auto const vp = reinterpret_cast<char const*>(p.GetVertexData());
+        auto const cp = reinterpret_cast<char const*>(p.GetColourData());
+        auto const dp = reinterpret_cast<char const*>(p.GetDirData());
+        auto const ip = reinterpret_cast<char const*>(p.GetIDData());
+        size_t const avs = p.GetVertexDataStride() == 0 ? vs : p.GetVertexDataStride();
+        size_t const acs = p.GetColourDataStride() == 0 ? cs : p.GetColourDataStride();
+        size_t const ads = p.GetDirDataStride() == 0 ? ds : p.GetDirDataStride();
+        size_t const ais = p.GetIDDataStride() == 0 ? is : p.GetIDDataStride();
+
+        auto const cnt = static_cast<int64_t>(p.GetCount());
+        auto const order = misc::sort_permutation(misc::curve_keys(p, curve));
+
+        d.clear();
+        d.shrink_to_fit();
+        d.resize(cnt * l.stride);
+        auto const base = d.data();
+        size_t const ts = l.stride;
+        auto const mapSize = static_cast<int64_t>(this->mapIndex_.size());
+
+#pragma omp parallel for
+        for (int64_t pidx = 0; pidx < cnt; ++pidx) {
+            auto const sidx = order[pidx];
+            auto const dst = base + pidx * ts;
+            if (vs > 0 && vp != nullptr)
+                std::memcpy(dst, vp + sidx * avs, vs);
+            if (cs > 0 && cp != nullptr)
+                std::memcpy(dst + vs, cp + sidx * acs, cs);
+            if (ds > 0 && dp != nullptr)
+                std::memcpy(dst + vs + cs, dp + sidx * ads, ds);
+            if (is > 0 && ip != nullptr)
+                std::memcpy(dst + vs + cs + ds, ip + sidx * ais, is);
+            if (static_cast<int64_t>(mapOffset) + pidx < mapSize)
+                this->mapIndex_[mapOffset + pidx] = static_cast<ParticleFilterMapDataCall::index_t>(mapOffset + sidx);
+        }
+
+        mapOffset += cnt;
+    }
+}
+
+
+bool datatools::ParticleSpatialSort::getParticleMapData(core::Call& c) {
+    auto* mapCall = dynamic_cast<ParticleFilterMapDataCall*>(&c);
+    if (mapCall == nullptr)
+        return false;
+
+    mapCall->Set(this->mapIndex_.data(), this->mapIndex_.size());
+    mapCall->SetFrameID(this->frameID_);
+    mapCall->SetDataHash(this->outDataHash_);
+    mapCall->SetUnlocker(nullptr);
+
+    return true;
+}
+
+
+bool datatools::ParticleSpatialSort::getParticleMapExtent(core::Call& c) {
+    auto* mapCall = dynamic_cast<ParticleFilterMapDataCall*>(&c);
+    if (mapCall == nullptr)
+        return false;
+
+    mapCall->SetFrameCount(0); // the map follows the frame last requested through outData
+    mapCall->SetUnlocker(nullptr);
+
+    return true;
+}
+
+
+bool datatools::ParticleSpatialSort::getParticleMapHash(core::Call& c) {
+    auto* mapCall = dynamic_cast<ParticleFilterMapDataCall*>(&c);
+    if (mapCall == nullptr)
+        return false;
+
+    mapCall->SetDataHash(this->outDataHash_);
+    mapCall->SetUnlocker(nullptr);
+
+    return true;
+}
@@ -0,0 +1,90 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "datatools/AbstractParticleManipulator.h"
+#include "datatools/ParticleFilterMapDataCall.h"
+#include "mmcore/CalleeSlot.h"
+#include "mmcore/param/ParamSlot.h"
+
+namespace megamol::datatools {
+
+/**
+ * Reorders the particles of each list along a space-filling curve for cache locality.
+ * The permutation is published through a ParticleFilterMapDataCall, mapping each output particle to the index of the
+ * input particle (counted over all lists).
+ */
+class ParticleSpatialSort : public AbstractParticleManipulator {
+public:
+    /** Return module class name */
+    static const char* ClassName() {
+        return "ParticleSpatialSort";
+    }
+
+    /** Return module class description */
+    static const char* Description() {
+        return "Sorts particles along a Morton or Hilbert curve";
+    }
+
+    /** Module is always available */
+    static bool IsAvailable() {
+        return true;
+    }
+
+    /** Ctor */
+    ParticleSpatialSort();
+
+    /** Dtor */
+    ~ParticleSpatialSort() override;
+
+protected:
+    /**
+     * Manipulates the particle data
+     *
+     * @param outData The call receiving the manipulated data
+     * @param inData The call holding the original data
+     *
+     * @return True on success
+     */
+    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+
+private:
+    struct list_layout {
+        unsigned int stride = 0;
+        unsigned int colOffset = 0;
+        unsigned int dirOffset = 0;
+        unsigned int idOffset = 0;
+    };
+
+    void sortData(geocalls::MultiParticleDataCall& inData);
+
+    bool getParticleMapData(core::Call& c);
+    bool getParticleMapExtent(core::Call& c);
+    bool getParticleMapHash(core::Call& c);
+
+    core::CalleeSlot particleMapSlot;
+
+    core::param::ParamSlot curveSlot;
+
+    /** Interleaved particle data of each list in curve order */
+    std::vector<std::vector<char>> data_;
+
+    std::vector<list_layout> layout_;
+
+    /** Index of the input particle for each output particle */
+    std::vector<ParticleFilterMapDataCall::index_t> mapIndex_;
+
+    size_t inDataHash_ = 0;
+
+    size_t outDataHash_ = 0;
+
+    unsigned int frameID_ = 0;
+};
+
+} // namespace megamol::datatools
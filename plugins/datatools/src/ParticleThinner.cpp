@@ -5,6 +5,7 @@
  * Alle Rechte vorbehalten.
  */
 #include "ParticleThinner.h"
+#include "mmcore/param/EnumParam.h"
 #include "mmcore/param/IntParam.h"
 
 using namespace megamol;
@@ -15,9 +16,20 @@ using namespace megamol;
  */
 datatools::ParticleThinner::ParticleThinner()
         : AbstractParticleManipulator("outData", "indata")
-        , thinningFactorSlot("thinningFactor", "The thinning factor. Only each n-th particle will be kept.") {
+        , thinningFactorSlot("thinningFactor", "The thinning factor. Only each n-th particle will be kept.")
+        , methodSlot("method", "Stride keeps each n-th particle of the input without any copy. Progressive keeps a "
+                               "spatially stratified subset, changing the thinning factor does not copy data.")
+        , inDataHash(0)
+        , outDataHash(0)
+        , frameID(0) {
     this->thinningFactorSlot.SetParameter(new core::param::IntParam(100, 1));
     this->MakeSlotAvailable(&this->thinningFactorSlot);
+
+    auto* ep = new core::param::EnumParam(0);
+    ep->SetTypePair(0, "Stride");
+    ep->SetTypePair(1, "Progressive");
+    this->methodSlot << ep;
+    this->MakeSlotAvailable(&this->methodSlot);
 }
 
 
@@ -36,16 +48,40 @@ bool datatools::ParticleThinner::manipulateData(
     geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
     using geocalls::MultiParticleDataCall;
     int tf = this->thinningFactorSlot.Param<core::param::IntParam>()->Value();
+    bool const progressive = this->methodSlot.Param<core::param::EnumParam>()->Value() == 1;
+
+    if ((inData.DataHash() != this->inDataHash) || (inData.FrameID() != this->frameID) || (inData.DataHash() == 0) ||
+        this->thinningFactorSlot.IsDirty() || this->methodSlot.IsDirty()) {
+        this->inDataHash = inData.DataHash();
+        this->frameID = inData.FrameID();
+        this->outDataHash++;
+        this->thinningFactorSlot.ResetDirty();
+        this->methodSlot.ResetDirty();
+    }
+
+    if (progressive) {
+        // only reorders once per frame, the thinning factor merely selects the prefix
+        this->lodOrder.Update(inData);
+    } else {
+        this->lodOrder.Clear();
+    }
 
     outData = inData; // also transfers the unlocker to 'outData'
 
     inData.SetUnlocker(nullptr, false); // keep original data locked
                                         // original data will be unlocked through outData
 
+    outData.SetDataHash(this->outDataHash);
+
     unsigned int plc = outData.GetParticleListCount();
     for (unsigned int i = 0; i < plc; i++) {
         MultiParticleDataCall::Particles& p = outData.AccessParticles(i);
 
+        if (progressive) {
+            this->lodOrder.Apply(p, i, this->lodOrder.GetCount(i) / tf);
+            continue;
+        }
+
         UINT64 cnt = p.GetCount();
 
         const void* cd = p.GetColourData();
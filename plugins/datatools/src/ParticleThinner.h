@@ -8,6 +8,7 @@
 #pragma once
 
 #include "datatools/AbstractParticleManipulator.h"
+#include "datatools/ParticleLODOrder.h"
 #include "mmcore/param/ParamSlot.h"
 
 
@@ -57,6 +58,18 @@ protected:
 private:
     /** The thinning factor. Only each n-th particle will be kept. */
     core::param::ParamSlot thinningFactorSlot;
+
+    /** Selects between strided access (default) and the progressive level-of-detail prefix */
+    core::param::ParamSlot methodSlot;
+
+    /** The particles of the current frame in progressive order */
+    ParticleLODOrder lodOrder;
+
+    size_t inDataHash;
+
+    size_t outDataHash;
+
+    unsigned int frameID;
 };
 
 } // namespace megamol::datatools
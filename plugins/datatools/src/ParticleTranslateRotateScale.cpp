@@ -15,14 +15,116 @@
 #include "mmcore/param/Vector3fParam.h"
 #include "mmcore/param/Vector4fParam.h"
 
+#include <limits>
+
 using namespace megamol;
 
+namespace {
+
+/** Parameters of the transformation, which is centred on the bounding box of its input */
+struct Transformation {
+    glm::vec3 translation;
+    glm::quat rotation;
+    glm::vec3 scale;
+
+    glm::mat4 Matrix(vislib::math::Cuboid<float> const& bbox) const {
+        auto bboxCenterX = bbox.CalcCenter().GetX();
+        auto bboxCenterY = bbox.CalcCenter().GetY();
+        auto bboxCenterZ = bbox.CalcCenter().GetZ();
+
+        auto trafo = glm::mat4(1.0);
+        trafo = glm::translate(trafo, glm::vec3(-bboxCenterX, -bboxCenterY, -bboxCenterZ));
+        trafo = glm::scale(trafo, scale);
+        trafo = glm::toMat4(rotation) * trafo;
+        trafo = glm::translate(trafo, glm::vec3(bboxCenterX, bboxCenterY, bboxCenterZ));
+        trafo = glm::translate(trafo, translation);
+
+        return trafo;
+    }
+};
+
+Transformation transformation(core::param::ParamSlot const& translateSlot,
+    core::param::ParamSlot const& quaternionSlot, core::param::ParamSlot const& scaleSlot) {
+    auto const& ts = translateSlot.Param<core::param::Vector3fParam>()->Value();
+    auto const& qs = quaternionSlot.Param<core::param::Vector4fParam>()->Value();
+    auto const& ss = scaleSlot.Param<core::param::Vector3fParam>()->Value();
+    return Transformation{glm::vec3(ts.GetX(), ts.GetY(), ts.GetZ()),
+        glm::quat(qs.GetW(), qs.GetX(), qs.GetY(), qs.GetZ()), glm::vec3(ss.GetX(), ss.GetY(), ss.GetZ())};
+}
+
+/** Conservatively transforms a box by transforming its corners */
+void transformBBox(glm::mat4 const& trafo, vislib::math::Cuboid<float>& box) {
+    if (box.IsEmpty())
+        return;
+    auto lbb = glm::vec3(std::numeric_limits<float>::max());
+    auto rtf = glm::vec3(std::numeric_limits<float>::lowest());
+    for (int c = 0; c < 8; ++c) {
+        glm::vec4 const corner((c & 1) ? box.Right() : box.Left(), (c & 2) ? box.Top() : box.Bottom(),
+            (c & 4) ? box.Front() : box.Back(), 1.0f);
+        glm::vec3 const pos = trafo * corner;
+        lbb = glm::min(lbb, pos);
+        rtf = glm::max(rtf, pos);
+    }
+    box.Set(lbb.x, lbb.y, lbb.z, rtf.x, rtf.y, rtf.z);
+}
+
+/**
+ * Does what the module does: transforms the positions centred on the bounding box of the input, drops per-particle
+ * radii in favour of the global radius scaled by the x scale factor and writes the colours as float RGBA.
+ */
+class TranslateRotateScaleOperator : public geocalls::ParticleOperator {
+public:
+    TranslateRotateScaleOperator(Transformation const& trafo, vislib::math::Cuboid<float> const& bbox)
+            : trafo(trafo)
+            , bboxTrafo(trafo.Matrix(bbox)) {}
+
+    unsigned int Writes() const override {
+        return ATTR_POSITION | ATTR_COLOUR;
+    }
+
+    bool UsesBBox() const override {
+        return true;
+    }
+
+    void Configure(std::vector<geocalls::ParticleListState>& states) const override {
+        for (auto& s : states) {
+            s.vertexType = geocalls::SimpleSphericalParticles::VERTDATA_FLOAT_XYZ;
+            s.colourType = geocalls::SimpleSphericalParticles::COLDATA_FLOAT_RGBA;
+            s.globalRadius *= trafo.scale.x;
+        }
+    }
+
+    void Apply(geocalls::ParticleBatch& batch, geocalls::ParticleListState const& in,
+        geocalls::ParticleListState const& out) const override {
+        // the batch holds the colours as the module reads them through the accessors
+        auto const mat = trafo.Matrix(in.bbox);
+        for (size_t i = 0; i < batch.count; ++i) {
+            glm::vec4 const pos = mat * glm::vec4(batch.x[i], batch.y[i], batch.z[i], 1.0f);
+            batch.x[i] = pos.x;
+            batch.y[i] = pos.y;
+            batch.z[i] = pos.z;
+        }
+    }
+
+    void TransformBBox(vislib::math::Cuboid<float>& box) const override {
+        transformBBox(bboxTrafo, box);
+    }
+
+private:
+    Transformation trafo;
+
+    /** The transformation for the bounding box the operator has been created for */
+    glm::mat4 bboxTrafo;
+};
+
+} // namespace
+
 
 /*
  * datatools::ParticleTranslateRotateScale::ParticleTranslateRotateScale
  */
 datatools::ParticleTranslateRotateScale::ParticleTranslateRotateScale()
-        : AbstractParticleManipulator("outData", "indata")
+        : AbstractParticleOperatorManipulator("outData", "indata")
         , translateSlot("translation", "Translates the particles in x, y, z direction")
         , quaternionSlot("quaternion", "Rotates the particles around x, y, z axes")
         , scaleSlot("scale", "Scales the particle data")
@@ -37,6 +139,10 @@ datatools::ParticleTranslateRotateScale::ParticleTranslateRotateScale()
 
     this->scaleSlot.SetParameter(new core::param::Vector3fParam(vislib::math::Vector<float, 3>(1, 1, 1)));
     this->MakeSlotAvailable(&this->scaleSlot);
+
+    this->addOperatorParam(this->translateSlot);
+    this->addOperatorParam(this->quaternionSlot);
+    this->addOperatorParam(this->scaleSlot);
 }
 
 
@@ -67,33 +173,25 @@ void datatools::ParticleTranslateRotateScale::InterfaceResetDirty() {
 
 
 /*
- * datatools::ParticleTranslateRotateScale::manipulateData
+ * datatools::ParticleTranslateRotateScale::createOperator
  */
-bool datatools::ParticleTranslateRotateScale::manipulateData(
-    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
-    using geocalls::MultiParticleDataCall;
+std::shared_ptr<geocalls::ParticleOperator const> datatools::ParticleTranslateRotateScale::createOperator(
+    geocalls::MultiParticleDataCall& inData) {
+    return std::make_shared<TranslateRotateScaleOperator>(
+        transformation(translateSlot, quaternionSlot, scaleSlot), inData.GetBoundingBoxes().ObjectSpaceBBox());
+}
 
 
-    const float transX = translateSlot.Param<core::param::Vector3fParam>()->Value().GetX();
-    const float transY = translateSlot.Param<core::param::Vector3fParam>()->Value().GetY();
-    const float transZ = translateSlot.Param<core::param::Vector3fParam>()->Value().GetZ();
+/*
+ * datatools::ParticleTranslateRotateScale::manipulateDataDirect
+ */
+bool datatools::ParticleTranslateRotateScale::manipulateDataDirect(
+    geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) {
+    using geocalls::MultiParticleDataCall;
 
+    auto const trafo =
+        transformation(translateSlot, quaternionSlot, scaleSlot).Matrix(inData.GetBoundingBoxes().ObjectSpaceBBox());
     const float scaleX = scaleSlot.Param<core::param::Vector3fParam>()->Value().GetX();
-    const float scaleY = scaleSlot.Param<core::param::Vector3fParam>()->Value().GetY();
-    const float scaleZ = scaleSlot.Param<core::param::Vector3fParam>()->Value().GetZ();
-
-    auto bboxCenterX = inData.GetBoundingBoxes().ObjectSpaceBBox().CalcCenter().GetX();
-    auto bboxCenterY = inData.GetBoundingBoxes().ObjectSpaceBBox().CalcCenter().GetY();
-    auto bboxCenterZ = inData.GetBoundingBoxes().ObjectSpaceBBox().CalcCenter().GetZ();
-
-    auto trafo = glm::mat4(1.0);
-    trafo = glm::translate(trafo, glm::vec3(-bboxCenterX, -bboxCenterY, -bboxCenterZ));
-    trafo = glm::scale(trafo, glm::vec3(scaleX, scaleY, scaleZ));
-    auto& qs = quaternionSlot.Param<core::param::Vector4fParam>()->Value();
-    auto glmq = glm::quat(qs.GetW(), qs.GetX(), qs.GetY(), qs.GetZ());
-    trafo = glm::toMat4(glmq) * trafo;
-    trafo = glm::translate(trafo, glm::vec3(bboxCenterX, bboxCenterY, bboxCenterZ));
-    trafo = glm::translate(trafo, glm::vec3(transX, transY, transZ));
 
     if (InterfaceIsDirty() || (hash != inData.DataHash()) || (inData.DataHash() == 0) ||
         (frameID != inData.FrameID())) {
@@ -210,9 +308,16 @@ bool datatools::ParticleTranslateRotateScale::manipulateExtent(
 
     outData = inData;
 
-    if (!_global_box.IsEmpty()) {
-        outData.AccessBoundingBoxes().SetObjectSpaceBBox(_global_box);
-        outData.AccessBoundingBoxes().SetObjectSpaceClipBox(_global_box);
+    auto box = _global_box;
+    if (getFusedBBox(box) && box.IsEmpty()) {
+        // the transformation is deferred, answer the transformed box of the input
+        box = inData.GetBoundingBoxes().ObjectSpaceBBox();
+        transformBBox(transformation(translateSlot, quaternionSlot, scaleSlot).Matrix(box), box);
+    }
+
+    if (!box.IsEmpty()) {
+        outData.AccessBoundingBoxes().SetObjectSpaceBBox(box);
+        outData.AccessBoundingBoxes().SetObjectSpaceClipBox(box);
     }
 
     return true;
@@ -7,7 +7,7 @@
 
 #pragma once
 
-#include "datatools/AbstractParticleManipulator.h"
+#include "datatools/AbstractParticleOperatorManipulator.h"
 #include "mmcore/param/ParamSlot.h"
 
 
@@ -18,7 +18,7 @@ namespace megamol::datatools {
  *
  * Migrated from SGrottel particle's tool box
  */
-class ParticleTranslateRotateScale : public AbstractParticleManipulator {
+class ParticleTranslateRotateScale : public AbstractParticleOperatorManipulator {
 public:
     /** Return module class name */
     static const char* ClassName() {
@@ -45,16 +45,24 @@ public:
 
 protected:
     /**
-     * Manipulates the particle data
+     * Creates the operator transforming the positions, used when fused with other manipulators
+     *
+     * @param inData The call holding the original data
      *
-     * @remarks the default implementation does not changed the data
+     * @return The operator
+     */
+    std::shared_ptr<geocalls::ParticleOperator const> createOperator(geocalls::MultiParticleDataCall& inData) override;
+
+    /**
+     * Manipulates the particle data
      *
      * @param outData The call receiving the manipulated data
      * @param inData The call holding the original data
      *
      * @return True on success
      */
-    bool manipulateData(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
+    bool manipulateDataDirect(
+        geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
     bool manipulateExtent(geocalls::MultiParticleDataCall& outData, geocalls::MultiParticleDataCall& inData) override;
 
 private:
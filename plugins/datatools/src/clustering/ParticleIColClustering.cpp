@@ -3,6 +3,8 @@
 #include "mmcore/param/FloatParam.h"
 #include "mmcore/param/IntParam.h"
 
+#include "geometry_calls/ParticleBulkAccess.h"
+
 
 megamol::datatools::clustering::ParticleIColClustering::ParticleIColClustering()
         : AbstractParticleManipulator("outData", "inData")
@@ -60,16 +62,16 @@ bool megamol::datatools::clustering::ParticleIColClustering::manipulateData(
 
                 std::vector<float> cur_points(p_count * 4);
 
-                auto const xAcc = parts.GetParticleStore().GetXAcc();
-                auto const yAcc = parts.GetParticleStore().GetYAcc();
-                auto const zAcc = parts.GetParticleStore().GetZAcc();
-                auto const iAcc = parts.GetParticleStore().GetCRAcc();
-
-                for (std::remove_const_t<decltype(p_count)> pidx = 0; pidx < p_count; ++pidx) {
-                    cur_points[pidx * 4 + 0] = xAcc->Get_f(pidx);
-                    cur_points[pidx * 4 + 1] = yAcc->Get_f(pidx);
-                    cur_points[pidx * 4 + 2] = zAcc->Get_f(pidx);
-                    cur_points[pidx * 4 + 3] = iAcc->Get_f(pidx);
+                std::array<std::array<float, geocalls::ParticleBatchSize>, 4> batch;
+                for (size_t first = 0; first < p_count; first += geocalls::ParticleBatchSize) {
+                    size_t const num = std::min<size_t>(geocalls::ParticleBatchSize, p_count - first);
+                    geocalls::UnpackPositions(parts, first, num, batch[0].data(), batch[1].data(), batch[2].data());
+                    geocalls::UnpackColours(parts, first, num, batch[3].data());
+                    for (size_t i = 0; i < num; ++i) {
+                        for (size_t c = 0; c < 4; ++c) {
+                            cur_points[(first + i) * 4 + c] = batch[c][i];
+                        }
+                    }
                 }
 
                 std::array<float, 8> bbox = {p_bbox.GetLeft(), p_bbox.GetRight(), p_bbox.GetBottom(), p_bbox.GetTop(),
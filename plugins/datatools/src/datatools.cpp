@@ -29,6 +29,7 @@
 #include "MPDCGrid.h"
 #include "MPDCListsConcatenate.h"
 #include "MPIParticleCollector.h"
+#include "MPIParticleRedistributor.h"
 #include "MPIVolumeAggregator.h"
 #include "ModColIRange.h"
 #include "MultiParticleRelister.h"
@@ -52,6 +53,7 @@
 #include "ParticleNeighborhoodGraph.h"
 #include "ParticleRelaxationModule.h"
 #include "ParticleSortFixHack.h"
+#include "ParticleSpatialSort.h"
 #include "ParticleThermodyn.h"
 #include "ParticleThinner.h"
 #include "ParticleTranslateRotateScale.h"
@@ -78,6 +80,7 @@
 #include "table/TableColumnFilter.h"
 #include "table/TableColumnScaler.h"
 #include "table/TableFlagFilter.h"
+#include "table/TableGroupBy.h"
 #include "table/TableInspector.h"
 #include "table/TableItemSelector.h"
 #include "table/TableJoin.h"
@@ -150,6 +153,7 @@ public:
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableColumnScaler>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableObserverPlane>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableJoin>();
+        this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableGroupBy>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableColumnFilter>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableSampler>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::table::TableSort>();
@@ -160,6 +164,7 @@ public:
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::ParticleNeighborhood>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::ParticleThermodyn>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::MPIParticleCollector>();
+        this->module_descriptions.RegisterAutoDescription<megamol::datatools::MPIParticleRedistributor>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::MPIVolumeAggregator>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::ParticlesToDensity>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::MPDCListsConcatenate>();
@@ -168,6 +173,7 @@ public:
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::CSVFileSequence>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::IColToIdentity>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::ParticleIdentitySort>();
+        this->module_descriptions.RegisterAutoDescription<megamol::datatools::ParticleSpatialSort>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::ParticleBoxFilter>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::StaticMMPLDProvider>();
         this->module_descriptions.RegisterAutoDescription<megamol::datatools::SyncedMMPLDProvider>();
@@ -0,0 +1,234 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "datatools/misc/SpaceFillingCurve.h"
+
+#include <algorithm>
+#include <array>
+#include <cfloat>
+#include <numeric>
+
+#include <omp.h>
+
+#include "geometry_calls/ParticleBulkAccess.h"
+
+namespace {
+
+/** Spreads the lower 21 bits of v to every third bit */
+uint64_t spread_bits(uint64_t v) {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffff;
+    v = (v | v << 16) & 0x1f0000ff0000ff;
+    v = (v | v << 8) & 0x100f00f00f00f00f;
+    v = (v | v << 4) & 0x10c30c30c30c30c3;
+    v = (v | v << 2) & 0x1249249249249249;
+    return v;
+}
+
+/** Maps a coordinate to [0, 0x1fffff], the upper end of the box included, and NaN to 0 */
+uint32_t quantize(float v, float lo, float scale) {
+    auto const q = (v - lo) * scale;
+    return q > 0.0f ? static_cast<uint32_t>(std::min(q, static_cast<float>(0x1fffff))) : 0u;
+}
+
+constexpr unsigned int radix_bits = 8;
+constexpr unsigned int radix_buckets = 1u << radix_bits;
+constexpr uint64_t radix_mask = radix_buckets - 1;
+
+} // namespace
+
+
+uint64_t megamol::datatools::misc::morton_code(uint32_t x, uint32_t y, uint32_t z) {
+    return spread_bits(x) | (spread_bits(y) << 1) | (spread_bits(z) << 2);
+}
+
+
+uint64_t megamol::datatools::misc::hilbert_code(uint32_t x, uint32_t y, uint32_t z) {
+    // J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707, 2004
+    std::array<uint32_t, 3> X = {x & 0x1fffff, y & 0x1fffff, z & 0x1fffff};
+    uint32_t const M = 1u << (curve_bits_per_axis - 1);
+
+    // inverse undo excess work
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        uint32_t const P = Q - 1;
+        for (int i = 0; i < 3; ++i) {
+            if (X[i] & Q) {
+                X[0] ^= P;
+            } else {
+                uint32_t const t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // gray encode
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t Q = M; Q > 1; Q >>= 1) {
+        if (X[2] & Q) {
+            t ^= Q - 1;
+        }
+    }
+    for (auto& c : X) {
+        c ^= t;
+    }
+
+    // the transposed index has its most significant bits in X[0]
+    return morton_code(X[2], X[1], X[0]);
+}
+
+
+std::vector<uint64_t> megamol::datatools::misc::curve_keys(
+    geocalls::SimpleSphericalParticles const& p, CurveType type) {
+    auto const cnt = p.GetCount();
+
+    std::vector<uint64_t> keys(cnt);
+    if (p.GetVertexDataType() == geocalls::SimpleSphericalParticles::VERTDATA_NONE) {
+        std::iota(keys.begin(), keys.end(), 0);
+        return keys;
+    }
+
+    auto const num_batches = static_cast<int64_t>((cnt + geocalls::ParticleBatchSize - 1) / geocalls::ParticleBatchSize);
+
+    std::array<float, 3> lo = {FLT_MAX, FLT_MAX, FLT_MAX};
+    std::array<float, 3> hi = {-FLT_MAX, -FLT_MAX, -FLT_MAX};
+#pragma omp parallel
+    {
+        std::array<std::array<float, geocalls::ParticleBatchSize>, 3> pos;
+        std::array<float, 3> llo = lo;
+        std::array<float, 3> lhi = hi;
+#pragma omp for
+        for (int64_t batch = 0; batch < num_batches; ++batch) {
+            size_t const first = batch * geocalls::ParticleBatchSize;
+            size_t const num = std::min(geocalls::ParticleBatchSize, cnt - first);
+            geocalls::UnpackPositions(p, first, num, pos[0].data(), pos[1].data(), pos[2].data());
+            for (int d = 0; d < 3; ++d) {
+                for (size_t i = 0; i < num; ++i) {
+                    llo[d] = std::min(llo[d], pos[d][i]);
+                    lhi[d] = std::max(lhi[d], pos[d][i]);
+                }
+            }
+        }
+#pragma omp critical
+        {
+            for (int d = 0; d < 3; ++d) {
+                lo[d] = std::min(lo[d], llo[d]);
+                hi[d] = std::max(hi[d], lhi[d]);
+            }
+        }
+    }
+
+    std::array<float, 3> scale;
+    for (int d = 0; d < 3; ++d) {
+        // flat or empty extents map to cell 0
+        scale[d] = hi[d] > lo[d] ? static_cast<float>(0x1fffff) / (hi[d] - lo[d]) : 0.0f;
+    }
+
+    bool const hilbert = type == CurveType::Hilbert;
+#pragma omp parallel
+    {
+        std::array<std::array<float, geocalls::ParticleBatchSize>, 3> pos;
+#pragma omp for
+        for (int64_t batch = 0; batch < num_batches; ++batch) {
+            size_t const first = batch * geocalls::ParticleBatchSize;
+            size_t const num = std::min(geocalls::ParticleBatchSize, cnt - first);
+            geocalls::UnpackPositions(p, first, num, pos[0].data(), pos[1].data(), pos[2].data());
+            for (size_t i = 0; i < num; ++i) {
+                auto const qx = quantize(pos[0][i], lo[0], scale[0]);
+                auto const qy = quantize(pos[1][i], lo[1], scale[1]);
+                auto const qz = quantize(pos[2][i], lo[2], scale[2]);
+                keys[first + i] = hilbert ? hilbert_code(qx, qy, qz) : morton_code(qx, qy, qz);
+            }
+        }
+    }
+
+    return keys;
+}
+
+
+std::vector<uint64_t> megamol::datatools::misc::sort_permutation(std::vector<uint64_t> const& keys) {
+    auto const cnt = keys.size();
+
+    std::vector<uint64_t> src_keys(keys);
+    std::vector<uint64_t> src_idx(cnt);
+    std::iota(src_idx.begin(), src_idx.end(), 0);
+    if (cnt < 2) {
+        return src_idx;
+    }
+    std::vector<uint64_t> dst_keys(cnt);
+    std::vector<uint64_t> dst_idx(cnt);
+
+    int const num_threads = std::max(1, std::min<int>(omp_get_max_threads(), static_cast<int>(cnt / 4096) + 1));
+    // per-thread histograms, thread t covers the contiguous range [t * chunk, (t + 1) * chunk)
+    std::vector<size_t> hist(num_threads * radix_buckets);
+    size_t const chunk = (cnt + num_threads - 1) / num_threads;
+
+    for (unsigned int shift = 0; shift < 64; shift += radix_bits) {
+        std::fill(hist.begin(), hist.end(), 0);
+
+#pragma omp parallel num_threads(num_threads)
+        {
+            // the runtime may hand out fewer threads than requested
+            for (int t = omp_get_thread_num(); t < num_threads; t += omp_get_num_threads()) {
+                size_t const begin = std::min(cnt, t * chunk);
+                size_t const end = std::min(cnt, begin + chunk);
+                auto* h = hist.data() + t * radix_buckets;
+                for (size_t i = begin; i < end; ++i) {
+                    ++h[(src_keys[i] >> shift) & radix_mask];
+                }
+            }
+        }
+
+        // skip passes in which all keys share the digit
+        bool trivial = false;
+        for (unsigned int b = 0; b < radix_buckets; ++b) {
+            size_t sum = 0;
+            for (int t = 0; t < num_threads; ++t) {
+                sum += hist[t * radix_buckets + b];
+            }
+            if (sum == cnt) {
+                trivial = true;
+            }
+            if (sum != 0) {
+                break;
+            }
+        }
+        if (trivial) {
+            continue;
+        }
+
+        // exclusive prefix sum over (bucket, thread) keeps the sort stable
+        size_t offset = 0;
+        for (unsigned int b = 0; b < radix_buckets; ++b) {
+            for (int t = 0; t < num_threads; ++t) {
+                auto const c = hist[t * radix_buckets + b];
+                hist[t * radix_buckets + b] = offset;
+                offset += c;
+            }
+        }
+
+#pragma omp parallel num_threads(num_threads)
+        {
+            for (int t = omp_get_thread_num(); t < num_threads; t += omp_get_num_threads()) {
+                size_t const begin = std::min(cnt, t * chunk);
+                size_t const end = std::min(cnt, begin + chunk);
+                auto* h = hist.data() + t * radix_buckets;
+                for (size_t i = begin; i < end; ++i) {
+                    auto const pos = h[(src_keys[i] >> shift) & radix_mask]++;
+                    dst_keys[pos] = src_keys[i];
+                    dst_idx[pos] = src_idx[i];
+                }
+            }
+        }
+
+        src_keys.swap(dst_keys);
+        src_idx.swap(dst_idx);
+    }
+
+    return src_idx;
+}
@@ -13,15 +13,21 @@
 #include "mmcore/param/FilePathParam.h"
 #include "mmcore/param/IntParam.h"
 #include "mmcore/param/StringParam.h"
-
-#include "vislib/StringTokeniser.h"
-#include "vislib/sys/ASCIIFileBuffer.h"
+#include "mmcore/utility/AtomicFileWriter.h"
+#include "mmcore/utility/CacheFile.h"
+
+#include "vislib/Exception.h"
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <future>
 #include <limits>
-#include <list>
-#include <map>
 #include <omp.h>
 #include <random>
-#include <sstream>
+#include <unordered_map>
 #include <vector>
 
 using namespace megamol::datatools;
@@ -30,54 +36,329 @@ using namespace megamol;
 
 enum class DecimalSeparator : int { Unknown = 0, US = 1, DE = 2 };
 
-template<char C>
-std::istream& expect(std::istream& is) {
-    if ((is >> std::ws).peek() == C) {
-        is.ignore();
-    } else {
-        is.setstate(std::ios_base::failbit);
+namespace {
+
+/** The number of bytes read from the file at once, the next block is read while the current one is parsed. */
+constexpr std::size_t BlockSize = 64 * 1024 * 1024;
+
+/** The number of data lines used to detect the decimal separator and the column types. */
+constexpr std::size_t SampleLines = 1000;
+
+/** Identifies the layout of the cache files. */
+constexpr const char* CacheMagic = "MMCSVCACHE2";
+
+struct CSVFormat {
+    std::string colSep;
+    DecimalSeparator decSep;
+    std::string comment;
+};
+
+/** The rows parsed from a part of a block. */
+struct ParsedRows {
+    std::vector<float> values;
+
+    /** The categories of every column, mapped to codes in order of their first appearance in this part. */
+    std::vector<std::unordered_map<std::string, float>> categories;
+
+    /** Maps the codes of 'categories' to the codes of the whole table. */
+    std::vector<std::vector<float>> remap;
+
+    std::vector<std::uint8_t> sawText;
+    std::vector<std::size_t> invalid;
+    std::vector<float> minimum;
+    std::vector<float> maximum;
+};
+
+/** The whole table. */
+struct ParsedTable {
+    std::vector<float> values;
+    std::vector<std::vector<std::string>> categories;
+    std::vector<std::uint8_t> sawText;
+    std::vector<std::size_t> invalid;
+    std::vector<float> minimum;
+    std::vector<float> maximum;
+};
+
+inline char* findSeparator(char* begin, char* end, const std::string& sep) {
+    if (sep.size() == 1) {
+        auto pos = std::memchr(begin, sep[0], static_cast<std::size_t>(end - begin));
+        return (pos != nullptr) ? static_cast<char*>(pos) : end;
+    }
+    return std::search(begin, end, sep.begin(), sep.end());
+}
+
+inline void trim(char*& begin, char*& end) {
+    while ((begin < end) && ((*begin == ' ') || (*begin == '\t'))) {
+        ++begin;
+    }
+    while ((end > begin) && ((end[-1] == ' ') || (end[-1] == '\t') || (end[-1] == '\r'))) {
+        --end;
+    }
+}
+
+/** Answers whether the line holds no data. */
+inline bool isSkipped(const char* begin, const char* end, const std::string& comment) {
+    if (!comment.empty() && (static_cast<std::size_t>(end - begin) >= comment.size()) &&
+        std::equal(comment.begin(), comment.end(), begin)) {
+        return true;
     }
-    return is;
+    return std::all_of(begin, end, [](char c) { return (c == ' ') || (c == '\t') || (c == '\r'); });
 }
 
-double parseValue(const char* tokenStart, const char* tokenEnd) {
-    std::string token(tokenStart, tokenEnd - tokenStart);
+std::vector<std::string> split(std::string& line, const std::string& sep) {
+    std::vector<std::string> tokens;
+    auto begin = line.data();
+    const auto end = line.data() + line.size();
+    while (true) {
+        auto tokenEnd = findSeparator(begin, end, sep);
+        auto first = begin, last = tokenEnd;
+        trim(first, last);
+        tokens.emplace_back(first, last);
+        if (tokenEnd == end) {
+            return tokens;
+        }
+        begin = tokenEnd + sep.size();
+    }
+}
 
-    std::istringstream iss(token);
-    iss.imbue(std::locale::classic());
-    if (iss.rdbuf()->in_avail() == 0) {
-        return NAN;
+/**
+ * Parses a trimmed token as number or as timestamp (HH:mm:ss or HH:mm:ss.SSS), which is converted to milliseconds.
+ * Empty tokens are NaN.
+ *
+ * @return false if the token is text.
+ */
+bool parseNumber(char* begin, char* end, DecimalSeparator decSep, float& outValue) {
+    outValue = std::numeric_limits<float>::quiet_NaN();
+    if (begin == end) {
+        return true;
+    }
+    if (decSep == DecimalSeparator::DE) {
+        std::replace(begin, end, ',', '.');
     }
 
-    // Try to parse as number.
     double number;
-    iss >> number;
-    if (!iss.fail() && iss.eof()) {
-        return number;
+    auto result = std::from_chars((*begin == '+') ? begin + 1 : begin, end, number);
+    if ((result.ptr == end) && (result.ec == std::errc())) {
+        outValue = static_cast<float>(number);
+        return true;
+    } else if ((result.ptr == end) && (result.ec == std::errc::result_out_of_range)) {
+        return true;
+    }
+
+    unsigned int fractions[4] = {0, 0, 0, 0};
+    const char* pos = begin;
+    for (int i = 0; i < 4; ++i) {
+        auto r = std::from_chars(pos, static_cast<const char*>(end), fractions[i]);
+        if (r.ec != std::errc()) {
+            return false;
+        }
+        pos = r.ptr;
+        if (pos == end) {
+            if (i < 2) {
+                return false;
+            }
+            outValue = static_cast<float>(
+                fractions[0] * (60 * 60 * 1000) + fractions[1] * (60 * 1000) + fractions[2] * 1000 + fractions[3]);
+            return true;
+        }
+        if ((i == 3) || (*pos != ((i < 2) ? ':' : '.'))) {
+            return false;
+        }
+        ++pos;
     }
+    return false;
+}
+
+/**
+ * Parses the complete lines in [begin, end). Categorical values are stored as codes of 'out.categories'.
+ */
+void parseRows(char* begin, char* end, const CSVFormat& format, const std::vector<TableDataCall::ColumnInfo>& columns,
+    ParsedRows& out) {
+    const auto numColumns = columns.size();
+    out.values.clear();
+    out.categories.assign(numColumns, std::unordered_map<std::string, float>());
+    out.sawText.assign(numColumns, 0);
+    out.invalid.assign(numColumns, 0);
+    out.minimum.assign(numColumns, std::numeric_limits<float>::max());
+    out.maximum.assign(numColumns, std::numeric_limits<float>::lowest());
+    std::string key;
+
+    while (begin < end) {
+        auto lineEnd = static_cast<char*>(std::memchr(begin, '\n', static_cast<std::size_t>(end - begin)));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        const auto next = (lineEnd < end) ? lineEnd + 1 : end;
+        if (isSkipped(begin, lineEnd, format.comment)) {
+            begin = next;
+            continue;
+        }
+
+        // Missing values at the end of the line are NaN, additional ones are ignored
+        auto token = begin;
+        bool hasToken = true;
+        for (std::size_t c = 0; c < numColumns; ++c) {
+            float value = std::numeric_limits<float>::quiet_NaN();
+            if (hasToken) {
+                auto tokenEnd = findSeparator(token, lineEnd, format.colSep);
+                auto first = token, last = tokenEnd;
+                trim(first, last);
+                if (columns[c].Type() == TableDataCall::ColumnType::CATEGORICAL) {
+                    if (first != last) {
+                        key.assign(first, last);
+                        auto& categories = out.categories[c];
+                        value = categories.try_emplace(key, static_cast<float>(categories.size())).first->second;
+                    }
+                } else if (!parseNumber(first, last, format.decSep, value)) {
+                    out.sawText[c] = 1;
+                }
+                hasToken = (tokenEnd < lineEnd);
+                token = hasToken ? tokenEnd + format.colSep.size() : lineEnd;
+            }
 
-    // Reset stream.
-    iss.str(token);
+            if (std::isnan(value)) {
+                ++out.invalid[c];
+            } else {
+                out.minimum[c] = std::min(out.minimum[c], value);
+                out.maximum[c] = std::max(out.maximum[c], value);
+            }
+            out.values.push_back(value);
+        }
 
-    // Timestamp fractions (to be converted to milliseconds).
-    unsigned short fractions[4];
+        begin = next;
+    }
+}
 
-    // Try to parse as timestamp (HH:mm:ss)
-    iss >> fractions[0] >> expect<':'> >> fractions[1] >> expect<':'> >> fractions[2];
-    if (!iss.fail() && iss.eof()) {
-        return fractions[0] * (60 * 60 * 1000) + fractions[1] * (60 * 1000) + fractions[2] * 1000;
+/**
+ * Parses the data lines of the file starting at 'offset'. The file is read in blocks, which are split at line breaks
+ * and parsed in parallel.
+ */
+ParsedTable parseTable(const std::filesystem::path& filename, std::uint64_t offset, const CSVFormat& format,
+    const std::vector<TableDataCall::ColumnInfo>& columns) {
+    const auto numColumns = columns.size();
+    ParsedTable table;
+    table.categories.resize(numColumns);
+    table.sawText.assign(numColumns, 0);
+    table.invalid.assign(numColumns, 0);
+    table.minimum.assign(numColumns, std::numeric_limits<float>::max());
+    table.maximum.assign(numColumns, std::numeric_limits<float>::lowest());
+    std::vector<std::unordered_map<std::string, float>> codes(numColumns);
+
+    std::ifstream file(filename, std::ios::binary);
+    file.seekg(static_cast<std::streamoff>(offset));
+    if (!file) {
+        throw vislib::Exception("Failed to read the data lines", __FILE__, __LINE__);
     }
+    const auto remaining = std::filesystem::file_size(filename) - offset;
+
+    // Reads the next block after the incomplete line of the previous one, answers the end of the complete lines
+    auto fill = [&file](std::vector<char>& block, const char* carry, std::size_t carrySize, bool& eof) {
+        block.resize(carrySize + BlockSize);
+        std::copy(carry, carry + carrySize, block.begin());
+        file.read(block.data() + carrySize, BlockSize);
+        const auto count = static_cast<std::size_t>(file.gcount());
+        block.resize(carrySize + count);
+        eof = (count < BlockSize);
+        if (eof) {
+            return block.size();
+        }
+        return static_cast<std::size_t>(std::find(block.rbegin(), block.rend(), '\n').base() - block.begin());
+    };
+
+    const auto numThreads = static_cast<std::size_t>(omp_get_max_threads());
+    std::vector<char> current, next;
+    std::vector<ParsedRows> parts;
+    std::vector<std::size_t> bounds;
+    bool eof = false;
+    auto end = fill(current, nullptr, 0, eof);
+    std::uint64_t consumed = 0;
+
+    while (true) {
+        bool nextEof = false;
+        std::future<std::size_t> pending;
+        if (!eof) {
+            pending = std::async(std::launch::async,
+                [&]() { return fill(next, current.data() + end, current.size() - end, nextEof); });
+        }
+
+        // Split the block at line breaks into parts of at least 1 MiB
+        const auto numParts = std::clamp<std::size_t>(end >> 20, 1, 4 * numThreads);
+        bounds.assign(numParts + 1, end);
+        bounds[0] = 0;
+        for (std::size_t p = 1; p < numParts; ++p) {
+            auto pos = std::max(end * p / numParts, bounds[p - 1]);
+            auto lineEnd = static_cast<char*>(std::memchr(current.data() + pos, '\n', end - pos));
+            bounds[p] = (lineEnd != nullptr) ? static_cast<std::size_t>(lineEnd - current.data()) + 1 : end;
+        }
+        parts.resize(numParts);
+
+#pragma omp parallel for schedule(dynamic)
+        for (long long p = 0; p < static_cast<long long>(numParts); ++p) {
+            parseRows(current.data() + bounds[p], current.data() + bounds[p + 1], format, columns, parts[p]);
+        }
+
+        // Merge the categories in the order of the parts, so that the codes follow their first appearance in the file
+        std::size_t numValues = table.values.size();
+        for (auto& part : parts) {
+            part.remap.resize(numColumns);
+            for (std::size_t c = 0; c < numColumns; ++c) {
+                std::vector<const std::string*> names(part.categories[c].size());
+                for (const auto& category : part.categories[c]) {
+                    names[static_cast<std::size_t>(category.second)] = &category.first;
+                }
+                part.remap[c].resize(names.size());
+                for (std::size_t i = 0; i < names.size(); ++i) {
+                    auto code = codes[c].try_emplace(*names[i], static_cast<float>(codes[c].size()));
+                    if (code.second) {
+                        table.categories[c].push_back(*names[i]);
+                    }
+                    part.remap[c][i] = code.first->second;
+                }
+                table.sawText[c] |= part.sawText[c];
+                table.invalid[c] += part.invalid[c];
+                table.minimum[c] = std::min(table.minimum[c], part.minimum[c]);
+                table.maximum[c] = std::max(table.maximum[c], part.maximum[c]);
+            }
+            numValues += part.values.size();
+        }
 
-    // Try to parse as timestamp (HH:mm:ss.SSS)
-    iss >> expect<'.'> >> fractions[3];
-    if (!iss.fail() && iss.eof()) {
-        return fractions[0] * (60 * 60 * 1000) + fractions[1] * (60 * 1000) + fractions[2] * 1000 + fractions[3];
+        // Reserve the estimated size of the whole table instead of growing step by step
+        consumed += end;
+        if ((table.values.capacity() < numValues) && !eof && (consumed > 0)) {
+            const auto ratio = static_cast<double>(remaining) / static_cast<double>(consumed);
+            table.values.reserve(static_cast<std::size_t>(static_cast<double>(numValues) * ratio * 1.05));
+        }
+        std::vector<std::size_t> offsets(numParts + 1, table.values.size());
+        for (std::size_t p = 0; p < numParts; ++p) {
+            offsets[p + 1] = offsets[p] + parts[p].values.size();
+        }
+        table.values.resize(numValues);
+
+#pragma omp parallel for schedule(dynamic)
+        for (long long p = 0; p < static_cast<long long>(numParts); ++p) {
+            const auto& part = parts[p];
+            auto dst = table.values.data() + offsets[p];
+            for (std::size_t i = 0; i < part.values.size(); ++i) {
+                const auto c = i % numColumns;
+                const auto value = part.values[i];
+                dst[i] = (part.remap[c].empty() || std::isnan(value)) ? value
+                                                                     : part.remap[c][static_cast<std::size_t>(value)];
+            }
+        }
+
+        if (eof) {
+            break;
+        }
+        end = pending.get();
+        eof = nextEof;
+        std::swap(current, next);
     }
 
-    // Bail out.
-    return NAN;
+    return table;
 }
 
+} // namespace
+
 CSVDataSource::CSVDataSource()
         : core::Module()
         , filenameSlot("filename", "Filename to read from")
@@ -89,6 +370,8 @@ CSVDataSource::CSVDataSource()
         , colSepSlot("colSep", "The column separator (detected if empty)")
         , decSepSlot("decSep", "The decimal point parser format type")
         , shuffleSlot("shuffle", "Shuffle data points")
+        , cacheSlot("cache", "Stores the parsed table in a binary file next to the CSV file and loads it from there "
+                             "as long as the CSV file and the parsing parameters do not change")
         , getDataSlot("getData", "Slot providing the data")
         , dataHash(0)
         , columns()
@@ -125,6 +408,9 @@ CSVDataSource::CSVDataSource()
     this->shuffleSlot.SetParameter(new core::param::BoolParam(false));
     this->MakeSlotAvailable(&this->shuffleSlot);
 
+    this->cacheSlot.SetParameter(new core::param::BoolParam(false));
+    this->MakeSlotAvailable(&this->cacheSlot);
+
     this->getDataSlot.SetCallback(TableDataCall::ClassName(), "GetData", &CSVDataSource::getDataCallback);
     this->getDataSlot.SetCallback(TableDataCall::ClassName(), "GetHash", &CSVDataSource::getHashCallback);
     this->MakeSlotAvailable(&this->getDataSlot);
@@ -169,285 +455,223 @@ void CSVDataSource::assertData() {
     this->values.clear();
 
     auto filename = this->filenameSlot.Param<core::param::FilePathParam>()->Value();
+    const int skipPreface = this->skipPrefaceSlot.Param<core::param::IntParam>()->Value();
+    const bool headerNames = this->headerNamesSlot.Param<core::param::BoolParam>()->Value();
+    const bool headerTypes = this->headerTypesSlot.Param<core::param::BoolParam>()->Value();
 
-    try {
-        vislib::sys::ASCIIFileBuffer file;
+    CSVFormat format;
+    format.colSep = this->colSepSlot.Param<core::param::StringParam>()->Value();
+    format.decSep = static_cast<DecimalSeparator>(this->decSepSlot.Param<core::param::EnumParam>()->Value());
+    format.comment = this->commentPrefixSlot.Param<core::param::StringParam>()->Value();
 
-        // 1. Load the whole file into memory (FAST!)
+    try {
+        // 1. Use the cache if it has been written for this file and these parameters
         //////////////////////////////////////////////////////////////////////
-        if (!file.LoadFile(filename.native().c_str(), vislib::sys::ASCIIFileBuffer::PARSING_LINES))
-            throw vislib::Exception(__FILE__, __LINE__);
-        if (file.Count() < 2)
-            throw vislib::Exception("No data in CSV file", __FILE__, __LINE__);
+        auto cachePath = std::filesystem::path(filename).concat(".mmcache");
+        std::string cacheKey;
+        const bool useCache = this->cacheSlot.Param<core::param::BoolParam>()->Value();
+        if (useCache) {
+            cacheKey = core::utility::CacheFileKey(CacheMagic, filename);
+            if (!cacheKey.empty()) {
+                cacheKey += "|" + std::to_string(skipPreface) + "|" + std::to_string(headerNames) + "|" +
+                            std::to_string(headerTypes) + "|" + format.colSep + "|" +
+                            std::to_string(static_cast<int>(format.decSep)) + "|" + format.comment;
+            }
+            if (!cacheKey.empty() && this->readCache(cachePath, cacheKey)) {
+                megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+                    "Tabular data loaded from cache \"%s\": %u dimensions; %u samples\n",
+                    cachePath.generic_string().c_str(), static_cast<unsigned int>(this->columns.size()),
+                    static_cast<unsigned int>(this->values.size() / std::max<std::size_t>(this->columns.size(), 1)));
+                shuffleData();
+                this->dataHash++;
+                return;
+            }
+        }
 
-        // 2. Determine the first row, column separator, and decimal point
+        // 2. Determine the header rows, column separator, and decimal point
         //////////////////////////////////////////////////////////////////////
-        int firstHeaRow = this->skipPrefaceSlot.Param<core::param::IntParam>()->Value();
-        int firstDatRow = this->skipPrefaceSlot.Param<core::param::IntParam>()->Value();
-        if (headerNamesSlot.Param<core::param::BoolParam>()->Value())
-            firstDatRow++;
-        if (headerTypesSlot.Param<core::param::BoolParam>()->Value())
-            firstDatRow++;
-
-        auto comment = vislib::StringA(this->commentPrefixSlot.Param<core::param::StringParam>()->Value().c_str());
-        if (!comment.IsEmpty()) {
-            // Skip comments at the beginning of the file.
-            while (firstHeaRow < file.Count()) {
-                if (!vislib::StringA(file[firstHeaRow]).StartsWith(comment)) {
-                    break;
-                }
-                firstHeaRow++;
-                firstDatRow++;
+        std::ifstream file(filename, std::ios::binary);
+        if (!file) {
+            throw vislib::Exception("Failed to open file", __FILE__, __LINE__);
+        }
+        const auto fileSize = std::filesystem::file_size(filename);
+        auto position = [&file, fileSize]() {
+            return file.good() ? static_cast<std::uint64_t>(file.tellg()) : fileSize;
+        };
+        auto readLine = [&file](std::string& line) {
+            if (!std::getline(file, line)) {
+                return false;
+            }
+            if (!line.empty() && (line.back() == '\r')) {
+                line.pop_back();
             }
+            return true;
+        };
+
+        std::string line;
+        for (int i = 0; i < skipPreface; ++i) {
+            readLine(line);
         }
+        std::uint64_t dataOffset = 0;
+        do {
+            // Skip comments at the beginning of the file.
+            dataOffset = position();
+            if (!readLine(line)) {
+                throw vislib::Exception("No data in CSV file", __FILE__, __LINE__);
+            }
+        } while (!format.comment.empty() && (line.compare(0, format.comment.size(), format.comment) == 0));
 
-        vislib::StringA colSep(this->colSepSlot.Param<core::param::StringParam>()->Value().c_str());
-        if (colSep.IsEmpty()) {
+        if (format.colSep.empty()) {
             // Detect column separator
             const char ColSepCanidates[] = {'\t', ';', ',', '|'};
-            vislib::StringA l1(file[firstHeaRow]);
-            vislib::StringA l2(file[firstHeaRow]);
-            for (int i = 0; i < sizeof(ColSepCanidates) / sizeof(char); ++i) {
-                SIZE_T c1 = l1.Count(ColSepCanidates[i]);
-                if ((c1 > 0) && (c1 == l2.Count(ColSepCanidates[i]))) {
-                    colSep.Append(ColSepCanidates[i]);
+            for (auto candidate : ColSepCanidates) {
+                if (line.find(candidate) != std::string::npos) {
+                    format.colSep.push_back(candidate);
                     break;
                 }
             }
-            if (colSep.IsEmpty()) {
+            if (format.colSep.empty()) {
                 throw vislib::Exception("Failed to detect column separator", __FILE__, __LINE__);
             }
         }
 
-        DecimalSeparator decType =
-            static_cast<DecimalSeparator>(this->decSepSlot.Param<core::param::EnumParam>()->Value());
-        if (decType == DecimalSeparator::Unknown) {
-            // Detect decimal type
-            vislib::Array<vislib::StringA> tokens(vislib::StringTokeniserA::Split(file[firstDatRow], colSep, false));
-            for (SIZE_T i = 0; i < tokens.Count(); i++) {
-                bool hasDot = tokens[i].Contains('.');
-                bool hasComma = tokens[i].Contains(',');
-                if (hasDot && !hasComma) {
-                    decType = DecimalSeparator::US;
-                    break;
-                } else if (hasComma && !hasDot) {
-                    decType = DecimalSeparator::DE;
-                    break;
-                }
-            }
-            if (decType == DecimalSeparator::Unknown) {
-                // Assume US format if detection failed.
-                decType = DecimalSeparator::US;
-            }
-        }
-
         // 3. Table layout is now clear... determine column headers.
         //////////////////////////////////////////////////////////////////////
-        vislib::Array<vislib::StringA> dimNames;
-        if (headerNamesSlot.Param<core::param::BoolParam>()->Value()) {
-            dimNames = vislib::StringTokeniserA::Split(file[firstHeaRow], colSep, false);
-            firstHeaRow++;
+        auto dimNames = split(line, format.colSep);
+        if (headerNames) {
+            dataOffset = position();
+            if (headerTypes && !readLine(line)) {
+                throw vislib::Exception("No data in CSV file", __FILE__, __LINE__);
+            }
         } else {
-            dimNames = vislib::StringTokeniserA::Split(file[firstHeaRow], colSep, false);
-            for (SIZE_T i = 0; i < dimNames.Count(); ++i) {
-                dimNames[i].Format("Dim %d", static_cast<int>(i));
+            for (std::size_t i = 0; i < dimNames.size(); ++i) {
+                dimNames[i] = "Dim " + std::to_string(i);
             }
         }
-        this->columns.resize(dimNames.Count());
-        this->values.clear();
+        if (headerTypes) {
+            dataOffset = position();
+        }
 
-        bool hasCatDims = false;
-        if (headerTypesSlot.Param<core::param::BoolParam>()->Value()) {
-            vislib::Array<vislib::StringA> tokens(vislib::StringTokeniserA::Split(file[firstHeaRow], colSep, false));
-            for (SIZE_T i = 0; i < dimNames.Count(); i++) {
+        this->columns.resize(dimNames.size());
+        std::vector<bool> fixedTypes(dimNames.size(), headerTypes);
+        {
+            auto tokens = headerTypes ? split(line, format.colSep) : std::vector<std::string>();
+            for (std::size_t i = 0; i < dimNames.size(); i++) {
                 TableDataCall::ColumnType type = TableDataCall::ColumnType::QUANTITATIVE;
-                if (tokens.Count() > i && tokens[i].Equals("CATEGORICAL", true)) {
+                if ((tokens.size() > i) && vislib::StringA(tokens[i].c_str()).Equals("CATEGORICAL", true)) {
                     type = TableDataCall::ColumnType::CATEGORICAL;
-                    hasCatDims = true;
                 }
-                this->columns[i]
-                    .SetName(dimNames[i].PeekBuffer())
-                    .SetType(type)
-                    .SetMinimumValue(0.0f)
-                    .SetMaximumValue(1.0f);
-            }
-        } else {
-            for (SIZE_T i = 0; i < dimNames.Count(); i++) {
-                this->columns[i]
-                    .SetName(dimNames[i].PeekBuffer())
-                    .SetType(TableDataCall::ColumnType::QUANTITATIVE)
-                    .SetMinimumValue(0.0f)
-                    .SetMaximumValue(1.0f);
+                this->columns[i].SetName(dimNames[i]).SetType(type).SetMinimumValue(0.0f).SetMaximumValue(1.0f);
             }
         }
 
-        // 4. Data format is now clear... finally parse actual data
-        //////////////////////////////////////////////////////////////////////
-        size_t colCnt = static_cast<size_t>(this->columns.size());
-        size_t rowCnt = static_cast<size_t>(file.Count() - firstDatRow);
-        int colSepEnd = colSep.Length() - 1;
-
-        // Test for empty lines at the end
-        for (; rowCnt > 0; --rowCnt) {
-            const char* start = file[firstDatRow + rowCnt - 1];
-            const char* end = start;
-            size_t col = 0;
-            while ((*end != '\0') && (col < colCnt)) {
-                int colSepPos = 0;
-                while ((*end != '\0') && ((*end != colSep[colSepEnd]) || (colSepEnd != colSepPos))) {
-                    if (*end == colSep[colSepPos])
-                        colSepPos++;
-                    else
-                        colSepPos = 0;
-                    ++end;
-                }
-                col++;
+        // Sample the first data rows
+        std::vector<std::vector<std::string>> sample;
+        file.clear();
+        file.seekg(static_cast<std::streamoff>(dataOffset));
+        while ((sample.size() < SampleLines) && readLine(line)) {
+            if (!isSkipped(line.data(), line.data() + line.size(), format.comment)) {
+                sample.push_back(split(line, format.colSep));
             }
-            if (col >= colCnt)
-                break; // we found the last line containing a full data set
-        }
-
-        // Parse in parallel, assuming all lines will work
-        std::vector<std::map<std::string, float>> catMaps;
-        int thCnt = omp_get_max_threads();
-        catMaps.resize(colCnt * thCnt);
-        values.resize(colCnt * rowCnt);
-        bool hasInvalids = false;
-
-#pragma omp parallel for
-        for (long long idx = 0; idx < static_cast<long long>(rowCnt); ++idx) {
-            int thId = omp_get_thread_num();
-            const char* start = file[static_cast<size_t>(firstDatRow + idx)];
-            const char* end = start;
-            size_t col = 0;
-            while ((*end != '\0') && (col < colCnt)) {
-                std::map<std::string, float>& catMap = catMaps[thId + col * thCnt];
-                int colSepPos = 0;
-                while ((*end != '\0') && ((*end != colSep[colSepEnd]) || (colSepEnd != colSepPos))) {
-                    if (*end == colSep[colSepPos])
-                        colSepPos++;
-                    else
-                        colSepPos = 0;
-                    ++end;
-                }
+        }
+        file.close();
 
-                if (this->columns[col].Type() == TableDataCall::ColumnType::QUANTITATIVE) {
-                    if (decType == DecimalSeparator::DE) {
-                        for (char* ez = const_cast<char*>(start); ez != end; ++ez)
-                            if (*ez == ',')
-                                *ez = '.';
-                    }
-                    double value = parseValue(start, end);
-                    values[static_cast<size_t>(idx * colCnt + col)] = static_cast<float>(value);
-                    if (std::isnan(value)) {
-                        hasInvalids = true;
-                    }
-                } else if (this->columns[col].Type() == TableDataCall::ColumnType::CATEGORICAL) {
-                    assert(hasCatDims);
-                    std::map<std::string, float>::iterator cmi = catMap.find(start);
-                    if (cmi == catMap.end()) {
-                        cmi = catMap
-                                  .insert(std::pair<std::string, float>(
-                                      start, static_cast<float>(thId + thCnt * catMap.size())))
-                                  .first;
-                    }
-                    values[static_cast<size_t>(idx * colCnt + col)] = cmi->second;
-                } else {
-                    assert(false);
+        if ((format.decSep == DecimalSeparator::Unknown) && !sample.empty()) {
+            // Detect decimal type
+            for (const auto& token : sample.front()) {
+                bool hasDot = (token.find('.') != std::string::npos);
+                bool hasComma = (token.find(',') != std::string::npos);
+                if (hasDot && !hasComma) {
+                    format.decSep = DecimalSeparator::US;
+                    break;
+                } else if (hasComma && !hasDot) {
+                    format.decSep = DecimalSeparator::DE;
+                    break;
                 }
+            }
+        }
+        if (format.decSep == DecimalSeparator::Unknown) {
+            // Assume US format if detection failed.
+            format.decSep = DecimalSeparator::US;
+        }
 
-                col++;
-                if (*end != '\0') {
-                    start = end + 1;
-                    end = start;
+        // Columns without given type are categorical if the sample holds text
+        for (auto& tokens : sample) {
+            for (std::size_t c = 0; c < std::min(tokens.size(), this->columns.size()); ++c) {
+                float value;
+                if (!fixedTypes[c] && !parseNumber(tokens[c].data(), tokens[c].data() + tokens[c].size(),
+                                          format.decSep, value)) {
+                    this->columns[c].SetType(TableDataCall::ColumnType::CATEGORICAL);
                 }
             }
-            for (; col < colCnt; ++col) {
-                values[static_cast<size_t>(idx * colCnt + col)] = std::numeric_limits<float>::quiet_NaN();
-                hasInvalids = true;
+        }
+
+        // 4. Data format is now clear... finally parse actual data
+        //////////////////////////////////////////////////////////////////////
+        auto table = parseTable(filename, dataOffset, format, this->columns);
+
+        // Parse again if the sample did not reveal all categorical columns
+        bool retypes = false;
+        for (std::size_t c = 0; c < this->columns.size(); ++c) {
+            if (!fixedTypes[c] && table.sawText[c] &&
+                (this->columns[c].Type() == TableDataCall::ColumnType::QUANTITATIVE)) {
+                this->columns[c].SetType(TableDataCall::ColumnType::CATEGORICAL);
+                retypes = true;
             }
         }
+        if (retypes) {
+            megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+                "Text found beyond the first %u rows of \"%s\", parsing again with categorical columns",
+                static_cast<unsigned int>(SampleLines), filename.generic_string().c_str());
+            table = parseTable(filename, dataOffset, format, this->columns);
+        }
+
+        const size_t colCnt = this->columns.size();
+        const size_t rowCnt = (colCnt > 0) ? table.values.size() / colCnt : 0;
+        this->values = std::move(table.values);
 
         // Report invalid data if present (note: do not drop data!)
-        if (hasInvalids) {
+        if (std::any_of(table.invalid.begin(), table.invalid.end(), [](std::size_t i) { return i > 0; })) {
             megamol::core::utility::log::Log::DefaultLog.WriteWarn("CSV file contains invalid data:");
             for (size_t c = 0; c < colCnt; ++c) {
-                std::stringstream ss;
-                bool invalidColumn = true;
-                for (size_t r = 0; r < rowCnt; ++r) {
-                    float value = values[r * colCnt + c];
-                    if (std::isnan(value)) {
-                        size_t line = 1 + firstDatRow + r;
-                        ss << line << " ";
-                    } else {
-                        invalidColumn = false;
-                    }
-                }
-                std::string lines = ss.str();
-                if (invalidColumn) {
+                if (table.invalid[c] == rowCnt) {
                     megamol::core::utility::log::Log::DefaultLog.WriteWarn("  lines in column %d: all", 1 + c);
-                } else if (!lines.empty()) {
+                } else if (table.invalid[c] > 0) {
                     megamol::core::utility::log::Log::DefaultLog.WriteWarn(
-                        "  lines in column %d: %s", 1 + c, lines.c_str());
-                }
-            }
-        }
-
-        // Merge categorical data so that all `value indices` map to one `string key`
-        if (hasCatDims) {
-            for (size_t c = 0; c < colCnt; ++c) {
-                if (columns[c].Type() != TableDataCall::ColumnType::CATEGORICAL)
-                    continue;
-                std::map<int, int> catRemap;
-                std::map<std::string, int> catMap;
-                for (int ci = static_cast<int>(c) * thCnt; ci < static_cast<int>(c + 1) * thCnt; ++ci) {
-                    for (const std::pair<std::string, float>& p : catMaps[ci]) {
-                        int vi = static_cast<int>(p.second + 0.49f);
-                        std::map<std::string, int>::iterator cmi = catMap.find(p.first);
-                        if (cmi == catMap.end()) {
-                            int nv = static_cast<int>(catMap.size());
-                            catMap[p.first] = nv;
-                            catRemap[vi] = nv;
-                        } else {
-                            catRemap[vi] = cmi->second;
-                        }
-                    }
-                }
-
-                for (size_t r = 0; r < rowCnt; ++r) {
-                    int vi = static_cast<int>(values[r * colCnt + c] + 0.49f);
-                    values[r * colCnt + c] = static_cast<float>(catRemap[vi]);
+                        "  lines in column %d: %zu", 1 + c, table.invalid[c]);
                 }
             }
         }
 
-        // Collect min/max
-        std::vector<float> minVals(colCnt, std::numeric_limits<float>::max());
-        std::vector<float> maxVals(colCnt, -std::numeric_limits<float>::max());
-        for (size_t r = 0; r < rowCnt; ++r) {
-            for (size_t c = 0; c < colCnt; ++c) {
-                float f = values[r * colCnt + c];
-                if (f < minVals[c])
-                    minVals[c] = f;
-                if (f > maxVals[c])
-                    maxVals[c] = f;
-            }
-        }
+        // Collect min/max, categorical values index the categories
         for (size_t c = 0; c < colCnt; ++c) {
-            columns[c].SetMinimumValue(minVals[c]).SetMaximumValue(maxVals[c]);
+            if (this->columns[c].Type() == TableDataCall::ColumnType::CATEGORICAL) {
+                table.minimum[c] = 0.0f;
+                table.maximum[c] = static_cast<float>(std::max<std::size_t>(table.categories[c].size(), 1) - 1);
+            } else if (table.minimum[c] > table.maximum[c]) {
+                table.minimum[c] = table.maximum[c] = 0.0f;
+            }
+            this->columns[c].SetMinimumValue(table.minimum[c]).SetMaximumValue(table.maximum[c]);
         }
 
-        // 5. All done... report summary
+        // 5. All done... report summary and fill the cache
         //////////////////////////////////////////////////////////////////////
         megamol::core::utility::log::Log::DefaultLog.WriteInfo("Tabular data loaded: %u dimensions; %u samples\n",
             static_cast<unsigned int>(colCnt), static_cast<unsigned int>(rowCnt));
 
+        if (!cacheKey.empty() && !this->writeCache(cachePath, cacheKey)) {
+            megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+                "Could not write the cache \"%s\"", cachePath.generic_string().c_str());
+        }
+
     } catch (const vislib::Exception& ex) {
         megamol::core::utility::log::Log::DefaultLog.WriteError("Could not load \"%s\": %s [%s, %d]",
             filename.generic_string().c_str(), ex.GetMsgA(), ex.GetFile(), ex.GetLine());
         this->columns.clear();
         this->values.clear();
-    } catch (...) {
+    } catch (const std::exception& ex) {
+        megamol::core::utility::log::Log::DefaultLog.WriteError(
+            "Could not load \"%s\": %s", filename.generic_string().c_str(), ex.what());
         this->columns.clear();
         this->values.clear();
     }
@@ -457,6 +681,60 @@ void CSVDataSource::assertData() {
     this->dataHash++;
 }
 
+bool CSVDataSource::readCache(const std::filesystem::path& path, const std::string& key) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    try {
+        if (core::utility::ReadCacheString(file) != key) {
+            return false;
+        }
+        this->columns.resize(core::utility::ReadCacheValue<std::uint64_t>(file));
+        for (auto& column : this->columns) {
+            auto name = core::utility::ReadCacheString(file);
+            auto type = static_cast<TableDataCall::ColumnType>(core::utility::ReadCacheValue<std::uint8_t>(file));
+            auto minimum = core::utility::ReadCacheValue<float>(file);
+            auto maximum = core::utility::ReadCacheValue<float>(file);
+            column.SetName(name).SetType(type).SetMinimumValue(minimum).SetMaximumValue(maximum);
+        }
+        core::utility::ReadCacheVector(file, this->values);
+        if (!this->columns.empty() && this->values.size() % this->columns.size() != 0) {
+            file.setstate(std::ios::failbit);
+        }
+    } catch (const std::exception&) {
+        file.setstate(std::ios::failbit);
+    }
+
+    if (!file) {
+        this->columns.clear();
+        this->values.clear();
+        return false;
+    }
+    return true;
+}
+
+bool CSVDataSource::writeCache(const std::filesystem::path& path, const std::string& key) const {
+    core::utility::AtomicFileWriter output(path);
+    auto& file = output.Stream();
+    if (!output.IsOpen()) {
+        return false;
+    }
+
+    core::utility::WriteCacheString(file, key);
+    core::utility::WriteCacheValue(file, static_cast<std::uint64_t>(this->columns.size()));
+    for (const auto& column : this->columns) {
+        core::utility::WriteCacheString(file, column.Name());
+        core::utility::WriteCacheValue(file, static_cast<std::uint8_t>(column.Type()));
+        core::utility::WriteCacheValue(file, column.MinimumValue());
+        core::utility::WriteCacheValue(file, column.MaximumValue());
+    }
+    core::utility::WriteCacheVector(file, this->values);
+
+    return output.Commit();
+}
+
 void CSVDataSource::shuffleData() {
     if (!this->shuffleSlot.Param<core::param::BoolParam>()->Value()) {
         // Do not shuffle, unless requested
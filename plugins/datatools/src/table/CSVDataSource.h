@@ -12,6 +12,8 @@
 #include "mmcore/CalleeSlot.h"
 #include "mmcore/Module.h"
 #include "mmcore/param/ParamSlot.h"
+#include <filesystem>
+#include <string>
 #include <vector>
 
 namespace megamol::datatools::table {
@@ -43,6 +45,23 @@ private:
     bool clearData(core::param::ParamSlot& caller);
     void shuffleData();
 
+    /**
+     * Loads the parsed table from the binary cache file.
+     *
+     * @param path The cache file.
+     * @param key  Identifies the CSV file and the parsing parameters the cache has to be written for.
+     *
+     * @return true if the cache exists and matches the key, false otherwise.
+     */
+    bool readCache(const std::filesystem::path& path, const std::string& key);
+
+    /**
+     * Stores the parsed table in the binary cache file.
+     *
+     * @return true in case of success, false otherwise.
+     */
+    bool writeCache(const std::filesystem::path& path, const std::string& key) const;
+
     core::param::ParamSlot filenameSlot;
     core::param::ParamSlot skipPrefaceSlot;
     core::param::ParamSlot headerNamesSlot;
@@ -52,6 +71,7 @@ private:
     core::param::ParamSlot colSepSlot;
     core::param::ParamSlot decSepSlot;
     core::param::ParamSlot shuffleSlot;
+    core::param::ParamSlot cacheSlot;
 
     core::CalleeSlot getDataSlot;
 
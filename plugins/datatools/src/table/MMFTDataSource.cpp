@@ -6,10 +6,15 @@
 
 #include "MMFTDataSource.h"
 
+#include <cmath>
 #include <fstream>
+#include <limits>
+#include <numeric>
 
+#include "TableKeyIndex.h"
 #include "mmcore/param/ButtonParam.h"
 #include "mmcore/param/FilePathParam.h"
+#include "mmcore/param/StringParam.h"
 
 using namespace megamol::datatools::table;
 using namespace megamol;
@@ -54,8 +59,12 @@ MMFTDataSource::MMFTDataSource()
         , getDataSlot_("getData", "Slot providing the data")
         , filenameSlot_("filename", "The file name")
         , reloadSlot_("reload", "Reload file")
+        , columnsSlot_("columns", "The columns to be loaded from chunked files, separated by ';', all if empty")
         , dataHash_(0)
         , reload_(false)
+        , isChunked_(false)
+        , frameCount_(1)
+        , frameID_(0)
         , columns_()
         , values_() {
 
@@ -64,6 +73,8 @@ MMFTDataSource::MMFTDataSource()
     reloadSlot_ << new core::param::ButtonParam();
     reloadSlot_.SetUpdateCallback(this, &MMFTDataSource::reloadCallback);
     MakeSlotAvailable(&reloadSlot_);
+    columnsSlot_ << new core::param::StringParam("");
+    MakeSlotAvailable(&columnsSlot_);
 
     getDataSlot_.SetCallback(TableDataCall::ClassName(), "GetData", &MMFTDataSource::getDataCallback);
     getDataSlot_.SetCallback(TableDataCall::ClassName(), "GetHash", &MMFTDataSource::getHashCallback);
@@ -80,66 +91,150 @@ bool MMFTDataSource::create() {
 }
 
 void MMFTDataSource::release() {
+    reader_.Close();
     columns_.clear();
     values_.clear();
 }
 
-void MMFTDataSource::assertData() {
+void MMFTDataSource::assertData(unsigned int frameID, const std::optional<TableDataCall::RowRangeHint>& hint) {
     using namespace std::string_literals;
 
-    if (!filenameSlot_.IsDirty() && !reload_) {
-        return; // nothing to do
-    }
+    if (filenameSlot_.IsDirty() || reload_) {
+        filenameSlot_.ResetDirty();
+        reload_ = false;
 
-    filenameSlot_.ResetDirty();
-    reload_ = false;
+        reader_.Close();
+        isChunked_ = false;
+        frameCount_ = 1;
+        columns_.clear();
+        values_.clear();
 
-    columns_.clear();
-    values_.clear();
+        auto filename = filenameSlot_.Param<core::param::FilePathParam>()->Value();
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "Unable to open file \"%s\". Abort.", filename.generic_string().c_str());
+            return;
+        }
+
+        try {
+            if (!(read_string(file, 6, false) == "MMFTD\0"s)) {
+                throw std::runtime_error("Wrong file format magic ID!");
+            }
+
+            auto version = read<uint16_t>(file);
+            if (version == 0) {
+                readVersion0(file);
+                dataHash_++;
+                return;
+            } else if (version != MMFTChunkedVersion) {
+                throw std::runtime_error("Wrong file format version number");
+            }
+
+            file.close();
+            reader_.Open(filename);
+            isChunked_ = true;
+            frameCount_ = static_cast<unsigned int>(std::max<std::size_t>(reader_.GetFrames().size(), 1));
+
+        } catch (std::exception& ex) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(ex.what());
+            reader_.Close();
+            isChunked_ = false;
+            columns_.clear();
+            values_.clear();
+            return;
+        }
+
+        // force loading a frame
+        frameID_ = std::numeric_limits<unsigned int>::max();
+    }
 
-    auto filename = filenameSlot_.Param<core::param::FilePathParam>()->Value();
-    std::ifstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
-        megamol::core::utility::log::Log::DefaultLog.WriteError(
-            "Unable to open file \"%s\". Abort.", filename.generic_string().c_str());
+    if (!isChunked_) {
         return;
     }
 
-    try {
-        if (!(read_string(file, 6, false) == "MMFTD\0"s)) {
-            throw std::runtime_error("Wrong file format magic ID!");
-        }
+    frameID = std::min(frameID, frameCount_ - 1);
+    if (columnsSlot_.IsDirty() || frameID != frameID_ || !(hint == hint_)) {
+        columnsSlot_.ResetDirty();
+        readFrame(frameID, hint);
+        dataHash_++;
+    }
+}
 
-        auto version = read<uint16_t>(file);
-        if (version != 0) {
-            throw std::runtime_error("Wrong file format version number");
-        }
+void MMFTDataSource::readVersion0(std::istream& file) {
+    auto colCount = read<uint32_t>(file);
+    columns_.resize(colCount);
+
+    for (uint32_t c = 0; c < colCount; ++c) {
+        TableDataCall::ColumnInfo& ci = columns_[c];
+        auto nameLen = read<uint16_t>(file);
+        ci.SetName(read_string(file, nameLen));
+        auto type = read<uint8_t>(file);
+        ci.SetType((type == 1) ? TableDataCall::ColumnType::CATEGORICAL : TableDataCall::ColumnType::QUANTITATIVE);
+        ci.SetMinimumValue(read<float>(file));
+        ci.SetMaximumValue(read<float>(file));
+    }
 
-        auto colCount = read<uint32_t>(file);
-        columns_.resize(colCount);
-
-        for (uint32_t c = 0; c < colCount; ++c) {
-            TableDataCall::ColumnInfo& ci = columns_[c];
-            auto nameLen = read<uint16_t>(file);
-            ci.SetName(read_string(file, nameLen));
-            auto type = read<uint8_t>(file);
-            ci.SetType((type == 1) ? TableDataCall::ColumnType::CATEGORICAL : TableDataCall::ColumnType::QUANTITATIVE);
-            ci.SetMinimumValue(read<float>(file));
-            ci.SetMaximumValue(read<float>(file));
-        }
+    auto rowCount = read<uint64_t>(file);
 
-        auto rowCount = read<uint64_t>(file);
+    values_ = read_vector<float>(file, rowCount * colCount);
+}
 
-        values_ = read_vector<float>(file, rowCount * colCount);
+void MMFTDataSource::readFrame(unsigned int frameID, const std::optional<TableDataCall::RowRangeHint>& hint) {
+    using megamol::core::utility::log::Log;
 
-        dataHash_++;
+    frameID_ = frameID;
+    hint_ = hint;
+    columns_.clear();
+    values_.clear();
+    if (frameID >= reader_.GetFrames().size()) {
+        return;
+    }
+
+    const auto& fileColumns = reader_.GetColumns();
+    const auto& frame = reader_.GetFrames()[frameID];
+
+    // load only the requested columns
+    std::vector<std::size_t> columns;
+    auto missing = TableKeyIndex::FindColumns(
+        columnsSlot_.Param<core::param::StringParam>()->Value(), fileColumns.data(), fileColumns.size(), columns);
+    if (!missing.empty()) {
+        Log::DefaultLog.WriteError("The column \"%s\" does not exist in the file.", missing.c_str());
+        return;
+    }
+    if (columns.empty()) {
+        columns.resize(fileColumns.size());
+        std::iota(columns.begin(), columns.end(), 0);
+    }
+
+    // skip the row groups whose values of the hinted column are all outside of the range, even if the column is
+    // not loaded, NaN values are outside of every range
+    std::vector<std::size_t> hintColumn;
+    if (hint.has_value()) {
+        TableKeyIndex::FindColumns(hint->column, fileColumns.data(), fileColumns.size(), hintColumn);
+    }
+    std::vector<std::size_t> groups;
+    for (std::size_t g = 0; g < frame.groups.size(); ++g) {
+        if (hintColumn.size() == 1) {
+            const auto& chunk = frame.groups[g].chunks[hintColumn.front()];
+            if (std::isnan(chunk.minimum) || chunk.maximum < hint->minimum || chunk.minimum > hint->maximum) {
+                continue;
+            }
+        }
+        groups.push_back(g);
+    }
 
+    try {
+        reader_.Read(frameID, columns, groups, values_);
     } catch (std::exception& ex) {
-        megamol::core::utility::log::Log::DefaultLog.WriteError(ex.what());
-        columns_.clear();
+        Log::DefaultLog.WriteError(ex.what());
         values_.clear();
         return;
     }
+
+    for (auto c : columns) {
+        columns_.push_back(fileColumns[c]);
+    }
 }
 
 bool MMFTDataSource::getDataCallback(core::Call& caller) {
@@ -148,11 +243,11 @@ bool MMFTDataSource::getDataCallback(core::Call& caller) {
         return false;
     }
 
-    assertData();
+    assertData(tfd->GetFrameID(), tfd->GetRowRangeHint());
 
     tfd->SetDataHash(dataHash_);
-    tfd->SetFrameCount(1);
-    if (values_.empty()) {
+    tfd->SetFrameCount(frameCount_);
+    if (values_.empty() || columns_.empty()) {
         tfd->Set(0, 0, nullptr, nullptr);
     } else {
         assert((values_.size() % columns_.size()) == 0);
@@ -169,9 +264,9 @@ bool MMFTDataSource::getHashCallback(core::Call& caller) {
         return false;
     }
 
-    assertData();
+    assertData(tfd->GetFrameID(), tfd->GetRowRangeHint());
 
-    tfd->SetFrameCount(1);
+    tfd->SetFrameCount(frameCount_);
     tfd->SetDataHash(dataHash_);
     tfd->SetUnlocker(nullptr);
 
@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <optional>
 #include <vector>
 
+#include "MMFTFormat.h"
 #include "datatools/table/TableDataCall.h"
 #include "mmcore/Call.h"
 #include "mmcore/CalleeSlot.h"
@@ -38,7 +40,9 @@ protected:
     bool reloadCallback(core::param::ParamSlot& caller);
 
 private:
-    inline void assertData();
+    inline void assertData(unsigned int frameID, const std::optional<TableDataCall::RowRangeHint>& hint);
+    void readVersion0(std::istream& file);
+    void readFrame(unsigned int frameID, const std::optional<TableDataCall::RowRangeHint>& hint);
     bool getDataCallback(core::Call& caller);
     bool getHashCallback(core::Call& caller);
 
@@ -46,10 +50,18 @@ private:
 
     core::param::ParamSlot filenameSlot_;
     core::param::ParamSlot reloadSlot_;
+    core::param::ParamSlot columnsSlot_;
 
     std::size_t dataHash_;
     bool reload_;
 
+    /** Reader of chunked files, which are loaded frame by frame */
+    MMFTReader reader_;
+    bool isChunked_;
+    unsigned int frameCount_;
+    unsigned int frameID_;
+    std::optional<TableDataCall::RowRangeHint> hint_;
+
     std::vector<TableDataCall::ColumnInfo> columns_;
     std::vector<float> values_;
 };
@@ -8,8 +8,14 @@
 
 #include <filesystem>
 #include <fstream>
+#include <stdexcept>
 
+#include "MMFTFormat.h"
+#include "mmcore/param/BoolParam.h"
+#include "mmcore/param/EnumParam.h"
 #include "mmcore/param/FilePathParam.h"
+#include "mmcore/param/IntParam.h"
+#include "mmcore/utility/AtomicFileWriter.h"
 #include "mmcore/utility/log/Log.h"
 
 using namespace megamol::datatools;
@@ -19,12 +25,34 @@ using namespace megamol;
 MMFTDataWriter::MMFTDataWriter()
         : core::AbstractDataWriter()
         , filenameSlot("filename", "The path to the MMFT file to be written")
+        , versionSlot("version", "Version 0 holds one row-major frame, version 1 holds all frames in columnar chunks")
+        , rowGroupSizeSlot("rowGroupSize", "The number of rows per row group of version 1")
+        , compressionSlot("compression", "The compression of the chunks of version 1")
+        , allFramesSlot("allFrames", "Write all frames instead of the current one with version 1")
         , dataSlot("data", "The slot requesting the data to be written") {
 
     this->filenameSlot << new core::param::FilePathParam(
         "", megamol::core::param::FilePathParam::Flag_File_ToBeCreatedWithRestrExts, {"mmft"});
     this->MakeSlotAvailable(&this->filenameSlot);
 
+    auto version = new core::param::EnumParam(MMFTChunkedVersion);
+    version->SetTypePair(0, "0 (row-major)");
+    version->SetTypePair(MMFTChunkedVersion, "1 (chunked)");
+    this->versionSlot << version;
+    this->MakeSlotAvailable(&this->versionSlot);
+
+    this->rowGroupSizeSlot << new core::param::IntParam(65536, 1);
+    this->MakeSlotAvailable(&this->rowGroupSizeSlot);
+
+    auto compression = new core::param::EnumParam(static_cast<int>(MMFTCompression::None));
+    compression->SetTypePair(static_cast<int>(MMFTCompression::None), "none");
+    compression->SetTypePair(static_cast<int>(MMFTCompression::Deflate), "deflate");
+    this->compressionSlot << compression;
+    this->MakeSlotAvailable(&this->compressionSlot);
+
+    this->allFramesSlot << new core::param::BoolParam(true);
+    this->MakeSlotAvailable(&this->allFramesSlot);
+
     this->dataSlot.SetCompatibleCall<TableDataCallDescription>();
     this->MakeSlotAvailable(&this->dataSlot);
 }
@@ -62,8 +90,16 @@ bool MMFTDataWriter::run() {
         Log::DefaultLog.WriteWarn("File %s already exists and will be overwritten.", filename.generic_string().c_str());
     }
 
-    std::ofstream file(filename, std::ios::binary);
-    if (!file.is_open()) {
+    if (this->versionSlot.Param<core::param::EnumParam>()->Value() == MMFTChunkedVersion) {
+        bool retval = this->writeChunked(*cftd);
+        cftd->Unlock();
+        return retval;
+    }
+
+    // The file is replaced once it has been written completely
+    core::utility::AtomicFileWriter output(filename);
+    auto& file = output.Stream();
+    if (!output.IsOpen()) {
         Log::DefaultLog.WriteError("Unable to create output file \"%s\". Abort.", filename.generic_string().c_str());
         cftd->Unlock();
         return false;
@@ -101,6 +137,9 @@ bool MMFTDataWriter::run() {
 
         file.write(reinterpret_cast<const char*>(cftd->GetData()), rowCnt * colCnt * sizeof(float));
 
+        if (!output.Commit()) {
+            throw std::runtime_error("Unable to complete the file");
+        }
     } catch (...) {
         Log::DefaultLog.WriteError("Write error \"%s\".", filename.generic_string().c_str());
         cftd->Unlock();
@@ -112,6 +151,53 @@ bool MMFTDataWriter::run() {
     return true;
 }
 
+bool MMFTDataWriter::writeChunked(TableDataCall& cftd) {
+    using megamol::core::utility::log::Log;
+    auto filename = this->filenameSlot.Param<core::param::FilePathParam>()->Value();
+
+    try {
+        std::vector<TableDataCall::ColumnInfo> columns(
+            cftd.GetColumnsInfos(), cftd.GetColumnsInfos() + cftd.GetColumnsCount());
+        MMFTWriter writer(filename, columns,
+            static_cast<uint32_t>(this->rowGroupSizeSlot.Param<core::param::IntParam>()->Value()),
+            static_cast<MMFTCompression>(this->compressionSlot.Param<core::param::EnumParam>()->Value()));
+
+        if (!this->allFramesSlot.Param<core::param::BoolParam>()->Value()) {
+            writer.WriteFrame(cftd.GetData(), cftd.GetRowsCount());
+            writer.Close();
+            return true;
+        }
+
+        const auto frameCount = cftd.GetFrameCount();
+        for (unsigned int f = 0; f < frameCount; ++f) {
+            cftd.Unlock();
+            cftd.SetFrameID(f);
+            if (!cftd(0)) {
+                Log::DefaultLog.WriteError("Failed to get frame %u. Abort.", f);
+                return false;
+            }
+
+            bool isSameColumns = (cftd.GetColumnsCount() == columns.size());
+            for (size_t c = 0; isSameColumns && c < columns.size(); ++c) {
+                isSameColumns = (cftd.GetColumnsInfos()[c].Name() == columns[c].Name());
+            }
+            if (!isSameColumns) {
+                Log::DefaultLog.WriteError("The columns of frame %u differ from the first frame. Abort.", f);
+                return false;
+            }
+
+            writer.WriteFrame(cftd.GetData(), cftd.GetRowsCount());
+        }
+        writer.Close();
+
+    } catch (std::exception& ex) {
+        Log::DefaultLog.WriteError("Write error \"%s\": %s", filename.generic_string().c_str(), ex.what());
+        return false;
+    }
+
+    return true;
+}
+
 bool MMFTDataWriter::getCapabilities(core::DataWriterCtrlCall& call) {
     call.SetAbortable(false);
     return true;
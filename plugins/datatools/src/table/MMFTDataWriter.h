@@ -80,9 +80,30 @@ protected:
     bool getCapabilities(core::DataWriterCtrlCall& call) override;
 
 private:
+    /**
+     * Writes all or the current frame in the chunked format.
+     *
+     * @param cftd The call of the data, already holding the current frame
+     *
+     * @return True on success
+     */
+    bool writeChunked(TableDataCall& cftd);
+
     /** The file name of the file to be written */
     core::param::ParamSlot filenameSlot;
 
+    /** The version of the file format */
+    core::param::ParamSlot versionSlot;
+
+    /** The number of rows per row group of the chunked format */
+    core::param::ParamSlot rowGroupSizeSlot;
+
+    /** The compression of the chunked format */
+    core::param::ParamSlot compressionSlot;
+
+    /** Write all frames instead of the current one in the chunked format */
+    core::param::ParamSlot allFramesSlot;
+
     /** The slot asking for data */
     core::CallerSlot dataSlot;
 };
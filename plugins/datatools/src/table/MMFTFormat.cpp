@@ -0,0 +1,459 @@
+/*
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "MMFTFormat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <zlib.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace megamol::datatools::table;
+
+namespace {
+
+template<typename T>
+void write(std::ostream& stream, const T& value) {
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+/** Bounds-checked reading from the mapping. */
+class MappingReader {
+public:
+    MappingReader(const char* data, std::uint64_t size, std::uint64_t position)
+            : data(data)
+            , size(size)
+            , position(position) {}
+
+    template<typename T>
+    T read() {
+        T value;
+        std::memcpy(&value, this->advance(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string read_string(std::size_t length) {
+        auto str = this->advance(length);
+        return std::string(str, std::find(str, str + length, '\0'));
+    }
+
+private:
+    const char* advance(std::uint64_t count) {
+        if (count > this->size || this->position > this->size - count) {
+            throw std::runtime_error("Unexpected end of MMFT file!");
+        }
+        auto retval = this->data + this->position;
+        this->position += count;
+        return retval;
+    }
+
+    const char* data;
+    std::uint64_t size;
+    std::uint64_t position;
+};
+
+inline int numThreads() {
+#ifdef _OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+}
+
+} // namespace
+
+
+MMFTWriter::MMFTWriter(const std::filesystem::path& filename, const std::vector<TableDataCall::ColumnInfo>& columns,
+    std::uint32_t rowGroupSize, MMFTCompression compression, int level)
+        : output(filename)
+        , file(output.Stream())
+        , columns(columns)
+        , rowGroupSize(std::max<std::uint32_t>(rowGroupSize, 1))
+        , compression(compression)
+        , level(level) {
+    if (!this->output.IsOpen()) {
+        throw std::runtime_error("Unable to create file \"" + filename.generic_string() + "\"");
+    }
+    this->file.exceptions(std::ios::failbit | std::ios::badbit);
+
+    // The ranges of the columns are only known at the end, the header is written again with the same size
+    this->writeHeader(0);
+    this->pad();
+}
+
+void MMFTWriter::WriteFrame(const float* data, std::uint64_t rowCount) {
+    const auto columnCount = this->columns.size();
+    const auto groupCount = static_cast<std::size_t>((rowCount + this->rowGroupSize - 1) / this->rowGroupSize);
+
+    MMFTFrame frame;
+    frame.rowCount = rowCount;
+    frame.groups.resize(groupCount);
+    for (std::size_t g = 0; g < groupCount; ++g) {
+        const auto firstRow = static_cast<std::uint64_t>(g) * this->rowGroupSize;
+        frame.groups[g].rowCount =
+            static_cast<std::uint32_t>(std::min<std::uint64_t>(this->rowGroupSize, rowCount - firstRow));
+        frame.groups[g].chunks.resize(columnCount);
+    }
+
+    // Transpose and compress a batch of row groups in parallel, then write them in order
+    const std::size_t batchSize = static_cast<std::size_t>(numThreads());
+    std::vector<std::vector<char>> buffers(batchSize * columnCount);
+
+    for (std::size_t batch = 0; batch < groupCount; batch += batchSize) {
+        const auto batchCount = std::min(batchSize, groupCount - batch);
+        bool isFailed = false;
+
+#pragma omp parallel
+        {
+            std::vector<float> column;
+            std::vector<char> planes;
+
+#pragma omp for schedule(dynamic)
+            for (std::int64_t i = 0; i < static_cast<std::int64_t>(batchCount * columnCount); ++i) {
+                const auto g = batch + static_cast<std::size_t>(i) / columnCount;
+                const auto c = static_cast<std::size_t>(i) % columnCount;
+                const auto firstRow = static_cast<std::uint64_t>(g) * this->rowGroupSize;
+                const std::size_t groupRows = frame.groups[g].rowCount;
+                auto& buffer = buffers[i];
+
+                float minimum = std::numeric_limits<float>::infinity();
+                float maximum = -std::numeric_limits<float>::infinity();
+                column.resize(groupRows);
+                for (std::size_t r = 0; r < groupRows; ++r) {
+                    const auto value = data[(firstRow + r) * columnCount + c];
+                    column[r] = value;
+                    if (!std::isnan(value)) {
+                        minimum = std::min(minimum, value);
+                        maximum = std::max(maximum, value);
+                    }
+                }
+                if (minimum > maximum) {
+                    minimum = maximum = std::numeric_limits<float>::quiet_NaN();
+                }
+
+                auto chunkCompression = MMFTCompression::None;
+                const auto rawSize = groupRows * sizeof(float);
+                if (this->compression == MMFTCompression::Deflate) {
+                    // Byte planes: the exponents and high mantissa bytes of similar values are similar
+                    planes.resize(rawSize);
+                    const auto bytes = reinterpret_cast<const unsigned char*>(column.data());
+                    for (std::size_t r = 0; r < groupRows; ++r) {
+                        for (std::size_t b = 0; b < sizeof(float); ++b) {
+                            planes[b * groupRows + r] = bytes[r * sizeof(float) + b];
+                        }
+                    }
+                    uLongf size = compressBound(static_cast<uLong>(rawSize));
+                    buffer.resize(size);
+                    const auto result = compress2(reinterpret_cast<Bytef*>(buffer.data()), &size,
+                        reinterpret_cast<const Bytef*>(planes.data()), static_cast<uLong>(rawSize), this->level);
+                    if (result != Z_OK) {
+#pragma omp critical
+                        {
+                            isFailed = true;
+                        }
+                    }
+                    // Incompressible chunks are stored as they are
+                    if (size < rawSize) {
+                        buffer.resize(size);
+                        chunkCompression = MMFTCompression::Deflate;
+                    }
+                }
+                if (chunkCompression == MMFTCompression::None) {
+                    buffer.resize(rawSize);
+                    std::memcpy(buffer.data(), column.data(), rawSize);
+                }
+
+                frame.groups[g].chunks[c] = MMFTChunk{0, buffer.size(), chunkCompression, minimum, maximum};
+            }
+        }
+
+        if (isFailed) {
+            throw std::runtime_error("Compression of MMFT chunk failed");
+        }
+
+        for (std::size_t i = 0; i < batchCount * columnCount; ++i) {
+            auto& chunk = frame.groups[batch + i / columnCount].chunks[i % columnCount];
+            this->pad();
+            chunk.offset = static_cast<std::uint64_t>(this->file.tellp());
+            this->file.write(buffers[i].data(), buffers[i].size());
+        }
+    }
+
+    this->frames.push_back(std::move(frame));
+}
+
+void MMFTWriter::Close() {
+    if (!this->output.IsOpen()) {
+        return;
+    }
+
+    const auto indexOffset = static_cast<std::uint64_t>(this->file.tellp());
+    write(this->file, static_cast<std::uint32_t>(this->frames.size()));
+    for (const auto& frame : this->frames) {
+        write(this->file, frame.rowCount);
+        write(this->file, static_cast<std::uint32_t>(frame.groups.size()));
+        for (const auto& group : frame.groups) {
+            write(this->file, group.rowCount);
+            for (const auto& chunk : group.chunks) {
+                write(this->file, chunk.offset);
+                write(this->file, chunk.size);
+                write(this->file, static_cast<std::uint8_t>(chunk.compression));
+                write(this->file, chunk.minimum);
+                write(this->file, chunk.maximum);
+            }
+        }
+    }
+
+    // The ranges of the columns span all frames
+    for (std::size_t c = 0; c < this->columns.size(); ++c) {
+        auto minimum = std::numeric_limits<float>::infinity();
+        auto maximum = -std::numeric_limits<float>::infinity();
+        for (const auto& frame : this->frames) {
+            for (const auto& group : frame.groups) {
+                if (!std::isnan(group.chunks[c].minimum)) {
+                    minimum = std::min(minimum, group.chunks[c].minimum);
+                    maximum = std::max(maximum, group.chunks[c].maximum);
+                }
+            }
+        }
+        if (minimum <= maximum) {
+            this->columns[c].SetMinimumValue(minimum).SetMaximumValue(maximum);
+        }
+    }
+
+    this->file.seekp(0);
+    this->writeHeader(indexOffset);
+    if (!this->output.Commit()) {
+        throw std::runtime_error("Unable to complete the file");
+    }
+}
+
+void MMFTWriter::writeHeader(std::uint64_t indexOffset) {
+    this->file.write("MMFTD", 6);
+    write(this->file, MMFTChunkedVersion);
+    write(this->file, static_cast<std::uint32_t>(this->columns.size()));
+    for (const auto& ci : this->columns) {
+        const auto nameLen = static_cast<std::uint16_t>(std::min<std::size_t>(ci.Name().size(), UINT16_MAX));
+        write(this->file, nameLen);
+        this->file.write(ci.Name().data(), nameLen);
+        write(this->file, static_cast<std::uint8_t>((ci.Type() == TableDataCall::ColumnType::CATEGORICAL) ? 1 : 0));
+        write(this->file, ci.MinimumValue());
+        write(this->file, ci.MaximumValue());
+    }
+    write(this->file, indexOffset);
+}
+
+void MMFTWriter::pad() {
+    static const char zeros[MMFTAlignment] = {};
+    const auto position = static_cast<std::uint64_t>(this->file.tellp());
+    const auto padding = (MMFTAlignment - position % MMFTAlignment) % MMFTAlignment;
+    this->file.write(zeros, padding);
+}
+
+
+MMFTReader::~MMFTReader() {
+    this->Close();
+}
+
+void MMFTReader::Open(const std::filesystem::path& filename) {
+    this->Close();
+
+#ifdef _WIN32
+    this->fileHandle = ::CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (this->fileHandle == INVALID_HANDLE_VALUE) {
+        this->fileHandle = nullptr;
+        throw std::runtime_error("Unable to open file \"" + filename.generic_string() + "\"");
+    }
+    LARGE_INTEGER size;
+    ::GetFileSizeEx(this->fileHandle, &size);
+    this->mappingSize = static_cast<std::uint64_t>(size.QuadPart);
+    if (this->mappingSize > 0) {
+        this->mappingHandle = ::CreateFileMappingW(this->fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (this->mappingHandle != nullptr) {
+            this->mapping = static_cast<const char*>(::MapViewOfFile(this->mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        }
+    }
+#else
+    this->fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (this->fileDescriptor < 0) {
+        throw std::runtime_error("Unable to open file \"" + filename.generic_string() + "\"");
+    }
+    struct stat info;
+    ::fstat(this->fileDescriptor, &info);
+    this->mappingSize = static_cast<std::uint64_t>(info.st_size);
+    if (this->mappingSize > 0) {
+        auto mapping = ::mmap(nullptr, this->mappingSize, PROT_READ, MAP_SHARED, this->fileDescriptor, 0);
+        if (mapping != MAP_FAILED) {
+            this->mapping = static_cast<const char*>(mapping);
+        }
+    }
+#endif
+    if (this->mapping == nullptr) {
+        this->Close();
+        throw std::runtime_error("Unable to map file \"" + filename.generic_string() + "\"");
+    }
+
+    try {
+        MappingReader header(this->mapping, this->mappingSize, 0);
+        if (header.read_string(6) != "MMFTD") {
+            throw std::runtime_error("Wrong file format magic ID!");
+        }
+        if (header.read<std::uint16_t>() != MMFTChunkedVersion) {
+            throw std::runtime_error("Wrong file format version number");
+        }
+
+        this->columns.resize(header.read<std::uint32_t>());
+        for (auto& ci : this->columns) {
+            ci.SetName(header.read_string(header.read<std::uint16_t>()));
+            ci.SetType((header.read<std::uint8_t>() == 1) ? TableDataCall::ColumnType::CATEGORICAL
+                                                          : TableDataCall::ColumnType::QUANTITATIVE);
+            ci.SetMinimumValue(header.read<float>());
+            ci.SetMaximumValue(header.read<float>());
+        }
+
+        MappingReader index(this->mapping, this->mappingSize, header.read<std::uint64_t>());
+        this->frames.resize(index.read<std::uint32_t>());
+        for (auto& frame : this->frames) {
+            frame.rowCount = index.read<std::uint64_t>();
+            frame.groups.resize(index.read<std::uint32_t>());
+            std::uint64_t rowCount = 0;
+            for (auto& group : frame.groups) {
+                group.rowCount = index.read<std::uint32_t>();
+                rowCount += group.rowCount;
+                group.chunks.resize(this->columns.size());
+                for (auto& chunk : group.chunks) {
+                    chunk.offset = index.read<std::uint64_t>();
+                    chunk.size = index.read<std::uint64_t>();
+                    chunk.compression = static_cast<MMFTCompression>(index.read<std::uint8_t>());
+                    chunk.minimum = index.read<float>();
+                    chunk.maximum = index.read<float>();
+
+                    const bool isValid = (chunk.offset % MMFTAlignment == 0) && (chunk.size <= this->mappingSize) &&
+                                         (chunk.offset <= this->mappingSize - chunk.size) &&
+                                         ((chunk.compression == MMFTCompression::Deflate) ||
+                                             ((chunk.compression == MMFTCompression::None) &&
+                                                 (chunk.size == group.rowCount * sizeof(float))));
+                    if (!isValid) {
+                        throw std::runtime_error("Invalid chunk in MMFT file!");
+                    }
+                }
+            }
+            if (rowCount != frame.rowCount) {
+                throw std::runtime_error("Row groups do not match the rows of the frame in MMFT file!");
+            }
+        }
+    } catch (...) {
+        this->Close();
+        throw;
+    }
+}
+
+void MMFTReader::Close() {
+#ifdef _WIN32
+    if (this->mapping != nullptr) {
+        ::UnmapViewOfFile(this->mapping);
+    }
+    if (this->mappingHandle != nullptr) {
+        ::CloseHandle(this->mappingHandle);
+        this->mappingHandle = nullptr;
+    }
+    if (this->fileHandle != nullptr) {
+        ::CloseHandle(this->fileHandle);
+        this->fileHandle = nullptr;
+    }
+#else
+    if (this->mapping != nullptr) {
+        ::munmap(const_cast<char*>(this->mapping), this->mappingSize);
+    }
+    if (this->fileDescriptor >= 0) {
+        ::close(this->fileDescriptor);
+        this->fileDescriptor = -1;
+    }
+#endif
+    this->mapping = nullptr;
+    this->mappingSize = 0;
+    this->columns.clear();
+    this->frames.clear();
+}
+
+void MMFTReader::Read(std::size_t frame, const std::vector<std::size_t>& columns,
+    const std::vector<std::size_t>& groups, std::vector<float>& outValues) const {
+    const auto& f = this->frames.at(frame);
+    const auto columnCount = columns.size();
+
+    std::vector<std::uint64_t> firstRows(groups.size() + 1, 0);
+    for (std::size_t g = 0; g < groups.size(); ++g) {
+        firstRows[g + 1] = firstRows[g] + f.groups.at(groups[g]).rowCount;
+    }
+    outValues.resize(firstRows.back() * columnCount);
+
+    bool isFailed = false;
+
+#pragma omp parallel
+    {
+        std::vector<unsigned char> planes;
+
+#pragma omp for schedule(dynamic)
+        for (std::int64_t i = 0; i < static_cast<std::int64_t>(groups.size() * columnCount); ++i) {
+            const auto g = static_cast<std::size_t>(i) / columnCount;
+            const auto c = static_cast<std::size_t>(i) % columnCount;
+            const auto& group = f.groups[groups[g]];
+            const auto& chunk = group.chunks.at(columns[c]);
+            const auto rowCount = static_cast<std::size_t>(group.rowCount);
+            auto out = outValues.data() + firstRows[g] * columnCount + c;
+
+            if (chunk.compression == MMFTCompression::None) {
+                // Chunks are aligned, so the floats are read straight from the mapping
+                auto values = reinterpret_cast<const float*>(this->mapping + chunk.offset);
+                for (std::size_t r = 0; r < rowCount; ++r) {
+                    out[r * columnCount] = values[r];
+                }
+                continue;
+            }
+
+            planes.resize(rowCount * sizeof(float));
+            uLongf size = static_cast<uLongf>(planes.size());
+            const auto result = uncompress(planes.data(), &size,
+                reinterpret_cast<const Bytef*>(this->mapping + chunk.offset), static_cast<uLong>(chunk.size));
+            if (result != Z_OK || size != planes.size()) {
+#pragma omp critical
+                {
+                    isFailed = true;
+                }
+                continue;
+            }
+            for (std::size_t r = 0; r < rowCount; ++r) {
+                unsigned char bytes[sizeof(float)];
+                for (std::size_t b = 0; b < sizeof(float); ++b) {
+                    bytes[b] = planes[b * rowCount + r];
+                }
+                std::memcpy(out + r * columnCount, bytes, sizeof(float));
+            }
+        }
+    }
+
+    if (isFailed) {
+        throw std::runtime_error("Decompression of MMFT chunk failed");
+    }
+}
@@ -0,0 +1,172 @@
+/*
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include "datatools/table/TableDataCall.h"
+#include "mmcore/utility/AtomicFileWriter.h"
+
+namespace megamol::datatools::table {
+
+/**
+ * Version 1 of the MMFT format stores several frames of a table in one file. The rows of every frame are split into
+ * row groups, which store every column as a separate chunk together with its minimum and maximum, so that readers can
+ * load single columns and skip row groups which cannot hold the values they are interested in.
+ *
+ * Layout, little endian:
+ *
+ *     char[6]  "MMFTD\0"
+ *     uint16   version = 1
+ *     uint32   column count
+ *     per column: uint16 name length, char[] name, uint8 type (1 = categorical), float min, float max of all frames
+ *     uint64   offset of the index
+ *     chunks, each starting at a multiple of MMFTAlignment
+ *     index:
+ *         uint32 frame count
+ *         per frame: uint64 row count, uint32 row group count
+ *             per row group: uint32 row count
+ *                 per column: uint64 offset, uint64 size, uint8 compression, float min, float max
+ *
+ * Uncompressed chunks hold the raw floats of a column and can be used straight from a memory mapping. Deflated chunks
+ * hold the floats split into four byte planes, which compresses considerably better, compressed with zlib.
+ */
+constexpr std::uint16_t MMFTChunkedVersion = 1;
+constexpr std::uint64_t MMFTAlignment = 64;
+
+enum class MMFTCompression : std::uint8_t { None = 0, Deflate = 1 };
+
+/** A column of a row group. */
+struct MMFTChunk {
+    std::uint64_t offset;
+    std::uint64_t size;
+    MMFTCompression compression;
+
+    /** The range of the values, NaN if all values are NaN. */
+    float minimum;
+    float maximum;
+};
+
+struct MMFTRowGroup {
+    std::uint32_t rowCount;
+    std::vector<MMFTChunk> chunks;
+};
+
+struct MMFTFrame {
+    std::uint64_t rowCount;
+    std::vector<MMFTRowGroup> groups;
+};
+
+/**
+ * Writes MMFT files of version 1.
+ */
+class MMFTWriter {
+public:
+    /**
+     * Creates the file, the frames are added with WriteFrame(). The data is written to a temporary file, which
+     * replaces the file in Close(). A writer destroyed before, e.g. after an error, leaves the file untouched.
+     *
+     * @param filename     The file to be written.
+     * @param columns      The columns of all frames.
+     * @param rowGroupSize The number of rows per row group.
+     * @param compression  The compression of the chunks.
+     * @param level        The zlib compression level, the fastest by default.
+     *
+     * @throws std::runtime_error if the file cannot be created.
+     */
+    MMFTWriter(const std::filesystem::path& filename, const std::vector<TableDataCall::ColumnInfo>& columns,
+        std::uint32_t rowGroupSize, MMFTCompression compression, int level = 1);
+
+    /**
+     * Appends a frame, the row groups are transposed and compressed in parallel.
+     *
+     * @param data     The row-major values.
+     * @param rowCount The number of rows.
+     *
+     * @throws std::runtime_error on write errors.
+     */
+    void WriteFrame(const float* data, std::uint64_t rowCount);
+
+    /**
+     * Writes the index and the header and moves the complete file to its name.
+     *
+     * @throws std::runtime_error on write errors.
+     */
+    void Close();
+
+private:
+    void writeHeader(std::uint64_t indexOffset);
+    void pad();
+
+    core::utility::AtomicFileWriter output;
+    std::ofstream& file;
+    std::vector<TableDataCall::ColumnInfo> columns;
+    std::uint32_t rowGroupSize;
+    MMFTCompression compression;
+    int level;
+    std::vector<MMFTFrame> frames;
+};
+
+/**
+ * Reads MMFT files of version 1 from a memory mapping.
+ */
+class MMFTReader {
+public:
+    MMFTReader() = default;
+    ~MMFTReader();
+
+    MMFTReader(const MMFTReader&) = delete;
+    MMFTReader& operator=(const MMFTReader&) = delete;
+
+    /**
+     * Maps the file and reads its header and index.
+     *
+     * @throws std::runtime_error if the file is not a valid MMFT file of version 1.
+     */
+    void Open(const std::filesystem::path& filename);
+
+    void Close();
+
+    inline const std::vector<TableDataCall::ColumnInfo>& GetColumns() const {
+        return this->columns;
+    }
+
+    inline const std::vector<MMFTFrame>& GetFrames() const {
+        return this->frames;
+    }
+
+    /**
+     * Reads some columns of some row groups of a frame in parallel.
+     *
+     * @param frame     The frame.
+     * @param columns   The indices of the columns, in the order of the output columns.
+     * @param groups    The indices of the row groups, in the order of the output rows.
+     * @param outValues Receives the row-major values.
+     *
+     * @throws std::runtime_error if a chunk cannot be decompressed.
+     */
+    void Read(std::size_t frame, const std::vector<std::size_t>& columns, const std::vector<std::size_t>& groups,
+        std::vector<float>& outValues) const;
+
+private:
+    std::vector<TableDataCall::ColumnInfo> columns;
+    std::vector<MMFTFrame> frames;
+
+    const char* mapping = nullptr;
+    std::uint64_t mappingSize = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#else
+    int fileDescriptor = -1;
+#endif
+};
+
+} // namespace megamol::datatools::table
@@ -0,0 +1,237 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "SelectionMessage.h"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+using namespace megamol::datatools::table;
+
+namespace {
+
+constexpr std::uint32_t Magic = 0x4c534d4d; // "MMSL"
+
+enum class Encoding : std::uint8_t { Runs = 0, Bitmap = 1 };
+
+void writeVarint(std::uint64_t value, std::vector<std::uint8_t>& out) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<std::uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<std::uint8_t>(value));
+}
+
+bool readVarint(const std::uint8_t*& pos, const std::uint8_t* end, std::uint64_t& value) {
+    value = 0;
+    for (unsigned int shift = 0; (shift < 64) && (pos < end); shift += 7) {
+        const auto byte = *pos++;
+        value |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+template<class T>
+void writeValue(T value, std::vector<std::uint8_t>& out) {
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<std::uint8_t>(static_cast<std::uint64_t>(value) >> (8 * i)));
+    }
+}
+
+template<class T>
+bool readValue(const std::uint8_t*& pos, const std::uint8_t* end, T& value) {
+    if (static_cast<std::size_t>(end - pos) < sizeof(T)) {
+        return false;
+    }
+    std::uint64_t v = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        v |= static_cast<std::uint64_t>(*pos++) << (8 * i);
+    }
+    value = static_cast<T>(v);
+    return true;
+}
+
+} // namespace
+
+
+/*
+ * SelectionMessage::MakeDelta
+ */
+SelectionMessage SelectionMessage::MakeDelta(const std::vector<std::uint64_t>& from,
+    const std::vector<std::uint64_t>& to, std::uint64_t baseVersion, std::uint64_t version) {
+    SelectionMessage retval;
+    retval.kind = Kind::Delta;
+    retval.version = version;
+    retval.baseVersion = baseVersion;
+    std::set_difference(to.begin(), to.end(), from.begin(), from.end(), std::back_inserter(retval.added));
+    std::set_difference(from.begin(), from.end(), to.begin(), to.end(), std::back_inserter(retval.removed));
+    return retval;
+}
+
+
+/*
+ * SelectionMessage::Apply
+ */
+void SelectionMessage::Apply(std::vector<std::uint64_t>& selection) const {
+    if (this->kind == Kind::Baseline) {
+        selection = this->added;
+        return;
+    }
+
+    std::vector<std::uint64_t> kept;
+    kept.reserve(selection.size());
+    std::set_difference(selection.begin(), selection.end(), this->removed.begin(), this->removed.end(),
+        std::back_inserter(kept));
+    selection.clear();
+    selection.reserve(kept.size() + this->added.size());
+    std::set_union(kept.begin(), kept.end(), this->added.begin(), this->added.end(), std::back_inserter(selection));
+}
+
+
+/*
+ * SelectionMessage::Serialize
+ */
+void SelectionMessage::Serialize(std::vector<std::uint8_t>& out) const {
+    out.clear();
+    writeValue(Magic, out);
+    writeValue(static_cast<std::uint8_t>(this->kind), out);
+    writeValue(this->version, out);
+    if (this->kind == Kind::Delta) {
+        writeValue(this->baseVersion, out);
+    }
+    EncodeIndices(this->added, out);
+    if (this->kind == Kind::Delta) {
+        EncodeIndices(this->removed, out);
+    }
+}
+
+
+/*
+ * SelectionMessage::Deserialize
+ */
+bool SelectionMessage::Deserialize(const std::uint8_t* data, std::size_t size, std::uint64_t maxIndices) {
+    const auto end = data + size;
+    std::uint32_t magic;
+    std::uint8_t kind;
+    if (!readValue(data, end, magic) || (magic != Magic) || !readValue(data, end, kind) ||
+        (kind > static_cast<std::uint8_t>(Kind::Delta)) || !readValue(data, end, this->version)) {
+        return false;
+    }
+    this->kind = static_cast<Kind>(kind);
+    this->baseVersion = 0;
+    this->removed.clear();
+
+    if (this->kind == Kind::Baseline) {
+        return DecodeIndices(data, end, this->added, maxIndices) && (data == end);
+    }
+    return readValue(data, end, this->baseVersion) && DecodeIndices(data, end, this->added, maxIndices) &&
+           DecodeIndices(data, end, this->removed, maxIndices) && (data == end);
+}
+
+
+/*
+ * SelectionMessage::EncodeIndices
+ */
+void SelectionMessage::EncodeIndices(const std::vector<std::uint64_t>& indices, std::vector<std::uint8_t>& out) {
+    // Runs of consecutive indices, which is what brushing usually produces
+    std::vector<std::uint8_t> runs;
+    std::size_t numRuns = 0;
+    std::uint64_t previousEnd = 0;
+    for (std::size_t i = 0; i < indices.size();) {
+        auto j = i + 1;
+        while ((j < indices.size()) && (indices[j] == indices[j - 1] + 1)) {
+            ++j;
+        }
+        writeVarint(indices[i] - previousEnd, runs);
+        writeVarint(j - i - 1, runs);
+        previousEnd = indices[j - 1] + 1;
+        ++numRuns;
+        i = j;
+    }
+
+    // A bitmap over the range of the indices is smaller for dense, scattered selections
+    const auto span = indices.empty() ? 0 : indices.back() - indices.front() + 1;
+    if (!indices.empty() && (indices.back() - indices.front() < MaxIndices) && (span / 8 + 20 < runs.size())) {
+        out.push_back(static_cast<std::uint8_t>(Encoding::Bitmap));
+        writeVarint(indices.front(), out);
+        writeVarint(span, out);
+        const auto offset = out.size();
+        out.resize(offset + static_cast<std::size_t>((span + 7) / 8), 0);
+        for (auto index : indices) {
+            const auto bit = index - indices.front();
+            out[offset + static_cast<std::size_t>(bit / 8)] |= static_cast<std::uint8_t>(1u << (bit % 8));
+        }
+        return;
+    }
+
+    out.push_back(static_cast<std::uint8_t>(Encoding::Runs));
+    writeVarint(numRuns, out);
+    out.insert(out.end(), runs.begin(), runs.end());
+}
+
+
+/*
+ * SelectionMessage::DecodeIndices
+ */
+bool SelectionMessage::DecodeIndices(const std::uint8_t*& pos, const std::uint8_t* end,
+    std::vector<std::uint64_t>& out, std::uint64_t maxIndices) {
+    maxIndices = std::min(maxIndices, MaxIndices);
+    out.clear();
+    if (pos >= end) {
+        return false;
+    }
+
+    const auto encoding = static_cast<Encoding>(*pos++);
+    if (encoding == Encoding::Bitmap) {
+        std::uint64_t first, span;
+        if (!readVarint(pos, end, first) || !readVarint(pos, end, span) || (span > MaxIndices) ||
+            ((span > 0) && (span - 1 > std::numeric_limits<std::uint64_t>::max() - first)) ||
+            ((span + 7) / 8 > static_cast<std::uint64_t>(end - pos))) {
+            return false;
+        }
+        for (std::uint64_t bit = 0; bit < span; ++bit) {
+            if (pos[bit / 8] & (1u << (bit % 8))) {
+                if (out.size() >= maxIndices) {
+                    return false;
+                }
+                out.push_back(first + bit);
+            }
+        }
+        pos += (span + 7) / 8;
+        return true;
+
+    } else if (encoding == Encoding::Runs) {
+        std::uint64_t numRuns;
+        if (!readVarint(pos, end, numRuns) || (numRuns > static_cast<std::uint64_t>(end - pos))) {
+            return false;
+        }
+        std::uint64_t previousEnd = 0;
+        for (std::uint64_t r = 0; r < numRuns; ++r) {
+            std::uint64_t gap, length;
+            if (!readVarint(pos, end, gap) || !readVarint(pos, end, length)) {
+                return false;
+            }
+            const auto first = previousEnd + gap;
+            const auto last = first + length;
+            // The runs must be disjoint and ascending and must not exceed the bounds
+            if ((first < previousEnd) || (last < first) || (length >= maxIndices - out.size()) ||
+                ((last == std::numeric_limits<std::uint64_t>::max()) && (r + 1 < numRuns))) {
+                return false;
+            }
+            for (std::uint64_t i = 0; i <= length; ++i) {
+                out.push_back(first + i);
+            }
+            previousEnd = last + 1;
+        }
+        return true;
+    }
+
+    return false;
+}
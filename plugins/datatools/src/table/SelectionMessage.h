@@ -0,0 +1,87 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace megamol::datatools::table {
+
+/**
+ * A selection update exchanged by TableSelectionTx. Baselines hold the whole selection, deltas hold the indices added
+ * to and removed from the selection of the version they are based on.
+ *
+ * Layout, little endian:
+ *
+ *     uint32   magic "MMSL"
+ *     uint8    kind
+ *     uint64   version
+ *     uint64   base version (deltas only)
+ *     indices  added indices (the selection for baselines)
+ *     indices  removed indices (deltas only)
+ *
+ * Sorted indices are stored either as runs (uint8 0, varint run count, per run varint gap to the end of the previous
+ * run and varint length - 1) or as bitmap (uint8 1, varint first index, varint bit count, bits), whichever is smaller.
+ */
+struct SelectionMessage {
+    enum class Kind : std::uint8_t { Baseline = 0, Delta = 1 };
+
+    /** Bounds the memory a malformed message can claim if the receiver knows no tighter bound. */
+    static constexpr std::uint64_t MaxIndices = 1ull << 31;
+
+    Kind kind = Kind::Baseline;
+    std::uint64_t version = 0;
+    std::uint64_t baseVersion = 0;
+
+    /** The sorted, unique indices added to the selection, or the whole selection for baselines. */
+    std::vector<std::uint64_t> added;
+
+    /** The sorted, unique indices removed from the selection. */
+    std::vector<std::uint64_t> removed;
+
+    /**
+     * Creates the delta between two selections.
+     *
+     * @param from The sorted, unique indices of the base version.
+     * @param to   The sorted, unique indices of the new version.
+     */
+    static SelectionMessage MakeDelta(const std::vector<std::uint64_t>& from, const std::vector<std::uint64_t>& to,
+        std::uint64_t baseVersion, std::uint64_t version);
+
+    /**
+     * Applies a delta to the selection it is based on.
+     *
+     * @param selection The sorted, unique indices, receives the new selection.
+     */
+    void Apply(std::vector<std::uint64_t>& selection) const;
+
+    void Serialize(std::vector<std::uint8_t>& out) const;
+
+    /**
+     * @param maxIndices The maximum number of indices in each of 'added' and 'removed', larger messages are rejected
+     *                   before they are decoded completely.
+     *
+     * @return false if the data is no valid message.
+     */
+    bool Deserialize(const std::uint8_t* data, std::size_t size, std::uint64_t maxIndices = MaxIndices);
+
+    /**
+     * Appends the encoding of sorted, unique indices.
+     */
+    static void EncodeIndices(const std::vector<std::uint64_t>& indices, std::vector<std::uint8_t>& out);
+
+    /**
+     * Decodes indices encoded by EncodeIndices() and advances 'pos' past them.
+     *
+     * @return false if the data is malformed or holds more than 'maxIndices' indices.
+     */
+    static bool DecodeIndices(const std::uint8_t*& pos, const std::uint8_t* end, std::vector<std::uint64_t>& out,
+        std::uint64_t maxIndices = MaxIndices);
+};
+
+} // namespace megamol::datatools::table
@@ -0,0 +1,161 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "SelectionReceiver.h"
+
+#include <utility>
+
+#include "SelectionMessage.h"
+#include "mmcore/utility/log/Log.h"
+
+using namespace megamol::datatools::table;
+
+SelectionReceiver::SelectionReceiver(zmq::context_t& context, std::string endpoint)
+        : context_(context)
+        , quit_(false)
+        , hasMaxIndices_(false)
+        , maxIndices_(0)
+        , hasSelection_(false)
+        , endpoint_(std::move(endpoint)) {
+    thread_ = std::thread(&SelectionReceiver::run, this);
+}
+
+SelectionReceiver::~SelectionReceiver() {
+    Stop();
+}
+
+void SelectionReceiver::SetEndpoint(std::string endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    endpoint_ = std::move(endpoint);
+    condVar_.notify_one();
+}
+
+std::string SelectionReceiver::BoundEndpoint() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return boundEndpoint_;
+}
+
+void SelectionReceiver::SetMaxIndices(std::uint64_t maxIndices) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    maxIndices_ = maxIndices;
+    hasMaxIndices_ = true;
+    condVar_.notify_one();
+}
+
+bool SelectionReceiver::TakeSelection(std::vector<std::uint64_t>& selection) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!hasSelection_) {
+        return false;
+    }
+    selection = std::move(selection_);
+    selection_.clear();
+    hasSelection_ = false;
+    return true;
+}
+
+void SelectionReceiver::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+        condVar_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void SelectionReceiver::run() {
+    auto makeSocket = [this]() {
+        zmq::socket_t socket{context_, ZMQ_PULL};
+        socket.setsockopt(ZMQ_LINGER, 0);
+        socket.setsockopt(ZMQ_RCVTIMEO, static_cast<int>(ReceiveTimeout.count()));
+        return socket;
+    };
+    zmq::socket_t socket;
+    std::string endpoint;
+    bool bound = false;
+
+    // Deltas are applied to the selection they are based on, others are dropped until the next baseline
+    std::vector<std::uint64_t> selection;
+    std::uint64_t version = 0;
+    bool hasBaseline = false;
+    SelectionMessage message;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!quit_) {
+        const std::string currentEndpoint = endpoint_;
+        const bool hasMaxIndices = hasMaxIndices_;
+        lock.unlock();
+
+        try {
+            if (currentEndpoint != endpoint) {
+                socket = makeSocket();
+                endpoint = currentEndpoint;
+                bound = false;
+                hasBaseline = false;
+                std::string boundEndpoint;
+                if (!endpoint.empty()) {
+                    try {
+                        socket.bind(endpoint);
+                        bound = true;
+                        char lastEndpoint[1024];
+                        size_t size = sizeof(lastEndpoint);
+                        socket.getsockopt(ZMQ_LAST_ENDPOINT, lastEndpoint, &size);
+                        boundEndpoint = lastEndpoint;
+                    } catch (const zmq::error_t& e) {
+                        if (e.num() != ETERM) {
+                            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                                "TableSelectionTx: cannot bind \"%s\": %s", endpoint.c_str(), e.what());
+                        }
+                    }
+                }
+                lock.lock();
+                boundEndpoint_ = boundEndpoint;
+                lock.unlock();
+            }
+
+            zmq::message_t request;
+            if (bound && hasMaxIndices && socket.recv(request, zmq::recv_flags::none)) {
+                // The limit may have changed while waiting for the message
+                lock.lock();
+                const std::uint64_t maxIndices = maxIndices_;
+                lock.unlock();
+
+                const auto data = static_cast<const std::uint8_t*>(request.data());
+                if (!message.Deserialize(data, request.size(), maxIndices)) {
+                    megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+                        "TableSelectionTx: ignoring invalid selection message or selection larger than the table.");
+                } else if ((message.kind == SelectionMessage::Kind::Baseline) ||
+                           (hasBaseline && (message.baseVersion == version))) {
+                    message.Apply(selection);
+                    version = message.version;
+                    hasBaseline = selection.size() <= maxIndices;
+                    if (hasBaseline) {
+                        lock.lock();
+                        selection_ = selection;
+                        hasSelection_ = true;
+                        lock.unlock();
+                    }
+                }
+            }
+        } catch (const zmq::error_t& e) {
+            if (e.num() != ETERM) {
+                megamol::core::utility::log::Log::DefaultLog.WriteError(
+                    "TableSelectionTx: cannot receive on \"%s\": %s", endpoint.c_str(), e.what());
+            }
+        } catch (const std::bad_alloc&) {
+            hasBaseline = false;
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "TableSelectionTx: the received selection does not fit into memory.");
+        }
+
+        lock.lock();
+        if (!bound || !hasMaxIndices) {
+            condVar_.wait_for(lock, ReceiveTimeout,
+                [&]() { return quit_ || (endpoint_ != endpoint) || (hasMaxIndices_ != hasMaxIndices); });
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zmq.hpp>
+
+namespace megamol::datatools::table {
+
+/**
+ * Receives the selection updates of a SelectionSender on a thread of its own, see SelectionMessage. Deltas are
+ * applied to the version they are based on, other deltas are dropped until the next baseline.
+ */
+class SelectionReceiver {
+public:
+    /** The time the receiver waits for messages before checking for a changed endpoint or limit. */
+    static constexpr std::chrono::milliseconds ReceiveTimeout{100};
+
+    /**
+     * Starts the receiver thread.
+     *
+     * @param context  The context, which must outlive the receiver.
+     * @param endpoint The endpoint to bind to, none if empty.
+     */
+    SelectionReceiver(zmq::context_t& context, std::string endpoint);
+
+    /** Stops the receiver thread. */
+    ~SelectionReceiver();
+
+    SelectionReceiver(const SelectionReceiver&) = delete;
+    SelectionReceiver& operator=(const SelectionReceiver&) = delete;
+
+    /** Unbinds and binds to the new endpoint, the received selection is kept until the next baseline. */
+    void SetEndpoint(std::string endpoint);
+
+    /**
+     * Returns the endpoint the receiver is bound to, which holds the port chosen by the system for endpoints like
+     * "tcp://127.0.0.1:*".
+     *
+     * @return The endpoint, empty if the receiver is not bound (yet).
+     */
+    std::string BoundEndpoint();
+
+    /**
+     * Sets the maximum number of indices of a selection, usually the number of rows of the table. Larger messages
+     * are dropped before they are decoded. No messages are received before the limit is set, they stay queued.
+     */
+    void SetMaxIndices(std::uint64_t maxIndices);
+
+    /**
+     * Takes the selection received since the last call.
+     *
+     * @param selection Receives the sorted, unique indices.
+     *
+     * @return false if no new selection has been received.
+     */
+    bool TakeSelection(std::vector<std::uint64_t>& selection);
+
+    /** Stops the receiver thread. */
+    void Stop();
+
+private:
+    void run();
+
+    zmq::context_t& context_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable condVar_;
+    bool quit_;
+    bool hasMaxIndices_;
+    std::uint64_t maxIndices_;
+    bool hasSelection_;
+    std::vector<std::uint64_t> selection_;
+    std::string endpoint_;
+    std::string boundEndpoint_;
+};
+
+} // namespace megamol::datatools::table
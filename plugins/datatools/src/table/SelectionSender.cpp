@@ -0,0 +1,142 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "SelectionSender.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "SelectionMessage.h"
+#include "mmcore/utility/log/Log.h"
+
+using namespace megamol::datatools::table;
+
+SelectionSender::SelectionSender(zmq::context_t& context, std::string endpoint)
+        : context_(context)
+        , quit_(false)
+        , notified_(false)
+        , hasSelection_(false)
+        , endpoint_(std::move(endpoint)) {
+    thread_ = std::thread(&SelectionSender::run, this);
+}
+
+SelectionSender::~SelectionSender() {
+    Stop();
+}
+
+void SelectionSender::SetEndpoint(std::string endpoint) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    endpoint_ = std::move(endpoint);
+    notified_ = true;
+    condVar_.notify_one();
+}
+
+void SelectionSender::SetSelection(std::vector<std::uint64_t> selection) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    selection_ = std::move(selection);
+    hasSelection_ = true;
+    notified_ = true;
+    condVar_.notify_one();
+}
+
+void SelectionSender::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        quit_ = true;
+        condVar_.notify_one();
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+void SelectionSender::run() {
+    auto makeSocket = [this]() {
+        zmq::socket_t socket{context_, ZMQ_PUSH};
+        socket.setsockopt(ZMQ_LINGER, 0);
+        socket.setsockopt(ZMQ_IMMEDIATE, 1);
+        return socket;
+    };
+    zmq::socket_t socket;
+    std::string endpoint;
+
+    std::vector<std::uint64_t> sent;
+    std::uint64_t sentVersion = 0;
+    std::uint64_t version = 0;
+    bool needsBaseline = true;
+    bool isRetryPending = false;
+    std::vector<std::uint8_t> buffer;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!quit_) {
+        // After a failed send, the selection is sent again once the interval has passed without further changes
+        while (!notified_ && !quit_) {
+            if (!isRetryPending) {
+                condVar_.wait(lock);
+            } else if (condVar_.wait_for(lock, RetryInterval) == std::cv_status::timeout) {
+                break;
+            }
+        }
+        if (quit_) {
+            break;
+        }
+
+        notified_ = false;
+        const bool hasSelection = hasSelection_;
+        std::vector<std::uint64_t> selection = selection_;
+        const std::string currentEndpoint = endpoint_;
+        lock.unlock();
+
+        isRetryPending = false;
+
+        try {
+            if (currentEndpoint != endpoint) {
+                socket = makeSocket();
+                endpoint = currentEndpoint;
+                if (!endpoint.empty()) {
+                    socket.connect(endpoint);
+                }
+                needsBaseline = true;
+            }
+
+            if (hasSelection && !endpoint.empty()) {
+                std::sort(selection.begin(), selection.end());
+                selection.erase(std::unique(selection.begin(), selection.end()), selection.end());
+                ++version;
+
+                SelectionMessage message;
+                if (!needsBaseline && (version % BaselineInterval != 0)) {
+                    message = SelectionMessage::MakeDelta(sent, selection, sentVersion, version);
+                }
+                if (message.kind == SelectionMessage::Kind::Baseline ||
+                    message.added.size() + message.removed.size() >= selection.size()) {
+                    message.kind = SelectionMessage::Kind::Baseline;
+                    message.version = version;
+                    message.added = selection;
+                    message.removed.clear();
+                }
+                message.Serialize(buffer);
+
+                zmq::message_t request{buffer.cbegin(), buffer.cend()};
+                if (socket.send(request, zmq::send_flags::dontwait)) {
+                    sent = std::move(selection);
+                    sentVersion = version;
+                    needsBaseline = false;
+                } else {
+                    needsBaseline = true;
+                    isRetryPending = true;
+                }
+            }
+        } catch (const zmq::error_t& e) {
+            needsBaseline = true;
+            if (e.num() != ETERM) {
+                megamol::core::utility::log::Log::DefaultLog.WriteError(
+                    "TableSelectionTx: cannot send to \"%s\": %s", endpoint.c_str(), e.what());
+            }
+        }
+        lock.lock();
+    }
+}
@@ -0,0 +1,71 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zmq.hpp>
+
+namespace megamol::datatools::table {
+
+/**
+ * Pushes selection updates of TableSelectionTx from a thread of its own, see SelectionMessage. Changes made while a
+ * message is sent are coalesced into the next one. Messages are not queued for receivers which are not connected yet,
+ * failed sends are retried as baseline until they succeed or the selection changes.
+ */
+class SelectionSender {
+public:
+    /** The time a failed send waits before it is retried. */
+    static constexpr std::chrono::milliseconds RetryInterval{100};
+
+    /** Every so many versions a baseline is sent instead of a delta, so that restarted receivers catch up. */
+    static constexpr std::uint64_t BaselineInterval = 64;
+
+    /**
+     * Starts the sender thread.
+     *
+     * @param context  The context, which must outlive the sender.
+     * @param endpoint The endpoint to connect to, none if empty.
+     */
+    SelectionSender(zmq::context_t& context, std::string endpoint);
+
+    /** Stops the sender thread. */
+    ~SelectionSender();
+
+    SelectionSender(const SelectionSender&) = delete;
+    SelectionSender& operator=(const SelectionSender&) = delete;
+
+    /** Reconnects and sends the current selection, if any, to the new endpoint. */
+    void SetEndpoint(std::string endpoint);
+
+    /** Sends the selection, given as indices in any order. */
+    void SetSelection(std::vector<std::uint64_t> selection);
+
+    /** Stops the sender thread, pending changes are dropped. */
+    void Stop();
+
+private:
+    void run();
+
+    zmq::context_t& context_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable condVar_;
+    bool quit_;
+    bool notified_;
+    bool hasSelection_;
+    std::vector<std::uint64_t> selection_;
+    std::string endpoint_;
+};
+
+} // namespace megamol::datatools::table
@@ -0,0 +1,358 @@
+/*
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "TableGroupBy.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+#include "TableKeyIndex.h"
+#include "mmcore/param/StringParam.h"
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::TableGroupBy
+ */
+megamol::datatools::table::TableGroupBy::TableGroupBy()
+        : paramKeyColumns("keyColumns", "The columns to group by, separated by ';'.")
+        , paramAggregates("aggregates",
+              "The aggregated columns separated by ';', e.g. \"count; mean(x); max(x); quantile(x, 0.9)\". Supports "
+              "count, sum, mean, min, max, median and quantile. The count and the mean of every other column if empty.")
+        , grouped(4, 512ull * 1024ull * 1024ull, [](GroupedTable const& t) {
+            return t.columns.size() * sizeof(ColumnInfo) + t.values.size() * sizeof(float);
+        }) {
+    /* Configure and export the parameters. */
+    this->paramKeyColumns << new core::param::StringParam("");
+    this->MakeSlotAvailable(&this->paramKeyColumns);
+
+    this->paramAggregates << new core::param::StringParam("");
+    this->MakeSlotAvailable(&this->paramAggregates);
+}
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::~TableGroupBy
+ */
+megamol::datatools::table::TableGroupBy::~TableGroupBy() {
+    this->Release();
+}
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::create
+ */
+bool megamol::datatools::table::TableGroupBy::create() {
+    return true;
+}
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::prepareData
+ */
+bool megamol::datatools::table::TableGroupBy::prepareData(TableDataCall& src, const unsigned int frameID) {
+    using megamol::core::utility::log::Log;
+
+    /* Request the source data. */
+    src.SetFrameID(frameID);
+    if (!(src) (0)) {
+        Log::DefaultLog.WriteError(
+            _T("The call to %hs failed in %hs."), TableDataCall::FunctionName(0), TableDataCall::ClassName());
+        return false;
+    }
+
+    /* (Re-) Generate the data unless it has been grouped for this state before. */
+    core::DataFingerprint fingerprint;
+    fingerprint.AddInput(src).AddFrame(src.GetFrameID()).AddParams(*this);
+
+    auto entry = this->grouped.GetOrCompute(fingerprint, [this, &src](GroupedTable& t) { return this->group(src, t); });
+    if (!entry.value) {
+        return false;
+    }
+
+    /* Persist the state of the data. */
+    if (entry.id != this->localHash) {
+        this->columns = entry.value->columns;
+        this->values = entry.value->values;
+        this->localHash = entry.id;
+    }
+    this->frameID = frameID;
+    this->inputHash = src.DataHash();
+    this->paramKeyColumns.ResetDirty();
+    this->paramAggregates.ResetDirty();
+
+    return true;
+}
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::parseAggregates
+ */
+bool megamol::datatools::table::TableGroupBy::parseAggregates(
+    TableDataCall& src, const std::vector<std::size_t>& keys, std::vector<Aggregate>& dst) {
+    using megamol::core::utility::log::Log;
+
+    const auto numColumns = src.GetColumnsCount();
+    const auto columns = src.GetColumnsInfos();
+    const auto spec = this->paramAggregates.Param<core::param::StringParam>()->Value();
+    dst.clear();
+
+    if (spec.find_first_not_of(" \t;") == std::string::npos) {
+        dst.push_back(Aggregate{Function::Count, 0, 0.0f, "count"});
+        for (std::size_t c = 0; c < numColumns; ++c) {
+            if (std::find(keys.begin(), keys.end(), c) == keys.end()) {
+                dst.push_back(Aggregate{Function::Mean, c, 0.0f, "mean(" + columns[c].Name() + ")"});
+            }
+        }
+        return true;
+    }
+
+    std::size_t begin = 0;
+    while (begin <= spec.size()) {
+        auto end = std::min(spec.find(';', begin), spec.size());
+        auto token = spec.substr(begin, end - begin);
+        begin = end + 1;
+        if (token.find_first_not_of(" \t") == std::string::npos) {
+            continue;
+        }
+
+        // split "function(column, argument)"
+        auto open = token.find('(');
+        auto close = token.rfind(')');
+        auto function = token.substr(0, open);
+        function.erase(
+            std::remove_if(function.begin(), function.end(), [](unsigned char c) { return std::isspace(c); }),
+            function.end());
+        std::transform(function.begin(), function.end(), function.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        std::string column, argument;
+        if (open != std::string::npos) {
+            if (close == std::string::npos || close < open) {
+                Log::DefaultLog.WriteError("%hs: The aggregate \"%s\" is missing a ')'.", ClassName(), token.c_str());
+                return false;
+            }
+            column = token.substr(open + 1, close - open - 1);
+            auto comma = column.find(',');
+            if (comma != std::string::npos) {
+                argument = column.substr(comma + 1);
+                column.erase(comma);
+            }
+        }
+
+        Aggregate aggregate{Function::Count, 0, 0.0f, ""};
+        if (function == "count") {
+            dst.push_back(Aggregate{Function::Count, 0, 0.0f, "count"});
+            continue;
+        } else if (function == "sum") {
+            aggregate.function = Function::Sum;
+        } else if (function == "mean") {
+            aggregate.function = Function::Mean;
+        } else if (function == "min") {
+            aggregate.function = Function::Min;
+        } else if (function == "max") {
+            aggregate.function = Function::Max;
+        } else if (function == "median") {
+            aggregate.function = Function::Quantile;
+            aggregate.quantile = 0.5f;
+        } else if (function == "quantile") {
+            aggregate.function = Function::Quantile;
+            try {
+                aggregate.quantile = std::stof(argument);
+            } catch (...) {
+                aggregate.quantile = -1.0f;
+            }
+            if (!(aggregate.quantile >= 0.0f && aggregate.quantile <= 1.0f)) {
+                Log::DefaultLog.WriteError(
+                    "%hs: The quantile in \"%s\" must be within [0, 1].", ClassName(), token.c_str());
+                return false;
+            }
+        } else {
+            Log::DefaultLog.WriteError("%hs: The aggregate \"%s\" is unknown.", ClassName(), token.c_str());
+            return false;
+        }
+
+        std::vector<std::size_t> indices;
+        auto missing = TableKeyIndex::FindColumns(column, columns, numColumns, indices);
+        if (!missing.empty() || indices.size() != 1) {
+            Log::DefaultLog.WriteError(
+                "%hs: The aggregate \"%s\" needs exactly one existing column.", ClassName(), token.c_str());
+            return false;
+        }
+        aggregate.column = indices.front();
+        aggregate.name = function + "(" + columns[aggregate.column].Name();
+        if (function == "quantile") {
+            argument.erase(0, argument.find_first_not_of(" \t"));
+            argument.erase(argument.find_last_not_of(" \t") + 1);
+            aggregate.name += ", " + argument;
+        }
+        aggregate.name += ")";
+        dst.push_back(aggregate);
+    }
+
+    return true;
+}
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::group
+ */
+bool megamol::datatools::table::TableGroupBy::group(TableDataCall& src, GroupedTable& dst) {
+    using megamol::core::utility::log::Log;
+
+    const auto numColumns = src.GetColumnsCount();
+    const auto columns = src.GetColumnsInfos();
+    const auto data = src.GetData();
+
+    /* Determine the key columns and the aggregates. */
+    std::vector<std::size_t> keys;
+    auto missing = TableKeyIndex::FindColumns(
+        this->paramKeyColumns.Param<core::param::StringParam>()->Value(), columns, numColumns, keys);
+    if (!missing.empty()) {
+        Log::DefaultLog.WriteError("%hs: The key column \"%s\" does not exist.", ClassName(), missing.c_str());
+        return false;
+    }
+
+    std::vector<Aggregate> aggregates;
+    if (!this->parseAggregates(src, keys, aggregates)) {
+        return false;
+    }
+
+    /* Find the groups, rows with NaN keys do not belong to any. */
+    TableKeyIndex index;
+    index.Build(data, src.GetRowsCount(), numColumns, keys);
+    const auto& groups = index.GetGroups();
+    const auto& rows = index.GetRows();
+
+    // Output the groups in ascending order of their keys
+    std::vector<std::size_t> order(groups.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&](std::size_t l, std::size_t r) {
+        auto lhs = data + groups[l].representative * numColumns;
+        auto rhs = data + groups[r].representative * numColumns;
+        for (auto k : keys) {
+            if (lhs[k] != rhs[k]) {
+                return lhs[k] < rhs[k];
+            }
+        }
+        return false;
+    });
+
+    /* Copy the keys and aggregate the values of every group. */
+    const auto numOutColumns = keys.size() + aggregates.size();
+    dst.values.resize(groups.size() * numOutColumns);
+
+#pragma omp parallel
+    {
+        std::vector<float> buffer;
+
+#pragma omp for schedule(dynamic, 64)
+        for (std::int64_t i = 0; i < static_cast<std::int64_t>(order.size()); ++i) {
+            const auto& g = groups[order[i]];
+            const auto first = rows.data() + g.begin;
+            const auto last = first + g.count;
+            auto out = dst.values.data() + i * numOutColumns;
+
+            for (auto k : keys) {
+                *out++ = data[g.representative * numColumns + k];
+            }
+
+            for (const auto& a : aggregates) {
+                if (a.function == Function::Count) {
+                    *out++ = static_cast<float>(g.count);
+                    continue;
+                }
+
+                // NaN values are skipped
+                double sum = 0.0;
+                std::size_t count = 0;
+                float min = std::numeric_limits<float>::max();
+                float max = std::numeric_limits<float>::lowest();
+                buffer.clear();
+                for (auto r = first; r != last; ++r) {
+                    const auto value = data[*r * numColumns + a.column];
+                    if (std::isnan(value)) {
+                        continue;
+                    }
+                    sum += value;
+                    ++count;
+                    min = std::min(min, value);
+                    max = std::max(max, value);
+                    if (a.function == Function::Quantile) {
+                        buffer.push_back(value);
+                    }
+                }
+
+                auto value = std::numeric_limits<float>::quiet_NaN();
+                switch (a.function) {
+                case Function::Sum:
+                    value = static_cast<float>(sum);
+                    break;
+                case Function::Mean:
+                    value = (count > 0) ? static_cast<float>(sum / count) : value;
+                    break;
+                case Function::Min:
+                    value = (count > 0) ? min : value;
+                    break;
+                case Function::Max:
+                    value = (count > 0) ? max : value;
+                    break;
+                case Function::Quantile:
+                    // Linear interpolation between the closest ranks
+                    if (count > 0) {
+                        const double pos = a.quantile * (count - 1);
+                        const auto lower = static_cast<std::size_t>(pos);
+                        std::nth_element(buffer.begin(), buffer.begin() + lower, buffer.end());
+                        value = buffer[lower];
+                        if (lower + 1 < count) {
+                            auto upper = *std::min_element(buffer.begin() + lower + 1, buffer.end());
+                            value += static_cast<float>((pos - lower) * (upper - value));
+                        }
+                    }
+                    break;
+                default:
+                    break;
+                }
+                *out++ = value;
+            }
+        }
+    }
+
+    /* Describe the output columns. */
+    dst.columns.clear();
+    for (auto k : keys) {
+        dst.columns.push_back(columns[k]);
+    }
+    for (const auto& a : aggregates) {
+        ColumnInfo info;
+        info.SetName(a.name).SetType(TableDataCall::ColumnType::QUANTITATIVE);
+        dst.columns.push_back(info);
+    }
+    for (std::size_t c = 0; c < numOutColumns; ++c) {
+        auto min = std::numeric_limits<float>::max();
+        auto max = std::numeric_limits<float>::lowest();
+        for (std::size_t r = 0; r < groups.size(); ++r) {
+            const auto value = dst.values[r * numOutColumns + c];
+            if (!std::isnan(value)) {
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+        }
+        if (min > max) {
+            min = max = 0.0f;
+        }
+        dst.columns[c].SetMinimumValue(min).SetMaximumValue(max);
+    }
+
+    return true;
+}
+
+
+/*
+ * megamol::datatools::table::TableGroupBy::release
+ */
+void megamol::datatools::table::TableGroupBy::release() {}
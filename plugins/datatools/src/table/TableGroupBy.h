@@ -0,0 +1,112 @@
+/*
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include "TableProcessorBase.h"
+
+#include "mmstd/data/OutputMemoizer.h"
+
+
+namespace megamol::datatools::table {
+
+/**
+ * This module groups the rows of a table by the values of one or more key columns and aggregates the other columns
+ * of every group.
+ */
+class TableGroupBy : public TableProcessorBase {
+
+public:
+    /**
+     * Answer the name of this module.
+     *
+     * @return The name of this module.
+     */
+    static inline const char* ClassName() {
+        return "TableGroupBy";
+    }
+
+    /**
+     * Answer a human readable description of this module.
+     *
+     * @return A human readable description of this module.
+     */
+    static inline const char* Description() {
+        return "Groups rows with equal keys and computes count, sum, mean, min, max or quantiles per group";
+    }
+
+    /**
+     * Answers whether this module is available on the current system.
+     *
+     * @return 'true' if the module is available, 'false' otherwise.
+     */
+    static inline bool IsAvailable() {
+        return true;
+    }
+
+    /**
+     * Initialises a new instance.
+     */
+    TableGroupBy();
+
+    /**
+     * Finalises an instance.
+     */
+    ~TableGroupBy() override;
+
+protected:
+    bool create() override;
+
+    bool prepareData(TableDataCall& src, const unsigned int frameID) override;
+
+    void release() override;
+
+private:
+    enum class Function { Count, Sum, Mean, Min, Max, Quantile };
+
+    /** An output column computed from the values of a column in every group. */
+    struct Aggregate {
+        Function function;
+        std::size_t column;
+        float quantile;
+        std::string name;
+    };
+
+    /** The aggregated columns and values. */
+    struct GroupedTable {
+        std::vector<ColumnInfo> columns;
+        std::vector<float> values;
+    };
+
+    /**
+     * Parses the aggregates, like "count; mean(x); quantile(y, 0.9)".
+     *
+     * @param src  The call holding the source data.
+     * @param keys The key columns, all other columns are averaged if no aggregates are given.
+     * @param dst  Receives the aggregates.
+     *
+     * @return false if the aggregates are invalid.
+     */
+    bool parseAggregates(TableDataCall& src, const std::vector<std::size_t>& keys, std::vector<Aggregate>& dst);
+
+    /**
+     * Groups and aggregates the data of 'src'.
+     *
+     * @param src The call holding the source data.
+     * @param dst Receives the grouped table.
+     *
+     * @return true in case of success, false otherwise.
+     */
+    bool group(TableDataCall& src, GroupedTable& dst);
+
+    core::param::ParamSlot paramKeyColumns;
+    core::param::ParamSlot paramAggregates;
+
+    /** The recently grouped tables. */
+    core::OutputMemoizer<GroupedTable> grouped;
+};
+
+} // namespace megamol::datatools::table
@@ -7,8 +7,18 @@
 
 #include "TableJoin.h"
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 
+#include "TableKeyIndex.h"
+#include "mmcore/param/EnumParam.h"
+#include "mmcore/param/StringParam.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace megamol::datatools;
 using namespace megamol::datatools::table;
 using namespace megamol;
@@ -25,9 +35,13 @@ TableJoin::TableJoin()
         , firstTableInSlot("firstTableIn", "First input")
         , secondTableInSlot("secondTableIn", "Second input")
         , dataOutSlot("dataOut", "Output")
+        , modeSlot("mode", "Concatenate the rows with equal position, or join the rows with equal keys")
+        , firstKeysSlot("firstKeyColumns", "Key columns of the first table, separated by ';'")
+        , secondKeysSlot("secondKeyColumns", "Key columns of the second table, the same names as in the first if empty")
         , frameID(-1)
         , firstDataHash(std::numeric_limits<unsigned long>::max())
-        , secondDataHash(std::numeric_limits<unsigned long>::max()) {
+        , secondDataHash(std::numeric_limits<unsigned long>::max())
+        , paramHash(0) {
     this->firstTableInSlot.SetCompatibleCall<TableDataCallDescription>();
     this->MakeSlotAvailable(&this->firstTableInSlot);
 
@@ -37,6 +51,19 @@ TableJoin::TableJoin()
     this->dataOutSlot.SetCallback(TableDataCall::ClassName(), TableDataCall::FunctionName(0), &TableJoin::processData);
     this->dataOutSlot.SetCallback(TableDataCall::ClassName(), TableDataCall::FunctionName(1), &TableJoin::getExtent);
     this->MakeSlotAvailable(&this->dataOutSlot);
+
+    auto mode = new core::param::EnumParam(0);
+    mode->SetTypePair(0, "by row position");
+    mode->SetTypePair(1, "inner join on keys");
+    mode->SetTypePair(2, "left join on keys");
+    this->modeSlot << mode;
+    this->MakeSlotAvailable(&this->modeSlot);
+
+    this->firstKeysSlot << new core::param::StringParam("");
+    this->MakeSlotAvailable(&this->firstKeysSlot);
+
+    this->secondKeysSlot << new core::param::StringParam("");
+    this->MakeSlotAvailable(&this->secondKeysSlot);
 }
 
 TableJoin::~TableJoin() {
@@ -87,42 +114,64 @@ bool TableJoin::processData(core::Call& c) {
         if (!(*secondInCall)())
             return false;
 
-        if (this->firstDataHash != firstInCall->DataHash() || this->secondDataHash != secondInCall->DataHash() ||
-            this->frameID != firstInCall->GetFrameID() || this->frameID != secondInCall->GetFrameID()) {
+        const bool isParamDirty =
+            this->modeSlot.IsDirty() || this->firstKeysSlot.IsDirty() || this->secondKeysSlot.IsDirty();
+        if (isParamDirty) {
+            this->modeSlot.ResetDirty();
+            this->firstKeysSlot.ResetDirty();
+            this->secondKeysSlot.ResetDirty();
+            ++this->paramHash;
+        }
+
+        if (isParamDirty || this->firstDataHash != firstInCall->DataHash() ||
+            this->secondDataHash != secondInCall->DataHash() || this->frameID != firstInCall->GetFrameID() ||
+            this->frameID != secondInCall->GetFrameID()) {
             this->firstDataHash = firstInCall->DataHash();
             this->secondDataHash = secondInCall->DataHash();
             ASSERT(firstInCall->GetFrameID() == secondInCall->GetFrameID());
             this->frameID = firstInCall->GetFrameID();
 
-            // retrieve data
-            auto firstRowsCount = firstInCall->GetRowsCount();
-            auto firstColumnCount = firstInCall->GetColumnsCount();
-            auto firstColumnInfos = firstInCall->GetColumnsInfos();
-            auto firstData = firstInCall->GetData();
-
-            auto secondRowsCount = secondInCall->GetRowsCount();
-            auto secondColumnCount = secondInCall->GetColumnsCount();
-            auto secondColumnInfos = secondInCall->GetColumnsInfos();
-            auto secondData = secondInCall->GetData();
-
-            // concatenate
-            this->rows_count = std::max(firstRowsCount, secondRowsCount);
-            this->column_count = firstColumnCount + secondColumnCount;
-            this->column_info.clear();
-            this->column_info.resize(this->column_count);
-            memcpy(this->column_info.data(), firstColumnInfos, sizeof(TableDataCall::ColumnInfo) * firstColumnCount);
-            memcpy(&(this->column_info.data()[firstColumnCount]), secondColumnInfos,
-                sizeof(TableDataCall::ColumnInfo) * secondColumnCount);
-            this->data.clear();
-            this->data.resize(this->rows_count * this->column_count);
-
-            this->concatenate(this->data.data(), this->rows_count, this->column_count, firstData, firstRowsCount,
-                firstColumnCount, secondData, secondRowsCount, secondColumnCount);
+            const auto mode = this->modeSlot.Param<core::param::EnumParam>()->Value();
+            if (mode != 0) {
+                if (!this->joinOnKeys(*firstInCall, *secondInCall, mode == 2)) {
+                    // try again with the next request
+                    this->firstDataHash = std::numeric_limits<unsigned long>::max();
+                    return false;
+                }
+                // Rows of both inputs are dropped or padded, so the ranges of the inputs do not hold anymore
+                this->updateColumnRanges();
+            } else {
+                // retrieve data
+                auto firstRowsCount = firstInCall->GetRowsCount();
+                auto firstColumnCount = firstInCall->GetColumnsCount();
+                auto firstColumnInfos = firstInCall->GetColumnsInfos();
+                auto firstData = firstInCall->GetData();
+
+                auto secondRowsCount = secondInCall->GetRowsCount();
+                auto secondColumnCount = secondInCall->GetColumnsCount();
+                auto secondColumnInfos = secondInCall->GetColumnsInfos();
+                auto secondData = secondInCall->GetData();
+
+                // concatenate
+                this->rows_count = std::max(firstRowsCount, secondRowsCount);
+                this->column_count = firstColumnCount + secondColumnCount;
+                this->column_info.clear();
+                this->column_info.resize(this->column_count);
+                memcpy(
+                    this->column_info.data(), firstColumnInfos, sizeof(TableDataCall::ColumnInfo) * firstColumnCount);
+                memcpy(&(this->column_info.data()[firstColumnCount]), secondColumnInfos,
+                    sizeof(TableDataCall::ColumnInfo) * secondColumnCount);
+                this->data.clear();
+                this->data.resize(this->rows_count * this->column_count);
+
+                this->concatenate(this->data.data(), this->rows_count, this->column_count, firstData, firstRowsCount,
+                    firstColumnCount, secondData, secondRowsCount, secondColumnCount);
+            }
         }
 
         outCall->SetFrameCount(firstInCall->GetFrameCount());
         outCall->SetFrameID(this->frameID);
-        outCall->SetDataHash(hash_combine(this->firstDataHash, this->secondDataHash));
+        outCall->SetDataHash(hash_combine(hash_combine(this->firstDataHash, this->secondDataHash), this->paramHash));
         outCall->Set(this->column_count, this->rows_count, this->column_info.data(), this->data.data());
     } catch (...) {
         megamol::core::utility::log::Log::DefaultLog.WriteError(
@@ -158,6 +207,126 @@ void TableJoin::concatenate(float* const out, const size_t rowCount, const size_
     }
 }
 
+void TableJoin::updateColumnRanges() {
+#pragma omp parallel for schedule(static)
+    for (int64_t c = 0; c < static_cast<int64_t>(this->column_count); ++c) {
+        auto min = std::numeric_limits<float>::max();
+        auto max = std::numeric_limits<float>::lowest();
+        for (size_t r = 0; r < this->rows_count; ++r) {
+            const auto value = this->data[c + r * this->column_count];
+            if (!std::isnan(value)) {
+                min = std::min(min, value);
+                max = std::max(max, value);
+            }
+        }
+        if (min > max) {
+            min = max = 0.0f;
+        }
+        this->column_info[c].SetMinimumValue(min).SetMaximumValue(max);
+    }
+}
+
+bool TableJoin::joinOnKeys(TableDataCall& first, TableDataCall& second, bool isLeftJoin) {
+    using megamol::core::utility::log::Log;
+
+    const auto firstColumnCount = first.GetColumnsCount();
+    const auto firstColumnInfos = first.GetColumnsInfos();
+    const auto firstRowsCount = first.GetRowsCount();
+    const auto firstData = first.GetData();
+    const auto secondColumnCount = second.GetColumnsCount();
+    const auto secondColumnInfos = second.GetColumnsInfos();
+    const auto secondData = second.GetData();
+
+    // resolve the key columns
+    const auto firstKeyNames = this->firstKeysSlot.Param<core::param::StringParam>()->Value();
+    auto secondKeyNames = this->secondKeysSlot.Param<core::param::StringParam>()->Value();
+    if (secondKeyNames.empty()) {
+        secondKeyNames = firstKeyNames;
+    }
+    std::vector<size_t> firstKeys, secondKeys;
+    auto missing = TableKeyIndex::FindColumns(firstKeyNames, firstColumnInfos, firstColumnCount, firstKeys);
+    if (missing.empty()) {
+        missing = TableKeyIndex::FindColumns(secondKeyNames, secondColumnInfos, secondColumnCount, secondKeys);
+    }
+    if (!missing.empty()) {
+        Log::DefaultLog.WriteError("%hs: The key column \"%s\" does not exist", ModuleName.c_str(), missing.c_str());
+        return false;
+    }
+    if (firstKeys.empty() || firstKeys.size() != secondKeys.size()) {
+        Log::DefaultLog.WriteError(
+            "%hs: Both tables need the same, non-zero number of key columns", ModuleName.c_str());
+        return false;
+    }
+
+    // the output holds all columns of the first table and the non-key columns of the second one
+    std::vector<size_t> secondValues;
+    for (size_t col = 0; col < secondColumnCount; ++col) {
+        if (std::find(secondKeys.begin(), secondKeys.end(), col) == secondKeys.end()) {
+            secondValues.push_back(col);
+        }
+    }
+    this->column_count = firstColumnCount + secondValues.size();
+    this->column_info.assign(firstColumnInfos, firstColumnInfos + firstColumnCount);
+    for (auto col : secondValues) {
+        this->column_info.push_back(secondColumnInfos[col]);
+    }
+
+    // build phase: index the second table, probe phase: count and then copy the matches of every block of rows
+    TableKeyIndex index;
+    index.Build(secondData, second.GetRowsCount(), secondColumnCount, secondKeys);
+
+    const auto& matches = index.GetRows();
+#ifdef _OPENMP
+    const size_t numBlocks = std::max<size_t>(std::min<size_t>(4 * omp_get_max_threads(), firstRowsCount), 1);
+#else
+    const size_t numBlocks = 1;
+#endif
+    std::vector<size_t> blockRows(numBlocks + 1, 0);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < static_cast<int64_t>(numBlocks); ++b) {
+        size_t count = 0;
+        for (auto r = firstRowsCount * b / numBlocks; r < firstRowsCount * (b + 1) / numBlocks; ++r) {
+            auto group = index.Find(firstData + r * firstColumnCount, firstKeys);
+            count += (group != nullptr) ? group->count : (isLeftJoin ? 1 : 0);
+        }
+        blockRows[b + 1] = count;
+    }
+    for (size_t b = 0; b < numBlocks; ++b) {
+        blockRows[b + 1] += blockRows[b];
+    }
+
+    this->rows_count = blockRows[numBlocks];
+    this->data.resize(this->rows_count * this->column_count);
+
+#pragma omp parallel for schedule(static)
+    for (int64_t b = 0; b < static_cast<int64_t>(numBlocks); ++b) {
+        auto out = this->data.data() + blockRows[b] * this->column_count;
+        for (auto r = firstRowsCount * b / numBlocks; r < firstRowsCount * (b + 1) / numBlocks; ++r) {
+            const auto row = firstData + r * firstColumnCount;
+            const auto group = index.Find(row, firstKeys);
+            if (group == nullptr) {
+                if (isLeftJoin) {
+                    std::copy(row, row + firstColumnCount, out);
+                    std::fill(out + firstColumnCount, out + this->column_count, NAN);
+                    out += this->column_count;
+                }
+                continue;
+            }
+            for (auto m = group->begin; m < group->begin + group->count; ++m) {
+                const auto match = secondData + matches[m] * secondColumnCount;
+                std::copy(row, row + firstColumnCount, out);
+                for (size_t i = 0; i < secondValues.size(); ++i) {
+                    out[firstColumnCount + i] = match[secondValues[i]];
+                }
+                out += this->column_count;
+            }
+        }
+    }
+
+    return true;
+}
+
 bool TableJoin::getExtent(core::Call& c) {
     try {
         TableDataCall* outCall = dynamic_cast<TableDataCall*>(&c);
@@ -173,7 +342,7 @@ bool TableJoin::getExtent(core::Call& c) {
             return false;
 
         outCall->SetFrameCount(inCall->GetFrameCount());
-        outCall->SetDataHash(hash_combine(this->firstDataHash, this->secondDataHash));
+        outCall->SetDataHash(hash_combine(hash_combine(this->firstDataHash, this->secondDataHash), this->paramHash));
     } catch (...) {
         megamol::core::utility::log::Log::DefaultLog.WriteError(
             _T("Failed to execute %hs::getExtent\n"), ModuleName.c_str());
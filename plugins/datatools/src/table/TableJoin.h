@@ -19,7 +19,8 @@
 namespace megamol::datatools::table {
 
 /**
- * This module joins two tables by copying the values together into one matrix
+ * This module joins two tables, either by copying the values of the rows with the same position together into one
+ * matrix or by matching the values of one or more key columns with a parallel hash join
  */
 class TableJoin : public core::Module {
 public:
@@ -40,7 +41,7 @@ public:
      * @return A human readable description of this module.
      */
     static inline const char* Description() {
-        return "Joins two tables (union of columns)";
+        return "Joins two tables (union of columns), by row position or on key columns";
     }
 
     /**
@@ -82,6 +83,12 @@ private:
     /** extent callback */
     bool getExtent(core::Call& c);
 
+    /** joins the rows of the first table to the rows of the second table with equal keys */
+    bool joinOnKeys(TableDataCall& first, TableDataCall& second, bool isLeftJoin);
+
+    /** sets the ranges of the columns to the joined values, ignoring the NaNs of missing matches */
+    void updateColumnRanges();
+
     /** concatenates two tables */
     static void concatenate(float* const out, const size_t rowCount, const size_t columnCount, const float* const first,
         const size_t firstRowCount, const size_t firstColumnCount, const float* const second,
@@ -96,6 +103,15 @@ private:
     /** data output */
     core::CalleeSlot dataOutSlot;
 
+    /** concatenation by row position, inner or left join */
+    core::param::ParamSlot modeSlot;
+
+    /** key columns of the first table, separated by ';' */
+    core::param::ParamSlot firstKeysSlot;
+
+    /** key columns of the second table, the keys of the first table if empty */
+    core::param::ParamSlot secondKeysSlot;
+
     /** frameID */
     int frameID;
 
@@ -103,6 +119,9 @@ private:
     size_t firstDataHash;
     size_t secondDataHash;
 
+    /** counts the changes of the parameters */
+    size_t paramHash;
+
     /** number of rows of the table */
     size_t rows_count;
 
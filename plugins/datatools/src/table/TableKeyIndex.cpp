@@ -0,0 +1,287 @@
+/*
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "TableKeyIndex.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace {
+
+inline std::uint64_t mix(std::uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+inline std::string trim(const std::string& str) {
+    auto begin = std::find_if_not(str.begin(), str.end(), [](unsigned char c) { return std::isspace(c); });
+    auto end = std::find_if_not(str.rbegin(), str.rend(), [](unsigned char c) { return std::isspace(c); }).base();
+    return (begin < end) ? std::string(begin, end) : std::string();
+}
+
+inline bool equalsInsensitive(const std::string& lhs, const std::string& rhs) {
+    return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char l, char r) {
+        return std::tolower(static_cast<unsigned char>(l)) == std::tolower(static_cast<unsigned char>(r));
+    });
+}
+
+inline unsigned int ceilLog2(std::size_t value) {
+    unsigned int retval = 0;
+    while ((static_cast<std::size_t>(1) << retval) < value) {
+        ++retval;
+    }
+    return retval;
+}
+
+} // namespace
+
+
+/*
+ * megamol::datatools::table::TableKeyIndex::FindColumns
+ */
+std::string megamol::datatools::table::TableKeyIndex::FindColumns(const std::string& names,
+    const TableDataCall::ColumnInfo* columns, std::size_t numColumns, std::vector<std::size_t>& outIndices) {
+    outIndices.clear();
+
+    std::size_t begin = 0;
+    while (begin <= names.size()) {
+        auto end = std::min(names.find(';', begin), names.size());
+        auto name = trim(names.substr(begin, end - begin));
+        begin = end + 1;
+        if (name.empty()) {
+            continue;
+        }
+
+        auto it = std::find_if(columns, columns + numColumns,
+            [&name](const TableDataCall::ColumnInfo& c) { return equalsInsensitive(c.Name(), name); });
+        if (it == columns + numColumns) {
+            return name;
+        }
+        outIndices.push_back(static_cast<std::size_t>(it - columns));
+    }
+
+    return std::string();
+}
+
+
+/*
+ * megamol::datatools::table::TableKeyIndex::Hash
+ */
+bool megamol::datatools::table::TableKeyIndex::Hash(
+    const float* row, const std::vector<std::size_t>& keys, std::uint64_t& outHash) {
+    std::uint64_t hash = 0x9e3779b97f4a7c15ull;
+    for (auto k : keys) {
+        auto value = row[k];
+        if (std::isnan(value)) {
+            return false;
+        }
+        // -0 and 0 are equal keys
+        if (value == 0.0f) {
+            value = 0.0f;
+        }
+        std::uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        hash = mix(hash ^ (bits + 0x9e3779b97f4a7c15ull + (hash << 6)));
+    }
+    outHash = hash;
+    return true;
+}
+
+
+/*
+ * megamol::datatools::table::TableKeyIndex::Build
+ */
+void megamol::datatools::table::TableKeyIndex::Build(
+    const float* data, std::size_t numRows, std::size_t numColumns, const std::vector<std::size_t>& keys) {
+    this->data = data;
+    this->numColumns = numColumns;
+    this->keys = keys;
+
+#ifdef _OPENMP
+    const auto numThreads = static_cast<std::size_t>(omp_get_max_threads());
+#else
+    const std::size_t numThreads = 1;
+#endif
+
+    // A few partitions per thread balance the load, but tiny tables are not split at all
+    this->partitionBits = std::min(ceilLog2(8 * numThreads), ceilLog2(std::max<std::size_t>(numRows / 1024, 1)));
+    const std::size_t numPartitions = static_cast<std::size_t>(1) << this->partitionBits;
+    const auto partitionOf = [this](std::uint64_t hash) -> std::size_t {
+        return (this->partitionBits == 0) ? 0 : static_cast<std::size_t>(hash >> (64 - this->partitionBits));
+    };
+
+    // Hash the keys and count the rows of every partition within each block of rows. Rows with NaN keys go to an
+    // additional partition which is not indexed.
+    const std::size_t numBlocks = std::max<std::size_t>(std::min(4 * numThreads, numRows), 1);
+    const std::size_t numCounts = numPartitions + 1;
+    std::vector<std::uint64_t> hashes(numRows);
+    std::vector<std::uint32_t> rowPartitions(numRows);
+    std::vector<std::size_t> offsets(numBlocks * numCounts, 0);
+
+#pragma omp parallel for schedule(static)
+    for (std::int64_t b = 0; b < static_cast<std::int64_t>(numBlocks); ++b) {
+        const auto first = numRows * b / numBlocks;
+        const auto last = numRows * (b + 1) / numBlocks;
+        auto counts = offsets.data() + b * numCounts;
+        for (auto r = first; r < last; ++r) {
+            const auto partition =
+                Hash(data + r * numColumns, keys, hashes[r]) ? partitionOf(hashes[r]) : numPartitions;
+            rowPartitions[r] = static_cast<std::uint32_t>(partition);
+            ++counts[partition];
+        }
+    }
+
+    // Turn the counts into the positions of the blocks in the partitioned rows
+    std::vector<std::size_t> partitionRows(numCounts + 1, 0);
+    {
+        std::size_t offset = 0;
+        for (std::size_t p = 0; p < numCounts; ++p) {
+            partitionRows[p] = offset;
+            for (std::size_t b = 0; b < numBlocks; ++b) {
+                auto count = offsets[b * numCounts + p];
+                offsets[b * numCounts + p] = offset;
+                offset += count;
+            }
+        }
+        partitionRows[numCounts] = offset;
+    }
+
+    // Scatter the row indices, the rows of a partition stay in ascending order
+    std::vector<std::size_t> partitioned(numRows);
+
+#pragma omp parallel for schedule(static)
+    for (std::int64_t b = 0; b < static_cast<std::int64_t>(numBlocks); ++b) {
+        const auto first = numRows * b / numBlocks;
+        const auto last = numRows * (b + 1) / numBlocks;
+        auto positions = offsets.data() + b * numCounts;
+        for (auto r = first; r < last; ++r) {
+            partitioned[positions[rowPartitions[r]]++] = r;
+        }
+    }
+
+    // Index every partition on its own: find the distinct keys and sort the rows by group
+    const std::size_t numIndexed = partitionRows[numPartitions];
+    std::vector<std::vector<Group>> partitionGroups(numPartitions);
+    this->slots.assign(numPartitions, std::vector<std::size_t>());
+    this->rows.resize(numIndexed);
+
+#pragma omp parallel
+    {
+        std::vector<std::size_t> rowGroups;
+
+#pragma omp for schedule(dynamic)
+        for (std::int64_t p = 0; p < static_cast<std::int64_t>(numPartitions); ++p) {
+            const auto first = partitionRows[p];
+            const auto count = partitionRows[p + 1] - first;
+            auto& groups = partitionGroups[p];
+            auto& slots = this->slots[p];
+            if (count == 0) {
+                continue;
+            }
+
+            slots.assign(static_cast<std::size_t>(1) << ceilLog2(2 * count), noGroup);
+            const auto mask = slots.size() - 1;
+            rowGroups.resize(count);
+
+            for (std::size_t i = 0; i < count; ++i) {
+                const auto r = partitioned[first + i];
+                const auto hash = hashes[r];
+                auto slot = static_cast<std::size_t>(hash) & mask;
+                while (slots[slot] != noGroup) {
+                    auto& g = groups[slots[slot]];
+                    if ((g.hash == hash) && this->isEqual(g.representative, data + r * numColumns, keys)) {
+                        break;
+                    }
+                    slot = (slot + 1) & mask;
+                }
+                if (slots[slot] == noGroup) {
+                    slots[slot] = groups.size();
+                    groups.push_back(Group{r, 0, 0, hash});
+                }
+                rowGroups[i] = slots[slot];
+                ++groups[slots[slot]].count;
+            }
+
+            auto offset = first;
+            for (auto& g : groups) {
+                g.begin = offset;
+                offset += g.count;
+                g.count = 0;
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                auto& g = groups[rowGroups[i]];
+                this->rows[g.begin + g.count++] = partitioned[first + i];
+            }
+        }
+    }
+
+    // Concatenate the groups of all partitions
+    this->partitionGroups.resize(numPartitions + 1);
+    this->partitionGroups[0] = 0;
+    for (std::size_t p = 0; p < numPartitions; ++p) {
+        this->partitionGroups[p + 1] = this->partitionGroups[p] + partitionGroups[p].size();
+    }
+    this->groups.resize(this->partitionGroups[numPartitions]);
+
+#pragma omp parallel for schedule(static)
+    for (std::int64_t p = 0; p < static_cast<std::int64_t>(numPartitions); ++p) {
+        std::copy(partitionGroups[p].begin(), partitionGroups[p].end(),
+            this->groups.begin() + this->partitionGroups[p]);
+    }
+}
+
+
+/*
+ * megamol::datatools::table::TableKeyIndex::Find
+ */
+const megamol::datatools::table::TableKeyIndex::Group* megamol::datatools::table::TableKeyIndex::Find(
+    const float* row, const std::vector<std::size_t>& keys) const {
+    std::uint64_t hash;
+    if (this->slots.empty() || !Hash(row, keys, hash)) {
+        return nullptr;
+    }
+
+    const auto partition =
+        (this->partitionBits == 0) ? 0 : static_cast<std::size_t>(hash >> (64 - this->partitionBits));
+    const auto& slots = this->slots[partition];
+    if (slots.empty()) {
+        return nullptr;
+    }
+
+    const auto mask = slots.size() - 1;
+    const auto groups = this->groups.data() + this->partitionGroups[partition];
+    for (auto slot = static_cast<std::size_t>(hash) & mask; slots[slot] != noGroup; slot = (slot + 1) & mask) {
+        auto& g = groups[slots[slot]];
+        if ((g.hash == hash) && this->isEqual(g.representative, row, keys)) {
+            return &g;
+        }
+    }
+
+    return nullptr;
+}
+
+
+/*
+ * megamol::datatools::table::TableKeyIndex::isEqual
+ */
+bool megamol::datatools::table::TableKeyIndex::isEqual(
+    std::size_t indexedRow, const float* row, const std::vector<std::size_t>& keys) const {
+    const auto indexed = this->data + indexedRow * this->numColumns;
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        if (indexed[this->keys[i]] != row[keys[i]]) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,141 @@
+/*
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "datatools/table/TableDataCall.h"
+
+
+namespace megamol::datatools::table {
+
+/**
+ * A hash index over the distinct values of one or more key columns of a table.
+ *
+ * The rows are radix-partitioned by the hash of their key, then every partition is indexed on its own, so building
+ * the index and probing it both run in parallel and in linear time. Rows with equal keys form a group, the rows of a
+ * group are stored contiguously and in ascending order. Rows with a NaN key are not indexed.
+ */
+class TableKeyIndex {
+
+public:
+    /** A set of rows with equal key values. */
+    struct Group {
+        /** The first row of the group. */
+        std::size_t representative;
+
+        /** Offset of the rows of the group in GetRows(). */
+        std::size_t begin;
+
+        /** Number of rows in the group. */
+        std::size_t count;
+
+        std::uint64_t hash;
+    };
+
+    /**
+     * Resolves a list of column names separated by ';', ignoring case and surrounding white space.
+     *
+     * @param names     The list of column names.
+     * @param columns   The columns of the table.
+     * @param numColumns The number of columns of the table.
+     * @param outIndices Receives the column indices.
+     *
+     * @return The first name not found in the table, or an empty string if all names were resolved.
+     */
+    static std::string FindColumns(const std::string& names, const TableDataCall::ColumnInfo* columns,
+        std::size_t numColumns, std::vector<std::size_t>& outIndices);
+
+    /**
+     * Computes the hash of the key of a row, NaN keys are not hashed.
+     *
+     * @param row  The values of the row.
+     * @param keys The indices of the key columns.
+     * @param outHash Receives the hash.
+     *
+     * @return false if any of the key values is NaN.
+     */
+    static bool Hash(const float* row, const std::vector<std::size_t>& keys, std::uint64_t& outHash);
+
+    /**
+     * Builds the index.
+     *
+     * @param data       The row-major values of the table, must outlive the index.
+     * @param numRows    The number of rows.
+     * @param numColumns The number of columns.
+     * @param keys       The indices of the key columns.
+     */
+    void Build(const float* data, std::size_t numRows, std::size_t numColumns, const std::vector<std::size_t>& keys);
+
+    /**
+     * Finds the group of rows whose key equals the key of the given row of another table.
+     *
+     * @param row  The values of the row.
+     * @param keys The indices of the key columns in the row, in the order of the indexed keys.
+     *
+     * @return The group, or nullptr if there are no such rows.
+     */
+    const Group* Find(const float* row, const std::vector<std::size_t>& keys) const;
+
+    /**
+     * Answer the groups, partition by partition.
+     */
+    inline const std::vector<Group>& GetGroups() const {
+        return this->groups;
+    }
+
+    /**
+     * Answer the indexed rows ordered by group.
+     */
+    inline const std::vector<std::size_t>& GetRows() const {
+        return this->rows;
+    }
+
+    /**
+     * Answer the number of partitions.
+     */
+    inline std::size_t GetPartitionCount() const {
+        return this->partitionGroups.size() - 1;
+    }
+
+    /**
+     * Answer the range of groups in the given partition, groups of different partitions never share rows.
+     */
+    inline std::size_t GetPartitionGroupBegin(std::size_t partition) const {
+        return this->partitionGroups[partition];
+    }
+    inline std::size_t GetPartitionGroupEnd(std::size_t partition) const {
+        return this->partitionGroups[partition + 1];
+    }
+
+private:
+    static constexpr std::size_t noGroup = static_cast<std::size_t>(-1);
+
+    /** Answer whether the keys of an indexed row and of the given row are equal. */
+    bool isEqual(std::size_t indexedRow, const float* row, const std::vector<std::size_t>& keys) const;
+
+    const float* data = nullptr;
+    std::size_t numColumns = 0;
+    std::vector<std::size_t> keys;
+
+    /** Number of bits of the hash selecting the partition. */
+    unsigned int partitionBits = 0;
+
+    std::vector<Group> groups;
+
+    /** Index of the first group of each partition and the end of the last one. */
+    std::vector<std::size_t> partitionGroups;
+
+    std::vector<std::size_t> rows;
+
+    /** Open addressing table of every partition, holding group indices. */
+    std::vector<std::vector<std::size_t>> slots;
+};
+
+} // namespace megamol::datatools::table
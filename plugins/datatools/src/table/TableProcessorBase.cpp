@@ -61,13 +61,21 @@ bool megamol::datatools::table::TableProcessorBase::getData(core::Call& call) {
     dst->SetFrameCount(src->GetFrameCount());
     dst->SetFrameID(this->frameID);
     dst->SetDataHash(this->getHash());
-    dst->Set(
-        this->columns.size(), this->values.size() / this->columns.size(), this->columns.data(), this->values.data());
+    this->setOutputData(*dst);
 
     return true;
 }
 
 
+/*
+ * megamol::datatools::table::TableProcessorBase::setOutputData
+ */
+void megamol::datatools::table::TableProcessorBase::setOutputData(TableDataCall& dst) {
+    dst.Set(
+        this->columns.size(), this->values.size() / this->columns.size(), this->columns.data(), this->values.data());
+}
+
+
 /*
  * megamol::datatools::table::TableProcessorBase::getHash
  */
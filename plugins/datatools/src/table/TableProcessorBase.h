@@ -59,6 +59,14 @@ protected:
      */
     virtual bool prepareData(TableDataCall& src, const unsigned int frameID) = 0;
 
+    /**
+     * Publishes the table prepared by the last call to 'prepareData' to
+     * 'dst'. The default implementation publishes 'columns' and 'values'.
+     *
+     * @param dst The call receiving the data.
+     */
+    virtual void setOutputData(TableDataCall& dst);
+
     /** Holds the columns of the (filtered) table. */
     std::vector<ColumnInfo> columns;
 
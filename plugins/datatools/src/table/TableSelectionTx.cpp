@@ -10,6 +10,7 @@
 
 #include "mmcore/param/BoolParam.h"
 #include "mmcore/param/IntParam.h"
+#include "mmcore/param/StringParam.h"
 #include "mmcore/utility/log/Log.h"
 #include "mmstd/flags/FlagCalls.h"
 
@@ -27,10 +28,8 @@ TableSelectionTx::TableSelectionTx()
         , updateSelectionParam("updateSelection", "Enable selection update")
         , useColumnAsIndexParam("useColumnAsIndex", "Use column as index instead of row id")
         , indexColumnParam("indexColumn", "Numeric index of column, which is used as row index")
-        , senderThreadQuit_(false)
-        , senderThreadNotified_(false)
-        , receiverThreadQuit_(false)
-        , receivedSelectionUpdate_(false) {
+        , sendEndpointParam("sendEndpoint", "ZeroMQ endpoint the selection is pushed to")
+        , receiveEndpointParam("receiveEndpoint", "ZeroMQ endpoint the selection of the other process is received on") {
     this->tableInSlot.SetCompatibleCall<datatools::table::TableDataCallDescription>();
     this->MakeSlotAvailable(&this->tableInSlot);
 
@@ -63,6 +62,12 @@ TableSelectionTx::TableSelectionTx()
 
     this->indexColumnParam << new core::param::IntParam(0, 0);
     this->MakeSlotAvailable(&this->indexColumnParam);
+
+    this->sendEndpointParam << new core::param::StringParam("tcp://localhost:10001");
+    this->MakeSlotAvailable(&this->sendEndpointParam);
+
+    this->receiveEndpointParam << new core::param::StringParam("tcp://*:10002");
+    this->MakeSlotAvailable(&this->receiveEndpointParam);
 }
 
 TableSelectionTx::~TableSelectionTx() {
@@ -72,32 +77,22 @@ TableSelectionTx::~TableSelectionTx() {
 bool TableSelectionTx::create() {
     context_ = std::make_unique<zmq::context_t>(1);
 
-    senderThreadQuit_ = false;
-    if (!senderThread_.joinable()) {
-        senderThread_ = std::thread(&TableSelectionTx::selectionSender, this);
-    }
+    this->sendEndpointParam.ResetDirty();
+    this->receiveEndpointParam.ResetDirty();
 
-    receiverThreadQuit_ = false;
-    if (!receiverThread_.joinable()) {
-        receiverThread_ = std::thread(&TableSelectionTx::selectionReceiver, this);
-    }
+    sender_ = std::make_unique<SelectionSender>(
+        *context_, this->sendEndpointParam.Param<core::param::StringParam>()->Value());
+    receiver_ = std::make_unique<SelectionReceiver>(
+        *context_, this->receiveEndpointParam.Param<core::param::StringParam>()->Value());
 
     return true;
 }
 
 void TableSelectionTx::release() {
-    senderThreadQuit_ = true;
-    receiverThreadQuit_ = true;
-    senderThreadNotified_ = true;
-    condVar_.notify_one();
+    sender_.reset();
+    receiver_.reset();
     context_->close();
     context_.reset();
-    if (senderThread_.joinable()) {
-        senderThread_.join();
-    }
-    if (receiverThread_.joinable()) {
-        receiverThread_.join();
-    }
 }
 
 bool TableSelectionTx::readDataCallback(core::Call& call) {
@@ -110,6 +105,8 @@ bool TableSelectionTx::readDataCallback(core::Call& call) {
         return false;
     }
 
+    updateEndpoints();
+
     if (!validateSelectionUpdate()) {
         return false;
     }
@@ -136,6 +133,8 @@ bool TableSelectionTx::writeDataCallback(core::Call& call) {
         return false;
     }
 
+    updateEndpoints();
+
     auto* flagsWriteInCall = this->flagStorageWriteInSlot.CallAs<core::FlagCallWrite_CPU>();
 
     flagsWriteInCall->setData(flagsWriteOutCall->getData(), flagsWriteOutCall->version());
@@ -174,24 +173,21 @@ bool TableSelectionTx::writeDataCallback(core::Call& call) {
     constexpr core::FlagStorageTypes::flag_item_type passMask =
         core::FlagStorageTypes::to_integral(core::FlagStorageTypes::flag_bits::ENABLED);
 
-    std::unique_lock<std::mutex> lock(selectedMutex_);
-    selected_.clear();
+    std::vector<uint64_t> selected;
     for (std::size_t i = 0; i < numberOfRows; ++i) {
         if ((flags[i] & testMask) == passMask) {
             if (flags[i] & core::FlagStorageTypes::to_integral(core::FlagStorageTypes::flag_bits::SELECTED)) {
                 if (useColumnAsIndex) {
-                    selected_.push_back(static_cast<uint64_t>(tableData[indexColumn + i * numberOfCols]));
+                    selected.push_back(static_cast<uint64_t>(tableData[indexColumn + i * numberOfCols]));
                 } else {
-                    selected_.push_back(static_cast<uint64_t>(i));
+                    selected.push_back(static_cast<uint64_t>(i));
                 }
             } else {
                 // not selected
             }
         }
     }
-    senderThreadNotified_ = true;
-    condVar_.notify_one();
-    lock.unlock();
+    sender_->SetSelection(std::move(selected));
 
     return true;
 }
@@ -224,13 +220,20 @@ bool TableSelectionTx::validateCalls() {
 }
 
 bool TableSelectionTx::validateSelectionUpdate() {
-    std::lock_guard<std::mutex> lock(receivedSelectionMutex_);
-    if (!receivedSelectionUpdate_) {
+    // The receiver decodes no more indices than the table has rows, so it needs the table before the first message
+    auto* tableInCall = this->tableInSlot.CallAs<datatools::table::TableDataCall>();
+    tableInCall->SetFrameID(0);
+    (*tableInCall)(1);
+    (*tableInCall)(0);
+
+    std::size_t numberOfRows = tableInCall->GetRowsCount();
+    receiver_->SetMaxIndices(numberOfRows);
+
+    std::vector<uint64_t> receivedSelection;
+    if (!receiver_->TakeSelection(receivedSelection)) {
         return true;
     }
 
-    receivedSelectionUpdate_ = false;
-
     if (!this->updateSelectionParam.Param<core::param::BoolParam>()->Value()) {
         return true;
     }
@@ -240,19 +243,12 @@ bool TableSelectionTx::validateSelectionUpdate() {
     auto flagCollection = flagsReadInCall->getData();
     auto version = flagsReadInCall->version();
 
-    auto* tableInCall = this->tableInSlot.CallAs<datatools::table::TableDataCall>();
-    tableInCall->SetFrameID(0);
-    (*tableInCall)(1);
-    (*tableInCall)(0);
-
-    std::size_t numberOfRows = tableInCall->GetRowsCount();
-
     core::FlagStorageTypes::flag_vector_type flags_data(
         numberOfRows, core::FlagStorageTypes::to_integral(core::FlagStorageTypes::flag_bits::ENABLED));
 
     if (!this->useColumnAsIndexParam.Param<core::param::BoolParam>()->Value()) {
         // Select received rows
-        for (auto id : receivedSelection_) {
+        for (auto id : receivedSelection) {
             if (id >= 0 && id < numberOfRows) {
                 flags_data[id] |= core::FlagStorageTypes::to_integral(core::FlagStorageTypes::flag_bits::SELECTED);
             }
@@ -269,7 +265,7 @@ bool TableSelectionTx::validateSelectionUpdate() {
 
         // Use unordered set for O(1) lookup of selected values
         std::unordered_set<float> s;
-        for (auto id : receivedSelection_) {
+        for (auto id : receivedSelection) {
             s.insert(static_cast<float>(id));
         }
 
@@ -290,60 +286,13 @@ bool TableSelectionTx::validateSelectionUpdate() {
     return true;
 }
 
-void TableSelectionTx::selectionSender() {
-    zmq::socket_t socket{*context_, ZMQ_REQ};
-    socket.setsockopt(ZMQ_LINGER, 0);
-    socket.connect("tcp://localhost:10001");
-
-    std::unique_lock<std::mutex> lock(selectedMutex_);
-    while (!senderThreadQuit_) {
-        while (!senderThreadNotified_ && !senderThreadQuit_) {
-            condVar_.wait(lock);
-        }
-        while (senderThreadNotified_ && !senderThreadQuit_) {
-            senderThreadNotified_ = false;
-            try {
-                zmq::message_t request{selected_.cbegin(), selected_.cend()};
-                lock.unlock();
-                socket.send(request, zmq::send_flags::none);
-
-                zmq::message_t reply{};
-                socket.recv(reply, zmq::recv_flags::none);
-            } catch (const zmq::error_t& e) {
-                if (e.num() != ETERM) {
-                    std::cerr << e.what() << std::endl;
-                }
-            }
-            lock.lock();
-        }
+void TableSelectionTx::updateEndpoints() {
+    if (this->sendEndpointParam.IsDirty()) {
+        this->sendEndpointParam.ResetDirty();
+        sender_->SetEndpoint(this->sendEndpointParam.Param<core::param::StringParam>()->Value());
     }
-}
-
-void TableSelectionTx::selectionReceiver() {
-    zmq::socket_t socket{*context_, ZMQ_REP};
-    socket.bind("tcp://*:10002");
-
-    const std::string okString{"Ok!"};
-
-    while (!receiverThreadQuit_) {
-        try {
-            zmq::message_t request;
-            socket.recv(request, zmq::recv_flags::none);
-            std::size_t size = request.size() / sizeof(uint64_t);
-
-            if (size > 0) {
-                std::lock_guard<std::mutex> lock(receivedSelectionMutex_);
-                uint64_t* data_ptr = static_cast<uint64_t*>(request.data());
-                receivedSelection_ = std::vector<uint64_t>(data_ptr, data_ptr + size);
-                receivedSelectionUpdate_ = true;
-            }
-
-            zmq::message_t reply{okString.cbegin(), okString.cend()};
-            socket.send(reply, zmq::send_flags::none);
-        } catch (const zmq::error_t& e) {
-            if (e.num() != ETERM) {
-                std::cerr << e.what() << std::endl;
-            }
-        }
+    if (this->receiveEndpointParam.IsDirty()) {
+        this->receiveEndpointParam.ResetDirty();
+        receiver_->SetEndpoint(this->receiveEndpointParam.Param<core::param::StringParam>()->Value());
     }
 }
@@ -6,11 +6,12 @@
 
 #pragma once
 
-#include <condition_variable>
-#include <thread>
+#include <memory>
 
 #include <zmq.hpp>
 
+#include "SelectionReceiver.h"
+#include "SelectionSender.h"
 #include "datatools/table/TableDataCall.h"
 #include "mmcore/CalleeSlot.h"
 #include "mmcore/CallerSlot.h"
@@ -20,7 +21,8 @@
 namespace megamol::datatools::table {
 
 /*
- * Module to send table selection to another process.
+ * Module to send table selection to another process. Selection changes are pushed asynchronously as deltas against
+ * the previously sent version, see SelectionMessage.
  */
 class TableSelectionTx : public core::Module {
 public:
@@ -61,9 +63,8 @@ protected:
 
     bool validateSelectionUpdate();
 
-    void selectionSender();
-
-    void selectionReceiver();
+    /** Passes changed endpoints to the sender and receiver threads. */
+    void updateEndpoints();
 
 private:
     core::CallerSlot tableInSlot;
@@ -76,20 +77,12 @@ private:
     core::param::ParamSlot updateSelectionParam;
     core::param::ParamSlot useColumnAsIndexParam;
     core::param::ParamSlot indexColumnParam;
+    core::param::ParamSlot sendEndpointParam;
+    core::param::ParamSlot receiveEndpointParam;
 
-    std::thread senderThread_;
-    std::thread receiverThread_;
     std::unique_ptr<zmq::context_t> context_;
-    std::vector<uint64_t> selected_;
-    std::mutex selectedMutex_;
-    std::condition_variable condVar_;
-    bool senderThreadQuit_;
-    bool senderThreadNotified_;
-    bool receiverThreadQuit_;
-
-    std::vector<uint64_t> receivedSelection_;
-    bool receivedSelectionUpdate_;
-    std::mutex receivedSelectionMutex_;
+    std::unique_ptr<SelectionSender> sender_;
+    std::unique_ptr<SelectionReceiver> receiver_;
 };
 
 } // namespace megamol::datatools::table
@@ -23,7 +23,10 @@
 megamol::datatools::table::TableSort::TableSort()
         : paramColumn("column", "The column to be filtered.")
         , paramIsDescending("descending", "Sort in descending instead of ascending order.")
-        , paramIsStable("stableSort", "Use a stable sorting algorithm.") {
+        , paramIsStable("stableSort", "Use a stable sorting algorithm.")
+        , sorted(4, 512ull * 1024ull * 1024ull, [](SortedTable const& t) {
+            return t.columns.size() * sizeof(ColumnInfo) + t.values.size() * sizeof(float);
+        }) {
     /* Configure and export the parameters. */
     this->paramColumn << new core::param::FlexEnumParam("");
     this->MakeSlotAvailable(&this->paramColumn);
@@ -57,7 +60,6 @@ bool megamol::datatools::table::TableSort::create() {
  * megamol::datatools::table::TableSort::prepareData
  */
 bool megamol::datatools::table::TableSort::prepareData(TableDataCall& src, const unsigned int frameID) {
-    using namespace core::param;
     using megamol::core::utility::log::Log;
 
     /* Request the source data. */
@@ -68,83 +70,96 @@ bool megamol::datatools::table::TableSort::prepareData(TableDataCall& src, const
         return false;
     }
 
-    auto isParamsChanged = this->paramColumn.IsDirty() || this->paramColumn.IsDirty() ||
-                           this->paramIsDescending.IsDirty() || this->paramIsStable.IsDirty();
-
-    /* (Re-) Generate the data. */
-    if (isParamsChanged || (this->inputHash != src.DataHash()) || (this->frameID != src.GetFrameID())) {
-        auto column = 0;
-        const auto data = src.GetData();
-        std::vector<std::size_t> proxy(src.GetRowsCount());
-
-        /* Copy the column descriptors. */
-        this->columns.resize(src.GetColumnsCount());
-        std::copy(src.GetColumnsInfos(), src.GetColumnsInfos() + this->columns.size(), this->columns.begin());
-
-        /* Update the column selector. */
-        {
-            auto param = this->paramColumn.Param<FlexEnumParam>();
-            param->ClearValues();
-            for (auto& c : this->columns) {
-                param->AddValue(c.Name());
-            }
-        }
+    /* (Re-) Generate the data unless it has been sorted for this state before. */
+    core::DataFingerprint fingerprint;
+    fingerprint.AddInput(src).AddFrame(src.GetFrameID()).AddParams(*this);
 
-        /* Determine the index of the reference column. */
-        {
-            auto c = this->paramColumn.Param<FlexEnumParam>()->Value();
-            for (auto& ci : this->columns) {
-                if (ci.Name() == c) {
-                    break;
-                }
-                ++column;
-            }
+    auto entry = this->sorted.Find(fingerprint);
+    if (!entry.value) {
+        SortedTable table;
+        this->sort(src, table);
+        entry = this->sorted.Insert(fingerprint, std::move(table));
+    }
 
-            if (column == this->columns.size()) {
-                Log::DefaultLog.WriteError("The column \"hs\" cannot be used for "
-                                           "sorting, because it does not exist in the source data.",
-                    c.c_str());
-            }
-        }
+    /* Persist the state of the data. */
+    this->current = entry.value;
+    this->localHash = entry.id;
+    this->frameID = frameID;
+    this->inputHash = src.DataHash();
+    this->paramColumn.ResetDirty();
+    this->paramIsDescending.ResetDirty();
+    this->paramIsStable.ResetDirty();
+
+    return true;
+}
 
-        /* Sort the index proxy. */
-        std::iota(proxy.begin(), proxy.end(), 0);
 
-        const auto isDesc = this->paramIsDescending.Param<BoolParam>()->Value();
-        auto pred = [this, column, data, isDesc](const std::size_t l, const std::size_t r) {
-            auto lhs = data[l * this->columns.size() + column];
-            auto rhs = data[r * this->columns.size() + column];
-            return isDesc ? (rhs < lhs) : (lhs < rhs);
-        };
+/*
+ * megamol::datatools::table::TableSort::sort
+ */
+void megamol::datatools::table::TableSort::sort(TableDataCall& src, SortedTable& dst) {
+    using namespace core::param;
+    using megamol::core::utility::log::Log;
 
-        if (this->paramIsStable.Param<BoolParam>()->Value()) {
-            std::stable_sort(proxy.begin(), proxy.end(), pred);
-        } else {
-            std::sort(proxy.begin(), proxy.end(), pred);
+    auto column = 0;
+    const auto data = src.GetData();
+    std::vector<std::size_t> proxy(src.GetRowsCount());
+
+    /* Copy the column descriptors. */
+    dst.columns.resize(src.GetColumnsCount());
+    std::copy(src.GetColumnsInfos(), src.GetColumnsInfos() + dst.columns.size(), dst.columns.begin());
+    const auto numColumns = dst.columns.size();
+
+    /* Update the column selector. */
+    {
+        auto param = this->paramColumn.Param<FlexEnumParam>();
+        param->ClearValues();
+        for (auto& c : dst.columns) {
+            param->AddValue(c.Name());
         }
+    }
 
-        /* Copy the data in sorted order. */
-        this->values.resize(src.GetRowsCount() * src.GetColumnsCount());
-        auto dst = this->values.data();
+    /* Determine the index of the reference column. */
+    {
+        auto c = this->paramColumn.Param<FlexEnumParam>()->Value();
+        for (auto& ci : dst.columns) {
+            if (ci.Name() == c) {
+                break;
+            }
+            ++column;
+        }
 
-        for (auto r : proxy) {
-            std::copy(data + r * this->columns.size(), data + (r + 1) * this->columns.size(), dst);
-            dst += this->columns.size();
+        if (column == numColumns) {
+            Log::DefaultLog.WriteError("The column \"hs\" cannot be used for "
+                                       "sorting, because it does not exist in the source data.",
+                c.c_str());
         }
+    }
 
-        /* Persist the state of the data. */
-        this->frameID = frameID;
-        this->inputHash = src.DataHash();
+    /* Sort the index proxy. */
+    std::iota(proxy.begin(), proxy.end(), 0);
 
-        if (isParamsChanged) {
-            ++this->localHash;
-            this->paramColumn.ResetDirty();
-            this->paramIsDescending.ResetDirty();
-            this->paramIsStable.ResetDirty();
-        }
-    } /* end if (selector || (this->inputHash != src->DataHash()) ... */
+    const auto isDesc = this->paramIsDescending.Param<BoolParam>()->Value();
+    auto pred = [numColumns, column, data, isDesc](const std::size_t l, const std::size_t r) {
+        auto lhs = data[l * numColumns + column];
+        auto rhs = data[r * numColumns + column];
+        return isDesc ? (rhs < lhs) : (lhs < rhs);
+    };
 
-    return true;
+    if (this->paramIsStable.Param<BoolParam>()->Value()) {
+        std::stable_sort(proxy.begin(), proxy.end(), pred);
+    } else {
+        std::sort(proxy.begin(), proxy.end(), pred);
+    }
+
+    /* Copy the data in sorted order. */
+    dst.values.resize(src.GetRowsCount() * src.GetColumnsCount());
+    auto out = dst.values.data();
+
+    for (auto r : proxy) {
+        std::copy(data + r * numColumns, data + (r + 1) * numColumns, out);
+        out += numColumns;
+    }
 }
 
 
@@ -152,3 +167,18 @@ bool megamol::datatools::table::TableSort::prepareData(TableDataCall& src, const
  * megamol::datatools::table::TableSort::release
  */
 void megamol::datatools::table::TableSort::release() {}
+
+
+/*
+ * megamol::datatools::table::TableSort::setOutputData
+ */
+void megamol::datatools::table::TableSort::setOutputData(TableDataCall& dst) {
+    if ((this->current == nullptr) || this->current->columns.empty()) {
+        dst.Set(0, 0, nullptr, nullptr);
+        return;
+    }
+
+    const auto& columns = this->current->columns;
+    const auto& values = this->current->values;
+    dst.Set(columns.size(), values.size() / columns.size(), columns.data(), values.data());
+}
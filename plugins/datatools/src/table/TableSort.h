@@ -9,6 +9,8 @@
 
 #include "TableProcessorBase.h"
 
+#include "mmstd/data/OutputMemoizer.h"
+
 
 namespace megamol::datatools::table {
 
@@ -62,10 +64,32 @@ protected:
 
     void release() override;
 
+    void setOutputData(TableDataCall& dst) override;
+
 private:
+    /** The sorted columns and values. */
+    struct SortedTable {
+        std::vector<ColumnInfo> columns;
+        std::vector<float> values;
+    };
+
+    /**
+     * Sorts the data of 'src'.
+     *
+     * @param src The call holding the source data.
+     * @param dst Receives the sorted table.
+     */
+    void sort(TableDataCall& src, SortedTable& dst);
+
     core::param::ParamSlot paramColumn;
     core::param::ParamSlot paramIsDescending;
     core::param::ParamSlot paramIsStable;
+
+    /** The recently sorted tables, switching back to a previous column does not sort again. */
+    core::OutputMemoizer<SortedTable> sorted;
+
+    /** The published table, shared with 'sorted' instead of being copied. */
+    std::shared_ptr<SortedTable const> current;
 };
 
 } // namespace megamol::datatools::table
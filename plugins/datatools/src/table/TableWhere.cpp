@@ -12,6 +12,7 @@
 #include <functional>
 #include <limits>
 #include <numeric>
+#include <optional>
 
 #include "mmcore/param/BoolParam.h"
 #include "mmcore/param/EnumParam.h"
@@ -111,6 +112,32 @@ bool megamol::datatools::table::TableWhere::prepareData(TableDataCall& src, cons
     using namespace core::param;
     using megamol::core::utility::log::Log;
 
+    /* Let the source skip rows that cannot match simple comparisons. */
+    {
+        const auto c = this->paramColumn.Param<FlexEnumParam>()->Value();
+        const auto e = this->paramEpsilon.Param<FloatParam>()->Value();
+        const auto r = this->paramReference.Param<FloatParam>()->Value();
+        const auto lowest = std::numeric_limits<float>::lowest();
+        const auto highest = (std::numeric_limits<float>::max)();
+        std::optional<TableDataCall::RowRangeHint> hint;
+        switch (this->paramOperator.Param<EnumParam>()->Value()) {
+        case Operator::Less:
+        case Operator::LessOrEqual:
+            hint = TableDataCall::RowRangeHint{c, lowest, r};
+            break;
+        case Operator::Equal:
+            hint = TableDataCall::RowRangeHint{c, r - std::abs(e), r + std::abs(e)};
+            break;
+        case Operator::GreaterOrEqual:
+        case Operator::Greater:
+            hint = TableDataCall::RowRangeHint{c, r, highest};
+            break;
+        default:
+            break;
+        }
+        src.SetRowRangeHint(hint);
+    }
+
     /* Request the source data. */
     src.SetFrameID(frameID);
     if (!(src) (0)) {
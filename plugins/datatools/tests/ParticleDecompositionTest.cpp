@@ -0,0 +1,163 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <numeric>
+#include <vector>
+
+#include "mpi.h"
+
+#include "ParticleDecomposition.h"
+
+#include "mmtest/Check.h"
+
+using namespace megamol::datatools::redistribution;
+
+namespace {
+
+/** Clustered particles, differently placed on every rank, so that the regions differ from the input distribution */
+std::vector<float> makeParticles(int rank, size_t count) {
+    uint32_t seed = 1234u + 77u * static_cast<uint32_t>(rank);
+    auto rnd = [&seed]() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+    };
+    std::vector<float> pos(3 * count);
+    for (size_t i = 0; i < count; ++i) {
+        bool const clustered = i % 3 != 0;
+        for (int d = 0; d < 3; ++d) {
+            float const center = 0.5f + 0.3f * static_cast<float>((rank + d) % 3);
+            pos[3 * i + d] = clustered ? center + 0.2f * (rnd() - 0.5f) : 4.0f * rnd() - 1.0f;
+        }
+    }
+    return pos;
+}
+
+/** Checks one decomposition against all particles of all ranks */
+void checkDecomposition(DecompositionType type, int rank, int size, std::vector<float> const& local,
+    std::vector<float> const& all, bounds_t const& bounds) {
+    auto dec = make_decomposition(MPI_COMM_WORLD, size, type, {local}, bounds);
+    size_t const n = all.size() / 3;
+
+    // every rank assigns the same, balanced regions
+    std::vector<int> owner(n);
+    std::vector<uint64_t> load(size, 0);
+    for (size_t i = 0; i < n; ++i) {
+        owner[i] = dec.rank_of(all.data() + 3 * i);
+        CHECK(owner[i] >= 0 && owner[i] < size);
+        ++load[owner[i]];
+    }
+    auto minOwner = owner, maxOwner = owner;
+    MPI_Allreduce(MPI_IN_PLACE, minOwner.data(), static_cast<int>(n), MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, maxOwner.data(), static_cast<int>(n), MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+    CHECK(minOwner == maxOwner);
+    CHECK(*std::max_element(load.begin(), load.end()) <= 1.25 * n / size);
+
+    // the regions of all ranks owning a particle within the ghost width are found, the owner included
+    float const width = 0.005f * (bounds[3] - bounds[0]);
+    dec.set_ghost_width(width);
+    std::vector<size_t> byX(n);
+    std::iota(byX.begin(), byX.end(), 0);
+    std::sort(byX.begin(), byX.end(), [&all](size_t l, size_t r) { return all[3 * l] < all[3 * r]; });
+
+    size_t missing = 0, ghosts = 0, ownersFound = 0;
+    std::vector<int> near;
+    for (size_t k = 0; k < n; ++k) {
+        size_t const i = byX[k];
+        float const* p = all.data() + 3 * i;
+        dec.ranks_near(p, near);
+        ownersFound += std::binary_search(near.begin(), near.end(), owner[i]);
+        ghosts += near.size() > 1;
+
+        auto check = [&](size_t j) {
+            float const* q = all.data() + 3 * j;
+            if (std::abs(p[1] - q[1]) <= width && std::abs(p[2] - q[2]) <= width &&
+                !std::binary_search(near.begin(), near.end(), owner[j])) {
+                ++missing;
+            }
+        };
+        for (size_t l = k + 1; l < n && all[3 * byX[l]] <= p[0] + width; ++l) {
+            check(byX[l]);
+        }
+        for (size_t l = k; l-- > 0 && all[3 * byX[l]] >= p[0] - width;) {
+            check(byX[l]);
+        }
+    }
+    CHECK(ownersFound == n);
+    CHECK(missing == 0);
+
+    // Morton ranges are scattered over the domain, so that their bounding boxes overlap much more than the ranges
+    std::vector<bounds_t> boxes(size, {FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX});
+    for (size_t i = 0; i < n; ++i) {
+        for (int d = 0; d < 3; ++d) {
+            boxes[owner[i]][d] = std::min(boxes[owner[i]][d], all[3 * i + d] - width);
+            boxes[owner[i]][3 + d] = std::max(boxes[owner[i]][3 + d], all[3 * i + d] + width);
+        }
+    }
+    size_t boxGhosts = 0;
+    for (size_t i = 0; i < n; ++i) {
+        float const* p = all.data() + 3 * i;
+        bool isGhost = false;
+        for (int r = 0; r < size; ++r) {
+            auto const& b = boxes[r];
+            isGhost |= r != owner[i] && p[0] >= b[0] && p[1] >= b[1] && p[2] >= b[2] && p[0] <= b[3] &&
+                       p[1] <= b[4] && p[2] <= b[5];
+        }
+        boxGhosts += isGhost;
+    }
+    if (type == DecompositionType::Morton) {
+        CHECK(2 * ghosts < boxGhosts);
+    }
+    if (rank == 0) {
+        std::printf("%s: load %llu..%llu, %.1f%% of the particles are ghosts, %.1f%% with bounding boxes\n",
+            type == DecompositionType::Morton ? "Morton" : "k-d",
+            static_cast<unsigned long long>(*std::min_element(load.begin(), load.end())),
+            static_cast<unsigned long long>(*std::max_element(load.begin(), load.end())), 100.0 * ghosts / n,
+            100.0 * boxGhosts / n);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    MPI_Init(&argc, &argv);
+    int rank = 0, size = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    auto const local = makeParticles(rank, 3000 + 500 * rank);
+
+    int const localCount = static_cast<int>(local.size());
+    std::vector<int> counts(size), displs(size, 0);
+    MPI_Allgather(&localCount, 1, MPI_INT, counts.data(), 1, MPI_INT, MPI_COMM_WORLD);
+    for (int r = 1; r < size; ++r) {
+        displs[r] = displs[r - 1] + counts[r - 1];
+    }
+    std::vector<float> all(displs[size - 1] + counts[size - 1]);
+    MPI_Allgatherv(
+        local.data(), localCount, MPI_FLOAT, all.data(), counts.data(), displs.data(), MPI_FLOAT, MPI_COMM_WORLD);
+
+    bounds_t bounds = {FLT_MAX, FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+    for (size_t i = 0; i < all.size(); i += 3) {
+        for (int d = 0; d < 3; ++d) {
+            bounds[d] = std::min(bounds[d], all[i + d]);
+            bounds[3 + d] = std::max(bounds[3 + d], all[i + d]);
+        }
+    }
+
+    checkDecomposition(DecompositionType::Morton, rank, size, local, all, bounds);
+    checkDecomposition(DecompositionType::KD, rank, size, local, all, bounds);
+
+    MPI_Allreduce(MPI_IN_PLACE, &megamol::test::failures, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Finalize();
+
+    return megamol::test::Result(rank == 0);
+}
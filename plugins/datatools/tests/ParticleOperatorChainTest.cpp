@@ -0,0 +1,250 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "geometry_calls/MultiParticleDataCall.h"
+#include "mmcore/param/EnumParam.h"
+#include "mmcore/param/FloatParam.h"
+#include "mmcore/param/ParamSlot.h"
+#include "mmcore/param/Vector3fParam.h"
+#include "mmcore/param/Vector4fParam.h"
+
+#include "IColInverse.h"
+#include "IColRangeFix.h"
+#include "ModColIRange.h"
+#include "ParticleColorChannelSelect.h"
+#include "ParticleTranslateRotateScale.h"
+
+#include "mmtest/Check.h"
+
+using namespace megamol;
+using geocalls::MultiParticleDataCall;
+using geocalls::SimpleSphericalParticles;
+
+namespace {
+
+/** Exposes the data manipulation of a module */
+template<class M>
+class Testable : public M {
+public:
+    bool Run(MultiParticleDataCall& outData, MultiParticleDataCall& inData) {
+        return this->manipulateData(outData, inData);
+    }
+};
+
+/** Synthetic particle lists covering the layouts the modules handle, each spanning several batches */
+class Source {
+public:
+    Source() {
+        uint32_t seed = 42;
+        auto rnd = [&seed](float lo, float hi) {
+            seed = seed * 1664525u + 1013904223u;
+            return lo + (hi - lo) * static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+        };
+
+        // interleaved xyzr and rgba
+        interleaved.resize(3000 * 8);
+        for (auto& v : interleaved) {
+            v = rnd(-2.0f, 3.0f);
+        }
+        // xyz and intensities in separate arrays
+        positions.resize(1500 * 3);
+        for (auto& v : positions) {
+            v = rnd(-1.0f, 1.0f);
+        }
+        intensities.resize(1500);
+        for (auto& v : intensities) {
+            v = rnd(-5.0f, 7.5f);
+        }
+        // xyz and rgb
+        rgb.resize(700 * 6);
+        for (auto& v : rgb) {
+            v = rnd(0.0f, 4.0f);
+        }
+    }
+
+    void Fill(MultiParticleDataCall& call) const {
+        call.SetParticleListCount(3);
+
+        auto& p0 = call.AccessParticles(0);
+        p0.SetCount(3000);
+        p0.SetVertexData(SimpleSphericalParticles::VERTDATA_FLOAT_XYZR, interleaved.data(), 8 * sizeof(float));
+        p0.SetColourData(SimpleSphericalParticles::COLDATA_FLOAT_RGBA, interleaved.data() + 4, 8 * sizeof(float));
+        p0.SetGlobalRadius(0.25f);
+        p0.SetColourMapIndexValues(-2.0f, 3.0f);
+
+        auto& p1 = call.AccessParticles(1);
+        p1.SetCount(1500);
+        p1.SetVertexData(SimpleSphericalParticles::VERTDATA_FLOAT_XYZ, positions.data());
+        p1.SetColourData(SimpleSphericalParticles::COLDATA_FLOAT_I, intensities.data());
+        p1.SetGlobalRadius(0.5f);
+        p1.SetColourMapIndexValues(-5.0f, 7.5f);
+
+        auto& p2 = call.AccessParticles(2);
+        p2.SetCount(700);
+        p2.SetVertexData(SimpleSphericalParticles::VERTDATA_FLOAT_XYZ, rgb.data(), 6 * sizeof(float));
+        p2.SetColourData(SimpleSphericalParticles::COLDATA_FLOAT_RGB, rgb.data() + 3, 6 * sizeof(float));
+        p2.SetGlobalRadius(0.1f);
+        p2.SetColourMapIndexValues(0.0f, 4.0f);
+
+        vislib::math::Cuboid<float> const box(-2.0f, -2.0f, -2.0f, 4.0f, 4.0f, 4.0f);
+        for (unsigned int i = 0; i < 3; ++i) {
+            call.AccessParticles(i).SetBBox(box);
+        }
+        call.AccessBoundingBoxes().SetObjectSpaceBBox(box);
+        call.AccessBoundingBoxes().SetObjectSpaceClipBox(box);
+        call.SetFrameID(0);
+        call.SetDataHash(1);
+    }
+
+private:
+    std::vector<float> interleaved;
+    std::vector<float> positions;
+    std::vector<float> intensities;
+    std::vector<float> rgb;
+};
+
+/** Modules connected one after another */
+class Pipeline {
+public:
+    template<class M>
+    M& Add() {
+        auto module = std::make_unique<Testable<M>>();
+        auto* ptr = module.get();
+        stages.emplace_back([ptr](MultiParticleDataCall& out, MultiParticleDataCall& in) { return ptr->Run(out, in); });
+        modules.push_back(std::move(module));
+        return *ptr;
+    }
+
+    /**
+     * Runs all modules, the calls between them accept deferred operators if fused
+     *
+     * @return The call holding the output of the last module
+     */
+    MultiParticleDataCall& Run(Source const& source, bool fused) {
+        calls = std::vector<MultiParticleDataCall>(stages.size() + 1);
+        source.Fill(calls[0]);
+        for (size_t i = 0; i < stages.size(); ++i) {
+            calls[i + 1].SetAcceptDeferredOperators(fused && i + 1 < stages.size());
+            CHECK(stages[i](calls[i + 1], calls[i]));
+        }
+        CHECK(!calls.back().GetDeferredOperators());
+        return calls.back();
+    }
+
+private:
+    std::vector<std::unique_ptr<core::Module>> modules;
+    std::vector<std::function<bool(MultiParticleDataCall&, MultiParticleDataCall&)>> stages;
+    std::vector<MultiParticleDataCall> calls;
+};
+
+template<class P, class V>
+void setParam(core::Module& module, const char* name, V const& value) {
+    auto slot = std::dynamic_pointer_cast<core::param::ParamSlot>(module.FindChild(name));
+    CHECK(slot != nullptr);
+    if (slot != nullptr) {
+        slot->Param<P>()->SetValue(value);
+    }
+}
+
+bool sameBox(vislib::math::Cuboid<float> const& a, vislib::math::Cuboid<float> const& b) {
+    return a.Left() == b.Left() && a.Bottom() == b.Bottom() && a.Back() == b.Back() && a.Right() == b.Right() &&
+           a.Top() == b.Top() && a.Front() == b.Front();
+}
+
+/** Checks that both calls hold bit-identical data as seen through the accessors */
+void checkIdentical(MultiParticleDataCall& direct, MultiParticleDataCall& fused) {
+    CHECK(direct.GetParticleListCount() == fused.GetParticleListCount());
+    CHECK(sameBox(direct.AccessBoundingBoxes().ObjectSpaceBBox(), fused.AccessBoundingBoxes().ObjectSpaceBBox()));
+    CHECK(sameBox(direct.AccessBoundingBoxes().ObjectSpaceClipBox(), fused.AccessBoundingBoxes().ObjectSpaceClipBox()));
+
+    for (unsigned int l = 0; l < direct.GetParticleListCount() && l < fused.GetParticleListCount(); ++l) {
+        auto& d = direct.AccessParticles(l);
+        auto& f = fused.AccessParticles(l);
+        CHECK(d.GetCount() == f.GetCount());
+        CHECK(d.GetVertexDataType() == f.GetVertexDataType());
+        CHECK(d.GetColourDataType() == f.GetColourDataType());
+        CHECK(d.GetGlobalRadius() == f.GetGlobalRadius());
+        CHECK(d.GetMinColourIndexValue() == f.GetMinColourIndexValue());
+        CHECK(d.GetMaxColourIndexValue() == f.GetMaxColourIndexValue());
+        CHECK(sameBox(d.GetBBox(), f.GetBBox()));
+        if (d.GetCount() != f.GetCount()) {
+            continue;
+        }
+
+        auto const& ds = d.GetParticleStore();
+        auto const& fs = f.GetParticleStore();
+        std::shared_ptr<geocalls::Accessor> const* dacc[] = {&ds.GetXAcc(), &ds.GetYAcc(), &ds.GetZAcc(),
+            &ds.GetRAcc(), &ds.GetCRAcc(), &ds.GetCGAcc(), &ds.GetCBAcc(), &ds.GetCAAcc()};
+        std::shared_ptr<geocalls::Accessor> const* facc[] = {&fs.GetXAcc(), &fs.GetYAcc(), &fs.GetZAcc(),
+            &fs.GetRAcc(), &fs.GetCRAcc(), &fs.GetCGAcc(), &fs.GetCBAcc(), &fs.GetCAAcc()};
+        size_t mismatches = 0;
+        for (size_t i = 0; i < d.GetCount(); ++i) {
+            for (int a = 0; a < 8; ++a) {
+                if ((*dacc[a])->Get_f(i) != (*facc[a])->Get_f(i)) {
+                    ++mismatches;
+                }
+            }
+        }
+        CHECK(mismatches == 0);
+    }
+}
+
+/** Runs the same modules directly and fused, configured by setup */
+void checkChain(Source const& source, std::function<void(Pipeline&)> const& setup) {
+    Pipeline direct;
+    Pipeline fused;
+    setup(direct);
+    setup(fused);
+    checkIdentical(direct.Run(source, false), fused.Run(source, true));
+}
+
+} // namespace
+
+int main() {
+    Source const source;
+
+    // colour operators, including a range reduction used by a later operator
+    checkChain(source, [](Pipeline& p) {
+        setParam<core::param::EnumParam>(p.Add<datatools::ParticleColorChannelSelect>(), "channel", 1);
+        p.Add<datatools::IColRangeFix>();
+        p.Add<datatools::IColInverse>();
+        setParam<core::param::FloatParam>(p.Add<datatools::ModColIRange>(), "maxVal", 1.5f);
+    });
+
+    // alpha selection leaves the RGB list alone
+    checkChain(source, [](Pipeline& p) {
+        setParam<core::param::EnumParam>(p.Add<datatools::ParticleColorChannelSelect>(), "channel", 3);
+        p.Add<datatools::IColInverse>();
+    });
+
+    // the second transformation is centred on the box of the first one's output
+    checkChain(source, [](Pipeline& p) {
+        auto& first = p.Add<datatools::ParticleTranslateRotateScale>();
+        setParam<core::param::Vector3fParam>(first, "translation", vislib::math::Vector<float, 3>(1.0f, -2.0f, 0.5f));
+        setParam<core::param::Vector3fParam>(first, "scale", vislib::math::Vector<float, 3>(2.0f, 1.0f, 0.5f));
+        p.Add<datatools::IColInverse>();
+        auto& second = p.Add<datatools::ParticleTranslateRotateScale>();
+        setParam<core::param::Vector4fParam>(
+            second, "quaternion", vislib::math::Vector<float, 4>(0.0f, 0.70710677f, 0.0f, 0.70710677f));
+        setParam<core::param::Vector3fParam>(second, "scale", vislib::math::Vector<float, 3>(0.5f, 0.5f, 0.5f));
+    });
+
+    // colour range operators behind a transformation, which writes the colours as RGBA
+    checkChain(source, [](Pipeline& p) {
+        p.Add<datatools::ParticleTranslateRotateScale>();
+        setParam<core::param::EnumParam>(p.Add<datatools::ParticleColorChannelSelect>(), "channel", 0);
+        p.Add<datatools::IColRangeFix>();
+    });
+
+    return megamol::test::Result();
+}
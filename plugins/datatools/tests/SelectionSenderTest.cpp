@@ -0,0 +1,137 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <zmq.hpp>
+
+#include "table/SelectionMessage.h"
+#include "table/SelectionReceiver.h"
+#include "table/SelectionSender.h"
+
+#include "mmtest/Check.h"
+
+using megamol::datatools::table::SelectionMessage;
+using megamol::datatools::table::SelectionReceiver;
+using megamol::datatools::table::SelectionSender;
+using namespace std::chrono_literals;
+
+namespace {
+
+/** Binds to a port chosen by the system */
+std::string bindEphemeral(SelectionReceiver& receiver) {
+    receiver.SetEndpoint("tcp://127.0.0.1:*");
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    std::string endpoint;
+    while (endpoint.empty() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(5ms);
+        endpoint = receiver.BoundEndpoint();
+    }
+    return endpoint;
+}
+
+/** Takes received selections until one matches or the time is up */
+bool waitFor(SelectionReceiver& receiver, std::vector<std::uint64_t> const& expected) {
+    auto const deadline = std::chrono::steady_clock::now() + 5s;
+    std::vector<std::uint64_t> selection;
+    bool received = false;
+    while (!(received && selection == expected) && std::chrono::steady_clock::now() < deadline) {
+        received |= receiver.TakeSelection(selection);
+        std::this_thread::sleep_for(5ms);
+    }
+    return received && selection == expected;
+}
+
+/** Checks that nothing is received for a while */
+bool receivesNothing(SelectionReceiver& receiver) {
+    std::this_thread::sleep_for(3 * SelectionReceiver::ReceiveTimeout);
+    std::vector<std::uint64_t> selection;
+    return !receiver.TakeSelection(selection);
+}
+
+} // namespace
+
+int main() {
+    // A message of a few bytes must not claim more indices than the table has rows
+    {
+        SelectionMessage message;
+        message.added = {0};
+        std::vector<std::uint8_t> buffer;
+        message.Serialize(buffer);
+        buffer.resize(buffer.size() - 3);
+        buffer.insert(buffer.end(), {1, 0, 0xff, 0xff, 0xff, 0xff, 0x07});
+        CHECK(!message.Deserialize(buffer.data(), buffer.size(), 1000));
+        message.added = {1, 2, 3, 10, 11};
+        message.Serialize(buffer);
+        CHECK(message.Deserialize(buffer.data(), buffer.size(), 5));
+        CHECK(!message.Deserialize(buffer.data(), buffer.size(), 4));
+    }
+
+    zmq::context_t context(1);
+    {
+        // The port of a receiver which is gone, for a receiver starting late
+        std::string first;
+        {
+            SelectionReceiver probe(context, "");
+            first = bindEphemeral(probe);
+        }
+        CHECK(!first.empty());
+
+        SelectionSender sender(context, first);
+
+        // Nobody listens yet, so the send fails and has to be retried without further changes
+        sender.SetSelection({5, 3, 1, 3});
+        std::this_thread::sleep_for(3 * SelectionSender::RetryInterval);
+        SelectionReceiver late(context, first);
+        late.SetMaxIndices(1000);
+        CHECK(waitFor(late, {1, 3, 5}));
+
+        // Small changes are sent as deltas against the previously sent version
+        std::vector<std::uint64_t> selection;
+        for (std::uint64_t i = 0; i < 1000; ++i) {
+            selection.push_back(3 * i);
+        }
+        for (std::uint64_t step = 0; step < 40; ++step) {
+            selection[(step * 37) % selection.size()] += 1;
+            sender.SetSelection(selection);
+            std::this_thread::sleep_for(5ms);
+        }
+        std::sort(selection.begin(), selection.end());
+        CHECK(waitFor(late, selection));
+
+        // A new endpoint receives the current selection right away, but only once the limit is known
+        SelectionReceiver other(context, "");
+        auto const second = bindEphemeral(other);
+        CHECK(!second.empty() && second != first);
+        sender.SetEndpoint(second);
+        CHECK(receivesNothing(other));
+        other.SetMaxIndices(selection.size());
+        CHECK(waitFor(other, selection));
+
+        // Selections larger than the limit are dropped, the next one fitting is received
+        std::vector<std::uint64_t> large;
+        for (std::uint64_t i = 0; i < 20; ++i) {
+            large.push_back(5 * i);
+        }
+        other.SetMaxIndices(10);
+        sender.SetSelection(large);
+        CHECK(receivesNothing(other));
+        sender.SetSelection({7, 8, 9});
+        CHECK(waitFor(other, {7, 8, 9}));
+
+        sender.Stop();
+        late.Stop();
+        other.Stop();
+    }
+    context.close();
+
+    return megamol::test::Result();
+}
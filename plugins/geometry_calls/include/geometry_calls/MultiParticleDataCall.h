@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <memory>
+
 #include "geometry_calls/AbstractParticleDataCall.h"
+#include "geometry_calls/ParticleOperatorChain.h"
 #include "geometry_calls/SimpleSphericalParticles.h"
 #include "mmcore/factories/CallAutoDescription.h"
 
@@ -49,6 +52,50 @@ public:
      * @return A reference to this
      */
     MultiParticleDataCall& operator=(const MultiParticleDataCall& rhs);
+
+    /**
+     * Answer whether the caller can take deferred particle operators instead of materialized data.
+     *
+     * @return True if the callee may answer with a chain of deferred operators
+     */
+    inline bool AcceptsDeferredOperators() const {
+        return this->acceptDeferred;
+    }
+
+    /**
+     * Sets whether the caller can take deferred particle operators. Set by the caller before each request.
+     *
+     * @param accept The flag
+     */
+    inline void SetAcceptDeferredOperators(bool accept) {
+        this->acceptDeferred = accept;
+    }
+
+    /**
+     * Answer the chain of operators still to be applied to the particle lists of this call.
+     *
+     * @return The chain, or nullptr if the lists already hold the final data
+     */
+    inline std::shared_ptr<ParticleOperatorChain const> const& GetDeferredOperators() const {
+        return this->deferredOps;
+    }
+
+    /**
+     * Sets the chain of operators still to be applied to the particle lists. Only allowed if the caller accepts
+     * deferred operators.
+     *
+     * @param ops The chain, or nullptr if the lists hold the final data
+     */
+    inline void SetDeferredOperators(std::shared_ptr<ParticleOperatorChain const> ops) {
+        this->deferredOps = std::move(ops);
+    }
+
+private:
+    /** Flag whether the caller accepts deferred operators, not copied by the assignment operator */
+    bool acceptDeferred;
+
+    /** Operators deferred by the callee, not copied by the assignment operator */
+    std::shared_ptr<ParticleOperatorChain const> deferredOps;
 };
 
 
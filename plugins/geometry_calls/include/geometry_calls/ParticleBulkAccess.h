@@ -0,0 +1,231 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "Accessor.h"
+#include "SimpleSphericalParticles.h"
+
+namespace megamol::geocalls {
+
+/**
+ * Typed view of a strided particle attribute with N consecutive components of type T per particle.
+ */
+template<class T, unsigned int N>
+struct StridedSpan {
+    using value_type = T;
+    static constexpr unsigned int components = N;
+
+    char const* ptr = nullptr;
+    size_t stride = 0;
+    size_t count = 0;
+
+    /** Answer the first component of particle idx */
+    T const* operator[](size_t const idx) const {
+        return access<T>(ptr, idx, stride);
+    }
+
+    /** True if the components of consecutive particles are packed without gaps */
+    bool IsPacked() const {
+        return stride == N * sizeof(T);
+    }
+};
+
+/**
+ * Placeholder for an attribute that is not present in the particle list.
+ */
+struct EmptySpan {
+    static constexpr unsigned int components = 0;
+
+    size_t count = 0;
+};
+
+/**
+ * Calls kernel once with a concrete StridedSpan of the vertex data of the list, or an EmptySpan for VERTDATA_NONE.
+ * The kernel is instantiated for every vertex type, so the per-particle loop inside it runs without any dispatch.
+ *
+ * @param p The particle list
+ * @param kernel Generic callable taking the span
+ *
+ * @return The result of the kernel
+ */
+template<class Kernel>
+decltype(auto) VisitVertexData(SimpleSphericalParticles const& p, Kernel&& kernel) {
+    auto const t = p.GetVertexDataType();
+    auto const ptr = reinterpret_cast<char const*>(p.GetVertexData());
+    size_t const s =
+        p.GetVertexDataStride() == 0 ? SimpleSphericalParticles::VertexDataSize[t] : p.GetVertexDataStride();
+    size_t const cnt = p.GetCount();
+    switch (t) {
+    case SimpleSphericalParticles::VERTDATA_FLOAT_XYZ:
+        return kernel(StridedSpan<float, 3>{ptr, s, cnt});
+    case SimpleSphericalParticles::VERTDATA_FLOAT_XYZR:
+        return kernel(StridedSpan<float, 4>{ptr, s, cnt});
+    case SimpleSphericalParticles::VERTDATA_SHORT_XYZ:
+        return kernel(StridedSpan<unsigned short, 3>{ptr, s, cnt});
+    case SimpleSphericalParticles::VERTDATA_DOUBLE_XYZ:
+        return kernel(StridedSpan<double, 3>{ptr, s, cnt});
+    case SimpleSphericalParticles::VERTDATA_NONE:
+    default:
+        return kernel(EmptySpan{cnt});
+    }
+}
+
+/**
+ * Calls kernel once with a concrete StridedSpan of the colour data of the list, or an EmptySpan for COLDATA_NONE.
+ *
+ * @param p The particle list
+ * @param kernel Generic callable taking the span
+ *
+ * @return The result of the kernel
+ */
+template<class Kernel>
+decltype(auto) VisitColourData(SimpleSphericalParticles const& p, Kernel&& kernel) {
+    auto const t = p.GetColourDataType();
+    auto const ptr = reinterpret_cast<char const*>(p.GetColourData());
+    size_t const s =
+        p.GetColourDataStride() == 0 ? SimpleSphericalParticles::ColorDataSize[t] : p.GetColourDataStride();
+    size_t const cnt = p.GetCount();
+    switch (t) {
+    case SimpleSphericalParticles::COLDATA_UINT8_RGB:
+        return kernel(StridedSpan<unsigned char, 3>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_UINT8_RGBA:
+        return kernel(StridedSpan<unsigned char, 4>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_FLOAT_RGB:
+        return kernel(StridedSpan<float, 3>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_FLOAT_RGBA:
+        return kernel(StridedSpan<float, 4>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_FLOAT_I:
+        return kernel(StridedSpan<float, 1>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_USHORT_RGBA:
+        return kernel(StridedSpan<unsigned short, 4>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_DOUBLE_I:
+        return kernel(StridedSpan<double, 1>{ptr, s, cnt});
+    case SimpleSphericalParticles::COLDATA_NONE:
+    default:
+        return kernel(EmptySpan{cnt});
+    }
+}
+
+/** Suggested number of particles per batch for the Unpack functions, fits the SoA buffers into L1/L2 */
+constexpr size_t ParticleBatchSize = 1024;
+
+/**
+ * Converts component c of particles [first, first + count) of a span to float.
+ * Packed spans use a constant stride, which lets the compiler vectorize the conversion.
+ */
+template<class T, unsigned int N>
+void UnpackComponent(StridedSpan<T, N> const& span, size_t const first, size_t const count, unsigned int const c,
+    float* __restrict dst) {
+    if (span.IsPacked()) {
+        T const* src = reinterpret_cast<T const*>(span.ptr) + first * N + c;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<float>(src[i * N]);
+        }
+    } else {
+        char const* src = span.ptr + first * span.stride + c * sizeof(T);
+        size_t const stride = span.stride;
+        for (size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<float>(*reinterpret_cast<T const*>(src + i * stride));
+        }
+    }
+}
+
+/**
+ * Unpacks the positions of particles [first, first + count) into caller-provided structure-of-arrays buffers.
+ * Values are identical to those of the x, y, z and r accessors of the particle store.
+ *
+ * @param p The particle list
+ * @param first Index of the first particle
+ * @param count Number of particles, the buffers must hold at least that many floats
+ * @param x Receives the x coordinates
+ * @param y Receives the y coordinates
+ * @param z Receives the z coordinates
+ * @param r Receives the radii (global radius if the list has none), may be nullptr
+ */
+inline void UnpackPositions(SimpleSphericalParticles const& p, size_t const first, size_t const count, float* x,
+    float* y, float* z, float* r = nullptr) {
+    VisitVertexData(p, [&](auto const& span) {
+        using span_t = std::decay_t<decltype(span)>;
+        if constexpr (span_t::components == 0) {
+            for (size_t i = 0; i < count; ++i) {
+                x[i] = y[i] = z[i] = 0.0f;
+            }
+        } else {
+            UnpackComponent(span, first, count, 0, x);
+            UnpackComponent(span, first, count, 1, y);
+            UnpackComponent(span, first, count, 2, z);
+        }
+        if (r != nullptr) {
+            if constexpr (span_t::components == 4) {
+                UnpackComponent(span, first, count, 3, r);
+            } else {
+                float const rad = p.GetGlobalRadius();
+                for (size_t i = 0; i < count; ++i) {
+                    r[i] = rad;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * Unpacks the colours of particles [first, first + count) into caller-provided structure-of-arrays buffers.
+ * Values are identical to those of the colour accessors of the particle store, i.e. integer channels are not
+ * normalized, intensities end up in r, and lists without colour data report the normalized global colour.
+ *
+ * @param p The particle list
+ * @param first Index of the first particle
+ * @param count Number of particles, the buffers must hold at least that many floats
+ * @param r Receives the red channel or the intensity
+ * @param g Receives the green channel, may be nullptr
+ * @param b Receives the blue channel, may be nullptr
+ * @param a Receives the alpha channel, may be nullptr
+ */
+inline void UnpackColours(SimpleSphericalParticles const& p, size_t const first, size_t const count, float* r,
+    float* g = nullptr, float* b = nullptr, float* a = nullptr) {
+    auto fill = [count](float* dst, float const val) {
+        if (dst != nullptr) {
+            for (size_t i = 0; i < count; ++i) {
+                dst[i] = val;
+            }
+        }
+    };
+    VisitColourData(p, [&](auto const& span) {
+        using span_t = std::decay_t<decltype(span)>;
+        if constexpr (span_t::components == 0) {
+            auto const col = p.GetGlobalColour();
+            fill(r, static_cast<float>(col[0]) / 255.0f);
+            fill(g, static_cast<float>(col[1]) / 255.0f);
+            fill(b, static_cast<float>(col[2]) / 255.0f);
+            fill(a, static_cast<float>(col[3]) / 255.0f);
+        } else if constexpr (span_t::components == 1) {
+            UnpackComponent(span, first, count, 0, r);
+            fill(g, 0.0f);
+            fill(b, 0.0f);
+            fill(a, 0.0f);
+        } else {
+            UnpackComponent(span, first, count, 0, r);
+            if (g != nullptr)
+                UnpackComponent(span, first, count, 1, g);
+            if (b != nullptr)
+                UnpackComponent(span, first, count, 2, b);
+            if constexpr (span_t::components == 4) {
+                if (a != nullptr)
+                    UnpackComponent(span, first, count, 3, a);
+            } else {
+                // matches the accessors: 255 for uint8 RGB, 1 for float RGB
+                fill(a, std::is_same_v<typename span_t::value_type, unsigned char> ? 255.0f : 1.0f);
+            }
+        }
+    });
+}
+
+} // namespace megamol::geocalls
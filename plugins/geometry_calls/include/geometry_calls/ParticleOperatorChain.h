@@ -0,0 +1,165 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "geometry_calls/SimpleSphericalParticles.h"
+#include "vislib/math/Cuboid.h"
+
+namespace megamol::geocalls {
+
+class MultiParticleDataCall;
+
+/**
+ * Structure-of-arrays batch of particles an operator works on in place.
+ * The values are those of the particle store accessors, i.e. intensities are stored in cr and integer colour channels
+ * are not normalized.
+ */
+struct ParticleBatch {
+    size_t first = 0;
+    size_t count = 0;
+    float* x = nullptr;
+    float* y = nullptr;
+    float* z = nullptr;
+    float* r = nullptr;
+    float* cr = nullptr;
+    float* cg = nullptr;
+    float* cb = nullptr;
+    float* ca = nullptr;
+};
+
+/**
+ * Per-list attributes besides the particle values, as seen by the operators of a chain.
+ */
+struct ParticleListState {
+    /**
+     * Data types of the list. Operators changing a type have the attribute written in it, which is only possible for
+     * the float types.
+     */
+    SimpleSphericalParticles::VertexDataType vertexType = SimpleSphericalParticles::VERTDATA_NONE;
+    SimpleSphericalParticles::ColourDataType colourType = SimpleSphericalParticles::COLDATA_NONE;
+
+    uint64_t count = 0;
+    float globalRadius = 0.5f;
+    float minColI = 0.0f;
+    float maxColI = 1.0f;
+
+    /** Object space bounding box of the whole call, the same for all lists */
+    vislib::math::Cuboid<float> bbox;
+};
+
+/**
+ * Point-wise particle operation that can be fused with others into one pass over the data.
+ * Operators are immutable once created, all parameters are captured at construction.
+ */
+class ParticleOperator {
+public:
+    enum Attribute : unsigned int { ATTR_NONE = 0, ATTR_POSITION = 1u << 0, ATTR_COLOUR = 1u << 1 };
+
+    virtual ~ParticleOperator() = default;
+
+    /** Answer the attributes (combination of Attribute) written by Apply */
+    virtual unsigned int Writes() const = 0;
+
+    /**
+     * Turns the states of the operator's input lists into the states of its output lists.
+     * Called for all lists at once, which allows for global ranges.
+     */
+    virtual void Configure(std::vector<ParticleListState>& states) const {}
+
+    /**
+     * Applies the operator to a batch in place.
+     *
+     * @param batch The batch
+     * @param in The state of the list before the operator
+     * @param out The state of the list after the operator
+     */
+    virtual void Apply(ParticleBatch& batch, ParticleListState const& in, ParticleListState const& out) const = 0;
+
+    /** True if Configure or Apply depend on the colour map range of their input */
+    virtual bool UsesColourRange() const {
+        return false;
+    }
+
+    /** True if Configure or Apply depend on the bounding box of their input */
+    virtual bool UsesBBox() const {
+        return false;
+    }
+
+    /** True if the operator sets the colour map range from the intensities it outputs, see SetReducedRange */
+    virtual bool ReducesColourRange() const {
+        return false;
+    }
+
+    /**
+     * Receives the per-list [min, max] of the colour values (intensities or red channel) written by the operator,
+     * once the pass is done. Lists without particles report min > max.
+     *
+     * @param in The states of the lists before the operator
+     * @param out The states of the lists after the operator, receive the ranges
+     * @param ranges The ranges per list
+     */
+    virtual void SetReducedRange(std::vector<ParticleListState> const& in, std::vector<ParticleListState>& out,
+        std::vector<std::array<float, 2>> const& ranges) const {}
+
+    /**
+     * Conservatively transforms a bounding box of the operator's input positions, used while the operator is deferred.
+     */
+    virtual void TransformBBox(vislib::math::Cuboid<float>& box) const {}
+};
+
+/**
+ * Immutable sequence of particle operators deferred by point-wise manipulators.
+ * Whoever cannot defer any further materializes the chain, which costs one pass over the data unless an operator
+ * needs a colour range or bounding box that an earlier operator only knows after its pass. The result is the same as
+ * running the manipulators one after another.
+ */
+class ParticleOperatorChain {
+public:
+    ParticleOperatorChain() = default;
+
+    /**
+     * Creates an empty chain
+     *
+     * @param bbox The object space bounding box of the data the chain gets deferred on, before any operator
+     */
+    explicit ParticleOperatorChain(vislib::math::Cuboid<float> const& bbox) : bbox(bbox) {}
+
+    /** Answer a new chain with op appended */
+    std::shared_ptr<ParticleOperatorChain const> Append(std::shared_ptr<ParticleOperator const> op) const;
+
+    bool Empty() const {
+        return ops.empty();
+    }
+
+    size_t Size() const {
+        return ops.size();
+    }
+
+    /**
+     * Applies the chain to all particle lists of the call.
+     * Modified attributes are written to buffers, the lists are pointed to them. Untouched attributes, directions
+     * and ids keep pointing to the original data.
+     *
+     * @param data The call holding the lists the chain has been deferred on
+     * @param buffers Receives the output data, has to stay alive as long as the call's data is used
+     */
+    void Materialize(MultiParticleDataCall& data, std::vector<std::vector<float>>& buffers) const;
+
+private:
+    std::vector<std::shared_ptr<ParticleOperator const>> ops;
+
+    /** The bounding box of the data the first operator gets applied to */
+    vislib::math::Cuboid<float> bbox;
+};
+
+} // namespace megamol::geocalls
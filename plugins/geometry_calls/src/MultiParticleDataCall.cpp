@@ -14,7 +14,10 @@ namespace megamol::geocalls {
 /*
  * MultiParticleDataCall::MultiParticleDataCall
  */
-MultiParticleDataCall::MultiParticleDataCall() : AbstractParticleDataCall<SimpleSphericalParticles>() {
+MultiParticleDataCall::MultiParticleDataCall()
+        : AbstractParticleDataCall<SimpleSphericalParticles>()
+        , acceptDeferred(false)
+        , deferredOps() {
     // Intentionally empty
 }
 
@@ -0,0 +1,300 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "geometry_calls/ParticleOperatorChain.h"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "geometry_calls/MultiParticleDataCall.h"
+#include "geometry_calls/ParticleBulkAccess.h"
+
+namespace megamol::geocalls {
+
+namespace {
+
+ParticleListState initial_state(SimpleSphericalParticles const& p, vislib::math::Cuboid<float> const& bbox) {
+    ParticleListState s;
+    s.vertexType = p.GetVertexDataType();
+    s.colourType = p.GetColourDataType();
+    s.count = p.GetCount();
+    s.globalRadius = p.GetGlobalRadius();
+    s.minColI = p.GetMinColourIndexValue();
+    s.maxColI = p.GetMaxColourIndexValue();
+    s.bbox = bbox;
+    return s;
+}
+
+/** Answer the floats per particle written for positions of the given type, 0 if it cannot be written */
+unsigned int position_floats(SimpleSphericalParticles::VertexDataType const t) {
+    switch (t) {
+    case SimpleSphericalParticles::VERTDATA_FLOAT_XYZ:
+        return 3;
+    case SimpleSphericalParticles::VERTDATA_FLOAT_XYZR:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+/** Answer the floats per particle written for colours of the given type, 0 if it cannot be written */
+unsigned int colour_floats(SimpleSphericalParticles::ColourDataType const t) {
+    switch (t) {
+    case SimpleSphericalParticles::COLDATA_FLOAT_I:
+        return 1;
+    case SimpleSphericalParticles::COLDATA_FLOAT_RGB:
+        return 3;
+    case SimpleSphericalParticles::COLDATA_FLOAT_RGBA:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+using Range = std::array<float, 2>;
+
+constexpr Range empty_range = {FLT_MAX, -FLT_MAX};
+
+/** Operators [begin, end) of the chain running in one pass */
+struct Segment {
+    size_t begin;
+    size_t end;
+};
+
+} // namespace
+
+
+/*
+ * ParticleOperatorChain::Append
+ */
+std::shared_ptr<ParticleOperatorChain const> ParticleOperatorChain::Append(
+    std::shared_ptr<ParticleOperator const> op) const {
+    auto chain = std::make_shared<ParticleOperatorChain>(*this);
+    chain->ops.push_back(std::move(op));
+    return chain;
+}
+
+
+/*
+ * ParticleOperatorChain::Materialize
+ */
+void ParticleOperatorChain::Materialize(MultiParticleDataCall& data, std::vector<std::vector<float>>& buffers) const {
+    unsigned int const plc = data.GetParticleListCount();
+    if (this->ops.empty() || plc == 0) {
+        return;
+    }
+
+    // an operator depending on the colour range or bounding box cannot run in the pass of an operator changing it
+    std::vector<Segment> segments;
+    Segment seg{0, 0};
+    bool reduced = false;
+    bool moved = false;
+    for (size_t k = 0; k < this->ops.size(); ++k) {
+        if ((this->ops[k]->UsesColourRange() && reduced) || (this->ops[k]->UsesBBox() && moved)) {
+            seg.end = k;
+            segments.push_back(seg);
+            seg.begin = k;
+            reduced = false;
+            moved = false;
+        }
+        reduced = reduced || this->ops[k]->ReducesColourRange();
+        moved = moved || (this->ops[k]->Writes() & ParticleOperator::ATTR_POSITION) != 0;
+    }
+    seg.end = this->ops.size();
+    segments.push_back(seg);
+
+    buffers.resize(segments.size() > 1 ? 2 * plc : plc);
+
+    std::vector<ParticleListState> states(plc);
+    for (unsigned int li = 0; li < plc; ++li) {
+        // the boxes of the call have been transformed conservatively by the deferred operators
+        states[li] = initial_state(data.AccessParticles(li), this->bbox);
+    }
+
+    bool globalBoxValid = false;
+    vislib::math::Cuboid<float> globalBox;
+    unsigned int writes = ParticleOperator::ATTR_NONE;
+
+    for (size_t si = 0; si < segments.size(); ++si) {
+        auto const& sg = segments[si];
+        size_t const num_ops = sg.end - sg.begin;
+
+        // stage[k] holds the list states in front of operator begin + k
+        std::vector<std::vector<ParticleListState>> stage(num_ops + 1);
+        stage[0] = states;
+        for (size_t k = 0; k < num_ops; ++k) {
+            stage[k + 1] = stage[k];
+            this->ops[sg.begin + k]->Configure(stage[k + 1]);
+            writes |= this->ops[sg.begin + k]->Writes();
+        }
+        auto const& final_states = stage[num_ops];
+
+        // attributes written by earlier segments point into the other buffer and are carried over
+        bool const write_pos = (writes & ParticleOperator::ATTR_POSITION) != 0;
+        bool const write_col = (writes & ParticleOperator::ATTR_COLOUR) != 0;
+        bool reduces = false;
+        for (size_t k = sg.begin; k < sg.end; ++k) {
+            reduces = reduces || this->ops[k]->ReducesColourRange();
+        }
+
+        std::vector<std::vector<Range>> ranges(num_ops, std::vector<Range>(plc, empty_range));
+        std::vector<std::array<float, 3>> lo(plc, std::array<float, 3>{FLT_MAX, FLT_MAX, FLT_MAX});
+        std::vector<std::array<float, 3>> hi(plc, std::array<float, 3>{-FLT_MAX, -FLT_MAX, -FLT_MAX});
+
+        for (unsigned int li = 0; li < plc; ++li) {
+            auto& p = data.AccessParticles(li);
+            auto const& fs = final_states[li];
+            size_t const cnt = p.GetCount();
+
+            unsigned int const pos_floats = write_pos ? position_floats(fs.vertexType) : 0;
+            unsigned int const col_floats = write_col ? colour_floats(fs.colourType) : 0;
+            unsigned int const stride = pos_floats + col_floats;
+            if (stride == 0 && !reduces) {
+                continue;
+            }
+
+            auto& buf = buffers[(si % 2) * plc + li];
+            buf.resize(cnt * stride);
+            float* const out = cnt * stride > 0 ? buf.data() : nullptr; // nullptr if the pass only reduces
+            auto const num_batches = static_cast<int64_t>((cnt + ParticleBatchSize - 1) / ParticleBatchSize);
+
+#pragma omp parallel
+            {
+                std::array<std::array<float, ParticleBatchSize>, 8> soa;
+                std::vector<Range> l_ranges(num_ops, empty_range);
+                std::array<float, 3> l_lo = lo[li];
+                std::array<float, 3> l_hi = hi[li];
+
+#pragma omp for
+                for (int64_t b = 0; b < num_batches; ++b) {
+                    ParticleBatch batch;
+                    batch.first = b * ParticleBatchSize;
+                    batch.count = std::min(ParticleBatchSize, cnt - batch.first);
+                    batch.x = soa[0].data();
+                    batch.y = soa[1].data();
+                    batch.z = soa[2].data();
+                    batch.r = soa[3].data();
+                    batch.cr = soa[4].data();
+                    batch.cg = soa[5].data();
+                    batch.cb = soa[6].data();
+                    batch.ca = soa[7].data();
+                    size_t const n = batch.count;
+
+                    UnpackPositions(p, batch.first, n, batch.x, batch.y, batch.z, batch.r);
+                    UnpackColours(p, batch.first, n, batch.cr, batch.cg, batch.cb, batch.ca);
+
+                    for (size_t k = 0; k < num_ops; ++k) {
+                        auto const& op = this->ops[sg.begin + k];
+                        op->Apply(batch, stage[k][li], stage[k + 1][li]);
+                        if (op->ReducesColourRange() &&
+                            stage[k + 1][li].colourType != SimpleSphericalParticles::COLDATA_NONE) {
+                            auto& rng = l_ranges[k];
+                            for (size_t i = 0; i < n; ++i) {
+                                rng[0] = std::min(rng[0], batch.cr[i]);
+                                rng[1] = std::max(rng[1], batch.cr[i]);
+                            }
+                        }
+                    }
+
+                    if (out == nullptr) {
+                        continue;
+                    }
+                    float* dst = out + batch.first * stride;
+                    if (pos_floats > 0) {
+                        for (size_t i = 0; i < n; ++i) {
+                            dst[i * stride + 0] = batch.x[i];
+                            dst[i * stride + 1] = batch.y[i];
+                            dst[i * stride + 2] = batch.z[i];
+                            l_lo[0] = std::min(l_lo[0], batch.x[i]);
+                            l_lo[1] = std::min(l_lo[1], batch.y[i]);
+                            l_lo[2] = std::min(l_lo[2], batch.z[i]);
+                            l_hi[0] = std::max(l_hi[0], batch.x[i]);
+                            l_hi[1] = std::max(l_hi[1], batch.y[i]);
+                            l_hi[2] = std::max(l_hi[2], batch.z[i]);
+                        }
+                        if (pos_floats == 4) {
+                            for (size_t i = 0; i < n; ++i) {
+                                dst[i * stride + 3] = batch.r[i];
+                            }
+                        }
+                        dst += pos_floats;
+                    }
+                    if (col_floats > 0) {
+                        float const* const channels[4] = {batch.cr, batch.cg, batch.cb, batch.ca};
+                        for (size_t i = 0; i < n; ++i) {
+                            for (unsigned int c = 0; c < col_floats; ++c) {
+                                dst[i * stride + c] = channels[c][i];
+                            }
+                        }
+                    }
+                }
+
+#pragma omp critical
+                {
+                    for (size_t k = 0; k < num_ops; ++k) {
+                        ranges[k][li][0] = std::min(ranges[k][li][0], l_ranges[k][0]);
+                        ranges[k][li][1] = std::max(ranges[k][li][1], l_ranges[k][1]);
+                    }
+                    for (int d = 0; d < 3; ++d) {
+                        lo[li][d] = std::min(lo[li][d], l_lo[d]);
+                        hi[li][d] = std::max(hi[li][d], l_hi[d]);
+                    }
+                }
+            }
+
+            if (pos_floats > 0 && out != nullptr) {
+                p.SetVertexData(fs.vertexType, out, stride * sizeof(float));
+            }
+            if (col_floats > 0) {
+                p.SetColourData(fs.colourType, out != nullptr ? out + pos_floats : nullptr, stride * sizeof(float));
+            }
+        }
+
+        // hand the reduced ranges to their operators and let the following ones see them
+        for (size_t k = 0; k < num_ops; ++k) {
+            if (!this->ops[sg.begin + k]->ReducesColourRange()) {
+                continue;
+            }
+            this->ops[sg.begin + k]->SetReducedRange(stage[k], stage[k + 1], ranges[k]);
+            for (size_t j = k + 1; j < num_ops; ++j) {
+                stage[j + 1] = stage[j];
+                this->ops[sg.begin + j]->Configure(stage[j + 1]);
+            }
+        }
+        states = stage[num_ops];
+
+        globalBoxValid = false;
+        for (unsigned int li = 0; li < plc; ++li) {
+            auto& p = data.AccessParticles(li);
+            p.SetGlobalRadius(states[li].globalRadius);
+            p.SetColourMapIndexValues(states[li].minColI, states[li].maxColI);
+            if (write_pos && lo[li][0] <= hi[li][0]) {
+                vislib::math::Cuboid<float> box(lo[li][0], lo[li][1], lo[li][2], hi[li][0], hi[li][1], hi[li][2]);
+                p.SetBBox(box);
+                if (globalBoxValid) {
+                    globalBox.Union(box);
+                } else {
+                    globalBox = box;
+                    globalBoxValid = true;
+                }
+            }
+        }
+
+        // the following segments see the box of the moved particles
+        if (globalBoxValid) {
+            for (auto& s : states) {
+                s.bbox = globalBox;
+            }
+        }
+    }
+
+    if (globalBoxValid) {
+        data.AccessBoundingBoxes().SetObjectSpaceBBox(globalBox);
+        data.AccessBoundingBoxes().SetObjectSpaceClipBox(globalBox);
+    }
+}
+
+} // namespace megamol::geocalls
@@ -65,6 +65,13 @@ public:
     bool isValid() const;
     bool isFailed() const;
 
+    /**
+     * Cancels the computation of the image if it has not been started yet.
+     *
+     * @return true if the image has been cancelled and will never become available through this object
+     */
+    bool cancel() const;
+
     const ImageMetadata& getMetadata() const;
     std::size_t getByteSize() const;
     Hash getHash() const;
@@ -119,6 +126,11 @@ inline bool AsyncImageData2D<BitmapImageT>::isFailed() const {
     return isFinished() && !imageData;
 }
 
+template<class BitmapImageT>
+inline bool AsyncImageData2D<BitmapImageT>::cancel() const {
+    return job.isPending() && !job.isInProgress() && job.cancel();
+}
+
 template<class BitmapImageT>
 inline const ImageMetadata& AsyncImageData2D<BitmapImageT>::getMetadata() const {
     return metadata;
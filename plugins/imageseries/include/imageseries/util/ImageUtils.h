@@ -65,7 +65,7 @@ template<typename T>
 Hash computeHash(const std::vector<T>& vec) {
     Hash result = 1;
     for (const auto& entry : vec) {
-        combineHash(result, computeHash(entry));
+        result = combineHash(result, computeHash(entry));
     }
     return result;
 }
@@ -6,10 +6,13 @@
 
 #pragma once
 
+#include "FilterResultCache.h"
 #include "imageseries/AsyncImageData2D.h"
 
 #include <functional>
 #include <memory>
+#include <type_traits>
+#include <typeinfo>
 
 namespace megamol::ImageSeries::filter {
 
@@ -18,6 +21,10 @@ namespace megamol::ImageSeries::filter {
  *
  * Inputs and outputs are provided via async image objects.
  * The filter itself may also perform its work on a separate thread.
+ *
+ * Results are looked up in the shared FilterResultCache by filter type and metadata hash before any work is
+ * scheduled, so identical filters on identical inputs are computed only once. Filters can opt out by providing
+ * a member function "bool isCacheable() const", e.g. if running them has side effects.
  */
 template<typename AsyncImageData = AsyncImageData2D<>>
 class AsyncFilterRunner {
@@ -28,11 +35,53 @@ public:
     template<typename Filter, typename... Args>
     std::shared_ptr<const AsyncImageData> run(Args&&... args) {
         std::shared_ptr<Filter> filter = std::make_shared<Filter>(std::forward<Args>(args)...);
-        return runFunction([filter]() { return (*filter)(); }, filter->getMetadata());
+        ImageMetadata metadata = filter->getMetadata();
+
+        auto schedule = [this, &filter, &metadata]() {
+            return runFunction([filter]() { return (*filter)(); }, metadata);
+        };
+
+        if (!isCacheable(*filter, metadata)) {
+            return schedule();
+        }
+        return FilterResultCache::getSharedInstance().findOrCreate<AsyncImageData>(
+            getCacheKey<Filter>(metadata), schedule);
     }
 
     std::shared_ptr<const AsyncImageData> runFunction(
         std::function<std::shared_ptr<const typename AsyncImageData::BitmapImage>()> filter, ImageMetadata metadata);
+
+private:
+    template<typename Filter, typename = void>
+    struct HasCachePolicy : std::false_type {};
+
+    template<typename Filter>
+    struct HasCachePolicy<Filter, std::void_t<decltype(std::declval<const Filter&>().isCacheable())>>
+            : std::true_type {};
+
+    template<typename Filter>
+    static bool isCacheable(const Filter& filter, const ImageMetadata& metadata) {
+        // A hash of 0 denotes missing inputs
+        if (metadata.hash == 0) {
+            return false;
+        }
+        if constexpr (HasCachePolicy<Filter>::value) {
+            return filter.isCacheable();
+        } else {
+            return true;
+        }
+    }
+
+    /**
+     * The metadata hash only covers the inputs of a filter. The result also depends on the filter type, and the
+     * metadata passed through from the inputs is part of the result.
+     */
+    template<typename Filter>
+    static util::Hash getCacheKey(const ImageMetadata& metadata) {
+        return util::computeHash(typeid(Filter).hash_code(), typeid(AsyncImageData).hash_code(), metadata.hash,
+            static_cast<int>(metadata.mode), metadata.index, metadata.imageCount, metadata.width, metadata.height,
+            metadata.channels, metadata.bytesPerChannel, metadata.filename);
+    }
 };
 
 template<typename AsyncImageData>
@@ -6,9 +6,11 @@
 
 #include "BlobLabelFilter.h"
 
+#include "../util/ConnectedComponents.h"
+
 #include "vislib/graphics/BitmapImage.h"
 
-#include <deque>
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -77,13 +79,6 @@ BlobLabelFilter::ImagePtr BlobLabelFilter::operator()() {
     Label nextLabel = LabelFirst;
     Label labelLimit = LabelFirst + input.blobCountLimit - 1;
 
-    std::vector<Index> pendingPixels;
-    std::vector<Index> pendingFlow;
-    std::deque<Index> queue;
-
-    // Reserve enough space to perform first pass
-    pendingPixels.reserve(input.minBlobSize + 4);
-
     auto testPixel = [&](Index index) {
         return dataOut[index] == LabelBackground && (dataIn[index] < threshold) != input.negateThreshold;
     };
@@ -91,122 +86,121 @@ BlobLabelFilter::ImagePtr BlobLabelFilter::operator()() {
     auto testPrev = [&](Index index) { return prevIn && (prevIn[index] < threshold) != input.negateThreshold; };
     auto testDiff = [&](Index index) { return diffIn && (diffIn[index] < threshold) != input.negateThreshold; };
 
-    auto markMinimal = [&](Index index) {
-        if (testPixel(index)) {
-            if (testDiff(index)) {
-                pendingFlow.push_back(index);
-            } else {
-                dataOut[index] = LabelMinimal;
-                pendingPixels.push_back(index);
-            }
+    // Find blobs of active pixels that have not been active in the previous frame
+    std::vector<Index> components;
+    const Index componentCount = util::ConnectedComponents::label(
+        width, height, util::ConnectedComponents::Connectivity::Four,
+        [&](Index index) { return testPixel(index) && !testPrev(index); }, [](Index, Index) { return true; },
+        components);
+
+    auto forEachNeighbor = [width, size](Index index, auto&& func) {
+        // Pixel is not on the right boundary
+        if (index % width < width - 1) {
+            func(index + 1);
+        }
+        // Pixel is not on the left boundary
+        if (index % width > 0) {
+            func(index - 1);
+        }
+        // Pixel is not on the bottom boundary
+        if (index < size - width) {
+            func(index + width);
+        }
+        // Pixel is not on the top boundary
+        if (index >= width) {
+            func(index - width);
         }
     };
 
-    auto fillMinimal = [&](Index startIndex) {
-        pendingPixels.clear();
-        pendingFlow.clear();
-        markMinimal(startIndex);
-        Index queueIndex = 0;
+    const bool parallel = size >= util::kernels::ParallelPixelThreshold;
 
-        // Try to collect at least MinBlobSize connected pixels
-        while (queueIndex < pendingPixels.size()) {
-            Index index = pendingPixels[queueIndex++];
+    // Count blob pixels and collect the pixels of the difference frame touching a blob, once per adjacent side
+    struct Contact {
+        Index component;
+        Index pixel;
 
-            // Pixel is not on the right boundary
-            if (index % width < width - 1) {
-                markMinimal(index + 1);
-            }
-            // Pixel is not on the left boundary
-            if (index % width > 0) {
-                markMinimal(index - 1);
-            }
-            // Pixel is not on the bottom boundary
-            if (index < size - width) {
-                markMinimal(index + width);
-            }
-            // Pixel is not on the top boundary
-            if (index >= width) {
-                markMinimal(index - width);
-            }
-
-            // Pixel threshold met
-            if ((pendingPixels.size() + pendingFlow.size()) >= input.minBlobSize) {
-                return true;
-            }
+        bool operator<(const Contact& other) const {
+            return component < other.component || (component == other.component && pixel < other.pixel);
         }
-
-        // Not enough pixels
-        return false;
     };
 
-    auto mark = [&](Index index) {
-        if (testPixel(index)) {
-            if (testPrev(index)) {
-                dataOut[index] = LabelFlow;
-            } else {
-                dataOut[index] = nextLabel;
-                queue.push_back(index);
+    std::vector<Index> blobSizes(componentCount + 1, 0);
+    std::vector<Contact> contacts;
+
+#pragma omp parallel if (parallel)
+    {
+        std::vector<Contact> localContacts;
+
+#pragma omp for schedule(static)
+        for (std::int64_t i = 0; i < static_cast<std::int64_t>(size); ++i) {
+            const auto index = static_cast<Index>(i);
+            const Index component = components[index];
+            if (component != util::ConnectedComponents::Background) {
+#pragma omp atomic
+                blobSizes[component]++;
+            } else if (testPixel(index) && testDiff(index)) {
+                forEachNeighbor(index, [&](Index neighbor) {
+                    if (components[neighbor] != util::ConnectedComponents::Background) {
+                        localContacts.push_back(Contact{components[neighbor], index});
+                    }
+                });
             }
         }
-    };
-
-    auto fill = [&](Index startIndex) {
-        // Perform minimal first pass, checking if the blob is large enough
-        if (!fillMinimal(startIndex)) {
-            // Small blob: avoid assigning unique label ID
-            return;
-        }
 
-        queue.clear();
+#pragma omp critical
+        contacts.insert(contacts.end(), localContacts.begin(), localContacts.end());
+    }
 
-        // Large blob: fill out all pixels with proper label ID
-        for (auto& index : pendingPixels) {
-            dataOut[index] = nextLabel;
-            queue.push_back(index);
+    std::sort(contacts.begin(), contacts.end());
+
+    // Assign label IDs in the order in which the blobs are first encountered. Contact pixels count towards the size of
+    // a blob unless an earlier blob has already claimed them as interface pixels.
+    std::vector<Label> blobLabels(componentCount + 1, LabelBackground);
+    auto contact = contacts.begin();
+    for (Index component = 1; component <= componentCount; ++component) {
+        const auto contactBegin = contact;
+        std::size_t blobSize = blobSizes[component];
+        for (; contact != contacts.end() && contact->component == component; ++contact) {
+            blobSize += dataOut[contact->pixel] == LabelBackground ? 1 : 0;
         }
 
-        for (auto& index : pendingFlow) {
-            dataOut[index] = LabelFlow;
+        // Small blob: avoid assigning unique label ID
+        if (blobSize < input.minBlobSize) {
+            blobLabels[component] = LabelMinimal;
+            continue;
         }
 
-        // Perform proper flood fill
-        while (!queue.empty()) {
-            auto index = queue.front();
-            queue.pop_front();
-
-            // Pixel is not on the right boundary
-            if (index % width < width - 1) {
-                mark(index + 1);
-            }
-            // Pixel is not on the left boundary
-            if (index % width > 0) {
-                mark(index - 1);
-            }
-            // Pixel is not on the bottom boundary
-            if (index < size - width) {
-                mark(index + width);
-            }
-            // Pixel is not on the top boundary
-            if (index >= width) {
-                mark(index - width);
-            }
+        blobLabels[component] = nextLabel;
+        for (auto it = contactBegin; it != contact; ++it) {
+            dataOut[it->pixel] = LabelFlow;
         }
 
         // Check if label limit has been reached
         if (nextLabel == labelLimit) {
             // TODO clear smallest blob
-            return;
+            continue;
         }
 
         // Increment label index
         nextLabel++;
-    };
+    }
 
-    // Perform flood fill
-    for (Index i = 0; i < size; ++i) {
-        // Found a possible seed point: start flood filling!
-        if (testPixel(i) && !testPrev(i)) {
-            fill(i);
+    // Label blobs and mark adjacent pixels of the predecessor frame as interface pixels between frames
+#pragma omp parallel for schedule(static) if (parallel)
+    for (std::int64_t i = 0; i < static_cast<std::int64_t>(size); ++i) {
+        const auto index = static_cast<Index>(i);
+        const Index component = components[index];
+        if (component != util::ConnectedComponents::Background) {
+            dataOut[index] = blobLabels[component];
+        } else if (testPixel(index) && testPrev(index)) {
+            bool flow = false;
+            forEachNeighbor(index, [&](Index neighbor) {
+                const Label neighborLabel = blobLabels[components[neighbor]];
+                flow = flow || (neighborLabel != LabelBackground && neighborLabel != LabelMinimal);
+            });
+            if (flow) {
+                dataOut[index] = LabelFlow;
+            }
         }
     }
 
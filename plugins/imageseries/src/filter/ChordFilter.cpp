@@ -6,6 +6,8 @@
 
 #include "ChordFilter.h"
 
+#include "../util/ImageKernels.h"
+
 #include "vislib/graphics/BitmapImage.h"
 
 #include <memory>
@@ -32,64 +34,29 @@ ChordFilter::ImagePtr ChordFilter::operator()() {
         return nullptr;
     }
 
-    if (image->GetChannelCount() != 1 || image->GetChannelType() != Image::ChannelType::CHANNELTYPE_BYTE) {
+    if (image->GetChannelCount() != 1) {
         return nullptr;
     }
 
     // Create output image with 2 channels (R = horizontal chords, G = vertical chords)
     auto result = std::make_shared<Image>(image->Width(), image->Height(), 2, Image::ChannelType::CHANNELTYPE_WORD);
 
-    const auto* dataIn = image->PeekDataAs<std::uint8_t>();
     auto* dataOut = result->PeekDataAs<std::uint16_t>();
     std::size_t width = result->Width();
     std::size_t height = result->Height();
 
-    std::int32_t threshold = input.threshold * 255;
-
-    // Compute chords along X-axis
-    for (std::size_t y = 0; y < height; y++) {
-        // Ignore chords touching borders
-        std::size_t x = 0;
-        for (; x < width; x++) {
-            if (dataIn[x + y * width] < threshold) {
-                break;
-            }
-        }
-
-        std::size_t length = 0;
-        for (; x < width; x++) {
-            if (dataIn[x + y * width] >= threshold) {
-                length++;
-            } else if (length != 0) {
-                for (std::size_t x2 = x - length; x2 < x; x2++) {
-                    dataOut[(x2 + y * width) * 2] = length;
-                }
-                length = 0;
-            }
-        }
-    }
+    bool supported = util::kernels::dispatchChannelType(image->GetChannelType(), [&](auto type) {
+        using T = decltype(type);
+        const auto* dataIn = image->PeekDataAs<T>();
+        const float threshold = util::kernels::thresholdValue<T>(input.threshold);
 
-    // Compute chords along Y-axis
-    for (std::size_t x = 0; x < width; x++) {
-        // Ignore chords touching borders
-        std::size_t y = 0;
-        for (; y < height; y++) {
-            if (dataIn[y + x * width] < threshold) {
-                break;
-            }
-        }
-
-        std::size_t length = 0;
-        for (; y < height; y++) {
-            if (dataIn[y + x * width] >= threshold) {
-                length++;
-            } else if (length != 0) {
-                for (std::size_t y2 = y - length; y2 < y; y2++) {
-                    dataOut[(y2 + x * width) * 2 + 1] = length;
-                }
-                length = 0;
-            }
-        }
+        // Compute chords along X-axis and Y-axis
+        util::kernels::horizontalChords(dataIn, dataOut, width, height, threshold);
+        util::kernels::verticalChords(dataIn, dataOut, width, height, threshold);
+    });
+
+    if (!supported) {
+        return nullptr;
     }
 
     return std::const_pointer_cast<const Image>(result);
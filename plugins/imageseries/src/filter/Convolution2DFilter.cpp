@@ -6,6 +6,8 @@
 
 #include "Convolution2DFilter.h"
 
+#include "../util/ImageKernels.h"
+
 #include "vislib/graphics/BitmapImage.h"
 
 #include <algorithm>
@@ -29,53 +31,29 @@ Convolution2DFilter::ImagePtr Convolution2DFilter::operator()() {
         return nullptr;
     }
 
-    // TODO: add compatibility with non-byte images
-    if (image->GetChannelCount() != 1 || image->GetChannelType() != Image::ChannelType::CHANNELTYPE_BYTE) {
+    if (image->GetChannelCount() != 1) {
         return nullptr;
     }
 
     // Create output image
-    auto result = std::make_shared<Image>(image->Width(), image->Height(), 1, Image::ChannelType::CHANNELTYPE_BYTE);
+    auto result = std::make_shared<Image>(image->Width(), image->Height(), 1, image->GetChannelType());
 
-    const auto* dataIn = image->PeekDataAs<std::uint8_t>();
-    auto* dataOut = result->PeekDataAs<std::uint8_t>();
     std::size_t width = result->Width();
     std::size_t height = result->Height();
 
     // Create intermediate storage
     std::vector<float> intermediate(width * height);
 
-    auto clamp = [](int low, int value, int up) { return std::min(std::max(value, low), up); };
-    auto getIndex = [=](std::size_t x, std::size_t y) { return x + y * width; };
-
-    int kernelWidth = input.kernelX.size();
-    int kernelXOff = kernelWidth / 2;
-
-    // Convolve along X-axis
-    for (std::size_t y = 0; y < height; y++) {
-        for (std::size_t x = 0; x < width; x++) {
-            float value = 0;
-            std::size_t yi = clamp(0, y, height - 1);
-            for (int i = 0; i < kernelWidth; ++i) {
-                value += input.kernelX[i] * dataIn[getIndex(clamp(0, int(x) + kernelXOff - i, width - 1), yi)];
-            }
-            intermediate[getIndex(x, y)] = value;
-        }
-    }
+    bool supported = util::kernels::dispatchChannelType(image->GetChannelType(), [&](auto type) {
+        using T = decltype(type);
 
-    int kernelHeight = input.kernelY.size();
-    int kernelYOff = kernelHeight / 2;
-
-    // Convolve along Y-axis
-    for (std::size_t y = 0; y < height; y++) {
-        for (std::size_t x = 0; x < width; x++) {
-            float value = 0;
-            std::size_t xi = clamp(0, x, width - 1);
-            for (int i = 0; i < kernelHeight; ++i) {
-                value += input.kernelY[i] * intermediate[getIndex(xi, clamp(0, int(y) + kernelYOff - i, height - 1))];
-            }
-            dataOut[getIndex(x, y)] = clamp(0, value, 255);
-        }
+        // Convolve along X-axis, then along Y-axis
+        util::kernels::convolveRows(image->PeekDataAs<T>(), intermediate.data(), width, height, input.kernelX);
+        util::kernels::convolveColumns(intermediate.data(), result->PeekDataAs<T>(), width, height, input.kernelY);
+    });
+
+    if (!supported) {
+        return nullptr;
     }
 
     return std::const_pointer_cast<const Image>(result);
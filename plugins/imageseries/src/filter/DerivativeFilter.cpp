@@ -6,6 +6,8 @@
 
 #include "DerivativeFilter.h"
 
+#include "../util/ImageKernels.h"
+
 #include "vislib/graphics/BitmapImage.h"
 
 #include <algorithm>
@@ -26,38 +28,32 @@ DerivativeFilter::ImagePtr DerivativeFilter::operator()() {
     // Wait for image data to be ready
     auto image = input.image ? input.image->getImageData() : nullptr;
 
-    // Empty or too small -> return nothing
-    if (!image || image->Width() < 3 || image->Height() < 3) {
+    // Empty -> return nothing
+    if (!image || image->Width() == 0 || image->Height() == 0) {
         return nullptr;
     }
 
-    // TODO: add compatibility with non-byte images
-    if (image->GetChannelCount() != 1 || image->GetChannelType() != Image::ChannelType::CHANNELTYPE_BYTE) {
+    if (image->GetChannelCount() != 1) {
         return nullptr;
     }
 
-    // Create output image
-    auto result = std::make_shared<Image>(image->Width(), image->Height(), 2, Image::ChannelType::CHANNELTYPE_BYTE);
-
-    const auto* dataIn = image->PeekDataAs<std::uint8_t>();
-    auto* dataOut = result->PeekDataAs<std::uint8_t>();
-    std::size_t width = result->Width();
-    std::size_t height = result->Height();
-
-    auto clamp = [](int low, int value, int up) { return std::min(std::max(value, low), up); };
-    auto getIndex = [=](std::size_t x, std::size_t y) { return x + y * width; };
-
-    // Compute derivative for each pixel
-    for (std::size_t y = 0; y < height; y++) {
-        for (std::size_t x = 0; x < width; x++) {
-            auto inIndex = getIndex(clamp(1, x, width - 2), clamp(1, y, height - 2));
-
-            // Red channel: horizontal derivative
-            *(dataOut++) = clamp(0, (dataIn[inIndex + 1] - dataIn[inIndex - 1] + 255) / 2, 255);
-
-            // Green channel: vertical derivative
-            *(dataOut++) = clamp(0, (dataIn[inIndex + width] - dataIn[inIndex - width] + 255) / 2, 255);
+    // Create output image: red channel holds the horizontal, green channel the vertical derivative
+    auto result = std::make_shared<Image>(image->Width(), image->Height(), 2, image->GetChannelType());
+
+    bool supported = util::kernels::dispatchChannelType(image->GetChannelType(), [&](auto type) {
+        using T = decltype(type);
+        if (result->Width() < 3 || result->Height() < 3) {
+            // Central differences need a neighbor on both sides, smaller images have a derivative of zero
+            std::fill_n(result->PeekDataAs<T>(), result->Width() * result->Height() * 2,
+                static_cast<T>(util::kernels::maxValue<T>() / 2));
+        } else {
+            util::kernels::centralDifferences(
+                image->PeekDataAs<T>(), result->PeekDataAs<T>(), result->Width(), result->Height());
         }
+    });
+
+    if (!supported) {
+        return nullptr;
     }
 
     return std::const_pointer_cast<const Image>(result);
@@ -0,0 +1,111 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "FilterResultCache.h"
+
+#include <algorithm>
+
+namespace megamol::ImageSeries::filter {
+
+FilterResultCache& FilterResultCache::getSharedInstance() {
+    // Results own jobs of the thread pool, so the pool has to outlive the cache
+    util::WorkerThreadPool::getSharedInstance();
+
+    static FilterResultCache cache;
+    return cache;
+}
+
+void FilterResultCache::clear() {
+    Evicted evicted;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto& entry : entries) {
+        evicted.push_back(std::move(entry.second.strong));
+    }
+    entries.clear();
+    retained.clear();
+    totalByteCount = 0;
+}
+
+void FilterResultCache::setMaximumSize(std::size_t maximumSize) {
+    Evicted evicted;
+    std::lock_guard<std::mutex> lock(mutex);
+    this->maximumSize = maximumSize;
+    cleanUp(evicted);
+}
+
+std::size_t FilterResultCache::getMaximumSize() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return maximumSize;
+}
+
+FilterResultCache::Statistics FilterResultCache::getStatistics() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    Statistics stats;
+    stats.hits = hitCount;
+    stats.misses = missCount;
+    stats.entryCount = retained.size();
+    stats.byteCount = totalByteCount;
+    return stats;
+}
+
+void FilterResultCache::store(
+    Hash key, std::type_index type, std::shared_ptr<const void> value, std::size_t byteCount, Evicted& evicted) {
+    Entry& entry = entries[key];
+    release(entry, evicted);
+    entry.type = type;
+    entry.weak = value;
+    entry.byteCount = byteCount;
+    retain(key, entry, std::move(value), evicted);
+}
+
+void FilterResultCache::retain(Hash key, Entry& entry, std::shared_ptr<const void> value, Evicted& evicted) {
+    if (entry.strong) {
+        retained.splice(retained.begin(), retained, entry.position);
+        return;
+    }
+
+    entry.strong = std::move(value);
+    retained.push_front(key);
+    entry.position = retained.begin();
+    totalByteCount += entry.byteCount;
+
+    cleanUp(evicted);
+}
+
+void FilterResultCache::release(Entry& entry, Evicted& evicted) {
+    if (entry.strong) {
+        evicted.push_back(std::move(entry.strong));
+        entry.strong = nullptr;
+        retained.erase(entry.position);
+        totalByteCount -= entry.byteCount;
+    }
+}
+
+void FilterResultCache::cleanUp(Evicted& evicted) {
+    // Keep at least the most recent result, even if it exceeds the budget on its own
+    while (totalByteCount > maximumSize && !retained.empty()) {
+        if (maximumSize != 0 && retained.size() == 1) {
+            break;
+        }
+        release(entries[retained.back()], evicted);
+    }
+
+    // Forget results that are gone everywhere
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (!it->second.strong && it->second.weak.expired()) {
+            it = entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool FilterResultCache::isRetained(const void* value) const {
+    return std::any_of(
+        entries.begin(), entries.end(), [value](const auto& entry) { return entry.second.strong.get() == value; });
+}
+
+} // namespace megamol::ImageSeries::filter
@@ -0,0 +1,135 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include "imageseries/AsyncImageData2D.h"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace megamol::ImageSeries::filter {
+
+/**
+ * Process-wide cache of filter results, addressed by the filter type and the hash of its inputs.
+ *
+ * Results are shared as soon as they have been scheduled, so identical requests issued while a result is still being
+ * computed wait for the same job instead of starting another one. Results are kept until the cache exceeds its memory
+ * budget, and can be found afterwards for as long as any other owner keeps them alive.
+ */
+class FilterResultCache {
+public:
+    using Hash = util::Hash;
+    using Evicted = std::vector<std::shared_ptr<const void>>;
+
+    struct Statistics {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t entryCount = 0;
+        std::size_t byteCount = 0;
+    };
+
+    static FilterResultCache& getSharedInstance();
+
+    /**
+     * Returns the result stored for a key or stores the result of the supplier.
+     *
+     * @param key Content hash of the result, including the filter type
+     * @param supplier Creates the result on a miss, called with the cache locked
+     */
+    template<typename AsyncImageData, typename Func>
+    std::shared_ptr<const AsyncImageData> findOrCreate(Hash key, Func supplier) {
+        const std::type_index type = typeid(AsyncImageData);
+
+        // Evicted results are released after unlocking, as destroying a running job waits for it
+        Evicted evicted;
+        std::lock_guard<std::mutex> lock(mutex);
+
+        auto it = entries.find(key);
+        if (it != entries.end() && it->second.type == type) {
+            auto value = std::static_pointer_cast<const AsyncImageData>(it->second.weak.lock());
+            // Failed and cancelled results are computed again
+            if (value && !value->isFailed()) {
+                ++hitCount;
+                retain(key, it->second, value, evicted);
+                return value;
+            }
+        }
+
+        ++missCount;
+        std::shared_ptr<const AsyncImageData> value = supplier();
+        if (value && maximumSize != 0) {
+            store(key, type, value, value->getByteSize(), evicted);
+        }
+        return value;
+    }
+
+    /**
+     * Cancels a result that has not been started yet, unless anyone besides the caller and this cache uses it.
+     *
+     * @param value The result to cancel
+     * @param callerReferences Number of references to the result held by the caller, including 'value'
+     * @return true if the result has been cancelled
+     */
+    template<typename AsyncImageData>
+    bool cancelUnshared(const std::shared_ptr<const AsyncImageData>& value, long callerReferences) {
+        // Results are only handed out with the cache locked, so no user can be added while checking
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!value || value.use_count() > callerReferences + (isRetained(value.get()) ? 1 : 0)) {
+            return false;
+        }
+        return value->cancel();
+    }
+
+    void clear();
+
+    void setMaximumSize(std::size_t maximumSize);
+    std::size_t getMaximumSize() const;
+
+    Statistics getStatistics() const;
+
+private:
+    struct Entry {
+        std::type_index type = typeid(void);
+
+        // Finds the result for as long as anyone uses it
+        std::weak_ptr<const void> weak;
+
+        // Keeps the result alive, unset once it has been evicted
+        std::shared_ptr<const void> strong;
+        std::list<Hash>::iterator position;
+
+        std::size_t byteCount = 0;
+    };
+
+    FilterResultCache() = default;
+
+    void store(Hash key, std::type_index type, std::shared_ptr<const void> value, std::size_t byteCount,
+        Evicted& evicted);
+    void retain(Hash key, Entry& entry, std::shared_ptr<const void> value, Evicted& evicted);
+    void release(Entry& entry, Evicted& evicted);
+    void cleanUp(Evicted& evicted);
+    bool isRetained(const void* value) const;
+
+    std::unordered_map<Hash, Entry> entries;
+
+    // Keys of the retained results, most recently used first
+    std::list<Hash> retained;
+
+    std::size_t totalByteCount = 0;
+    std::size_t maximumSize = 1024ull * 1024ull * 1024ull;
+    std::size_t hitCount = 0;
+    std::size_t missCount = 0;
+
+    mutable std::mutex mutex;
+};
+
+} // namespace megamol::ImageSeries::filter
@@ -6,6 +6,7 @@
 
 #include "FlowTimeLabelFilter.h"
 
+#include "../util/ConnectedComponents.h"
 #include "../util/GraphGDFExporter.h"
 #include "../util/GraphLuaExporter.h"
 
@@ -122,65 +123,88 @@ std::shared_ptr<FlowTimeLabelFilter::Output> FlowTimeLabelFilter::operator()() {
         }
     }
 
-    std::vector<Index> floodQueue;
+    // Find connected areas of same time
+    std::vector<util::ConnectedComponents::Index> components;
+    const auto componentCount = util::ConnectedComponents::label(
+        width, height, util::ConnectedComponents::Connectivity::Eight,
+        [&](Index index) { return dataOut[index] == LabelUnassigned; },
+        [&](Index index, Index neighborIndex) { return dataIn[index] == dataIn[neighborIndex]; }, components);
 
-    auto floodFill = [&](const Index index, const Label label) {
-        floodQueue.clear();
-        floodQueue.push_back(index);
+    if (componentCount >= LabelMaximum) {
+        core::utility::log::Log::DefaultLog.WriteError(
+            "[FlowTimeLabelFilter]: Too many labels! Consider denoising the input images.");
 
-        graph::GraphData2D::Node current_region(dataIn[index], label);
-        current_region.pixels.push_back(index);
+        // return black image and empty graph
+        auto output = std::make_shared<Output>();
+        output->image =
+            std::make_shared<Image>(image->Width(), image->Height(), 1, Image::ChannelType::CHANNELTYPE_WORD);
+        output->graph = std::make_shared<graph::GraphData2D>();
+        return output;
+    }
 
-        dataOut[index] = label;
+    Label next_label = LabelMinimum;
 
-        for (std::size_t queueIndex = 0; queueIndex < floodQueue.size(); ++queueIndex) {
-            const auto currentIndex = floodQueue[queueIndex];
+    std::vector<graph::GraphData2D::Node> regions;
+    regions.reserve(componentCount);
 
-            const auto x = currentIndex % width;
-            const auto y = currentIndex / width;
+    for (Index index = 0; index < size; ++index) {
+        const auto component = components[index];
+        if (component == util::ConnectedComponents::Background) {
+            continue;
+        }
 
-            for (auto j = ((y > 0) ? -1 : 0); j <= ((y < height - 1) ? 1 : 0); ++j) {
-                for (auto i = ((x > 0) ? -1 : 0); i <= ((x < width - 1) ? 1 : 0); ++i) {
-                    const auto neighborIndex = (y + j) * width + (x + i);
+        // First pixel of a region: components are numbered in order of their first pixel
+        if (component > regions.size()) {
+            regions.emplace_back(dataIn[index], next_label++);
+        }
 
-                    if (dataOut[neighborIndex] == LabelUnassigned && dataIn[index] == dataIn[neighborIndex]) {
-                        floodQueue.push_back(neighborIndex);
-                        dataOut[neighborIndex] = label;
+        auto& current_region = regions[component - 1];
+        const Label label = current_region.getLabel();
+        current_region.pixels.push_back(index);
+        dataOut[index] = label;
 
-                        current_region.pixels.push_back(neighborIndex);
-                    } else if (dataOut[neighborIndex] == LabelSolid) {
-                        // Add current fluid index to interfaces, indicating a fluid-solid interface
-                        current_region.interfaces[LabelSolid].insert(currentIndex);
+        const auto x = index % width;
+        const auto y = index / width;
 
-                        if (interface_output == interface_t::full) {
-                            interfaceSolidOut[currentIndex] = interfaceOut[currentIndex] = 0;
-                        }
-                    } else if (dataIn[index] > dataIn[neighborIndex]) {
-                        // Add neighboring fluid index to interfaces, indicating a past fluid-fluid interface
-                        current_region.interfaces[dataIn[neighborIndex]].insert(neighborIndex);
-                    } else if (dataIn[index] < dataIn[neighborIndex]) {
-                        // Add current fluid index to interfaces, indicating a current fluid-fluid interface
-                        current_region.interfaces[dataIn[neighborIndex]].insert(neighborIndex);
-
-                        if (interface_output == interface_t::full) {
-                            interfaceFluidOut[neighborIndex] = interfaceOut[currentIndex] =
-                                current_region.getFrameIndex();
-                        }
+        for (auto j = ((y > 0) ? -1 : 0); j <= ((y < height - 1) ? 1 : 0); ++j) {
+            for (auto i = ((x > 0) ? -1 : 0); i <= ((x < width - 1) ? 1 : 0); ++i) {
+                const auto neighborIndex = (y + j) * width + (x + i);
+
+                if (components[neighborIndex] == component) {
+                    // Same region
+                } else if (dataIn[neighborIndex] == 0) {
+                    // Add current fluid index to interfaces, indicating a fluid-solid interface
+                    current_region.interfaces[LabelSolid].insert(index);
+
+                    if (interface_output == interface_t::full) {
+                        interfaceSolidOut[index] = interfaceOut[index] = 0;
                     }
+                } else if (dataIn[index] > dataIn[neighborIndex]) {
+                    // Add neighboring fluid index to interfaces, indicating a past fluid-fluid interface
+                    current_region.interfaces[dataIn[neighborIndex]].insert(neighborIndex);
+                } else if (dataIn[index] < dataIn[neighborIndex]) {
+                    // Add current fluid index to interfaces, indicating a current fluid-fluid interface
+                    current_region.interfaces[dataIn[neighborIndex]].insert(neighborIndex);
+
+                    if (interface_output == interface_t::full) {
+                        interfaceFluidOut[neighborIndex] = interfaceOut[index] = current_region.getFrameIndex();
+                    }
+                }
 
-                    if (interface_output != interface_t::none) {
-                        const auto targetInterface = static_cast<Timestamp>(interface_output);
-                        if (dataIn[index] <= targetInterface && dataIn[neighborIndex] > targetInterface) {
-                            interfaceFluidOut[neighborIndex] = interfaceOut[currentIndex] = 0;
-                        }
-                        if (dataIn[index] <= targetInterface && dataIn[neighborIndex] == LabelSolid) {
-                            interfaceSolidOut[neighborIndex] = interfaceOut[currentIndex] = 0;
-                        }
+                if (interface_output != interface_t::none) {
+                    const auto targetInterface = static_cast<Timestamp>(interface_output);
+                    if (dataIn[index] <= targetInterface && dataIn[neighborIndex] > targetInterface) {
+                        interfaceFluidOut[neighborIndex] = interfaceOut[index] = 0;
+                    }
+                    if (dataIn[index] <= targetInterface && dataIn[neighborIndex] == LabelSolid) {
+                        interfaceSolidOut[neighborIndex] = interfaceOut[index] = 0;
                     }
                 }
             }
         }
+    }
 
+    for (auto& current_region : regions) {
         current_region.interfaceSolid = current_region.interfaces[LabelSolid].size();
         current_region.interfaceFluid = 0.0f;
 
@@ -190,27 +214,8 @@ std::shared_ptr<FlowTimeLabelFilter::Output> FlowTimeLabelFilter::operator()() {
             }
         }
 
-        nodesByTime[current_region.getFrameIndex()].push_back(nodeGraph->addNode(current_region));
-    };
-
-    Label next_label = LabelMinimum;
-
-    for (Index index = 0; index < size; ++index) {
-        if (dataOut[index] == LabelUnassigned && next_label <= LabelMaximum) {
-            floodFill(index, next_label++);
-        }
-    }
-
-    if (next_label > LabelMaximum) {
-        core::utility::log::Log::DefaultLog.WriteError(
-            "[FlowTimeLabelFilter]: Too many labels! Consider denoising the input images.");
-
-        // return black image and empty graph
-        auto output = std::make_shared<Output>();
-        output->image =
-            std::make_shared<Image>(image->Width(), image->Height(), 1, Image::ChannelType::CHANNELTYPE_WORD);
-        output->graph = std::make_shared<graph::GraphData2D>();
-        return output;
+        const auto frameIndex = current_region.getFrameIndex();
+        nodesByTime[frameIndex].push_back(nodeGraph->addNode(std::move(current_region)));
     }
 
     auto printNode = [&nodeGraph](graph::GraphData2D::NodeID id) {
@@ -722,6 +727,10 @@ ImageMetadata FlowTimeLabelFilter::getMetadata() const {
     }
 }
 
+bool FlowTimeLabelFilter::isCacheable() const {
+    return !input.outputGraphs && !input.outputLabelImages && !input.outputTimeImages;
+}
+
 graph::GraphData2D::Node FlowTimeLabelFilter::combineNodes(
     const std::vector<graph::GraphData2D::Node>& nodesToCombine, Label& nextLabel) const {
 
@@ -100,6 +100,9 @@ public:
 
     ImageMetadata getMetadata() const;
 
+    /// Results written to files must not be taken from the filter result cache
+    bool isCacheable() const;
+
 private:
     Input input;
 
@@ -8,8 +8,10 @@
 
 #include "vislib/graphics/BitmapCodecCollection.h"
 
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <system_error>
 
 namespace megamol::ImageSeries::filter {
 
@@ -46,7 +48,19 @@ ImageLoadFilter::ImagePtr ImageLoadFilter::operator()() {
 
 ImageMetadata ImageLoadFilter::getMetadata() const {
     ImageMetadata metadata = input.metadata;
-    metadata.hash = util::computeHash(input.filename);
+
+    // Results are cached process-wide by this hash, so a file replaced on disk has to hash differently
+    const std::filesystem::path path(input.filename);
+    std::error_code ec;
+    std::uintmax_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec) {
+        fileSize = 0;
+    }
+    auto writeTime = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    if (ec) {
+        writeTime = 0;
+    }
+    metadata.hash = util::computeHash(input.filename, fileSize, writeTime);
     metadata.filename = input.filename;
     return metadata;
 }
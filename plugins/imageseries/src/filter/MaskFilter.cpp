@@ -6,6 +6,8 @@
 
 #include "MaskFilter.h"
 
+#include "../util/ImageKernels.h"
+
 #include "vislib/graphics/BitmapImage.h"
 
 #include <algorithm>
@@ -38,23 +40,27 @@ MaskFilter::ImagePtr MaskFilter::operator()() {
         return nullptr;
     }
 
-    // TODO: add compatibility with non-byte multichannel images
-    if (image->GetChannelCount() != 1 || image->GetChannelType() != Image::ChannelType::CHANNELTYPE_BYTE ||
-        mask->GetChannelCount() != 1 || mask->GetChannelType() != Image::ChannelType::CHANNELTYPE_BYTE) {
+    // TODO: add compatibility with multichannel images
+    if (image->GetChannelCount() != 1 || mask->GetChannelCount() != 1) {
         return nullptr;
     }
 
     // Create output image
-    auto result = std::make_shared<Image>(image->Width(), image->Height(), 1, Image::ChannelType::CHANNELTYPE_BYTE);
-
-    const auto* dataIn = image->PeekDataAs<std::uint8_t>();
-    const auto* maskIn = mask->PeekDataAs<std::uint8_t>();
-    auto* dataOut = result->PeekDataAs<std::uint8_t>();
-    std::size_t size = result->Width() * result->Height();
-
-    // Apply mask to each pixel
-    for (std::size_t i = 0; i < size; i++) {
-        dataOut[i] = std::max(dataIn[i], maskIn[i]);
+    auto result = std::make_shared<Image>(image->Width(), image->Height(), 1, image->GetChannelType());
+
+    // Apply mask to each pixel, the mask is rescaled to the channel range of the image
+    bool supported = false;
+    util::kernels::dispatchChannelType(image->GetChannelType(), [&](auto type) {
+        using T = decltype(type);
+        supported = util::kernels::dispatchChannelType(mask->GetChannelType(), [&](auto maskType) {
+            using M = decltype(maskType);
+            util::kernels::maximum(image->PeekDataAs<T>(), mask->PeekDataAs<M>(), result->PeekDataAs<T>(),
+                result->Width(), result->Height());
+        });
+    });
+
+    if (!supported) {
+        return nullptr;
     }
 
     return std::const_pointer_cast<const Image>(result);
@@ -6,6 +6,8 @@
 
 #include "SegmentationFilter.h"
 
+#include "../util/ImageKernels.h"
+
 #include "vislib/graphics/BitmapImage.h"
 
 #include <memory>
@@ -32,8 +34,8 @@ SegmentationFilter::ImagePtr SegmentationFilter::operator()() {
         return nullptr;
     }
 
-    // TODO: add compatibility with non-byte multichannel images
-    if (image->GetChannelCount() != 1 || image->GetChannelType() != Image::ChannelType::CHANNELTYPE_BYTE) {
+    // TODO: add compatibility with multichannel images
+    if (image->GetChannelCount() != 1) {
         return nullptr;
     }
 
@@ -42,20 +44,15 @@ SegmentationFilter::ImagePtr SegmentationFilter::operator()() {
     // Create output image
     auto result = std::make_shared<Image>(image->Width(), image->Height(), 1, Image::ChannelType::CHANNELTYPE_BYTE);
 
-    const auto* dataIn = image->PeekDataAs<std::uint8_t>();
-    auto* dataOut = result->PeekDataAs<std::uint8_t>();
-    std::size_t size = result->Width() * result->Height();
-    std::int32_t threshold = input.threshold * 255;
-
     // Apply threshold to each pixel
-    if (input.negateOutput) {
-        for (std::size_t i = 0; i < size; i++) {
-            dataOut[i] = dataIn[i] < threshold ? 255 : 0;
-        }
-    } else {
-        for (std::size_t i = 0; i < size; i++) {
-            dataOut[i] = dataIn[i] >= threshold ? 255 : 0;
-        }
+    bool supported = util::kernels::dispatchChannelType(image->GetChannelType(), [&](auto type) {
+        using T = decltype(type);
+        util::kernels::threshold(image->PeekDataAs<T>(), result->PeekDataAs<std::uint8_t>(), result->Width(),
+            result->Height(), util::kernels::thresholdValue<T>(input.threshold), input.negateOutput);
+    });
+
+    if (!supported) {
+        return nullptr;
     }
 
     return std::const_pointer_cast<const Image>(result);
@@ -64,6 +61,7 @@ SegmentationFilter::ImagePtr SegmentationFilter::operator()() {
 ImageMetadata SegmentationFilter::getMetadata() const {
     if (input.image) {
         ImageMetadata metadata = input.image->getMetadata();
+        metadata.bytesPerChannel = 1;
         metadata.hash = util::computeHash(input.image, input.threshold, input.negateOutput);
 
         return metadata;
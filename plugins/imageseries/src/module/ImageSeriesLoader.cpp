@@ -7,12 +7,14 @@
 #include "ImageSeriesLoader.h"
 
 #include "../filter/AsyncFilterRunner.h"
+#include "../filter/FilterResultCache.h"
 #include "../filter/ImageLoadFilter.h"
 
 #include "imageseries/ImageSeries2DCall.h"
 
 #include "mmcore/param/EnumParam.h"
 #include "mmcore/param/FilePathParam.h"
+#include "mmcore/param/IntParam.h"
 #include "mmcore/param/StringParam.h"
 
 #include "vislib/graphics/BitmapCodecCollection.h"
@@ -24,6 +26,7 @@
 #include <filesystem>
 #include <memory>
 #include <regex>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -35,6 +38,10 @@ ImageSeriesLoader::ImageSeriesLoader()
         : getDataCallee("getData", "Returns data from the image series for the requested timestamp.")
         , pathParam("Path", "Directory from which image files should be loaded.")
         , patternParam("Filename pattern", "Regular expression to filter file names by.")
+        , cacheSizeParam("Cache size (MB)", "Maximum memory used for decoded images.")
+        , prefetchParam("Prefetch frames",
+              "Number of frames decoded ahead of the requested one, following the direction of playback.")
+        , cacheStatisticsParam("Cache statistics", "Hits, misses and memory usage of the image cache.")
         , imageCache([](const AsyncImageData2D<>& imageData) { return imageData.getByteSize(); }) {
 
     getDataCallee.SetCallback(ImageSeries2DCall::ClassName(),
@@ -52,7 +59,17 @@ ImageSeriesLoader::ImageSeriesLoader()
     MakeSlotAvailable(&patternParam);
 
     // Set default image cache size to 512 MB
+    cacheSizeParam << new core::param::IntParam(512, 0);
+    cacheSizeParam.SetUpdateCallback(&ImageSeriesLoader::cacheSizeChangedCallback);
+    MakeSlotAvailable(&cacheSizeParam);
     imageCache.setMaximumSize(512 * 1024 * 1024);
+
+    prefetchParam << new core::param::IntParam(8, 0, 256);
+    MakeSlotAvailable(&prefetchParam);
+
+    cacheStatisticsParam << new core::param::StringParam("");
+    cacheStatisticsParam.Parameter()->SetGUIReadOnly(true);
+    MakeSlotAvailable(&cacheStatisticsParam);
 }
 
 ImageSeriesLoader::~ImageSeriesLoader() {
@@ -65,6 +82,7 @@ bool ImageSeriesLoader::create() {
 }
 
 void ImageSeriesLoader::release() {
+    cancelPrefetch();
     imageCache.clear();
     filterRunner = nullptr;
 }
@@ -79,16 +97,12 @@ bool ImageSeriesLoader::getDataCallback(core::Call& caller) {
         output.resultTime = frameIndexToTimestamp(output.imageIndex);
 
         if (output.imageIndex < imageFilesFiltered.size()) {
-            const auto& path = imageFilesFiltered[output.imageIndex];
-            output.filename = path;
-
-            ImageMetadata meta = metadata;
-            meta.imageCount = output.imageCount;
-            meta.index = output.imageIndex;
-            meta.valid = true;
-            output.imageData = imageCache.findOrCreate(output.imageIndex, [&](std::uint32_t) {
-                return filterRunner->run<ImageSeries::filter::ImageLoadFilter>(getBitmapCodecs(), path, meta);
-            });
+            output.filename = imageFilesFiltered[output.imageIndex];
+            output.imageData = imageCache.findOrCreate(
+                output.imageIndex, [&](std::uint32_t index) { return loadImageAsync(index); });
+
+            prefetch(output.imageIndex);
+            updateCacheStatistics();
         }
 
         // TODO validate that width and height match series metadata
@@ -129,6 +143,13 @@ bool ImageSeriesLoader::formatChangedCallback(core::param::ParamSlot& param) {
     return true;
 }
 
+bool ImageSeriesLoader::cacheSizeChangedCallback(core::param::ParamSlot& param) {
+    auto megabytes = std::max(0, cacheSizeParam.Param<core::param::IntParam>()->Value());
+    imageCache.setMaximumSize(static_cast<std::size_t>(megabytes) * 1024 * 1024);
+    updateCacheStatistics();
+    return true;
+}
+
 inline bool lexicalNumericComparatorImpl(const char* a, const char* aEnd, const char* b, const char* bEnd) {
     if (a >= aEnd || b >= bEnd) {
         return a >= aEnd;
@@ -181,7 +202,10 @@ void ImageSeriesLoader::filterImageFiles() {
 }
 
 void ImageSeriesLoader::updateMetadata() {
+    cancelPrefetch();
     imageCache.clear();
+    lastFrameIndex.reset();
+    playbackDirection = 0;
     outputPrototype = {};
 
     // No image files -> no data
@@ -245,6 +269,94 @@ std::shared_ptr<vislib::graphics::BitmapImage> ImageSeriesLoader::loadImageFile(
     return nullptr;
 }
 
+std::shared_ptr<const AsyncImageData2D<>> ImageSeriesLoader::loadImageAsync(std::size_t index) const {
+    ImageMetadata meta = metadata;
+    meta.imageCount = outputPrototype.imageCount;
+    meta.index = index;
+    meta.valid = true;
+    return filterRunner->run<ImageSeries::filter::ImageLoadFilter>(
+        getBitmapCodecs(), imageFilesFiltered[index], meta);
+}
+
+void ImageSeriesLoader::prefetch(std::size_t index) {
+    const int frames = prefetchParam.Param<core::param::IntParam>()->Value();
+
+    // The trend of playback is only known from the second request on
+    if (!lastFrameIndex.has_value()) {
+        lastFrameIndex = index;
+        return;
+    }
+    const std::size_t last = *lastFrameIndex;
+
+    // Follow the requested frames: playback keeps its direction and step, anything else counts as a seek
+    const std::size_t distance = index > last ? index - last : last - index;
+    const int direction = index > last ? 1 : (index < last ? -1 : playbackDirection);
+    const bool seek = distance > static_cast<std::size_t>(std::max(frames, 1));
+    const std::size_t step = distance == 0 || seek ? 1 : distance;
+
+    if (seek || direction != playbackDirection) {
+        cancelPrefetch();
+    }
+    prefetchedFrames.erase(
+        std::remove(prefetchedFrames.begin(), prefetchedFrames.end(), index), prefetchedFrames.end());
+
+    lastFrameIndex = index;
+    playbackDirection = direction;
+
+    if (frames <= 0 || direction == 0 || imageCache.getMaximumSize() == 0) {
+        return;
+    }
+
+    // Leave at least half of the cache to frames that have actually been requested
+    const std::size_t frameSize = std::max<std::size_t>(1, metadata.getByteSize());
+    const std::size_t count = std::min<std::size_t>(frames, imageCache.getMaximumSize() / 2 / frameSize);
+
+    for (std::size_t i = 1; i <= count; ++i) {
+        const std::int64_t next = static_cast<std::int64_t>(index) + direction * static_cast<std::int64_t>(i * step);
+        if (next < 0 || next >= static_cast<std::int64_t>(imageFilesFiltered.size())) {
+            break;
+        }
+        // Decoding runs on the shared worker thread pool
+        if (imageCache.prefetch(next, [&](std::uint32_t key) { return loadImageAsync(key); })) {
+            prefetchedFrames.push_back(next);
+        }
+    }
+}
+
+void ImageSeriesLoader::cancelPrefetch() {
+    for (auto key : prefetchedFrames) {
+        auto image = imageCache.get(key);
+        // Running decodes are kept, waiting ones are dropped without blocking. Results are shared through the
+        // filter result cache, so decodes that anyone else uses are kept as well. The loader holds two references,
+        // 'image' and the entry of its own cache.
+        if (image != nullptr && filter::FilterResultCache::getSharedInstance().cancelUnshared(image, 2)) {
+            imageCache.erase(key);
+        }
+    }
+    prefetchedFrames.clear();
+}
+
+void ImageSeriesLoader::updateCacheStatistics() {
+    const auto stats = imageCache.getStatistics();
+    const auto total = stats.hits + stats.misses;
+
+    std::ostringstream text;
+    text << stats.hits << " hits, " << stats.misses << " misses";
+    if (total > 0) {
+        text << " (" << (100 * stats.hits / total) << "% hit rate)";
+    }
+    text << ", " << stats.entryCount << " frames, " << (stats.byteCount / (1024 * 1024)) << " MB";
+
+    const auto shared = filter::FilterResultCache::getSharedInstance().getStatistics();
+    text << "; shared filter results: " << shared.hits << " hits, " << shared.misses << " misses, "
+         << shared.entryCount << " results, " << (shared.byteCount / (1024 * 1024)) << " MB";
+
+    auto param = cacheStatisticsParam.Param<core::param::StringParam>();
+    if (param->Value() != text.str()) {
+        param->SetValue(text.str());
+    }
+}
+
 std::shared_ptr<vislib::graphics::BitmapCodecCollection> ImageSeriesLoader::getBitmapCodecs() const {
     // Copy bitmap codec collection (for thread-safety)
     auto bitmapCodecCollection = std::make_shared<vislib::graphics::BitmapCodecCollection>(
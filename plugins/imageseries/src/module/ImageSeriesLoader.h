@@ -20,6 +20,7 @@
 #include "vislib/graphics/BitmapCodecCollection.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -96,6 +97,11 @@ protected:
      */
     bool formatChangedCallback(core::param::ParamSlot& param);
 
+    /**
+     * Callback for changes to the 'cache size' parameter.
+     */
+    bool cacheSizeChangedCallback(core::param::ParamSlot& param);
+
 private:
     void refreshDirectory();
     void filterImageFiles();
@@ -106,6 +112,17 @@ private:
 
     std::shared_ptr<vislib::graphics::BitmapImage> loadImageFile(const std::string& path) const;
 
+    std::shared_ptr<const AsyncImageData2D<>> loadImageAsync(std::size_t index) const;
+
+    /**
+     * Follows the trend of the requested frames and schedules decoding of the frames expected next.
+     */
+    void prefetch(std::size_t index);
+
+    void cancelPrefetch();
+
+    void updateCacheStatistics();
+
     std::unique_ptr<filter::AsyncFilterRunner<>> filterRunner;
 
     core::CalleeSlot getDataCallee;
@@ -116,11 +133,27 @@ private:
     /// Regex pattern to filter image series by
     core::param::ParamSlot patternParam;
 
+    /// Maximum memory used for decoded images
+    core::param::ParamSlot cacheSizeParam;
+
+    /// Number of frames decoded ahead of the requested one
+    core::param::ParamSlot prefetchParam;
+
+    /// Read-only display of cache hits, misses and memory usage
+    core::param::ParamSlot cacheStatisticsParam;
+
     std::vector<std::string> imageFilesUnfiltered;
     std::vector<std::string> imageFilesFiltered;
 
     util::LRUCache<std::uint32_t, AsyncImageData2D<>> imageCache;
 
+    /// Frames scheduled by the prefetcher which have not been requested yet
+    std::vector<std::uint32_t> prefetchedFrames;
+
+    /// Last requested frame, if any, and the direction of playback (-1, 0 or 1)
+    std::optional<std::size_t> lastFrameIndex;
+    int playbackDirection = 0;
+
     ImageMetadata metadata;
     ImageSeries2DCall::Output outputPrototype;
 
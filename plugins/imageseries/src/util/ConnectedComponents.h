@@ -0,0 +1,242 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include "ImageKernels.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace megamol::ImageSeries::util {
+
+/**
+ * Labels the connected components of an image using a block-based union-find.
+ *
+ * The image is split into bands of rows which are labeled independently, the equivalences across band borders are
+ * merged afterwards. Both steps run in parallel for large images. Components are numbered from 1 in the order of their
+ * first pixel in row-major order, which is the order a sequential flood fill would discover them in.
+ */
+class ConnectedComponents {
+public:
+    using Index = std::uint32_t;
+
+    enum class Connectivity {
+        // Horizontal and vertical neighbors
+        Four,
+
+        // Horizontal, vertical and diagonal neighbors
+        Eight,
+    };
+
+    /// Label of pixels not belonging to any component
+    static constexpr Index Background = 0;
+
+    /**
+     * Computes the component of each pixel.
+     *
+     * @param width Width of the image
+     * @param height Height of the image
+     * @param connectivity Neighborhood of a pixel
+     * @param foreground Answers whether the pixel at an index belongs to any component, called once per pixel
+     * @param connected Answers whether two neighboring foreground pixels belong to the same component
+     * @param labels Receives the component of each pixel, or Background
+     *
+     * @return Number of components
+     */
+    template<typename Foreground, typename Connected>
+    static Index label(std::size_t width, std::size_t height, Connectivity connectivity, Foreground&& foreground,
+        Connected&& connected, std::vector<Index>& labels) {
+        const std::size_t size = width * height;
+        labels.resize(size);
+        if (size == 0) {
+            return 0;
+        }
+
+        const auto bandCount = static_cast<std::int64_t>((height + BandHeight - 1) / BandHeight);
+        const bool parallel = size >= kernels::ParallelPixelThreshold && bandCount > 1;
+        const bool diagonal = connectivity == Connectivity::Eight;
+
+        std::unique_ptr<std::atomic<Index>[]> parentStorage(new std::atomic<Index>[size]);
+        auto* parent = parentStorage.get();
+
+        auto find = [parent](Index index) {
+            Index next = parent[index].load(std::memory_order_relaxed);
+            while (next != index) {
+                // Path halving: only ever points a pixel to one of its ancestors
+                const Index grandparent = parent[next].load(std::memory_order_relaxed);
+                if (grandparent != next) {
+                    parent[index].store(grandparent, std::memory_order_relaxed);
+                }
+                index = next;
+                next = grandparent;
+            }
+            return index;
+        };
+
+        // Roots are always linked below smaller roots, so the root of a component is its first pixel
+        auto unite = [parent, &find](Index a, Index b) {
+            while (true) {
+                a = find(a);
+                b = find(b);
+                if (a == b) {
+                    return;
+                }
+                if (a > b) {
+                    std::swap(a, b);
+                }
+                Index expected = b;
+                if (parent[b].compare_exchange_weak(expected, a)) {
+                    return;
+                }
+            }
+        };
+
+        auto isForeground = [parent](Index index) {
+            return parent[index].load(std::memory_order_relaxed) != Unassigned;
+        };
+
+        // Within a band only one thread touches the pixels, so components are merged without atomic exchanges
+        auto mergeLocal = [&](Index index, Index neighbor, Index root) {
+            if (!isForeground(neighbor) || !connected(index, neighbor)) {
+                return root;
+            }
+            const Index other = find(neighbor);
+            if (root == index) {
+                return other;
+            }
+            if (other != root) {
+                parent[std::max(root, other)].store(std::min(root, other), std::memory_order_relaxed);
+            }
+            return std::min(root, other);
+        };
+
+        // Label bands independently
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (std::int64_t band = 0; band < bandCount; ++band) {
+            const std::size_t rowBegin = band * BandHeight;
+            const std::size_t rowEnd = std::min(rowBegin + BandHeight, height);
+
+            for (std::size_t y = rowBegin; y < rowEnd; ++y) {
+                for (std::size_t x = 0; x < width; ++x) {
+                    const auto index = static_cast<Index>(x + y * width);
+                    if (!foreground(index)) {
+                        parent[index].store(Unassigned, std::memory_order_relaxed);
+                        continue;
+                    }
+
+                    Index root = index;
+                    if (x > 0) {
+                        root = mergeLocal(index, index - 1, root);
+                    }
+                    if (y > rowBegin) {
+                        const Index up = index - static_cast<Index>(width);
+                        if (diagonal && x > 0) {
+                            root = mergeLocal(index, up - 1, root);
+                        }
+                        root = mergeLocal(index, up, root);
+                        if (diagonal && x + 1 < width) {
+                            root = mergeLocal(index, up + 1, root);
+                        }
+                    }
+                    parent[index].store(root, std::memory_order_relaxed);
+                }
+            }
+        }
+
+        auto tryUnite = [&](Index index, Index neighbor) {
+            if (isForeground(neighbor) && connected(index, neighbor)) {
+                unite(index, neighbor);
+            }
+        };
+
+        // Merge components across band borders
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (std::int64_t band = 1; band < bandCount; ++band) {
+            const std::size_t y = band * BandHeight;
+            for (std::size_t x = 0; x < width; ++x) {
+                const auto index = static_cast<Index>(x + y * width);
+                if (!isForeground(index)) {
+                    continue;
+                }
+                const Index up = index - static_cast<Index>(width);
+                if (diagonal && x > 0) {
+                    tryUnite(index, up - 1);
+                }
+                tryUnite(index, up);
+                if (diagonal && x + 1 < width) {
+                    tryUnite(index, up + 1);
+                }
+            }
+        }
+
+        // Count the roots of each band
+        std::vector<Index> bandOffsets(bandCount + 1, 0);
+
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (std::int64_t band = 0; band < bandCount; ++band) {
+            const std::size_t begin = band * BandHeight * width;
+            const std::size_t end = std::min((band + 1) * BandHeight, height) * width;
+
+            Index roots = 0;
+            for (std::size_t index = begin; index < end; ++index) {
+                roots += parent[index].load(std::memory_order_relaxed) == index ? 1 : 0;
+            }
+            bandOffsets[band + 1] = roots;
+        }
+
+        for (std::int64_t band = 0; band < bandCount; ++band) {
+            bandOffsets[band + 1] += bandOffsets[band];
+        }
+
+        // Number the roots in row-major order
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (std::int64_t band = 0; band < bandCount; ++band) {
+            const std::size_t begin = band * BandHeight * width;
+            const std::size_t end = std::min((band + 1) * BandHeight, height) * width;
+
+            Index next = bandOffsets[band];
+            for (std::size_t index = begin; index < end; ++index) {
+                if (parent[index].load(std::memory_order_relaxed) == index) {
+                    labels[index] = ++next;
+                }
+            }
+        }
+
+        // Propagate the numbers of the roots
+#pragma omp parallel for schedule(dynamic) if (parallel)
+        for (std::int64_t band = 0; band < bandCount; ++band) {
+            const std::size_t begin = band * BandHeight * width;
+            const std::size_t end = std::min((band + 1) * BandHeight, height) * width;
+
+            for (std::size_t index = begin; index < end; ++index) {
+                if (!isForeground(static_cast<Index>(index))) {
+                    labels[index] = Background;
+                    continue;
+                }
+                const Index root = find(static_cast<Index>(index));
+                if (root != index) {
+                    labels[index] = labels[root];
+                }
+            }
+        }
+
+        return bandOffsets[bandCount];
+    }
+
+private:
+    /// Number of rows labeled by a thread at once
+    static constexpr std::size_t BandHeight = 64;
+
+    /// Parent of pixels not belonging to any component
+    static constexpr Index Unassigned = ~Index(0);
+};
+
+} // namespace megamol::ImageSeries::util
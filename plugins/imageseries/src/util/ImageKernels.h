@@ -0,0 +1,342 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include "vislib/graphics/BitmapImage.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace megamol::ImageSeries::util {
+
+/**
+ * Building blocks for the per-pixel image filters.
+ *
+ * All kernels operate on single-channel images of 8-bit, 16-bit or float channels. Border pixels are handled in
+ * separate loops, so the inner loops over the interior of a row contain no clamping and can be vectorized. Large
+ * images are split into tiles of rows which are processed in parallel.
+ */
+namespace kernels {
+
+using ChannelType = vislib::graphics::BitmapImage::ChannelType;
+
+/// Images with fewer pixels are processed on the calling thread only, as they already run in parallel per image
+constexpr std::size_t ParallelPixelThreshold = 512 * 512;
+
+/// Number of rows processed by a thread at once
+constexpr std::size_t RowTileSize = 16;
+
+/**
+ * Maximum value of a channel, i.e. the value corresponding to an intensity of 1.
+ */
+template<typename T>
+constexpr float maxValue() {
+    if constexpr (std::is_floating_point_v<T>) {
+        return 1.f;
+    } else {
+        return static_cast<float>(std::numeric_limits<T>::max());
+    }
+}
+
+/**
+ * Converts a relative threshold in [0, 1] to channel values, truncating as the integer filters always did.
+ */
+template<typename T>
+float thresholdValue(double threshold) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<float>(threshold);
+    } else {
+        return std::floor(static_cast<float>(threshold * maxValue<T>()));
+    }
+}
+
+/**
+ * Converts a filtered value back to the channel type, saturating integer channels.
+ */
+template<typename T>
+inline T saturate(float value) {
+    if constexpr (std::is_floating_point_v<T>) {
+        return static_cast<T>(value);
+    } else {
+        return static_cast<T>(std::min(std::max(value, 0.f), maxValue<T>()));
+    }
+}
+
+/**
+ * Calls func with a value-initialized object of the C++ type of a channel type.
+ *
+ * @return false if the channel type is unsupported
+ */
+template<typename Func>
+bool dispatchChannelType(ChannelType type, Func&& func) {
+    switch (type) {
+    case ChannelType::CHANNELTYPE_BYTE:
+        func(std::uint8_t{});
+        return true;
+    case ChannelType::CHANNELTYPE_WORD:
+        func(std::uint16_t{});
+        return true;
+    case ChannelType::CHANNELTYPE_FLOAT:
+        func(float{});
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * Calls func(rowBegin, rowEnd) for tiles of rows covering [0, height), in parallel for large images.
+ */
+template<typename Func>
+void forEachRowTile(std::size_t width, std::size_t height, Func&& func) {
+    const auto tileCount = static_cast<std::int64_t>((height + RowTileSize - 1) / RowTileSize);
+    const bool parallel = width * height >= ParallelPixelThreshold && tileCount > 1;
+
+#pragma omp parallel for schedule(dynamic) if (parallel)
+    for (std::int64_t tile = 0; tile < tileCount; ++tile) {
+        const std::size_t rowBegin = tile * RowTileSize;
+        func(rowBegin, std::min(rowBegin + RowTileSize, height));
+    }
+}
+
+/**
+ * Convolves each row with a kernel, replicating the border pixels. out[x] = sum_i kernel[i] * in[x + radius - i]
+ */
+template<typename T>
+void convolveRows(const T* in, float* out, std::size_t width, std::size_t height, const std::vector<float>& kernel) {
+    const int size = static_cast<int>(kernel.size());
+    const int offset = size / 2;
+    const int w = static_cast<int>(width);
+    const float* k = kernel.data();
+
+    // Interior pixels have all taps inside the row
+    const int interiorBegin = std::min(std::max(size - 1 - offset, 0), w);
+    const int interiorEnd = std::max(w - offset, interiorBegin);
+
+    forEachRowTile(width, height, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        for (std::size_t y = rowBegin; y < rowEnd; ++y) {
+            const T* row = in + y * width;
+            float* result = out + y * width;
+
+            auto border = [&](int x) {
+                float value = 0;
+                for (int i = 0; i < size; ++i) {
+                    value += k[i] * row[std::min(std::max(x + offset - i, 0), w - 1)];
+                }
+                result[x] = value;
+            };
+
+            for (int x = 0; x < interiorBegin; ++x) {
+                border(x);
+            }
+#pragma omp simd
+            for (int x = interiorBegin; x < interiorEnd; ++x) {
+                float value = 0;
+                for (int i = 0; i < size; ++i) {
+                    value += k[i] * static_cast<float>(row[x + offset - i]);
+                }
+                result[x] = value;
+            }
+            for (int x = interiorEnd; x < w; ++x) {
+                border(x);
+            }
+        }
+    });
+}
+
+/**
+ * Convolves each column with a kernel, replicating the border pixels. The taps are accumulated row by row, so the
+ * inner loop runs along contiguous memory.
+ */
+template<typename T>
+void convolveColumns(
+    const float* in, T* out, std::size_t width, std::size_t height, const std::vector<float>& kernel) {
+    const int size = static_cast<int>(kernel.size());
+    const int offset = size / 2;
+    const int h = static_cast<int>(height);
+
+    forEachRowTile(width, height, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        std::vector<float> accumulator(width);
+        for (std::size_t y = rowBegin; y < rowEnd; ++y) {
+            std::fill(accumulator.begin(), accumulator.end(), 0.f);
+            float* acc = accumulator.data();
+
+            for (int i = 0; i < size; ++i) {
+                const float weight = kernel[i];
+                const float* row = in + std::min(std::max(static_cast<int>(y) + offset - i, 0), h - 1) * width;
+#pragma omp simd
+                for (std::size_t x = 0; x < width; ++x) {
+                    acc[x] += weight * row[x];
+                }
+            }
+
+            T* result = out + y * width;
+#pragma omp simd
+            for (std::size_t x = 0; x < width; ++x) {
+                result[x] = saturate<T>(acc[x]);
+            }
+        }
+    });
+}
+
+/**
+ * Computes central differences into a two-channel image (horizontal, vertical), mapped from [-max, max] to [0, max].
+ * Border pixels repeat the derivative of their inner neighbor. Requires width and height of at least 3.
+ */
+template<typename T>
+void centralDifferences(const T* in, T* out, std::size_t width, std::size_t height) {
+    using Wide = std::conditional_t<std::is_floating_point_v<T>, float, std::int32_t>;
+    constexpr Wide max = static_cast<Wide>(maxValue<T>());
+
+    forEachRowTile(width, height, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        for (std::size_t y = rowBegin; y < rowEnd; ++y) {
+            const std::size_t yc = std::min(std::max<std::size_t>(y, 1), height - 2);
+            const T* row = in + yc * width;
+            const T* above = row - width;
+            const T* below = row + width;
+            T* result = out + y * width * 2;
+
+#pragma omp simd
+            for (std::size_t x = 1; x < width - 1; ++x) {
+                result[x * 2] = static_cast<T>((static_cast<Wide>(row[x + 1]) - row[x - 1] + max) / 2);
+                result[x * 2 + 1] = static_cast<T>((static_cast<Wide>(below[x]) - above[x] + max) / 2);
+            }
+
+            result[0] = result[2];
+            result[1] = result[3];
+            result[(width - 1) * 2] = result[(width - 2) * 2];
+            result[(width - 1) * 2 + 1] = result[(width - 2) * 2 + 1];
+        }
+    });
+}
+
+/**
+ * Writes 255 to every byte of out whose input value is at or above a threshold (or below it, if negated) and 0 to all
+ * others.
+ */
+template<typename T>
+void threshold(const T* in, std::uint8_t* out, std::size_t width, std::size_t height, float threshold, bool negate) {
+    forEachRowTile(width, height, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        const T* src = in + rowBegin * width;
+        std::uint8_t* dst = out + rowBegin * width;
+        const std::size_t count = (rowEnd - rowBegin) * width;
+        const std::uint8_t above = negate ? 0 : 255;
+        const std::uint8_t below = negate ? 255 : 0;
+
+#pragma omp simd
+        for (std::size_t i = 0; i < count; ++i) {
+            dst[i] = static_cast<float>(src[i]) >= threshold ? above : below;
+        }
+    });
+}
+
+/**
+ * Computes the per-pixel maximum of an image and a mask, both rescaled to the channel range of the image.
+ */
+template<typename T, typename M>
+void maximum(const T* in, const M* mask, T* out, std::size_t width, std::size_t height) {
+    forEachRowTile(width, height, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        const std::size_t begin = rowBegin * width;
+        const std::size_t end = rowEnd * width;
+
+        if constexpr (std::is_same_v<T, M>) {
+#pragma omp simd
+            for (std::size_t i = begin; i < end; ++i) {
+                out[i] = std::max(in[i], mask[i]);
+            }
+        } else {
+            constexpr float scale = maxValue<T>() / maxValue<M>();
+#pragma omp simd
+            for (std::size_t i = begin; i < end; ++i) {
+                out[i] = std::max(in[i], saturate<T>(static_cast<float>(mask[i]) * scale));
+            }
+        }
+    });
+}
+
+/**
+ * Writes the length of each horizontal run of pixels at or above a threshold to every pixel of the run (channel 0 of
+ * a two-channel image). Runs touching the left or right border are ignored.
+ */
+template<typename T>
+void horizontalChords(const T* in, std::uint16_t* out, std::size_t width, std::size_t height, float threshold) {
+    forEachRowTile(width, height, [&](std::size_t rowBegin, std::size_t rowEnd) {
+        for (std::size_t y = rowBegin; y < rowEnd; ++y) {
+            const T* row = in + y * width;
+            std::uint16_t* result = out + y * width * 2;
+
+            // Ignore chords touching borders
+            std::size_t x = 0;
+            while (x < width && static_cast<float>(row[x]) >= threshold) {
+                ++x;
+            }
+
+            std::size_t length = 0;
+            for (; x < width; ++x) {
+                if (static_cast<float>(row[x]) >= threshold) {
+                    ++length;
+                } else if (length != 0) {
+                    for (std::size_t x2 = x - length; x2 < x; ++x2) {
+                        result[x2 * 2] = static_cast<std::uint16_t>(length);
+                    }
+                    length = 0;
+                }
+            }
+        }
+    });
+}
+
+/**
+ * Writes the length of each vertical run of pixels at or above a threshold to every pixel of the run (channel 1 of a
+ * two-channel image). Runs touching the top or bottom border are ignored.
+ *
+ * The image is traversed row by row with the state of each column kept in a strip, so that memory is read in order.
+ * Strips of columns are processed in parallel.
+ */
+template<typename T>
+void verticalChords(const T* in, std::uint16_t* out, std::size_t width, std::size_t height, float threshold) {
+    constexpr std::size_t StripWidth = 256;
+    const auto stripCount = static_cast<std::int64_t>((width + StripWidth - 1) / StripWidth);
+    const bool parallel = width * height >= ParallelPixelThreshold && stripCount > 1;
+
+#pragma omp parallel for schedule(dynamic) if (parallel)
+    for (std::int64_t strip = 0; strip < stripCount; ++strip) {
+        const std::size_t xBegin = strip * StripWidth;
+        const std::size_t xEnd = std::min(xBegin + StripWidth, width);
+
+        std::vector<std::uint32_t> lengths(xEnd - xBegin, 0);
+        std::vector<std::uint8_t> started(xEnd - xBegin, 0);
+
+        for (std::size_t y = 0; y < height; ++y) {
+            const T* row = in + y * width;
+            for (std::size_t x = xBegin; x < xEnd; ++x) {
+                const std::size_t c = x - xBegin;
+                const bool inside = static_cast<float>(row[x]) >= threshold;
+
+                // Ignore chords touching borders
+                if (!started[c]) {
+                    started[c] = !inside;
+                } else if (inside) {
+                    ++lengths[c];
+                } else if (lengths[c] != 0) {
+                    for (std::size_t y2 = y - lengths[c]; y2 < y; ++y2) {
+                        out[(x + y2 * width) * 2 + 1] = static_cast<std::uint16_t>(lengths[c]);
+                    }
+                    lengths[c] = 0;
+                }
+            }
+        }
+    }
+}
+
+} // namespace kernels
+
+} // namespace megamol::ImageSeries::util
@@ -21,6 +21,13 @@ class LRUCache {
 public:
     using SizeGetterFunc = std::function<std::size_t(const Value&)>;
 
+    struct Statistics {
+        std::size_t hits = 0;
+        std::size_t misses = 0;
+        std::size_t entryCount = 0;
+        std::size_t byteCount = 0;
+    };
+
     LRUCache(SizeGetterFunc sizeGetter) : sizeGetter(sizeGetter) {}
 
     void clear() {
@@ -51,23 +58,56 @@ public:
 
         auto result = entries.find(key);
         if (result != entries.end()) {
+            ++hitCount;
             result->second.lastAccess = accessCount++;
             return result->second.value;
         } else {
-            Entry entry;
-            entry.lastAccess = accessCount++;
-            entry.value = supplier(key);
-            entry.byteCount = entry.value != nullptr ? sizeGetter(*entry.value) : 0;
+            ++missCount;
+            return insert(key, supplier(key));
+        }
+    }
 
-            totalByteCount += entry.byteCount;
-            entries.insert(std::make_pair(key, entry));
+    /**
+     * Creates the entry for a key ahead of its use, without counting a hit or miss. Entries created this way count as
+     * accessed now, so that they are kept until they are requested. The caller bounds how much is prefetched.
+     *
+     * @return true if the entry has been created, false if it already existed or the cache is disabled
+     */
+    template<typename Func>
+    bool prefetch(const Key& key, Func supplier) {
+        if (maximumSize == 0 || entries.find(key) != entries.end()) {
+            return false;
+        }
+        insert(key, supplier(key));
+        return entries.find(key) != entries.end();
+    }
 
-            cleanUp();
+    bool contains(const Key& key) const {
+        return entries.find(key) != entries.end();
+    }
 
-            return entry.value;
+    void erase(const Key& key) {
+        auto result = entries.find(key);
+        if (result != entries.end()) {
+            totalByteCount -= result->second.byteCount;
+            entries.erase(result);
         }
     }
 
+    Statistics getStatistics() const {
+        Statistics stats;
+        stats.hits = hitCount;
+        stats.misses = missCount;
+        stats.entryCount = entries.size();
+        stats.byteCount = totalByteCount;
+        return stats;
+    }
+
+    void resetStatistics() {
+        hitCount = 0;
+        missCount = 0;
+    }
+
     std::shared_ptr<const Value> find(const Key& key) {
         if (maximumSize == 0) {
             throw std::runtime_error("Find function is not allowed if cache size is zero.");
@@ -75,9 +115,11 @@ public:
 
         auto result = entries.find(key);
         if (result != entries.end()) {
+            ++hitCount;
             result->second.lastAccess = accessCount++;
             return result->second.value;
         } else {
+            ++missCount;
             return nullptr;
         }
     }
@@ -100,6 +142,20 @@ private:
         std::size_t byteCount = 0;
     };
 
+    std::shared_ptr<const Value> insert(const Key& key, std::shared_ptr<const Value> value) {
+        Entry entry;
+        entry.lastAccess = accessCount++;
+        entry.value = std::move(value);
+        entry.byteCount = entry.value != nullptr ? sizeGetter(*entry.value) : 0;
+
+        totalByteCount += entry.byteCount;
+        entries.insert(std::make_pair(key, entry));
+
+        cleanUp();
+
+        return entry.value;
+    }
+
     void cleanUp() {
         if (maximumSize == 0) {
             entries.clear();
@@ -130,6 +186,8 @@ private:
     mutable std::size_t accessCount = 0;
     std::size_t totalByteCount = 0;
     std::size_t maximumSize = 0;
+    std::size_t hitCount = 0;
+    std::size_t missCount = 0;
     float cleanupFactor = 0.9;
 };
 
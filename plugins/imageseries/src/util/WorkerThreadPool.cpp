@@ -24,7 +24,7 @@ bool Job::await() {
     if (auto data = jobData.lock()) {
         if (data->isPending()) {
             std::unique_lock<std::mutex> lock(data->mutex);
-            data->condition.wait(lock, [&] { return data->isPending(); });
+            data->condition.wait(lock, [&] { return !data->isPending(); });
         }
         return data->status == Status::DONE;
     } else {
@@ -48,7 +48,7 @@ bool Job::execute() {
             return true;
 
         case Status::ACTIVE:
-            data->condition.wait(lock, [&] { return data->isPending(); });
+            data->condition.wait(lock, [&] { return !data->isPending(); });
             return data->status == Status::DONE;
 
         case Status::DONE:
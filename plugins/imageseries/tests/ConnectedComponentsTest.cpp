@@ -0,0 +1,138 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <queue>
+#include <vector>
+
+#include "util/ConnectedComponents.h"
+
+#include "mmtest/Check.h"
+
+using megamol::ImageSeries::util::ConnectedComponents;
+using Index = ConnectedComponents::Index;
+using Connectivity = ConnectedComponents::Connectivity;
+
+namespace {
+
+/** Random mask of values 0 (background) to classes, foreground pixels are connected if their values match */
+std::vector<std::uint8_t> makeMask(
+    std::size_t width, std::size_t height, float density, int classes, std::uint32_t seed) {
+    std::vector<std::uint8_t> mask(width * height);
+    for (auto& value : mask) {
+        seed = seed * 1664525u + 1013904223u;
+        const float r = static_cast<float>(seed >> 8) / static_cast<float>(1u << 24);
+        value = r < density ? static_cast<std::uint8_t>(1 + (seed >> 4) % classes) : 0;
+    }
+    return mask;
+}
+
+/** Sequential flood fill, as the labelling of the filters worked before the union-find */
+Index labelBFS(std::size_t width, std::size_t height, Connectivity connectivity, std::vector<std::uint8_t> const& mask,
+    std::vector<Index>& labels) {
+    labels.assign(width * height, ConnectedComponents::Background);
+    const bool diagonal = connectivity == Connectivity::Eight;
+    Index count = 0;
+    std::queue<std::size_t> queue;
+    for (std::size_t start = 0; start < mask.size(); ++start) {
+        if (mask[start] == 0 || labels[start] != ConnectedComponents::Background) {
+            continue;
+        }
+        labels[start] = ++count;
+        queue.push(start);
+        while (!queue.empty()) {
+            const std::size_t index = queue.front();
+            queue.pop();
+            const auto x = static_cast<std::int64_t>(index % width);
+            const auto y = static_cast<std::int64_t>(index / width);
+            for (std::int64_t dy = -1; dy <= 1; ++dy) {
+                for (std::int64_t dx = -1; dx <= 1; ++dx) {
+                    if ((dx == 0 && dy == 0) || (!diagonal && dx != 0 && dy != 0)) {
+                        continue;
+                    }
+                    const std::int64_t nx = x + dx;
+                    const std::int64_t ny = y + dy;
+                    if (nx < 0 || ny < 0 || nx >= static_cast<std::int64_t>(width) ||
+                        ny >= static_cast<std::int64_t>(height)) {
+                        continue;
+                    }
+                    const std::size_t neighbor = nx + ny * width;
+                    if (mask[neighbor] == mask[index] && labels[neighbor] == ConnectedComponents::Background) {
+                        labels[neighbor] = count;
+                        queue.push(neighbor);
+                    }
+                }
+            }
+        }
+    }
+    return count;
+}
+
+/** The labellings describe the same components if there is a one-to-one mapping between their labels */
+bool sameComponents(std::vector<Index> const& a, std::vector<Index> const& b, Index count) {
+    std::vector<Index> aToB(count + 1, ConnectedComponents::Background);
+    std::vector<Index> bToA(count + 1, ConnectedComponents::Background);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if ((a[i] == ConnectedComponents::Background) != (b[i] == ConnectedComponents::Background)) {
+            return false;
+        }
+        if (a[i] == ConnectedComponents::Background) {
+            continue;
+        }
+        if (a[i] > count || b[i] > count) {
+            return false;
+        }
+        if (aToB[a[i]] == ConnectedComponents::Background && bToA[b[i]] == ConnectedComponents::Background) {
+            aToB[a[i]] = b[i];
+            bToA[b[i]] = a[i];
+        } else if (aToB[a[i]] != b[i] || bToA[b[i]] != a[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void checkMask(std::size_t width, std::size_t height, float density, int classes, std::uint32_t seed) {
+    const auto mask = makeMask(width, height, density, classes, seed);
+    for (auto connectivity : {Connectivity::Four, Connectivity::Eight}) {
+        std::vector<Index> expected, labels;
+        const Index expectedCount = labelBFS(width, height, connectivity, mask, expected);
+        const Index count = ConnectedComponents::label(
+            width, height, connectivity, [&](Index index) { return mask[index] != 0; },
+            [&](Index a, Index b) { return mask[a] == mask[b]; }, labels);
+
+        CHECK(labels.size() == mask.size());
+        CHECK(count == expectedCount);
+        if (count != expectedCount || !sameComponents(expected, labels, count)) {
+            std::fprintf(stderr, "%zux%zu, density %.2f, %d classes, seed %u, %s connectivity: labels differ\n", width,
+                height, density, classes, seed, connectivity == Connectivity::Four ? "four" : "eight");
+            ++megamol::test::failures;
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    // degenerate and single band images
+    checkMask(0, 0, 0.5f, 1, 1);
+    checkMask(1, 1, 1.0f, 1, 2);
+    checkMask(1, 300, 0.6f, 1, 3);
+    checkMask(300, 1, 0.6f, 1, 4);
+    checkMask(50, 40, 0.6f, 2, 5);
+
+    // above the parallel threshold, components span many bands around the percolation threshold
+    std::uint32_t seed = 100;
+    for (float density : {0.3f, 0.5f, 0.6f, 0.9f}) {
+        for (int classes : {1, 3}) {
+            checkMask(700, 513, density, classes, ++seed);
+            checkMask(513, 1100, density, classes, ++seed);
+        }
+    }
+
+    return megamol::test::Result();
+}
@@ -0,0 +1,86 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <cstddef>
+#include <memory>
+
+#include "util/LRUCache.h"
+
+#include "mmtest/Check.h"
+
+using megamol::ImageSeries::util::LRUCache;
+
+namespace {
+
+using Cache = LRUCache<int, int>;
+
+constexpr std::size_t Capacity = 10;
+
+std::shared_ptr<const int> make(int key) {
+    return std::make_shared<const int>(key);
+}
+
+Cache makeCache() {
+    Cache cache([](const int&) { return std::size_t{1}; });
+    cache.setMaximumSize(Capacity);
+    return cache;
+}
+
+/** Prefetched entries are kept until requested, entries in use are evicted in order of their last access */
+void testPrefetchSurvivesFullCache() {
+    auto cache = makeCache();
+
+    // the frames played so far fill the cache
+    for (int key = 0; key < static_cast<int>(Capacity); ++key) {
+        cache.findOrCreate(key, make);
+    }
+    CHECK(cache.getStatistics().entryCount == Capacity);
+
+    // prefetching the next frames pushes out the oldest played frames
+    for (int key = 10; key < 13; ++key) {
+        CHECK(cache.prefetch(key, make));
+        CHECK(!cache.prefetch(key, make));
+    }
+    for (int key = 10; key < 13; ++key) {
+        CHECK(cache.contains(key));
+    }
+    CHECK(!cache.contains(0));
+    CHECK(cache.contains(Capacity - 1));
+
+    // frames played while the prefetched ones wait evict older frames instead
+    for (int key = 100; key < 103; ++key) {
+        cache.findOrCreate(key, make);
+    }
+    cache.resetStatistics();
+    for (int key = 10; key < 13; ++key) {
+        auto value = cache.findOrCreate(key, [](int) -> std::shared_ptr<const int> { return nullptr; });
+        CHECK(value != nullptr && *value == key);
+    }
+    auto const stats = cache.getStatistics();
+    CHECK(stats.hits == 3);
+    CHECK(stats.misses == 0);
+}
+
+/** Prefetching does nothing while the cache is disabled */
+void testPrefetchDisabled() {
+    Cache cache([](const int&) { return std::size_t{1}; });
+    bool called = false;
+    CHECK(!cache.prefetch(1, [&](int key) {
+        called = true;
+        return make(key);
+    }));
+    CHECK(!called);
+    CHECK(!cache.contains(1));
+}
+
+} // namespace
+
+int main() {
+    testPrefetchSurvivesFullCache();
+    testPrefetchDisabled();
+
+    return megamol::test::Result();
+}
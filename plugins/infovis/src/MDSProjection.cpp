@@ -2,11 +2,14 @@
 
 #include "datatools/table/TableDataCall.h"
 #include "mmcore/param/BoolParam.h"
+#include "mmcore/param/EnumParam.h"
 #include "mmcore/param/IntParam.h"
 
 #include "MDSProjection.h"
 #include <Eigen/Dense>
 #include <Eigen/SVD>
+#include <algorithm>
+#include <limits>
 #include <set>
 #include <sstream>
 
@@ -21,6 +24,9 @@ MDSProjection::MDSProjection()
         , dataOutSlot("dataOut", "Ouput")
         , dataInSlot("dataIn", "Input")
         , reduceToNSlot("nComponents", "Number of components (dimensions) to keep")
+        , methodSlot("method", "Classic MDS is exact but needs O(n^2) memory, landmark and pivot MDS approximate it "
+                               "from the distances to a subset of the points")
+        , landmarkCountSlot("landmarkCount", "Number of landmarks or pivots used by landmark and pivot MDS")
         , datahash(0)
         , dataInHash(0)
         , columnInfos() {
@@ -36,6 +42,15 @@ MDSProjection::MDSProjection()
 
     reduceToNSlot << new ::megamol::core::param::IntParam(2);
     this->MakeSlotAvailable(&reduceToNSlot);
+
+    methodSlot << new ::megamol::core::param::EnumParam(0);
+    methodSlot.Param<param::EnumParam>()->SetTypePair(0, "classic");
+    methodSlot.Param<param::EnumParam>()->SetTypePair(1, "landmark");
+    methodSlot.Param<param::EnumParam>()->SetTypePair(2, "pivot");
+    this->MakeSlotAvailable(&methodSlot);
+
+    landmarkCountSlot << new ::megamol::core::param::IntParam(100, 3);
+    this->MakeSlotAvailable(&landmarkCountSlot);
 }
 
 MDSProjection::~MDSProjection() {
@@ -116,7 +131,7 @@ bool MDSProjection::getHashCallback(core::Call& c) {
 bool megamol::infovis::MDSProjection::dataProjection(megamol::datatools::table::TableDataCall* inCall) {
     // Test if inData has changed and if slots have changed
     if (this->dataInHash == inCall->DataHash()) {
-        if (!reduceToNSlot.IsDirty()) {
+        if (!reduceToNSlot.IsDirty() && !methodSlot.IsDirty() && !landmarkCountSlot.IsDirty()) {
             return true; // Nothing to do
         }
     }
@@ -141,10 +156,23 @@ bool megamol::infovis::MDSProjection::dataProjection(megamol::datatools::table::
         }
     }
 
-    // generate dissimilarity Matrix( squared euclidean Distance matrix)
-    Eigen::MatrixXd delta2 = euclideanDissimilarityMatrix(inDataMat).array().pow(2);
-    // compute MDS
-    Eigen::MatrixXd result = classicMds(delta2, outputDimCount);
+    const int landmarkCount = this->landmarkCountSlot.Param<core::param::IntParam>()->Value();
+
+    Eigen::MatrixXd result;
+    switch (this->methodSlot.Param<core::param::EnumParam>()->Value()) {
+    case 1:
+        result = landmarkMds(inDataMat, outputDimCount, landmarkCount);
+        break;
+    case 2:
+        result = pivotMds(inDataMat, outputDimCount, landmarkCount);
+        break;
+    default: {
+        // generate dissimilarity Matrix( squared euclidean Distance matrix)
+        Eigen::MatrixXd delta2 = euclideanDissimilarityMatrix(inDataMat).array().pow(2);
+        // compute MDS
+        result = classicMds(delta2, outputDimCount);
+    } break;
+    }
 
     // generate new columns
     this->columnInfos.clear();
@@ -170,6 +198,8 @@ bool megamol::infovis::MDSProjection::dataProjection(megamol::datatools::table::
     this->dataInHash = inCall->DataHash();
     this->datahash++;
     reduceToNSlot.ResetDirty();
+    methodSlot.ResetDirty();
+    landmarkCountSlot.ResetDirty();
 
     return true;
 }
@@ -228,6 +258,119 @@ Eigen::MatrixXd megamol::infovis::MDSProjection::classicMds(
     return result;
 }
 
+Eigen::MatrixXd megamol::infovis::MDSProjection::landmarkDistances(
+    Eigen::MatrixXd const& dataMatrix, int landmarkCount, std::vector<int>& landmarks) {
+    const int rowsCount = dataMatrix.rows();
+    landmarkCount = std::min(landmarkCount, rowsCount);
+
+    // Row-major copy, so that the distance computations read contiguous memory
+    const Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> points = dataMatrix;
+
+    Eigen::MatrixXd distances(rowsCount, landmarkCount);
+    Eigen::VectorXd minDistances = Eigen::VectorXd::Constant(rowsCount, std::numeric_limits<double>::max());
+
+    landmarks.clear();
+    int next = 0;
+    for (int landmark = 0; landmark < landmarkCount; landmark++) {
+        landmarks.push_back(next);
+        const Eigen::RowVectorXd position = points.row(next);
+
+#pragma omp parallel for
+        for (int row = 0; row < rowsCount; row++) {
+            const double distance = (points.row(row) - position).squaredNorm();
+            distances(row, landmark) = distance;
+            minDistances(row) = std::min(minDistances(row), distance);
+        }
+
+        minDistances.maxCoeff(&next);
+    }
+
+    return distances;
+}
+
+Eigen::MatrixXd megamol::infovis::MDSProjection::landmarkMds(
+    Eigen::MatrixXd const& dataMatrix, int outputDimension, int landmarkCount) {
+    std::vector<int> landmarks;
+    Eigen::MatrixXd distances = landmarkDistances(dataMatrix, landmarkCount, landmarks);
+    const int count = landmarks.size();
+
+    // Classic MDS of the landmarks
+    Eigen::MatrixXd landmarkMatrix(count, count);
+    for (int i = 0; i < count; i++) {
+        landmarkMatrix.row(i) = distances.row(landmarks[i]);
+    }
+    const Eigen::VectorXd meanDistances = landmarkMatrix.colwise().mean().transpose();
+
+    Eigen::MatrixXd B = landmarkMatrix;
+    B.colwise() -= meanDistances;
+    B.rowwise() -= meanDistances.transpose();
+    B.array() += meanDistances.mean();
+    B *= -0.5;
+
+    SelfAdjointEigenSolver<MatrixXd> eigSolver(B);
+
+    // Pseudoinverse of the landmark coordinates, eigenvalues are sorted ascending
+    MatrixXd pseudoInverse = MatrixXd::Zero(count, outputDimension);
+    for (int i = 0; i < std::min(outputDimension, count); ++i) {
+        const double eigVal = eigSolver.eigenvalues()(count - 1 - i);
+        if (eigVal > 0.0) {
+            pseudoInverse.col(i) = eigSolver.eigenvectors().col(count - 1 - i) / std::sqrt(eigVal);
+        }
+    }
+
+    // Triangulate all points from their distances to the landmarks
+    distances.rowwise() -= meanDistances.transpose();
+    return -0.5 * distances * pseudoInverse;
+}
+
+Eigen::MatrixXd megamol::infovis::MDSProjection::pivotMds(
+    Eigen::MatrixXd const& dataMatrix, int outputDimension, int pivotCount) {
+    std::vector<int> pivots;
+    const Eigen::MatrixXd distances = landmarkDistances(dataMatrix, pivotCount, pivots);
+    const int rowsCount = distances.rows();
+    const int count = pivots.size();
+
+    // Double centering of the columns of the pivots
+    Eigen::MatrixXd C = distances;
+    const Eigen::VectorXd rowMeans = C.rowwise().mean();
+    const Eigen::RowVectorXd colMeans = C.colwise().mean();
+    const double mean = C.mean();
+    C.colwise() -= rowMeans;
+    C.rowwise() -= colMeans;
+    C.array() += mean;
+    C *= -0.5;
+
+    SelfAdjointEigenSolver<MatrixXd> eigSolver(C.transpose() * C);
+
+    // C * v = sigma * u for the singular values sigma of C. The eigenvalues of the full centered distance matrix are
+    // proportional to sigma, so the axes are scaled by sqrt(sigma) up to a common factor.
+    MatrixXd result = MatrixXd::Zero(rowsCount, outputDimension);
+    for (int i = 0; i < std::min(outputDimension, count); ++i) {
+        const double sigma = std::sqrt(std::max(eigSolver.eigenvalues()(count - 1 - i), 0.0));
+        if (sigma > 0.0) {
+            result.col(i) = C * eigSolver.eigenvectors().col(count - 1 - i) / std::sqrt(sigma);
+        }
+    }
+
+    // The common factor depends on how the pivots sample the data. It is fitted to the distances to the pivots in
+    // the least squares sense.
+    double distanceProducts = 0.0;
+    double squaredDistances = 0.0;
+#pragma omp parallel for reduction(+ : distanceProducts, squaredDistances)
+    for (int row = 0; row < rowsCount; row++) {
+        for (int pivot = 0; pivot < count; pivot++) {
+            const double layoutDistance = (result.row(row) - result.row(pivots[pivot])).norm();
+            distanceProducts += layoutDistance * std::sqrt(distances(row, pivot));
+            squaredDistances += layoutDistance * layoutDistance;
+        }
+    }
+    if (squaredDistances > 0.0) {
+        result *= distanceProducts / squaredDistances;
+    }
+
+    return result;
+}
+
 Eigen::MatrixXd megamol::infovis::MDSProjection::bMatrix(
     Eigen::MatrixXd X, Eigen::MatrixXd W, Eigen::MatrixXd dissimilarityMatrix) {
     assert(X.rows() == W.rows());
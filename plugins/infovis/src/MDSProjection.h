@@ -41,6 +41,18 @@ public:
 
     static Eigen::MatrixXd classicMds(Eigen::MatrixXd squaredDissimilarityMatrix, int outputDimension);
 
+    /**
+     * Landmark MDS (de Silva and Tenenbaum): classic MDS of a set of landmarks, all other points are placed by
+     * triangulation from their distances to the landmarks. Needs O(n * landmarkCount) memory.
+     */
+    static Eigen::MatrixXd landmarkMds(Eigen::MatrixXd const& dataMatrix, int outputDimension, int landmarkCount);
+
+    /**
+     * Pivot MDS (Brandes and Pich): approximates the eigenvectors of the double-centered distance matrix from its
+     * columns of a set of pivots. Needs O(n * pivotCount) memory.
+     */
+    static Eigen::MatrixXd pivotMds(Eigen::MatrixXd const& dataMatrix, int outputDimension, int pivotCount);
+
     static Eigen::MatrixXd smacofMds(Eigen::MatrixXd squaredDissimilarityMatrix, int outputDimension = 2,
         int countSteps = 100, Eigen::MatrixXd weightsMatrix = Eigen::MatrixXd::Ones(1, 1), double tolerance = 1e-3);
 
@@ -58,6 +70,14 @@ protected:
     void release() override;
 
 private:
+    /**
+     * Selects landmarks by max-min sampling, i.e., each landmark is the point farthest from all previous ones.
+     *
+     * @return The squared distances of all points (rows) to the landmarks (columns)
+     */
+    static Eigen::MatrixXd landmarkDistances(
+        Eigen::MatrixXd const& dataMatrix, int landmarkCount, std::vector<int>& landmarks);
+
     static Eigen::MatrixXd bMatrix(Eigen::MatrixXd X, Eigen::MatrixXd W, Eigen::MatrixXd dissimilarityMatrix);
 
     static Eigen::MatrixXd vMatrix(Eigen::MatrixXd W);
@@ -78,6 +98,12 @@ private:
     /** Parameter slot for target number of dimensions */
     ::megamol::core::param::ParamSlot reduceToNSlot;
 
+    /** Parameter slot for the MDS variant */
+    ::megamol::core::param::ParamSlot methodSlot;
+
+    /** Parameter slot for the number of landmarks or pivots */
+    ::megamol::core::param::ParamSlot landmarkCountSlot;
+
     /** ID of the current frame */
     // int frameID; //TODO: unknown
 
@@ -5,9 +5,15 @@
 #include "mmcore/param/IntParam.h"
 
 #include <Eigen/Dense>
-#include <Eigen/SVD>
+#include <algorithm>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 using namespace megamol;
 using namespace megamol::infovis;
@@ -21,6 +27,8 @@ PCAProjection::PCAProjection()
         , reduceToNSlot("nComponents", "Number of components (dimensions) to keep")
         , scaleSlot("scale", "Set to scale each column to unit variance")
         , centerSlot("center", "Set to shift the mean centroid to the origin")
+        , fitSampleSlot("fitSampleSize",
+              "Number of rows the components are fitted on, 0 fits on all rows. All rows are projected regardless")
         , datahash(0)
         , dataInHash(0)
         , columnInfos() {
@@ -42,6 +50,9 @@ PCAProjection::PCAProjection()
 
     scaleSlot << new ::megamol::core::param::BoolParam(false);
     this->MakeSlotAvailable(&scaleSlot);
+
+    fitSampleSlot << new ::megamol::core::param::IntParam(0, 0);
+    this->MakeSlotAvailable(&fitSampleSlot);
 }
 
 
@@ -55,6 +66,52 @@ bool PCAProjection::create() {
 
 void PCAProjection::release() {}
 
+namespace {
+
+/** Rows gathered and converted to double before they are added to the moments */
+constexpr int64_t blockSize = 4096;
+
+/** Count, mean and sum of squared deviations from the mean of a set of rows */
+struct Moments {
+    double count = 0.0;
+    Eigen::VectorXd mean;
+    Eigen::MatrixXd m2;
+
+    explicit Moments(Eigen::Index columns)
+            : mean(Eigen::VectorXd::Zero(columns))
+            , m2(Eigen::MatrixXd::Zero(columns, columns)) {}
+
+    /** Merges the moments of a disjoint set of rows (Chan et al.), only the lower triangle of m2 is updated */
+    void merge(double otherCount, Eigen::VectorXd const& otherMean, Eigen::MatrixXd const& otherM2) {
+        if (otherCount == 0.0) {
+            return;
+        }
+        const double total = count + otherCount;
+        const Eigen::VectorXd delta = otherMean - mean;
+        m2.triangularView<Eigen::Lower>() += otherM2;
+        m2.selfadjointView<Eigen::Lower>().rankUpdate(delta, count * otherCount / total);
+        mean += delta * (otherCount / total);
+        count = total;
+    }
+};
+
+/** Maps a sample index to a row, picking one random row out of each of the equally sized strata */
+inline int64_t sampleRow(int64_t sample, int64_t sampleCount, int64_t rowCount) {
+    if (sampleCount == rowCount) {
+        return sample;
+    }
+    const int64_t begin = sample * rowCount / sampleCount;
+    const int64_t end = (sample + 1) * rowCount / sampleCount;
+    // splitmix64, so that the sample does not depend on the number of threads
+    uint64_t z = static_cast<uint64_t>(sample) + 0x9e3779b97f4a7c15ull;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    z ^= z >> 31;
+    return begin + static_cast<int64_t>(z % static_cast<uint64_t>(end - begin));
+}
+
+} // namespace
+
 bool PCAProjection::getDataCallback(core::Call& c) {
 
     try {
@@ -125,20 +182,23 @@ bool megamol::infovis::PCAProjection::project(megamol::datatools::table::TableDa
 
     // check if inData has changed and if Slots have changed
     if (this->dataInHash == inCall->DataHash()) {
-        if (!reduceToNSlot.IsDirty() && !scaleSlot.IsDirty() && !centerSlot.IsDirty()) {
+        if (!reduceToNSlot.IsDirty() && !scaleSlot.IsDirty() && !centerSlot.IsDirty() && !fitSampleSlot.IsDirty()) {
             return true; // Nothing to do
         }
     }
 
 
-    auto columnCount = inCall->GetColumnsCount();
-    auto column_infos = inCall->GetColumnsInfos();
-    auto rowsCount = inCall->GetRowsCount();
-    auto inData = inCall->GetData();
+    const auto columnCount = static_cast<Eigen::Index>(inCall->GetColumnsCount());
+    const auto rowsCount = static_cast<int64_t>(inCall->GetRowsCount());
+    const float* inData = inCall->GetData();
 
-    unsigned int outputDimCount = this->reduceToNSlot.Param<core::param::IntParam>()->Value();
+    int outputDimCount = this->reduceToNSlot.Param<core::param::IntParam>()->Value();
     bool center = this->centerSlot.Param<core::param::BoolParam>()->Value();
     bool scale = this->scaleSlot.Param<core::param::BoolParam>()->Value();
+    int64_t sampleCount = this->fitSampleSlot.Param<core::param::IntParam>()->Value();
+    if (sampleCount <= 0 || sampleCount > rowsCount) {
+        sampleCount = rowsCount;
+    }
 
 
     if (outputDimCount <= 0 || outputDimCount > columnCount) {
@@ -146,92 +206,133 @@ bool megamol::infovis::PCAProjection::project(megamol::datatools::table::TableDa
             _T("%hs: No valid Dimension Count has been given\n"), ClassName());
         return false;
     }
+    if (sampleCount < 2) {
+        megamol::core::utility::log::Log::DefaultLog.WriteError(
+            _T("%hs: At least two rows are needed to fit the components\n"), ClassName());
+        return false;
+    }
 
-    // Load data in a Matrix
-    Eigen::MatrixXd inDataMat = Eigen::MatrixXd(rowsCount, columnCount);
-    for (int row = 0; row < rowsCount; row++) {
-        for (int col = 0; col < columnCount; col++) {
-            inDataMat(row, col) = inData[row * columnCount + col];
+    // Accumulate mean and covariance in a single pass without copying the data: every thread merges blocks of
+    // (sampled) rows into its own moments, which are merged in thread order, so the result is reproducible.
+    const int64_t blockCount = (sampleCount + blockSize - 1) / blockSize;
+    std::vector<Moments> threadMoments;
+
+#pragma omp parallel
+    {
+#pragma omp single
+        {
+#ifdef _OPENMP
+            threadMoments.assign(omp_get_num_threads(), Moments(columnCount));
+#else
+            threadMoments.assign(1, Moments(columnCount));
+#endif
+        }
+#ifdef _OPENMP
+        Moments& moments = threadMoments[omp_get_thread_num()];
+#else
+        Moments& moments = threadMoments[0];
+#endif
+        Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> block(blockSize, columnCount);
+        Eigen::MatrixXd blockM2(columnCount, columnCount);
+
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < blockCount; ++b) {
+            const int64_t first = b * blockSize;
+            const int64_t count = std::min(blockSize, sampleCount - first);
+            for (int64_t i = 0; i < count; ++i) {
+                const float* row = inData + sampleRow(first + i, sampleCount, rowsCount) * columnCount;
+                block.row(i) = Eigen::Map<const Eigen::RowVectorXf>(row, columnCount).cast<double>();
+            }
+
+            auto rows = block.topRows(count);
+            const Eigen::VectorXd blockMean = rows.colwise().mean().transpose();
+            rows.rowwise() -= blockMean.transpose();
+            blockM2.setZero();
+            blockM2.selfadjointView<Eigen::Lower>().rankUpdate(rows.transpose());
+
+            moments.merge(static_cast<double>(count), blockMean, blockM2);
         }
     }
 
-    // calculate mean for each column
-    Eigen::VectorXd mean_vector(columnCount);
-    mean_vector = inDataMat.colwise().mean();
-
-
-    // prepare data
-    if (center) {
-        // substract mean columnwise
-        for (int col = 0; col < columnCount; col++) {
-            inDataMat.col(col) -= Eigen::VectorXd::Constant(rowsCount, mean_vector(col));
-        }
+    Moments total(columnCount);
+    for (auto const& moments : threadMoments) {
+        total.merge(moments.count, moments.mean, moments.m2);
     }
+    threadMoments.clear();
 
+    // Without centering, the covariance is taken around the origin, as "R ggfortify" does
+    const Eigen::VectorXd offset = center ? total.mean : Eigen::VectorXd::Zero(columnCount);
+    if (!center) {
+        total.m2.selfadjointView<Eigen::Lower>().rankUpdate(total.mean, total.count);
+    }
+    MatrixXd covarianceMatrix = total.m2.selfadjointView<Eigen::Lower>();
+    covarianceMatrix /= total.count - 1.0;
 
+    // scale data to unit variance by dividing by standard deviation
+    Eigen::VectorXd invStdDev = Eigen::VectorXd::Ones(columnCount);
     if (scale) {
-        // scale data to unit variance by dividing by standard deviation
-        Eigen::VectorXd stdDev(columnCount);
-        for (int col = 0; col < columnCount; col++) {
-            stdDev(col) = sqrt(inDataMat.col(col).cwiseProduct(inDataMat.col(col)).sum() / (rowsCount - 1));
-            inDataMat.col(col) /= stdDev(col);
-        }
+        invStdDev = covarianceMatrix.diagonal().cwiseSqrt().cwiseInverse();
+        covarianceMatrix = invStdDev.asDiagonal() * covarianceMatrix * invStdDev.asDiagonal();
     }
 
 
-    // calculate CovarianceMatrix
-    MatrixXd covarianceMatrix = inDataMat;
-
-    /** if center is off: "R ggfortify" doesn't substract mean for the covariance matrix
-    //substract mean for cov Matrix
-    mean_vector = inDataMat.colwise().mean();
-    for (int col = 0; col < columnCount; col++) {
-        covarianceMatrix.col(col) -= Eigen::VectorXd::Constant(rowsCount, mean_vector(col));
-    }*/
-
-
-    covarianceMatrix = covarianceMatrix.transpose() * covarianceMatrix;
-    covarianceMatrix = covarianceMatrix / (float) (rowsCount - 1);
-
-
-    // calculate Eigenvalues and Eigenvectors
-    EigenSolver<MatrixXd> eigSolver(covarianceMatrix);
-
-    VectorXd eigVal = eigSolver.eigenvalues().real();
-    MatrixXd eigVec = eigSolver.eigenvectors().real();
-
-    // sort eigenvalues (with index): descending
-    // each eigenvalue represents the variance
-    typedef std::pair<float, int> eigenPair;
-    std::vector<eigenPair> sorted;
-    for (unsigned int i = 0; i < columnCount; ++i) {
-        sorted.push_back(std::make_pair(eigVal(i), i));
-    }
-    std::sort(sorted.begin(), sorted.end(), [&sorted](eigenPair& a, eigenPair& b) { return a.first > b.first; });
-
-    // create Matrix out of sorted (and selected) eigenvectors
-    MatrixXd eigVecBasis = MatrixXd(columnCount, outputDimCount);
-    for (unsigned int i = 0; i < outputDimCount; ++i) {
-        eigVecBasis.col(i) = eigVec.col(sorted[i].second);
+    // calculate Eigenvalues and Eigenvectors, each eigenvalue represents the variance
+    SelfAdjointEigenSolver<MatrixXd> eigSolver(covarianceMatrix);
+    if (eigSolver.info() != Eigen::Success) {
+        megamol::core::utility::log::Log::DefaultLog.WriteError(
+            _T("%hs: Eigendecomposition of the covariance matrix failed\n"), ClassName());
+        return false;
     }
 
+    // eigenvalues are ascending, create Matrix out of the last (and selected) eigenvectors
+    const VectorXd& eigVal = eigSolver.eigenvalues();
+    MatrixXd eigVecBasis = eigSolver.eigenvectors().rightCols(outputDimCount).rowwise().reverse();
 
-    // calculate PCA
-    MatrixXd result = inDataMat * eigVecBasis;
+    // fold centering and scaling into the projection: result = (x - offset) * diag(1 / stdDev) * basis
+    const Eigen::MatrixXf basis = (invStdDev.asDiagonal() * eigVecBasis).cast<float>();
+    const Eigen::RowVectorXf shift = (offset.transpose() * invStdDev.asDiagonal() * eigVecBasis).cast<float>();
 
+    std::stringstream debug;
+    debug << ClassName() << ": fitted on " << sampleCount << " of " << rowsCount << " rows, explained variance";
+    const double totalVariance = eigVal.sum();
+    for (int i = 0; i < outputDimCount; ++i) {
+        debug << " " << eigVal(columnCount - 1 - i) / totalVariance;
+    }
+    megamol::core::utility::log::Log::DefaultLog.WriteInfo(debug.str().c_str());
 
-    //// center
-    // mean_vector = result.colwise().mean();
-    //// substract mean adjusted Matrix (shift to mean to zero)
-    // for (int col = 0; col < result.cols(); col++) {
-    //    result.col(col) -= Eigen::VectorXd::Constant(rowsCount, mean_vector(col));
-    //}
 
+    // calculate PCA, every row is projected directly into the output
+    this->data.resize(static_cast<size_t>(rowsCount) * outputDimCount);
+    Eigen::VectorXf minimum = Eigen::VectorXf::Constant(outputDimCount, std::numeric_limits<float>::max());
+    Eigen::VectorXf maximum = Eigen::VectorXf::Constant(outputDimCount, std::numeric_limits<float>::lowest());
+    const int64_t outputBlockCount = (rowsCount + blockSize - 1) / blockSize;
+
+#pragma omp parallel
+    {
+        Eigen::VectorXf localMinimum = minimum;
+        Eigen::VectorXf localMaximum = maximum;
+
+#pragma omp for schedule(static)
+        for (int64_t b = 0; b < outputBlockCount; ++b) {
+            const int64_t first = b * blockSize;
+            const int64_t count = std::min(blockSize, rowsCount - first);
+            Eigen::Map<const Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> in(
+                inData + first * columnCount, count, columnCount);
+            Eigen::Map<Eigen::Matrix<float, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>> out(
+                this->data.data() + first * outputDimCount, count, outputDimCount);
+            out.noalias() = in * basis;
+            out.rowwise() -= shift;
+            localMinimum = localMinimum.cwiseMin(out.colwise().minCoeff().transpose());
+            localMaximum = localMaximum.cwiseMax(out.colwise().maxCoeff().transpose());
+        }
 
-    std::stringstream debug;
-    debug << std::endl << result << std::endl;
+#pragma omp critical
+        {
+            minimum = minimum.cwiseMin(localMinimum);
+            maximum = maximum.cwiseMax(localMaximum);
+        }
+    }
 
-    megamol::core::utility::log::Log::DefaultLog.WriteInfo(debug.str().c_str());
 
     // generate new columns
     this->columnInfos.clear();
@@ -241,17 +342,8 @@ bool megamol::infovis::PCAProjection::project(megamol::datatools::table::TableDa
         columnInfos[indexX]
             .SetName("PC" + std::to_string(indexX))
             .SetType(megamol::datatools::table::TableDataCall::ColumnType::QUANTITATIVE)
-            .SetMinimumValue(result.col(indexX).minCoeff())
-            .SetMaximumValue(result.col(indexX).maxCoeff());
-    }
-
-    // Result Matrix into Output
-    this->data.clear();
-    this->data.reserve(rowsCount * outputDimCount);
-
-    for (size_t row = 0; row < rowsCount; row++) {
-        for (size_t col = 0; col < outputDimCount; col++)
-            this->data.push_back(result(row, col));
+            .SetMinimumValue(minimum(indexX))
+            .SetMaximumValue(maximum(indexX));
     }
 
 
@@ -260,6 +352,7 @@ bool megamol::infovis::PCAProjection::project(megamol::datatools::table::TableDa
     reduceToNSlot.ResetDirty();
     scaleSlot.ResetDirty();
     centerSlot.ResetDirty();
+    fitSampleSlot.ResetDirty();
 
     return true;
 }
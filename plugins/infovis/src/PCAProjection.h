@@ -60,6 +60,9 @@ private:
     ::megamol::core::param::ParamSlot scaleSlot;
     ::megamol::core::param::ParamSlot centerSlot;
 
+    /** Parameter slot for the number of rows the components are fitted on, 0 for all rows */
+    ::megamol::core::param::ParamSlot fitSampleSlot;
+
     /** ID of the current frame */
     // int frameID; //TODO: unknown
 
@@ -0,0 +1,557 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "ParallelTSNE.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <utility>
+
+using namespace megamol::infovis;
+
+namespace {
+
+double squaredDistance(const double* a, const double* b, std::size_t dims) {
+    double result = 0.0;
+    for (std::size_t d = 0; d < dims; ++d) {
+        const double diff = a[d] - b[d];
+        result += diff * diff;
+    }
+    return result;
+}
+
+/**
+ * Vantage-point tree for exact k-nearest-neighbor queries in the input space. Built once, queried concurrently.
+ */
+class VantagePointTree {
+public:
+    VantagePointTree(const double* data, std::size_t rows, std::size_t dims, std::mt19937& rng)
+            : data(data)
+            , dims(dims)
+            , items(rows) {
+        std::iota(items.begin(), items.end(), 0);
+        nodes.reserve(rows);
+        root = build(0, static_cast<int>(rows), rng);
+    }
+
+    /**
+     * Finds the k nearest neighbors of a point, excluding the point itself, sorted by distance.
+     */
+    void search(int point, int k, std::vector<int>& indices, std::vector<double>& distances) const {
+        Heap heap;
+        double tau = std::numeric_limits<double>::max();
+        search(root, point, k, heap, tau);
+
+        indices.resize(heap.size());
+        distances.resize(heap.size());
+        for (auto i = static_cast<int>(heap.size()) - 1; i >= 0; --i) {
+            distances[i] = heap.top().first;
+            indices[i] = heap.top().second;
+            heap.pop();
+        }
+    }
+
+private:
+    struct Node {
+        int index = -1;
+        double threshold = 0.0;
+        int inside = -1;
+        int outside = -1;
+    };
+
+    using Heap = std::priority_queue<std::pair<double, int>>;
+
+    double distance(int a, int b) const {
+        return std::sqrt(squaredDistance(data + a * dims, data + b * dims, dims));
+    }
+
+    int build(int lower, int upper, std::mt19937& rng) {
+        if (upper == lower) {
+            return -1;
+        }
+
+        const auto node = static_cast<int>(nodes.size());
+        nodes.emplace_back();
+
+        if (upper - lower > 1) {
+            const int vantage = std::uniform_int_distribution<int>(lower, upper - 1)(rng);
+            std::swap(items[lower], items[vantage]);
+
+            const int median = (upper + lower) / 2;
+            const int center = items[lower];
+            std::nth_element(items.begin() + lower + 1, items.begin() + median, items.begin() + upper,
+                [this, center](int a, int b) { return distance(center, a) < distance(center, b); });
+
+            nodes[node].index = center;
+            nodes[node].threshold = distance(center, items[median]);
+            const int inside = build(lower + 1, median, rng);
+            const int outside = build(median, upper, rng);
+            nodes[node].inside = inside;
+            nodes[node].outside = outside;
+        } else {
+            nodes[node].index = items[lower];
+        }
+
+        return node;
+    }
+
+    void search(int node, int point, int k, Heap& heap, double& tau) const {
+        if (node == -1) {
+            return;
+        }
+
+        const Node& n = nodes[node];
+        const double dist = distance(n.index, point);
+        if (n.index != point && dist < tau) {
+            if (static_cast<int>(heap.size()) == k) {
+                heap.pop();
+            }
+            heap.emplace(dist, n.index);
+            if (static_cast<int>(heap.size()) == k) {
+                tau = heap.top().first;
+            }
+        }
+
+        if (n.inside == -1 && n.outside == -1) {
+            return;
+        }
+
+        if (dist < n.threshold) {
+            if (dist - tau <= n.threshold) {
+                search(n.inside, point, k, heap, tau);
+            }
+            if (dist + tau >= n.threshold) {
+                search(n.outside, point, k, heap, tau);
+            }
+        } else {
+            if (dist + tau >= n.threshold) {
+                search(n.outside, point, k, heap, tau);
+            }
+            if (dist - tau <= n.threshold) {
+                search(n.inside, point, k, heap, tau);
+            }
+        }
+    }
+
+    const double* data;
+    std::size_t dims;
+    std::vector<int> items;
+    std::vector<Node> nodes;
+    int root = -1;
+};
+
+/**
+ * Quadtree over the embedding storing the center of mass of each cell. Built once per iteration, then traversed
+ * concurrently to approximate the repulsive forces.
+ */
+class QuadTree {
+public:
+    QuadTree(const double* points, std::size_t count) : points(points) {
+        double minX = std::numeric_limits<double>::max();
+        double minY = minX;
+        double maxX = std::numeric_limits<double>::lowest();
+        double maxY = maxX;
+        for (std::size_t i = 0; i < count; ++i) {
+            minX = std::min(minX, points[2 * i]);
+            maxX = std::max(maxX, points[2 * i]);
+            minY = std::min(minY, points[2 * i + 1]);
+            maxY = std::max(maxY, points[2 * i + 1]);
+        }
+
+        cells.reserve(2 * count + 1);
+        Cell root;
+        root.centerX = (minX + maxX) / 2.0;
+        root.centerY = (minY + maxY) / 2.0;
+        root.halfWidth = std::max(maxX - minX, maxY - minY) / 2.0 + 1e-5;
+        cells.push_back(root);
+
+        for (std::size_t i = 0; i < count; ++i) {
+            insert(0, static_cast<int>(i), 0);
+        }
+    }
+
+    /**
+     * Accumulates the unnormalized repulsive force on a point and its contribution to the normalization sum Z.
+     */
+    void repulsion(int point, double theta, double& forceX, double& forceY, double& sumQ,
+        std::vector<int>& stack) const {
+        const double x = points[2 * point];
+        const double y = points[2 * point + 1];
+        const double theta2 = theta * theta;
+
+        stack.clear();
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Cell& cell = cells[stack.back()];
+            stack.pop_back();
+
+            if (cell.count == 0 || (cell.firstChild == -1 && cell.count == 1 && cell.point == point)) {
+                continue;
+            }
+
+            const double dx = x - cell.sumX / cell.count;
+            const double dy = y - cell.sumY / cell.count;
+            const double dist2 = dx * dx + dy * dy;
+            const double width = 2.0 * cell.halfWidth;
+
+            if (cell.firstChild == -1 || width * width < theta2 * dist2) {
+                const double q = 1.0 / (1.0 + dist2);
+                double mult = cell.count * q;
+                sumQ += mult;
+                mult *= q;
+                forceX += mult * dx;
+                forceY += mult * dy;
+            } else {
+                for (int c = 0; c < 4; ++c) {
+                    stack.push_back(cell.firstChild + c);
+                }
+            }
+        }
+    }
+
+private:
+    /** Identical points would be split forever, they are merged into one leaf below this depth */
+    static constexpr int MaxDepth = 48;
+
+    struct Cell {
+        double centerX = 0.0;
+        double centerY = 0.0;
+        double halfWidth = 0.0;
+        double sumX = 0.0;
+        double sumY = 0.0;
+        int count = 0;
+        int firstChild = -1;
+        int point = -1;
+    };
+
+    int childFor(int cell, int point) const {
+        const Cell& c = cells[cell];
+        const int quadrant = (points[2 * point] > c.centerX ? 1 : 0) + (points[2 * point + 1] > c.centerY ? 2 : 0);
+        return c.firstChild + quadrant;
+    }
+
+    void insert(int cell, int point, int depth) {
+        cells[cell].sumX += points[2 * point];
+        cells[cell].sumY += points[2 * point + 1];
+        ++cells[cell].count;
+
+        if (cells[cell].firstChild == -1) {
+            if (cells[cell].count == 1) {
+                cells[cell].point = point;
+                return;
+            }
+            if (depth >= MaxDepth) {
+                return;
+            }
+
+            // Split the leaf and move its point down
+            const int previous = cells[cell].point;
+            const double half = cells[cell].halfWidth / 2.0;
+            cells[cell].point = -1;
+            cells[cell].firstChild = static_cast<int>(cells.size());
+            for (int c = 0; c < 4; ++c) {
+                Cell child;
+                child.centerX = cells[cell].centerX + ((c & 1) ? half : -half);
+                child.centerY = cells[cell].centerY + ((c & 2) ? half : -half);
+                child.halfWidth = half;
+                cells.push_back(child);
+            }
+            insert(childFor(cell, previous), previous, depth + 1);
+        }
+
+        insert(childFor(cell, point), point, depth + 1);
+    }
+
+    const double* points;
+    std::vector<Cell> cells;
+};
+
+/**
+ * Sparse symmetric matrix in compressed row storage.
+ */
+struct SparseMatrix {
+    std::vector<std::size_t> rowOffsets;
+    std::vector<int> columns;
+    std::vector<double> values;
+};
+
+/**
+ * Computes the conditional probabilities p_j|i over the k nearest neighbors of each point, calibrated to the
+ * perplexity by a binary search for the bandwidth of each point.
+ */
+SparseMatrix conditionalProbabilities(
+    const std::vector<double>& data, std::size_t rows, std::size_t dims, double perplexity, unsigned int seed) {
+    const int k = static_cast<int>(std::min<double>(static_cast<double>(rows) - 1.0, std::floor(3.0 * perplexity)));
+
+    std::mt19937 rng(seed);
+    const VantagePointTree tree(data.data(), rows, dims, rng);
+
+    SparseMatrix result;
+    result.rowOffsets.resize(rows + 1);
+    for (std::size_t i = 0; i <= rows; ++i) {
+        result.rowOffsets[i] = i * k;
+    }
+    result.columns.resize(rows * k);
+    result.values.resize(rows * k);
+
+    const double targetEntropy = std::log(perplexity);
+
+#pragma omp parallel
+    {
+        std::vector<int> indices;
+        std::vector<double> distances;
+        std::vector<double> p(k);
+
+#pragma omp for schedule(dynamic, 64)
+        for (std::int64_t i = 0; i < static_cast<std::int64_t>(rows); ++i) {
+            tree.search(static_cast<int>(i), k, indices, distances);
+            for (auto& d : distances) {
+                d *= d;
+            }
+
+            double beta = 1.0;
+            double minBeta = std::numeric_limits<double>::lowest();
+            double maxBeta = std::numeric_limits<double>::max();
+            double sum = 0.0;
+            for (int iter = 0; iter < 200; ++iter) {
+                sum = std::numeric_limits<double>::min();
+                double weighted = 0.0;
+                for (int m = 0; m < k; ++m) {
+                    p[m] = std::exp(-beta * distances[m]);
+                    sum += p[m];
+                    weighted += beta * distances[m] * p[m];
+                }
+                const double entropy = weighted / sum + std::log(sum);
+                const double diff = entropy - targetEntropy;
+                if (std::abs(diff) < 1e-5) {
+                    break;
+                }
+                if (diff > 0) {
+                    minBeta = beta;
+                    beta = maxBeta == std::numeric_limits<double>::max() ? beta * 2.0 : (beta + maxBeta) / 2.0;
+                } else {
+                    maxBeta = beta;
+                    beta = minBeta == std::numeric_limits<double>::lowest() ? beta / 2.0 : (beta + minBeta) / 2.0;
+                }
+            }
+
+            const std::size_t offset = i * k;
+            for (int m = 0; m < k; ++m) {
+                result.columns[offset + m] = indices[m];
+                result.values[offset + m] = p[m] / sum;
+            }
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Computes the joint probabilities p_ij = (p_j|i + p_i|j) / 2n.
+ */
+SparseMatrix symmetrize(const SparseMatrix& conditional, std::size_t rows) {
+    // Each entry of the conditional matrix contributes to its own row and to the row of its column
+    std::vector<std::size_t> counts(rows, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t e = conditional.rowOffsets[i]; e < conditional.rowOffsets[i + 1]; ++e) {
+            ++counts[i];
+            ++counts[conditional.columns[e]];
+        }
+    }
+
+    std::vector<std::size_t> offsets(rows + 1, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        offsets[i + 1] = offsets[i] + counts[i];
+    }
+
+    std::vector<std::pair<int, double>> entries(offsets[rows]);
+    std::vector<std::size_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t e = conditional.rowOffsets[i]; e < conditional.rowOffsets[i + 1]; ++e) {
+            const int j = conditional.columns[e];
+            entries[fill[i]++] = {j, conditional.values[e]};
+            entries[fill[j]++] = {static_cast<int>(i), conditional.values[e]};
+        }
+    }
+
+    // Merge the duplicate entries of mutual neighbors
+    std::vector<std::size_t> merged(rows, 0);
+#pragma omp parallel for schedule(dynamic, 256)
+    for (std::int64_t i = 0; i < static_cast<std::int64_t>(rows); ++i) {
+        auto begin = entries.begin() + offsets[i];
+        auto end = entries.begin() + offsets[i + 1];
+        std::sort(begin, end, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        auto out = begin;
+        for (auto it = begin; it != end; ++it) {
+            if (out != begin && (out - 1)->first == it->first) {
+                (out - 1)->second += it->second;
+            } else {
+                *out++ = *it;
+            }
+        }
+        merged[i] = out - begin;
+    }
+
+    SparseMatrix result;
+    result.rowOffsets.resize(rows + 1, 0);
+    for (std::size_t i = 0; i < rows; ++i) {
+        result.rowOffsets[i + 1] = result.rowOffsets[i] + merged[i];
+    }
+    result.columns.resize(result.rowOffsets[rows]);
+    result.values.resize(result.rowOffsets[rows]);
+
+    // Every conditional row sums to one
+    const double normalization = 1.0 / (2.0 * static_cast<double>(rows));
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t e = 0; e < merged[i]; ++e) {
+            result.columns[result.rowOffsets[i] + e] = entries[offsets[i] + e].first;
+            result.values[result.rowOffsets[i] + e] = entries[offsets[i] + e].second * normalization;
+        }
+    }
+
+    return result;
+}
+
+} // namespace
+
+void ParallelTSNE::run(std::vector<double>& data, std::size_t rows, std::size_t dims, std::vector<double>& embedding,
+    bool initialized, Config const& config) {
+    constexpr double Exaggeration = 12.0;
+    constexpr double InitialMomentum = 0.5;
+    constexpr double FinalMomentum = 0.8;
+
+    const auto now = std::chrono::system_clock::now().time_since_epoch().count();
+    const auto seed = static_cast<unsigned int>(config.randomSeed < 0 ? now : config.randomSeed);
+    std::mt19937 rng(seed);
+
+    if (rows < 2) {
+        embedding.assign(rows * 2, 0.0);
+        return;
+    }
+
+    // Center the data and scale it into [-1, 1], as bhtsne does
+    for (std::size_t d = 0; d < dims; ++d) {
+        double mean = 0.0;
+        for (std::size_t i = 0; i < rows; ++i) {
+            mean += data[i * dims + d];
+        }
+        mean /= static_cast<double>(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            data[i * dims + d] -= mean;
+        }
+    }
+    double maxValue = 0.0;
+    for (const double v : data) {
+        maxValue = std::max(maxValue, std::abs(v));
+    }
+    if (maxValue > 0.0) {
+        for (auto& v : data) {
+            v /= maxValue;
+        }
+    }
+
+    SparseMatrix p = symmetrize(conditionalProbabilities(data, rows, dims, config.perplexity, seed), rows);
+
+    if (!initialized || embedding.size() != rows * 2) {
+        std::normal_distribution<double> normal(0.0, 1e-4);
+        embedding.resize(rows * 2);
+        for (auto& v : embedding) {
+            v = normal(rng);
+        }
+    }
+
+    const bool lying = config.stopLyingIter > 0;
+    if (lying) {
+        for (auto& v : p.values) {
+            v *= Exaggeration;
+        }
+    }
+
+    std::vector<double> attraction(rows * 2);
+    std::vector<double> repulsion(rows * 2);
+    std::vector<double> update(rows * 2, 0.0);
+    std::vector<double> gains(rows * 2, 1.0);
+    double momentum = InitialMomentum;
+    const auto count = static_cast<std::int64_t>(rows);
+    double* y = embedding.data();
+
+    for (int iter = 0; iter < config.maxIter; ++iter) {
+        const QuadTree tree(y, rows);
+
+        // Forces on each point, the repulsion is normalized by the sum over all points afterwards
+        double sumQ = 0.0;
+#pragma omp parallel
+        {
+            std::vector<int> stack;
+            stack.reserve(256);
+
+#pragma omp for schedule(dynamic, 256) reduction(+ : sumQ)
+            for (std::int64_t i = 0; i < count; ++i) {
+                double attractX = 0.0;
+                double attractY = 0.0;
+                for (std::size_t e = p.rowOffsets[i]; e < p.rowOffsets[i + 1]; ++e) {
+                    const int j = p.columns[e];
+                    const double dx = y[2 * i] - y[2 * j];
+                    const double dy = y[2 * i + 1] - y[2 * j + 1];
+                    const double mult = p.values[e] / (1.0 + dx * dx + dy * dy);
+                    attractX += mult * dx;
+                    attractY += mult * dy;
+                }
+                attraction[2 * i] = attractX;
+                attraction[2 * i + 1] = attractY;
+
+                double repelX = 0.0;
+                double repelY = 0.0;
+                double q = 0.0;
+                tree.repulsion(static_cast<int>(i), config.theta, repelX, repelY, q, stack);
+                repulsion[2 * i] = repelX;
+                repulsion[2 * i + 1] = repelY;
+                sumQ += q;
+            }
+        }
+
+        // Gradient step with momentum and per-coordinate gains
+        const double normalization = sumQ > 0.0 ? 1.0 / sumQ : 0.0;
+        const auto coordinates = static_cast<std::int64_t>(rows * 2);
+#pragma omp parallel for
+        for (std::int64_t c = 0; c < coordinates; ++c) {
+            const double gradient = attraction[c] - repulsion[c] * normalization;
+            gains[c] = (gradient > 0.0) != (update[c] > 0.0) ? gains[c] + 0.2 : gains[c] * 0.8;
+            gains[c] = std::max(gains[c], 0.01);
+            update[c] = momentum * update[c] - config.learningRate * gains[c] * gradient;
+            y[c] += update[c];
+        }
+
+        double meanX = 0.0;
+        double meanY = 0.0;
+        for (std::size_t i = 0; i < rows; ++i) {
+            meanX += y[2 * i];
+            meanY += y[2 * i + 1];
+        }
+        meanX /= static_cast<double>(rows);
+        meanY /= static_cast<double>(rows);
+        for (std::size_t i = 0; i < rows; ++i) {
+            y[2 * i] -= meanX;
+            y[2 * i + 1] -= meanY;
+        }
+
+        if (lying && iter == config.stopLyingIter) {
+            for (auto& v : p.values) {
+                v /= Exaggeration;
+            }
+        }
+        if (iter == config.momentumSwitchIter) {
+            momentum = FinalMomentum;
+        }
+    }
+}
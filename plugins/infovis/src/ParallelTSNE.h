@@ -0,0 +1,56 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace megamol::infovis {
+
+/**
+ * Barnes-Hut t-SNE for two-dimensional embeddings, parallelized with OpenMP.
+ *
+ * Follows the algorithm of van der Maaten (2014), as does bhtsne: input similarities are computed from the exact
+ * nearest neighbors found with a vantage-point tree, repulsive forces are approximated with a quadtree. Neighbor
+ * search, perplexity calibration and both force terms run in parallel over the points.
+ */
+class ParallelTSNE {
+public:
+    struct Config {
+        double perplexity = 30.0;
+
+        /** Barnes-Hut accuracy, 0 computes all repulsive forces exactly */
+        double theta = 0.5;
+
+        int maxIter = 1000;
+
+        /** Iteration ending the early exaggeration, 0 disables it, e.g. when starting from a previous embedding */
+        int stopLyingIter = 250;
+
+        int momentumSwitchIter = 250;
+
+        double learningRate = 200.0;
+
+        /** Seed of the random initialization, negative for a time dependent seed */
+        int randomSeed = 42;
+    };
+
+    /**
+     * Computes the embedding of a data set.
+     *
+     * @param data Row-major input data, rows x dims. It is normalized in place.
+     * @param rows Number of points
+     * @param dims Number of input dimensions
+     * @param embedding Receives the row-major embedding, rows x 2
+     * @param initialized Use the given embedding as initialization instead of a random one
+     * @param config Parameters of the optimization
+     */
+    static void run(std::vector<double>& data, std::size_t rows, std::size_t dims, std::vector<double>& embedding,
+        bool initialized, Config const& config);
+};
+
+} // namespace megamol::infovis
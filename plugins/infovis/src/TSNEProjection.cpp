@@ -2,9 +2,13 @@
 
 #include "datatools/table/TableDataCall.h"
 #include "mmcore/param/BoolParam.h"
+#include "mmcore/param/EnumParam.h"
 #include "mmcore/param/FloatParam.h"
 #include "mmcore/param/IntParam.h"
 
+#include "ParallelTSNE.h"
+
+#include <algorithm>
 #include <sstream>
 #include <tsne.h>
 
@@ -21,6 +25,10 @@ TSNEProjection::TSNEProjection()
               "theta = 0 corresponds to standard, slow t-SNE, while theta = 1 corresponds to very crude approximations")
         , maxIterSlot("maxIter", "Set the maximum Iterations")
         , perplexitySlot("perplexity", "Set the Perplexity")
+        , methodSlot("method", "The single-threaded bhtsne library for any number of components, or multithreaded "
+                               "Barnes-Hut t-SNE for two components")
+        , incrementalSlot("incremental", "Start from the previous embedding if the number of rows did not change, "
+                                         "e.g., to follow small changes of the input without the early exaggeration")
         , datahash(0)
         , dataInHash(0)
         , columnInfos() {
@@ -48,6 +56,14 @@ TSNEProjection::TSNEProjection()
 
     thetaSlot << new ::megamol::core::param::FloatParam(0.5);
     this->MakeSlotAvailable(&thetaSlot);
+
+    methodSlot << new ::megamol::core::param::EnumParam(1);
+    methodSlot.Param<param::EnumParam>()->SetTypePair(0, "parallel Barnes-Hut (2D)");
+    methodSlot.Param<param::EnumParam>()->SetTypePair(1, "bhtsne");
+    this->MakeSlotAvailable(&methodSlot);
+
+    incrementalSlot << new ::megamol::core::param::BoolParam(false);
+    this->MakeSlotAvailable(&incrementalSlot);
 }
 
 TSNEProjection::~TSNEProjection() {
@@ -129,7 +145,7 @@ bool megamol::infovis::TSNEProjection::project(megamol::datatools::table::TableD
     // check if inData has changed and if Slots have changed
     if (this->dataInHash == inCall->DataHash()) {
         if (!reduceToNSlot.IsDirty() && !maxIterSlot.IsDirty() && !thetaSlot.IsDirty() && !perplexitySlot.IsDirty() &&
-            !randomSeedSlot.IsDirty()) {
+            !randomSeedSlot.IsDirty() && !methodSlot.IsDirty() && !incrementalSlot.IsDirty()) {
             return true; // Nothing to do
         }
     }
@@ -152,27 +168,47 @@ bool megamol::infovis::TSNEProjection::project(megamol::datatools::table::TableD
         return false;
     }
 
-    // Load data in a double Array
-    double* inputData = (double*) malloc(columnCount * rowsCount * sizeof(double));
-    for (int col = 0; col < columnCount; col++) {
-        for (int row = 0; row < rowsCount; row++) {
-            inputData[row * columnCount + col] = inData[row * columnCount + col];
-            // inputData[col*rowsCount + row] = inData[row * columnCount + col];
+    // Load data in a double Array, row-major as the table
+    std::vector<double> inputData(inData, inData + static_cast<size_t>(columnCount) * rowsCount);
+
+    // Start from the previous embedding if it matches the input
+    bool incremental = false;
+    if (this->incrementalSlot.Param<core::param::BoolParam>()->Value()) {
+        incremental = this->embedding.size() == static_cast<size_t>(rowsCount) * outputColumnCount;
+        if (!incremental) {
+            megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+                "%s: No previous embedding of %d rows, starting from a random embedding", ClassName(), rowsCount);
         }
     }
 
-    double* result = (double*) malloc(rowsCount * outputColumnCount * sizeof(double));
-    TSNE::run(inputData, rowsCount, columnCount, result, outputColumnCount, perplexity, theta, randomSeed, false,
-        maxIter, 250, 250);
-
-    double* maximas = new double[outputColumnCount];
-    double* minimas = new double[outputColumnCount];
+    std::vector<double> result;
+    if (incremental) {
+        result = this->embedding;
+    } else {
+        result.resize(static_cast<size_t>(rowsCount) * outputColumnCount);
+    }
 
-    for (int col = 0; col < outputColumnCount; col++) {
-        maximas[col] = result[col];
-        minimas[col] = result[col];
+    const bool parallel = this->methodSlot.Param<core::param::EnumParam>()->Value() == 0;
+    if (parallel && outputColumnCount == 2) {
+        ParallelTSNE::Config config;
+        config.perplexity = perplexity;
+        config.theta = theta;
+        config.maxIter = maxIter;
+        config.stopLyingIter = incremental ? 0 : 250;
+        config.randomSeed = randomSeed;
+        ParallelTSNE::run(inputData, rowsCount, columnCount, result, incremental, config);
+    } else {
+        if (parallel) {
+            megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+                "%s: Parallel Barnes-Hut t-SNE only supports two components, using bhtsne", ClassName());
+        }
+        TSNE::run(inputData.data(), rowsCount, columnCount, result.data(), outputColumnCount, perplexity, theta,
+            randomSeed, incremental, maxIter, incremental ? 0 : 250, 250);
     }
 
+    std::vector<double> maximas(result.begin(), result.begin() + outputColumnCount);
+    std::vector<double> minimas(result.begin(), result.begin() + outputColumnCount);
+
     for (int col = 0; col < outputColumnCount; col++) {
         for (int row = 1; row < rowsCount; row++) {
             double value = result[row * outputColumnCount + col];
@@ -218,13 +254,10 @@ bool megamol::infovis::TSNEProjection::project(megamol::datatools::table::TableD
     randomSeedSlot.ResetDirty();
     thetaSlot.ResetDirty();
     perplexitySlot.ResetDirty();
+    methodSlot.ResetDirty();
+    incrementalSlot.ResetDirty();
 
-    free(result);
-    result = NULL;
-    free(inputData);
-    inputData = NULL;
-    delete[] maximas;
-    delete[] minimas;
+    this->embedding = std::move(result);
 
     return true;
 }
@@ -62,6 +62,8 @@ private:
     ::megamol::core::param::ParamSlot thetaSlot;
     ::megamol::core::param::ParamSlot perplexitySlot;
     ::megamol::core::param::ParamSlot maxIterSlot;
+    ::megamol::core::param::ParamSlot methodSlot;
+    ::megamol::core::param::ParamSlot incrementalSlot;
 
     /** ID of the current frame */
     // int frameID; //TODO: unknown
@@ -75,6 +77,9 @@ private:
 
     /** Vector stroing the actual float data */
     std::vector<float> data;
+
+    /** Last embedding, row-major, initializes the next one in incremental mode */
+    std::vector<double> embedding;
 };
 
 } // namespace megamol::infovis
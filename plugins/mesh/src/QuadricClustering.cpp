@@ -0,0 +1,580 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "QuadricClustering.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+
+using namespace megamol::mesh::lod;
+
+namespace {
+
+/** Items are grouped into buckets by the hash of their key, every bucket is processed by a single thread */
+constexpr uint32_t NumBuckets = 1024;
+
+/** Marks items that are not assigned to any bucket */
+constexpr uint32_t Skip = std::numeric_limits<uint32_t>::max();
+
+/** The number of slices the items are split into for parallel passes */
+constexpr int64_t NumChunks = 256;
+
+/** Grid cells are packed into 64 bit keys with 21 bits per coordinate */
+constexpr unsigned int CoordBits = 21;
+constexpr uint64_t CoordMask = (1ull << CoordBits) - 1;
+constexpr unsigned int MaxResolution = 1u << 20;
+
+/** Items grouped by bucket, bucket b holds order[start[b]] to order[start[b + 1] - 1] in ascending order */
+struct Partition {
+    std::vector<uint32_t> order;
+    std::vector<size_t> start;
+};
+
+/** Clusters of vertices, the accumulated values are relative to the origin of the grid */
+struct Clusters {
+    std::vector<uint64_t> cells;
+
+    /** Ten coefficients of the symmetric 4x4 error quadric per cluster */
+    std::vector<double> quadrics;
+
+    /** Sum of vertex positions, vertex count and sum of normals per cluster */
+    std::vector<double> sums;
+    std::vector<uint32_t> counts;
+    std::vector<float> normals;
+
+    /** The point representing each cluster */
+    std::vector<double> positions;
+
+    /** Distinct non-degenerate triangles between the clusters */
+    std::vector<unsigned int> triangles;
+
+    void resize(size_t size, bool with_normals) {
+        quadrics.assign(10 * size, 0.0);
+        sums.assign(3 * size, 0.0);
+        counts.assign(size, 0);
+        normals.assign(with_normals ? 3 * size : 0, 0.0f);
+        positions.resize(3 * size);
+    }
+};
+
+size_t chunkBegin(size_t n, int64_t chunk) {
+    return static_cast<size_t>(n * static_cast<uint64_t>(chunk) / NumChunks);
+}
+
+uint32_t bucketOf(uint64_t key) {
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdull;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ull;
+    key ^= key >> 33;
+    return static_cast<uint32_t>(key % NumBuckets);
+}
+
+uint64_t packCell(uint64_t x, uint64_t y, uint64_t z) {
+    return x | (y << CoordBits) | (z << (2 * CoordBits));
+}
+
+std::array<uint64_t, 3> unpackCell(uint64_t key) {
+    return {key & CoordMask, (key >> CoordBits) & CoordMask, (key >> (2 * CoordBits)) & CoordMask};
+}
+
+uint64_t parentCell(uint64_t key) {
+    const auto c = unpackCell(key);
+    return packCell(c[0] >> 1, c[1] >> 1, c[2] >> 1);
+}
+
+/**
+ * Groups the items [0, n) by the bucket returned for them, items for which Skip is returned are dropped.
+ */
+template<typename BucketFunc>
+void partition(size_t n, BucketFunc const& bucket, Partition& part) {
+    std::vector<size_t> offsets(NumChunks * NumBuckets, 0);
+#pragma omp parallel for schedule(static)
+    for (int64_t c = 0; c < NumChunks; ++c) {
+        auto counts = offsets.data() + c * NumBuckets;
+        for (size_t i = chunkBegin(n, c); i < chunkBegin(n, c + 1); ++i) {
+            const auto b = bucket(i);
+            if (b != Skip) {
+                ++counts[b];
+            }
+        }
+    }
+
+    // the items of a bucket are ordered by chunk, which keeps them in ascending order
+    part.start.resize(NumBuckets + 1);
+    size_t sum = 0;
+    for (uint32_t b = 0; b < NumBuckets; ++b) {
+        part.start[b] = sum;
+        for (int64_t c = 0; c < NumChunks; ++c) {
+            const auto count = offsets[c * NumBuckets + b];
+            offsets[c * NumBuckets + b] = sum;
+            sum += count;
+        }
+    }
+    part.start[NumBuckets] = sum;
+
+    part.order.resize(sum);
+#pragma omp parallel for schedule(static)
+    for (int64_t c = 0; c < NumChunks; ++c) {
+        auto next = offsets.data() + c * NumBuckets;
+        for (size_t i = chunkBegin(n, c); i < chunkBegin(n, c + 1); ++i) {
+            const auto b = bucket(i);
+            if (b != Skip) {
+                part.order[next[b]++] = static_cast<uint32_t>(i);
+            }
+        }
+    }
+}
+
+/**
+ * Assigns consecutive ids to the distinct cells. The ids of the items in bucket b of the partition are in
+ * [first[b], first[b + 1]), so that the buckets can accumulate into the clusters without synchronisation.
+ *
+ * @param keys The cell of every item
+ * @param ids Receives the cluster of every item
+ * @param cells Receives the cell of every cluster
+ */
+void cluster(std::vector<uint64_t> const& keys, std::vector<uint32_t>& ids, std::vector<uint64_t>& cells,
+    Partition& part, std::vector<size_t>& first) {
+    partition(keys.size(), [&keys](size_t i) { return bucketOf(keys[i]); }, part);
+
+    ids.resize(keys.size());
+    std::vector<std::vector<uint64_t>> local(NumBuckets);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < NumBuckets; ++b) {
+        std::unordered_map<uint64_t, uint32_t> index;
+        index.reserve((part.start[b + 1] - part.start[b]) / 2 + 1);
+        for (auto j = part.start[b]; j < part.start[b + 1]; ++j) {
+            const auto i = part.order[j];
+            const auto [it, inserted] = index.try_emplace(keys[i], static_cast<uint32_t>(local[b].size()));
+            if (inserted) {
+                local[b].push_back(keys[i]);
+            }
+            ids[i] = it->second;
+        }
+    }
+
+    first.resize(NumBuckets + 1);
+    size_t sum = 0;
+    for (uint32_t b = 0; b < NumBuckets; ++b) {
+        first[b] = sum;
+        sum += local[b].size();
+    }
+    first[NumBuckets] = sum;
+
+    cells.resize(sum);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < NumBuckets; ++b) {
+        for (auto j = part.start[b]; j < part.start[b + 1]; ++j) {
+            ids[part.order[j]] += static_cast<uint32_t>(first[b]);
+        }
+        std::copy(local[b].begin(), local[b].end(), cells.begin() + first[b]);
+    }
+}
+
+/**
+ * Maps the triangles to the clusters of their vertices and keeps the distinct non-degenerate ones, rotated to start
+ * at their smallest index. Oppositely oriented triangles are kept, as they bound thin features.
+ */
+void mapTriangles(unsigned int const* triangles, size_t num_triangles, std::vector<uint32_t> const& map,
+    std::vector<unsigned int>& out) {
+    typedef std::array<uint32_t, 3> Triangle;
+    struct TriangleHash {
+        size_t operator()(Triangle const& t) const {
+            return static_cast<size_t>((static_cast<uint64_t>(t[0]) << 32 | t[1]) ^ (t[2] * 0x9e3779b97f4a7c15ull));
+        }
+    };
+
+    const auto mapped = [&](size_t i, Triangle& t) {
+        for (size_t c = 0; c < 3; ++c) {
+            const auto v = triangles[3 * i + c];
+            if (v >= map.size()) {
+                return false;
+            }
+            t[c] = map[v];
+        }
+        if (t[0] == t[1] || t[1] == t[2] || t[0] == t[2]) {
+            return false;
+        }
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        return true;
+    };
+
+    Partition part;
+    partition(
+        num_triangles,
+        [&](size_t i) {
+            Triangle t;
+            return mapped(i, t) ? bucketOf(TriangleHash()(t)) : Skip;
+        },
+        part);
+
+    std::vector<std::vector<unsigned int>> local(NumBuckets);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < NumBuckets; ++b) {
+        std::unordered_set<Triangle, TriangleHash> seen;
+        seen.reserve(part.start[b + 1] - part.start[b]);
+        for (auto j = part.start[b]; j < part.start[b + 1]; ++j) {
+            Triangle t;
+            mapped(part.order[j], t);
+            if (seen.insert(t).second) {
+                local[b].insert(local[b].end(), t.begin(), t.end());
+            }
+        }
+    }
+
+    std::vector<size_t> first(NumBuckets + 1, 0);
+    for (uint32_t b = 0; b < NumBuckets; ++b) {
+        first[b + 1] = first[b] + local[b].size();
+    }
+    out.resize(first[NumBuckets]);
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < NumBuckets; ++b) {
+        std::copy(local[b].begin(), local[b].end(), out.begin() + first[b]);
+    }
+}
+
+/** Eigen decomposition of a symmetric 3x3 matrix by Jacobi rotations, the eigenvectors are the columns of 'v' */
+void eigen(std::array<std::array<double, 3>, 3>& a, std::array<std::array<double, 3>, 3>& v) {
+    v = {{{1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {0.0, 0.0, 1.0}}};
+    for (int sweep = 0; sweep < 32; ++sweep) {
+        const auto diag = a[0][0] * a[0][0] + a[1][1] * a[1][1] + a[2][2] * a[2][2];
+        const auto off = a[0][1] * a[0][1] + a[0][2] * a[0][2] + a[1][2] * a[1][2];
+        if (off <= 1e-24 * diag) {
+            return;
+        }
+        for (int p = 0; p < 2; ++p) {
+            for (int q = p + 1; q < 3; ++q) {
+                if (a[p][q] == 0.0) {
+                    continue;
+                }
+                const auto theta = (a[q][q] - a[p][p]) / (2.0 * a[p][q]);
+                const auto t = (theta >= 0.0 ? 1.0 : -1.0) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const auto c = 1.0 / std::sqrt(t * t + 1.0);
+                const auto s = t * c;
+                for (int k = 0; k < 3; ++k) {
+                    const auto kp = a[k][p], kq = a[k][q];
+                    a[k][p] = c * kp - s * kq;
+                    a[k][q] = s * kp + c * kq;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const auto pk = a[p][k], qk = a[q][k];
+                    a[p][k] = c * pk - s * qk;
+                    a[q][k] = s * pk + c * qk;
+                }
+                for (int k = 0; k < 3; ++k) {
+                    const auto kp = v[k][p], kq = v[k][q];
+                    v[k][p] = c * kp - s * kq;
+                    v[k][q] = s * kp + c * kq;
+                }
+            }
+        }
+    }
+}
+
+double evaluate(double const* q, double const* x) {
+    return q[0] * x[0] * x[0] + q[4] * x[1] * x[1] + q[7] * x[2] * x[2] +
+           2.0 * (q[1] * x[0] * x[1] + q[2] * x[0] * x[2] + q[5] * x[1] * x[2]) +
+           2.0 * (q[3] * x[0] + q[6] * x[1] + q[8] * x[2]) + q[9];
+}
+
+/**
+ * Places the cluster at the minimum of its quadric. Directions in which the quadric is (nearly) flat are left at the
+ * mean of the vertices, and the point is clamped to the cell to bound the displacement.
+ */
+void place(Clusters& clusters, double cell_size) {
+#pragma omp parallel for schedule(static)
+    for (int64_t k = 0; k < static_cast<int64_t>(clusters.cells.size()); ++k) {
+        const auto q = clusters.quadrics.data() + 10 * k;
+        const auto n = static_cast<double>(std::max<uint32_t>(clusters.counts[k], 1));
+        const std::array<double, 3> mean = {
+            clusters.sums[3 * k] / n, clusters.sums[3 * k + 1] / n, clusters.sums[3 * k + 2] / n};
+
+        std::array<std::array<double, 3>, 3> a = {{{q[0], q[1], q[2]}, {q[1], q[4], q[5]}, {q[2], q[5], q[7]}}};
+        // the minimum solves A x = -b, it is searched for as an offset from the mean
+        const std::array<double, 3> r = {-q[3] - (a[0][0] * mean[0] + a[0][1] * mean[1] + a[0][2] * mean[2]),
+            -q[6] - (a[1][0] * mean[0] + a[1][1] * mean[1] + a[1][2] * mean[2]),
+            -q[8] - (a[2][0] * mean[0] + a[2][1] * mean[1] + a[2][2] * mean[2])};
+
+        std::array<std::array<double, 3>, 3> v;
+        eigen(a, v);
+        const auto max_eigenvalue = std::max({std::abs(a[0][0]), std::abs(a[1][1]), std::abs(a[2][2])});
+
+        auto x = mean;
+        for (int e = 0; e < 3; ++e) {
+            if (std::abs(a[e][e]) > 1e-3 * max_eigenvalue && a[e][e] != 0.0) {
+                const auto f = (v[0][e] * r[0] + v[1][e] * r[1] + v[2][e] * r[2]) / a[e][e];
+                for (int i = 0; i < 3; ++i) {
+                    x[i] += f * v[i][e];
+                }
+            }
+        }
+
+        const auto c = unpackCell(clusters.cells[k]);
+        for (int i = 0; i < 3; ++i) {
+            clusters.positions[3 * k + i] =
+                std::clamp(x[i], static_cast<double>(c[i]) * cell_size, static_cast<double>(c[i] + 1) * cell_size);
+        }
+    }
+}
+
+} // namespace
+
+
+/*
+ * megamol::mesh::lod::Simplify
+ */
+void megamol::mesh::lod::Simplify(std::vector<float> const& vertices, std::vector<float> const* normals,
+    std::vector<unsigned int> const& indices, unsigned int resolution, unsigned int num_levels,
+    std::vector<Level>& levels) {
+    levels.clear();
+    const size_t num_vertices = vertices.size() / 3;
+    const size_t num_triangles = indices.size() / 3;
+    const bool with_normals = normals != nullptr && normals->size() >= 3 * num_vertices;
+    if (num_vertices == 0 || num_triangles == 0 || num_levels == 0) {
+        return;
+    }
+
+    // the grid starts at the lower corner of the bounding box
+    std::vector<std::array<float, 6>> chunk_bounds(NumChunks);
+#pragma omp parallel for schedule(static)
+    for (int64_t c = 0; c < NumChunks; ++c) {
+        auto& b = chunk_bounds[c];
+        b = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+            -std::numeric_limits<float>::max()};
+        for (size_t v = chunkBegin(num_vertices, c); v < chunkBegin(num_vertices, c + 1); ++v) {
+            for (int i = 0; i < 3; ++i) {
+                b[i] = std::min(b[i], vertices[3 * v + i]);
+                b[i + 3] = std::max(b[i + 3], vertices[3 * v + i]);
+            }
+        }
+    }
+    std::array<float, 6> bounds = chunk_bounds[0];
+    for (auto const& b : chunk_bounds) {
+        for (int i = 0; i < 3; ++i) {
+            bounds[i] = std::min(bounds[i], b[i]);
+            bounds[i + 3] = std::max(bounds[i + 3], b[i + 3]);
+        }
+    }
+    const std::array<double, 3> origin = {bounds[0], bounds[1], bounds[2]};
+    const auto extent = std::max({bounds[3] - bounds[0], bounds[4] - bounds[1], bounds[5] - bounds[2]});
+    resolution = std::clamp(resolution, 1u, MaxResolution);
+    double cell_size = extent > 0.0f ? static_cast<double>(extent) / resolution : 1.0;
+
+    // the first level clusters the input vertices
+    std::vector<uint32_t> vertex_clusters;
+    Clusters clusters;
+    Partition part;
+    std::vector<size_t> first;
+    {
+        std::vector<uint64_t> keys(num_vertices);
+#pragma omp parallel for schedule(static)
+        for (int64_t v = 0; v < static_cast<int64_t>(num_vertices); ++v) {
+            std::array<uint64_t, 3> c;
+            for (int i = 0; i < 3; ++i) {
+                const auto x = std::floor((vertices[3 * v + i] - origin[i]) / cell_size);
+                c[i] = static_cast<uint64_t>(std::clamp(x, 0.0, static_cast<double>(CoordMask)));
+            }
+            keys[v] = packCell(c[0], c[1], c[2]);
+        }
+        cluster(keys, vertex_clusters, clusters.cells, part, first);
+    }
+    clusters.resize(clusters.cells.size(), with_normals);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < NumBuckets; ++b) {
+        for (auto j = part.start[b]; j < part.start[b + 1]; ++j) {
+            const auto v = part.order[j];
+            const auto k = vertex_clusters[v];
+            for (int i = 0; i < 3; ++i) {
+                clusters.sums[3 * k + i] += vertices[3 * v + i] - origin[i];
+            }
+            ++clusters.counts[k];
+            if (with_normals) {
+                for (int i = 0; i < 3; ++i) {
+                    clusters.normals[3 * k + i] += (*normals)[3 * v + i];
+                }
+            }
+        }
+    }
+
+    // every triangle adds the area-weighted quadric of its plane to the clusters of its vertices
+    double total_weight = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : total_weight)
+    for (int64_t t = 0; t < static_cast<int64_t>(num_triangles); ++t) {
+        std::array<std::array<double, 3>, 3> p;
+        bool valid = true;
+        for (int c = 0; c < 3; ++c) {
+            const auto v = indices[3 * t + c];
+            valid = valid && v < num_vertices;
+            for (int i = 0; valid && i < 3; ++i) {
+                p[c][i] = vertices[3 * v + i] - origin[i];
+            }
+        }
+        if (!valid) {
+            continue;
+        }
+        const std::array<double, 3> e0 = {p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2]};
+        const std::array<double, 3> e1 = {p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2]};
+        std::array<double, 3> n = {
+            e0[1] * e1[2] - e0[2] * e1[1], e0[2] * e1[0] - e0[0] * e1[2], e0[0] * e1[1] - e0[1] * e1[0]};
+        const auto len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        if (len == 0.0) {
+            continue;
+        }
+        for (auto& x : n) {
+            x /= len;
+        }
+        const auto d = -(n[0] * p[0][0] + n[1] * p[0][1] + n[2] * p[0][2]);
+        const auto w = 0.5 * len;
+        const std::array<double, 10> q = {n[0] * n[0], n[0] * n[1], n[0] * n[2], n[0] * d, n[1] * n[1], n[1] * n[2],
+            n[1] * d, n[2] * n[2], n[2] * d, d * d};
+
+        const std::array<uint32_t, 3> k = {vertex_clusters[indices[3 * t]], vertex_clusters[indices[3 * t + 1]],
+            vertex_clusters[indices[3 * t + 2]]};
+        for (int c = 0; c < 3; ++c) {
+            // corners in the same cluster add their quadrics at once
+            if ((c > 0 && k[c] == k[0]) || (c > 1 && k[c] == k[1])) {
+                continue;
+            }
+            const auto f = w * static_cast<double>(std::count(k.begin() + c, k.end(), k[c]));
+            auto dst = clusters.quadrics.data() + 10 * static_cast<size_t>(k[c]);
+            for (int i = 0; i < 10; ++i) {
+#pragma omp atomic
+                dst[i] += f * q[i];
+            }
+        }
+        total_weight += 3.0 * w;
+    }
+
+    mapTriangles(indices.data(), num_triangles, vertex_clusters, clusters.triangles);
+
+    for (unsigned int l = 0; l < num_levels; ++l) {
+        if (l > 0) {
+            // the cells of the next level are the parents of the current cells
+            Clusters parents;
+            std::vector<uint32_t> parent_ids;
+            {
+                std::vector<uint64_t> keys(clusters.cells.size());
+#pragma omp parallel for schedule(static)
+                for (int64_t k = 0; k < static_cast<int64_t>(keys.size()); ++k) {
+                    keys[k] = parentCell(clusters.cells[k]);
+                }
+                cluster(keys, parent_ids, parents.cells, part, first);
+            }
+            if (parents.cells.size() == clusters.cells.size()) {
+                break;
+            }
+            parents.resize(parents.cells.size(), with_normals);
+
+#pragma omp parallel for schedule(dynamic)
+            for (int64_t b = 0; b < NumBuckets; ++b) {
+                for (auto j = part.start[b]; j < part.start[b + 1]; ++j) {
+                    const auto k = part.order[j];
+                    const auto p = parent_ids[k];
+                    for (int i = 0; i < 10; ++i) {
+                        parents.quadrics[10 * p + i] += clusters.quadrics[10 * k + i];
+                    }
+                    for (int i = 0; i < 3; ++i) {
+                        parents.sums[3 * p + i] += clusters.sums[3 * k + i];
+                    }
+                    parents.counts[p] += clusters.counts[k];
+                    if (with_normals) {
+                        for (int i = 0; i < 3; ++i) {
+                            parents.normals[3 * p + i] += clusters.normals[3 * k + i];
+                        }
+                    }
+                }
+            }
+
+            mapTriangles(clusters.triangles.data(), clusters.triangles.size() / 3, parent_ids, parents.triangles);
+
+#pragma omp parallel for schedule(static)
+            for (int64_t v = 0; v < static_cast<int64_t>(num_vertices); ++v) {
+                vertex_clusters[v] = parent_ids[vertex_clusters[v]];
+            }
+
+            clusters = std::move(parents);
+            cell_size *= 2.0;
+        }
+
+        if (clusters.triangles.empty()) {
+            break;
+        }
+        place(clusters, cell_size);
+
+        // the vertices are numbered by their first use, which keeps the triangles of a vertex close in memory
+        std::vector<uint32_t> remap(clusters.cells.size(), Skip);
+        uint32_t num_used = 0;
+        for (auto k : clusters.triangles) {
+            if (remap[k] == Skip) {
+                remap[k] = num_used++;
+            }
+        }
+
+        Level level;
+        level.cell_size = static_cast<float>(cell_size);
+        level.displacement_bound = static_cast<float>(cell_size * std::sqrt(3.0));
+        level.vertices = std::make_shared<std::vector<float>>(3 * static_cast<size_t>(num_used));
+        if (with_normals) {
+            level.normals = std::make_shared<std::vector<float>>(3 * static_cast<size_t>(num_used));
+        }
+        level.indices = std::make_shared<std::vector<unsigned int>>(clusters.triangles.size());
+
+        double error = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : error)
+        for (int64_t k = 0; k < static_cast<int64_t>(clusters.cells.size()); ++k) {
+            const auto x = clusters.positions.data() + 3 * k;
+            error += std::max(0.0, evaluate(clusters.quadrics.data() + 10 * k, x));
+            const auto r = remap[k];
+            if (r == Skip) {
+                continue;
+            }
+            for (int i = 0; i < 3; ++i) {
+                (*level.vertices)[3 * r + i] = static_cast<float>(x[i] + origin[i]);
+            }
+            if (with_normals) {
+                const auto n = clusters.normals.data() + 3 * k;
+                const auto len = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+                for (int i = 0; i < 3; ++i) {
+                    (*level.normals)[3 * r + i] = len > 0.0f ? n[i] / len : 0.0f;
+                }
+            }
+        }
+        level.rms_error = total_weight > 0.0 ? static_cast<float>(std::sqrt(error / total_weight)) : 0.0f;
+
+#pragma omp parallel for schedule(static)
+        for (int64_t i = 0; i < static_cast<int64_t>(clusters.triangles.size()); ++i) {
+            (*level.indices)[i] = remap[clusters.triangles[i]];
+        }
+
+        std::vector<double> chunk_displacement(NumChunks, 0.0);
+#pragma omp parallel for schedule(static)
+        for (int64_t c = 0; c < NumChunks; ++c) {
+            double max_sq = 0.0;
+            for (size_t v = chunkBegin(num_vertices, c); v < chunkBegin(num_vertices, c + 1); ++v) {
+                const auto x = clusters.positions.data() + 3 * static_cast<size_t>(vertex_clusters[v]);
+                double sq = 0.0;
+                for (int i = 0; i < 3; ++i) {
+                    const auto d = vertices[3 * v + i] - origin[i] - x[i];
+                    sq += d * d;
+                }
+                max_sq = std::max(max_sq, sq);
+            }
+            chunk_displacement[c] = max_sq;
+        }
+        level.max_displacement = static_cast<float>(
+            std::sqrt(*std::max_element(chunk_displacement.begin(), chunk_displacement.end())));
+
+        levels.push_back(std::move(level));
+    }
+}
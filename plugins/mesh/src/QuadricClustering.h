@@ -0,0 +1,56 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+namespace megamol::mesh::lod {
+
+/** A level of detail of a triangle mesh */
+struct Level {
+    /** Edge length of the grid cells whose vertices have been merged */
+    float cell_size = 0.0f;
+
+    std::shared_ptr<std::vector<float>> vertices;
+
+    /** Averaged input normals, nullptr if the input has none */
+    std::shared_ptr<std::vector<float>> normals;
+
+    std::shared_ptr<std::vector<unsigned int>> indices;
+
+    /** Largest distance between an input vertex and the vertex it has been merged into */
+    float max_displacement = 0.0f;
+
+    /** Upper bound of the displacement, the diagonal of a grid cell */
+    float displacement_bound = 0.0f;
+
+    /** Area-weighted root mean square distance of the vertices to the planes of the input triangles merged into them */
+    float rms_error = 0.0f;
+};
+
+/**
+ * Simplifies a triangle mesh into a chain of levels of detail by vertex clustering with quadric error metrics
+ * (Lindstrom, "Out-of-Core Simplification of Large Polygonal Models", 2000).
+ *
+ * The vertices in each cell of a uniform grid are merged into the point minimising the sum of squared distances to the
+ * planes of their triangles, clamped to the cell. Every following level doubles the cell size and is derived from the
+ * clusters of the previous one, so that the input triangles are only traversed for the first level. All passes are
+ * parallel, the clusters are partitioned by the hash of their cell so that threads own disjoint sets of clusters.
+ *
+ * @param vertices Three floats per vertex
+ * @param normals Three floats per vertex, or nullptr
+ * @param indices Three indices per triangle
+ * @param resolution The number of cells along the longest side of the bounding box for the first level
+ * @param num_levels The maximum number of levels, fewer are created if the mesh cannot be simplified further
+ * @param levels Receives the levels, from fine to coarse
+ */
+void Simplify(std::vector<float> const& vertices, std::vector<float> const* normals,
+    std::vector<unsigned int> const& indices, unsigned int resolution, unsigned int num_levels,
+    std::vector<Level>& levels);
+
+} // namespace megamol::mesh::lod
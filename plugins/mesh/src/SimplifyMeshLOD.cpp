@@ -0,0 +1,252 @@
+#include "SimplifyMeshLOD.h"
+
+#include "mesh/TriangleMeshCall.h"
+
+#include "mmcore/param/IntParam.h"
+#include "mmcore/param/StringParam.h"
+
+#include "mmcore/utility/DataHash.h"
+#include "mmcore/utility/log/Log.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+megamol::mesh::SimplifyMeshLOD::SimplifyMeshLOD()
+        : mesh_lhs_slot("mesh_lhs_slot", "Simplified mesh of the selected level.")
+        , lod_lhs_slot("lod_lhs_slot", "All levels of detail, named lod_0 (the input) to lod_n.")
+        , mesh_rhs_slot("mesh_rhs_slot", "Input surface mesh.")
+        , resolution("resolution", "Number of grid cells along the longest side of the bounding box for the finest "
+                                   "simplified level. Every further level halves the resolution.")
+        , num_levels("num_levels", "Maximum number of simplified levels.")
+        , output_level("output_level", "Level provided through the triangle mesh output, 0 being the input mesh.")
+        , error_bounds("error_bounds", "Triangle count, largest vertex displacement, its upper bound and the RMS "
+                                       "distance to the input triangles of every level.")
+        , input_hash(SimplifyMeshLOD::GUID())
+        , lod_collection(std::make_shared<MeshDataAccessCollection>())
+        , lod_version(0) {
+
+    // Connect input slot
+    this->mesh_rhs_slot.SetCompatibleCall<mesh::TriangleMeshCall::triangle_mesh_description>();
+    this->MakeSlotAvailable(&this->mesh_rhs_slot);
+
+    // Connect output slots
+    this->mesh_lhs_slot.SetCallback(
+        mesh::TriangleMeshCall::ClassName(), "get_data", &SimplifyMeshLOD::getMeshDataCallback);
+    this->mesh_lhs_slot.SetCallback(
+        mesh::TriangleMeshCall::ClassName(), "get_extent", &SimplifyMeshLOD::getMeshMetaDataCallback);
+    this->MakeSlotAvailable(&this->mesh_lhs_slot);
+
+    this->lod_lhs_slot.SetCallback(CallMesh::ClassName(), "GetData", &SimplifyMeshLOD::getLODDataCallback);
+    this->lod_lhs_slot.SetCallback(CallMesh::ClassName(), "GetMetaData", &SimplifyMeshLOD::getLODMetaDataCallback);
+    this->MakeSlotAvailable(&this->lod_lhs_slot);
+
+    // Initialize parameter slots
+    this->resolution << new core::param::IntParam(1024, 1, 1 << 20);
+    this->MakeSlotAvailable(&this->resolution);
+
+    this->num_levels << new core::param::IntParam(4, 1, 20);
+    this->MakeSlotAvailable(&this->num_levels);
+
+    this->output_level << new core::param::IntParam(1, 0);
+    this->MakeSlotAvailable(&this->output_level);
+
+    this->error_bounds << new core::param::StringParam("");
+    this->error_bounds.Parameter()->SetGUIReadOnly(true);
+    this->MakeSlotAvailable(&this->error_bounds);
+}
+
+megamol::mesh::SimplifyMeshLOD::~SimplifyMeshLOD() {
+    this->Release();
+}
+
+bool megamol::mesh::SimplifyMeshLOD::create() {
+    return true;
+}
+
+void megamol::mesh::SimplifyMeshLOD::release() {}
+
+bool megamol::mesh::SimplifyMeshLOD::getMeshDataCallback(core::Call& _call) {
+    assert(dynamic_cast<mesh::TriangleMeshCall*>(&_call) != nullptr);
+
+    auto& call = static_cast<mesh::TriangleMeshCall&>(_call);
+
+    if (!compute()) {
+        return false;
+    }
+
+    const auto level = std::min(static_cast<size_t>(this->output_level.Param<core::param::IntParam>()->Value()),
+        std::max<size_t>(this->levels.size(), 1) - 1);
+
+    if (level < this->levels.size()) {
+        call.set_vertices(this->levels[level].vertices);
+        call.set_normals(this->levels[level].normals);
+        call.set_indices(this->levels[level].indices);
+    } else {
+        call.set_vertices(nullptr);
+        call.set_normals(nullptr);
+        call.set_indices(nullptr);
+    }
+
+    call.SetDataHash(core::utility::DataHash(this->input_hash, level));
+
+    return true;
+}
+
+bool megamol::mesh::SimplifyMeshLOD::getMeshMetaDataCallback(core::Call& _call) {
+    assert(dynamic_cast<mesh::TriangleMeshCall*>(&_call) != nullptr);
+
+    auto& call = static_cast<mesh::TriangleMeshCall&>(_call);
+
+    // Get input extent
+    auto tmc_ptr = this->mesh_rhs_slot.CallAs<mesh::TriangleMeshCall>();
+
+    if (tmc_ptr == nullptr || !(*tmc_ptr)(1)) {
+        return false;
+    }
+
+    call.set_dimension(tmc_ptr->get_dimension());
+    call.set_bounding_box(tmc_ptr->get_bounding_box());
+
+    return true;
+}
+
+bool megamol::mesh::SimplifyMeshLOD::getLODDataCallback(core::Call& _call) {
+    auto call = dynamic_cast<CallMesh*>(&_call);
+
+    if (call == nullptr || !compute()) {
+        return false;
+    }
+
+    call->setData(this->lod_collection, this->lod_version);
+
+    return true;
+}
+
+bool megamol::mesh::SimplifyMeshLOD::getLODMetaDataCallback(core::Call& _call) {
+    auto call = dynamic_cast<CallMesh*>(&_call);
+
+    // Get input extent
+    auto tmc_ptr = this->mesh_rhs_slot.CallAs<mesh::TriangleMeshCall>();
+
+    if (call == nullptr || tmc_ptr == nullptr || !(*tmc_ptr)(1)) {
+        return false;
+    }
+
+    auto meta_data = call->getMetaData();
+    meta_data.m_frame_cnt = 1;
+    meta_data.m_bboxs.SetBoundingBox(tmc_ptr->get_bounding_box());
+    meta_data.m_bboxs.SetClipBox(tmc_ptr->get_bounding_box());
+    call->setMetaData(meta_data);
+
+    return true;
+}
+
+bool megamol::mesh::SimplifyMeshLOD::compute() {
+
+    // Check input connection and get data
+    auto tmc_ptr = this->mesh_rhs_slot.CallAs<mesh::TriangleMeshCall>();
+
+    if (tmc_ptr == nullptr) {
+        megamol::core::utility::log::Log::DefaultLog.WriteError(
+            "Triangle mesh input is not connected. [%s, %s, line %d]\n", __FILE__, __FUNCTION__, __LINE__);
+
+        return false;
+    }
+
+    auto& tmc = *tmc_ptr;
+
+    if (!tmc(0)) {
+        if (tmc.DataHash() != this->input_hash) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "Error getting triangle mesh. [%s, %s, line %d]\n", __FILE__, __FUNCTION__, __LINE__);
+
+            this->input_hash = tmc.DataHash();
+        }
+
+        return false;
+    }
+
+    if (compute_hash(tmc.DataHash()) == this->input_hash) {
+        return true;
+    }
+
+    this->input.vertices = tmc.get_vertices();
+    this->input.normals = tmc.get_normals();
+    this->input.indices = tmc.get_indices();
+
+    this->input_hash = compute_hash(tmc.DataHash());
+
+    this->levels.clear();
+    this->lod_collection = std::make_shared<MeshDataAccessCollection>();
+    ++this->lod_version;
+
+    // Set empty output when encountering empty input
+    if (this->input.vertices == nullptr || this->input.indices == nullptr) {
+        this->error_bounds.Param<core::param::StringParam>()->SetValue("");
+
+        return true;
+    }
+
+    // Level 0 is the input mesh, the simplified levels follow
+    lod::Level input_level;
+    input_level.vertices = this->input.vertices;
+    input_level.normals = this->input.normals;
+    input_level.indices = this->input.indices;
+    this->levels.push_back(input_level);
+
+    {
+        std::vector<lod::Level> simplified;
+        lod::Simplify(*this->input.vertices, this->input.normals.get(), *this->input.indices,
+            static_cast<unsigned int>(this->resolution.Param<core::param::IntParam>()->Value()),
+            static_cast<unsigned int>(this->num_levels.Param<core::param::IntParam>()->Value()), simplified);
+        this->levels.insert(this->levels.end(), simplified.begin(), simplified.end());
+    }
+
+    // Create output
+    std::stringstream errors;
+    errors << std::setprecision(3);
+
+    for (std::size_t l = 0; l < this->levels.size(); ++l) {
+        auto& level = this->levels[l];
+        const auto name = "lod_" + std::to_string(l);
+
+        std::vector<MeshDataAccessCollection::VertexAttribute> attributes;
+        attributes.push_back({reinterpret_cast<uint8_t*>(level.vertices->data()),
+            level.vertices->size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT), 3,
+            MeshDataAccessCollection::FLOAT, 12, 0, MeshDataAccessCollection::AttributeSemanticType::POSITION});
+        if (level.normals != nullptr && level.normals->size() == level.vertices->size()) {
+            attributes.push_back({reinterpret_cast<uint8_t*>(level.normals->data()),
+                level.normals->size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT), 3,
+                MeshDataAccessCollection::FLOAT, 12, 0, MeshDataAccessCollection::AttributeSemanticType::NORMAL});
+        }
+
+        MeshDataAccessCollection::IndexData indices;
+        indices.data = reinterpret_cast<uint8_t*>(level.indices->data());
+        indices.byte_size =
+            level.indices->size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::UNSIGNED_INT);
+        indices.type = MeshDataAccessCollection::UNSIGNED_INT;
+
+        this->lod_collection->addMesh(name, attributes, indices, MeshDataAccessCollection::PrimitiveType::TRIANGLES);
+
+        errors << (l > 0 ? "; " : "") << name << ": " << level.indices->size() / 3 << " triangles";
+        if (l > 0) {
+            errors << ", displacement " << level.max_displacement << " (bound " << level.displacement_bound
+                   << "), rms " << level.rms_error;
+        }
+    }
+
+    this->error_bounds.Param<core::param::StringParam>()->SetValue(errors.str());
+
+    megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+        "Created %u levels of detail: %s", static_cast<unsigned int>(this->levels.size()), errors.str().c_str());
+
+    return true;
+}
+
+SIZE_T megamol::mesh::SimplifyMeshLOD::compute_hash(const SIZE_T data_hash) const {
+    return core::utility::DataHash(SimplifyMeshLOD::GUID(), data_hash,
+        this->resolution.Param<core::param::IntParam>()->Value(),
+        this->num_levels.Param<core::param::IntParam>()->Value());
+}
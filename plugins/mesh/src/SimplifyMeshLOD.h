@@ -0,0 +1,130 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include "mmcore/Call.h"
+#include "mmcore/CalleeSlot.h"
+#include "mmcore/CallerSlot.h"
+#include "mmcore/Module.h"
+
+#include "mmcore/param/ParamSlot.h"
+
+#include "QuadricClustering.h"
+#include "mesh/MeshCalls.h"
+
+#include <memory>
+#include <vector>
+
+namespace megamol::mesh {
+/**
+ * Module for creating levels of detail of a triangle mesh by quadric-based vertex clustering. Unlike SimplifyMesh, it
+ * does not require CGAL and runs in parallel.
+ */
+class SimplifyMeshLOD : public core::Module {
+public:
+    /**
+     * Answer the name of this module.
+     *
+     * @return The name of this module.
+     */
+    static inline const char* ClassName() {
+        return "SimplifyMeshLOD";
+    }
+
+    /**
+     * Answer a human readable description of this module.
+     *
+     * @return A human readable description of this module.
+     */
+    static inline const char* Description() {
+        return "Create a chain of simplified levels of detail of a triangle mesh with error bounds";
+    }
+
+    /**
+     * Answers whether this module is available on the current system.
+     *
+     * @return 'true' if the module is available, 'false' otherwise.
+     */
+    static inline bool IsAvailable() {
+        return true;
+    }
+
+    /**
+     * Global unique ID that can e.g. be used for hash calculation.
+     *
+     * @return Unique ID
+     */
+    static inline SIZE_T GUID() {
+        return 472520022uLL;
+    }
+
+    /**
+     * Initialises a new instance.
+     */
+    SimplifyMeshLOD();
+
+    /**
+     * Finalises an instance.
+     */
+    ~SimplifyMeshLOD() override;
+
+protected:
+    /**
+     * Implementation of 'Create'.
+     *
+     * @return 'true' on success, 'false' otherwise.
+     */
+    bool create() override;
+
+    /**
+     * Implementation of 'Release'.
+     */
+    void release() override;
+
+private:
+    /** Callbacks for performing the computation and exposing data */
+    bool getMeshDataCallback(core::Call& call);
+    bool getMeshMetaDataCallback(core::Call& call);
+    bool getLODDataCallback(core::Call& call);
+    bool getLODMetaDataCallback(core::Call& call);
+
+    /** Function to start the computation */
+    bool compute();
+
+    /** Compute input hash */
+    SIZE_T compute_hash(SIZE_T data_hash) const;
+
+    /** The slots for requesting data from this module, i.e., lhs connection */
+    megamol::core::CalleeSlot mesh_lhs_slot;
+    megamol::core::CalleeSlot lod_lhs_slot;
+
+    /** The slots for querying data, i.e., a rhs connection */
+    megamol::core::CallerSlot mesh_rhs_slot;
+
+    /** Parameter slots */
+    core::param::ParamSlot resolution;
+    core::param::ParamSlot num_levels;
+    core::param::ParamSlot output_level;
+    core::param::ParamSlot error_bounds;
+
+    /** Input */
+    struct input_t {
+        std::shared_ptr<std::vector<float>> vertices;
+        std::shared_ptr<std::vector<float>> normals;
+        std::shared_ptr<std::vector<unsigned int>> indices;
+    } input;
+
+    SIZE_T input_hash;
+
+    /** Output, level 0 is the input mesh */
+    std::vector<lod::Level> levels;
+
+    std::shared_ptr<MeshDataAccessCollection> lod_collection;
+
+    uint32_t lod_version;
+};
+} // namespace megamol::mesh
@@ -1,14 +1,33 @@
 #include "WavefrontObjLoader.h"
 
+#include <fstream>
+#include <limits>
+
+#include "mmcore/param/BoolParam.h"
 #include "mmcore/param/FilePathParam.h"
+#include "mmcore/utility/AtomicFileWriter.h"
+#include "mmcore/utility/CacheFile.h"
+#include "mmcore/utility/log/Log.h"
+
+namespace {
+
+constexpr const char* CacheMagic = "MMOBJCACHE1";
+
+} // namespace
 
 megamol::mesh::WavefrontObjLoader::WavefrontObjLoader()
         : AbstractMeshDataSource()
         , m_version(0)
+        , m_bbox()
         , m_meta_data()
-        , m_filename_slot("Wavefront OBJ filename", "The name of the obj file to load") {
+        , m_filename_slot("Wavefront OBJ filename", "The name of the obj file to load")
+        , m_cache_slot("cache", "Stores the welded meshes in a binary file next to the obj file and loads them from "
+                                "there as long as the obj file does not change") {
     this->m_filename_slot << new core::param::FilePathParam("");
     this->MakeSlotAvailable(&this->m_filename_slot);
+
+    this->m_cache_slot << new core::param::BoolParam(false);
+    this->MakeSlotAvailable(&this->m_cache_slot);
 }
 
 megamol::mesh::WavefrontObjLoader::~WavefrontObjLoader() {}
@@ -44,196 +63,69 @@ bool megamol::mesh::WavefrontObjLoader::getMeshDataCallback(core::Call& caller)
 
         ++m_version;
 
-        auto vislib_filename = m_filename_slot.Param<core::param::FilePathParam>()->Value();
-        std::string filename(vislib_filename.generic_string());
-
-        m_obj_model = std::make_shared<TinyObjModel>();
-
-        std::string warn;
-        std::string err;
-
-        bool ret = tinyobj::LoadObj(
-            &m_obj_model->attrib, &m_obj_model->shapes, &m_obj_model->materials, &warn, &err, filename.c_str());
+        clearMeshAccessCollection();
+        m_meshes.clear();
 
-        if (!warn.empty()) {
-            std::cout << warn << std::endl;
-        }
-
-        if (!err.empty()) {
-            std::cerr << err << std::endl;
-        }
-
-        if (!ret) {
-            return false;
-        }
+        auto filename = m_filename_slot.Param<core::param::FilePathParam>()->Value();
 
-        const bool has_normals = !m_obj_model->attrib.normals.empty();
-        const bool has_texcoords = !m_obj_model->attrib.texcoords.empty();
-
-        // size_t vertex_cnt = m_obj_model->shapes.size() * 3;
-        this->m_positions.clear();
-        this->m_normals.clear();
-        this->m_texcoords.clear();
-
-        std::array<float, 6> bbox;
-        bbox[0] = std::numeric_limits<float>::max();
-        bbox[1] = std::numeric_limits<float>::max();
-        bbox[2] = std::numeric_limits<float>::max();
-        bbox[3] = -std::numeric_limits<float>::max();
-        bbox[4] = -std::numeric_limits<float>::max();
-        bbox[5] = -std::numeric_limits<float>::max();
-
-        m_indices.resize(m_obj_model->shapes.size());
-        m_positions.resize(m_obj_model->shapes.size());
-        if (has_normals) {
-            this->m_normals.resize(m_obj_model->shapes.size());
-        }
-        if (has_texcoords) {
-            this->m_texcoords.resize(m_obj_model->shapes.size());
+        // the cache is only valid for the file it has been written for
+        auto cache_path = std::filesystem::path(filename).concat(".mmcache");
+        std::string cache_key;
+        if (m_cache_slot.Param<core::param::BoolParam>()->Value()) {
+            cache_key = core::utility::CacheFileKey(CacheMagic, filename);
         }
 
-        // Loop over shapes
-        for (size_t s = 0; s < m_obj_model->shapes.size(); s++) {
-            auto& mesh = m_obj_model->shapes[s].mesh;
-            auto& lines = m_obj_model->shapes[s].lines;
-
-            uint64_t vertex_cnt = 0;
-            if (!mesh.indices.empty()) {
-                // Loop over faces(polygon)
-                size_t index_offset = 0;
-
-                m_indices[s].resize(mesh.num_face_vertices.size() * 3);
-                m_positions[s].reserve(mesh.num_face_vertices.size() * 3 * 3);
-                if (has_normals) {
-                    this->m_normals[s].reserve(mesh.num_face_vertices.size() * 3 * 3);
-                }
-                if (has_texcoords) {
-                    this->m_texcoords[s].reserve(mesh.num_face_vertices.size() * 3 * 2);
-                }
-
-                for (size_t f = 0; f < mesh.num_face_vertices.size(); f++) {
-                    int fv = mesh.num_face_vertices[f];
-
-                    assert(fv == 3); // assume that triangulation was forced
-
-                    // Loop over vertices in the face.
-                    for (size_t v = 0; v < fv; v++) {
-                        // access to vertex
-                        tinyobj::index_t idx = mesh.indices[index_offset + v];
-                        tinyobj::real_t vx = m_obj_model->attrib.vertices[3 * idx.vertex_index + 0];
-                        tinyobj::real_t vy = m_obj_model->attrib.vertices[3 * idx.vertex_index + 1];
-                        tinyobj::real_t vz = m_obj_model->attrib.vertices[3 * idx.vertex_index + 2];
-
-                        bbox[0] = std::min(bbox[0], static_cast<float>(vx));
-                        bbox[1] = std::min(bbox[1], static_cast<float>(vy));
-                        bbox[2] = std::min(bbox[2], static_cast<float>(vz));
-                        bbox[3] = std::max(bbox[3], static_cast<float>(vx));
-                        bbox[4] = std::max(bbox[4], static_cast<float>(vy));
-                        bbox[5] = std::max(bbox[5], static_cast<float>(vz));
-
-                        m_indices[s][index_offset + v] = index_offset + v;
-
-                        auto current_position_ptr = &(m_obj_model->attrib.vertices[3 * idx.vertex_index]);
-                        m_positions[s].insert(m_positions[s].end(), current_position_ptr, current_position_ptr + 3);
-
-                        if (has_normals && idx.normal_index >= 0) {
-                            auto current_normal_ptr = &(m_obj_model->attrib.normals[3 * idx.normal_index]);
-                            m_normals[s].insert(m_normals[s].end(), current_normal_ptr, current_normal_ptr + 3);
-                        }
-
-                        if (has_texcoords && idx.texcoord_index >= 0) {
-                            auto current_texcoords_ptr = &(m_obj_model->attrib.texcoords[2 * idx.texcoord_index]);
-                            m_texcoords[s].insert(
-                                m_texcoords[s].end(), current_texcoords_ptr, current_texcoords_ptr + 2);
-                        }
-                    }
-                    index_offset += fv;
-                    // per-face material
-                    // m_obj_model->shapes[s].mesh.material_ids[f];
-                }
-
-                vertex_cnt = mesh.num_face_vertices.size() * 3;
-
-            } else {
-                // Loop over line
-                size_t index_offset = 0;
-
-                m_indices[s].resize(lines.num_line_vertices.size() * 2);
-                m_positions[s].reserve(lines.num_line_vertices.size() * 3);
-
-                for (size_t f = 0; f < lines.num_line_vertices.size(); f++) {
-                    // access to vertex
-                    tinyobj::index_t idx = lines.indices[index_offset];
-                    tinyobj::real_t vx = m_obj_model->attrib.vertices[3 * idx.vertex_index + 0];
-                    tinyobj::real_t vy = m_obj_model->attrib.vertices[3 * idx.vertex_index + 1];
-                    tinyobj::real_t vz = m_obj_model->attrib.vertices[3 * idx.vertex_index + 2];
-
-                    bbox[0] = std::min(bbox[0], static_cast<float>(vx));
-                    bbox[1] = std::min(bbox[1], static_cast<float>(vy));
-                    bbox[2] = std::min(bbox[2], static_cast<float>(vz));
-                    bbox[3] = std::max(bbox[3], static_cast<float>(vx));
-                    bbox[4] = std::max(bbox[4], static_cast<float>(vy));
-                    bbox[5] = std::max(bbox[5], static_cast<float>(vz));
-
-                    auto current_position_ptr = &(m_obj_model->attrib.vertices[3 * idx.vertex_index]);
-                    m_positions[s].insert(m_positions[s].end(), current_position_ptr, current_position_ptr + 3);
-
-                    // Loop over line segments
-                    int fv = lines.num_line_vertices[f];
-                    for (size_t v = 0; v < fv; v++) {
-                        m_indices[s][index_offset + v] = lines.indices[index_offset + v].vertex_index;
-                    }
-                    index_offset += fv;
-                    // per-face material
-                    // m_obj_model->shapes[s].mesh.material_ids[f];
-                }
-
-                vertex_cnt = lines.num_line_vertices.size();
+        if (!cache_key.empty() && readCache(cache_path, cache_key)) {
+            megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+                "WavefrontObjLoader: Loaded %u meshes from cache \"%s\"", static_cast<unsigned int>(m_meshes.size()),
+                cache_path.generic_string().c_str());
+        } else {
+            if (!loadObj(filename)) {
+                return false;
+            }
+            if (!cache_key.empty() && !writeCache(cache_path, cache_key)) {
+                megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+                    "WavefrontObjLoader: Could not write the cache \"%s\"", cache_path.generic_string().c_str());
             }
+        }
 
-            const auto pos_ptr = m_positions[s].data();
+        for (auto& mesh : m_meshes) {
             std::vector<MeshDataAccessCollection::VertexAttribute> mesh_attributes;
 
-            mesh_attributes.emplace_back(MeshDataAccessCollection::VertexAttribute{reinterpret_cast<uint8_t*>(pos_ptr),
-                3 * vertex_cnt * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT), 3,
+            mesh_attributes.emplace_back(MeshDataAccessCollection::VertexAttribute{
+                reinterpret_cast<uint8_t*>(mesh.data.positions.data()),
+                mesh.data.positions.size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT), 3,
                 MeshDataAccessCollection::FLOAT, 12, 0, MeshDataAccessCollection::AttributeSemanticType::POSITION});
 
-            if (has_normals) {
-                const auto normal_ptr = m_normals[s].data();
-
+            if (!mesh.data.normals.empty()) {
                 mesh_attributes.emplace_back(MeshDataAccessCollection::VertexAttribute{
-                    reinterpret_cast<uint8_t*>(normal_ptr),
-                    3 * vertex_cnt * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT), 3,
-                    MeshDataAccessCollection::FLOAT, 12, 0, MeshDataAccessCollection::AttributeSemanticType::NORMAL});
+                    reinterpret_cast<uint8_t*>(mesh.data.normals.data()),
+                    mesh.data.normals.size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT),
+                    3, MeshDataAccessCollection::FLOAT, 12, 0,
+                    MeshDataAccessCollection::AttributeSemanticType::NORMAL});
             }
 
-            if (has_texcoords) {
-                const auto texcoord_ptr = m_texcoords[s].data();
+            if (!mesh.data.texcoords.empty()) {
                 mesh_attributes.emplace_back(MeshDataAccessCollection::VertexAttribute{
-                    reinterpret_cast<uint8_t*>(texcoord_ptr),
-                    2 * vertex_cnt * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT), 2,
-                    MeshDataAccessCollection::FLOAT, 8, 0, MeshDataAccessCollection::AttributeSemanticType::TEXCOORD});
+                    reinterpret_cast<uint8_t*>(mesh.data.texcoords.data()),
+                    mesh.data.texcoords.size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::FLOAT),
+                    2, MeshDataAccessCollection::FLOAT, 8, 0,
+                    MeshDataAccessCollection::AttributeSemanticType::TEXCOORD});
             }
 
             MeshDataAccessCollection::IndexData mesh_indices;
-            mesh_indices.data = reinterpret_cast<uint8_t*>(m_indices[s].data());
-            mesh_indices.byte_size =
-                m_indices[s].size() * MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::UNSIGNED_INT);
+            mesh_indices.data = reinterpret_cast<uint8_t*>(mesh.data.indices.data());
+            mesh_indices.byte_size = mesh.data.indices.size() *
+                                     MeshDataAccessCollection::getByteSize(MeshDataAccessCollection::UNSIGNED_INT);
             mesh_indices.type = MeshDataAccessCollection::UNSIGNED_INT;
 
-            // TODO add file name?
-            std::string identifier = m_obj_model->shapes[s].name;
-            if (!mesh.indices.empty()) {
-                m_mesh_access_collection.first->addMesh(
-                    identifier, mesh_attributes, mesh_indices, MeshDataAccessCollection::PrimitiveType::TRIANGLES);
-            } else {
-                m_mesh_access_collection.first->addMesh(identifier, mesh_attributes, mesh_indices);
-            }
-            m_mesh_access_collection.second.push_back(identifier);
+            m_mesh_access_collection.first->addMesh(
+                mesh.identifier, mesh_attributes, mesh_indices, mesh.primitive_type);
+            m_mesh_access_collection.second.push_back(mesh.identifier);
         }
 
-        m_meta_data.m_bboxs.SetBoundingBox(bbox[0], bbox[1], bbox[2], bbox[3], bbox[4], bbox[5]);
-        m_meta_data.m_bboxs.SetClipBox(bbox[0], bbox[1], bbox[2], bbox[3], bbox[4], bbox[5]);
+        m_meta_data.m_bboxs.SetBoundingBox(m_bbox[0], m_bbox[1], m_bbox[2], m_bbox[3], m_bbox[4], m_bbox[5]);
+        m_meta_data.m_bboxs.SetClipBox(m_bbox[0], m_bbox[1], m_bbox[2], m_bbox[3], m_bbox[4], m_bbox[5]);
         m_meta_data.m_frame_cnt = 1;
     }
 
@@ -253,3 +145,138 @@ bool megamol::mesh::WavefrontObjLoader::getMeshMetaDataCallback(core::Call& call
 }
 
 void megamol::mesh::WavefrontObjLoader::release() {}
+
+bool megamol::mesh::WavefrontObjLoader::loadObj(std::filesystem::path const& filename) {
+    std::vector<char> content;
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(filename, ec);
+        if (file && !ec) {
+            content.resize(size);
+            file.read(content.data(), static_cast<std::streamsize>(size));
+        }
+        if (!file || ec) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "WavefrontObjLoader: Could not read \"%s\"", filename.generic_string().c_str());
+            return false;
+        }
+    }
+
+    obj::Model model;
+    std::string error;
+    if (!obj::Parse(content.data(), content.size(), model, error)) {
+        megamol::core::utility::log::Log::DefaultLog.WriteError(
+            "WavefrontObjLoader: Could not parse \"%s\": %s", filename.generic_string().c_str(), error.c_str());
+        return false;
+    }
+    content = std::vector<char>();
+
+    // faces and lines of a shape end up in separate meshes, as a mesh has a single primitive type
+    std::vector<std::vector<obj::Corner> const*> corners;
+    for (auto const& shape : model.shapes) {
+        if (!shape.triangles.empty()) {
+            m_meshes.push_back({shape.name, MeshDataAccessCollection::PrimitiveType::TRIANGLES, {}});
+            corners.push_back(&shape.triangles);
+        }
+        if (!shape.lines.empty()) {
+            m_meshes.push_back({shape.triangles.empty() ? shape.name : shape.name + "/lines",
+                MeshDataAccessCollection::PrimitiveType::LINES, {}});
+            corners.push_back(&shape.lines);
+        }
+    }
+
+    std::vector<std::array<float, 6>> bboxes(m_meshes.size());
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t m = 0; m < static_cast<int64_t>(m_meshes.size()); ++m) {
+        obj::Weld(model, *corners[m], m_meshes[m].data);
+        auto const& positions = m_meshes[m].data.positions;
+
+        auto& bbox = bboxes[m];
+        bbox = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+            std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(),
+            -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+        for (size_t i = 0; i < positions.size(); i += 3) {
+            for (size_t d = 0; d < 3; ++d) {
+                bbox[d] = std::min(bbox[d], positions[i + d]);
+                bbox[d + 3] = std::max(bbox[d + 3], positions[i + d]);
+            }
+        }
+    }
+
+    m_bbox = {std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+        -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()};
+    size_t vertex_cnt = 0;
+    for (size_t m = 0; m < m_meshes.size(); ++m) {
+        for (size_t d = 0; d < 3; ++d) {
+            m_bbox[d] = std::min(m_bbox[d], bboxes[m][d]);
+            m_bbox[d + 3] = std::max(m_bbox[d + 3], bboxes[m][d + 3]);
+        }
+        vertex_cnt += m_meshes[m].data.positions.size() / 3;
+    }
+
+    megamol::core::utility::log::Log::DefaultLog.WriteInfo(
+        "WavefrontObjLoader: Loaded %u meshes with %zu welded vertices from %zu positions in \"%s\"",
+        static_cast<unsigned int>(m_meshes.size()), vertex_cnt, model.positions.size() / 3,
+        filename.generic_string().c_str());
+
+    return true;
+}
+
+bool megamol::mesh::WavefrontObjLoader::readCache(std::filesystem::path const& path, std::string const& key) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        return false;
+    }
+
+    try {
+        if (core::utility::ReadCacheString(file) != key) {
+            return false;
+        }
+        for (auto& v : m_bbox) {
+            v = core::utility::ReadCacheValue<float>(file);
+        }
+        m_meshes.resize(core::utility::ReadCacheValue<std::uint64_t>(file));
+        for (auto& mesh : m_meshes) {
+            mesh.identifier = core::utility::ReadCacheString(file);
+            mesh.primitive_type =
+                static_cast<MeshDataAccessCollection::PrimitiveType>(core::utility::ReadCacheValue<std::uint8_t>(file));
+            core::utility::ReadCacheVector(file, mesh.data.positions);
+            core::utility::ReadCacheVector(file, mesh.data.normals);
+            core::utility::ReadCacheVector(file, mesh.data.texcoords);
+            core::utility::ReadCacheVector(file, mesh.data.indices);
+        }
+    } catch (const std::exception&) {
+        file.setstate(std::ios::failbit);
+    }
+
+    if (!file) {
+        m_meshes.clear();
+        return false;
+    }
+    return true;
+}
+
+bool megamol::mesh::WavefrontObjLoader::writeCache(std::filesystem::path const& path, std::string const& key) const {
+    core::utility::AtomicFileWriter output(path);
+    auto& file = output.Stream();
+    if (!output.IsOpen()) {
+        return false;
+    }
+
+    core::utility::WriteCacheString(file, key);
+    for (auto v : m_bbox) {
+        core::utility::WriteCacheValue(file, v);
+    }
+    core::utility::WriteCacheValue(file, static_cast<std::uint64_t>(m_meshes.size()));
+    for (auto const& mesh : m_meshes) {
+        core::utility::WriteCacheString(file, mesh.identifier);
+        core::utility::WriteCacheValue(file, static_cast<std::uint8_t>(mesh.primitive_type));
+        core::utility::WriteCacheVector(file, mesh.data.positions);
+        core::utility::WriteCacheVector(file, mesh.data.normals);
+        core::utility::WriteCacheVector(file, mesh.data.texcoords);
+        core::utility::WriteCacheVector(file, mesh.data.indices);
+    }
+
+    return output.Commit();
+}
@@ -7,8 +7,10 @@
 
 #pragma once
 
-#include <tiny_obj_loader.h>
+#include <array>
+#include <filesystem>
 
+#include "WavefrontObjParser.h"
 #include "mesh/AbstractMeshDataSource.h"
 #include "mesh/MeshCalls.h"
 #include "mesh/MeshDataAccessCollection.h"
@@ -34,7 +36,7 @@ public:
      * @return A human readable description of this module.
      */
     static const char* Description() {
-        return "Data source for simply loading a wavefront obj file from disk";
+        return "Data source for loading a wavefront obj file from disk, welding the vertices of every shape";
     }
 
     /**
@@ -74,46 +76,52 @@ protected:
     void release() override;
 
 private:
-    struct TinyObjModel {
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> materials;
+    struct Mesh {
+        std::string identifier;
+        MeshDataAccessCollection::PrimitiveType primitive_type;
+        obj::WeldedMesh data;
     };
 
-    uint32_t m_version;
-
     /**
-     * Representation of obj model as loaded by tinyobjloader
+     * Parses the obj file and welds the vertices of its shapes.
+     *
+     * @return 'true' on success, 'false' on failure.
      */
-    std::shared_ptr<TinyObjModel> m_obj_model;
+    bool loadObj(std::filesystem::path const& filename);
 
     /**
-     * Internal storage for unpacked positions, i.e one position per vertex, three vertices per triangle
+     * Loads the meshes from the binary cache if it has been written for 'key'.
+     *
+     * @return 'true' on success, 'false' if there is no valid cache.
      */
-    std::vector<std::vector<float>> m_positions;
+    bool readCache(std::filesystem::path const& path, std::string const& key);
 
     /**
-     * Internal storage for unpacked normals, i.e one normal per vertex, three vertices per triangle
+     * Stores the meshes in the binary cache.
+     *
+     * @return 'true' on success, 'false' on failure.
      */
-    std::vector<std::vector<float>> m_normals;
+    bool writeCache(std::filesystem::path const& path, std::string const& key) const;
 
-    /**
-     * Internal storage for unpacked texcoords, i.e one texcoord per vertex, three vertices per triangle
-     */
-    std::vector<std::vector<float>> m_texcoords;
+    uint32_t m_version;
 
     /**
-     *
+     * The welded meshes, one per shape with faces and one per shape with lines
      */
-    std::vector<std::vector<unsigned int>> m_indices;
+    std::vector<Mesh> m_meshes;
+
+    std::array<float, 6> m_bbox;
 
     /**
      * Meta data for communicating data updates, as well as data size
      */
     core::Spatial3DMetaData m_meta_data;
 
-    /** The gltf file name */
+    /** The obj file name */
     core::param::ParamSlot m_filename_slot;
+
+    /** Whether to use a binary cache next to the obj file */
+    core::param::ParamSlot m_cache_slot;
 };
 
 } // namespace megamol::mesh
@@ -0,0 +1,352 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "WavefrontObjParser.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <limits>
+#include <thread>
+#include <unordered_map>
+
+using namespace megamol::mesh::obj;
+
+namespace {
+
+/** Blocks smaller than this are not worth a thread of their own */
+constexpr size_t MinBlockSize = 1 << 20;
+
+enum class Statement { Other, Position, Normal, Texcoord, Face, Line, Group };
+
+struct Counts {
+    size_t positions = 0;
+    size_t normals = 0;
+    size_t texcoords = 0;
+};
+
+struct Block {
+    const char* begin;
+    const char* end;
+    Counts counts;
+
+    /** The first shape continues the last shape of the previous block */
+    std::vector<Shape> shapes;
+    std::string error;
+};
+
+struct CornerHash {
+    size_t operator()(Corner const& c) const {
+        uint64_t h = static_cast<uint32_t>(c.v) * 0x9e3779b97f4a7c15ull;
+        h ^= (static_cast<uint32_t>(c.vt) + (h << 6) + (h >> 2)) * 0xc2b2ae3d27d4eb4full;
+        h ^= (static_cast<uint32_t>(c.vn) + (h << 6) + (h >> 2)) * 0x165667b19e3779f9ull;
+        return static_cast<size_t>(h ^ (h >> 32));
+    }
+};
+
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipSpace(const char* p, const char* end) {
+    while (p < end && isSpace(*p)) {
+        ++p;
+    }
+    return p;
+}
+
+/** Identifies the statement of a line and advances 'p' past its keyword */
+Statement classify(const char*& p, const char* end) {
+    p = skipSpace(p, end);
+    const auto keyword = [&p, end](const char* word, size_t len) {
+        if (static_cast<size_t>(end - p) < len || std::memcmp(p, word, len) != 0 ||
+            (p + len < end && !isSpace(p[len]))) {
+            return false;
+        }
+        p += len;
+        return true;
+    };
+    if (keyword("v", 1)) {
+        return Statement::Position;
+    } else if (keyword("vn", 2)) {
+        return Statement::Normal;
+    } else if (keyword("vt", 2)) {
+        return Statement::Texcoord;
+    } else if (keyword("f", 1)) {
+        return Statement::Face;
+    } else if (keyword("l", 1)) {
+        return Statement::Line;
+    } else if (keyword("o", 1) || keyword("g", 1)) {
+        return Statement::Group;
+    }
+    return Statement::Other;
+}
+
+const char* lineEnd(const char* p, const char* end) {
+    auto e = static_cast<const char*>(std::memchr(p, '\n', end - p));
+    return e != nullptr ? e : end;
+}
+
+bool parseFloats(const char*& p, const char* end, float* out, size_t required, size_t max) {
+    for (size_t i = 0; i < max; ++i) {
+        p = skipSpace(p, end);
+        if (p < end && *p == '+') {
+            ++p;
+        }
+        auto r = std::from_chars(p, end, out[i]);
+        if (r.ec != std::errc()) {
+            return i >= required;
+        }
+        p = r.ptr;
+    }
+    return true;
+}
+
+/**
+ * Parses a one-based or relative obj index into a zero-based one.
+ *
+ * @param count The number of entries defined before this line
+ * @param total The number of entries in the file
+ */
+bool parseIndex(const char*& p, const char* end, size_t count, size_t total, int32_t& out) {
+    int64_t i = 0;
+    auto r = std::from_chars(p, end, i);
+    if (r.ec != std::errc() || i == 0) {
+        return false;
+    }
+    p = r.ptr;
+    const int64_t idx = i > 0 ? i - 1 : static_cast<int64_t>(count) + i;
+    if (idx < 0 || idx >= static_cast<int64_t>(total)) {
+        return false;
+    }
+    out = static_cast<int32_t>(idx);
+    return true;
+}
+
+/** Parses the corners 'v', 'v/vt', 'v//vn' or 'v/vt/vn' of a face or line */
+bool parseCorners(const char* p, const char* end, Counts const& counts, Counts const& totals,
+    std::vector<Corner>& corners) {
+    corners.clear();
+    for (p = skipSpace(p, end); p < end; p = skipSpace(p, end)) {
+        Corner c;
+        if (!parseIndex(p, end, counts.positions, totals.positions, c.v)) {
+            return false;
+        }
+        if (p < end && *p == '/') {
+            ++p;
+            if (p < end && *p != '/' && !parseIndex(p, end, counts.texcoords, totals.texcoords, c.vt)) {
+                return false;
+            }
+            if (p < end && *p == '/') {
+                ++p;
+                if (!parseIndex(p, end, counts.normals, totals.normals, c.vn)) {
+                    return false;
+                }
+            }
+        }
+        if (p < end && !isSpace(*p)) {
+            return false;
+        }
+        corners.push_back(c);
+    }
+    return true;
+}
+
+void countBlock(Block& block) {
+    for (auto p = block.begin; p < block.end;) {
+        const auto e = lineEnd(p, block.end);
+        switch (classify(p, e)) {
+        case Statement::Position:
+            ++block.counts.positions;
+            break;
+        case Statement::Normal:
+            ++block.counts.normals;
+            break;
+        case Statement::Texcoord:
+            ++block.counts.texcoords;
+            break;
+        default:
+            break;
+        }
+        p = e + 1;
+    }
+}
+
+/**
+ * Parses a block, writing the attributes to the model at the offsets given by the counts of the previous blocks.
+ */
+void parseBlock(Block& block, Counts counts, Counts const& totals, Model& model) {
+    std::vector<Corner> corners;
+    block.shapes.emplace_back();
+    for (auto p = block.begin; p < block.end;) {
+        const auto line = p;
+        const auto e = lineEnd(p, block.end);
+        bool ok = true;
+        switch (classify(p, e)) {
+        case Statement::Position:
+            ok = parseFloats(p, e, model.positions.data() + 3 * counts.positions++, 3, 3);
+            break;
+        case Statement::Normal:
+            ok = parseFloats(p, e, model.normals.data() + 3 * counts.normals++, 3, 3);
+            break;
+        case Statement::Texcoord:
+            ok = parseFloats(p, e, model.texcoords.data() + 2 * counts.texcoords++, 1, 2);
+            break;
+        case Statement::Face:
+            ok = parseCorners(p, e, counts, totals, corners) && corners.size() >= 3;
+            for (size_t i = 1; ok && i + 1 < corners.size(); ++i) {
+                auto& tris = block.shapes.back().triangles;
+                tris.insert(tris.end(), {corners[0], corners[i], corners[i + 1]});
+            }
+            break;
+        case Statement::Line:
+            ok = parseCorners(p, e, counts, totals, corners) && corners.size() >= 2;
+            for (size_t i = 0; ok && i + 1 < corners.size(); ++i) {
+                auto& lines = block.shapes.back().lines;
+                lines.insert(lines.end(), {corners[i], corners[i + 1]});
+            }
+            break;
+        case Statement::Group: {
+            p = skipSpace(p, e);
+            auto last = e;
+            while (last > p && isSpace(last[-1])) {
+                --last;
+            }
+            block.shapes.emplace_back().name.assign(p, last);
+        } break;
+        default:
+            break;
+        }
+        if (!ok) {
+            block.error = "malformed statement \"" + std::string(skipSpace(line, e), e) + "\"";
+            return;
+        }
+        p = e + 1;
+    }
+}
+
+} // namespace
+
+
+/*
+ * megamol::mesh::obj::Parse
+ */
+bool megamol::mesh::obj::Parse(const char* data, size_t size, Model& model, std::string& error, size_t numBlocks) {
+    model = Model();
+    error.clear();
+
+    // split at line breaks into blocks of roughly the same size
+    if (numBlocks == 0) {
+        const size_t numThreads = std::max(1u, std::thread::hardware_concurrency());
+        numBlocks = std::clamp<size_t>(size / MinBlockSize, 1, 4 * numThreads);
+    }
+    std::vector<Block> blocks(numBlocks);
+    const auto end = data + size;
+    auto begin = data;
+    for (size_t b = 0; b < numBlocks; ++b) {
+        auto split = b + 1 < numBlocks ? data + size * (b + 1) / numBlocks : end;
+        if (split < begin) {
+            split = begin;
+        }
+        if (split < end) {
+            split = lineEnd(split, end);
+        }
+        blocks[b].begin = begin;
+        blocks[b].end = split;
+        begin = split < end ? split + 1 : end;
+    }
+
+    // the attributes are counted first, so that every block knows where its attributes go and what relative indices
+    // refer to
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < static_cast<int64_t>(numBlocks); ++b) {
+        countBlock(blocks[b]);
+    }
+    std::vector<Counts> offsets(numBlocks);
+    Counts totals;
+    for (size_t b = 0; b < numBlocks; ++b) {
+        offsets[b] = totals;
+        totals.positions += blocks[b].counts.positions;
+        totals.normals += blocks[b].counts.normals;
+        totals.texcoords += blocks[b].counts.texcoords;
+    }
+    constexpr auto maxIndex = static_cast<size_t>(std::numeric_limits<int32_t>::max());
+    if (totals.positions > maxIndex || totals.normals > maxIndex || totals.texcoords > maxIndex) {
+        error = "too many vertices";
+        return false;
+    }
+    model.positions.resize(3 * totals.positions);
+    model.normals.resize(3 * totals.normals);
+    model.texcoords.resize(2 * totals.texcoords);
+
+#pragma omp parallel for schedule(dynamic)
+    for (int64_t b = 0; b < static_cast<int64_t>(numBlocks); ++b) {
+        parseBlock(blocks[b], offsets[b], totals, model);
+    }
+
+    for (auto& block : blocks) {
+        if (!block.error.empty()) {
+            error = block.error;
+            return false;
+        }
+        for (size_t s = 0; s < block.shapes.size(); ++s) {
+            auto& shape = block.shapes[s];
+            if (s == 0 && !model.shapes.empty()) {
+                auto& last = model.shapes.back();
+                last.triangles.insert(last.triangles.end(), shape.triangles.begin(), shape.triangles.end());
+                last.lines.insert(last.lines.end(), shape.lines.begin(), shape.lines.end());
+            } else {
+                model.shapes.emplace_back(std::move(shape));
+            }
+        }
+    }
+    model.shapes.erase(std::remove_if(model.shapes.begin(), model.shapes.end(),
+                           [](Shape const& s) { return s.triangles.empty() && s.lines.empty(); }),
+        model.shapes.end());
+
+    return true;
+}
+
+
+/*
+ * megamol::mesh::obj::Weld
+ */
+void megamol::mesh::obj::Weld(Model const& model, std::vector<Corner> const& corners, WeldedMesh& mesh) {
+    const bool hasNormals = !model.normals.empty();
+    const bool hasTexcoords = !model.texcoords.empty();
+
+    mesh = WeldedMesh();
+    mesh.indices.resize(corners.size());
+    std::unordered_map<Corner, uint32_t, CornerHash> vertices;
+    vertices.reserve(corners.size() / 4 + 1);
+    for (size_t i = 0; i < corners.size(); ++i) {
+        auto const& c = corners[i];
+        auto const [it, inserted] = vertices.try_emplace(c, static_cast<uint32_t>(vertices.size()));
+        mesh.indices[i] = it->second;
+        if (!inserted) {
+            continue;
+        }
+
+        auto const pos = model.positions.data() + 3 * c.v;
+        mesh.positions.insert(mesh.positions.end(), pos, pos + 3);
+        if (hasNormals) {
+            if (c.vn >= 0) {
+                auto const n = model.normals.data() + 3 * c.vn;
+                mesh.normals.insert(mesh.normals.end(), n, n + 3);
+            } else {
+                mesh.normals.insert(mesh.normals.end(), 3, 0.0f);
+            }
+        }
+        if (hasTexcoords) {
+            if (c.vt >= 0) {
+                auto const t = model.texcoords.data() + 2 * c.vt;
+                mesh.texcoords.insert(mesh.texcoords.end(), t, t + 2);
+            } else {
+                mesh.texcoords.insert(mesh.texcoords.end(), 2, 0.0f);
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace megamol::mesh::obj {
+
+/** The position, texcoord and normal index of a face corner, -1 if absent */
+struct Corner {
+    int32_t v = -1;
+    int32_t vt = -1;
+    int32_t vn = -1;
+
+    bool operator==(Corner const& rhs) const {
+        return v == rhs.v && vt == rhs.vt && vn == rhs.vn;
+    }
+};
+
+/** A group of faces and lines started by an 'o' or 'g' statement */
+struct Shape {
+    std::string name;
+
+    /** Three corners per triangle, polygons are triangulated as fans */
+    std::vector<Corner> triangles;
+
+    /** Two corners per segment, polylines are split into segments */
+    std::vector<Corner> lines;
+};
+
+struct Model {
+    /** Three floats per entry */
+    std::vector<float> positions;
+    std::vector<float> normals;
+
+    /** Two floats per entry, w is dropped */
+    std::vector<float> texcoords;
+
+    std::vector<Shape> shapes;
+};
+
+/** A mesh with one vertex per distinct position/texcoord/normal index triplet */
+struct WeldedMesh {
+    std::vector<float> positions;
+    std::vector<float> normals;
+    std::vector<float> texcoords;
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * Parses the geometry of an obj file. The data is split at line breaks into blocks that are parsed in parallel,
+ * materials, smoothing groups and free-form geometry are ignored.
+ *
+ * @param data The content of the file
+ * @param size The size of the content in bytes
+ * @param model Receives the parsed geometry
+ * @param error Receives the reason if the file is malformed
+ * @param numBlocks The number of blocks, chosen from the size and the number of threads if 0
+ *
+ * @return false if the file is malformed
+ */
+bool Parse(const char* data, size_t size, Model& model, std::string& error, size_t numBlocks = 0);
+
+/**
+ * Merges the corners referring to the same position, texcoord and normal into one vertex, keeping the topology.
+ * Normals and texcoords missing at some corners are zero.
+ *
+ * @param model The model holding the attributes
+ * @param corners The corners of a shape's triangles or lines
+ * @param mesh Receives the vertices and the index of every corner
+ */
+void Weld(Model const& model, std::vector<Corner> const& corners, WeldedMesh& mesh);
+
+} // namespace megamol::mesh::obj
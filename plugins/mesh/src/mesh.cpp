@@ -11,6 +11,7 @@
 #include "ObjWriter.h"
 #include "STLWriter.h"
 #include "SimplifyMesh.h"
+#include "SimplifyMeshLOD.h"
 #include "UIElement.h"
 #include "WavefrontObjLoader.h"
 #include "gltf/glTFFileLoader.h"
@@ -37,6 +38,7 @@ public:
         this->module_descriptions.RegisterAutoDescription<megamol::mesh::MeshBakery>();
         this->module_descriptions.RegisterAutoDescription<megamol::mesh::UIElement>();
         this->module_descriptions.RegisterAutoDescription<megamol::mesh::STLWriter>();
+        this->module_descriptions.RegisterAutoDescription<megamol::mesh::SimplifyMeshLOD>();
 
         // register calls
         this->call_descriptions.RegisterAutoDescription<megamol::mesh::Call3DInteraction>();
@@ -0,0 +1,198 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "WavefrontObjParser.h"
+
+#include "mmtest/Check.h"
+
+using namespace megamol::mesh::obj;
+
+namespace {
+
+constexpr int NumObjects = 5;
+constexpr int QuadsPerObject = 400;
+
+/**
+ * Quads with four vertices of their own each, half of them referenced by absolute and half by relative indices. Lines
+ * end with CRLF in every other object, comments and blank lines are in between and the last line has no line break.
+ */
+std::string makeFixture() {
+    std::string obj = "# fixture\nmtllib none.mtl\n";
+    int quad = 0;
+    for (int o = 0; o < NumObjects; ++o) {
+        const std::string eol = o % 2 == 0 ? "\n" : "\r\n";
+        obj += "o object" + std::to_string(o) + "  " + eol + "usemtl none" + eol;
+        for (int q = 0; q < QuadsPerObject; ++q, ++quad) {
+            for (int c = 0; c < 4; ++c) {
+                const int x = quad + (c == 1 || c == 2), y = c >= 2;
+                obj += "v " + std::to_string(x) + " " + std::to_string(y) + " +" + std::to_string(quad) + eol;
+                obj += "vt " + std::to_string(c) + " 0.5 0" + eol;
+            }
+            obj += "vn 0 0 " + std::to_string(quad) + eol;
+            if (q % 2 == 0) {
+                const int first = 4 * quad + 1;
+                obj += "f";
+                for (int c = 0; c < 4; ++c) {
+                    obj += " " + std::to_string(first + c) + "/" + std::to_string(first + c) + "/" +
+                           std::to_string(quad + 1);
+                }
+            } else {
+                obj += "\t f  -4/-4/-1 -3/-3/-1\t-2/-2/-1 -1/-1/-1 ";
+            }
+            obj += eol;
+            if (q % 50 == 0) {
+                obj += eol + "# polyline" + eol + "l -4 -3 -2" + eol;
+            }
+        }
+    }
+    obj.pop_back();
+    return obj;
+}
+
+bool sameModel(Model const& a, Model const& b) {
+    if (a.positions != b.positions || a.normals != b.normals || a.texcoords != b.texcoords ||
+        a.shapes.size() != b.shapes.size()) {
+        return false;
+    }
+    for (size_t s = 0; s < a.shapes.size(); ++s) {
+        if (a.shapes[s].name != b.shapes[s].name || a.shapes[s].triangles != b.shapes[s].triangles ||
+            a.shapes[s].lines != b.shapes[s].lines) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** Checks the parsed fixture against what was written */
+void checkFixture(Model const& model) {
+    const size_t numQuads = NumObjects * QuadsPerObject;
+    CHECK(model.positions.size() == 3 * 4 * numQuads);
+    CHECK(model.texcoords.size() == 2 * 4 * numQuads);
+    CHECK(model.normals.size() == 3 * numQuads);
+    CHECK(model.shapes.size() == NumObjects);
+    if (model.shapes.size() != NumObjects || model.positions.size() != 3 * 4 * numQuads) {
+        return;
+    }
+
+    size_t mismatches = 0;
+    for (int o = 0; o < NumObjects; ++o) {
+        auto const& shape = model.shapes[o];
+        CHECK(shape.name == "object" + std::to_string(o));
+        CHECK(shape.triangles.size() == 6 * QuadsPerObject);
+        CHECK(shape.lines.size() == 4 * (QuadsPerObject / 50));
+        if (shape.triangles.size() != 6 * QuadsPerObject || shape.lines.size() != 4 * (QuadsPerObject / 50)) {
+            continue;
+        }
+        for (int q = 0; q < QuadsPerObject; ++q) {
+            const int quad = o * QuadsPerObject + q;
+            const int fan[6] = {0, 1, 2, 0, 2, 3};
+            for (int i = 0; i < 6; ++i) {
+                const Corner expected{4 * quad + fan[i], 4 * quad + fan[i], quad};
+                mismatches += !(shape.triangles[6 * q + i] == expected);
+            }
+            if (q % 50 == 0) {
+                auto const* segments = &shape.lines[4 * (q / 50)];
+                const int first = 4 * quad;
+                mismatches += !(segments[0] == Corner{first, -1, -1}) + !(segments[1] == Corner{first + 1, -1, -1});
+                mismatches += !(segments[2] == Corner{first + 1, -1, -1}) + !(segments[3] == Corner{first + 2, -1, -1});
+            }
+        }
+    }
+    CHECK(mismatches == 0);
+    CHECK(model.positions[3 * (4 * 7 + 2)] == 8.0f && model.positions[3 * (4 * 7 + 2) + 1] == 1.0f &&
+          model.positions[3 * (4 * 7 + 2) + 2] == 7.0f);
+    CHECK(model.texcoords[2 * (4 * 7 + 3)] == 3.0f && model.texcoords[2 * (4 * 7 + 3) + 1] == 0.5f);
+    CHECK(model.normals[3 * 7 + 2] == 7.0f);
+}
+
+void checkWelding(Model const& model) {
+    // the two triangles of every quad share two corners
+    WeldedMesh mesh;
+    Weld(model, model.shapes[1].triangles, mesh);
+    CHECK(mesh.positions.size() == 3 * 4 * QuadsPerObject);
+    CHECK(mesh.texcoords.size() == 2 * 4 * QuadsPerObject);
+    CHECK(mesh.normals.size() == 3 * 4 * QuadsPerObject);
+    CHECK(mesh.indices.size() == 6 * QuadsPerObject);
+    bool ok = mesh.indices.size() == 6 * QuadsPerObject && mesh.positions.size() == 3 * 4 * QuadsPerObject;
+    for (uint32_t q = 0; ok && q < QuadsPerObject; ++q) {
+        const uint32_t fan[6] = {0, 1, 2, 0, 2, 3};
+        for (int i = 0; i < 6; ++i) {
+            ok &= mesh.indices[6 * q + i] == 4 * q + fan[i];
+        }
+        const uint32_t quad = QuadsPerObject + q;
+        ok &= mesh.positions[3 * 4 * q + 2] == static_cast<float>(quad);
+        ok &= mesh.normals[3 * 4 * q + 2] == static_cast<float>(quad);
+    }
+    CHECK(ok);
+
+    // corners sharing a position but not the normal stay apart, missing normals and texcoords are zero
+    const std::string obj = "v 0 0 0\nv 1 0 0\nv 0 1 0\nvn 0 0 1\nvn 0 0 -1\n"
+                            "f 1//1 2//1 3//1\nf 1//2 3//2 2//2\nf 1 2 3\n";
+    Model small;
+    std::string error;
+    CHECK(Parse(obj.data(), obj.size(), small, error));
+    CHECK(small.shapes.size() == 1);
+    if (small.shapes.size() != 1) {
+        return;
+    }
+    Weld(small, small.shapes[0].triangles, mesh);
+    CHECK(mesh.indices == (std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7, 8}));
+    CHECK(mesh.positions.size() == 3 * 9);
+    CHECK(mesh.normals.size() == 3 * 9 && mesh.normals[3 * 3 + 2] == -1.0f && mesh.normals[3 * 6 + 2] == 0.0f);
+    CHECK(mesh.texcoords.empty());
+
+    Weld(small, {small.shapes[0].triangles[0], small.shapes[0].triangles[3], small.shapes[0].triangles[0]}, mesh);
+    CHECK(mesh.indices == (std::vector<uint32_t>{0, 1, 0}));
+}
+
+void checkErrors() {
+    Model model;
+    std::string error;
+    for (std::string const obj : {"v 0 0 0\nf 1 1\n", "v 0 0 0\nf 1 2 1\n", "v 0 0 0\nf 1 1 -2\n", "v 0 0\n",
+             "v 0 0 0\nf 1 1 0\n", "v 0 0 0\nf 1/x 1 1\n"}) {
+        for (size_t numBlocks : {1, 3}) {
+            if (Parse(obj.data(), obj.size(), model, error, numBlocks) || error.empty()) {
+                std::fprintf(stderr, "accepted malformed \"%s\" in %zu blocks\n", obj.c_str(), numBlocks);
+                ++megamol::test::failures;
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    const auto fixture = makeFixture();
+
+    Model reference;
+    std::string error;
+    CHECK(Parse(fixture.data(), fixture.size(), reference, error, 1));
+    CHECK(error.empty());
+    checkFixture(reference);
+    checkWelding(reference);
+
+    // splitting the file anywhere must not change the result, also with more blocks than lines
+    for (size_t numBlocks : {size_t(2), size_t(3), size_t(7), size_t(64), size_t(1000), fixture.size()}) {
+        Model model;
+        const bool ok = Parse(fixture.data(), fixture.size(), model, error, numBlocks);
+        if (!ok || !sameModel(reference, model)) {
+            std::fprintf(stderr, "%zu blocks: %s\n", numBlocks, ok ? "result differs" : error.c_str());
+            ++megamol::test::failures;
+        }
+    }
+    Model model;
+    CHECK(Parse(fixture.data(), fixture.size(), model, error));
+    CHECK(sameModel(reference, model));
+
+    checkErrors();
+
+    return megamol::test::Result();
+}
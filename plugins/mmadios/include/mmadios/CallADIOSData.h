@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <map>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -27,9 +28,33 @@ struct adios2Params {
     bool isAttribute = false;
 };
 
+template<typename value_type>
+class containerInterface;
+
 class abstractContainer {
 public:
     virtual ~abstractContainer() = default;
+
+    /**
+     * Answers the loaded values without copying them.
+     *
+     * @return The values, or an empty span if the container holds another type.
+     */
+    template<typename T>
+    std::span<const T> GetSpan();
+
+    /**
+     * Answers the loaded values as T. They are only copied and converted, into 'storage', if the container holds
+     * another type.
+     *
+     * @param storage Receives the converted values if needed and has to outlive the returned span.
+     */
+    template<typename T>
+    std::span<const T> GetSpanAs(std::vector<T>& storage);
+
+    /** Answers the bytes of the loaded values without copying them, empty for strings. */
+    virtual std::span<const unsigned char> GetRawData() = 0;
+
     virtual std::vector<float> GetAsFloat() = 0;
     virtual std::vector<double> GetAsDouble() = 0;
     virtual std::vector<int32_t> GetAsInt32() = 0;
@@ -52,6 +77,10 @@ public:
     }
 
     std::vector<size_t> shape;
+
+    /** The offset of the loaded box in the global array, empty if the whole variable has been loaded. */
+    std::vector<size_t> start;
+
     bool singleValue = false;
 };
 
@@ -67,6 +96,14 @@ protected:
         return dataVec.size();
     }
 
+    std::span<const unsigned char> getRaw() {
+        if constexpr (std::is_same_v<std::string, value_type>) {
+            return {};
+        } else {
+            return {reinterpret_cast<const unsigned char*>(dataVec.data()), dataVec.size() * sizeof(value_type)};
+        }
+    }
+
     template<class R>
     std::vector<std::enable_if_t<std::is_same_v<value_type, R>, R>> getAs() {
         return dataVec;
@@ -127,6 +164,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -167,6 +207,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -207,6 +250,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -247,6 +293,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -287,6 +336,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -327,6 +379,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -367,6 +422,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -437,6 +495,9 @@ public:
     std::vector<std::string> GetAsString() override {
         return this->getAs<std::string>();
     }
+    std::span<const unsigned char> GetRawData() override {
+        return this->getRaw();
+    }
 
     size_t size() override {
         return getSize();
@@ -449,9 +510,47 @@ public:
     }
 };
 
+template<typename T>
+std::span<const T> abstractContainer::GetSpan() {
+    auto* c = dynamic_cast<containerInterface<T>*>(this);
+    if (c == nullptr) {
+        return {};
+    }
+    return c->getVec();
+}
+
+template<typename T>
+std::span<const T> abstractContainer::GetSpanAs(std::vector<T>& storage) {
+    if (auto* c = dynamic_cast<containerInterface<T>*>(this)) {
+        return c->getVec();
+    }
+    if constexpr (std::is_same_v<float, T>) {
+        storage = GetAsFloat();
+    } else if constexpr (std::is_same_v<double, T>) {
+        storage = GetAsDouble();
+    } else if constexpr (std::is_same_v<int32_t, T>) {
+        storage = GetAsInt32();
+    } else if constexpr (std::is_same_v<uint64_t, T>) {
+        storage = GetAsUInt64();
+    } else if constexpr (std::is_same_v<uint32_t, T>) {
+        storage = GetAsUInt32();
+    } else if constexpr (std::is_same_v<char, T>) {
+        storage = GetAsChar();
+    } else if constexpr (std::is_same_v<unsigned char, T>) {
+        storage = GetAsUChar();
+    } else {
+        static_assert(std::is_same_v<std::string, T>, "Unsupported type");
+        storage = GetAsString();
+    }
+    return storage;
+}
+
 
 typedef std::map<std::string, std::shared_ptr<abstractContainer>> adiosDataMap;
 
+/** A box in a global array, given as offset and count per dimension */
+typedef adios2::Box<adios2::Dims> adiosSelection;
+
 class CallADIOSData : public megamol::core::Call {
 public:
     /**
@@ -525,6 +624,17 @@ public:
     std::map<std::string, std::string> getVarProperties(std::string var) const;
     void setAvailableVars(const std::vector<std::string>& avars);
 
+    /**
+     * Restricts the next read of an inquired global array variable to a box, so that only the needed blocks are read.
+     * The loaded container answers the count of the box as shape and its offset as start.
+     *
+     * @param varname The name of the variable.
+     * @param box The offset and count per dimension.
+     */
+    void setSelection(const std::string& varname, const adiosSelection& box);
+    void clearSelection(const std::string& varname);
+    std::map<std::string, adiosSelection> getSelections() const;
+
     bool inquireAttr(const std::string& attrname);
     std::vector<std::string> getAttributesToInquire() const;
     std::vector<std::string> getAvailableAttributes() const;
@@ -574,6 +684,7 @@ private:
     std::vector<std::string> availableVars;
     std::map<std::string, std::map<std::string, std::string>> allVars;
     std::vector<std::string> inqAttributes;
+    std::map<std::string, adiosSelection> selections;
     std::vector<std::string> availableAttributes;
 
     std::shared_ptr<adiosDataMap> dataptr;
@@ -9,7 +9,9 @@
 #include "geometry_calls/MultiParticleDataCall.h"
 #include "mmadios/CallADIOSData.h"
 #include "mmcore/utility/log/Log.h"
+#include <cstring>
 #include <numeric>
+#include <span>
 
 
 namespace megamol::adios {
@@ -117,13 +119,14 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
                 return false;
             }
 
-            std::vector<unsigned char> X;
-            std::vector<unsigned char> Y;
-            std::vector<unsigned char> Z;
+            // the bytes of the loaded arrays are interleaved without copying or converting them first
+            std::span<const unsigned char> X;
+            std::span<const unsigned char> Y;
+            std::span<const unsigned char> Z;
 
             stride = 0;
             if (cad->isInVars("xyz")) {
-                X = cad->getData("xyz")->GetAsUChar();
+                X = cad->getData("xyz")->GetRawData();
                 stride += 3 * cad->getData("xyz")->getTypeSize();
                 if (cad->getData("xyz")->getTypeSize() == 4) {
                     vertType = geocalls::SimpleSphericalParticles::VERTDATA_FLOAT_XYZ;
@@ -131,9 +134,9 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
                     vertType = geocalls::SimpleSphericalParticles::VERTDATA_DOUBLE_XYZ;
                 }
             } else if (cad->isInVars("x") && cad->isInVars("y") && cad->isInVars("z")) {
-                X = cad->getData("x")->GetAsUChar();
-                Y = cad->getData("y")->GetAsUChar();
-                Z = cad->getData("z")->GetAsUChar();
+                X = cad->getData("x")->GetRawData();
+                Y = cad->getData("y")->GetRawData();
+                Z = cad->getData("z")->GetRawData();
                 stride += 3 * cad->getData("x")->getTypeSize();
                 if (cad->getData("x")->getTypeSize() == 4) {
                     vertType = geocalls::SimpleSphericalParticles::VERTDATA_FLOAT_XYZ;
@@ -148,13 +151,13 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
             std::vector<float> box = cad->getData("global_box")->GetAsFloat();
 
             auto p_count = cad->getData("count")->GetAsUInt64();
-            std::vector<unsigned char> radius;
-            std::vector<unsigned char> r;
-            std::vector<unsigned char> g;
-            std::vector<unsigned char> b;
-            std::vector<unsigned char> a;
-            std::vector<unsigned char> id;
-            std::vector<unsigned char> intensity;
+            std::span<const unsigned char> radius;
+            std::span<const unsigned char> r;
+            std::span<const unsigned char> g;
+            std::span<const unsigned char> b;
+            std::span<const unsigned char> a;
+            std::span<const unsigned char> id;
+            std::span<const unsigned char> intensity;
 
             // list_box
             if (cad->isInVars("list_box")) {
@@ -162,23 +165,18 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
             }
             // Radius
             if (cad->isInVars("radius")) {
-                radius = cad->getData("radius")->GetAsUChar();
-                stride += 3 * cad->getData("radius")->getTypeSize();
+                radius = cad->getData("radius")->GetRawData();
+                stride += cad->getData("radius")->getTypeSize();
             }
             // Colors
             if (cad->isInVars("r")) {
-                r = cad->getData("r")->GetAsUChar();
-                g = cad->getData("g")->GetAsUChar();
-                b = cad->getData("b")->GetAsUChar();
-                a = cad->getData("a")->GetAsUChar();
+                r = cad->getData("r")->GetRawData();
+                g = cad->getData("g")->GetRawData();
+                b = cad->getData("b")->GetRawData();
+                a = cad->getData("a")->GetRawData();
                 stride += 4 * cad->getData("r")->getTypeSize();
-            } else if (cad->isInVars("global_r")) {
-                r = cad->getData("global_r")->GetAsUChar();
-                g = cad->getData("global_g")->GetAsUChar();
-                b = cad->getData("global_b")->GetAsUChar();
-                a = cad->getData("global_a")->GetAsUChar();
             } else if (cad->isInVars("i")) {
-                intensity = cad->getData("i")->GetAsUChar();
+                intensity = cad->getData("i")->GetRawData();
                 stride += cad->getData("i")->getTypeSize();
                 // normalizing intentsity to [0,1]
                 // std::vector<float>::iterator minIt = std::min_element(std::begin(intensity), std::end(intensity));
@@ -191,7 +189,7 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
             }
             // ID
             if (cad->isInVars("id")) {
-                id = cad->getData("id")->GetAsUChar();
+                id = cad->getData("id")->GetRawData();
                 stride += cad->getData("id")->getTypeSize();
             }
 
@@ -239,19 +237,20 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
                 idType = geocalls::SimpleSphericalParticles::IDDATA_NONE;
 
                 if (cad->isInVars("global_radius")) {
-                    auto flt_radius = cad->getData("global_radius")->GetAsFloat();
-                    mpdc->AccessParticles(k).SetGlobalRadius(flt_radius[0]);
+                    std::vector<float> flt_radius;
+                    mpdc->AccessParticles(k).SetGlobalRadius(
+                        cad->getData("global_radius")->GetSpanAs(flt_radius)[0]);
                 } else if (cad->isInVars("radius")) {
                     vertType = geocalls::SimpleSphericalParticles::VERTDATA_FLOAT_XYZR;
                 } else {
                     mpdc->AccessParticles(k).SetGlobalRadius(1.0f);
                 }
                 if (cad->isInVars("global_r")) {
-                    auto flt_r = reinterpret_cast<std::vector<float>&>(r);
-                    auto flt_g = reinterpret_cast<std::vector<float>&>(g);
-                    auto flt_b = reinterpret_cast<std::vector<float>&>(b);
-                    auto flt_a = reinterpret_cast<std::vector<float>&>(a);
-                    mpdc->AccessParticles(k).SetGlobalColour(r[0] * 255, g[0] * 255, b[0] * 255, a[0] * 255);
+                    std::vector<float> flt_r, flt_g, flt_b, flt_a;
+                    mpdc->AccessParticles(k).SetGlobalColour(cad->getData("global_r")->GetSpanAs(flt_r)[0] * 255,
+                        cad->getData("global_g")->GetSpanAs(flt_g)[0] * 255,
+                        cad->getData("global_b")->GetSpanAs(flt_b)[0] * 255,
+                        cad->getData("global_a")->GetSpanAs(flt_a)[0] * 255);
                 } else if (cad->isInVars("r")) {
                     if (cad->getData("r")->getType() == "float") {
                         colType = geocalls::SimpleSphericalParticles::COLDATA_FLOAT_RGBA;
@@ -278,7 +277,7 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
                 // Fill mmpld byte array
                 mix[k].clear();
                 mix[k].shrink_to_fit();
-                mix[k].reserve(stride * p_count[k]);
+                mix[k].resize(stride * particleCount);
 
                 const bool have_interleaved_pos = cad->isInVars("xyz");
                 const bool have_radius = cad->isInVars("radius");
@@ -292,32 +291,35 @@ bool ADIOStoMultiParticle::getDataCallback(core::Call& call) {
                 const size_t intensity_size = have_intensity ? cad->getData("i")->getTypeSize() : 0;
                 const size_t id_size = have_ids ? cad->getData("id")->getTypeSize() : 0;
 
-                for (size_t i = plist_offset[k]; i < (plist_offset[k] + particleCount); i++) {
+                const auto first = static_cast<int64_t>(plist_offset[k]);
+#pragma omp parallel for
+                for (int64_t i = first; i < first + static_cast<int64_t>(particleCount); i++) {
+                    auto dst = mix[k].data() + (i - first) * stride;
+                    const auto append = [&dst, i](std::span<const unsigned char> src, size_t size) {
+                        std::memcpy(dst, src.data() + size * i, size);
+                        dst += size;
+                    };
 
                     if (have_interleaved_pos) {
-                        mix[k].insert(mix[k].end(), X.begin() + 3 * interleaved_pos_size * i,
-                            X.begin() + 3 * interleaved_pos_size * (i + 1));
+                        append(X, 3 * interleaved_pos_size);
                     } else {
-                        mix[k].insert(mix[k].end(), X.begin() + pos_size * i, X.begin() + pos_size * (i + 1));
-                        mix[k].insert(mix[k].end(), Y.begin() + pos_size * i, Y.begin() + pos_size * (i + 1));
-                        mix[k].insert(mix[k].end(), Z.begin() + pos_size * i, Z.begin() + pos_size * (i + 1));
+                        append(X, pos_size);
+                        append(Y, pos_size);
+                        append(Z, pos_size);
                     }
                     if (have_radius) {
-                        std::vector<unsigned char> tmp_radius = reinterpret_cast<std::vector<unsigned char>&>(radius);
-                        mix[k].insert(mix[k].end(), tmp_radius.begin() + radius_size * i,
-                            tmp_radius.begin() + radius_size * (i + 1));
+                        append(radius, radius_size);
                     }
                     if (have_colors) {
-                        mix[k].insert(mix[k].end(), r.begin() + col_size * i, r.begin() + col_size * (i + 1));
-                        mix[k].insert(mix[k].end(), g.begin() + col_size * i, g.begin() + col_size * (i + 1));
-                        mix[k].insert(mix[k].end(), b.begin() + col_size * i, b.begin() + col_size * (i + 1));
-                        mix[k].insert(mix[k].end(), a.begin() + col_size * i, a.begin() + col_size * (i + 1));
+                        append(r, col_size);
+                        append(g, col_size);
+                        append(b, col_size);
+                        append(a, col_size);
                     } else if (have_intensity) {
-                        mix[k].insert(mix[k].end(), intensity.begin() + intensity_size * i,
-                            intensity.begin() + intensity_size * (i + 1));
+                        append(intensity, intensity_size);
                     }
                     if (have_ids) {
-                        mix[k].insert(mix[k].end(), id.begin() + id_size * i, id.begin() + id_size * (i + 1));
+                        append(id, id_size);
                     }
                 }
             }
@@ -84,6 +84,18 @@ void CallADIOSData::setAvailableVars(const std::vector<std::string>& avars) {
     this->availableVars = avars;
 }
 
+void CallADIOSData::setSelection(const std::string& varname, const adiosSelection& box) {
+    this->selections[varname] = box;
+}
+
+void CallADIOSData::clearSelection(const std::string& varname) {
+    this->selections.erase(varname);
+}
+
+std::map<std::string, adiosSelection> CallADIOSData::getSelections() const {
+    return this->selections;
+}
+
 bool CallADIOSData::inquireAttr(const std::string& attrname) {
     if (!this->availableVars.empty()) {
         if (std::find(this->availableAttributes.begin(), this->availableAttributes.end(), attrname) !=
@@ -1,26 +1,52 @@
 #include "adiosDataSource.h"
 #include "cluster/mpi/MpiCall.h"
+#include "mmcore/param/EnumParam.h"
 #include "mmcore/param/FilePathParam.h"
+#include "mmcore/param/IntParam.h"
 #include "mmcore/utility/log/Log.h"
 #include "vislib/StringConverter.h"
 #include "vislib/Trace.h"
 #include "vislib/sys/CmdLineProvider.h"
 #include "vislib/sys/SystemInformation.h"
 #include <algorithm>
+#include <chrono>
 #include <numeric>
 
 
 namespace megamol::adios {
 
+namespace {
+
+/** Seconds a single attempt to open a stream waits for the writer, so that waiting can be stopped in between. */
+constexpr const char* OpenTimeoutSecs = "1";
+
+/** Without a reader thread, the render thread does not wait for the writer and tries to open at most this often. */
+constexpr std::chrono::milliseconds SyncOpenInterval{1000};
+
+} // namespace
+
 adiosDataSource::adiosDataSource()
         : callRequestMpi("requestMpi", "Requests initialization of MPI and the communicator for the view.")
         , getData("getdata", "Slot to request data from this data source.")
-        , filenameSlot("filename", "The path to the ADIOS-based file to load.") {
+        , filenameSlot("filename", "The path to the ADIOS-based file to load.")
+        , modeSlot("mode", "Read a file randomly, follow a BP5 file being written or attach to an SST stream.")
+        , ringSizeSlot("ringSize", "The number of recent steps of a stream kept in memory.") {
 
     this->filenameSlot.SetParameter(new core::param::FilePathParam("", core::param::FilePathParam::Flag_Any));
     this->filenameSlot.SetUpdateCallback(&adiosDataSource::filenameChanged);
     this->MakeSlotAvailable(&this->filenameSlot);
 
+    auto* modeEnum = new core::param::EnumParam(0);
+    modeEnum->SetTypePair(0, "File");
+    modeEnum->SetTypePair(1, "Follow BP5");
+    modeEnum->SetTypePair(2, "SST stream");
+    this->modeSlot.SetParameter(modeEnum);
+    this->modeSlot.SetUpdateCallback(&adiosDataSource::filenameChanged);
+    this->MakeSlotAvailable(&this->modeSlot);
+
+    this->ringSizeSlot.SetParameter(new core::param::IntParam(16, 1));
+    this->MakeSlotAvailable(&this->ringSizeSlot);
+
 
     this->getData.SetCallback("CallADIOSData", "GetData", &adiosDataSource::getDataCallback);
     this->getData.SetCallback("CallADIOSData", "GetHeader", &adiosDataSource::getHeaderCallback);
@@ -59,6 +85,7 @@ bool adiosDataSource::create() {
 
         megamol::core::utility::log::Log::DefaultLog.WriteInfo("[adiosDataSource] Declaring IO");
         this->io = std::make_shared<adios2::IO>(adiosInst->DeclareIO("Input"));
+        this->streamIo = std::make_shared<adios2::IO>(adiosInst->DeclareIO("Stream"));
 
     } catch (std::invalid_argument& e) {
 #ifdef MEGAMOL_USE_MPI
@@ -95,7 +122,8 @@ bool adiosDataSource::create() {
 /*
  * adiosDataSource::release
  */
-void adiosDataSource::release() { /* empty */
+void adiosDataSource::release() {
+    this->stopStream();
 }
 
 
@@ -107,6 +135,10 @@ bool adiosDataSource::getDataCallback(core::Call& caller) {
     if (cad == nullptr)
         return false;
 
+    if (this->modeSlot.Param<core::param::EnumParam>()->Value() != 0) {
+        return this->getStreamData(*cad);
+    }
+
     if (!this->dataMap.empty()) {
         auto inqV = cad->getVarsToInquire();
         for (auto var : inqV) {
@@ -121,6 +153,8 @@ bool adiosDataSource::getDataCallback(core::Call& caller) {
             this->inquireChanged = true;
         }
     }
+    const auto selections = cad->getSelections();
+    this->inquireChanged = this->inquireChanged || selections != this->loadedSelections;
 
     if (dataHashChanged || inquireChanged || loadedFrameID != cad->getFrameIDtoLoad()) {
 
@@ -163,39 +197,11 @@ bool adiosDataSource::getDataCallback(core::Call& caller) {
             content.insert(content.end(), attributes.begin(), attributes.end());
 
             for (auto toInq : toInquire) {
+                const auto sel = selections.find(toInq);
+                const adiosSelection* selection = sel != selections.end() ? &sel->second : nullptr;
                 for (auto var : content) {
                     if (var.name == toInq) {
-                        std::vector<size_t> shape(1);
-                        bool singleValue = true;
-                        if (var.params["SingleValue"] != std::string("true")) {
-                            // num = std::stoi(var.second["Shape"]);
-                            singleValue = false;
-                        }
-                        if (var.params["Type"] == "float") {
-                            auto fc = std::make_shared<FloatContainer>(FloatContainer());
-                            inquireRead<float>(fc, var, frameIDtoLoad, singleValue);
-                        } else if (var.params["Type"] == "double") {
-                            auto fc = std::make_shared<DoubleContainer>(DoubleContainer());
-                            inquireRead<double>(fc, var, frameIDtoLoad, singleValue);
-                        } else if (var.params["Type"] == "int32_t") {
-                            auto fc = std::make_shared<Int32Container>(Int32Container());
-                            inquireRead<int32_t>(fc, var, frameIDtoLoad, singleValue);
-                        } else if (var.params["Type"] == "int8_t" || var.params["Type"] == "char") {
-                            auto fc = std::make_shared<CharContainer>(CharContainer());
-                            inquireRead<char>(fc, var, frameIDtoLoad, singleValue);
-                        } else if (var.params["Type"] == "uint64_t") {
-                            auto fc = std::make_shared<UInt64Container>(UInt64Container());
-                            inquireRead<uint64_t>(fc, var, frameIDtoLoad, singleValue);
-                        } else if ((var.params["Type"] == "unsigned char") || (var.params["Type"] == "uint8_t")) {
-                            auto fc = std::make_shared<UCharContainer>(UCharContainer());
-                            inquireRead<unsigned char>(fc, var, frameIDtoLoad, singleValue);
-                        } else if (var.params["Type"] == "uint32_t") {
-                            auto fc = std::make_shared<UInt32Container>(UInt32Container());
-                            inquireRead<uint32_t>(fc, var, frameIDtoLoad, singleValue);
-                        } else if (var.params["Type"] == "string") {
-                            auto fc = std::make_shared<StringContainer>(StringContainer());
-                            inquireRead<std::string>(fc, var, frameIDtoLoad, singleValue);
-                        }
+                        readVariable(*io, *reader, var, frameIDtoLoad, selection, dataMap);
                     }
                 }
             }
@@ -208,6 +214,7 @@ bool adiosDataSource::getDataCallback(core::Call& caller) {
                 "[adiosDataSource] Time spent for reading frame: %d ms", duration);
 
             loadedFrameID = frameIDtoLoad;
+            loadedSelections = selections;
             cad->setLoadedFrameID(loadedFrameID);
             // here data is loaded
         } catch (std::invalid_argument& e) {
@@ -264,6 +271,13 @@ bool adiosDataSource::getHeaderCallback(core::Call& caller) {
     if (cad == nullptr)
         return false;
 
+    if (this->modeSlot.Param<core::param::EnumParam>()->Value() != 0) {
+        return this->getStreamHeader(*cad);
+    }
+    if (this->streamReader) {
+        this->stopStream();
+    }
+
     if (dataHashChanged || loadedFrameID != cad->getFrameIDtoLoad() || this->filenameSlot.IsDirty()) {
         this->filenameSlot.ResetDirty();
         if (loadedFrameID != cad->getFrameIDtoLoad())
@@ -396,6 +410,294 @@ bool adiosDataSource::getHeaderCallback(core::Call& caller) {
     return true;
 }
 
+/*
+ * adiosDataSource::readVariable
+ */
+void adiosDataSource::readVariable(adios2::IO& inIo, adios2::Engine& engine, adios2Params var,
+    const std::optional<size_t> frameIDtoLoad, const adiosSelection* selection, adiosDataMap& target) {
+    bool singleValue = true;
+    if (var.params["SingleValue"] != std::string("true")) {
+        singleValue = false;
+    }
+    if (var.params["Type"] == "float") {
+        auto fc = std::make_shared<FloatContainer>(FloatContainer());
+        inquireRead<float>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if (var.params["Type"] == "double") {
+        auto fc = std::make_shared<DoubleContainer>(DoubleContainer());
+        inquireRead<double>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if (var.params["Type"] == "int32_t") {
+        auto fc = std::make_shared<Int32Container>(Int32Container());
+        inquireRead<int32_t>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if (var.params["Type"] == "int8_t" || var.params["Type"] == "char") {
+        auto fc = std::make_shared<CharContainer>(CharContainer());
+        inquireRead<char>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if (var.params["Type"] == "uint64_t") {
+        auto fc = std::make_shared<UInt64Container>(UInt64Container());
+        inquireRead<uint64_t>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if ((var.params["Type"] == "unsigned char") || (var.params["Type"] == "uint8_t")) {
+        auto fc = std::make_shared<UCharContainer>(UCharContainer());
+        inquireRead<unsigned char>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if (var.params["Type"] == "uint32_t") {
+        auto fc = std::make_shared<UInt32Container>(UInt32Container());
+        inquireRead<uint32_t>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    } else if (var.params["Type"] == "string") {
+        auto fc = std::make_shared<StringContainer>(StringContainer());
+        inquireRead<std::string>(inIo, engine, fc, var, frameIDtoLoad, singleValue, selection, target);
+    }
+}
+
+
+/*
+ * adiosDataSource::getStreamHeader
+ */
+bool adiosDataSource::getStreamHeader(CallADIOSData& cad) {
+    this->ringSize = this->ringSizeSlot.Param<core::param::IntParam>()->Value();
+
+    if (dataHashChanged || this->filenameSlot.IsDirty() || this->modeSlot.IsDirty() || !this->streamReader) {
+        this->filenameSlot.ResetDirty();
+        this->modeSlot.ResetDirty();
+        auto fname = this->filenameSlot.Param<core::param::FilePathParam>()->Value().generic_string();
+#ifdef _WIN32
+        std::replace(fname.begin(), fname.end(), '/', '\\');
+#endif
+        this->stopStream();
+        try {
+            this->startStream(fname);
+        } catch (std::exception& e) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "[adiosDataSource] Could not open stream '%s': %s", fname.c_str(), e.what());
+            this->stopStream();
+            return false;
+        }
+        this->data_hash++;
+        dataHashChanged = false;
+    }
+
+    // without a reader thread, the steps that arrived meanwhile are read now
+    if (!this->streamThread.joinable() && !this->streamEnded && (*this->streamReader || this->tryOpenStream())) {
+        try {
+            StreamStatus status;
+            do {
+                status = this->readStreamStep(0.0f);
+            } while (status == StreamStatus::Read);
+            this->streamEnded = status == StreamStatus::End;
+        } catch (std::exception& e) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "[adiosDataSource] Reading the stream failed: %s", e.what());
+            this->streamEnded = true;
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(this->ringMutex);
+        if (!this->ring.empty()) {
+            const auto& newest = this->ring.back();
+            cad.setAvailableVars(newest.vars);
+            cad.setAllVars(newest.allVars);
+            cad.setAvailableAttributes(newest.attribs);
+        }
+    }
+    cad.setFrameCount(std::max<size_t>(1, this->stepsRead));
+    cad.setDataHash(this->data_hash);
+
+    return true;
+}
+
+
+/*
+ * adiosDataSource::getStreamData
+ */
+bool adiosDataSource::getStreamData(CallADIOSData& cad) {
+    std::lock_guard<std::mutex> lock(this->ringMutex);
+    if (this->ring.empty()) {
+        if (!this->warnedEmptyRing) {
+            megamol::core::utility::log::Log::DefaultLog.WriteWarn("[adiosDataSource] No step received yet.");
+            this->warnedEmptyRing = true;
+        }
+        return false;
+    }
+
+    // steps that already left the ring are answered with the closest one kept
+    const auto requested = cad.getFrameIDtoLoad();
+    auto it = std::find_if(
+        this->ring.begin(), this->ring.end(), [requested](const streamStep& s) { return s.step >= requested; });
+    if (it == this->ring.end()) {
+        it = std::prev(this->ring.end());
+    }
+    if (it->step != requested) {
+        megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+            "[adiosDataSource] Step %zu is not in memory, returning step %zu instead", requested, it->step);
+    }
+
+    for (const auto& var : cad.getVarsToInquire()) {
+        if (it->data->find(var) == it->data->end()) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "[adiosDataSource] Variable %s is not in step %zu", var.c_str(), it->step);
+            return false;
+        }
+    }
+
+    cad.setData(it->data);
+    cad.setLoadedFrameID(it->step);
+    cad.setDataHash(this->data_hash);
+    return true;
+}
+
+
+/*
+ * adiosDataSource::readStreamStep
+ */
+adiosDataSource::StreamStatus adiosDataSource::readStreamStep(float timeout) {
+    const auto status = this->streamReader->BeginStep(adios2::StepMode::Read, timeout);
+    if (status == adios2::StepStatus::NotReady) {
+        return StreamStatus::NotReady;
+    }
+    if (status != adios2::StepStatus::OK) {
+        megamol::core::utility::log::Log::DefaultLog.WriteInfo("[adiosDataSource] End of stream after %zu steps",
+            static_cast<size_t>(this->stepsRead));
+        return StreamStatus::End;
+    }
+
+    streamStep current;
+    current.step = this->streamReader->CurrentStep();
+    current.data = std::make_shared<adiosDataMap>();
+    current.allVars = this->streamIo->AvailableVariables();
+    for (const auto& var : current.allVars) {
+        adios2Params p;
+        p.name = var.first;
+        p.params = var.second;
+        current.vars.emplace_back(var.first);
+        this->readVariable(*this->streamIo, *this->streamReader, p, std::nullopt, nullptr, *current.data);
+    }
+    for (const auto& attr : this->streamIo->AvailableAttributes()) {
+        adios2Params p;
+        p.name = attr.first;
+        p.params = attr.second;
+        p.isAttribute = true;
+        current.attribs.emplace_back(attr.first);
+        this->readVariable(*this->streamIo, *this->streamReader, p, std::nullopt, nullptr, *current.data);
+    }
+    this->streamReader->EndStep();
+
+    std::lock_guard<std::mutex> lock(this->ringMutex);
+    this->stepsRead = current.step + 1;
+    this->ring.emplace_back(std::move(current));
+    while (this->ring.size() > this->ringSize) {
+        this->ring.pop_front();
+    }
+    this->warnedEmptyRing = false;
+    ++this->data_hash;
+    return StreamStatus::Read;
+}
+
+
+/*
+ * adiosDataSource::openStream
+ */
+bool adiosDataSource::openStream(const char* timeoutSecs) {
+    try {
+        // wait for the writer to create the file or the contact information instead of failing
+        this->streamIo->SetParameter("OpenTimeoutSecs", timeoutSecs);
+        *this->streamReader = this->streamIo->Open(this->streamName, adios2::Mode::Read);
+    } catch (std::exception& e) {
+        if (!this->warnedOpen) {
+            megamol::core::utility::log::Log::DefaultLog.WriteWarn(
+                "[adiosDataSource] Waiting for the writer of '%s': %s", this->streamName.c_str(), e.what());
+            this->warnedOpen = true;
+        }
+        return false;
+    }
+    return true;
+}
+
+
+/*
+ * adiosDataSource::tryOpenStream
+ */
+bool adiosDataSource::tryOpenStream() {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - this->lastOpenAttempt < SyncOpenInterval) {
+        return false;
+    }
+    this->lastOpenAttempt = now;
+    return this->openStream("0");
+}
+
+
+/*
+ * adiosDataSource::startStream
+ */
+void adiosDataSource::startStream(const std::string& fname) {
+    const bool sst = this->modeSlot.Param<core::param::EnumParam>()->Value() == 2;
+    this->streamIo->SetEngine(sst ? "SST" : "BP5");
+    this->streamName = fname;
+    this->warnedOpen = false;
+    this->warnedEmptyRing = false;
+    this->stopStreaming = false;
+    this->streamEnded = false;
+    this->stepsRead = 0;
+
+    // MPI collectives in the reader thread need MPI_THREAD_MULTIPLE, otherwise steps are read in the callbacks
+    bool background = true;
+#ifdef MEGAMOL_USE_MPI
+    if (this->MpiInitialized) {
+        int provided = MPI_THREAD_SINGLE;
+        MPI_Query_thread(&provided);
+        background = provided == MPI_THREAD_MULTIPLE;
+    }
+#endif
+    megamol::core::utility::log::Log::DefaultLog.WriteInfo("[adiosDataSource] Attaching to %s '%s'%s",
+        sst ? "SST stream" : "BP5 file", fname.c_str(), background ? "" : ", reading steps synchronously");
+
+    // until the writer shows up, opening is attempted again in the thread or with the next header request
+    this->streamReader = std::make_shared<adios2::Engine>();
+    if (!background) {
+        this->lastOpenAttempt = {};
+        this->tryOpenStream();
+        return;
+    }
+
+    this->streamThread = std::thread([this]() {
+        try {
+            while (!this->stopStreaming && !this->openStream(OpenTimeoutSecs)) {
+                // errors other than the timeout return right away
+                std::this_thread::sleep_for(std::chrono::milliseconds(250));
+            }
+            while (!this->stopStreaming) {
+                if (this->readStreamStep(0.25f) == StreamStatus::End) {
+                    break;
+                }
+            }
+        } catch (std::exception& e) {
+            megamol::core::utility::log::Log::DefaultLog.WriteError(
+                "[adiosDataSource] Reading the stream failed: %s", e.what());
+        }
+        this->streamEnded = true;
+    });
+}
+
+
+/*
+ * adiosDataSource::stopStream
+ */
+void adiosDataSource::stopStream() {
+    this->stopStreaming = true;
+    if (this->streamThread.joinable()) {
+        this->streamThread.join();
+    }
+    if (this->streamReader) {
+        if (*this->streamReader) {
+            this->streamReader->Close();
+        }
+        this->streamReader.reset();
+        this->streamIo->RemoveAllVariables();
+        this->streamIo->RemoveAllAttributes();
+    }
+    std::lock_guard<std::mutex> lock(this->ringMutex);
+    this->ring.clear();
+}
+
+
 bool adiosDataSource::initMPI() {
 #ifdef MEGAMOL_USE_MPI
     if (this->mpi_comm_ == MPI_COMM_NULL) {
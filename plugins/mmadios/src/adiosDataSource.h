@@ -9,12 +9,23 @@
 #include "vislib/String.h"
 #include "vislib/math/Cuboid.h"
 #include <adios2.h>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <thread>
 #ifdef MEGAMOL_USE_MPI
 #include <mpi.h>
 #endif
 
 namespace megamol::adios {
 
+/**
+ * Data source for ADIOS2 files. Besides random access to bp files, it can follow a BP5 file while it is still being
+ * written or attach to an SST stream. Steps are then read as they arrive, in a background thread if possible, and the
+ * most recent ones are kept in a ring for scrubbing. Frame IDs are the step indices of the stream.
+ */
 class adiosDataSource : public core::Module {
 public:
     /**
@@ -87,8 +98,63 @@ private:
     vislib::StringA getCommandLine();
     bool filenameChanged(core::param::ParamSlot& slot);
 
+    /**
+     * Schedules reading a variable or attribute into its container, the values arrive with PerformGets.
+     *
+     * @param selection The box to read of a global array variable, or nullptr for the whole variable.
+     */
     template<typename T, typename C>
-    void inquireRead(C container, const adios2Params var, const size_t frameIDtoLoad, const bool singleValue);
+    void inquireRead(adios2::IO& inIo, adios2::Engine& engine, C container, const adios2Params var,
+        const std::optional<size_t> frameIDtoLoad, const bool singleValue, const adiosSelection* selection,
+        adiosDataMap& target);
+
+    /**
+     * Schedules reading a variable or attribute of any supported type.
+     *
+     * @param frameIDtoLoad The step to read, or none for the current step of a stream.
+     */
+    void readVariable(adios2::IO& inIo, adios2::Engine& engine, adios2Params var,
+        const std::optional<size_t> frameIDtoLoad, const adiosSelection* selection, adiosDataMap& target);
+
+    bool getStreamHeader(CallADIOSData& cad);
+    bool getStreamData(CallADIOSData& cad);
+
+    enum class StreamStatus { Read, NotReady, End };
+
+    /**
+     * Reads the next step of the stream, if any, into the ring.
+     *
+     * @param timeout Seconds to wait for the next step.
+     */
+    StreamStatus readStreamStep(float timeout);
+
+    /**
+     * Tries to open the stream, waiting for the writer for a short time only.
+     *
+     * @param timeoutSecs The seconds to wait for the writer, as ADIOS2 parameter value.
+     *
+     * @return false if the writer did not show up yet.
+     */
+    bool openStream(const char* timeoutSecs);
+
+    /**
+     * Tries to open the stream from the render thread without waiting for the writer, and only if the last attempt is
+     * some time ago.
+     *
+     * @return false if the stream is not open.
+     */
+    bool tryOpenStream();
+    void startStream(const std::string& fname);
+    void stopStream();
+
+    /** A step of the stream with all its variables and attributes */
+    struct streamStep {
+        size_t step = 0;
+        std::shared_ptr<adiosDataMap> data;
+        std::vector<std::string> vars;
+        std::vector<std::string> attribs;
+        std::map<std::string, std::map<std::string, std::string>> allVars;
+    };
 
     /** The slot for requesting data */
     core::CalleeSlot getData;
@@ -97,13 +163,19 @@ private:
     //std::vector<UINT64> frameIdx;
 
     /** Data file load id counter */
-    size_t data_hash = 0;
+    std::atomic<size_t> data_hash = 0;
     bool dataHashChanged = false;
     bool inquireChanged = false;
 
     /** The file name */
     core::param::ParamSlot filenameSlot;
 
+    /** Random access, following a BP5 file or attaching to an SST stream */
+    core::param::ParamSlot modeSlot;
+
+    /** The number of recent steps kept for streams */
+    core::param::ParamSlot ringSizeSlot;
+
     size_t frameCount = 0;
     long long int loadedFrameID = -1;
 
@@ -115,37 +187,74 @@ private:
     std::map<std::string, std::map<std::string, std::string>> allVariables;
     std::vector<adios2Params> attributes;
     adiosDataMap dataMap;
+    std::map<std::string, adiosSelection> loadedSelections;
 
     std::vector<std::size_t> timesteps;
     std::vector<std::string> availVars;
     std::vector<std::string> availAttribs;
+
+    // Streaming
+    std::shared_ptr<adios2::IO> streamIo;
+    std::shared_ptr<adios2::Engine> streamReader;
+    std::string streamName;
+    bool warnedOpen = false;
+    std::chrono::steady_clock::time_point lastOpenAttempt;
+    bool warnedEmptyRing = false;
+    std::deque<streamStep> ring;
+    std::mutex ringMutex;
+    std::atomic<size_t> ringSize = 16;
+    std::atomic<size_t> stepsRead = 0;
+    std::thread streamThread;
+    std::atomic<bool> stopStreaming = false;
+    std::atomic<bool> streamEnded = false;
 };
 
 template<typename T, typename C>
-void adiosDataSource::inquireRead(
-    C container, const adios2Params var, const size_t frameIDtoLoad, const bool singleValue) {
+void adiosDataSource::inquireRead(adios2::IO& inIo, adios2::Engine& engine, C container, const adios2Params var,
+    const std::optional<size_t> frameIDtoLoad, const bool singleValue, const adiosSelection* selection,
+    adiosDataMap& target) {
     container->singleValue = singleValue;
     std::vector<T>& tmp_vec = container->getVec();
     size_t num = 1;
 
     if (var.isAttribute) {
-        auto advar = io->InquireAttribute<T>(var.name);
+        auto advar = inIo.InquireAttribute<T>(var.name);
         tmp_vec = advar.Data();
     } else {
-        auto advar = io->InquireVariable<T>(var.name);
-        advar.SetStepSelection({frameIDtoLoad, 1});
-        container->shape = advar.Shape(frameIDtoLoad);
+        auto advar = inIo.InquireVariable<T>(var.name);
+        if (frameIDtoLoad.has_value()) {
+            // steps of streams are selected by BeginStep
+            advar.SetStepSelection({*frameIDtoLoad, 1});
+            container->shape = advar.Shape(*frameIDtoLoad);
+        } else {
+            container->shape = advar.Shape();
+        }
         if (container->shape.empty()) {
             container->shape = {advar.Count()};
         }
+        if (!singleValue && selection != nullptr) {
+            bool valid = selection->first.size() == container->shape.size() &&
+                         selection->second.size() == container->shape.size();
+            for (size_t d = 0; valid && d < container->shape.size(); ++d) {
+                valid = selection->first[d] + selection->second[d] <= container->shape[d];
+            }
+            if (valid) {
+                container->start = selection->first;
+                container->shape = selection->second;
+            } else {
+                megamol::core::utility::log::Log::DefaultLog.WriteError(
+                    "[adiosDataSource] Selection of %s exceeds its shape, reading the whole variable",
+                    var.name.c_str());
+            }
+        }
         if (!singleValue) {
-            advar.SetSelection({advar.Start(), container->shape});
+            advar.SetSelection({container->start.empty() ? advar.Start() : container->start, container->shape});
         }
         std::for_each(container->shape.begin(), container->shape.end(), [&](decltype(num) n) { num *= n; });
         tmp_vec.resize(num);
 
-        reader->Get<T>(advar, tmp_vec);
+        engine.Get<T>(advar, tmp_vec);
     }
-    dataMap[var.name] = std::move(container);
+    target[var.name] = std::move(container);
 }
 } // namespace megamol::adios
@@ -0,0 +1,238 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "mmcore/Module.h"
+#include "mmcore/param/ParamSlot.h"
+#include "mmstd/data/AbstractGetDataCall.h"
+
+namespace megamol::core {
+
+/**
+ * Fingerprint of everything the output of a data module depends on: the hashes of its inputs, the requested frame
+ * and the values of its parameters.
+ */
+class DataFingerprint {
+public:
+    /**
+     * Adds the data hash of an input call. An input reporting hash 0 has no stable state and makes the fingerprint
+     * uncacheable.
+     *
+     * @param call The input call after its data has been requested
+     *
+     * @return *this
+     */
+    DataFingerprint& AddInput(AbstractGetDataCall const& call);
+
+    /**
+     * Adds the requested frame.
+     *
+     * @param frameID The frame ID
+     *
+     * @return *this
+     */
+    DataFingerprint& AddFrame(unsigned int frameID);
+
+    /**
+     * Adds the names and values of all parameters of a module.
+     *
+     * @param module The module
+     * @param ignore Parameters not affecting the output, e.g. buttons or display options
+     *
+     * @return *this
+     */
+    DataFingerprint& AddParams(Module& module, std::vector<param::ParamSlot const*> const& ignore = {});
+
+    /**
+     * Adds an arbitrary value of the module state.
+     *
+     * @param value The value
+     *
+     * @return *this
+     */
+    DataFingerprint& Add(uint64_t value);
+
+    /** Answer whether outputs for this fingerprint can be reused */
+    inline bool IsCacheable() const {
+        return this->cacheable;
+    }
+
+    /** Answer the combined hash */
+    inline uint64_t Value() const {
+        return this->hash;
+    }
+
+private:
+    uint64_t hash = 0xcbf29ce484222325ull;
+    bool cacheable = true;
+};
+
+
+/**
+ * Keeps the last outputs of a data module together with the fingerprints they have been computed for. Outputs are
+ * evicted least recently used first once there are more than the given number of entries or they exceed the memory
+ * budget, the most recent output is always kept.
+ *
+ * Every output gets a unique ID, which is a suitable data hash for the outgoing call: returning to a cached output
+ * also returns to its hash.
+ *
+ * @tparam T The type of the output
+ */
+template<class T>
+class OutputMemoizer {
+public:
+    /** Functor answering the memory footprint of an output in bytes */
+    using SizeFunc = std::function<size_t(T const&)>;
+
+    /** A cached output, value is nullptr if there is none */
+    struct Entry {
+        std::shared_ptr<T const> value;
+        size_t id = 0;
+    };
+
+    /**
+     * Ctor
+     *
+     * @param capacity The maximum number of outputs kept
+     * @param budget The maximum number of bytes of all outputs kept
+     * @param sizeOf Answers the bytes of an output, sizeof(T) if not given
+     */
+    explicit OutputMemoizer(size_t capacity = 4, size_t budget = 512ull * 1024ull * 1024ull, SizeFunc sizeOf = nullptr)
+            : capacity(capacity)
+            , budget(budget)
+            , sizeOf(sizeOf ? std::move(sizeOf) : [](T const&) { return sizeof(T); }) {}
+
+    /**
+     * Looks up the output for a fingerprint and marks it as most recently used.
+     *
+     * @param fp The fingerprint
+     *
+     * @return The entry, or an empty entry on a miss
+     */
+    Entry Find(DataFingerprint const& fp) {
+        if (!fp.IsCacheable()) {
+            return Entry();
+        }
+        for (auto it = this->items.begin(); it != this->items.end(); ++it) {
+            if (it->cacheable && it->key == fp.Value()) {
+                this->items.splice(this->items.begin(), this->items, it);
+                return Entry{this->items.front().value, this->items.front().id};
+            }
+        }
+        return Entry();
+    }
+
+    /**
+     * Stores the output computed for a fingerprint.
+     *
+     * @param fp The fingerprint
+     * @param value The output
+     *
+     * @return The entry of the output
+     */
+    Entry Insert(DataFingerprint const& fp, T value) {
+        Item item;
+        item.key = fp.Value();
+        item.cacheable = fp.IsCacheable();
+        item.bytes = this->sizeOf(value);
+        item.value = std::make_shared<T const>(std::move(value));
+        item.id = this->nextID++;
+        if (this->nextID == 0) {
+            this->nextID = 1;
+        }
+
+        // an output for an uncacheable fingerprint can never be hit again
+        this->items.remove_if(
+            [&fp](Item const& i) { return !i.cacheable || (fp.IsCacheable() && i.key == fp.Value()); });
+        this->items.push_front(std::move(item));
+        this->evict();
+
+        return Entry{this->items.front().value, this->items.front().id};
+    }
+
+    /**
+     * Answers the cached output for a fingerprint or computes and stores it.
+     *
+     * @param fp The fingerprint
+     * @param compute Callable taking a T& to fill, returning false on failure
+     *
+     * @return The entry, empty if compute failed
+     */
+    template<class F>
+    Entry GetOrCompute(DataFingerprint const& fp, F&& compute) {
+        auto entry = this->Find(fp);
+        if (entry.value) {
+            return entry;
+        }
+        T value{};
+        if (!compute(value)) {
+            return Entry();
+        }
+        return this->Insert(fp, std::move(value));
+    }
+
+    /** Drops all outputs */
+    void Clear() {
+        this->items.clear();
+    }
+
+    /** Answer the number of outputs kept */
+    size_t Size() const {
+        return this->items.size();
+    }
+
+    /** Answer the bytes of all outputs kept */
+    size_t MemoryUsage() const {
+        size_t bytes = 0;
+        for (auto const& i : this->items) {
+            bytes += i.bytes;
+        }
+        return bytes;
+    }
+
+    void SetCapacity(size_t capacity) {
+        this->capacity = capacity;
+        this->evict();
+    }
+
+    void SetBudget(size_t budget) {
+        this->budget = budget;
+        this->evict();
+    }
+
+private:
+    struct Item {
+        uint64_t key = 0;
+        bool cacheable = false;
+        size_t bytes = 0;
+        size_t id = 0;
+        std::shared_ptr<T const> value;
+    };
+
+    void evict() {
+        auto bytes = this->MemoryUsage();
+        while (this->items.size() > 1 && (this->items.size() > this->capacity || bytes > this->budget)) {
+            bytes -= this->items.back().bytes;
+            this->items.pop_back();
+        }
+    }
+
+    size_t capacity;
+    size_t budget;
+    SizeFunc sizeOf;
+    std::list<Item> items;
+    size_t nextID = 1;
+};
+
+} // namespace megamol::core
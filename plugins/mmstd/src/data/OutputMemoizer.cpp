@@ -0,0 +1,59 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include "mmstd/data/OutputMemoizer.h"
+
+#include <algorithm>
+
+using namespace megamol::core;
+
+
+/*
+ * DataFingerprint::AddInput
+ */
+DataFingerprint& DataFingerprint::AddInput(AbstractGetDataCall const& call) {
+    if (call.DataHash() == 0) {
+        this->cacheable = false;
+    }
+    return this->Add(call.DataHash());
+}
+
+
+/*
+ * DataFingerprint::AddFrame
+ */
+DataFingerprint& DataFingerprint::AddFrame(unsigned int frameID) {
+    return this->Add(frameID);
+}
+
+
+/*
+ * DataFingerprint::AddParams
+ */
+DataFingerprint& DataFingerprint::AddParams(Module& module, std::vector<param::ParamSlot const*> const& ignore) {
+    std::hash<std::string> strHash;
+    for (auto* slot : module.GetSlots<param::ParamSlot>()) {
+        if (std::find(ignore.begin(), ignore.end(), slot) != ignore.end()) {
+            continue;
+        }
+        auto const& p = slot->Parameter();
+        if (p == nullptr) {
+            continue;
+        }
+        this->Add(strHash(std::string(slot->Name().PeekBuffer())));
+        this->Add(strHash(p->ValueString()));
+    }
+    return *this;
+}
+
+
+/*
+ * DataFingerprint::Add
+ */
+DataFingerprint& DataFingerprint::Add(uint64_t value) {
+    this->hash ^= value + 0x9e3779b97f4a7c15ull + (this->hash << 6) + (this->hash >> 2);
+    return *this;
+}
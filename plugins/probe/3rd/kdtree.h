@@ -630,9 +630,6 @@ int pcl::KdTreeFLANN<PointT>::nearestKSearch(
     k_indices.resize(k);
     k_distances.resize(k);
 
-    std::vector<float> query(dim_);
-    point_representation_->vectorize(static_cast<PointT>(point), query);
-
     //::flann::Matrix<int> k_indices_mat(&k_indices[0], 1, k);
     //::flann::Matrix<float> k_distances_mat(&k_distances[0], 1, k);
     // Wrap the k_indices and k_distances vectors (no data copy)
@@ -666,22 +663,17 @@ int pcl::KdTreeFLANN<PointT>::radiusSearch(const PointT& point, double radius, s
     std::vector<float>& k_sqr_dists, unsigned int max_nn) const {
     assert(point_representation_->isValid(point) && "Invalid (NaN, Inf) point coordinates given to radiusSearch!");
 
-    std::vector<float> query(dim_);
-    point_representation_->vectorize(static_cast<PointT>(point), query);
-
     // Has max_nn been set properly?
     if (max_nn == 0 || max_nn > static_cast<unsigned int>(total_nr_points_)) max_nn = total_nr_points_;
 
-    std::vector<std::vector<int>> indices(1);
-    std::vector<std::vector<float>> dists(1);
-
     //const PC2KD pc2kd(cloud_);
     //auto flann_idx = FLANNIndex(3 /*dim*/, pc2kd, ::nanoflann::KDTreeSingleIndexAdaptorParams(10 /* max leaf */));
     //*flann_index_ = flann_idx;
     //flann_index_ = new FLANNIndex(3 /*dim*/, pc2kd, ::nanoflann::KDTreeSingleIndexAdaptorParams(10 /* max leaf */));
     //flann_index_->buildIndex();
 
-    std::vector<std::pair<size_t, double>> ret_matches;
+    // reused across queries of the calling thread, saves one allocation per search
+    thread_local std::vector<std::pair<size_t, double>> ret_matches;
 
     ::nanoflann::SearchParams params;
     //if (max_nn == static_cast<unsigned int>(total_nr_points_))
@@ -696,13 +688,11 @@ int pcl::KdTreeFLANN<PointT>::radiusSearch(const PointT& point, double radius, s
     int neighbors_in_radius = flann_index_->radiusSearch(point.data, radius, ret_matches, params);
 
     // XXX
-    k_indices.clear();
-    k_sqr_dists.clear();
-    k_indices.reserve(ret_matches.size());
-    k_sqr_dists.reserve(ret_matches.size());
-    for (auto& element : ret_matches) {
-        k_indices.push_back(element.first);
-        k_sqr_dists.push_back(element.second);
+    k_indices.resize(ret_matches.size());
+    k_sqr_dists.resize(ret_matches.size());
+    for (size_t i = 0; i < ret_matches.size(); ++i) {
+        k_indices[i] = ret_matches[i].first;
+        k_sqr_dists[i] = ret_matches[i].second;
     }
     
     // Do mapping to original point cloud
@@ -8,10 +8,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
 #include <random>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <variant>
+#include <vector>
+
+#include "ProbeSampleStore.h"
 
 namespace megamol {
 namespace probe {
@@ -47,7 +57,7 @@ struct BaseProbe {
 struct FloatProbe : public BaseProbe {
 public:
     struct SamplingResult {
-        std::vector<float> samples;
+        SampleArray<float> samples;
         float min_value;
         float max_value;
         float average_value;
@@ -55,6 +65,8 @@ public:
 
     FloatProbe() : m_result(std::make_shared<SamplingResult>()) {}
 
+    explicit FloatProbe(std::shared_ptr<SamplingResult> result) : m_result(std::move(result)) {}
+
     template<typename DatafieldType>
     void probe(DatafieldType const& datafield) { /* ToDo*/
     }
@@ -76,7 +88,7 @@ public:
     };
 
     struct SamplingResult {
-        std::vector<SampleValue> samples;
+        SampleArray<SampleValue> samples;
         float min_value;
         float max_value;
         float average_value;
@@ -84,6 +96,8 @@ public:
 
     FloatDistributionProbe() : m_result(std::make_shared<SamplingResult>()) {}
 
+    explicit FloatDistributionProbe(std::shared_ptr<SamplingResult> result) : m_result(std::move(result)) {}
+
     template<typename DatafieldType>
     void probe(DatafieldType const& datafield) { /* ToDo*/
     }
@@ -104,11 +118,13 @@ struct IntProbe : public BaseProbe {
 struct Vec4Probe : public BaseProbe {
 public:
     struct SamplingResult {
-        std::vector<std::array<float, 4>> samples;
+        SampleArray<std::array<float, 4>> samples;
     };
 
     Vec4Probe() : m_result(std::make_shared<SamplingResult>()) {}
 
+    explicit Vec4Probe(std::shared_ptr<SamplingResult> result) : m_result(std::move(result)) {}
+
     template<typename DatafieldType>
     void probe(DatafieldType const& datafield) { /* ToDo*/
     }
@@ -124,54 +140,121 @@ private:
 using GenericProbe = std::variant<FloatProbe, IntProbe, Vec4Probe, BaseProbe, FloatDistributionProbe>;
 using GenericMinMax = std::variant<std::array<float, 2>, std::array<int, 2>>;
 
+namespace detail {
+
+template<typename ProbeType, typename Variant>
+struct probe_type_index;
+
+template<typename ProbeType, typename... Ts>
+struct probe_type_index<ProbeType, std::variant<Ts...>> {
+    static constexpr uint8_t value = [] {
+        uint8_t idx = 0;
+        bool found = false;
+        ((found = found || std::is_same_v<ProbeType, Ts>, idx += found ? 0 : 1), ...);
+        return idx;
+    }();
+};
+
+template<typename ProbeType, typename = void>
+struct has_sampling_result : std::false_type {};
+
+template<typename ProbeType>
+struct has_sampling_result<ProbeType, std::void_t<typename ProbeType::SamplingResult>> : std::true_type {};
+
+template<typename Result, typename = void>
+struct has_sample_stats : std::false_type {};
+
+template<typename Result>
+struct has_sample_stats<Result, std::void_t<decltype(Result::min_value)>> : std::true_type {};
+
+} // namespace detail
+
+/** Contiguous range of per-probe IDs inside a flat column */
+template<typename T>
+struct IDRange {
+    T const* first = nullptr;
+    T const* last = nullptr;
+
+    T const* begin() const {
+        return first;
+    }
+    T const* end() const {
+        return last;
+    }
+    size_t size() const {
+        return static_cast<size_t>(last - first);
+    }
+    bool empty() const {
+        return first == last;
+    }
+    T const& operator[](size_t idx) const {
+        return first[idx];
+    }
+};
+
+/**
+ * Columnar storage of probes.
+ * Each probe attribute lives in its own array, strings are interned and the variable length ID lists are stored
+ * back to back with an offset array. Sampling results either come from an attached ProbeSampleStore or, for probes
+ * handed in with own results, from a per-probe result pointer.
+ *
+ * The probe structs and GenericProbe remain available as a compatibility view: addProbe()/setProbe() decompose a
+ * probe into the columns, getProbe()/getGenericProbe() assemble one on demand. Bulk consumers should prefer the
+ * column accessors. addProbe()/setProbe() are not thread-safe, the per-index column setters are safe to call
+ * concurrently for distinct indices.
+ */
 class ProbeCollection {
 public:
     ProbeCollection() = default;
     ~ProbeCollection() = default;
 
+    /** Index of ProbeType in GenericProbe, as reported by getProbeTypeIndex() */
+    template<typename ProbeType>
+    static constexpr uint8_t typeIndex() {
+        return detail::probe_type_index<ProbeType, GenericProbe>::value;
+    }
+
     template<typename ProbeType>
     void addProbe(ProbeType const& probe) {
-        m_probes.push_back(probe);
+        auto const idx = m_types.size();
+        resize(idx + 1);
+        writeProbe(idx, probe);
     }
 
     template<typename ProbeType>
     void setProbe(size_t idx, ProbeType const& probe) {
-        m_probes[idx] = probe;
+        writeProbe(idx, probe);
     }
 
     template<typename ProbeType>
     ProbeType getProbe(size_t idx) const {
-        return std::get<ProbeType>(m_probes[idx]);
+        if (m_types[idx] != typeIndex<ProbeType>()) {
+            throw std::bad_variant_access();
+        }
+        return makeProbe<ProbeType>(idx);
     }
 
     GenericProbe getGenericProbe(size_t idx) const {
-        return m_probes[idx];
+        switch (m_types[idx]) {
+        case typeIndex<FloatProbe>():
+            return makeProbe<FloatProbe>(idx);
+        case typeIndex<IntProbe>():
+            return makeProbe<IntProbe>(idx);
+        case typeIndex<Vec4Probe>():
+            return makeProbe<Vec4Probe>(idx);
+        case typeIndex<FloatDistributionProbe>():
+            return makeProbe<FloatDistributionProbe>(idx);
+        default:
+            return makeProbe<BaseProbe>(idx);
+        }
     }
 
     BaseProbe getBaseProbe(size_t idx) const {
-        using T = std::decay_t<decltype(m_probes[idx])>;
-        if constexpr (std::is_same_v<T, probe::FloatProbe>) {
-            FloatProbe fp = std::get<FloatProbe>(m_probes[idx]);
-            FloatProbe* fpp = &fp;
-            BaseProbe* bpp = dynamic_cast<BaseProbe*>(fpp);
-            return *bpp;
-        } else if constexpr (std::is_same_v<T, probe::IntProbe>) {
-            IntProbe ip = std::get<IntProbe>(m_probes[idx]);
-            IntProbe* ipp = &ip;
-            BaseProbe* bpp = dynamic_cast<BaseProbe*>(ipp);
-            return *bpp;
-        } else if constexpr (std::is_same_v<T, probe::Vec4Probe>) {
-            Vec4Probe vecp = std::get<Vec4Probe>(m_probes[idx]);
-            Vec4Probe* vecpp = &vecp;
-            BaseProbe* bpp = dynamic_cast<BaseProbe*>(vecpp);
-            return *bpp;
-        } else {
-            return std::get<BaseProbe>(m_probes[idx]);
-        }
+        return makeProbe<BaseProbe>(idx);
     }
 
     uint32_t getProbeCount() const {
-        return m_probes.size();
+        return m_types.size();
     }
 
     template<typename T>
@@ -188,29 +271,364 @@ public:
         return m_global_min_max;
     }
 
+    /** GenericProbe index of the probe type at idx */
+    uint8_t getProbeTypeIndex(size_t idx) const {
+        return m_types[idx];
+    }
+
+    template<typename ProbeType>
+    bool holdsProbe(size_t idx) const {
+        return m_types[idx] == typeIndex<ProbeType>();
+    }
+
+    /**
+     * Changes the type of the probe at idx, keeping all base attributes.
+     * An own sampling result of the probe is dropped.
+     */
+    template<typename ProbeType>
+    void convertProbe(size_t idx) {
+        if (m_types[idx] != typeIndex<ProbeType>()) {
+            m_types[idx] = typeIndex<ProbeType>();
+            m_results[idx].reset();
+        }
+    }
+
+    std::vector<size_t> const& getTimestamps() const {
+        return m_timestamps;
+    }
+    std::vector<std::array<float, 3>> const& getPositions() const {
+        return m_positions;
+    }
+    std::vector<std::array<float, 3>> const& getDirections() const {
+        return m_directions;
+    }
+    std::vector<float> const& getBegins() const {
+        return m_begins;
+    }
+    std::vector<float> const& getEnds() const {
+        return m_ends;
+    }
+    std::vector<float> const& getSampleRadii() const {
+        return m_sample_radii;
+    }
+    std::vector<int> const& getClusterIDs() const {
+        return m_cluster_ids;
+    }
+    std::vector<char> const& getRepresentants() const {
+        return m_representants;
+    }
+
+    void setSampleRadius(size_t idx, float radius) {
+        m_sample_radii[idx] = radius;
+    }
+    void setClusterID(size_t idx, int cluster_id) {
+        m_cluster_ids[idx] = cluster_id;
+    }
+    void setRepresentant(size_t idx, bool representant) {
+        m_representants[idx] = representant;
+    }
+
+    std::string const& getValueName(size_t idx) const {
+        return m_strings[m_value_names[idx]];
+    }
+
+    /** Interned string IDs of the meshes the probe at idx goes through, resolve with getString() */
+    IDRange<uint32_t> getGeoIDs(size_t idx) const {
+        return {m_geo_ids.data() + m_geo_id_offsets[idx], m_geo_ids.data() + m_geo_id_offsets[idx + 1]};
+    }
+
+    IDRange<uint64_t> getVertIDs(size_t idx) const {
+        return {m_vert_ids.data() + m_vert_id_offsets[idx], m_vert_ids.data() + m_vert_id_offsets[idx + 1]};
+    }
+
+    std::string const& getString(uint32_t id) const {
+        return m_strings[id];
+    }
+
+    /**
+     * Sampling result of the probe at idx.
+     * For probes backed by the sample store, the result is a handle to the store row: the samples reference the row
+     * and the statistics are written back to the store when the last reference to the result is released. Samples
+     * resized to a count other than the samples per probe of the store do not fit the row and are not written back.
+     */
+    template<typename ProbeType>
+    std::shared_ptr<typename ProbeType::SamplingResult> getSamplingResult(size_t idx) const {
+        using Result = typename ProbeType::SamplingResult;
+        using SampleType = typename decltype(Result::samples)::value_type;
+
+        if (m_results[idx]) {
+            return std::static_pointer_cast<Result>(m_results[idx]);
+        }
+
+        auto const row = getSampleRow(idx);
+        if (row == NoSampleRow || m_sample_store->components() * sizeof(float) != sizeof(SampleType)) {
+            return std::make_shared<Result>();
+        }
+
+        auto result = std::make_unique<Result>();
+        result->samples = ProbeSampleStore::view<SampleType>(m_sample_store, row);
+        if constexpr (detail::has_sample_stats<Result>::value) {
+            result->min_value = m_sample_store->min_value()[row];
+            result->max_value = m_sample_store->max_value()[row];
+            result->average_value = m_sample_store->average_value()[row];
+        }
+        return std::shared_ptr<Result>(result.release(), [store = m_sample_store, row](Result* r) {
+            writeBack(*store, row, *r);
+            delete r;
+        });
+    }
+
+    /** Samples of the probe at idx without assembling a result object */
+    template<typename ProbeType>
+    auto getSamples(size_t idx) const -> decltype(ProbeType::SamplingResult::samples) {
+        using SampleType = typename decltype(ProbeType::SamplingResult::samples)::value_type;
+
+        if (m_results[idx]) {
+            return std::static_pointer_cast<typename ProbeType::SamplingResult>(m_results[idx])->samples;
+        }
+        auto const row = getSampleRow(idx);
+        if (row != NoSampleRow && m_sample_store->components() * sizeof(float) == sizeof(SampleType)) {
+            return ProbeSampleStore::view<SampleType>(m_sample_store, row);
+        }
+        return {};
+    }
+
+    /**
+     * Attach contiguous sample storage. Row i of the store holds the samples of the probe currently at index i,
+     * the mapping follows the probes through erase_probes() and shuffle_probes().
+     * Own sampling results of the probes are dropped, the store takes their place.
+     */
+    void setSampleStore(std::shared_ptr<ProbeSampleStore> store) {
+        m_sample_store = std::move(store);
+        m_sample_rows.resize(m_types.size());
+        std::iota(m_sample_rows.begin(), m_sample_rows.end(), 0);
+        std::fill(m_results.begin(), m_results.end(), nullptr);
+    }
+
+    std::shared_ptr<ProbeSampleStore> getSampleStore() const {
+        return m_sample_store;
+    }
+
+    /** Row of the probe in the sample store, or NoSampleRow if it has none */
+    uint32_t getSampleRow(size_t idx) const {
+        return idx < m_sample_rows.size() ? m_sample_rows[idx] : NoSampleRow;
+    }
+
+    static constexpr uint32_t NoSampleRow = std::numeric_limits<uint32_t>::max();
+
     void erase_probes(std::vector<char> const& indicator) {
-        if (indicator.size() != m_probes.size())
+        if (indicator.size() != m_types.size())
             return;
-        auto const num_el = std::count_if(indicator.begin(), indicator.end(), [](auto const el) { return el == 0; });
-        std::vector<GenericProbe> tmp;
-        tmp.reserve(num_el);
-        for (std::vector<GenericProbe>::size_type idx = 0; idx < m_probes.size(); ++idx) {
+        std::vector<size_t> order;
+        order.reserve(std::count(indicator.begin(), indicator.end(), 0));
+        for (size_t idx = 0; idx < indicator.size(); ++idx) {
             if (indicator[idx] == 0) {
-                tmp.push_back(m_probes[idx]);
+                order.push_back(idx);
             }
         }
-        m_probes = tmp;
+        reorder(order);
     }
 
     void shuffle_probes() {
         std::random_device rd;
         std::mt19937 g(rd());
-        std::shuffle(m_probes.begin(), m_probes.end(), g);
+        std::vector<size_t> order(m_types.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), g);
+        reorder(order);
     }
 
 private:
-    std::vector<GenericProbe> m_probes;
+    /** Stores a sampling result handed out by getSamplingResult() in its row of the sample store */
+    template<typename Result>
+    static void writeBack(ProbeSampleStore& store, uint32_t row, Result const& result) {
+        auto const dst = store.row(row);
+        auto const src = reinterpret_cast<float const*>(result.samples.data());
+        if (src != dst && result.samples.size() == store.samples_per_probe()) {
+            std::copy(src, src + store.samples_per_probe() * store.components(), dst);
+        }
+        if constexpr (detail::has_sample_stats<Result>::value) {
+            store.min_value()[row] = result.min_value;
+            store.max_value()[row] = result.max_value;
+            store.average_value()[row] = result.average_value;
+        }
+    }
+
+    void resize(size_t count) {
+        m_types.resize(count, typeIndex<BaseProbe>());
+        m_timestamps.resize(count);
+        m_value_names.resize(count);
+        m_positions.resize(count);
+        m_directions.resize(count);
+        m_begins.resize(count);
+        m_ends.resize(count);
+        m_sample_radii.resize(count);
+        m_cluster_ids.resize(count);
+        m_representants.resize(count);
+        m_geo_id_offsets.resize(count + 1, static_cast<uint32_t>(m_geo_ids.size()));
+        m_vert_id_offsets.resize(count + 1, static_cast<uint32_t>(m_vert_ids.size()));
+        m_results.resize(count);
+        if (!m_sample_rows.empty()) {
+            m_sample_rows.resize(count, NoSampleRow);
+        }
+    }
+
+    /** Keeps the probes listed in order, in that order */
+    void reorder(std::vector<size_t> const& order) {
+        auto gather = [&order](auto& column) {
+            std::decay_t<decltype(column)> tmp;
+            tmp.reserve(order.size());
+            for (auto const idx : order) {
+                tmp.push_back(std::move(column[idx]));
+            }
+            column = std::move(tmp);
+        };
+        auto gather_ranges = [&order](std::vector<uint32_t>& offsets, auto& data) {
+            std::vector<uint32_t> tmp_offsets;
+            tmp_offsets.reserve(order.size() + 1);
+            std::decay_t<decltype(data)> tmp_data;
+            tmp_offsets.push_back(0);
+            for (auto const idx : order) {
+                tmp_data.insert(tmp_data.end(), data.begin() + offsets[idx], data.begin() + offsets[idx + 1]);
+                tmp_offsets.push_back(static_cast<uint32_t>(tmp_data.size()));
+            }
+            offsets = std::move(tmp_offsets);
+            data = std::move(tmp_data);
+        };
+
+        gather(m_types);
+        gather(m_timestamps);
+        gather(m_value_names);
+        gather(m_positions);
+        gather(m_directions);
+        gather(m_begins);
+        gather(m_ends);
+        gather(m_sample_radii);
+        gather(m_cluster_ids);
+        gather(m_representants);
+        gather_ranges(m_geo_id_offsets, m_geo_ids);
+        gather_ranges(m_vert_id_offsets, m_vert_ids);
+        gather(m_results);
+        if (!m_sample_rows.empty()) {
+            gather(m_sample_rows);
+        }
+    }
+
+    uint32_t intern(std::string const& str) {
+        auto const it = m_string_ids.find(str);
+        if (it != m_string_ids.end()) {
+            return it->second;
+        }
+        auto const id = static_cast<uint32_t>(m_strings.size());
+        m_strings.push_back(str);
+        m_string_ids.emplace(str, id);
+        return id;
+    }
+
+    /** Replaces the ID range of probe idx, shifting the ranges behind it if the length changes */
+    template<typename T, typename Src, typename Convert>
+    static void assignRange(
+        std::vector<uint32_t>& offsets, std::vector<T>& data, size_t idx, Src const& values, Convert convert) {
+        auto const first = offsets[idx];
+        auto const old_size = offsets[idx + 1] - first;
+        auto const new_size = static_cast<uint32_t>(values.size());
+        if (old_size != new_size) {
+            data.erase(data.begin() + first, data.begin() + first + old_size);
+            data.insert(data.begin() + first, new_size, T{});
+            for (auto i = idx + 1; i < offsets.size(); ++i) {
+                offsets[i] = offsets[i] - old_size + new_size;
+            }
+        }
+        for (uint32_t i = 0; i < new_size; ++i) {
+            data[first + i] = convert(values[i]);
+        }
+    }
+
+    template<typename ProbeType>
+    void writeProbe(size_t idx, ProbeType const& probe) {
+        m_types[idx] = typeIndex<ProbeType>();
+        m_timestamps[idx] = probe.m_timestamp;
+        m_value_names[idx] = intern(probe.m_value_name);
+        m_positions[idx] = probe.m_position;
+        m_directions[idx] = probe.m_direction;
+        m_begins[idx] = probe.m_begin;
+        m_ends[idx] = probe.m_end;
+        m_sample_radii[idx] = probe.m_sample_radius;
+        m_cluster_ids[idx] = probe.m_cluster_id;
+        m_representants[idx] = probe.m_representant;
+        assignRange(m_geo_id_offsets, m_geo_ids, idx, probe.m_geo_ids,
+            [this](std::string const& geo_id) { return intern(geo_id); });
+        assignRange(m_vert_id_offsets, m_vert_ids, idx, probe.m_vert_ids, [](uint64_t vert_id) { return vert_id; });
+
+        m_results[idx].reset();
+        if constexpr (detail::has_sampling_result<ProbeType>::value) {
+            // results assembled from the store need not be kept, their samples already live there
+            auto result = probe.getSamplingResult();
+            auto const row = getSampleRow(idx);
+            if (result && !(row != NoSampleRow && result->samples.is_view() &&
+                              reinterpret_cast<float const*>(result->samples.data()) == m_sample_store->row(row))) {
+                m_results[idx] = std::move(result);
+            }
+        }
+    }
+
+    template<typename ProbeType>
+    ProbeType makeProbe(size_t idx) const {
+        ProbeType probe = [this, idx] {
+            if constexpr (detail::has_sampling_result<ProbeType>::value) {
+                return ProbeType(getSamplingResult<ProbeType>(idx));
+            } else {
+                return ProbeType();
+            }
+        }();
+        probe.m_timestamp = m_timestamps[idx];
+        probe.m_value_name = m_strings[m_value_names[idx]];
+        probe.m_position = m_positions[idx];
+        probe.m_direction = m_directions[idx];
+        probe.m_begin = m_begins[idx];
+        probe.m_end = m_ends[idx];
+        probe.m_sample_radius = m_sample_radii[idx];
+        probe.m_cluster_id = m_cluster_ids[idx];
+        probe.m_representant = m_representants[idx];
+        auto const geo_ids = getGeoIDs(idx);
+        probe.m_geo_ids.reserve(geo_ids.size());
+        for (auto const id : geo_ids) {
+            probe.m_geo_ids.push_back(m_strings[id]);
+        }
+        auto const vert_ids = getVertIDs(idx);
+        probe.m_vert_ids.assign(vert_ids.begin(), vert_ids.end());
+        return probe;
+    }
+
+    /** GenericProbe index per probe */
+    std::vector<uint8_t> m_types;
+    std::vector<size_t> m_timestamps;
+    /** Interned string ID per probe */
+    std::vector<uint32_t> m_value_names;
+    std::vector<std::array<float, 3>> m_positions;
+    std::vector<std::array<float, 3>> m_directions;
+    std::vector<float> m_begins;
+    std::vector<float> m_ends;
+    std::vector<float> m_sample_radii;
+    std::vector<int> m_cluster_ids;
+    std::vector<char> m_representants;
+    /** Probe i owns m_geo_ids[m_geo_id_offsets[i]] to m_geo_ids[m_geo_id_offsets[i + 1]] (exclusive) */
+    std::vector<uint32_t> m_geo_id_offsets = {0};
+    std::vector<uint32_t> m_geo_ids;
+    std::vector<uint32_t> m_vert_id_offsets = {0};
+    std::vector<uint64_t> m_vert_ids;
+    /** Own sampling result per probe, empty if the probe has none or its samples live in m_sample_store */
+    std::vector<std::shared_ptr<void>> m_results;
+
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, uint32_t> m_string_ids;
+
     GenericMinMax m_global_min_max;
+
+    /** Sampling results of all probes, if the producer stored them contiguously */
+    std::shared_ptr<ProbeSampleStore> m_sample_store;
+    /** Row in m_sample_store per probe */
+    std::vector<uint32_t> m_sample_rows;
 };
 
 
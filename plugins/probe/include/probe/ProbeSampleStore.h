@@ -0,0 +1,245 @@
+/*
+ * ProbeSampleStore.h
+ *
+ * Copyright (C) 2023 by Universitaet Stuttgart (VISUS).
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace megamol {
+namespace probe {
+
+/**
+ * Sample array of a single probe.
+ * Either owns its samples (like a std::vector) or references a slice of a shared sample store, which is kept alive as
+ * long as the array exists. Resizing a referencing array detaches it into an owning copy.
+ */
+template<typename T>
+class SampleArray {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = T const&;
+    using iterator = T*;
+    using const_iterator = T const*;
+
+    SampleArray() = default;
+
+    SampleArray(std::vector<T> samples) : _owned(std::move(samples)), _data(_owned.data()), _size(_owned.size()) {}
+
+    /** References size elements at data, owner keeps the memory alive */
+    SampleArray(std::shared_ptr<void const> owner, T* data, size_type size)
+            : _owner(std::move(owner))
+            , _data(data)
+            , _size(size) {}
+
+    SampleArray(SampleArray const& rhs) : _owned(rhs._owned), _owner(rhs._owner), _data(rhs._data), _size(rhs._size) {
+        if (!_owner) {
+            _data = _owned.data();
+        }
+    }
+
+    SampleArray(SampleArray&& rhs) noexcept
+            : _owned(std::move(rhs._owned))
+            , _owner(std::move(rhs._owner))
+            , _data(rhs._data)
+            , _size(rhs._size) {
+        rhs._data = nullptr;
+        rhs._size = 0;
+    }
+
+    SampleArray& operator=(SampleArray const& rhs) {
+        if (this != &rhs) {
+            SampleArray tmp(rhs);
+            *this = std::move(tmp);
+        }
+        return *this;
+    }
+
+    SampleArray& operator=(SampleArray&& rhs) noexcept {
+        _owned = std::move(rhs._owned);
+        _owner = std::move(rhs._owner);
+        _data = rhs._data;
+        _size = rhs._size;
+        rhs._data = nullptr;
+        rhs._size = 0;
+        return *this;
+    }
+
+    void resize(size_type size) {
+        detach();
+        _owned.resize(size);
+        _data = _owned.data();
+        _size = size;
+    }
+
+    void clear() {
+        resize(0);
+    }
+
+    /** True if the samples live in a shared store instead of this array */
+    bool is_view() const {
+        return static_cast<bool>(_owner);
+    }
+
+    size_type size() const {
+        return _size;
+    }
+    bool empty() const {
+        return _size == 0;
+    }
+
+    T* data() {
+        return _data;
+    }
+    T const* data() const {
+        return _data;
+    }
+
+    T& operator[](size_type idx) {
+        return _data[idx];
+    }
+    T const& operator[](size_type idx) const {
+        return _data[idx];
+    }
+
+    T& front() {
+        return _data[0];
+    }
+    T const& front() const {
+        return _data[0];
+    }
+    T& back() {
+        return _data[_size - 1];
+    }
+    T const& back() const {
+        return _data[_size - 1];
+    }
+
+    iterator begin() {
+        return _data;
+    }
+    iterator end() {
+        return _data + _size;
+    }
+    const_iterator begin() const {
+        return _data;
+    }
+    const_iterator end() const {
+        return _data + _size;
+    }
+    const_iterator cbegin() const {
+        return _data;
+    }
+    const_iterator cend() const {
+        return _data + _size;
+    }
+
+private:
+    void detach() {
+        if (_owner) {
+            _owned.assign(_data, _data + _size);
+            _owner.reset();
+        }
+    }
+
+    std::vector<T> _owned;
+    std::shared_ptr<void const> _owner;
+    T* _data = nullptr;
+    size_type _size = 0;
+};
+
+/**
+ * Contiguous structure-of-arrays storage for the sampling results of many probes.
+ * Row r holds samples_per_probe samples with components floats each, rows are packed back to back.
+ * Per-row statistics live in separate arrays.
+ */
+class ProbeSampleStore {
+public:
+    ProbeSampleStore() = default;
+
+    ProbeSampleStore(std::size_t rows, std::size_t samples_per_probe, std::size_t components) {
+        resize(rows, samples_per_probe, components);
+    }
+
+    void resize(std::size_t rows, std::size_t samples_per_probe, std::size_t components) {
+        _rows = rows;
+        _samples_per_probe = samples_per_probe;
+        _components = components;
+        _values.resize(rows * samples_per_probe * components);
+        _min_value.resize(rows);
+        _max_value.resize(rows);
+        _average_value.resize(rows);
+    }
+
+    std::size_t rows() const {
+        return _rows;
+    }
+    std::size_t samples_per_probe() const {
+        return _samples_per_probe;
+    }
+    std::size_t components() const {
+        return _components;
+    }
+
+    /** First float of the given row */
+    float* row(std::size_t r) {
+        return _values.data() + r * _samples_per_probe * _components;
+    }
+    float const* row(std::size_t r) const {
+        return _values.data() + r * _samples_per_probe * _components;
+    }
+
+    /**
+     * Typed view of a row for probe sampling results.
+     * T has to be layout compatible with components floats (e.g. float, std::array<float, 4>).
+     */
+    template<typename T>
+    static SampleArray<T> view(std::shared_ptr<ProbeSampleStore> const& store, std::size_t r) {
+        static_assert(sizeof(T) % sizeof(float) == 0, "sample type must consist of floats");
+        return SampleArray<T>(store, reinterpret_cast<T*>(store->row(r)), store->samples_per_probe());
+    }
+
+    std::vector<float>& values() {
+        return _values;
+    }
+    std::vector<float> const& values() const {
+        return _values;
+    }
+    std::vector<float>& min_value() {
+        return _min_value;
+    }
+    std::vector<float> const& min_value() const {
+        return _min_value;
+    }
+    std::vector<float>& max_value() {
+        return _max_value;
+    }
+    std::vector<float> const& max_value() const {
+        return _max_value;
+    }
+    std::vector<float>& average_value() {
+        return _average_value;
+    }
+    std::vector<float> const& average_value() const {
+        return _average_value;
+    }
+
+private:
+    std::size_t _rows = 0;
+    std::size_t _samples_per_probe = 0;
+    std::size_t _components = 1;
+    std::vector<float> _values;
+    std::vector<float> _min_value;
+    std::vector<float> _max_value;
+    std::vector<float> _average_value;
+};
+
+} // namespace probe
+} // namespace megamol
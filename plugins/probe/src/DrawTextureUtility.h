@@ -8,6 +8,7 @@
 
 #include "blend2d.h"
 #include "mmcore/utility/log/Log.h"
+#include "probe/ProbeSampleStore.h"
 #include <cmath>
 #include <cstdint>
 #include <memory>
@@ -53,20 +54,20 @@ public:
     }
 
     template<typename T>
-    uint8_t* draw(std::vector<T>& data, T min, T max);
+    uint8_t* draw(SampleArray<T>& data, T min, T max);
 
     template<typename T>
-    uint8_t* draw(std::vector<T>& data, std::array<float, 3> probe_direction);
+    uint8_t* draw(SampleArray<T>& data, std::array<float, 3> probe_direction);
 
 private:
     template<typename T>
-    void drawPlot(std::vector<T>& data, T min, T max);
+    void drawPlot(SampleArray<T>& data, T min, T max);
     template<typename T>
-    void drawStar(std::vector<T>& data, T min, T max);
+    void drawStar(SampleArray<T>& data, T min, T max);
     template<typename T>
-    void drawLinear(std::vector<T>& data, T min, T max);
+    void drawLinear(SampleArray<T>& data, T min, T max);
     template<typename T>
-    void drawRadarGlyph(std::vector<T>& data, std::array<float, 3> probe_direction);
+    void drawRadarGlyph(SampleArray<T>& data, std::array<float, 3> probe_direction);
 
     uint32_t _pixel_width = 0;
     uint32_t _pixel_height = 0;
@@ -80,7 +81,7 @@ private:
 
 
 template<typename T>
-uint8_t* DrawTextureUtility::draw(std::vector<T>& data, T min, T max) {
+uint8_t* DrawTextureUtility::draw(SampleArray<T>& data, T min, T max) {
     _img = BLImage(this->_pixel_width, this->_pixel_height, BL_FORMAT_PRGB32);
     _ctx = BLContext(_img);
 
@@ -114,7 +115,7 @@ uint8_t* DrawTextureUtility::draw(std::vector<T>& data, T min, T max) {
 }
 
 template<typename T>
-inline uint8_t* DrawTextureUtility::draw(std::vector<T>& data, std::array<float, 3> probe_direction) {
+inline uint8_t* DrawTextureUtility::draw(SampleArray<T>& data, std::array<float, 3> probe_direction) {
 
     _img = BLImage(this->_pixel_width, this->_pixel_height, BL_FORMAT_PRGB32);
     _ctx = BLContext(_img);
@@ -147,7 +148,7 @@ inline uint8_t* DrawTextureUtility::draw(std::vector<T>& data, std::array<float,
 }
 
 template<typename T>
-void DrawTextureUtility::drawPlot(std::vector<T>& data, T min, T max) {
+void DrawTextureUtility::drawPlot(SampleArray<T>& data, T min, T max) {
 
     uint32_t width_halo = this->_pixel_width * 0.1f;
     uint32_t height_halo = this->_pixel_height * 0.1f;
@@ -187,7 +188,7 @@ void DrawTextureUtility::drawPlot(std::vector<T>& data, T min, T max) {
 }
 
 template<typename T>
-void DrawTextureUtility::drawStar(std::vector<T>& data, T min, T max) {
+void DrawTextureUtility::drawStar(SampleArray<T>& data, T min, T max) {
 
     uint32_t width_halo = this->_pixel_width * 0.1f;
     uint32_t height_halo = this->_pixel_height * 0.1f;
@@ -270,7 +271,7 @@ void DrawTextureUtility::drawStar(std::vector<T>& data, T min, T max) {
 }
 
 template<typename T>
-void DrawTextureUtility::drawLinear(std::vector<T>& data, T min, T max) {
+void DrawTextureUtility::drawLinear(SampleArray<T>& data, T min, T max) {
 
     uint32_t width_halo = this->_pixel_width * 0.2f;
     uint32_t height_halo = this->_pixel_height * 0.1f;
@@ -326,7 +327,7 @@ void DrawTextureUtility::drawLinear(std::vector<T>& data, T min, T max) {
 }
 
 template<typename T>
-inline void DrawTextureUtility::drawRadarGlyph(std::vector<T>& data, std::array<float, 3> probe_direction) {
+inline void DrawTextureUtility::drawRadarGlyph(SampleArray<T>& data, std::array<float, 3> probe_direction) {
 
     uint32_t width_halo = this->_pixel_width * 0.1f;
     uint32_t height_halo = this->_pixel_height * 0.1f;
@@ -118,45 +118,21 @@ void ElementSampling::doScalarSampling(const std::vector<std::vector<Surface_mes
     float global_min = std::numeric_limits<T>::max();
     float global_max = -std::numeric_limits<T>::max();
 
+    // the samples go straight into the rows of the store, one sample per shell
+    static_assert(sizeof(FloatDistributionProbe::SampleValue) == 3 * sizeof(float));
+    auto store = std::make_shared<ProbeSampleStore>(_probes->getProbeCount(), elements.size(), 3);
+
     // select Element
     for (int j = 0; j < elements[0].size(); ++j) {
-        FloatDistributionProbe probe;
-
-
-        auto visitor = [&probe, j, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::Vec4Probe> ||
-                          std::is_same_v<T, probe::FloatProbe>) {
-
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-                probe.m_geo_ids = arg.m_geo_ids;
-
-                probe.m_sample_radius = 0;
-
-                _probes->setProbe(j, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::FloatDistributionProbe>) {
-                probe = arg;
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
-
-        auto generic_probe = _probes->getGenericProbe(j);
-        std::visit(visitor, generic_probe);
+        if (!_probes->holdsProbe<FloatDistributionProbe>(j)) {
+            _probes->convertProbe<FloatDistributionProbe>(j);
+            _probes->setSampleRadius(j, 0);
+        }
 
-        std::shared_ptr<FloatDistributionProbe::SamplingResult> samples = probe.getSamplingResult();
+        auto* samples = reinterpret_cast<FloatDistributionProbe::SampleValue*>(store->row(j));
         float min_value = std::numeric_limits<T>::max();
         float max_value = -std::numeric_limits<T>::max();
         float avg_value = 0.0f;
-        samples->samples.resize(elements.size());
 
         // go through shells
         for (int i = 0; i < elements.size(); ++i) {
@@ -233,7 +209,7 @@ void ElementSampling::doScalarSampling(const std::vector<std::vector<Surface_mes
             s_result.lower_bound = min_data;
             s_result.upper_bound = max_data;
 
-            samples->samples[i] = s_result;
+            samples[i] = s_result;
 
             min_value = std::min(min_value, value);
             max_value = std::max(max_value, value);
@@ -243,14 +219,15 @@ void ElementSampling::doScalarSampling(const std::vector<std::vector<Surface_mes
         } // end for shells
         avg_value /= elements.size();
 
-        samples->average_value = avg_value;
-        samples->max_value = max_value;
-        samples->min_value = min_value;
+        store->average_value()[j] = avg_value;
+        store->max_value()[j] = max_value;
+        store->min_value()[j] = min_value;
 
-        global_min = std::min(global_min, samples->min_value);
-        global_max = std::max(global_max, samples->max_value);
+        global_min = std::min(global_min, min_value);
+        global_max = std::max(global_max, max_value);
     } // end for elements
     _probes->setGlobalMinMax(global_min, global_max);
+    _probes->setSampleStore(store);
 }
 
 inline void ElementSampling::do_triangulation(Surface_mesh& mesh_) {
@@ -85,12 +85,7 @@ bool megamol::probe::InjectClusterID::getData(core::Call& call) {
 
                         for (int i = 0; i < vertex_cnt; ++i) {
                             if (probe_id_accessor[i] != std::numeric_limits<int>::max()) {
-                                auto generic_probe = probes->getGenericProbe(probe_id_accessor[i]);
-
-                                int cluster_id =
-                                    std::visit([](auto&& arg) -> int { return arg.m_cluster_id; }, generic_probe);
-
-                                probe_id_accessor[i] = cluster_id;
+                                probe_id_accessor[i] = probes->getClusterIDs()[probe_id_accessor[i]];
                             } else {
                                 megamol::core::utility::log::Log::DefaultLog.WriteError(
                                     "Tried injecting cluster ID to vertex with invalid probe ID. [%s, %s, line %d]\n",
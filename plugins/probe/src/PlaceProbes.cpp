@@ -1016,7 +1016,8 @@ bool megamol::probe::PlaceProbes::loadFromFile() {
     if (!(*cd)(0))
         return false;
 
-    auto tmp_data = cd->getData(availVars[0])->GetAsFloat();
+    std::vector<float> converted;
+    auto tmp_data = cd->getData(availVars[0])->GetSpanAs(converted);
     _probePositions.resize(tmp_data.size() / 4);
     for (int i = 0; i < _probePositions.size(); ++i) {
         for (int j = 0; j < _probePositions.data()->size(); ++j) {
@@ -137,40 +137,16 @@ bool megamol::probe::ProbeClustering::get_data_cb(core::Call& c) {
             auto const handwaving = _handwaving_slot.Param<core::param::FloatParam>()->Value();
             auto const angle_threshold = glm::radians(_angle_threshold_slot.Param<core::param::FloatParam>()->Value());
 
-            bool vec_probe = false;
-            bool distrib_probe = false;
-            {
-                auto const test_probe = _probes->getGenericProbe(0);
-                vec_probe = std::holds_alternative<Vec4Probe>(test_probe);
-                distrib_probe = std::holds_alternative<FloatDistributionProbe>(test_probe);
-            }
+            auto const& positions = _probes->getPositions();
+            auto const& directions = _probes->getDirections();
 
             std::vector<float> cur_points(num_probes * 3);
             _cur_dirs.resize(num_probes);
-            if (vec_probe) {
-                for (std::remove_const_t<decltype(num_probes)> pidx = 0; pidx < num_probes; ++pidx) {
-                    auto const probe = _probes->getProbe<Vec4Probe>(pidx);
-                    cur_points[pidx * 3 + 0] = probe.m_position[0];
-                    cur_points[pidx * 3 + 1] = probe.m_position[1];
-                    cur_points[pidx * 3 + 2] = probe.m_position[2];
-                    _cur_dirs[pidx] = glm::vec3(probe.m_direction[0], probe.m_direction[1], probe.m_direction[2]);
-                }
-            } else if (distrib_probe) {
-                for (std::remove_const_t<decltype(num_probes)> pidx = 0; pidx < num_probes; ++pidx) {
-                    auto const probe = _probes->getProbe<FloatDistributionProbe>(pidx);
-                    cur_points[pidx * 3 + 0] = probe.m_position[0];
-                    cur_points[pidx * 3 + 1] = probe.m_position[1];
-                    cur_points[pidx * 3 + 2] = probe.m_position[2];
-                    _cur_dirs[pidx] = glm::vec3(probe.m_direction[0], probe.m_direction[1], probe.m_direction[2]);
-                }
-            } else {
-                for (std::remove_const_t<decltype(num_probes)> pidx = 0; pidx < num_probes; ++pidx) {
-                    auto const probe = _probes->getProbe<FloatProbe>(pidx);
-                    cur_points[pidx * 3 + 0] = probe.m_position[0];
-                    cur_points[pidx * 3 + 1] = probe.m_position[1];
-                    cur_points[pidx * 3 + 2] = probe.m_position[2];
-                    _cur_dirs[pidx] = glm::vec3(probe.m_direction[0], probe.m_direction[1], probe.m_direction[2]);
-                }
+            for (std::remove_const_t<decltype(num_probes)> pidx = 0; pidx < num_probes; ++pidx) {
+                cur_points[pidx * 3 + 0] = positions[pidx][0];
+                cur_points[pidx * 3 + 1] = positions[pidx][1];
+                cur_points[pidx * 3 + 2] = positions[pidx][2];
+                _cur_dirs[pidx] = glm::vec3(directions[pidx][0], directions[pidx][1], directions[pidx][2]);
             }
 
             /*if (is_debug_dirty()) {
@@ -246,24 +222,8 @@ bool megamol::probe::ProbeClustering::get_data_cb(core::Call& c) {
                     return sum / static_cast<float>(vec.size());
                 }*/
 
-                if (vec_probe) {
-                    for (decltype(_cluster_res)::size_type pidx = 0; pidx < _cluster_res.size(); ++pidx) {
-                        auto probe = _probes->getProbe<Vec4Probe>(pidx);
-                        probe.m_cluster_id = _cluster_res[pidx];
-                        _probes->setProbe(pidx, probe);
-                    }
-                } else if (distrib_probe) {
-                    for (decltype(_cluster_res)::size_type pidx = 0; pidx < _cluster_res.size(); ++pidx) {
-                        auto probe = _probes->getProbe<FloatDistributionProbe>(pidx);
-                        probe.m_cluster_id = _cluster_res[pidx];
-                        _probes->setProbe(pidx, probe);
-                    }
-                } else {
-                    for (decltype(_cluster_res)::size_type pidx = 0; pidx < _cluster_res.size(); ++pidx) {
-                        auto probe = _probes->getProbe<FloatProbe>(pidx);
-                        probe.m_cluster_id = _cluster_res[pidx];
-                        _probes->setProbe(pidx, probe);
-                    }
+                for (decltype(_cluster_res)::size_type pidx = 0; pidx < _cluster_res.size(); ++pidx) {
+                    _probes->setClusterID(pidx, _cluster_res[pidx]);
                 }
             }
         }
@@ -302,31 +262,8 @@ bool megamol::probe::ProbeClustering::get_data_cb(core::Call& c) {
                 cluster_reps.push_back(min_idx);
             }
 
-            bool vec_probe = false;
-            bool distrib_probe = false;
-            {
-                auto const test_probe = _probes->getGenericProbe(0);
-                vec_probe = std::holds_alternative<Vec4Probe>(test_probe);
-                distrib_probe = std::holds_alternative<FloatDistributionProbe>(test_probe);
-            }
-            if (vec_probe) {
-                for (auto const& el : cluster_reps) {
-                    auto probe = _probes->getProbe<Vec4Probe>(el);
-                    probe.m_representant = true;
-                    _probes->setProbe(el, probe);
-                }
-            } else if (distrib_probe) {
-                for (auto const& el : cluster_reps) {
-                    auto probe = _probes->getProbe<FloatDistributionProbe>(el);
-                    probe.m_representant = true;
-                    _probes->setProbe(el, probe);
-                }
-            } else {
-                for (auto const& el : cluster_reps) {
-                    auto probe = _probes->getProbe<FloatProbe>(el);
-                    probe.m_representant = true;
-                    _probes->setProbe(el, probe);
-                }
+            for (auto const& el : cluster_reps) {
+                _probes->setRepresentant(el, true);
             }
             /*std::vector<char> indicator(probes->getProbeCount(), 1);
             for (auto const& el : cluster_reps) {
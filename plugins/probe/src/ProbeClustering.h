@@ -101,12 +101,8 @@ private:
 
         if (lhs_idx < _probes->getProbeCount() && rhs_idx < _probes->getProbeCount()) {
 
-            auto rhs_generic_probe = _probes->getGenericProbe(rhs_idx);
-            auto lhs_generic_probe = _probes->getGenericProbe(lhs_idx);
-            uint32_t rhs_cluster_id = std::visit(
-                [](auto&& arg) -> uint32_t { return static_cast<uint32_t>(arg.m_cluster_id); }, rhs_generic_probe);
-            uint32_t lhs_cluster_id = std::visit(
-                [](auto&& arg) -> uint32_t { return static_cast<uint32_t>(arg.m_cluster_id); }, lhs_generic_probe);
+            uint32_t rhs_cluster_id = static_cast<uint32_t>(_probes->getClusterIDs()[rhs_idx]);
+            uint32_t lhs_cluster_id = static_cast<uint32_t>(_probes->getClusterIDs()[lhs_idx]);
             core::utility::log::Log::DefaultLog.WriteInfo("[ProbeClustering]: Assigned cluster IDs for %d:%d are %d:%d",
                 lhs_idx, rhs_idx, lhs_cluster_id, rhs_cluster_id);
         }
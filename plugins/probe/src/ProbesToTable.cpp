@@ -64,19 +64,22 @@ bool ProbeToTable::getData(core::Call& call) {
     if (cpd->hasUpdate() || (meta_data.m_frame_ID != _currentFrame)) {
 
         auto num_probes = probe_data->getProbeCount();
-        bool distrib_probe = false;
-        {
-            auto const test_probe = probe_data->getGenericProbe(0);
-            distrib_probe = std::holds_alternative<FloatDistributionProbe>(test_probe);
-        }
+        bool const distrib_probe = probe_data->holdsProbe<FloatDistributionProbe>(0);
+
+        auto const& positions = probe_data->getPositions();
+        auto const& directions = probe_data->getDirections();
+        auto const& begins = probe_data->getBegins();
+        auto const& ends = probe_data->getEnds();
+        auto const& timestamps = probe_data->getTimestamps();
+        auto const& sample_radii = probe_data->getSampleRadii();
+        auto const& cluster_ids = probe_data->getClusterIDs();
 
         std::vector<std::vector<float>> raw_data;
         std::vector<float> mins;
         std::vector<float> maxes;
         std::vector<std::string> var_names;
         if (distrib_probe) {
-            auto probe_one = probe_data->getProbe<FloatDistributionProbe>(0);
-            auto num_samples = probe_one.getSamplingResult()->samples.size();
+            auto num_samples = probe_data->getSamples<FloatDistributionProbe>(0).size();
             _rows = num_probes;
 
             var_names = {"id", "position_x", "position_y", "position_z", "direction_x", "direction_y", "direction_z",
@@ -102,52 +105,51 @@ bool ProbeToTable::getData(core::Call& call) {
                 raw_data[i].resize(_total_cols);
 
                 int current_col = 0;
-                auto probe = probe_data->getProbe<FloatDistributionProbe>(i);
                 raw_data[i][current_col] = i;
                 mins[current_col] = std::min(mins[current_col], static_cast<float>(i));
                 maxes[current_col] = std::max(maxes[current_col], static_cast<float>(i));
                 current_col += 1;
 
-                for (int n = 0; n < probe.m_position.size(); ++n) {
-                    raw_data[i][current_col] = probe.m_position[n];
-                    mins[current_col] = std::min(mins[current_col], probe.m_position[n]);
-                    maxes[current_col] = std::max(maxes[current_col], probe.m_position[n]);
+                for (int n = 0; n < positions[i].size(); ++n) {
+                    raw_data[i][current_col] = positions[i][n];
+                    mins[current_col] = std::min(mins[current_col], positions[i][n]);
+                    maxes[current_col] = std::max(maxes[current_col], positions[i][n]);
                     current_col += 1;
                 }
 
-                for (int n = 0; n < probe.m_position.size(); ++n) {
-                    raw_data[i][current_col] = probe.m_direction[n];
-                    mins[current_col] = std::min(mins[current_col], probe.m_direction[n]);
-                    maxes[current_col] = std::max(maxes[current_col], probe.m_direction[n]);
+                for (int n = 0; n < positions[i].size(); ++n) {
+                    raw_data[i][current_col] = directions[i][n];
+                    mins[current_col] = std::min(mins[current_col], directions[i][n]);
+                    maxes[current_col] = std::max(maxes[current_col], directions[i][n]);
                     current_col += 1;
                 }
 
-                raw_data[i][current_col] = probe.m_begin;
-                mins[current_col] = std::min(mins[current_col], probe.m_begin);
-                maxes[current_col] = std::max(maxes[current_col], probe.m_begin);
+                raw_data[i][current_col] = begins[i];
+                mins[current_col] = std::min(mins[current_col], begins[i]);
+                maxes[current_col] = std::max(maxes[current_col], begins[i]);
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_end;
-                mins[current_col] = std::min(mins[current_col], probe.m_end);
-                maxes[current_col] = std::max(maxes[current_col], probe.m_end);
+                raw_data[i][current_col] = ends[i];
+                mins[current_col] = std::min(mins[current_col], ends[i]);
+                maxes[current_col] = std::max(maxes[current_col], ends[i]);
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_timestamp;
-                mins[current_col] = std::min(mins[current_col], static_cast<float>(probe.m_timestamp));
-                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(probe.m_timestamp));
+                raw_data[i][current_col] = timestamps[i];
+                mins[current_col] = std::min(mins[current_col], static_cast<float>(timestamps[i]));
+                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(timestamps[i]));
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_sample_radius;
-                mins[current_col] = std::min(mins[current_col], probe.m_sample_radius);
-                maxes[current_col] = std::max(maxes[current_col], probe.m_sample_radius);
+                raw_data[i][current_col] = sample_radii[i];
+                mins[current_col] = std::min(mins[current_col], sample_radii[i]);
+                maxes[current_col] = std::max(maxes[current_col], sample_radii[i]);
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_cluster_id;
-                mins[current_col] = std::min(mins[current_col], static_cast<float>(probe.m_cluster_id));
-                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(probe.m_cluster_id));
+                raw_data[i][current_col] = cluster_ids[i];
+                mins[current_col] = std::min(mins[current_col], static_cast<float>(cluster_ids[i]));
+                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(cluster_ids[i]));
                 current_col += 1;
 
-                auto result = probe.getSamplingResult()->samples;
+                auto const result = probe_data->getSamples<FloatDistributionProbe>(i);
                 for (int k = 0; k < num_samples; ++k) {
                     raw_data[i][fixed_var_names_index + 3 * k + 0] = result[k].mean;
                     raw_data[i][fixed_var_names_index + 3 * k + 1] = result[k].lower_bound;
@@ -159,8 +161,7 @@ bool ProbeToTable::getData(core::Call& call) {
                 }
             }
         } else {
-            auto probe_one = probe_data->getProbe<FloatProbe>(0);
-            auto num_samples = probe_one.getSamplingResult()->samples.size();
+            auto num_samples = probe_data->getSamples<FloatProbe>(0).size();
             _rows = num_probes;
 
             var_names = {"id", "position_x", "position_y", "position_z", "direction_x", "direction_y", "direction_z",
@@ -182,52 +183,51 @@ bool ProbeToTable::getData(core::Call& call) {
                 raw_data[i].resize(_total_cols);
 
                 int current_col = 0;
-                auto probe = probe_data->getProbe<FloatProbe>(i);
                 raw_data[i][current_col] = i;
                 mins[current_col] = std::min(mins[current_col], static_cast<float>(i));
                 maxes[current_col] = std::max(maxes[current_col], static_cast<float>(i));
                 current_col += 1;
 
-                for (int n = 0; n < probe.m_position.size(); ++n) {
-                    raw_data[i][current_col] = probe.m_position[n];
-                    mins[current_col] = std::min(mins[current_col], probe.m_position[n]);
-                    maxes[current_col] = std::max(maxes[current_col], probe.m_position[n]);
+                for (int n = 0; n < positions[i].size(); ++n) {
+                    raw_data[i][current_col] = positions[i][n];
+                    mins[current_col] = std::min(mins[current_col], positions[i][n]);
+                    maxes[current_col] = std::max(maxes[current_col], positions[i][n]);
                     current_col += 1;
                 }
 
-                for (int n = 0; n < probe.m_position.size(); ++n) {
-                    raw_data[i][current_col] = probe.m_direction[n];
-                    mins[current_col] = std::min(mins[current_col], probe.m_direction[n]);
-                    maxes[current_col] = std::max(maxes[current_col], probe.m_direction[n]);
+                for (int n = 0; n < positions[i].size(); ++n) {
+                    raw_data[i][current_col] = directions[i][n];
+                    mins[current_col] = std::min(mins[current_col], directions[i][n]);
+                    maxes[current_col] = std::max(maxes[current_col], directions[i][n]);
                     current_col += 1;
                 }
 
-                raw_data[i][current_col] = probe.m_begin;
-                mins[current_col] = std::min(mins[current_col], probe.m_begin);
-                maxes[current_col] = std::max(maxes[current_col], probe.m_begin);
+                raw_data[i][current_col] = begins[i];
+                mins[current_col] = std::min(mins[current_col], begins[i]);
+                maxes[current_col] = std::max(maxes[current_col], begins[i]);
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_end;
-                mins[current_col] = std::min(mins[current_col], probe.m_end);
-                maxes[current_col] = std::max(maxes[current_col], probe.m_end);
+                raw_data[i][current_col] = ends[i];
+                mins[current_col] = std::min(mins[current_col], ends[i]);
+                maxes[current_col] = std::max(maxes[current_col], ends[i]);
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_timestamp;
-                mins[current_col] = std::min(mins[current_col], static_cast<float>(probe.m_timestamp));
-                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(probe.m_timestamp));
+                raw_data[i][current_col] = timestamps[i];
+                mins[current_col] = std::min(mins[current_col], static_cast<float>(timestamps[i]));
+                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(timestamps[i]));
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_sample_radius;
-                mins[current_col] = std::min(mins[current_col], probe.m_sample_radius);
-                maxes[current_col] = std::max(maxes[current_col], probe.m_sample_radius);
+                raw_data[i][current_col] = sample_radii[i];
+                mins[current_col] = std::min(mins[current_col], sample_radii[i]);
+                maxes[current_col] = std::max(maxes[current_col], sample_radii[i]);
                 current_col += 1;
 
-                raw_data[i][current_col] = probe.m_cluster_id;
-                mins[current_col] = std::min(mins[current_col], static_cast<float>(probe.m_cluster_id));
-                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(probe.m_cluster_id));
+                raw_data[i][current_col] = cluster_ids[i];
+                mins[current_col] = std::min(mins[current_col], static_cast<float>(cluster_ids[i]));
+                maxes[current_col] = std::max(maxes[current_col], static_cast<float>(cluster_ids[i]));
                 current_col += 1;
 
-                auto result = probe.getSamplingResult()->samples;
+                auto const result = probe_data->getSamples<FloatProbe>(i);
                 for (int k = 0; k < num_samples; ++k) {
                     raw_data[i][fixed_var_names_index + k] = result[k];
                     mins[fixed_var_names_index + k] = std::min(mins[fixed_var_names_index + k], result[k]);
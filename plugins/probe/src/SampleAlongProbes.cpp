@@ -432,6 +432,17 @@ bool SampleAlongPobes::getMetaData(core::Call& call) {
     return true;
 }
 
+void SampleAlongPobes::applySampleStore(std::shared_ptr<ProbeSampleStore> const& store) {
+    float global_min = std::numeric_limits<float>::max();
+    float global_max = std::numeric_limits<float>::lowest();
+    for (size_t i = 0; i < store->rows(); ++i) {
+        global_min = std::min(global_min, store->min_value()[i]);
+        global_max = std::max(global_max, store->max_value()[i]);
+    }
+    _probes->setGlobalMinMax(global_min, global_max);
+    _probes->setSampleStore(store);
+}
+
 bool SampleAlongPobes::paramChanged(core::param::ParamSlot& p) {
 
     _trigger_recalc = true;
@@ -123,6 +123,24 @@ private:
     template<typename T>
     void doNearestNeighborSampling(const std::shared_ptr<pcl::KdTreeFLANN<pcl::PointXYZ>>& tree, std::vector<T>& data);
 
+    /**
+     * Prepares the probes for sampling into a new sample store. Probes of other types are turned into ProbeType, their
+     * base attributes stay. Each probe gets the sample radius radius_scale * sample step * sample radius factor, where
+     * the sample step is its length divided by the number of samples per probe.
+     *
+     * @param components Number of floats per sample
+     *
+     * @return The sample store, row i receives the samples of probe i
+     */
+    template<typename ProbeType>
+    std::shared_ptr<ProbeSampleStore> prepareSampling(size_t components, float radius_scale);
+
+    /**
+     * Hands the sampling results to the probe collection and derives the global value range from the per-probe
+     * ranges. Has to be called before probes are erased or shuffled.
+     */
+    void applySampleStore(std::shared_ptr<ProbeSampleStore> const& store);
+
     bool getData(core::Call& call);
 
     bool getMetaData(core::Call& call);
@@ -138,204 +156,172 @@ private:
 };
 
 
-template<typename T>
-void SampleAlongPobes::doScalarSampling(
-    const std::shared_ptr<pcl::KdTreeFLANN<pcl::PointXYZ>>& tree, std::vector<T>& data) {
-
+template<typename ProbeType>
+std::shared_ptr<ProbeSampleStore> SampleAlongPobes::prepareSampling(size_t components, float radius_scale) {
     const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
     const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
 
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = -std::numeric_limits<float>::max();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); i++) {
-
-        FloatProbe probe;
+    const auto probe_count = static_cast<int32_t>(_probes->getProbeCount());
+    auto const& ends = _probes->getEnds();
 
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::Vec4Probe> ||
-                          std::is_same_v<T, probe::FloatDistributionProbe>) {
+#pragma omp parallel for
+    for (int32_t i = 0; i < probe_count; ++i) {
+        _probes->convertProbe<ProbeType>(i);
+        auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
+        _probes->setSampleRadius(i, radius_scale * sample_step * sample_radius_factor);
+    }
 
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
+    return std::make_shared<ProbeSampleStore>(probe_count, samples_per_probe, components);
+}
 
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = 0.5 * sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
+template<typename T>
+void SampleAlongPobes::doScalarSampling(
+    const std::shared_ptr<pcl::KdTreeFLANN<pcl::PointXYZ>>& tree, std::vector<T>& data) {
 
-                _probes->setProbe(i, probe);
+    const bool use_max_weighting = this->_weighting.Param<megamol::core::param::EnumParam>()->Value() != 0;
 
-            } else if constexpr (std::is_same_v<T, probe::FloatProbe>) {
-                probe = arg;
+    auto store = prepareSampling<FloatProbe>(1, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
+    auto const& radii = _probes->getSampleRadii();
 
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
+#pragma omp parallel
+    {
+        // search scratch of this thread, reused for all sample points
+        std::vector<uint32_t> k_indices;
+        std::vector<float> k_distances;
 
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
+#pragma omp for schedule(dynamic, 64)
+        for (int32_t i = 0; i < probe_count; i++) {
 
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = 0.5 * sample_step * sample_radius_factor;
+            auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
+            auto const radius = radii[i];
 
-        std::shared_ptr<FloatProbe::SamplingResult> samples = probe.getSamplingResult();
+            float* samples = store->row(i);
 
-        float min_value = std::numeric_limits<float>::max();
-        float max_value = -std::numeric_limits<float>::max();
-        float min_data = std::numeric_limits<float>::max();
-        float max_data = -std::numeric_limits<float>::max();
-        float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
-
-        for (int j = 0; j < samples_per_probe; j++) {
+            float min_value = std::numeric_limits<float>::max();
+            float max_value = -std::numeric_limits<float>::max();
+            float min_data = std::numeric_limits<float>::max();
+            float max_data = -std::numeric_limits<float>::max();
+            float avg_value = 0.0f;
 
-            pcl::PointXYZ sample_point;
-            sample_point.x = probe.m_position[0] + j * sample_step * probe.m_direction[0];
-            sample_point.y = probe.m_position[1] + j * sample_step * probe.m_direction[1];
-            sample_point.z = probe.m_position[2] + j * sample_step * probe.m_direction[2];
+            for (int j = 0; j < samples_per_probe; j++) {
 
-            std::vector<uint32_t> k_indices;
-            std::vector<float> k_distances;
+                pcl::PointXYZ sample_point;
+                sample_point.x = positions[i][0] + j * sample_step * directions[i][0];
+                sample_point.y = positions[i][1] + j * sample_step * directions[i][1];
+                sample_point.z = positions[i][2] + j * sample_step * directions[i][2];
 
-            auto num_neighbors = tree->radiusSearch(sample_point, radius, k_indices, k_distances);
-            if (num_neighbors == 0) {
-                num_neighbors = tree->nearestKSearch(sample_point, 1, k_indices, k_distances);
-            }
+                auto num_neighbors = tree->radiusSearch(sample_point, radius, k_indices, k_distances);
+                if (num_neighbors == 0) {
+                    num_neighbors = tree->nearestKSearch(sample_point, 1, k_indices, k_distances);
+                }
 
-            // accumulate values
-            float value = 0;
-            for (int n = 0; n < num_neighbors; n++) {
-                auto distance_weight = k_distances[n] / radius;
-                value += data[k_indices[n]] * distance_weight;
-                min_data = std::min(min_data, static_cast<float>(data[k_indices[n]]));
-                max_data = std::max(max_data, static_cast<float>(data[k_indices[n]]));
-            } // end num_neighbors
-            value /= num_neighbors;
-            if (this->_weighting.Param<megamol::core::param::EnumParam>()->Value() == 0) {
-                samples->samples[j] = value;
+                // accumulate values
+                float value = 0;
+                for (int n = 0; n < num_neighbors; n++) {
+                    auto distance_weight = k_distances[n] / radius;
+                    value += data[k_indices[n]] * distance_weight;
+                    min_data = std::min(min_data, static_cast<float>(data[k_indices[n]]));
+                    max_data = std::max(max_data, static_cast<float>(data[k_indices[n]]));
+                } // end num_neighbors
+                value /= num_neighbors;
+                if (!use_max_weighting) {
+                    samples[j] = value;
+                } else {
+                    samples[j] = max_data;
+                }
+                min_value = std::min(min_value, value);
+                max_value = std::max(max_value, value);
+                avg_value += value;
+            } // end num samples per probe
+            avg_value /= samples_per_probe;
+            if (!use_max_weighting) {
+                store->average_value()[i] = avg_value;
+                store->max_value()[i] = max_value;
+                store->min_value()[i] = min_value;
             } else {
-                samples->samples[j] = max_data;
+                store->average_value()[i] = max_data;
+                store->max_value()[i] = max_data;
+                store->min_value()[i] = max_data;
             }
-            min_value = std::min(min_value, value);
-            max_value = std::max(max_value, value);
-            avg_value += value;
-        } // end num samples per probe
-        avg_value /= samples_per_probe;
-        if (this->_weighting.Param<megamol::core::param::EnumParam>()->Value() == 0) {
-            samples->average_value = avg_value;
-            samples->max_value = max_value;
-            samples->min_value = min_value;
-        } else {
-            samples->average_value = max_data;
-            samples->max_value = max_data;
-            samples->min_value = max_data;
-        }
-        global_min = std::min(global_min, samples->min_value);
-        global_max = std::max(global_max, samples->max_value);
-    } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+        } // end for probes
+    }
+    applySampleStore(store);
 }
 
 template<typename T>
 inline void SampleAlongPobes::doScalarDistributionSampling(
     const std::shared_ptr<pcl::KdTreeFLANN<pcl::PointXYZ>>& tree, std::vector<T>& data) {
 
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
-
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = -std::numeric_limits<float>::max();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); i++) {
-
-        FloatDistributionProbe probe;
-
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::FloatProbe> ||
-                          std::is_same_v<T, probe::Vec4Probe>) {
+    static_assert(sizeof(FloatDistributionProbe::SampleValue) == 3 * sizeof(float));
+    auto store = prepareSampling<FloatDistributionProbe>(3, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
+    auto const& radii = _probes->getSampleRadii();
 
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = 0.5 * sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::FloatDistributionProbe>) {
-                probe = arg;
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
-
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
+#pragma omp parallel
+    {
+        std::vector<uint32_t> k_indices;
+        std::vector<float> k_distances;
 
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = 0.5 * sample_step * sample_radius_factor;
+#pragma omp for schedule(dynamic, 64)
+        for (int32_t i = 0; i < probe_count; i++) {
 
-        std::shared_ptr<FloatDistributionProbe::SamplingResult> samples = probe.getSamplingResult();
+            auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
+            auto const radius = radii[i];
 
-        float min_value = std::numeric_limits<float>::max();
-        float max_value = std::numeric_limits<float>::min();
-        float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+            auto* samples = reinterpret_cast<FloatDistributionProbe::SampleValue*>(store->row(i));
 
-        for (int j = 0; j < samples_per_probe; j++) {
+            float min_value = std::numeric_limits<float>::max();
+            float max_value = std::numeric_limits<float>::lowest();
+            float avg_value = 0.0f;
 
-            pcl::PointXYZ sample_point;
-            sample_point.x = probe.m_position[0] + j * sample_step * probe.m_direction[0];
-            sample_point.y = probe.m_position[1] + j * sample_step * probe.m_direction[1];
-            sample_point.z = probe.m_position[2] + j * sample_step * probe.m_direction[2];
+            for (int j = 0; j < samples_per_probe; j++) {
 
-            std::vector<uint32_t> k_indices;
-            std::vector<float> k_distances;
+                pcl::PointXYZ sample_point;
+                sample_point.x = positions[i][0] + j * sample_step * directions[i][0];
+                sample_point.y = positions[i][1] + j * sample_step * directions[i][1];
+                sample_point.z = positions[i][2] + j * sample_step * directions[i][2];
 
-            auto num_neighbors = tree->radiusSearch(sample_point, radius, k_indices, k_distances);
-            if (num_neighbors == 0) {
-                num_neighbors = tree->nearestKSearch(sample_point, 1, k_indices, k_distances);
-            }
+                auto num_neighbors = tree->radiusSearch(sample_point, radius, k_indices, k_distances);
+                if (num_neighbors == 0) {
+                    num_neighbors = tree->nearestKSearch(sample_point, 1, k_indices, k_distances);
+                }
 
-            // accumulate values
-            float value = 0.0f;
-            float min_data = std::numeric_limits<float>::max();
-            float max_data = std::numeric_limits<float>::min();
-            for (int n = 0; n < num_neighbors; n++) {
-                value += data[k_indices[n]];
-                min_data = std::min(min_data, static_cast<float>(data[k_indices[n]]));
-                max_data = std::max(max_data, static_cast<float>(data[k_indices[n]]));
-            } // end num_neighbors
-            value /= num_neighbors;
-
-            samples->samples[j].mean = value;
-            samples->samples[j].lower_bound = min_data;
-            samples->samples[j].upper_bound = max_data;
-
-            min_value = std::min(min_value, min_data);
-            max_value = std::max(max_value, max_data);
-            avg_value += value;
-        } // end num samples per probe
+                // accumulate values
+                float value = 0.0f;
+                float min_data = std::numeric_limits<float>::max();
+                float max_data = std::numeric_limits<float>::lowest();
+                for (int n = 0; n < num_neighbors; n++) {
+                    value += data[k_indices[n]];
+                    min_data = std::min(min_data, static_cast<float>(data[k_indices[n]]));
+                    max_data = std::max(max_data, static_cast<float>(data[k_indices[n]]));
+                } // end num_neighbors
+                value /= num_neighbors;
+
+                samples[j].mean = value;
+                samples[j].lower_bound = min_data;
+                samples[j].upper_bound = max_data;
+
+                min_value = std::min(min_value, min_data);
+                max_value = std::max(max_value, max_data);
+                avg_value += value;
+            } // end num samples per probe
+            avg_value /= samples_per_probe;
 
-        global_min = std::min(global_min, min_value);
-        global_max = std::max(global_max, max_value);
-    } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+            store->average_value()[i] = avg_value;
+            store->min_value()[i] = min_value;
+            store->max_value()[i] = max_value;
+        } // end for probes
+    }
+    applySampleStore(store);
 }
 
 template<typename T>
@@ -343,101 +329,55 @@ inline void SampleAlongPobes::doVectorSamling(const std::shared_ptr<pcl::KdTreeF
     const std::vector<T>& data_x, const std::vector<T>& data_y, const std::vector<T>& data_z,
     const std::vector<T>& data_w) {
 
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
-
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); i++) {
-
-        Vec4Probe probe;
-
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::FloatProbe> ||
-                          std::is_same_v<T, probe::FloatDistributionProbe>) {
-
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::Vec4Probe>) {
-                probe = arg;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
+    auto store = prepareSampling<Vec4Probe>(4, 1.0f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
+    auto const& radii = _probes->getSampleRadii();
 
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
+#pragma omp parallel
+    {
+        std::vector<uint32_t> k_indices;
+        std::vector<float> k_distances;
 
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = sample_step * sample_radius_factor;
+#pragma omp for schedule(dynamic, 64)
+        for (int32_t i = 0; i < probe_count; i++) {
 
-        std::shared_ptr<Vec4Probe::SamplingResult> samples = probe.getSamplingResult();
+            auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
+            auto const radius = radii[i];
 
-        float min_value = std::numeric_limits<float>::max();
-        float max_value = -std::numeric_limits<float>::max();
-        float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+            auto* samples = reinterpret_cast<std::array<float, 4>*>(store->row(i));
 
-        for (int j = 0; j < samples_per_probe; j++) {
-
-            pcl::PointXYZ sample_point;
-            sample_point.x = probe.m_position[0] + j * sample_step * probe.m_direction[0];
-            sample_point.y = probe.m_position[1] + j * sample_step * probe.m_direction[1];
-            sample_point.z = probe.m_position[2] + j * sample_step * probe.m_direction[2];
+            for (int j = 0; j < samples_per_probe; j++) {
 
-            std::vector<uint32_t> k_indices;
-            std::vector<float> k_distances;
-
-            auto num_neighbors = tree->radiusSearch(sample_point, radius, k_indices, k_distances);
-            if (num_neighbors == 0) {
-                num_neighbors = tree->nearestKSearch(sample_point, 1, k_indices, k_distances);
-            }
+                pcl::PointXYZ sample_point;
+                sample_point.x = positions[i][0] + j * sample_step * directions[i][0];
+                sample_point.y = positions[i][1] + j * sample_step * directions[i][1];
+                sample_point.z = positions[i][2] + j * sample_step * directions[i][2];
 
+                auto num_neighbors = tree->radiusSearch(sample_point, radius, k_indices, k_distances);
+                if (num_neighbors == 0) {
+                    num_neighbors = tree->nearestKSearch(sample_point, 1, k_indices, k_distances);
+                }
 
-            // accumulate values
-            float value_x = 0, value_y = 0, value_z = 0, value_w = 0;
-            for (int n = 0; n < num_neighbors; n++) {
-                value_x += data_x[k_indices[n]];
-                value_y += data_y[k_indices[n]];
-                value_z += data_z[k_indices[n]];
-                value_w += data_w[k_indices[n]];
-            } // end num_neighbors
-            samples->samples[j][0] = value_x / num_neighbors;
-            ;
-            samples->samples[j][1] = value_y / num_neighbors;
-            ;
-            samples->samples[j][2] = value_z / num_neighbors;
-            ;
-            samples->samples[j][3] = value_w / num_neighbors;
-            ;
-            //min_value = std::min(min_value, value);
-            //max_value = std::max(max_value, value);
-            //avg_value += value;
-        } // end num samples per probe
-        //avg_value /= samples_per_probe;
-        //samples->average_value = avg_value;
-        //samples->max_value = max_value;
-        //samples->min_value = min_value;
-    } // end for probes
+                // accumulate values
+                float value_x = 0, value_y = 0, value_z = 0, value_w = 0;
+                for (int n = 0; n < num_neighbors; n++) {
+                    value_x += data_x[k_indices[n]];
+                    value_y += data_y[k_indices[n]];
+                    value_z += data_z[k_indices[n]];
+                    value_w += data_w[k_indices[n]];
+                } // end num_neighbors
+                samples[j][0] = value_x / num_neighbors;
+                samples[j][1] = value_y / num_neighbors;
+                samples[j][2] = value_z / num_neighbors;
+                samples[j][3] = value_w / num_neighbors;
+            } // end num samples per probe
+        } // end for probes
+    }
+    _probes->setSampleStore(store);
 }
 
 
@@ -465,63 +405,30 @@ void SampleAlongPobes::doTetrahedralSampling(
         tri = Triangulation(points.cbegin(), points.cend());
     }
 
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
-
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = std::numeric_limits<float>::lowest();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); ++i) {
+    // CGAL's point location is not safe to call concurrently on one triangulation, this mode stays serial
+    auto store = prepareSampling<FloatProbe>(1, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
 
-        FloatProbe probe;
+    for (int32_t i = 0; i < probe_count; ++i) {
 
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::Vec4Probe> ||
-                          std::is_same_v<T, probe::FloatDistributionProbe>) {
-
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = 0.5 * sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::FloatProbe>) {
-                probe = arg;
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
-
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
-
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = 0.5 * sample_step * sample_radius_factor;
-
-        std::shared_ptr<FloatProbe::SamplingResult> samples = probe.getSamplingResult();
+        auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
 
         float min_value = std::numeric_limits<float>::max();
         float max_value = std::numeric_limits<float>::lowest();
         /*float min_data = std::numeric_limits<float>::max();
         float max_data = -std::numeric_limits<float>::max();*/
         float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+        float* samples = store->row(i);
 
         for (int j = 0; j < samples_per_probe; ++j) {
 
-            Point sample_point(probe.m_position[0] + static_cast<float>(j) * sample_step * probe.m_direction[0],
-                probe.m_position[1] + static_cast<float>(j) * sample_step * probe.m_direction[1],
-                probe.m_position[2] + static_cast<float>(j) * sample_step * probe.m_direction[2]);
+            Point sample_point(positions[i][0] + static_cast<float>(j) * sample_step * directions[i][0],
+                positions[i][1] + static_cast<float>(j) * sample_step * directions[i][1],
+                positions[i][2] + static_cast<float>(j) * sample_step * directions[i][2]);
 
             T val = std::numeric_limits<T>::signaling_NaN();
 
@@ -557,7 +464,7 @@ void SampleAlongPobes::doTetrahedralSampling(
 
                 val = a_0 * val_0 + a_1 * val_1 + a_2 * val_2 + a_3 * val_3;
             }
-            samples->samples[j] = val;
+            samples[j] = val;
 
             min_value = std::min<decltype(min_value)>(min_value, val);
             max_value = std::max<decltype(max_value)>(max_value, val);
@@ -565,13 +472,11 @@ void SampleAlongPobes::doTetrahedralSampling(
         } // end num samples per probe
 
         avg_value /= samples_per_probe;
-        samples->average_value = avg_value;
-        samples->max_value = max_value;
-        samples->min_value = min_value;
-        global_min = std::min(global_min, samples->min_value);
-        global_max = std::max(global_max, samples->max_value);
+        store->average_value()[i] = avg_value;
+        store->max_value()[i] = max_value;
+        store->min_value()[i] = min_value;
     } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+    applySampleStore(store);
     _probes->shuffle_probes();
 }
 
@@ -610,69 +515,29 @@ inline void SampleAlongPobes::doTetrahedralVectorSamling(const std::shared_ptr<p
         tri = Triangulation(points.cbegin(), points.cend());
     }
 
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
-
-    std::vector<char> invalid_probes(_probes->getProbeCount(), 1);
-
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = std::numeric_limits<float>::lowest();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); ++i) {
-
-        Vec4Probe probe;
-
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::FloatProbe> ||
-                          std::is_same_v<T, probe::FloatDistributionProbe>) {
+    auto store = prepareSampling<Vec4Probe>(4, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
 
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
+    std::vector<char> invalid_probes(probe_count, 1);
 
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
+    for (int32_t i = 0; i < probe_count; ++i) {
 
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::Vec4Probe>) {
-                probe = arg;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
-
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
-
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = 0.5 * sample_step * sample_radius_factor;
-
-        std::shared_ptr<Vec4Probe::SamplingResult> samples = probe.getSamplingResult();
+        auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
 
         float min_value = std::numeric_limits<float>::max();
         float max_value = std::numeric_limits<float>::lowest();
         float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+        auto* samples = reinterpret_cast<std::array<float, 4>*>(store->row(i));
 
         for (int j = 0; j < samples_per_probe; ++j) {
 
-            Point sample_point(probe.m_position[0] + static_cast<float>(j) * sample_step * probe.m_direction[0],
-                probe.m_position[1] + static_cast<float>(j) * sample_step * probe.m_direction[1],
-                probe.m_position[2] + static_cast<float>(j) * sample_step * probe.m_direction[2]);
+            Point sample_point(positions[i][0] + static_cast<float>(j) * sample_step * directions[i][0],
+                positions[i][1] + static_cast<float>(j) * sample_step * directions[i][1],
+                positions[i][2] + static_cast<float>(j) * sample_step * directions[i][2]);
 
             InfoType val = {std::numeric_limits<float>::signaling_NaN(), std::numeric_limits<float>::signaling_NaN(),
                 std::numeric_limits<float>::signaling_NaN(), std::numeric_limits<float>::signaling_NaN()};
@@ -719,7 +584,7 @@ inline void SampleAlongPobes::doTetrahedralVectorSamling(const std::shared_ptr<p
                                    a_3 * std::get<3>(val_3);
             }
             std::array<float, 4> sample = {std::get<0>(val), std::get<1>(val), std::get<2>(val), std::get<3>(val)};
-            samples->samples[j] = sample;
+            samples[j] = sample;
 
             min_value = std::min(min_value, std::get<3>(sample));
             max_value = std::max(max_value, std::get<3>(sample));
@@ -728,10 +593,11 @@ inline void SampleAlongPobes::doTetrahedralVectorSamling(const std::shared_ptr<p
 
         avg_value /= samples_per_probe;
 
-        global_min = std::min(global_min, min_value);
-        global_max = std::max(global_max, max_value);
+        store->average_value()[i] = avg_value;
+        store->min_value()[i] = min_value;
+        store->max_value()[i] = max_value;
     } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+    applySampleStore(store);
     _probes->erase_probes(invalid_probes);
     _probes->shuffle_probes();
 }
@@ -761,63 +627,29 @@ void SampleAlongPobes::doNearestNeighborSampling(
         tri = Triangulation(points.begin(), points.end());
     }
 
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
-
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = std::numeric_limits<float>::lowest();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); ++i) {
-
-        FloatProbe probe;
-
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::Vec4Probe> ||
-                          std::is_same_v<T, probe::FloatDistributionProbe>) {
-
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = 0.5 * sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::FloatProbe>) {
-                probe = arg;
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
+    auto store = prepareSampling<FloatProbe>(1, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
 
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
+    for (int32_t i = 0; i < probe_count; ++i) {
 
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = 0.5 * sample_step * sample_radius_factor;
-
-        std::shared_ptr<FloatProbe::SamplingResult> samples = probe.getSamplingResult();
+        auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
 
         float min_value = std::numeric_limits<float>::max();
         float max_value = std::numeric_limits<float>::lowest();
         /*float min_data = std::numeric_limits<float>::max();
         float max_data = -std::numeric_limits<float>::max();*/
         float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+        float* samples = store->row(i);
 
         for (int j = 0; j < samples_per_probe; ++j) {
 
-            Point sample_point(probe.m_position[0] + static_cast<float>(j) * sample_step * probe.m_direction[0],
-                probe.m_position[1] + static_cast<float>(j) * sample_step * probe.m_direction[1],
-                probe.m_position[2] + static_cast<float>(j) * sample_step * probe.m_direction[2]);
+            Point sample_point(positions[i][0] + static_cast<float>(j) * sample_step * directions[i][0],
+                positions[i][1] + static_cast<float>(j) * sample_step * directions[i][1],
+                positions[i][2] + static_cast<float>(j) * sample_step * directions[i][2]);
 
             T val = std::numeric_limits<T>::signaling_NaN();
 
@@ -828,7 +660,7 @@ void SampleAlongPobes::doNearestNeighborSampling(
                 val = vertex->info();
             }
 
-            samples->samples[j] = val;
+            samples[j] = val;
 
             min_value = std::min<decltype(min_value)>(min_value, val);
             max_value = std::max<decltype(max_value)>(max_value, val);
@@ -836,6 +668,9 @@ void SampleAlongPobes::doNearestNeighborSampling(
         } // end num samples per probe
 
         avg_value /= samples_per_probe;
+        store->average_value()[i] = avg_value;
+        store->max_value()[i] = max_value;
+        store->min_value()[i] = min_value;
         /*if (this->_weighting.Param<megamol::core::param::EnumParam>()->Value() == 0) {
             samples->average_value = avg_value;
             samples->max_value = max_value;
@@ -845,59 +680,31 @@ void SampleAlongPobes::doNearestNeighborSampling(
             samples->max_value = max_data;
             samples->min_value = max_data;
         }*/
-        global_min = std::min(global_min, samples->min_value);
-        global_max = std::max(global_max, samples->max_value);
     } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+    applySampleStore(store);
 }
 
 template<typename T>
 void SampleAlongPobes::SampleAlongPobes::doVolumeRadiusSampling(T* data) {
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
+    const bool use_max_weighting = this->_weighting.Param<megamol::core::param::EnumParam>()->Value() != 0;
 
     glm::vec3 origin = {_vol_metadata->Origin[0], _vol_metadata->Origin[1], _vol_metadata->Origin[2]};
     glm::vec3 spacing = {*_vol_metadata->SliceDists[0], *_vol_metadata->SliceDists[1], *_vol_metadata->SliceDists[2]};
     float min_spacing = std::min(std::min(spacing.x, spacing.y), spacing.z);
 
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = -std::numeric_limits<float>::max();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); i++) {
-
-        FloatProbe probe;
-
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::Vec4Probe>) {
-
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = 0.5 * sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::FloatProbe>) {
-                probe = arg;
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
+    auto store = prepareSampling<FloatProbe>(1, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
+    auto const& radii = _probes->getSampleRadii();
 
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int32_t i = 0; i < probe_count; i++) {
 
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-        auto radius = 0.5 * sample_step * sample_radius_factor;
+        auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
+        auto const radius = radii[i];
         auto grid_radius = glm::vec3(radius) / spacing;
         std::array<int, 3> num_grid_points_per_dim = {grid_radius.x * 2, grid_radius.y * 2, grid_radius.z * 2};
 
@@ -909,21 +716,20 @@ void SampleAlongPobes::SampleAlongPobes::doVolumeRadiusSampling(T* data) {
             }
         }
 
-        std::shared_ptr<FloatProbe::SamplingResult> samples = probe.getSamplingResult();
         float min_value = std::numeric_limits<float>::max();
         float max_value = -std::numeric_limits<float>::max();
         float min_data = std::numeric_limits<float>::max();
         float max_data = -std::numeric_limits<float>::max();
         float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+        float* samples = store->row(i);
 
 
         for (int j = 0; j < samples_per_probe; j++) {
 
             glm::vec3 sample_point;
-            sample_point.x = probe.m_position[0] + j * sample_step * probe.m_direction[0];
-            sample_point.y = probe.m_position[1] + j * sample_step * probe.m_direction[1];
-            sample_point.z = probe.m_position[2] + j * sample_step * probe.m_direction[2];
+            sample_point.x = positions[i][0] + j * sample_step * directions[i][0];
+            sample_point.y = positions[i][1] + j * sample_step * directions[i][1];
+            sample_point.z = positions[i][2] + j * sample_step * directions[i][2];
 
 
             // calculate in which cell (i,j,k) the point resides in
@@ -959,10 +765,10 @@ void SampleAlongPobes::SampleAlongPobes::doVolumeRadiusSampling(T* data) {
             }
             if (value != 0)
                 value /= num_samples;
-            if (this->_weighting.Param<megamol::core::param::EnumParam>()->Value() == 0) {
-                samples->samples[j] = value;
+            if (!use_max_weighting) {
+                samples[j] = value;
             } else {
-                samples->samples[j] = max_data;
+                samples[j] = max_data;
             }
             min_value = std::min(min_value, value);
             max_value = std::max(max_value, value);
@@ -973,81 +779,49 @@ void SampleAlongPobes::SampleAlongPobes::doVolumeRadiusSampling(T* data) {
         if (!std::isfinite(avg_value)) {
             core::utility::log::Log::DefaultLog.WriteError("[SampleAlongProbes] Non-finite value in sampled.");
         }
-        if (this->_weighting.Param<megamol::core::param::EnumParam>()->Value() == 0) {
-            samples->average_value = avg_value;
-            samples->max_value = max_value;
-            samples->min_value = min_value;
+        if (!use_max_weighting) {
+            store->average_value()[i] = avg_value;
+            store->max_value()[i] = max_value;
+            store->min_value()[i] = min_value;
         } else {
-            samples->average_value = max_data;
-            samples->max_value = max_data;
-            samples->min_value = max_data;
+            store->average_value()[i] = max_data;
+            store->max_value()[i] = max_data;
+            store->min_value()[i] = max_data;
         }
-        global_min = std::min(global_min, samples->min_value);
-        global_max = std::max(global_max, samples->max_value);
     } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+    applySampleStore(store);
 }
 
 template<typename T>
 void SampleAlongPobes::SampleAlongPobes::doVolumeTrilinSampling(T* data) {
-    const int samples_per_probe = this->_num_samples_per_probe_slot.Param<core::param::IntParam>()->Value();
-    const float sample_radius_factor = this->_sample_radius_factor_slot.Param<core::param::FloatParam>()->Value();
-
     glm::vec3 origin = {_vol_metadata->Origin[0], _vol_metadata->Origin[1], _vol_metadata->Origin[2]};
     glm::vec3 spacing = {*_vol_metadata->SliceDists[0], *_vol_metadata->SliceDists[1], *_vol_metadata->SliceDists[2]};
     float min_spacing = std::min(std::min(spacing.x, spacing.y), spacing.z);
 
-    float global_min = std::numeric_limits<float>::max();
-    float global_max = -std::numeric_limits<float>::max();
-    //#pragma omp parallel for
-    for (int32_t i = 0; i < static_cast<int32_t>(_probes->getProbeCount()); i++) {
+    auto store = prepareSampling<FloatProbe>(1, 0.5f);
+    const auto samples_per_probe = static_cast<int>(store->samples_per_probe());
+    const auto probe_count = static_cast<int32_t>(store->rows());
+    auto const& positions = _probes->getPositions();
+    auto const& directions = _probes->getDirections();
+    auto const& ends = _probes->getEnds();
 
-        FloatProbe probe;
+#pragma omp parallel for schedule(dynamic, 64)
+    for (int32_t i = 0; i < probe_count; i++) {
 
-        auto visitor = [&probe, i, samples_per_probe, sample_radius_factor, this](auto&& arg) {
-            using T = std::decay_t<decltype(arg)>;
-            if constexpr (std::is_same_v<T, probe::BaseProbe> || std::is_same_v<T, probe::Vec4Probe>) {
+        auto const sample_step = ends[i] / static_cast<float>(samples_per_probe);
 
-                probe.m_timestamp = arg.m_timestamp;
-                probe.m_value_name = arg.m_value_name;
-                probe.m_position = arg.m_position;
-                probe.m_direction = arg.m_direction;
-                probe.m_begin = arg.m_begin;
-                probe.m_end = arg.m_end;
-                probe.m_cluster_id = arg.m_cluster_id;
-
-                auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-                auto radius = 0.5 * sample_step * sample_radius_factor;
-                probe.m_sample_radius = radius;
-
-                _probes->setProbe(i, probe);
-
-            } else if constexpr (std::is_same_v<T, probe::FloatProbe>) {
-                probe = arg;
-
-            } else {
-                // unknown/incompatible probe type, throw error? do nothing?
-            }
-        };
-
-        auto generic_probe = _probes->getGenericProbe(i);
-        std::visit(visitor, generic_probe);
-
-        auto sample_step = probe.m_end / static_cast<float>(samples_per_probe);
-
-        std::shared_ptr<FloatProbe::SamplingResult> samples = probe.getSamplingResult();
         float min_value = std::numeric_limits<float>::max();
         float max_value = -std::numeric_limits<float>::max();
         float avg_value = 0.0f;
-        samples->samples.resize(samples_per_probe);
+        float* samples = store->row(i);
 
 
         for (int j = 0; j < samples_per_probe; j++) {
 
             glm::vec3 sample_point;
-            sample_point.x = probe.m_position[0] + j * sample_step * probe.m_direction[0];
-            sample_point.y = probe.m_position[1] + j * sample_step * probe.m_direction[1];
-            sample_point.z = probe.m_position[2] + j * sample_step * probe.m_direction[2];
+            sample_point.x = positions[i][0] + j * sample_step * directions[i][0];
+            sample_point.y = positions[i][1] + j * sample_step * directions[i][1];
+            sample_point.z = positions[i][2] + j * sample_step * directions[i][2];
 
             auto xd = sample_point.x -
                       std::floorf(sample_point.x) / (std::ceilf(sample_point.x) - std::floorf(sample_point.x));
@@ -1098,7 +872,7 @@ void SampleAlongPobes::SampleAlongPobes::doVolumeTrilinSampling(T* data) {
             auto c1 = c01 * (1 - yd) + c11 * yd;
 
             auto value = c0 * (1 - zd) + c1 * zd;
-            samples->samples[j] = value;
+            samples[j] = value;
 
             min_value = std::min(min_value, value);
             max_value = std::max(max_value, value);
@@ -1110,14 +884,11 @@ void SampleAlongPobes::SampleAlongPobes::doVolumeTrilinSampling(T* data) {
             core::utility::log::Log::DefaultLog.WriteError("[SampleAlongProbes] Non-finite value in sampled.");
         }
 
-        samples->average_value = avg_value;
-        samples->max_value = max_value;
-        samples->min_value = min_value;
-
-        global_min = std::min(global_min, samples->min_value);
-        global_max = std::max(global_max, samples->max_value);
+        store->average_value()[i] = avg_value;
+        store->max_value()[i] = max_value;
+        store->min_value()[i] = min_value;
     } // end for probes
-    _probes->setGlobalMinMax(global_min, global_max);
+    applySampleStore(store);
 }
 
 
@@ -0,0 +1,134 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "probe/ProbeCollection.h"
+
+#include "mmtest/Check.h"
+
+using namespace megamol::probe;
+
+namespace {
+
+constexpr size_t ProbeCount = 3;
+constexpr size_t SamplesPerProbe = 4;
+
+std::shared_ptr<ProbeCollection> makeProbes() {
+    auto probes = std::make_shared<ProbeCollection>();
+    for (size_t i = 0; i < ProbeCount; ++i) {
+        BaseProbe probe;
+        probe.m_timestamp = 0;
+        probe.m_value_name = "value";
+        probe.m_position = {static_cast<float>(i), 0.0f, 0.0f};
+        probe.m_direction = {0.0f, 0.0f, 1.0f};
+        probe.m_begin = 0.0f;
+        probe.m_end = 1.0f;
+        probe.m_sample_radius = 0.0f;
+        probe.m_cluster_id = -1;
+        probe.m_representant = false;
+        probe.m_geo_ids = {"mesh"};
+        probes->addProbe(probe);
+    }
+    return probes;
+}
+
+/** Samples like SampleAlongProbes and ElementSampling do: straight into the rows of an attached store */
+void sampleIntoStore(ProbeCollection& probes) {
+    auto store = std::make_shared<ProbeSampleStore>(ProbeCount, SamplesPerProbe, 3);
+    for (size_t i = 0; i < ProbeCount; ++i) {
+        probes.convertProbe<FloatDistributionProbe>(i);
+        auto* samples = reinterpret_cast<FloatDistributionProbe::SampleValue*>(store->row(i));
+        for (size_t j = 0; j < SamplesPerProbe; ++j) {
+            auto const v = static_cast<float>(10 * i + j);
+            samples[j] = {v, v - 1.0f, v + 1.0f};
+        }
+        store->min_value()[i] = static_cast<float>(10 * i);
+        store->max_value()[i] = static_cast<float>(10 * i + SamplesPerProbe - 1);
+        store->average_value()[i] = static_cast<float>(10 * i) + 1.5f;
+    }
+    probes.setSampleStore(store);
+}
+
+void testReadBackAfterSampling() {
+    auto probes = makeProbes();
+    sampleIntoStore(*probes);
+
+    for (size_t i = 0; i < ProbeCount; ++i) {
+        CHECK(probes->holdsProbe<FloatDistributionProbe>(i));
+        auto const result = probes->getSamplingResult<FloatDistributionProbe>(i);
+        CHECK(result->samples.size() == SamplesPerProbe);
+        for (size_t j = 0; j < result->samples.size(); ++j) {
+            CHECK(result->samples[j].mean == static_cast<float>(10 * i + j));
+            CHECK(result->samples[j].upper_bound == static_cast<float>(10 * i + j) + 1.0f);
+        }
+        CHECK(result->min_value == static_cast<float>(10 * i));
+        CHECK(result->max_value == static_cast<float>(10 * i + SamplesPerProbe - 1));
+        CHECK(result->average_value == static_cast<float>(10 * i) + 1.5f);
+    }
+}
+
+/** Writes through the compatibility view have to end up in the store */
+void testWriteThroughProbe() {
+    auto probes = makeProbes();
+    sampleIntoStore(*probes);
+
+    {
+        auto probe = probes->getProbe<FloatDistributionProbe>(1);
+        auto result = probe.getSamplingResult();
+        result->samples[2].mean = -5.0f;
+        result->min_value = -5.0f;
+        result->average_value = 3.0f;
+    }
+
+    {
+        auto result = probes->getSamplingResult<FloatDistributionProbe>(2);
+        result->max_value = 100.0f;
+    }
+
+    auto const store = probes->getSampleStore();
+    CHECK(store->min_value()[probes->getSampleRow(1)] == -5.0f);
+    CHECK(store->average_value()[probes->getSampleRow(1)] == 3.0f);
+    CHECK(store->max_value()[probes->getSampleRow(2)] == 100.0f);
+
+    auto const result = probes->getSamplingResult<FloatDistributionProbe>(1);
+    CHECK(result->samples[2].mean == -5.0f);
+    CHECK(result->min_value == -5.0f);
+    CHECK(result->average_value == 3.0f);
+    CHECK(probes->getSamplingResult<FloatDistributionProbe>(2)->max_value == 100.0f);
+
+    // samples detached into an own array of the same size are copied back
+    {
+        auto result = probes->getSamplingResult<FloatDistributionProbe>(0);
+        result->samples.resize(SamplesPerProbe);
+        result->samples[0].mean = 42.0f;
+    }
+    CHECK(probes->getSamples<FloatDistributionProbe>(0)[0].mean == 42.0f);
+}
+
+/** Results follow their probes when the probes are reordered */
+void testReadBackAfterErase() {
+    auto probes = makeProbes();
+    sampleIntoStore(*probes);
+
+    probes->erase_probes({1, 0, 0});
+    CHECK(probes->getProbeCount() == 2);
+    CHECK(probes->getPositions()[0][0] == 1.0f);
+    auto const result = probes->getSamplingResult<FloatDistributionProbe>(0);
+    CHECK(result->samples[0].mean == 10.0f);
+    CHECK(result->min_value == 10.0f);
+}
+
+} // namespace
+
+int main() {
+    testReadBackAfterSampling();
+    testWriteThroughProbe();
+    testReadBackAfterErase();
+
+    return megamol::test::Result();
+}
@@ -0,0 +1,49 @@
+/**
+ * MegaMol
+ * Copyright (c) 2023, MegaMol Dev Team
+ * All rights reserved.
+ */
+
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * Minimal harness of the unit tests, which are plain programs: CHECK() reports failed conditions and lets the test
+ * continue, main() returns megamol::test::Result().
+ */
+namespace megamol::test {
+
+/** The number of failed checks so far. */
+inline int failures = 0;
+
+/**
+ * Prints the summary of the checks.
+ *
+ * @param report Whether to print the summary, e.g. on one MPI rank only.
+ *
+ * @return The exit code of the test.
+ */
+inline int Result(bool report = true) {
+    if (failures > 0) {
+        if (report) {
+            std::fprintf(stderr, "%d checks failed\n", failures);
+        }
+        return EXIT_FAILURE;
+    }
+    if (report) {
+        std::printf("all checks passed\n");
+    }
+    return EXIT_SUCCESS;
+}
+
+} // namespace megamol::test
+
+#define CHECK(cond)                                                                       \
+    do {                                                                                  \
+        if (!(cond)) {                                                                    \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++megamol::test::failures;                                                    \
+        }                                                                                 \
+    } while (false)
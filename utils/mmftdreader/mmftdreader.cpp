@@ -64,6 +64,49 @@ int main(int argc, char* argv[]) {
         file.read(reinterpret_cast<char*>(&info[i].max), sizeof(float));
     }
 
+    if (version == 1) {
+        // Chunked format: print the frames and their row groups instead of the data
+        uint64_t indexOffset;
+        file.read(reinterpret_cast<char*>(&indexOffset), sizeof(uint64_t));
+        file.seekg(indexOffset, std::ios::beg);
+
+        uint32_t frameCount;
+        file.read(reinterpret_cast<char*>(&frameCount), sizeof(uint32_t));
+        std::cout << "Frames:    " << frameCount << std::endl
+                  << std::endl
+                  << "# Row Groups" << std::endl
+                  << std::endl
+                  << "| Frame | Group | Rows       | Stored bytes | Raw bytes    |" << std::endl
+                  << "|-------|-------|------------|--------------|--------------|" << std::endl;
+        for (uint32_t f = 0; f < frameCount && file.good(); f++) {
+            uint64_t rowCount;
+            uint32_t groupCount;
+            file.read(reinterpret_cast<char*>(&rowCount), sizeof(uint64_t));
+            file.read(reinterpret_cast<char*>(&groupCount), sizeof(uint32_t));
+            for (uint32_t g = 0; g < groupCount && file.good(); g++) {
+                uint32_t groupRows;
+                file.read(reinterpret_cast<char*>(&groupRows), sizeof(uint32_t));
+                uint64_t stored = 0;
+                for (uint32_t c = 0; c < colCount; c++) {
+                    uint64_t offset, size;
+                    file.read(reinterpret_cast<char*>(&offset), sizeof(uint64_t));
+                    file.read(reinterpret_cast<char*>(&size), sizeof(uint64_t));
+                    file.seekg(sizeof(uint8_t) + 2 * sizeof(float), std::ios::cur);
+                    stored += size;
+                }
+                // clang-format off
+                std::cout << "| " << std::setw(5) << f
+                          << " | " << std::setw(5) << g
+                          << " | " << std::setw(10) << groupRows
+                          << " | " << std::setw(12) << stored
+                          << " | " << std::setw(12) << uint64_t(groupRows) * colCount * sizeof(float)
+                          << " |" << std::endl;
+                // clang-format on
+            }
+        }
+        return 0;
+    }
+
     uint64_t rowCount;
     file.read(reinterpret_cast<char*>(&rowCount), sizeof(uint64_t));
     std::cout << "Rows:      " << rowCount << std::endl;